@@ -0,0 +1,184 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Benchmark of the image conversions.
+ *
+ *****************************************************************************/
+
+/*!
+  \example benchImageConvert.cpp
+
+  Benchmark of vpImageConvert on synthetic VGA and full HD images.
+*/
+
+#include <visp3/core/vpImageConvert.h>
+
+#include "vpBenchmark.h"
+
+namespace
+{
+struct RGBaToGrey {
+  vpImage<vpRGBa> I;
+  vpImage<unsigned char> Ig;
+  void operator()() { vpImageConvert::RGBaToGrey((unsigned char *)I.bitmap, Ig.bitmap, I.getSize()); }
+};
+
+struct RGBToGrey {
+  std::vector<unsigned char> rgb;
+  vpImage<unsigned char> Ig;
+  void operator()() { vpImageConvert::RGBToGrey(&rgb[0], Ig.bitmap, Ig.getSize()); }
+};
+
+struct RGBaToRGB {
+  vpImage<vpRGBa> I;
+  std::vector<unsigned char> rgb;
+  void operator()() { vpImageConvert::RGBaToRGB((unsigned char *)I.bitmap, &rgb[0], I.getSize()); }
+};
+
+struct GreyToRGBa {
+  vpImage<unsigned char> Ig;
+  vpImage<vpRGBa> I;
+  void operator()() { vpImageConvert::GreyToRGBa(Ig.bitmap, (unsigned char *)I.bitmap, Ig.getSize()); }
+};
+
+struct YUYVToRGBa {
+  std::vector<unsigned char> yuyv;
+  vpImage<vpRGBa> I;
+  void operator()() { vpImageConvert::YUYVToRGBa(&yuyv[0], (unsigned char *)I.bitmap, I.getWidth(), I.getHeight()); }
+};
+
+struct YUV420ToRGBa {
+  std::vector<unsigned char> yuv;
+  vpImage<vpRGBa> I;
+  void operator()() { vpImageConvert::YUV420ToRGBa(&yuv[0], (unsigned char *)I.bitmap, I.getWidth(), I.getHeight()); }
+};
+
+struct Split {
+  vpImage<vpRGBa> I;
+  vpImage<unsigned char> R, G, B;
+  void operator()() { vpImageConvert::split(I, &R, &G, &B); }
+};
+
+struct Merge {
+  vpImage<unsigned char> R, G, B;
+  vpImage<vpRGBa> I;
+  void operator()() { vpImageConvert::merge(&R, &G, &B, NULL, I); }
+};
+
+void runBenchmarks(vpBenchmark &bench, unsigned int height, unsigned int width)
+{
+  std::stringstream ss;
+  ss << "/" << width << "x" << height;
+  const std::string size = ss.str();
+  const unsigned int n = height * width;
+
+  vpImage<vpRGBa> I;
+  vpImage<unsigned char> Ig;
+  vpBenchmark::generateImage(I, height, width, bench.getSeed());
+  vpBenchmark::generateImage(Ig, height, width, bench.getSeed());
+  std::vector<unsigned char> bytes(4 * n);
+  for (unsigned int i = 0; i < 4 * n; i++) {
+    bytes[i] = ((unsigned char *)I.bitmap)[i];
+  }
+
+  if (bench.isEnabled("vpImageConvert::RGBaToGrey" + size)) {
+    RGBaToGrey f;
+    f.I = I;
+    f.Ig.resize(height, width);
+    bench.run("vpImageConvert::RGBaToGrey" + size, f);
+  }
+
+  if (bench.isEnabled("vpImageConvert::RGBToGrey" + size)) {
+    RGBToGrey f;
+    f.rgb.assign(bytes.begin(), bytes.begin() + 3 * n);
+    f.Ig.resize(height, width);
+    bench.run("vpImageConvert::RGBToGrey" + size, f);
+  }
+
+  if (bench.isEnabled("vpImageConvert::RGBaToRGB" + size)) {
+    RGBaToRGB f;
+    f.I = I;
+    f.rgb.resize(3 * n);
+    bench.run("vpImageConvert::RGBaToRGB" + size, f);
+  }
+
+  if (bench.isEnabled("vpImageConvert::GreyToRGBa" + size)) {
+    GreyToRGBa f;
+    f.Ig = Ig;
+    f.I.resize(height, width);
+    bench.run("vpImageConvert::GreyToRGBa" + size, f);
+  }
+
+  if (bench.isEnabled("vpImageConvert::YUYVToRGBa" + size)) {
+    YUYVToRGBa f;
+    f.yuyv.assign(bytes.begin(), bytes.begin() + 2 * n);
+    f.I.resize(height, width);
+    bench.run("vpImageConvert::YUYVToRGBa" + size, f);
+  }
+
+  if (bench.isEnabled("vpImageConvert::YUV420ToRGBa" + size)) {
+    YUV420ToRGBa f;
+    f.yuv.assign(bytes.begin(), bytes.begin() + 3 * n / 2);
+    f.I.resize(height, width);
+    bench.run("vpImageConvert::YUV420ToRGBa" + size, f);
+  }
+
+  if (bench.isEnabled("vpImageConvert::split" + size)) {
+    Split f;
+    f.I = I;
+    bench.run("vpImageConvert::split" + size, f);
+  }
+
+  if (bench.isEnabled("vpImageConvert::merge" + size)) {
+    Merge f;
+    vpImageConvert::split(I, &f.R, &f.G, &f.B);
+    f.I.resize(height, width);
+    bench.run("vpImageConvert::merge" + size, f);
+  }
+}
+}
+
+int main(int argc, const char *argv[])
+{
+  try {
+    vpBenchmark bench("benchImageConvert");
+    if (!bench.parse(argc, argv))
+      return EXIT_FAILURE;
+
+    runBenchmarks(bench, 480, 640);
+    runBenchmarks(bench, 1080, 1920);
+
+    return bench.finish();
+  } catch (const vpException &e) {
+    std::cerr << "Catch an exception: " << e.getMessage() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,181 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Benchmark of the image filters.
+ *
+ *****************************************************************************/
+
+/*!
+  \example benchImageFilter.cpp
+
+  Benchmark of vpImageFilter on synthetic VGA and full HD images.
+*/
+
+#include <visp3/core/vpImageFilter.h>
+
+#include "vpBenchmark.h"
+
+namespace
+{
+struct GaussianBlur {
+  vpImage<unsigned char> I;
+  vpImage<double> GI;
+  void operator()() { vpImageFilter::gaussianBlur(I, GI, 7); }
+};
+
+struct GradXGauss2D {
+  vpImage<unsigned char> I;
+  vpImage<double> dIx;
+  std::vector<double> fg, fgd;
+  void operator()() { vpImageFilter::getGradXGauss2D(I, dIx, &fg[0], &fgd[0], (unsigned int)(2 * fg.size() - 1)); }
+};
+
+struct GradX {
+  vpImage<unsigned char> I;
+  vpImage<double> dIx;
+  void operator()() { vpImageFilter::getGradX(I, dIx); }
+};
+
+struct Filter {
+  vpImage<unsigned char> I;
+  vpImage<double> If;
+  vpMatrix M;
+  void operator()() { vpImageFilter::filter(I, If, M); }
+};
+
+struct SepFilter {
+  vpImage<unsigned char> I;
+  vpImage<double> If;
+  vpColVector kernelH, kernelV;
+  void operator()() { vpImageFilter::sepFilter(I, If, kernelH, kernelV); }
+};
+
+struct GaussPyramidal {
+  vpImage<unsigned char> I, GI;
+  void operator()() { vpImageFilter::getGaussPyramidal(I, GI); }
+};
+
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100)
+struct Canny {
+  vpImage<unsigned char> I, Ic;
+  void operator()() { vpImageFilter::canny(I, Ic, 5, 15, 3); }
+};
+#endif
+
+void runBenchmarks(vpBenchmark &bench, unsigned int height, unsigned int width)
+{
+  std::stringstream ss;
+  ss << "/" << width << "x" << height;
+  const std::string size = ss.str();
+
+  vpImage<unsigned char> I;
+  vpBenchmark::generateImage(I, height, width, bench.getSeed());
+
+  if (bench.isEnabled("vpImageFilter::gaussianBlur" + size)) {
+    GaussianBlur f;
+    f.I = I;
+    bench.run("vpImageFilter::gaussianBlur" + size, f);
+  }
+
+  if (bench.isEnabled("vpImageFilter::getGradXGauss2D" + size)) {
+    GradXGauss2D f;
+    f.I = I;
+    f.fg.resize(3);
+    f.fgd.resize(3);
+    vpImageFilter::getGaussianKernel(&f.fg[0], 5);
+    vpImageFilter::getGaussianDerivativeKernel(&f.fgd[0], 5);
+    bench.run("vpImageFilter::getGradXGauss2D" + size, f);
+  }
+
+  if (bench.isEnabled("vpImageFilter::getGradX" + size)) {
+    GradX f;
+    f.I = I;
+    bench.run("vpImageFilter::getGradX" + size, f);
+  }
+
+  if (bench.isEnabled("vpImageFilter::filter/3x3" + size)) {
+    Filter f;
+    f.I = I;
+    f.M.resize(3, 3);
+    f.M[0][0] = 1;
+    f.M[0][1] = 2;
+    f.M[0][2] = 1;
+    f.M[2][0] = -1;
+    f.M[2][1] = -2;
+    f.M[2][2] = -1;
+    bench.run("vpImageFilter::filter/3x3" + size, f);
+  }
+
+  if (bench.isEnabled("vpImageFilter::sepFilter/5" + size)) {
+    SepFilter f;
+    f.I = I;
+    f.kernelH.resize(5);
+    f.kernelH[0] = f.kernelH[4] = 1. / 16;
+    f.kernelH[1] = f.kernelH[3] = 4. / 16;
+    f.kernelH[2] = 6. / 16;
+    f.kernelV = f.kernelH;
+    bench.run("vpImageFilter::sepFilter/5" + size, f);
+  }
+
+  if (bench.isEnabled("vpImageFilter::getGaussPyramidal" + size)) {
+    GaussPyramidal f;
+    f.I = I;
+    bench.run("vpImageFilter::getGaussPyramidal" + size, f);
+  }
+
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100)
+  if (bench.isEnabled("vpImageFilter::canny" + size)) {
+    Canny f;
+    f.I = I;
+    bench.run("vpImageFilter::canny" + size, f);
+  }
+#else
+  bench.skip("vpImageFilter::canny" + size, "requires OpenCV");
+#endif
+}
+}
+
+int main(int argc, const char *argv[])
+{
+  try {
+    vpBenchmark bench("benchImageFilter");
+    if (!bench.parse(argc, argv))
+      return EXIT_FAILURE;
+
+    runBenchmarks(bench, 480, 640);
+    runBenchmarks(bench, 1080, 1920);
+
+    return bench.finish();
+  } catch (const vpException &e) {
+    std::cerr << "Catch an exception: " << e.getMessage() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,117 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Benchmark of the image resize and undistortion.
+ *
+ *****************************************************************************/
+
+/*!
+  \example benchImageTools.cpp
+
+  Benchmark of vpImageTools::resize() and vpImageTools::undistort() on
+  synthetic grey and color VGA images.
+*/
+
+#include <visp3/core/vpCameraParameters.h>
+#include <visp3/core/vpImageTools.h>
+
+#include "vpBenchmark.h"
+
+namespace
+{
+template <class Type> struct Resize {
+  Resize() : I(), Ires(), width(0), height(0), method(vpImageTools::INTERPOLATION_NEAREST) {}
+  vpImage<Type> I, Ires;
+  unsigned int width, height;
+  vpImageTools::vpImageInterpolationType method;
+  void operator()() { vpImageTools::resize(I, Ires, width, height, method); }
+};
+
+template <class Type> struct Undistort {
+  vpImage<Type> I, Iundist;
+  vpCameraParameters cam;
+  void operator()() { vpImageTools::undistort(I, cam, Iundist); }
+};
+
+template <class Type> void runBenchmarks(vpBenchmark &bench, const std::string &type)
+{
+  const unsigned int height = 480, width = 640;
+  vpImage<Type> I;
+  vpBenchmark::generateImage(I, height, width, bench.getSeed());
+
+  const char *methodNames[] = {"nearest", "linear", "cubic"};
+  const vpImageTools::vpImageInterpolationType methods[] = {
+      vpImageTools::INTERPOLATION_NEAREST, vpImageTools::INTERPOLATION_LINEAR, vpImageTools::INTERPOLATION_CUBIC};
+  const double scales[] = {0.5, 2.0};
+
+  for (unsigned int s = 0; s < 2; s++) {
+    for (unsigned int m = 0; m < 3; m++) {
+      std::stringstream ss;
+      ss << "vpImageTools::resize/" << type << "/" << methodNames[m] << "/" << width << "x" << height << "->"
+         << (unsigned int)(width * scales[s]) << "x" << (unsigned int)(height * scales[s]);
+      if (bench.isEnabled(ss.str())) {
+        Resize<Type> f;
+        f.I = I;
+        f.width = (unsigned int)(width * scales[s]);
+        f.height = (unsigned int)(height * scales[s]);
+        f.method = methods[m];
+        bench.run(ss.str(), f);
+      }
+    }
+  }
+
+  std::stringstream ss;
+  ss << "vpImageTools::undistort/" << type << "/" << width << "x" << height;
+  if (bench.isEnabled(ss.str())) {
+    Undistort<Type> f;
+    f.I = I;
+    f.cam.initPersProjWithDistortion(600., 600., width / 2., height / 2., -0.25, 0.25);
+    bench.run(ss.str(), f);
+  }
+}
+}
+
+int main(int argc, const char *argv[])
+{
+  try {
+    vpBenchmark bench("benchImageTools");
+    if (!bench.parse(argc, argv))
+      return EXIT_FAILURE;
+
+    runBenchmarks<unsigned char>(bench, "grey");
+    runBenchmarks<vpRGBa>(bench, "rgba");
+
+    return bench.finish();
+  } catch (const vpException &e) {
+    std::cerr << "Catch an exception: " << e.getMessage() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,127 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Benchmark of the keypoints detection and matching.
+ *
+ *****************************************************************************/
+
+/*!
+  \example benchKeyPoint.cpp
+
+  Benchmark of vpKeyPoint detection, extraction and matching between a
+  synthetic VGA image and a shifted copy.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#include "vpBenchmark.h"
+
+#if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020301)
+
+#include <visp3/vision/vpKeyPoint.h>
+
+namespace
+{
+struct BuildReference {
+  BuildReference() : I(), keypoint(NULL) {}
+  vpImage<unsigned char> I;
+  vpKeyPoint *keypoint;
+  void operator()() { keypoint->buildReference(I); }
+};
+
+struct MatchPoint {
+  MatchPoint() : I(), keypoint(NULL) {}
+  vpImage<unsigned char> I;
+  vpKeyPoint *keypoint;
+  void operator()() { keypoint->matchPoint(I); }
+};
+
+void runBenchmarks(vpBenchmark &bench, const std::string &detector, const std::string &extractor,
+                   const std::string &matcher)
+{
+  const std::string suffix = "/" + detector + "+" + extractor + "+" + matcher;
+  if (!bench.isEnabled("vpKeyPoint::buildReference" + suffix) && !bench.isEnabled("vpKeyPoint::matchPoint" + suffix))
+    return;
+
+  const unsigned int height = 480, width = 640;
+  vpImage<unsigned char> Iref, Icur(height, width);
+  vpBenchmark::generateImage(Iref, height, width, bench.getSeed());
+  for (unsigned int i = 0; i < height; i++) {
+    for (unsigned int j = 0; j < width; j++) {
+      Icur[i][j] = Iref[(i + 5) % height][(j + 7) % width];
+    }
+  }
+
+  vpKeyPoint keypoint(detector, extractor, matcher);
+
+  BuildReference build;
+  build.I = Iref;
+  build.keypoint = &keypoint;
+  bench.run("vpKeyPoint::buildReference" + suffix, build);
+
+  MatchPoint match;
+  match.I = Icur;
+  match.keypoint = &keypoint;
+  keypoint.buildReference(Iref);
+  bench.run("vpKeyPoint::matchPoint" + suffix, match);
+}
+}
+
+int main(int argc, const char *argv[])
+{
+  try {
+    vpBenchmark bench("benchKeyPoint");
+    if (!bench.parse(argc, argv))
+      return EXIT_FAILURE;
+
+    runBenchmarks(bench, "ORB", "ORB", "BruteForce-Hamming");
+    runBenchmarks(bench, "FAST", "ORB", "BruteForce-Hamming");
+
+    return bench.finish();
+  } catch (const vpException &e) {
+    std::cerr << "Catch an exception: " << e.getMessage() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
+
+#else
+int main(int argc, const char *argv[])
+{
+  vpBenchmark bench("benchKeyPoint");
+  if (!bench.parse(argc, argv))
+    return EXIT_FAILURE;
+
+  bench.skip("vpKeyPoint::buildReference", "requires OpenCV >= 2.3.1");
+  bench.skip("vpKeyPoint::matchPoint", "requires OpenCV >= 2.3.1");
+
+  return bench.finish();
+}
+#endif
@@ -0,0 +1,183 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Benchmark of the matrix products and decompositions.
+ *
+ *****************************************************************************/
+
+/*!
+  \example benchMatrix.cpp
+
+  Benchmark of vpMatrix products, pseudo-inverse and SVD with each of the
+  third-party backends ViSP was built with.
+*/
+
+#include <visp3/core/vpMatrix.h>
+
+#include "vpBenchmark.h"
+
+namespace
+{
+typedef unsigned int (vpMatrix::*PseudoInverseMethod)(vpMatrix &, double) const;
+typedef void (vpMatrix::*SvdMethod)(vpColVector &, vpMatrix &);
+
+// Small products are repeated to stay above the timer resolution
+struct Mult {
+  Mult() : A(), B(), C(), loops(1) {}
+  vpMatrix A, B, C;
+  unsigned int loops;
+  void operator()()
+  {
+    for (unsigned int i = 0; i < loops; i++) {
+      vpMatrix::mult2Matrices(A, B, C);
+    }
+  }
+};
+
+struct AtA {
+  vpMatrix A, C;
+  void operator()() { C = A.AtA(); }
+};
+
+struct PseudoInverse {
+  PseudoInverse() : A(), Ap(), method(NULL) {}
+  vpMatrix A, Ap;
+  PseudoInverseMethod method;
+  void operator()() { (A.*method)(Ap, 1e-6); }
+};
+
+// The SVD is done in place, the copy of the input is part of the measure
+struct Svd {
+  Svd() : A(), U(), V(), w(), method(NULL) {}
+  vpMatrix A, U, V;
+  vpColVector w;
+  SvdMethod method;
+  void operator()()
+  {
+    U = A;
+    (U.*method)(w, V);
+  }
+};
+
+vpMatrix randomMatrix(unsigned int rows, unsigned int cols, long seed)
+{
+  vpUniRand rng(seed);
+  vpMatrix M(rows, cols);
+  for (unsigned int i = 0; i < M.size(); i++) {
+    M.data[i] = 2. * rng() - 1.;
+  }
+  return M;
+}
+
+std::string sizeName(unsigned int rows, unsigned int cols)
+{
+  std::stringstream ss;
+  ss << "/" << rows << "x" << cols;
+  return ss.str();
+}
+
+void runMultBenchmarks(vpBenchmark &bench)
+{
+  const unsigned int sizes[] = {6, 32, 100, 500};
+  const unsigned int loops[] = {1000, 100, 1, 1};
+  for (unsigned int k = 0; k < 4; k++) {
+    const std::string name = "vpMatrix::mult" + sizeName(sizes[k], sizes[k]);
+    if (bench.isEnabled(name)) {
+      Mult f;
+      f.A = randomMatrix(sizes[k], sizes[k], bench.getSeed());
+      f.B = randomMatrix(sizes[k], sizes[k], bench.getSeed() + 1);
+      f.loops = loops[k];
+      bench.run(name, f, f.loops);
+    }
+  }
+
+  // Normal equations of an interaction matrix of 1000 points
+  const std::string name = "vpMatrix::AtA" + sizeName(2000, 6);
+  if (bench.isEnabled(name)) {
+    AtA f;
+    f.A = randomMatrix(2000, 6, bench.getSeed());
+    bench.run(name, f);
+  }
+}
+
+void runDecompositionBenchmarks(vpBenchmark &bench, const std::string &backend, PseudoInverseMethod pseudoInverse,
+                                SvdMethod svd)
+{
+  const unsigned int rows[] = {2000, 100, 300};
+  const unsigned int cols[] = {6, 100, 300};
+  for (unsigned int k = 0; k < 3; k++) {
+    std::string name = "vpMatrix::pseudoInverse/" + backend + sizeName(rows[k], cols[k]);
+    if (bench.isEnabled(name)) {
+      PseudoInverse f;
+      f.A = randomMatrix(rows[k], cols[k], bench.getSeed());
+      f.method = pseudoInverse;
+      bench.run(name, f);
+    }
+
+    name = "vpMatrix::svd/" + backend + sizeName(rows[k], cols[k]);
+    if (bench.isEnabled(name)) {
+      Svd f;
+      f.A = randomMatrix(rows[k], cols[k], bench.getSeed());
+      f.method = svd;
+      bench.run(name, f);
+    }
+  }
+}
+}
+
+int main(int argc, const char *argv[])
+{
+  try {
+    vpBenchmark bench("benchMatrix");
+    if (!bench.parse(argc, argv))
+      return EXIT_FAILURE;
+
+    runMultBenchmarks(bench);
+    runDecompositionBenchmarks(bench, "default", &vpMatrix::pseudoInverse, &vpMatrix::svd);
+#if defined(VISP_HAVE_LAPACK)
+    runDecompositionBenchmarks(bench, "lapack", &vpMatrix::pseudoInverseLapack, &vpMatrix::svdLapack);
+#endif
+#if defined(VISP_HAVE_EIGEN3)
+    runDecompositionBenchmarks(bench, "eigen3", &vpMatrix::pseudoInverseEigen3, &vpMatrix::svdEigen3);
+#endif
+#if (VISP_HAVE_OPENCV_VERSION >= 0x020101)
+    runDecompositionBenchmarks(bench, "opencv", &vpMatrix::pseudoInverseOpenCV, &vpMatrix::svdOpenCV);
+#endif
+#if defined(VISP_HAVE_GSL)
+    runDecompositionBenchmarks(bench, "gsl", &vpMatrix::pseudoInverseGsl, &vpMatrix::svdGsl);
+#endif
+
+    return bench.finish();
+  } catch (const vpException &e) {
+    std::cerr << "Catch an exception: " << e.getMessage() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,241 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Benchmark of the generic model-based tracker.
+ *
+ *****************************************************************************/
+
+/*!
+  \example benchMbGenericTracker.cpp
+
+  Benchmark of vpMbGenericTracker on the first frames of the
+  mbt-depth/Castle-simu sequence of the ViSP-images data set, with the same
+  settings as testGenericTracker.cpp. Each run initializes the tracker from
+  the ground truth pose of the first frame, then tracks the next ones.
+*/
+
+#include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpPixelMeterConversion.h>
+#include <visp3/io/vpImageIo.h>
+#include <visp3/mbt/vpMbGenericTracker.h>
+
+#include "vpBenchmark.h"
+
+namespace
+{
+struct Frame {
+  Frame() : I(), pointcloud(), depthWidth(0), depthHeight(0), cMo() {}
+  vpImage<unsigned char> I;
+  std::vector<vpColVector> pointcloud;
+  unsigned int depthWidth, depthHeight;
+  vpHomogeneousMatrix cMo;
+};
+
+bool readFrame(const std::string &input_directory, const int cpt, const vpCameraParameters &cam_depth, Frame &frame)
+{
+  char buffer[256];
+  sprintf(buffer, std::string(input_directory + "/Images/Image_%04d.pgm").c_str(), cpt);
+  std::string image_filename = buffer;
+
+  sprintf(buffer, std::string(input_directory + "/Depth/Depth_%04d.bin").c_str(), cpt);
+  std::string depth_filename = buffer;
+
+  sprintf(buffer, std::string(input_directory + "/CameraPose/Camera_%03d.txt").c_str(), cpt);
+  std::string pose_filename = buffer;
+
+  if (!vpIoTools::checkFilename(image_filename) || !vpIoTools::checkFilename(depth_filename) ||
+      !vpIoTools::checkFilename(pose_filename))
+    return false;
+
+  vpImageIo::read(frame.I, image_filename);
+
+  std::ifstream file_depth(depth_filename.c_str(), std::ios::in | std::ios::binary);
+  if (!file_depth.is_open())
+    return false;
+
+  vpIoTools::readBinaryValueLE(file_depth, frame.depthHeight);
+  vpIoTools::readBinaryValueLE(file_depth, frame.depthWidth);
+  frame.pointcloud.resize(frame.depthHeight * frame.depthWidth);
+
+  const float depth_scale = 0.000030518f;
+  for (unsigned int i = 0; i < frame.depthHeight; i++) {
+    for (unsigned int j = 0; j < frame.depthWidth; j++) {
+      uint16_t depth = 0;
+      vpIoTools::readBinaryValueLE(file_depth, depth);
+      double x = 0.0, y = 0.0, Z = depth * depth_scale;
+      vpPixelMeterConversion::convertPoint(cam_depth, j, i, x, y);
+      vpColVector pt3d(4, 1.0);
+      pt3d[0] = x * Z;
+      pt3d[1] = y * Z;
+      pt3d[2] = Z;
+      frame.pointcloud[i * frame.depthWidth + j] = pt3d;
+    }
+  }
+
+  std::ifstream file_pose(pose_filename.c_str());
+  if (!file_pose.is_open())
+    return false;
+
+  for (unsigned int i = 0; i < 4; i++) {
+    for (unsigned int j = 0; j < 4; j++) {
+      file_pose >> frame.cMo[i][j];
+    }
+  }
+
+  return true;
+}
+
+struct TrackSequence {
+  TrackSequence() : tracker(NULL), frames(NULL), useDepth(false) {}
+  vpMbGenericTracker *tracker;
+  const std::vector<Frame> *frames;
+  bool useDepth;
+  void operator()()
+  {
+    const std::vector<Frame> &sequence = *frames;
+    tracker->initFromPose(sequence[0].I, sequence[0].cMo);
+    for (size_t k = 1; k < sequence.size(); k++) {
+      std::map<std::string, const vpImage<unsigned char> *> mapOfImages;
+      mapOfImages["Camera1"] = &sequence[k].I;
+      std::map<std::string, const std::vector<vpColVector> *> mapOfPointclouds;
+      mapOfPointclouds["Camera2"] = &sequence[k].pointcloud;
+      std::map<std::string, unsigned int> mapOfWidths, mapOfHeights;
+      mapOfWidths["Camera2"] = useDepth ? sequence[k].depthWidth : 0;
+      mapOfHeights["Camera2"] = useDepth ? sequence[k].depthHeight : 0;
+      tracker->track(mapOfImages, mapOfPointclouds, mapOfWidths, mapOfHeights);
+    }
+  }
+};
+
+#if defined(VISP_HAVE_XML2)
+void runBenchmark(vpBenchmark &bench, const std::string &name, const std::string &input_directory,
+                  const std::vector<Frame> &frames, int trackerType_image, bool useDepth)
+{
+  if (!bench.isEnabled(name))
+    return;
+
+  std::vector<int> tracker_type(2);
+  tracker_type[0] = trackerType_image;
+  tracker_type[1] = vpMbGenericTracker::DEPTH_DENSE_TRACKER;
+  vpMbGenericTracker tracker(tracker_type);
+  tracker.loadConfigFile(input_directory + "/Config/chateau.xml", input_directory + "/Config/chateau_depth.xml");
+#ifdef VISP_HAVE_COIN3D
+  tracker.loadModel(input_directory + "/Models/chateau.wrl", input_directory + "/Models/chateau.cao");
+#else
+  tracker.loadModel(input_directory + "/Models/chateau.cao", input_directory + "/Models/chateau.cao");
+#endif
+  vpHomogeneousMatrix T;
+  T[0][0] = -1;
+  T[0][3] = -0.2;
+  T[1][1] = 0;
+  T[1][2] = 1;
+  T[1][3] = 0.12;
+  T[2][1] = 1;
+  T[2][2] = 0;
+  T[2][3] = -0.15;
+  tracker.loadModel(input_directory + "/Models/cube.cao", false, T);
+
+  vpHomogeneousMatrix depth_M_color;
+  depth_M_color[0][3] = -0.05;
+  tracker.setCameraTransformationMatrix("Camera2", depth_M_color);
+
+  TrackSequence f;
+  f.tracker = &tracker;
+  f.frames = &frames;
+  f.useDepth = useDepth;
+  bench.run(name, f, (unsigned int)frames.size() - 1);
+}
+#endif
+}
+
+int main(int argc, const char *argv[])
+{
+  try {
+    vpBenchmark bench("benchMbGenericTracker");
+    if (!bench.parse(argc, argv))
+      return EXIT_FAILURE;
+
+    std::vector<std::string> names;
+    std::vector<int> types;
+    std::vector<bool> depths;
+    names.push_back("vpMbGenericTracker::track/edge");
+    types.push_back(vpMbGenericTracker::EDGE_TRACKER);
+    depths.push_back(false);
+    names.push_back("vpMbGenericTracker::track/edge+depth_dense");
+    types.push_back(vpMbGenericTracker::EDGE_TRACKER);
+    depths.push_back(true);
+#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+    names.push_back("vpMbGenericTracker::track/klt");
+    types.push_back(vpMbGenericTracker::KLT_TRACKER);
+    depths.push_back(false);
+    names.push_back("vpMbGenericTracker::track/edge+klt+depth_dense");
+    types.push_back(vpMbGenericTracker::EDGE_TRACKER | vpMbGenericTracker::KLT_TRACKER);
+    depths.push_back(true);
+#endif
+
+#if defined(VISP_HAVE_XML2)
+    const std::string input_directory = vpIoTools::createFilePath(bench.getInputPath(), "mbt-depth/Castle-simu");
+    const unsigned int nbFrames = 30;
+    std::vector<Frame> frames;
+    if (!bench.getInputPath().empty() && vpIoTools::checkDirectory(input_directory)) {
+      // The depth camera parameters are needed to build the point clouds
+      std::vector<int> tracker_type(2);
+      tracker_type[0] = vpMbGenericTracker::EDGE_TRACKER;
+      tracker_type[1] = vpMbGenericTracker::DEPTH_DENSE_TRACKER;
+      vpMbGenericTracker tracker(tracker_type);
+      tracker.loadConfigFile(input_directory + "/Config/chateau.xml", input_directory + "/Config/chateau_depth.xml");
+      vpCameraParameters cam_color, cam_depth;
+      tracker.getCameraParameters(cam_color, cam_depth);
+
+      Frame frame;
+      while (frames.size() < nbFrames && readFrame(input_directory, (int)frames.size() + 1, cam_depth, frame)) {
+        frames.push_back(frame);
+      }
+    }
+
+    for (size_t k = 0; k < names.size(); k++) {
+      if (frames.size() < 2)
+        bench.skip(names[k], "requires the mbt-depth/Castle-simu sequence of ViSP-images");
+      else
+        runBenchmark(bench, names[k], input_directory, frames, types[k], depths[k]);
+    }
+#else
+    for (size_t k = 0; k < names.size(); k++) {
+      bench.skip(names[k], "requires libxml2 to read the tracker settings");
+    }
+#endif
+
+    return bench.finish();
+  } catch (const vpException &e) {
+    std::cerr << "Catch an exception: " << e.getMessage() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
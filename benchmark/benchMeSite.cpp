@@ -0,0 +1,129 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Benchmark of the moving-edges tracking.
+ *
+ *****************************************************************************/
+
+/*!
+  \example benchMeSite.cpp
+
+  Benchmark of the moving-edges tracking on a synthetic sequence where a
+  slanted edge moves back and forth by a few pixels.
+*/
+
+#include <visp3/core/vpGaussRand.h>
+#include <visp3/me/vpMeLine.h>
+#include <visp3/me/vpMeSite.h>
+
+#include "vpBenchmark.h"
+
+namespace
+{
+struct MeSiteTrack {
+  MeSiteTrack() : I(), me(), sites(), tracked() {}
+  vpImage<unsigned char> I;
+  vpMe me;
+  std::list<vpMeSite> sites, tracked;
+  void operator()()
+  {
+    tracked = sites;
+    for (std::list<vpMeSite>::iterator it = tracked.begin(); it != tracked.end(); ++it) {
+      it->track(I, &me, false);
+    }
+  }
+};
+
+struct MeLineTrack {
+  MeLineTrack() : I0(), I1(), line(), frame(0) {}
+  vpImage<unsigned char> I0, I1;
+  vpMeLine line;
+  unsigned int frame;
+  void operator()() { line.track((frame++ % 2) ? I0 : I1); }
+};
+
+// Dark half plane on a bright background, bounded by the line j = 0.2 i + offset
+void generateEdgeImage(vpImage<unsigned char> &I, double offset, long seed)
+{
+  const unsigned int height = 480, width = 640;
+  vpGaussRand noise(3., 0., seed);
+  I.resize(height, width);
+  for (unsigned int i = 0; i < height; i++) {
+    for (unsigned int j = 0; j < width; j++) {
+      I[i][j] = vpMath::saturate<unsigned char>((j < 0.2 * i + offset ? 60. : 190.) + noise());
+    }
+  }
+}
+}
+
+int main(int argc, const char *argv[])
+{
+  try {
+    vpBenchmark bench("benchMeSite");
+    if (!bench.parse(argc, argv))
+      return EXIT_FAILURE;
+
+    vpImage<unsigned char> I0, I1;
+    generateEdgeImage(I0, 250., bench.getSeed());
+    generateEdgeImage(I1, 253., bench.getSeed() + 1);
+
+    vpMe me;
+    me.setRange(10);
+    me.setThreshold(15000);
+    me.setMaskSize(5);
+    me.setMaskNumber(180);
+    me.setSampleStep(2);
+
+    MeLineTrack lineTrack;
+    lineTrack.I0 = I0;
+    lineTrack.I1 = I1;
+    lineTrack.line.setMe(&me);
+    lineTrack.line.setDisplay(vpMeSite::NONE);
+    lineTrack.line.initTracking(I0, vpImagePoint(20, 0.2 * 20 + 250.), vpImagePoint(460, 0.2 * 460 + 250.));
+
+    if (bench.isEnabled("vpMeSite::track")) {
+      MeSiteTrack siteTrack;
+      siteTrack.I = I1;
+      siteTrack.me = me;
+      siteTrack.sites = lineTrack.line.getMeList();
+      bench.run("vpMeSite::track", siteTrack, (unsigned int)siteTrack.sites.size());
+    }
+
+    if (bench.isEnabled("vpMeLine::track")) {
+      bench.run("vpMeLine::track", lineTrack);
+    }
+
+    return bench.finish();
+  } catch (const vpException &e) {
+    std::cerr << "Catch an exception: " << e.getMessage() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,127 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Benchmark of the RANSAC pose estimation.
+ *
+ *****************************************************************************/
+
+/*!
+  \example benchPoseRansac.cpp
+
+  Benchmark of vpPose::computePose() with the RANSAC method on synthetic
+  points with noise and 30% of outliers.
+*/
+
+#include <visp3/core/vpGaussRand.h>
+#include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpPoint.h>
+#include <visp3/vision/vpPose.h>
+
+#include "vpBenchmark.h"
+
+namespace
+{
+struct PoseRansac {
+  PoseRansac() : points(), parallel(false), cMo() {}
+  std::vector<vpPoint> points;
+  bool parallel;
+  vpHomogeneousMatrix cMo;
+  void operator()()
+  {
+    vpPose pose;
+    pose.addPoints(points);
+    pose.setRansacNbInliersToReachConsensus((unsigned int)(points.size() / 2));
+    pose.setRansacThreshold(0.002);
+    pose.setRansacMaxTrials(1000);
+#ifdef VISP_HAVE_CPP11_COMPATIBILITY
+    pose.setUseParallelRansac(parallel);
+#endif
+    pose.computePose(vpPose::RANSAC, cMo);
+  }
+};
+
+std::vector<vpPoint> generatePoints(unsigned int nbPoints, long seed)
+{
+  vpUniRand rng(seed);
+  vpGaussRand noise(0.0005, 0., seed + 1);
+  const vpHomogeneousMatrix cMo_ref(0.05, -0.02, 0.8, vpMath::rad(10), vpMath::rad(-20), vpMath::rad(30));
+
+  std::vector<vpPoint> points(nbPoints);
+  for (unsigned int i = 0; i < nbPoints; i++) {
+    points[i].setWorldCoordinates(0.2 * rng() - 0.1, 0.2 * rng() - 0.1, 0.1 * rng() - 0.05);
+    points[i].project(cMo_ref);
+    if (rng() < 0.3) {
+      points[i].set_x(0.6 * rng() - 0.3);
+      points[i].set_y(0.6 * rng() - 0.3);
+    } else {
+      points[i].set_x(points[i].get_x() + noise());
+      points[i].set_y(points[i].get_y() + noise());
+    }
+  }
+
+  return points;
+}
+}
+
+int main(int argc, const char *argv[])
+{
+  try {
+    vpBenchmark bench("benchPoseRansac");
+    if (!bench.parse(argc, argv))
+      return EXIT_FAILURE;
+
+    const unsigned int sizes[] = {50, 200, 1000};
+    for (unsigned int s = 0; s < 3; s++) {
+      for (int parallel = 0; parallel < 2; parallel++) {
+        std::stringstream ss;
+        ss << "vpPose::computePose/RANSAC" << (parallel ? "/parallel/" : "/") << sizes[s];
+#ifndef VISP_HAVE_CPP11_COMPATIBILITY
+        if (parallel) {
+          bench.skip(ss.str(), "requires C++11");
+          continue;
+        }
+#endif
+        if (!bench.isEnabled(ss.str()))
+          continue;
+
+        PoseRansac f;
+        f.points = generatePoints(sizes[s], bench.getSeed());
+        f.parallel = parallel != 0;
+        bench.run(ss.str(), f);
+      }
+    }
+
+    return bench.finish();
+  } catch (const vpException &e) {
+    std::cerr << "Catch an exception: " << e.getMessage() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,101 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Benchmark of the robust M-estimators.
+ *
+ *****************************************************************************/
+
+/*!
+  \example benchRobust.cpp
+
+  Benchmark of vpRobust::MEstimator() on Gaussian residues with 20% of
+  outliers.
+*/
+
+#include <visp3/core/vpGaussRand.h>
+#include <visp3/core/vpRobust.h>
+
+#include "vpBenchmark.h"
+
+namespace
+{
+struct MEstimator {
+  MEstimator() : robust(), method(vpRobust::TUKEY), residues(), weights() {}
+  vpRobust robust;
+  vpRobust::vpRobustEstimatorType method;
+  vpColVector residues, weights;
+  void operator()()
+  {
+    // Start each run with unit weights as the trackers do
+    weights = 1.;
+    robust.MEstimator(method, residues, weights);
+  }
+};
+}
+
+int main(int argc, const char *argv[])
+{
+  try {
+    vpBenchmark bench("benchRobust");
+    if (!bench.parse(argc, argv))
+      return EXIT_FAILURE;
+
+    const char *methodNames[] = {"tukey", "cauchy", "huber"};
+    const vpRobust::vpRobustEstimatorType methods[] = {vpRobust::TUKEY, vpRobust::CAUCHY, vpRobust::HUBER};
+    const unsigned int sizes[] = {1000, 10000, 100000};
+
+    for (unsigned int s = 0; s < 3; s++) {
+      for (unsigned int m = 0; m < 3; m++) {
+        std::stringstream ss;
+        ss << "vpRobust::MEstimator/" << methodNames[m] << "/" << sizes[s];
+        if (!bench.isEnabled(ss.str()))
+          continue;
+
+        MEstimator f;
+        f.method = methods[m];
+        f.robust.resize(sizes[s]);
+        f.residues.resize(sizes[s]);
+        f.weights.resize(sizes[s]);
+        vpGaussRand noise(0.01, 0., bench.getSeed());
+        vpUniRand outlier(bench.getSeed() + 1);
+        for (unsigned int i = 0; i < sizes[s]; i++) {
+          f.residues[i] = (outlier() < 0.2) ? 2. * outlier() - 1. : noise();
+        }
+        bench.run(ss.str(), f, sizes[s]);
+      }
+    }
+
+    return bench.finish();
+  } catch (const vpException &e) {
+    std::cerr << "Catch an exception: " << e.getMessage() << std::endl;
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,520 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Minimal harness shared by the ViSP benchmarks.
+ *
+ *****************************************************************************/
+
+#ifndef _vpBenchmark_h_
+#define _vpBenchmark_h_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpRGBa.h>
+#include <visp3/core/vpTime.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/io/vpParseArgv.h>
+
+// List of allowed command line options
+#define GETOPTARGS "b:cdf:hi:lo:r:s:w:"
+
+/*!
+  \class vpBenchmark
+
+  Harness used by the programs of the benchmark folder.
+
+  A benchmark is a functor without argument that is called \e warmup times
+  without being measured, then \e repetitions times while measuring its
+  duration with vpTime::measureTimeMs(). The min, mean, median, 90th and 99th
+  percentiles and max durations are printed on the standard output and can be
+  saved in a JSON file with the -o option.
+
+  The inputs of the benchmarks are synthetic and generated from the seed
+  returned by getSeed() (-s option) so that two runs process the same data.
+  Benchmarks that need the ViSP-images data set get its location from
+  getInputPath() and should call skip() when it is not available.
+
+  A budget file given with the -b option contains lines "<name> <max median
+  in ms>". When one of the budgets is exceeded, or when a budget name does
+  not match any of the benchmarks that are run, finish() returns
+  EXIT_FAILURE so that the benchmarks can be used to check an upgrade.
+
+  \code
+  struct GaussianBlur {
+    vpImage<unsigned char> I;
+    vpImage<double> GI;
+    void operator()() { vpImageFilter::gaussianBlur(I, GI); }
+  };
+
+  int main(int argc, const char *argv[])
+  {
+    vpBenchmark bench("benchImageFilter");
+    if (!bench.parse(argc, argv))
+      return EXIT_FAILURE;
+    GaussianBlur blur;
+    // fill blur.I using bench.getSeed()
+    bench.run("vpImageFilter::gaussianBlur/640x480", blur);
+    return bench.finish();
+  }
+  \endcode
+*/
+class vpBenchmark
+{
+public:
+  explicit vpBenchmark(const std::string &name)
+    : m_name(name), m_warmup(3), m_repetitions(20), m_seed(1), m_filter(), m_ipath(), m_jsonFile(), m_budgetFile(),
+      m_list(false), m_budgets(), m_results()
+  {
+  }
+
+  /*!
+    Parse the command line options. Return false if the program has to be
+    stopped.
+  */
+  bool parse(int argc, const char **argv)
+  {
+    m_ipath = vpIoTools::getViSPImagesDataPath();
+
+    const char *optarg_;
+    int c;
+    while ((c = vpParseArgv::parse(argc, argv, GETOPTARGS, &optarg_)) > 1) {
+      switch (c) {
+      case 'b':
+        m_budgetFile = optarg_;
+        break;
+      case 'f':
+        m_filter = optarg_;
+        break;
+      case 'i':
+        m_ipath = optarg_;
+        break;
+      case 'l':
+        m_list = true;
+        break;
+      case 'o':
+        m_jsonFile = optarg_;
+        break;
+      case 'r':
+        m_repetitions = (unsigned int)atoi(optarg_);
+        break;
+      case 's':
+        m_seed = atol(optarg_);
+        break;
+      case 'w':
+        m_warmup = (unsigned int)atoi(optarg_);
+        break;
+      case 'c':
+      case 'd':
+        break;
+      case 'h':
+        usage(argv[0], NULL);
+        return false;
+      default:
+        usage(argv[0], optarg_);
+        return false;
+      }
+    }
+
+    if ((c == 1) || (c == -1)) {
+      // standalone param or error
+      usage(argv[0], NULL);
+      std::cerr << "ERROR: " << std::endl;
+      std::cerr << "  Bad argument " << optarg_ << std::endl << std::endl;
+      return false;
+    }
+
+    if (m_repetitions == 0) {
+      std::cerr << "ERROR: the number of repetitions must be positive" << std::endl;
+      return false;
+    }
+
+    if (!m_budgetFile.empty() && !readBudgets()) {
+      std::cerr << "ERROR: cannot read the budget file " << m_budgetFile << std::endl;
+      return false;
+    }
+
+    if (!m_list) {
+      std::cout << m_name << ": " << m_warmup << " warmup, " << m_repetitions << " repetitions, seed " << m_seed
+                << std::endl;
+      std::cout << std::left << std::setw(56) << "name" << std::right << std::setw(11) << "min (ms)" << std::setw(11)
+                << "median" << std::setw(11) << "p90" << std::setw(11) << "p99" << std::setw(11) << "max" << std::endl;
+    }
+
+    return true;
+  }
+
+  /*!
+    Fill \e I with a synthetic scene made of random rectangles over a
+    gradient, with a small noise. Two calls with the same \e seed give the
+    same image.
+  */
+  static void generateImage(vpImage<unsigned char> &I, unsigned int height, unsigned int width, long seed)
+  {
+    vpUniRand rng(seed);
+    I.resize(height, width);
+    for (unsigned int i = 0; i < height; i++) {
+      for (unsigned int j = 0; j < width; j++) {
+        I[i][j] = (unsigned char)(64 + (128 * (i + j)) / (height + width));
+      }
+    }
+
+    for (unsigned int k = 0; k < 50; k++) {
+      unsigned int top = (unsigned int)(rng() * height), left = (unsigned int)(rng() * width);
+      unsigned int bottom = std::min(height, top + 1 + (unsigned int)(rng() * height / 4));
+      unsigned int right = std::min(width, left + 1 + (unsigned int)(rng() * width / 4));
+      unsigned char value = (unsigned char)(rng() * 256);
+      for (unsigned int i = top; i < bottom; i++) {
+        for (unsigned int j = left; j < right; j++) {
+          I[i][j] = value;
+        }
+      }
+    }
+
+    for (unsigned int i = 0; i < I.getSize(); i++) {
+      I.bitmap[i] = vpMath::saturate<unsigned char>(I.bitmap[i] + 8 * (rng() - 0.5));
+    }
+  }
+
+  //! Color version of generateImage(), each channel being drawn from its own seed.
+  static void generateImage(vpImage<vpRGBa> &I, unsigned int height, unsigned int width, long seed)
+  {
+    vpImage<unsigned char> R, G, B;
+    generateImage(R, height, width, seed);
+    generateImage(G, height, width, seed + 1);
+    generateImage(B, height, width, seed + 2);
+    I.resize(height, width);
+    for (unsigned int i = 0; i < I.getSize(); i++) {
+      I.bitmap[i] = vpRGBa(R.bitmap[i], G.bitmap[i], B.bitmap[i], vpRGBa::alpha_default);
+    }
+  }
+
+  //! Seed to use to generate the synthetic inputs.
+  long getSeed() const { return m_seed; }
+  //! Location of the ViSP-images data set, empty if unknown.
+  std::string getInputPath() const { return m_ipath; }
+
+  /*!
+    Return true if the benchmark \e name has to be run, i.e. if it matches the
+    -f filter and if the -l option that only lists the benchmarks is not set.
+    Useful to avoid preparing the inputs of a benchmark that is not run.
+  */
+  bool isEnabled(const std::string &name)
+  {
+    if (!m_filter.empty() && name.find(m_filter) == std::string::npos)
+      return false;
+    if (m_list) {
+      std::cout << name << std::endl;
+      return false;
+    }
+    return true;
+  }
+
+  /*!
+    Measure the functor \e f. \e nbItems is the number of items (frames,
+    points...) processed by one call, used to report the time per item.
+  */
+  template <class Functor> void run(const std::string &name, Functor &f, unsigned int nbItems = 1)
+  {
+    if (!isEnabled(name))
+      return;
+
+    for (unsigned int i = 0; i < m_warmup; i++) {
+      f();
+    }
+
+    std::vector<double> durations(m_repetitions);
+    for (unsigned int i = 0; i < m_repetitions; i++) {
+      double t = vpTime::measureTimeMs();
+      f();
+      durations[i] = vpTime::measureTimeMs() - t;
+    }
+
+    Result result;
+    result.name = name;
+    result.nbItems = nbItems;
+    result.computeStatistics(durations);
+    print(result);
+    m_results.push_back(result);
+  }
+
+  //! Record that the benchmark \e name could not be run.
+  void skip(const std::string &name, const std::string &reason)
+  {
+    if (!isEnabled(name))
+      return;
+
+    Result result;
+    result.name = name;
+    result.skipped = reason;
+    print(result);
+    m_results.push_back(result);
+  }
+
+  /*!
+    Write the JSON file and check the budgets. Return EXIT_FAILURE if a budget
+    is exceeded, if a budget does not match any benchmark or if the JSON file
+    cannot be written, EXIT_SUCCESS otherwise.
+  */
+  int finish()
+  {
+    bool success = true;
+    for (std::map<std::string, double>::const_iterator it = m_budgets.begin(); it != m_budgets.end(); ++it) {
+      bool found = false;
+      for (size_t i = 0; i < m_results.size(); i++) {
+        if (m_results[i].name != it->first)
+          continue;
+        found = true;
+        if (m_results[i].skipped.empty() && m_results[i].median > it->second) {
+          std::cerr << "Budget exceeded for " << it->first << ": median " << m_results[i].median << " ms > "
+                    << it->second << " ms" << std::endl;
+          success = false;
+        }
+      }
+
+      // A budget of a benchmark that was not filtered out has to match a
+      // result, otherwise a typo or a renamed benchmark would go unnoticed
+      if (!found && !m_list && (m_filter.empty() || it->first.find(m_filter) != std::string::npos)) {
+        std::cerr << "Budget " << it->first << " does not match any benchmark" << std::endl;
+        success = false;
+      }
+    }
+
+    if (!m_jsonFile.empty() && !m_list) {
+      if (!writeJson()) {
+        std::cerr << "ERROR: cannot write " << m_jsonFile << std::endl;
+        success = false;
+      } else {
+        std::cout << "Results saved in " << m_jsonFile << std::endl;
+      }
+    }
+
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
+private:
+  struct Result {
+    Result()
+      : name(), skipped(), nbItems(1), min(0.), mean(0.), median(0.), stdev(0.), p90(0.), p99(0.), max(0.)
+    {
+    }
+
+    void computeStatistics(std::vector<double> &durations)
+    {
+      std::sort(durations.begin(), durations.end());
+      size_t n = durations.size();
+      min = durations.front();
+      max = durations.back();
+      median = (n % 2) ? durations[n / 2] : 0.5 * (durations[n / 2 - 1] + durations[n / 2]);
+      p90 = percentile(durations, 90.);
+      p99 = percentile(durations, 99.);
+
+      double sum = 0.;
+      for (size_t i = 0; i < n; i++)
+        sum += durations[i];
+      mean = sum / n;
+
+      double sum2 = 0.;
+      for (size_t i = 0; i < n; i++)
+        sum2 += (durations[i] - mean) * (durations[i] - mean);
+      stdev = (n > 1) ? sqrt(sum2 / (n - 1)) : 0.;
+    }
+
+    // Nearest-rank percentile of sorted values
+    static double percentile(const std::vector<double> &sorted, double p)
+    {
+      size_t rank = (size_t)ceil(p / 100. * sorted.size());
+      return sorted[rank > 0 ? rank - 1 : 0];
+    }
+
+    std::string name;
+    std::string skipped;
+    unsigned int nbItems;
+    double min, mean, median, stdev, p90, p99, max;
+  };
+
+  void usage(const char *name, const char *badparam) const
+  {
+    fprintf(stdout, "\n\
+Run the %s benchmarks.\n\
+\n\
+SYNOPSIS\n\
+  %s [-r <repetitions>] [-w <warmup>] [-s <seed>] [-f <filter>]\n\
+     [-i <input image path>] [-o <json file>] [-b <budget file>] [-l] [-h]\n",
+            m_name.c_str(), name);
+
+    fprintf(stdout, "\n\
+OPTIONS:                                               Default\n\
+  -r <repetitions>                                     %u\n\
+     Number of measured runs of each benchmark.\n\
+\n\
+  -w <warmup>                                          %u\n\
+     Number of runs done before measuring.\n\
+\n\
+  -s <seed>                                            %ld\n\
+     Seed used to generate the synthetic inputs.\n\
+\n\
+  -f <filter>\n\
+     Only run the benchmarks whose name contains <filter>.\n\
+\n\
+  -i <input image path>                                %s\n\
+     Location of the ViSP-images data set used by some\n\
+     benchmarks. Setting the VISP_INPUT_IMAGE_PATH\n\
+     environment variable produces the same behaviour.\n\
+\n\
+  -o <json file>\n\
+     Save the results in a JSON file.\n\
+\n\
+  -b <budget file>\n\
+     File with lines \"<name> <max median in ms>\". The\n\
+     program fails if a median exceeds its budget or if\n\
+     a name does not match any benchmark.\n\
+\n\
+  -l\n\
+     List the benchmarks without running them.\n\
+\n\
+  -h\n\
+     Print the help.\n\n",
+            m_repetitions, m_warmup, m_seed, m_ipath.c_str());
+
+    if (badparam)
+      fprintf(stdout, "\nERROR: Bad parameter [%s]\n", badparam);
+  }
+
+  bool readBudgets()
+  {
+    std::ifstream file(m_budgetFile.c_str());
+    if (!file.is_open())
+      return false;
+
+    std::string line;
+    while (std::getline(file, line)) {
+      std::istringstream iss(line);
+      std::string name;
+      double budget;
+      if (!(iss >> name) || name[0] == '#')
+        continue;
+      if (!(iss >> budget))
+        return false;
+      m_budgets[name] = budget;
+    }
+
+    return true;
+  }
+
+  void print(const Result &result) const
+  {
+    std::cout << std::left << std::setw(56) << result.name << std::right;
+    if (!result.skipped.empty()) {
+      std::cout << "skipped: " << result.skipped << std::endl;
+      return;
+    }
+    std::cout << std::fixed << std::setprecision(3) << std::setw(11) << result.min << std::setw(11) << result.median
+              << std::setw(11) << result.p90 << std::setw(11) << result.p99 << std::setw(11) << result.max;
+    if (result.nbItems > 1)
+      std::cout << "  (" << 1000. * result.median / result.nbItems << " us/item)";
+    std::cout << std::endl;
+    std::cout.unsetf(std::ios::floatfield);
+  }
+
+  static std::string jsonString(const std::string &s)
+  {
+    std::string str = "\"";
+    for (size_t i = 0; i < s.size(); i++) {
+      if (s[i] == '"' || s[i] == '\\')
+        str += '\\';
+      str += s[i];
+    }
+    return str + "\"";
+  }
+
+  bool writeJson() const
+  {
+    std::ofstream file(m_jsonFile.c_str());
+    if (!file.is_open())
+      return false;
+
+    file << std::setprecision(6);
+    file << "{\n";
+    file << "  \"benchmark\": " << jsonString(m_name) << ",\n";
+    file << "  \"visp_version\": \"" << VISP_VERSION_MAJOR << "." << VISP_VERSION_MINOR << "." << VISP_VERSION_PATCH
+         << "\",\n";
+    file << "  \"seed\": " << m_seed << ",\n";
+    file << "  \"warmup\": " << m_warmup << ",\n";
+    file << "  \"repetitions\": " << m_repetitions << ",\n";
+    file << "  \"results\": [";
+    for (size_t i = 0; i < m_results.size(); i++) {
+      const Result &r = m_results[i];
+      file << (i ? ",\n" : "\n") << "    {\"name\": " << jsonString(r.name);
+      if (!r.skipped.empty()) {
+        file << ", \"skipped\": " << jsonString(r.skipped) << "}";
+        continue;
+      }
+      file << ", \"items\": " << r.nbItems << ", \"min_ms\": " << r.min << ", \"mean_ms\": " << r.mean
+           << ", \"stdev_ms\": " << r.stdev << ", \"median_ms\": " << r.median << ", \"p90_ms\": " << r.p90
+           << ", \"p99_ms\": " << r.p99 << ", \"max_ms\": " << r.max << ", \"median_per_item_ms\": " << r.median / r.nbItems;
+      std::map<std::string, double>::const_iterator it = m_budgets.find(r.name);
+      if (it != m_budgets.end())
+        file << ", \"budget_ms\": " << it->second << ", \"within_budget\": " << (r.median <= it->second ? "true" : "false");
+      file << "}";
+    }
+    file << "\n  ]\n}\n";
+
+    return file.good();
+  }
+
+  std::string m_name;
+  unsigned int m_warmup;
+  unsigned int m_repetitions;
+  long m_seed;
+  std::string m_filter;
+  std::string m_ipath;
+  std::string m_jsonFile;
+  std::string m_budgetFile;
+  bool m_list;
+  std::map<std::string, double> m_budgets;
+  std::vector<Result> m_results;
+};
+
+#endif
@@ -0,0 +1,184 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Example of the sparse revised simplex
+ *
+ *****************************************************************************/
+/*!
+  \file linprog_sparse.cpp
+
+  \brief Example of the sparse revised simplex on a task allocation problem
+*/
+
+/*!
+  \example linprog_sparse.cpp
+
+  Example of the sparse revised simplex: comparison with the dense simplex on
+  small random programs, then resolution of a task allocation problem with
+  warm start.
+*/
+
+#include <iostream>
+#include <visp3/core/vpConfig.h>
+
+#ifdef VISP_HAVE_CPP11_COMPATIBILITY
+
+#include <visp3/core/vpLinProg.h>
+#include <visp3/core/vpTime.h>
+
+namespace
+{
+double randUniform() { return (2. * rand()) / RAND_MAX - 1; }
+
+vpMatrix randM(int n, int m)
+{
+  vpMatrix M(n, m);
+  for (int i = 0; i < n; ++i)
+    for (int j = 0; j < m; ++j)
+      M[i][j] = randUniform();
+  return M;
+}
+}
+
+int main (int argc, char **argv)
+{
+  for (int i = 0; i < argc; i++) {
+    if (std::string(argv[i]) == "-h") {
+      std::cout << "\nUsage: " << argv[0] << " [-h]" << std::endl;
+      return EXIT_SUCCESS;
+    }
+  }
+  std::srand((long) vpTime::measureTimeMs());
+  const double tol = 1e-6;
+
+  // small random programs, compared to the dense solver
+  for(int k = 0; k < 100; ++k)
+  {
+    const int n = 30, m = 10;
+    vpMatrix A = randM(m, n);
+    vpColVector x0(n), c(n), l(n), u(n);
+    std::vector<vpLinProg::BoundedIndex> lb, ub;
+    for(int j = 0; j < n; ++j)
+    {
+      x0[j] = (1. + rand())/RAND_MAX;
+      c[j] = randUniform();
+      l[j] = 0;
+      u[j] = 1 + (1. * rand())/RAND_MAX;
+      lb.push_back({j, l[j]});
+      ub.push_back({j, u[j]});
+    }
+    const vpColVector b = A*x0;
+
+    vpColVector x, x_sparse;
+    std::vector<unsigned int> basis;
+    if(!vpLinProg::solveLP(c, A, b, vpMatrix(), vpColVector(), x, lb, ub, tol) ||
+       !vpLinProg::revisedSimplex(c, vpLinProg::SparseMatrix(A), b, l, u, x_sparse, basis, tol))
+    {
+      std::cout << "Solver failed on random program " << k << std::endl;
+      return EXIT_FAILURE;
+    }
+    const double cost = c.t()*x, cost_sparse = c.t()*x_sparse;
+    if(std::fabs(cost - cost_sparse) > 1e-4*(1+std::fabs(cost)) ||
+       !vpLinProg::allClose(A, x_sparse, b, 1e-5) ||
+       !vpLinProg::allGreater(x_sparse - l, -1e-6) || !vpLinProg::allLesser(x_sparse - u, 1e-6))
+    {
+      std::cout << "Random program " << k << ": sparse cost " << cost_sparse << " instead of " << cost << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  std::cout << "Sparse and dense solvers agree on random programs" << std::endl;
+
+  // task allocation: x[T*r+t] is the part of task t done by robot r
+  // each task is done once, each robot has a limited capacity
+  const unsigned int R = 40, T = 100;
+  const unsigned int n = R*T + R, m = T + R;
+  vpLinProg::SparseMatrix A(m, n);
+  vpColVector c(n), b(m, 1), l(n), u(n, 1);
+  for(unsigned int r = 0; r < R; ++r)
+  {
+    for(unsigned int t = 0; t < T; ++t)
+    {
+      c[T*r+t] = (1. * rand())/RAND_MAX;
+      A.add(t, T*r+t, 1);
+      A.add(T+r, T*r+t, 1);
+    }
+    // slack variable on the capacity
+    A.add(T+r, R*T+r, 1);
+    b[T+r] = u[R*T+r] = 3;
+  }
+
+  vpColVector x;
+  std::vector<unsigned int> basis;
+  double t = vpTime::measureTimeMs();
+  if(!vpLinProg::revisedSimplex(c, A, b, l, u, x, basis, tol))
+  {
+    std::cout << "Task allocation failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Task allocation with " << n << " variables: " << vpTime::measureTimeMs() - t << " ms, cost "
+            << c.t()*x << std::endl;
+
+  // new costs, warm start from the previous basis
+  for(unsigned int j = 0; j < R*T; ++j)
+    c[j] += 0.01*randUniform();
+  t = vpTime::measureTimeMs();
+  vpColVector x_warm = x;
+  std::vector<unsigned int> basis_warm = basis;
+  if(!vpLinProg::revisedSimplex(c, A, b, l, u, x_warm, basis_warm, tol))
+  {
+    std::cout << "Task allocation failed with warm start" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "With warm start: " << vpTime::measureTimeMs() - t << " ms, cost " << c.t()*x_warm << std::endl;
+  basis.clear();
+  t = vpTime::measureTimeMs();
+  if(!vpLinProg::revisedSimplex(c, A, b, l, u, x, basis, tol))
+  {
+    std::cout << "Task allocation failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Without warm start: " << vpTime::measureTimeMs() - t << " ms, cost " << c.t()*x << std::endl;
+  if(std::fabs(c.t()*x - c.t()*x_warm) > 1e-6*n)
+  {
+    std::cout << "Warm start leads to a different cost" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+#else
+int main()
+{
+  std::cout << "You did not build ViSP with C++11 compiler flag" << std::endl;
+  std::cout << "Tip:" << std::endl;
+  std::cout << "- Configure ViSP again using cmake -DUSE_CPP11=ON, and build again this example" << std::endl;
+  return EXIT_SUCCESS;
+}
+#endif
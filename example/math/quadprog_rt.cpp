@@ -0,0 +1,180 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Example of the real-time QP solver
+ *
+ *****************************************************************************/
+/*!
+  \file quadprog_rt.cpp
+
+  \brief Example of the real-time QP solver with preallocated workspace
+*/
+
+/*!
+  \example quadprog_rt.cpp
+
+  Example of the real-time QP solver with preallocated workspace, compared to
+  sequential calls to solveQPi()
+*/
+
+#include <iostream>
+#include <visp3/core/vpConfig.h>
+
+#ifdef VISP_HAVE_CPP11_COMPATIBILITY
+
+#include <visp3/core/vpQuadProg.h>
+#include <visp3/core/vpTime.h>
+
+#include "qp_plot.h"
+
+int main (int argc, char **argv)
+{
+  const int n = 12;   // x dim, e.g. joint velocities of a redundant robot
+  const int p = 30;   // inequality
+  const int o = 6;    // cost function, e.g. task dimension
+  bool opt_display = true;
+
+  for (int i = 0; i < argc; i++) {
+    if (std::string(argv[i]) == "-d")
+      opt_display = false;
+    else if (std::string(argv[i]) == "-h") {
+      std::cout << "\nUsage: " << argv[0] << " [-d] [-h]" << std::endl;
+      std::cout << "\nOptions: \n"
+                   "  -d \n"
+                   "     Disable the image display. This can be useful \n"
+                   "     for automatic tests using crontab under Unix or \n"
+                   "     using the task manager under Windows.\n"
+                   "\n"
+                   "  -h\n"
+                   "     Print the help.\n"<< std::endl;
+
+      return EXIT_SUCCESS;
+    }
+  }
+  std::srand((long) vpTime::measureTimeMs());
+
+  vpMatrix Q, C;
+  vpColVector d, r;
+
+  Q = randM(o,n)*5;
+  r = randV(o)*5;
+  C = randM(p,n)*5;
+
+  // x = 0 is feasible
+  d.resize(p);
+  for(int i = 0; i < p; ++i)
+    d[i] = 1 + (5.*rand())/RAND_MAX;
+
+  // real-time solver
+  vpQuadProg qp_RT;
+  qp_RT.initRealTime(n, p);
+
+  // timing
+  int total = 1000;
+  double t, t_RT(0), t_QPi(0);
+  unsigned int iterations = 0, warm_starts = 0;
+  const double eps = 1e-2;
+
+#ifdef VISP_HAVE_DISPLAY
+  QPlot *plot = NULL;
+  if (opt_display)
+    plot = new QPlot(1, total, {"time to solve QP", "real-time solver"});
+#endif
+
+  vpColVector x, x_RT;
+  for(int k = 0; k < total; ++k)
+  {
+    // small change on QP data
+    Q += eps * randM(o,n);
+    r += eps * randV(o);
+    C += eps * randM(p,n);
+    d += eps * randV(p);
+
+    // solver without preallocation
+    vpQuadProg qp;
+    t = vpTime::measureTimeMs();
+    qp.solveQPi(Q, r, C, d, x);
+
+    t_QPi += vpTime::measureTimeMs() - t;
+#ifdef VISP_HAVE_DISPLAY
+    if (opt_display)
+      plot->plot(0,0,k,t);
+#endif
+
+    // real-time solver
+    t = vpTime::measureTimeMs();
+    if(!qp_RT.solveQPiRealTime(Q, r, C, d, x_RT))
+    {
+      std::cout << "Real-time solver failed at iteration " << k << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    t_RT += qp_RT.getSolveTime();
+    iterations += qp_RT.getIterations();
+    if(qp_RT.isWarmStarted())
+      warm_starts++;
+#ifdef VISP_HAVE_DISPLAY
+    if (opt_display)
+      plot->plot(0, 1, k, t);
+#endif
+
+    // the real-time solution should be feasible and at least as good
+    const double cost = (Q*x - r).sumSquare(), cost_RT = (Q*x_RT - r).sumSquare();
+    if(cost_RT > cost + 1e-4*(1+cost) || !vpLinProg::allLesser(C, x_RT, d, 1e-5))
+    {
+      std::cout << "Real-time solver is not optimal at iteration " << k << ": cost " << cost_RT
+                << " instead of " << cost << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::cout.precision(3);
+  std::cout << "Real-time: t = " << t_RT << " ms (for 1 QP = " << t_RT/total << " ms, "
+            << (double)iterations/total << " iterations, " << warm_starts << " warm starts)\n";
+  std::cout << "solveQPi: t = " << t_QPi << " ms (for 1 QP = " << t_QPi/total << " ms)" << std::endl;
+
+#ifdef VISP_HAVE_DISPLAY
+  if (opt_display) {
+    plot->wait();
+    delete plot;
+  }
+#endif
+  return EXIT_SUCCESS;
+}
+#else
+int main()
+{
+  std::cout << "You did not build ViSP with C++11 compiler flag" << std::endl;
+  std::cout << "Tip:" << std::endl;
+  std::cout << "- Configure ViSP again using cmake -DUSE_CPP11=ON, and build again this example" << std::endl;
+  return EXIT_SUCCESS;
+}
+#endif
@@ -247,6 +247,8 @@ public:
   void init(unsigned int height, unsigned int width, Type value);
   //! init from an image stored as a continuous array in memory
   void init(Type *const array, const unsigned int height, const unsigned int width, const bool copyData = false);
+  //! init as a view on an external array, that is not released
+  void initView(Type *const array, const unsigned int height, const unsigned int width);
   void insert(const vpImage<Type> &src, const vpImagePoint &topLeft);
 
   //------------------------------------------------------------------
@@ -347,6 +349,7 @@ private:
   unsigned int width;   ///! number of columns
   unsigned int height;  ///! number of rows
   Type **row;           ///! points the row pointer array
+  bool hasOwnership;    ///! false if the bitmap is an external array that is not released, see initView()
 };
 
 template <class Type> std::ostream &operator<<(std::ostream &s, const vpImage<Type> &I)
@@ -667,10 +670,12 @@ template <class Type> void vpImage<Type>::init(unsigned int h, unsigned int w)
     }
   }
 
-  if ((h != this->height) || (w != this->width)) {
+  // An external array is never modified, a new bitmap is allocated
+  if ((h != this->height) || (w != this->width) || !hasOwnership) {
     if (bitmap != NULL) {
       vpDEBUG_TRACE(10, "Destruction bitmap[]");
-      delete[] bitmap;
+      if (hasOwnership)
+        delete[] bitmap;
       bitmap = NULL;
     }
   }
@@ -680,8 +685,10 @@ template <class Type> void vpImage<Type>::init(unsigned int h, unsigned int w)
 
   npixels = width * height;
 
-  if (bitmap == NULL)
+  if (bitmap == NULL) {
     bitmap = new Type[npixels];
+    hasOwnership = true;
+  }
 
   if (bitmap == NULL) {
     throw(vpException(vpException::memoryAllocationError, "cannot allocate bitmap "));
@@ -706,7 +713,8 @@ template <class Type> void vpImage<Type>::init(unsigned int h, unsigned int w)
   \param h : Image height.
   \param w : Image width.
   \param copyData : If false (by default) only the memory address is copied,
-  otherwise the data are copied.
+  otherwise the data are copied. Without copy, the image takes the ownership
+  of the array, allocated with new[], see initView() to only refer to it.
 
   \exception vpException::memoryAllocationError
 */
@@ -721,9 +729,11 @@ void vpImage<Type>::init(Type *const array, const unsigned int h, const unsigned
   }
 
   // Delete bitmap if copyData==false, otherwise only if the dimension differs
-  if ((copyData && ((h != this->height) || (w != this->width))) || !copyData) {
+  // or if it is an external array
+  if ((copyData && ((h != this->height) || (w != this->width) || !hasOwnership)) || !copyData) {
     if (bitmap != NULL) {
-      delete[] bitmap;
+      if (hasOwnership)
+        delete[] bitmap;
       bitmap = NULL;
     }
   }
@@ -734,8 +744,10 @@ void vpImage<Type>::init(Type *const array, const unsigned int h, const unsigned
   npixels = width * height;
 
   if (copyData) {
-    if (bitmap == NULL)
+    if (bitmap == NULL) {
       bitmap = new Type[npixels];
+      hasOwnership = true;
+    }
 
     if (bitmap == NULL) {
       throw(vpException(vpException::memoryAllocationError, "cannot allocate bitmap "));
@@ -744,8 +756,10 @@ void vpImage<Type>::init(Type *const array, const unsigned int h, const unsigned
     // Copy the image data
     memcpy(bitmap, array, (size_t)(npixels * sizeof(Type)));
   } else {
-    // Copy the address of the array in the bitmap
+    // Copy the address of the array in the bitmap, that is released by the
+    // image
     bitmap = array;
+    hasOwnership = true;
   }
 
   if (row == NULL)
@@ -759,6 +773,27 @@ void vpImage<Type>::init(Type *const array, const unsigned int h, const unsigned
   }
 }
 
+/*!
+  \brief Image initialization
+
+  Init the image as a view on an external array, without any copy. Unlike
+  init(array, height, width), the image does not take the ownership of the
+  array: it is never released nor written past its size by the image, that
+  allocates its own bitmap if it is resized. The array has to remain valid
+  as long as the image refers to it.
+
+  \param array : Image data stored as a continuous array in memory.
+  \param h : Image height.
+  \param w : Image width.
+
+  \exception vpException::memoryAllocationError
+*/
+template <class Type> void vpImage<Type>::initView(Type *const array, const unsigned int h, const unsigned int w)
+{
+  init(array, h, w, false);
+  hasOwnership = false;
+}
+
 /*!
   \brief Constructor
 
@@ -779,7 +814,7 @@ void vpImage<Type>::init(Type *const array, const unsigned int h, const unsigned
 */
 template <class Type>
 vpImage<Type>::vpImage(unsigned int h, unsigned int w)
-  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL)
+  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), hasOwnership(true)
 {
   init(h, w, 0);
 }
@@ -803,7 +838,7 @@ vpImage<Type>::vpImage(unsigned int h, unsigned int w)
 */
 template <class Type>
 vpImage<Type>::vpImage(unsigned int h, unsigned int w, Type value)
-  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL)
+  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), hasOwnership(true)
 {
   init(h, w, value);
 }
@@ -817,7 +852,8 @@ vpImage<Type>::vpImage(unsigned int h, unsigned int w, Type value)
   \param h : Image height.
   \param w : Image width.
   \param copyData : If false (by default) only the memory address is copied,
-  otherwise the data are copied.
+  otherwise the data are copied. Without copy, the image takes the ownership
+  of the array, allocated with new[], see initView() to only refer to it.
 
   \return MEMORY_FAULT if memory allocation is impossible, else OK
 
@@ -825,7 +861,7 @@ vpImage<Type>::vpImage(unsigned int h, unsigned int w, Type value)
 */
 template <class Type>
 vpImage<Type>::vpImage(Type *const array, const unsigned int h, const unsigned int w, const bool copyData)
-  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL)
+  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), hasOwnership(true)
 {
   init(array, h, w, copyData);
 }
@@ -839,7 +875,8 @@ vpImage<Type>::vpImage(Type *const array, const unsigned int h, const unsigned i
 
   \sa vpImage::resize(height, width) for memory allocation
 */
-template <class Type> vpImage<Type>::vpImage() : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL)
+template <class Type>
+vpImage<Type>::vpImage() : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), hasOwnership(true)
 {
 }
 
@@ -899,7 +936,8 @@ template <class Type> void vpImage<Type>::destroy()
   if (bitmap != NULL) {
     //  vpERROR_TRACE("Deallocate bitmap memory %p",bitmap);
     //    vpDEBUG_TRACE(20,"Deallocate bitmap memory %p",bitmap);
-    delete[] bitmap;
+    if (hasOwnership)
+      delete[] bitmap;
     bitmap = NULL;
   }
 
@@ -923,7 +961,8 @@ template <class Type> vpImage<Type>::~vpImage() { destroy(); }
   Copy constructor
 */
 template <class Type>
-vpImage<Type>::vpImage(const vpImage<Type> &I) : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL)
+vpImage<Type>::vpImage(const vpImage<Type> &I)
+  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), hasOwnership(true)
 {
   resize(I.getHeight(), I.getWidth());
   memcpy(bitmap, I.bitmap, I.npixels * sizeof(Type));
@@ -935,7 +974,8 @@ vpImage<Type>::vpImage(const vpImage<Type> &I) : bitmap(NULL), display(NULL), np
 */
 template <class Type>
 vpImage<Type>::vpImage(vpImage<Type> &&I)
-  : bitmap(I.bitmap), display(I.display), npixels(I.npixels), width(I.width), height(I.height), row(I.row)
+  : bitmap(I.bitmap), display(I.display), npixels(I.npixels), width(I.width), height(I.height), row(I.row),
+    hasOwnership(I.hasOwnership)
 {
   I.bitmap = NULL;
   I.display = NULL;
@@ -943,6 +983,7 @@ vpImage<Type>::vpImage(vpImage<Type> &&I)
   I.width = 0;
   I.height = 0;
   I.row = NULL;
+  I.hasOwnership = true;
 }
 #endif
 
@@ -1973,6 +2014,7 @@ template <class Type> void swap(vpImage<Type> &first, vpImage<Type> &second)
   swap(first.width, second.width);
   swap(first.height, second.height);
   swap(first.row, second.row);
+  swap(first.hasOwnership, second.hasOwnership);
 }
 
 #endif
@@ -39,8 +39,11 @@
 #ifndef vpLinProgh
 #define vpLinProgh
 
+#include <utility>
+#include <vector>
 #include <visp3/core/vpConfig.h>
 #include <visp3/core/vpColVector.h>
+#include <visp3/core/vpException.h>
 #include <visp3/core/vpMatrix.h>
 
 /*!
@@ -55,6 +58,10 @@
 
   One is a classical simplex, the other can deal with various inequality or bound constraints.
 
+  For larger programs, revisedSimplex() works on a sparse representation of the equality constraints
+  (vpLinProg::SparseMatrix), handles lower and upper bounds on the variables without additional constraints
+  and can be warm started from the basis of a previous call.
+
   Utility functions to reduce or check linear equalities or inequalities are also available.
 
   \warning The solvers are only available if C++11 is activated during compilation. Configure ViSP using cmake -DUSE_CPP11=ON.
@@ -117,6 +124,62 @@ The type is compatible with C++11's braced initialization.
   */
   typedef std::pair<unsigned int, double> BoundedIndex;
 
+  /*!
+    Sparse matrix in column storage, used to pass the equality constraints to revisedSimplex().
+
+    Only the non-zero elements are stored, as a list of (row index, value) for each column.
+
+    \code
+    vpLinProg::SparseMatrix A(2, 1000);
+    A.add(0, 10, 1.);
+    A.add(1, 999, -2.);
+    \endcode
+
+    \warning This class is only available if C++11 is activated during compilation. Configure ViSP using cmake -DUSE_CPP11=ON.
+  */
+  class SparseMatrix
+  {
+  public:
+    /*!
+      Builds an empty (all zero) sparse matrix.
+    */
+    SparseMatrix(unsigned int rows = 0, unsigned int cols = 0) : nrows(rows), columns(cols) {}
+    /*!
+      Builds a sparse matrix from the elements of A whose absolute value is greater than tol.
+    */
+    explicit SparseMatrix(const vpMatrix &A, const double &tol = 0) : nrows(A.getRows()), columns(A.getCols())
+    {
+      for(unsigned int j = 0; j < A.getCols(); ++j)
+      {
+        for(unsigned int i = 0; i < A.getRows(); ++i)
+        {
+          if(std::abs(A[i][j]) > tol)
+            columns[j].push_back({i, A[i][j]});
+        }
+      }
+    }
+    /*!
+      Adds the element (i, j) with value v. The element should not have been added yet.
+    */
+    void add(unsigned int i, unsigned int j, const double &v)
+    {
+      if(i >= nrows || j >= columns.size())
+        throw(vpException(vpException::dimensionError, "vpLinProg::SparseMatrix::add: (%u, %u) out of a %ux%u matrix",
+                          i, j, nrows, (unsigned int)columns.size()));
+      columns[j].push_back({i, v});
+    }
+    /*!
+      Non-zero elements of the column j, as (row index, value).
+    */
+    const std::vector<std::pair<unsigned int, double> > &getCol(unsigned int j) const { return columns[j]; }
+    unsigned int getRows() const { return nrows; }
+    unsigned int getCols() const { return (unsigned int)columns.size(); }
+
+  private:
+    unsigned int nrows;
+    std::vector<std::vector<std::pair<unsigned int, double> > > columns;
+  };
+
   /** @name Solvers  */
   //@{
   static bool simplex(const vpColVector &c, vpMatrix A, vpColVector b,
@@ -128,6 +191,10 @@ The type is compatible with C++11's braced initialization.
                       std::vector<BoundedIndex> u = {},
                       const double &tol = 1e-6);
 
+  static bool revisedSimplex(const vpColVector &c, const SparseMatrix &A, const vpColVector &b,
+                             const vpColVector &l, const vpColVector &u, vpColVector &x,
+                             std::vector<unsigned int> &basis, const double &tol = 1e-6);
+
   //@}
 #endif
 
@@ -0,0 +1,110 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Memory-mapped file.
+ *
+ *****************************************************************************/
+
+#ifndef vpMappedFile_h
+#define vpMappedFile_h
+
+/*!
+  \file vpMappedFile.h
+  \brief Memory-mapped file.
+*/
+
+#include <string>
+
+#include <visp3/core/vpConfig.h>
+
+/*!
+  \class vpMappedFile
+
+  \ingroup group_core_files_io
+
+  \brief Map the content of a file in memory.
+
+  The file is mapped with mmap() on Unix-like systems and with a file mapping
+  object under Windows, so that opening a large file is immediate and that
+  its pages are only read from the disk when they are accessed. On the other
+  platforms, or when the mapping fails, the whole file is read in a buffer.
+
+  The mapping is private: the memory can be modified but the changes are
+  neither visible from other processes nor written back to the file.
+
+  \code
+#include <visp3/core/vpMappedFile.h>
+
+int main()
+{
+  vpMappedFile file("data.bin");
+  const unsigned char *data = file.data();
+  size_t size = file.size();
+  // ...
+}
+  \endcode
+*/
+class VISP_EXPORT vpMappedFile
+{
+public:
+  vpMappedFile();
+  explicit vpMappedFile(const std::string &filename);
+  virtual ~vpMappedFile();
+
+  void close();
+
+  //! Pointer to the content of the file, or NULL if no file is open.
+  inline unsigned char *data() const { return m_data; }
+
+  //! Return true if the file is mapped, false if it was read in a buffer.
+  inline bool isMapped() const { return m_mapped; }
+  //! Return true if a file is open.
+  inline bool isOpen() const { return m_data != NULL; }
+
+  void open(const std::string &filename);
+
+  //! Size of the file in bytes.
+  inline size_t size() const { return m_size; }
+
+private:
+  vpMappedFile(const vpMappedFile &);
+  vpMappedFile &operator=(const vpMappedFile &);
+
+  unsigned char *m_data;
+  size_t m_size;
+  bool m_mapped;
+#if defined(_WIN32)
+  void *m_fileHandle;
+  void *m_mappingHandle;
+#endif
+};
+
+#endif
@@ -0,0 +1,261 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Fixed-size matrix with inline storage.
+ *
+ *****************************************************************************/
+
+#ifndef vpMatrixFixed_h
+#define vpMatrixFixed_h
+
+#include <visp3/core/vpArray2D.h>
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpMatrix.h>
+
+/*!
+  \file vpMatrixFixed.h
+  \brief Definition of the vpMatrixFixed class, a matrix whose size is known
+  at compile time.
+*/
+
+/*!
+  \class vpMatrixFixed
+
+  \ingroup group_core_matrices
+
+  \brief Matrix of R rows and C columns whose size is known at compile time.
+
+  Contrary to vpMatrix and to the classes that inherit from vpArray2D, the
+  elements are stored inside the object (row major, 16 bytes aligned) so that
+  a vpMatrixFixed never allocates memory. The arithmetic operators loop over
+  compile-time bounds that the compiler is able to unroll and vectorize.
+
+  This class is intended for the temporaries of small and frequent
+  computations, typically rigid transformations. It is used internally by
+  vpHomogeneousMatrix and vpVelocityTwistMatrix. A vpMatrixFixed can be built
+  from any vpArray2D<double> of the same size (vpMatrix, vpRotationMatrix,
+  vpTranslationVector...) or from a block of a larger one, is implicitly
+  converted to a vpMatrix, and can be copied back into a vpArray2D<double>
+  with copyTo().
+
+  \code
+#include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpMatrixFixed.h>
+
+int main()
+{
+  vpHomogeneousMatrix cMo(0.1, 0.2, 0.5, 0.1, 0.2, 0.3);
+  vpMatrixFixed<3, 3> R(cMo, 0, 0);   // rotation block
+  vpMatrixFixed<3, 1> t(cMo, 0, 3);   // translation block
+  vpMatrixFixed<3, 1> oX;
+  oX[0][0] = 0.1;
+  vpMatrixFixed<3, 1> cX = R * oX + t;
+  vpMatrix M = cX;                    // back to a dynamic matrix
+}
+  \endcode
+*/
+template <unsigned int R, unsigned int C> class vpMatrixFixed
+{
+public:
+  //! Build a matrix with all the elements set to 0.
+  vpMatrixFixed()
+  {
+    for (unsigned int i = 0; i < R * C; i++)
+      data[i] = 0;
+  }
+
+  /*!
+    Build a matrix from a vpArray2D<double> of the same size.
+
+    \exception vpException::dimensionError : If \e A is not a R-by-C array.
+  */
+  vpMatrixFixed(const vpArray2D<double> &A)
+  {
+    if (A.getRows() != R || A.getCols() != C) {
+      throw(vpException(vpException::dimensionError, "Cannot build a (%dx%d) fixed matrix from a (%dx%d) array", R, C,
+                        A.getRows(), A.getCols()));
+    }
+    for (unsigned int i = 0; i < R * C; i++)
+      data[i] = A.data[i];
+  }
+
+  /*!
+    Build a matrix from the R-by-C block of \e A whose top left element is at
+    row \e r and column \e c.
+
+    \exception vpException::dimensionError : If the block is not inside \e A.
+  */
+  vpMatrixFixed(const vpArray2D<double> &A, unsigned int r, unsigned int c)
+  {
+    if (r + R > A.getRows() || c + C > A.getCols()) {
+      throw(vpException(vpException::dimensionError, "Cannot extract a (%dx%d) block at (%d,%d) from a (%dx%d) array",
+                        R, C, r, c, A.getRows(), A.getCols()));
+    }
+    for (unsigned int i = 0; i < R; i++)
+      for (unsigned int j = 0; j < C; j++)
+        data[i * C + j] = A[r + i][c + j];
+  }
+
+  //! Number of rows.
+  unsigned int getRows() const { return R; }
+  //! Number of columns.
+  unsigned int getCols() const { return C; }
+
+  //! Set element \f$A_{ij} = (*this)[i][j]\f$.
+  inline double *operator[](unsigned int i) { return data + i * C; }
+  //! Get element \f$A_{ij} = (*this)[i][j]\f$.
+  inline const double *operator[](unsigned int i) const { return data + i * C; }
+
+  //! Conversion to a dynamic matrix.
+  operator vpMatrix() const
+  {
+    vpMatrix M(R, C);
+    for (unsigned int i = 0; i < R * C; i++)
+      M.data[i] = data[i];
+    return M;
+  }
+
+  /*!
+    Copy the matrix in \e A, with its top left element at row \e r and
+    column \e c. \e A is not resized.
+
+    \exception vpException::dimensionError : If the matrix does not fit in
+    \e A.
+  */
+  void copyTo(vpArray2D<double> &A, unsigned int r = 0, unsigned int c = 0) const
+  {
+    if (r + R > A.getRows() || c + C > A.getCols()) {
+      throw(vpException(vpException::dimensionError, "Cannot copy a (%dx%d) matrix at (%d,%d) in a (%dx%d) array", R, C,
+                        r, c, A.getRows(), A.getCols()));
+    }
+    for (unsigned int i = 0; i < R; i++)
+      for (unsigned int j = 0; j < C; j++)
+        A[r + i][c + j] = data[i * C + j];
+  }
+
+  //! Set the matrix to identity (ones on the diagonal, zeros elsewhere).
+  void eye()
+  {
+    for (unsigned int i = 0; i < R; i++)
+      for (unsigned int j = 0; j < C; j++)
+        data[i * C + j] = (i == j) ? 1. : 0.;
+  }
+
+  //! Transpose of the matrix.
+  vpMatrixFixed<C, R> t() const
+  {
+    vpMatrixFixed<C, R> At;
+    for (unsigned int i = 0; i < R; i++)
+      for (unsigned int j = 0; j < C; j++)
+        At.data[j * R + i] = data[i * C + j];
+    return At;
+  }
+
+  //! Matrix product.
+  template <unsigned int K> vpMatrixFixed<R, K> operator*(const vpMatrixFixed<C, K> &B) const
+  {
+    vpMatrixFixed<R, K> AB;
+    for (unsigned int i = 0; i < R; i++) {
+      for (unsigned int k = 0; k < C; k++) {
+        const double a = data[i * C + k];
+        for (unsigned int j = 0; j < K; j++)
+          AB.data[i * K + j] += a * B.data[k * K + j];
+      }
+    }
+    return AB;
+  }
+
+  //! Sum of two matrices.
+  vpMatrixFixed operator+(const vpMatrixFixed &B) const
+  {
+    vpMatrixFixed A(*this);
+    return A += B;
+  }
+
+  //! Difference of two matrices.
+  vpMatrixFixed operator-(const vpMatrixFixed &B) const
+  {
+    vpMatrixFixed A(*this);
+    return A -= B;
+  }
+
+  //! Opposite of the matrix.
+  vpMatrixFixed operator-() const
+  {
+    vpMatrixFixed A;
+    for (unsigned int i = 0; i < R * C; i++)
+      A.data[i] = -data[i];
+    return A;
+  }
+
+  //! Multiply all the elements by a scalar.
+  vpMatrixFixed operator*(double x) const
+  {
+    vpMatrixFixed A(*this);
+    return A *= x;
+  }
+
+  //! Add \e B to the matrix.
+  vpMatrixFixed &operator+=(const vpMatrixFixed &B)
+  {
+    for (unsigned int i = 0; i < R * C; i++)
+      data[i] += B.data[i];
+    return *this;
+  }
+
+  //! Subtract \e B from the matrix.
+  vpMatrixFixed &operator-=(const vpMatrixFixed &B)
+  {
+    for (unsigned int i = 0; i < R * C; i++)
+      data[i] -= B.data[i];
+    return *this;
+  }
+
+  //! Multiply all the elements by a scalar.
+  vpMatrixFixed &operator*=(double x)
+  {
+    for (unsigned int i = 0; i < R * C; i++)
+      data[i] *= x;
+    return *this;
+  }
+
+  //! Elements of the matrix, stored row after row.
+#if defined(__GNUC__)
+  double data[R * C] __attribute__((aligned(16)));
+#elif defined(_MSC_VER)
+  __declspec(align(16)) double data[R * C];
+#else
+  double data[R * C];
+#endif
+};
+
+#endif
@@ -42,6 +42,7 @@
 #define vpPolygon_h
 
 #include <list>
+#include <utility>
 #include <vector>
 
 #include <visp3/core/vpCameraParameters.h>
@@ -142,6 +143,11 @@ public:
                  unsigned int thickness = 1);
 
   bool isInside(const vpImagePoint &iP, const PointInPolygonMethod &method = PnPolyRayCasting) const;
+  void isInside(const std::vector<vpImagePoint> &iPs, std::vector<bool> &inside) const;
+
+  void getRowSpans(unsigned int i, unsigned int left, unsigned int right,
+                   std::vector<std::pair<unsigned int, unsigned int> > &spans) const;
+  void fillMask(vpImage<unsigned char> &mask, unsigned char value = 255) const;
 
   void display(const vpImage<unsigned char> &I, const vpColor &color, unsigned int thickness = 1) const;
 
@@ -198,6 +204,30 @@ private:
 public:
   static bool isInside(const std::vector<vpImagePoint> &roi, const double &i, const double &j,
                        const PointInPolygonMethod &method = PnPolyRayCasting);
+  static void fillMask(const std::vector<vpPolygon> &polygons, vpImage<unsigned char> &mask,
+                       unsigned char value = 255);
+
+  /*!
+    Check if the column \e j is inside one of the spans of a row computed by
+    getRowSpans(). The columns have to be visited in increasing order, \e
+    spanIndex keeping the current span from one call to the next one.
+
+    \param spans : Spans of the row computed by getRowSpans().
+    \param j : Column index.
+    \param spanIndex : Index of the current span, to set to 0 before the
+    first column of the row.
+
+    \return true if the column is inside a span.
+  */
+  static inline bool isInsideRowSpans(const std::vector<std::pair<unsigned int, unsigned int> > &spans, unsigned int j,
+                                      size_t &spanIndex)
+  {
+    while (spanIndex < spans.size() && spans[spanIndex].second <= j) {
+      spanIndex++;
+    }
+
+    return spanIndex < spans.size() && spans[spanIndex].first <= j;
+  }
 };
 
 #endif
@@ -68,6 +68,12 @@
   In order to be used sequentially, the decomposition of the equality constraint may be stored.
   The last active set is always stored and used to warm start the next call.
 
+  For real-time loops where the problem dimensions do not change between two calls, initRealTime() preallocates
+  the workspace of solveQPiRealTime(), that does not allocate memory when a feasible warm start is available.
+  The previous solution and active set are used as a starting point, and the factorization of the working set
+  is updated incrementally when a constraint enters or leaves it. The number of iterations and the computation
+  time of the last call are available with getIterations() and getSolveTime().
+
   \warning The solvers are only available if C++11 is activated during compilation. Configure ViSP using cmake -DUSE_CPP11=ON.
 */
 class VISP_EXPORT vpQuadProg
@@ -103,6 +109,27 @@ public:
   }
   //@}
 
+  /** @name Real-time solver with preallocated workspace  */
+  //@{
+  void initRealTime(unsigned int n, unsigned int p, const double &regularization = 1e-9);
+  bool solveQPiRealTime(const vpMatrix &Q, const vpColVector &r,
+                        const vpMatrix &C, const vpColVector &d,
+                        vpColVector &x, const double &tol = 1e-6);
+  /*!
+    Number of active set iterations performed by the last call to solveQPiRealTime().
+  */
+  unsigned int getIterations() const { return rt_iterations; }
+  /*!
+    Computation time in ms of the last call to solveQPiRealTime().
+  */
+  double getSolveTime() const { return rt_time; }
+  /*!
+    True if the last call to solveQPiRealTime() started from the previous solution or from 0, false if a feasible
+    point had to be computed with the simplex.
+  */
+  bool isWarmStarted() const { return rt_warmStart; }
+  //@}
+
   static void fromCanonicalCost(const vpMatrix &H, const vpColVector &c, vpMatrix &Q, vpColVector &r, const double &tol = 1e-6);
   static bool solveQPe(const vpMatrix &Q, const vpColVector &r,
                 vpMatrix A, vpColVector b,
@@ -126,6 +153,43 @@ protected:
   */
   vpMatrix Z;
 
+  /*!
+    Dimensions of the problem solved by solveQPiRealTime(), set by initRealTime().
+  */
+  unsigned int rt_n = 0, rt_p = 0;
+  /*!
+    Relative regularization added to the diagonal of \f$\mathbf{Q}^T\mathbf{Q}\f$ in solveQPiRealTime().
+  */
+  double rt_regularization = 1e-9;
+  /*!
+    Workspace of solveQPiRealTime(): Hessian \f$\mathbf{H} = \mathbf{Q}^T\mathbf{Q}\f$, its Cholesky factor
+    \f$\mathbf{L}\f$, \f$\mathbf{V} = \mathbf{L}^{-1}\mathbf{C}_W^T\f$ for the working set W and the triangular
+    factor \f$\mathbf{R}\f$ of \f$\mathbf{V}\f$.
+  */
+  vpMatrix rt_H, rt_L, rt_V, rt_R;
+  /*!
+    Workspace of solveQPiRealTime(): linear cost, gradient, temporaries, step, multipliers and last solution.
+  */
+  vpColVector rt_c, rt_g, rt_w, rt_t, rt_s, rt_lambda, rt_x;
+  /*!
+    Working set of solveQPiRealTime(), in the order of the columns of \f$\mathbf{V}\f$.
+  */
+  std::vector<unsigned int> rt_active, rt_prevActive;
+  std::vector<bool> rt_isActive;
+  /*!
+    Constraints of solveQPiRealTime() left out of the step length, when they are linearly dependent on the working
+    set without being able to replace one of its constraints.
+  */
+  std::vector<bool> rt_isIgnored;
+  bool rt_hasSolution = false;
+  bool rt_warmStart = false;
+  unsigned int rt_iterations = 0;
+  double rt_time = 0;
+
+  bool addRealTimeConstraint(const vpMatrix &C, unsigned int i, const double &tol);
+  void removeRealTimeConstraint(unsigned int k);
+  void computeRealTimeStep();
+
   static bool solveByProjection(const vpMatrix &Q, const vpColVector &r,
                                 vpMatrix &A, vpColVector &b,
                                 vpColVector &x, const double &tol = 1e-6);
@@ -77,6 +77,7 @@ namespace vpTime
 {
 VISP_EXPORT std::string getDateTime(const std::string &format = "%Y/%m/%d %H:%M:%S");
 VISP_EXPORT double getMinTimeForUsleepCall();
+VISP_EXPORT double measureMonotonicTimeMs();
 VISP_EXPORT double measureTimeSecond();
 VISP_EXPORT double measureTimeMs();
 VISP_EXPORT double measureTimeMicros();
@@ -0,0 +1,168 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Tracing of the time spent in the main functions of ViSP.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpTracing.h
+  \brief Tracing of the time spent in the main functions of ViSP.
+*/
+
+#ifndef vpTracing_h
+#define vpTracing_h
+
+#include <iostream>
+#include <string>
+
+#include <visp3/core/vpConfig.h>
+
+/*!
+  \class vpTracing
+  \ingroup group_core_time
+
+  \brief Record of timed spans, that can be saved in the Chrome trace event
+  format to be viewed in chrome://tracing or in https://ui.perfetto.dev.
+
+  A span is the interval of time spent in a scope or between a call to
+  begin() and a call to end(). The spans are recorded in a buffer owned by
+  the thread that runs them, so that recording a span never takes a lock and
+  the spans of the different threads appear on separate tracks. The buffer
+  of a thread has a fixed size, see setBufferSize(): when it is full, the
+  next spans are dropped and counted by getNbDroppedEvents(). Nothing is
+  recorded while the tracing is not started with start().
+
+  The main functions of ViSP (frame grabbers, image conversions, trackers,
+  detectors, pose estimation and visual servoing) contain tracing spans
+  declared with the VP_TRACING_SCOPE() macro. The macros only do something
+  when ViSP is built with the ENABLE_TRACING CMake option, which defines
+  VISP_TRACING in vpConfig.h. Otherwise they expand to nothing and have no
+  cost. The same macros can be used in an application:
+
+  \code
+#include <visp3/core/vpTracing.h>
+
+void process(vpImage<unsigned char> &I)
+{
+  VP_TRACING_SCOPE("process");
+  ...
+}
+
+int main()
+{
+  vpTracing::setThreadName("main");
+  vpTracing::start();
+  for (int i = 0; i < 100; i++) {
+    VP_TRACING_BEGIN("iteration");
+    process(I);
+    VP_TRACING_END();
+  }
+  vpTracing::stop();
+  vpTracing::saveChromeTrace("/tmp/trace.json");
+}
+  \endcode
+
+  \warning The name given to a span is not copied. It has to remain valid
+  until the trace is saved, which is the case of string literals.
+*/
+class VISP_EXPORT vpTracing
+{
+public:
+  /*!
+    Span that lasts from the construction to the destruction of the object.
+    Use the VP_TRACING_SCOPE() macro rather than this class directly.
+  */
+  class VISP_EXPORT vpScope
+  {
+  public:
+    explicit vpScope(const char *name);
+    ~vpScope();
+
+  private:
+    vpScope(const vpScope &);
+    vpScope &operator=(const vpScope &);
+
+    const char *m_name;
+    //! Start time in ms, negative when the tracing was not started
+    double m_start;
+  };
+
+  static void begin(const char *name);
+  static void clear();
+  static void end();
+
+  static unsigned int getBufferSize();
+  static unsigned int getNbDroppedEvents();
+  static unsigned int getNbEvents();
+
+  static bool isStarted();
+
+  static void saveChromeTrace(const std::string &filename);
+  static void setBufferSize(const unsigned int nbEvents);
+  static void setThreadName(const std::string &name);
+  static void start();
+  static void stop();
+
+  static void writeChromeTrace(std::ostream &os);
+
+private:
+  vpTracing();
+};
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+#define VP_TRACING_CONCAT_(a, b) a##b
+#define VP_TRACING_CONCAT(a, b) VP_TRACING_CONCAT_(a, b)
+#endif
+
+#if defined(VISP_TRACING)
+/*!
+  Record a span from this line to the end of the enclosing scope.
+  Expands to nothing when ViSP is not built with the ENABLE_TRACING option.
+*/
+#define VP_TRACING_SCOPE(name) vpTracing::vpScope VP_TRACING_CONCAT(vp_tracing_scope_, __LINE__)(name)
+/*!
+  Begin a span, ended by the next VP_TRACING_END() of the same thread.
+  Expands to nothing when ViSP is not built with the ENABLE_TRACING option.
+*/
+#define VP_TRACING_BEGIN(name) vpTracing::begin(name)
+/*!
+  End the last span begun with VP_TRACING_BEGIN() by the thread.
+  Expands to nothing when ViSP is not built with the ENABLE_TRACING option.
+*/
+#define VP_TRACING_END() vpTracing::end()
+#else
+#define VP_TRACING_SCOPE(name)
+#define VP_TRACING_BEGIN(name)
+#define VP_TRACING_END()
+#endif
+
+#endif
@@ -49,6 +49,7 @@
 // image
 #include <visp3/core/vpCPUFeatures.h>
 #include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpTracing.h>
 
 #if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
 #include <emmintrin.h>
@@ -78,6 +79,7 @@ int vpImageConvert::vpCbb[256];
 */
 void vpImageConvert::convert(const vpImage<unsigned char> &src, vpImage<vpRGBa> &dest)
 {
+  VP_TRACING_SCOPE("vpImageConvert::convert");
   dest.resize(src.getHeight(), src.getWidth());
 
   GreyToRGBa(src.bitmap, (unsigned char *)dest.bitmap, src.getHeight() * src.getWidth());
@@ -90,6 +92,7 @@ void vpImageConvert::convert(const vpImage<unsigned char> &src, vpImage<vpRGBa>
 */
 void vpImageConvert::convert(const vpImage<vpRGBa> &src, vpImage<unsigned char> &dest)
 {
+  VP_TRACING_SCOPE("vpImageConvert::convert");
   dest.resize(src.getHeight(), src.getWidth());
 
   RGBaToGrey((unsigned char *)src.bitmap, dest.bitmap, src.getHeight() * src.getWidth());
@@ -659,6 +662,7 @@ int main()
 */
 void vpImageConvert::convert(const cv::Mat &src, vpImage<vpRGBa> &dest, const bool flip)
 {
+  VP_TRACING_SCOPE("vpImageConvert::convert");
   if (src.type() == CV_8UC4) {
     dest.resize((unsigned int)src.rows, (unsigned int)src.cols);
     vpRGBa rgbaVal;
@@ -809,6 +813,7 @@ int main()
 */
 void vpImageConvert::convert(const cv::Mat &src, vpImage<unsigned char> &dest, const bool flip)
 {
+  VP_TRACING_SCOPE("vpImageConvert::convert");
   if (src.type() == CV_8UC1) {
     dest.resize((unsigned int)src.rows, (unsigned int)src.cols);
     if (src.isContinuous() && !flip) {
@@ -1250,6 +1255,7 @@ void vpImageConvert::convert(const yarp::sig::ImageOf<yarp::sig::PixelRgb> *src,
 */
 void vpImageConvert::YUYVToRGBa(unsigned char *yuyv, unsigned char *rgba, unsigned int width, unsigned int height)
 {
+  VP_TRACING_SCOPE("vpImageConvert::YUYVToRGBa");
   unsigned char *s;
   unsigned char *d;
   int w, h;
@@ -1357,6 +1363,7 @@ void vpImageConvert::YUYVToRGB(unsigned char *yuyv, unsigned char *rgb, unsigned
 */
 void vpImageConvert::YUYVToGrey(unsigned char *yuyv, unsigned char *grey, unsigned int size)
 {
+  VP_TRACING_SCOPE("vpImageConvert::YUYVToGrey");
   unsigned int i = 0, j = 0;
 
   while (j < size * 2) {
@@ -1914,6 +1921,7 @@ void vpImageConvert::YUV411ToRGB(unsigned char *yuv, unsigned char *rgb, unsigne
 */
 void vpImageConvert::YUV420ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height)
 {
+  VP_TRACING_SCOPE("vpImageConvert::YUV420ToRGBa");
   //  std::cout << "call optimized ConvertYUV420ToRGBa()" << std::endl;
   int U, V, R, G, B, V2, U5, UV;
   int Y0, Y1, Y2, Y3;
@@ -3446,6 +3454,7 @@ void vpImageConvert::RGBaToRGB(unsigned char *rgba, unsigned char *rgb, unsigned
 */
 void vpImageConvert::RGBToGrey(unsigned char *rgb, unsigned char *grey, unsigned int size)
 {
+  VP_TRACING_SCOPE("vpImageConvert::RGBToGrey");
   bool checkSSSE3 = vpCPUFeatures::checkSSSE3();
 #if !VISP_HAVE_SSSE3
   checkSSSE3 = false;
@@ -3542,6 +3551,7 @@ void vpImageConvert::RGBToGrey(unsigned char *rgb, unsigned char *grey, unsigned
 */
 void vpImageConvert::RGBaToGrey(unsigned char *rgba, unsigned char *grey, unsigned int size)
 {
+  VP_TRACING_SCOPE("vpImageConvert::RGBaToGrey");
   bool checkSSSE3 = vpCPUFeatures::checkSSSE3();
 #if !VISP_HAVE_SSSE3
   checkSSSE3 = false;
@@ -3681,6 +3691,7 @@ void vpImageConvert::GreyToRGB(unsigned char *grey, unsigned char *rgb, unsigned
 void vpImageConvert::BGRToRGBa(unsigned char *bgr, unsigned char *rgba, unsigned int width, unsigned int height,
                                bool flip)
 {
+  VP_TRACING_SCOPE("vpImageConvert::BGRToRGBa");
   // if we have to flip the image, we start from the end last scanline so the
   // step is negative
   int lineStep = (flip) ? -(int)(width * 3) : (int)(width * 3);
@@ -3935,6 +3946,7 @@ void vpImageConvert::RGBToRGBa(unsigned char *rgb, unsigned char *rgba, unsigned
 void vpImageConvert::RGBToGrey(unsigned char *rgb, unsigned char *grey, unsigned int width, unsigned int height,
                                bool flip)
 {
+  VP_TRACING_SCOPE("vpImageConvert::RGBToGrey");
   if (flip) {
     bool checkSSSE3 = vpCPUFeatures::checkSSSE3();
 #if !VISP_HAVE_SSSE3
@@ -4371,6 +4383,7 @@ int main()
 void vpImageConvert::split(const vpImage<vpRGBa> &src, vpImage<unsigned char> *pR, vpImage<unsigned char> *pG,
                            vpImage<unsigned char> *pB, vpImage<unsigned char> *pa)
 {
+  VP_TRACING_SCOPE("vpImageConvert::split");
   size_t n = src.getNumberOfPixel();
   unsigned int height = src.getHeight();
   unsigned int width = src.getWidth();
@@ -4440,6 +4453,7 @@ void vpImageConvert::split(const vpImage<vpRGBa> &src, vpImage<unsigned char> *p
 void vpImageConvert::merge(const vpImage<unsigned char> *R, const vpImage<unsigned char> *G,
                            const vpImage<unsigned char> *B, const vpImage<unsigned char> *a, vpImage<vpRGBa> &RGBa)
 {
+  VP_TRACING_SCOPE("vpImageConvert::merge");
   // Check if the input channels have all the same dimensions
   std::map<unsigned int, unsigned int> mapOfWidths, mapOfHeights;
   if (R != NULL) {
@@ -46,6 +46,7 @@
 #include <visp3/core/vpException.h>
 #include <visp3/core/vpHomogeneousMatrix.h>
 #include <visp3/core/vpMatrix.h>
+#include <visp3/core/vpMatrixFixed.h>
 #include <visp3/core/vpPoint.h>
 #include <visp3/core/vpQuaternionVector.h>
 
@@ -399,21 +400,12 @@ vpHomogeneousMatrix vpHomogeneousMatrix::operator*(const vpHomogeneousMatrix &M)
 {
   vpHomogeneousMatrix p;
 
-  vpRotationMatrix R1, R2, R;
-  vpTranslationVector T1, T2, T;
+  // fixed size blocks avoid the allocation of temporary matrices
+  const vpMatrixFixed<3, 3> R1(*this, 0, 0), R2(M, 0, 0);
+  const vpMatrixFixed<3, 1> T1(*this, 0, 3), T2(M, 0, 3);
 
-  extract(T1);
-  M.extract(T2);
-
-  extract(R1);
-  M.extract(R2);
-
-  R = R1 * R2;
-
-  T = R1 * T2 + T1;
-
-  p.insert(T);
-  p.insert(R);
+  (R1 * R2).copyTo(p);
+  (R1 * T2 + T1).copyTo(p, 0, 3);
 
   return p;
 }
@@ -437,7 +429,12 @@ int main()
 */
 vpHomogeneousMatrix &vpHomogeneousMatrix::operator*=(const vpHomogeneousMatrix &M)
 {
-  (*this) = (*this) * M;
+  const vpMatrixFixed<3, 3> R1(*this, 0, 0), R2(M, 0, 0);
+  const vpMatrixFixed<3, 1> T1(*this, 0, 3), T2(M, 0, 3);
+
+  (R1 * R2).copyTo(*this);
+  (R1 * T2 + T1).copyTo(*this, 0, 3);
+
   return (*this);
 }
 
@@ -484,30 +481,27 @@ vpPoint vpHomogeneousMatrix::operator*(const vpPoint &bP) const
 {
   vpPoint aP;
 
-  vpColVector v(4), v1(4);
+  const vpMatrixFixed<4, 4> M(*this);
+  vpMatrixFixed<4, 1> v;
 
-  v[0] = bP.get_X();
-  v[1] = bP.get_Y();
-  v[2] = bP.get_Z();
-  v[3] = bP.get_W();
+  v[0][0] = bP.get_X();
+  v[1][0] = bP.get_Y();
+  v[2][0] = bP.get_Z();
+  v[3][0] = bP.get_W();
 
-  v1[0] = (*this)[0][0] * v[0] + (*this)[0][1] * v[1] + (*this)[0][2] * v[2] + (*this)[0][3] * v[3];
-  v1[1] = (*this)[1][0] * v[0] + (*this)[1][1] * v[1] + (*this)[1][2] * v[2] + (*this)[1][3] * v[3];
-  v1[2] = (*this)[2][0] * v[0] + (*this)[2][1] * v[1] + (*this)[2][2] * v[2] + (*this)[2][3] * v[3];
-  v1[3] = (*this)[3][0] * v[0] + (*this)[3][1] * v[1] + (*this)[3][2] * v[2] + (*this)[3][3] * v[3];
+  vpMatrixFixed<4, 1> v1 = M * v;
 
-  v1 /= v1[3];
+  v1 *= 1. / v1[3][0];
 
-  //  v1 = M*v ;
-  aP.set_X(v1[0]);
-  aP.set_Y(v1[1]);
-  aP.set_Z(v1[2]);
-  aP.set_W(v1[3]);
+  aP.set_X(v1[0][0]);
+  aP.set_Y(v1[1][0]);
+  aP.set_Z(v1[2][0]);
+  aP.set_W(v1[3][0]);
 
-  aP.set_oX(v1[0]);
-  aP.set_oY(v1[1]);
-  aP.set_oZ(v1[2]);
-  aP.set_oW(v1[3]);
+  aP.set_oX(v1[0][0]);
+  aP.set_oY(v1[1][0]);
+  aP.set_oZ(v1[2][0]);
+  aP.set_oW(v1[3][0]);
 
   return aP;
 }
@@ -643,18 +637,7 @@ void vpHomogeneousMatrix::insert(const vpQuaternionVector &q) { insert(vpRotatio
 vpHomogeneousMatrix vpHomogeneousMatrix::inverse() const
 {
   vpHomogeneousMatrix Mi;
-
-  vpRotationMatrix R;
-  extract(R);
-  vpTranslationVector T;
-  extract(T);
-
-  vpTranslationVector RtT;
-  RtT = -(R.t() * T);
-
-  Mi.insert(R.t());
-  Mi.insert(RtT);
-
+  inverse(Mi);
   return Mi;
 }
 
@@ -688,7 +671,17 @@ void vpHomogeneousMatrix::eye()
   \right]\f$
 
 */
-void vpHomogeneousMatrix::inverse(vpHomogeneousMatrix &M) const { M = inverse(); }
+void vpHomogeneousMatrix::inverse(vpHomogeneousMatrix &M) const
+{
+  // the blocks are copied first, M may be this matrix
+  const vpMatrixFixed<3, 3> Rt = vpMatrixFixed<3, 3>(*this, 0, 0).t();
+  const vpMatrixFixed<3, 1> T(*this, 0, 3);
+
+  Rt.copyTo(M);
+  (-(Rt * T)).copyTo(M, 0, 3);
+  M[3][0] = M[3][1] = M[3][2] = 0;
+  M[3][3] = 1;
+}
 
 /*!
   Write an homogeneous matrix in an output file stream.
@@ -40,8 +40,34 @@
 #include <sstream>
 
 #include <visp3/core/vpException.h>
+#include <visp3/core/vpMatrixFixed.h>
 #include <visp3/core/vpVelocityTwistMatrix.h>
 
+namespace
+{
+// V = [R [t]x R; 0 R] computed with fixed size temporaries
+void buildTwist(vpArray2D<double> &V, const vpMatrixFixed<3, 1> &t, const vpMatrixFixed<3, 3> &R)
+{
+  vpMatrixFixed<3, 3> skew_t;
+  skew_t[0][1] = -t[2][0];
+  skew_t[0][2] = t[1][0];
+  skew_t[1][0] = t[2][0];
+  skew_t[1][2] = -t[0][0];
+  skew_t[2][0] = -t[1][0];
+  skew_t[2][1] = t[0][0];
+  const vpMatrixFixed<3, 3> skewaR = skew_t * R;
+
+  for (unsigned int i = 0; i < 3; i++) {
+    for (unsigned int j = 0; j < 3; j++) {
+      V[i][j] = R[i][j];
+      V[i + 3][j + 3] = R[i][j];
+      V[i][j + 3] = skewaR[i][j];
+      V[i + 3][j] = 0;
+    }
+  }
+}
+}
+
 /*!
   \file vpVelocityTwistMatrix.cpp
 
@@ -364,16 +390,7 @@ vpVelocityTwistMatrix vpVelocityTwistMatrix::buildFrom(const vpRotationMatrix &R
 */
 vpVelocityTwistMatrix vpVelocityTwistMatrix::buildFrom(const vpTranslationVector &t, const vpRotationMatrix &R)
 {
-  vpMatrix skewaR = t.skew(t) * R;
-
-  for (unsigned int i = 0; i < 3; i++) {
-    for (unsigned int j = 0; j < 3; j++) {
-      (*this)[i][j] = R[i][j];
-      (*this)[i + 3][j + 3] = R[i][j];
-      (*this)[i][j + 3] = skewaR[i][j];
-    }
-  }
-
+  buildTwist(*this, vpMatrixFixed<3, 1>(t), vpMatrixFixed<3, 3>(R));
   return (*this);
 }
 
@@ -436,10 +453,10 @@ vpVelocityTwistMatrix vpVelocityTwistMatrix::buildFrom(const vpThetaUVector &the
 */
 vpVelocityTwistMatrix vpVelocityTwistMatrix::buildFrom(const vpHomogeneousMatrix &M, bool full)
 {
+  vpMatrixFixed<3, 1> t;
   if (full)
-    buildFrom(M.getTranslationVector(), M.getRotationMatrix());
-  else
-    buildFrom(M.getRotationMatrix());
+    t = vpMatrixFixed<3, 1>(M, 0, 3);
+  buildTwist(*this, t, vpMatrixFixed<3, 3>(M, 0, 0));
 
   return (*this);
 }
@@ -448,14 +465,15 @@ vpVelocityTwistMatrix vpVelocityTwistMatrix::buildFrom(const vpHomogeneousMatrix
 vpVelocityTwistMatrix vpVelocityTwistMatrix::inverse() const
 {
   vpVelocityTwistMatrix Wi;
-  vpRotationMatrix R;
-  extract(R);
-  vpTranslationVector T;
-  extract(T);
-  vpTranslationVector RtT;
-  RtT = -(R.t() * T);
+  // t is extracted from [t]x = V_12 R^T, the inverse is built from -R^T t and R^T
+  const vpMatrixFixed<3, 3> Rt = vpMatrixFixed<3, 3>(*this, 0, 0).t();
+  const vpMatrixFixed<3, 3> skew_t = vpMatrixFixed<3, 3>(*this, 0, 3) * Rt;
+  vpMatrixFixed<3, 1> T;
+  T[0][0] = skew_t[2][1];
+  T[1][0] = skew_t[0][2];
+  T[2][0] = skew_t[1][0];
 
-  Wi.buildFrom(RtT, R.t());
+  buildTwist(Wi, -(Rt * T), Rt);
 
   return Wi;
 }
@@ -474,14 +492,7 @@ void vpVelocityTwistMatrix::extract(vpRotationMatrix &R) const
 //! Extract the translation vector from the velocity twist matrix.
 void vpVelocityTwistMatrix::extract(vpTranslationVector &tv) const
 {
-  vpRotationMatrix R;
-  extract(R);
-  vpMatrix skTR(3, 3);
-  for (unsigned int i = 0; i < 3; i++)
-    for (unsigned int j = 0; j < 3; j++)
-      skTR[i][j] = (*this)[i][j + 3];
-
-  vpMatrix skT = skTR * R.t();
+  const vpMatrixFixed<3, 3> skT = vpMatrixFixed<3, 3>(*this, 0, 3) * vpMatrixFixed<3, 3>(*this, 0, 0).t();
   tv[0] = skT[2][1];
   tv[1] = skT[0][2];
   tv[2] = skT[1][0];
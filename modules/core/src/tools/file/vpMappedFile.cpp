@@ -0,0 +1,187 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Memory-mapped file.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpMappedFile.cpp
+  \brief Memory-mapped file.
+*/
+
+#include <fstream>
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpMappedFile.h>
+
+#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
+#define VP_MAPPED_FILE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#elif defined(_WIN32) && !defined(WINRT)
+#define VP_MAPPED_FILE_WIN32
+#include <windows.h>
+#endif
+
+/*!
+  Default constructor, no file is open.
+*/
+vpMappedFile::vpMappedFile()
+  : m_data(NULL), m_size(0), m_mapped(false)
+#if defined(_WIN32)
+    ,
+    m_fileHandle(NULL), m_mappingHandle(NULL)
+#endif
+{
+}
+
+/*!
+  Map the file \e filename in memory. See open().
+*/
+vpMappedFile::vpMappedFile(const std::string &filename)
+  : m_data(NULL), m_size(0), m_mapped(false)
+#if defined(_WIN32)
+    ,
+    m_fileHandle(NULL), m_mappingHandle(NULL)
+#endif
+{
+  open(filename);
+}
+
+/*!
+  Destructor that unmaps the file.
+*/
+vpMappedFile::~vpMappedFile() { close(); }
+
+/*!
+  Unmap the file. The pointers returned by data() are no more valid.
+*/
+void vpMappedFile::close()
+{
+  if (m_data != NULL) {
+    if (m_mapped) {
+#if defined(VP_MAPPED_FILE_MMAP)
+      munmap(m_data, m_size);
+#elif defined(VP_MAPPED_FILE_WIN32)
+      UnmapViewOfFile(m_data);
+#endif
+    } else {
+      delete[] m_data;
+    }
+  }
+#if defined(VP_MAPPED_FILE_WIN32)
+  if (m_mappingHandle != NULL)
+    CloseHandle((HANDLE)m_mappingHandle);
+  if (m_fileHandle != NULL)
+    CloseHandle((HANDLE)m_fileHandle);
+  m_mappingHandle = NULL;
+  m_fileHandle = NULL;
+#endif
+  m_data = NULL;
+  m_size = 0;
+  m_mapped = false;
+}
+
+/*!
+  Map the file \e filename in memory. A file previously open is closed.
+
+  \exception vpException::ioError : If the file cannot be open or is empty.
+*/
+void vpMappedFile::open(const std::string &filename)
+{
+  close();
+
+#if defined(VP_MAPPED_FILE_MMAP)
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw(vpException(vpException::ioError, "Cannot open the file %s", filename.c_str()));
+  }
+  struct stat st;
+  if (fstat(fd, &st) == 0 && st.st_size > 0) {
+    m_size = (size_t)st.st_size;
+    // Private mapping: the pages are copied on write
+    void *addr = mmap(NULL, m_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    if (addr != MAP_FAILED) {
+      m_data = (unsigned char *)addr;
+      m_mapped = true;
+    }
+  }
+  ::close(fd);
+#elif defined(VP_MAPPED_FILE_WIN32)
+  HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file == INVALID_HANDLE_VALUE) {
+    throw(vpException(vpException::ioError, "Cannot open the file %s", filename.c_str()));
+  }
+  LARGE_INTEGER fileSize;
+  if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    if (mapping != NULL) {
+      void *addr = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+      if (addr != NULL) {
+        m_data = (unsigned char *)addr;
+        m_size = (size_t)fileSize.QuadPart;
+        m_mapped = true;
+        m_fileHandle = file;
+        m_mappingHandle = mapping;
+      } else {
+        CloseHandle(mapping);
+      }
+    }
+  }
+  if (!m_mapped)
+    CloseHandle(file);
+#endif
+
+  if (!m_mapped) {
+    // Fall back to a copy of the file in memory
+    std::ifstream file(filename.c_str(), std::ifstream::binary);
+    if (!file.is_open()) {
+      throw(vpException(vpException::ioError, "Cannot open the file %s", filename.c_str()));
+    }
+    file.seekg(0, std::ios::end);
+    std::streamoff length = file.tellg();
+    file.seekg(0, std::ios::beg);
+    if (length <= 0) {
+      throw(vpException(vpException::ioError, "The file %s is empty", filename.c_str()));
+    }
+    m_size = (size_t)length;
+    m_data = new unsigned char[m_size];
+    file.read((char *)m_data, (std::streamsize)m_size);
+    if (!file) {
+      close();
+      throw(vpException(vpException::ioError, "Cannot read the file %s", filename.c_str()));
+    }
+  }
+}
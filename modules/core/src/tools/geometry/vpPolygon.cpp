@@ -38,13 +38,30 @@
  *
  *****************************************************************************/
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <limits>
 #include <set>
+#include <visp3/core/vpCPUFeatures.h>
 #include <visp3/core/vpDisplay.h>
 #include <visp3/core/vpException.h>
 #include <visp3/core/vpMeterPixelConversion.h>
 #include <visp3/core/vpPolygon.h>
 #include <visp3/core/vpUniRand.h>
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
+#define USE_SSE_CODE 1
+#if VISP_HAVE_SSE2 && USE_SSE_CODE
+#define USE_SSE 1
+#else
+#define USE_SSE 0
+#endif
+
 /*!
   Basic constructor.
 
@@ -377,6 +394,133 @@ bool vpPolygon::isInside(const vpImagePoint &ip, const PointInPolygonMethod &met
   return test;
 }
 
+/*!
+  Check if the 2D points \e iPs are inside the polygon using the ray casting
+  method. This is equivalent to call isInside(const vpImagePoint &, const
+  PointInPolygonMethod &) with vpPolygon::PnPolyRayCasting for each point,
+  but the points are tested by batches using SSE2 instructions when
+  available.
+
+  \param iPs : The points which have to be tested.
+  \param inside : For each point, true if the point is inside the polygon,
+  false otherwise.
+*/
+void vpPolygon::isInside(const std::vector<vpImagePoint> &iPs, std::vector<bool> &inside) const
+{
+  inside.assign(iPs.size(), false);
+  if (_corners.size() < 3) {
+    return;
+  }
+
+  size_t k = 0;
+#if USE_SSE
+  if (vpCPUFeatures::checkSSE2()) {
+    const size_t nbCorners = _corners.size();
+    for (; k + 2 <= iPs.size(); k += 2) {
+      __m128d u = _mm_set_pd(iPs[k + 1].get_u(), iPs[k].get_u());
+      __m128d v = _mm_set_pd(iPs[k + 1].get_v(), iPs[k].get_v());
+      __m128d oddNodes = _mm_setzero_pd();
+
+      for (size_t i = 0, j = nbCorners - 1; i < nbCorners; i++) {
+        // (vi < v && vj >= v) || (vj < v && vi >= v) is (vi < v) xor (vj < v)
+        __m128d vi_lower = _mm_cmplt_pd(_mm_set1_pd(_corners[i].get_v()), v);
+        __m128d vj_lower = _mm_cmplt_pd(_mm_set1_pd(_corners[j].get_v()), v);
+        __m128d crossing = _mm_cmplt_pd(
+            _mm_add_pd(_mm_mul_pd(v, _mm_set1_pd(m_PnPolyMultiples[i])), _mm_set1_pd(m_PnPolyConstants[i])), u);
+        oddNodes = _mm_xor_pd(oddNodes, _mm_and_pd(_mm_xor_pd(vi_lower, vj_lower), crossing));
+
+        j = i;
+      }
+
+      int mask = _mm_movemask_pd(oddNodes);
+      inside[k] = (mask & 1) != 0;
+      inside[k + 1] = (mask & 2) != 0;
+    }
+  }
+#endif
+
+  for (; k < iPs.size(); k++) {
+    inside[k] = isInside(iPs[k], PnPolyRayCasting);
+  }
+}
+
+/*!
+  Compute the spans of the pixels of the image row \e i that are inside the
+  polygon, using a single scanline pass over the polygon edges. A pixel \f$
+  (i,j) \f$ belongs to a span if and only if isInside(vpImagePoint(i, j),
+  vpPolygon::PnPolyRayCasting) is true.
+
+  \param i : Index of the image row.
+  \param left : First column to consider.
+  \param right : Last column to consider (excluded).
+  \param spans : List of the spans [first, second[ sorted by increasing
+  column index.
+*/
+void vpPolygon::getRowSpans(unsigned int i, unsigned int left, unsigned int right,
+                            std::vector<std::pair<unsigned int, unsigned int> > &spans) const
+{
+  spans.clear();
+  if (_corners.size() < 3 || left >= right) {
+    return;
+  }
+
+  const size_t nbCorners = _corners.size();
+  // Avoid a memory allocation for common polygons
+  double crossings_buffer[32];
+  std::vector<double> crossings_vector;
+  double *crossings = crossings_buffer;
+  if (nbCorners > 32) {
+    crossings_vector.resize(nbCorners);
+    crossings = &crossings_vector[0];
+  }
+
+  const double v = i;
+  size_t nbCrossings = 0;
+  for (size_t k = 0, l = nbCorners - 1; k < nbCorners; k++) {
+    if ((_corners[k].get_v() < v && _corners[l].get_v() >= v) || (_corners[l].get_v() < v && _corners[k].get_v() >= v)) {
+      crossings[nbCrossings++] = v * m_PnPolyMultiples[k] + m_PnPolyConstants[k];
+    }
+
+    l = k;
+  }
+  std::sort(crossings, crossings + nbCrossings);
+
+  // A pixel is inside when an odd number of crossings are strictly lower
+  // than its column index, ie. j in ]crossings[2n], crossings[2n+1]]
+  for (size_t k = 0; k + 1 < nbCrossings; k += 2) {
+    double first = std::max((double)left, std::floor(crossings[k]) + 1.);
+    double last = std::min((double)right, std::floor(crossings[k + 1]) + 1.);
+    if (first < last) {
+      spans.push_back(std::pair<unsigned int, unsigned int>((unsigned int)first, (unsigned int)last));
+    }
+  }
+}
+
+/*!
+  Set to \e value the pixels of \e mask that are inside the polygon. The
+  other pixels are left unchanged. The polygon is rasterized row by row from
+  its bounding box using getRowSpans().
+
+  \param mask : Image mask to fill.
+  \param value : Value of the pixels inside the polygon.
+*/
+void vpPolygon::fillMask(vpImage<unsigned char> &mask, unsigned char value) const
+{
+  if (_corners.size() < 3 || mask.getSize() == 0) {
+    return;
+  }
+
+  int top = std::max(0, (int)std::floor(_bbox.getTop()));
+  int bottom = std::min((int)mask.getHeight() - 1, (int)std::ceil(_bbox.getBottom()));
+  std::vector<std::pair<unsigned int, unsigned int> > spans;
+  for (int i = top; i <= bottom; i++) {
+    getRowSpans((unsigned int)i, 0, mask.getWidth(), spans);
+    for (size_t k = 0; k < spans.size(); k++) {
+      memset(mask[i] + spans[k].first, value, spans[k].second - spans[k].first);
+    }
+  }
+}
+
 void vpPolygon::precalcValuesPnPoly()
 {
   if (_corners.size() < 3) {
@@ -546,6 +690,23 @@ bool vpPolygon::isInside(const std::vector<vpImagePoint> &roi, const double &i,
   return poly.isInside(vpImagePoint(i, j), method);
 }
 
+/*!
+  Set to \e value the pixels of \e mask that are inside at least one of the
+  \e polygons. The other pixels are left unchanged.
+
+  \param polygons : List of polygons.
+  \param mask : Image mask to fill.
+  \param value : Value of the pixels inside the polygons.
+
+  \sa fillMask(vpImage<unsigned char> &, unsigned char) const
+*/
+void vpPolygon::fillMask(const std::vector<vpPolygon> &polygons, vpImage<unsigned char> &mask, unsigned char value)
+{
+  for (std::vector<vpPolygon>::const_iterator it = polygons.begin(); it != polygons.end(); ++it) {
+    it->fillMask(mask, value);
+  }
+}
+
 /*!
   Return number of corners belonging to the polygon.
  */
@@ -36,6 +36,9 @@
  *
  *****************************************************************************/
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <visp3/core/vpLinProg.h>
 
 /*!
@@ -757,4 +760,537 @@ bool vpLinProg::simplex(const vpColVector &c, vpMatrix A, vpColVector b, vpColVe
     std::swap(B[k],N[j]);
   }
 }
+namespace
+{
+typedef std::vector<std::pair<unsigned int, double> > vpSparseColumn;
+
+/*
+  Sparse LU factorization of a simplex basis, with product form updates.
+
+  The columns of the basis are eliminated in the order of their number of non-zeros (left-looking elimination
+  with partial pivoting), such that B.Q = L.U. Each basis change is stored as an eta column until the next
+  factorization.
+*/
+class vpBasisFactorization
+{
+public:
+  vpBasisFactorization() : m(0), pivotRow(), order(), diag(), L(), U(), etaRow(), etaPivot(), eta(), work() {}
+
+  // factorizes the basis made of the columns cols[basis[k]], returns false if it is singular
+  bool factorize(const std::vector<vpSparseColumn> &cols, const std::vector<unsigned int> &basis, const double &tol)
+  {
+    m = (unsigned int)basis.size();
+    order.resize(m);
+    for (unsigned int k = 0; k < m; ++k)
+      order[k] = k;
+    std::stable_sort(order.begin(), order.end(), [&](unsigned int k1, unsigned int k2) {
+      return cols[basis[k1]].size() < cols[basis[k2]].size();
+    });
+    pivotRow.assign(m, 0);
+    diag.assign(m, 0);
+    L.assign(m, vpSparseColumn());
+    U.assign(m, vpSparseColumn());
+    etaRow.clear();
+    etaPivot.clear();
+    eta.clear();
+
+    std::vector<int> rowStep(m, -1);
+    std::vector<double> x(m, 0);
+    std::vector<char> mark(m, 0);
+    std::vector<unsigned int> nz;
+    nz.reserve(m);
+    for (unsigned int k = 0; k < m; ++k) {
+      nz.clear();
+      for (const auto &a : cols[basis[order[k]]]) {
+        x[a.first] = a.second;
+        mark[a.first] = 1;
+        nz.push_back(a.first);
+      }
+      // eliminate with the previous L columns
+      for (unsigned int t = 0; t < k; ++t) {
+        const double a = x[pivotRow[t]];
+        if (a != 0) {
+          U[k].push_back({t, a});
+          x[pivotRow[t]] = 0;
+          for (const auto &l : L[t]) {
+            if (!mark[l.first]) {
+              mark[l.first] = 1;
+              nz.push_back(l.first);
+            }
+            x[l.first] -= l.second * a;
+          }
+        }
+      }
+      // partial pivoting among remaining rows
+      unsigned int p = m;
+      double pmax = tol;
+      for (auto i : nz) {
+        if (rowStep[i] < 0 && std::fabs(x[i]) > pmax) {
+          pmax = std::fabs(x[i]);
+          p = i;
+        }
+      }
+      if (p == m)
+        return false;
+      pivotRow[k] = p;
+      rowStep[p] = (int)k;
+      diag[k] = x[p];
+      for (auto i : nz) {
+        if (rowStep[i] < 0 && x[i] != 0)
+          L[k].push_back({i, x[i] / diag[k]});
+        x[i] = 0;
+        mark[i] = 0;
+      }
+    }
+    work.resize(m);
+    return true;
+  }
+
+  // v <- B^-1 v, v is indexed by rows in input and by basis positions in output
+  void ftran(std::vector<double> &v) const
+  {
+    for (unsigned int t = 0; t < m; ++t) {
+      const double a = v[pivotRow[t]];
+      work[t] = a;
+      if (a != 0) {
+        for (const auto &l : L[t])
+          v[l.first] -= l.second * a;
+      }
+    }
+    for (unsigned int k = m; k-- > 0;) {
+      const double z = work[k] / diag[k];
+      work[k] = z;
+      if (z != 0) {
+        for (const auto &u : U[k])
+          work[u.first] -= u.second * z;
+      }
+    }
+    for (unsigned int k = 0; k < m; ++k)
+      v[order[k]] = work[k];
+    for (unsigned int e = 0; e < eta.size(); ++e) {
+      const double a = v[etaRow[e]] / etaPivot[e];
+      v[etaRow[e]] = a;
+      if (a != 0) {
+        for (const auto &w : eta[e])
+          v[w.first] -= w.second * a;
+      }
+    }
+  }
+
+  // v <- B^-T v, v is indexed by basis positions in input and by rows in output
+  void btran(std::vector<double> &v) const
+  {
+    for (unsigned int e = (unsigned int)eta.size(); e-- > 0;) {
+      double a = v[etaRow[e]];
+      for (const auto &w : eta[e])
+        a -= w.second * v[w.first];
+      v[etaRow[e]] = a / etaPivot[e];
+    }
+    for (unsigned int k = 0; k < m; ++k) {
+      double s = v[order[k]];
+      for (const auto &u : U[k])
+        s -= u.second * work[u.first];
+      work[k] = s / diag[k];
+    }
+    for (unsigned int t = m; t-- > 0;) {
+      double y = work[t];
+      for (const auto &l : L[t])
+        y -= l.second * v[l.first];
+      v[pivotRow[t]] = y;
+    }
+  }
+
+  // the basis column at position r is replaced by a column a such that w = B^-1 a
+  void update(const std::vector<double> &w, unsigned int r, const double &tol)
+  {
+    etaRow.push_back(r);
+    etaPivot.push_back(w[r]);
+    eta.push_back(vpSparseColumn());
+    for (unsigned int i = 0; i < m; ++i) {
+      if (i != r && std::fabs(w[i]) > tol)
+        eta.back().push_back({i, w[i]});
+    }
+  }
+
+  unsigned int updates() const { return (unsigned int)eta.size(); }
+
+private:
+  unsigned int m;
+  // row pivoted at each step and corresponding basis position
+  std::vector<unsigned int> pivotRow, order;
+  std::vector<double> diag;
+  std::vector<vpSparseColumn> L, U;
+  // product form updates
+  std::vector<unsigned int> etaRow;
+  std::vector<double> etaPivot;
+  std::vector<vpSparseColumn> eta;
+  mutable std::vector<double> work;
+};
+
+/*
+  Primal revised simplex with bounded variables, used by vpLinProg::revisedSimplex().
+
+  The n structural variables are followed by m artificial variables, one per row, that are used to find a
+  feasible basis (phase 1) and are then fixed to 0.
+*/
+class vpRevisedSimplex
+{
+public:
+  enum vpStatus { BASIC, LOWER, UPPER, FREE };
+
+  vpRevisedSimplex(const vpLinProg::SparseMatrix &A, const vpColVector &b, const double &eps)
+    : n(A.getCols()), m(A.getRows()), tol(eps), rhs(b.getRows()), cols(n + m), lo(n + m, 0),
+      up(n + m, std::numeric_limits<double>::infinity()), x(n + m, 0), status(n + m, LOWER), basis(), lu()
+  {
+    for (unsigned int j = 0; j < n; ++j)
+      cols[j] = A.getCol(j);
+    for (unsigned int i = 0; i < m; ++i) {
+      cols[n + i].push_back({i, 1.});
+      rhs[i] = b[i];
+    }
+  }
+
+  // basic variables from the non-basic ones, B.xB = b - N.xN
+  bool computeBasicValues()
+  {
+    if (!lu.factorize(cols, basis, tol * 1e-3))
+      return false;
+    std::vector<double> v(rhs);
+    for (unsigned int j = 0; j < n + m; ++j) {
+      if (status[j] != BASIC && x[j] != 0) {
+        for (const auto &a : cols[j])
+          v[a.first] -= a.second * x[j];
+      }
+    }
+    lu.ftran(v);
+    for (unsigned int k = 0; k < m; ++k)
+      x[basis[k]] = v[k];
+    return true;
+  }
+
+  bool isBasisFeasible() const
+  {
+    for (auto j : basis) {
+      if (x[j] < lo[j] - tol || x[j] > up[j] + tol)
+        return false;
+    }
+    return true;
+  }
+
+  // sets a non-basic variable to the bound that is the closest to its current value
+  void setNonBasic(unsigned int j)
+  {
+    if (lo[j] == -std::numeric_limits<double>::infinity() && up[j] == std::numeric_limits<double>::infinity()) {
+      status[j] = FREE;
+      x[j] = 0;
+    } else if (up[j] == std::numeric_limits<double>::infinity() ||
+               (lo[j] != -std::numeric_limits<double>::infinity() &&
+                std::fabs(x[j] - lo[j]) <= std::fabs(x[j] - up[j]))) {
+      status[j] = LOWER;
+      x[j] = lo[j];
+    } else {
+      status[j] = UPPER;
+      x[j] = up[j];
+    }
+  }
+
+  // tries to start from a given basis, returns true if it is feasible
+  bool warmStart(const std::vector<unsigned int> &start)
+  {
+    if (start.size() != m)
+      return false;
+    std::fill(status.begin(), status.end(), LOWER);
+    for (auto j : start) {
+      if (j >= n + m || status[j] == BASIC)
+        return false;
+      status[j] = BASIC;
+    }
+    for (unsigned int i = 0; i < m; ++i)
+      up[n + i] = 0;
+    for (unsigned int j = 0; j < n + m; ++j) {
+      if (status[j] != BASIC)
+        setNonBasic(j);
+    }
+    basis = start;
+    return computeBasicValues() && isBasisFeasible();
+  }
+
+  // phase 1 from the artificial basis, returns true if a feasible basis was found
+  bool coldStart()
+  {
+    std::vector<double> r(rhs);
+    for (unsigned int j = 0; j < n; ++j) {
+      setNonBasic(j);
+      if (x[j] != 0) {
+        for (const auto &a : cols[j])
+          r[a.first] -= a.second * x[j];
+      }
+    }
+    basis.resize(m);
+    std::vector<double> cost(n + m, 0);
+    for (unsigned int i = 0; i < m; ++i) {
+      cols[n + i][0].second = r[i] < 0 ? -1. : 1.;
+      lo[n + i] = 0;
+      up[n + i] = std::numeric_limits<double>::infinity();
+      basis[i] = n + i;
+      status[n + i] = BASIC;
+      cost[n + i] = 1;
+    }
+    if (!computeBasicValues() || !iterate(cost))
+      return false;
+
+    double infeasibility = 0, bmax = 1;
+    for (unsigned int i = 0; i < m; ++i) {
+      infeasibility += x[n + i];
+      bmax = std::max(bmax, std::fabs(rhs[i]));
+    }
+    if (infeasibility > tol * bmax)
+      return false;
+    // artificial variables are now fixed to 0
+    for (unsigned int i = 0; i < m; ++i) {
+      up[n + i] = 0;
+      x[n + i] = 0;
+    }
+    return true;
+  }
+
+  // simplex iterations from a feasible basis, returns true if an optimal basis is found
+  bool iterate(const std::vector<double> &cost)
+  {
+    const double pivotTol = 1e-9;
+    const unsigned int maxIterations = 50 * (n + m) + 100;
+    std::vector<double> y(m), w(m);
+    unsigned int degenerate = 0;
+
+    for (unsigned int iter = 0; iter < maxIterations; ++iter) {
+      // refactorize from time to time to limit the size of the eta file and the numerical drift
+      if (lu.updates() >= 100 && !computeBasicValues())
+        return false;
+
+      // simplex multipliers
+      for (unsigned int k = 0; k < m; ++k)
+        y[k] = cost[basis[k]];
+      lu.btran(y);
+
+      // pricing, Dantzig rule or Bland rule if the simplex seems to stall
+      const bool bland = degenerate > 50;
+      unsigned int q = n + m;
+      double dir = 0, best = 0;
+      for (unsigned int j = 0; j < n + m; ++j) {
+        if (status[j] == BASIC || lo[j] == up[j])
+          continue;
+        double d = cost[j];
+        for (const auto &a : cols[j])
+          d -= a.second * y[a.first];
+        double s = 0;
+        if (d < -tol && status[j] != UPPER)
+          s = 1;
+        else if (d > tol && status[j] != LOWER)
+          s = -1;
+        if (s != 0 && std::fabs(d) > best) {
+          q = j;
+          dir = s;
+          best = std::fabs(d);
+          if (bland)
+            break;
+        }
+      }
+      if (q == n + m)
+        return true;
+
+      // direction of the basic variables
+      std::fill(w.begin(), w.end(), 0.);
+      for (const auto &a : cols[q])
+        w[a.first] = a.second;
+      lu.ftran(w);
+
+      // ratio test, the entering variable may also reach its other bound
+      double theta = up[q] - lo[q];
+      unsigned int r = m;
+      for (unsigned int k = 0; k < m; ++k) {
+        const double delta = -dir * w[k];
+        const unsigned int j = basis[k];
+        double t;
+        if (delta < -pivotTol && lo[j] != -std::numeric_limits<double>::infinity())
+          t = (x[j] - lo[j]) / -delta;
+        else if (delta > pivotTol && up[j] != std::numeric_limits<double>::infinity())
+          t = (up[j] - x[j]) / delta;
+        else
+          continue;
+        t = std::max(t, 0.);
+        if (t < theta - pivotTol || (r != m && t <= theta + pivotTol && std::fabs(w[k]) > std::fabs(w[r]))) {
+          theta = std::min(theta, t);
+          r = k;
+        }
+      }
+      if (theta == std::numeric_limits<double>::infinity()) {
+        std::cout << "vpLinProg::revisedSimplex: problem is unbounded" << std::endl;
+        return false;
+      }
+      degenerate = theta > tol ? 0 : degenerate + 1;
+
+      // update the primal values
+      x[q] += dir * theta;
+      for (unsigned int k = 0; k < m; ++k)
+        x[basis[k]] -= dir * w[k] * theta;
+
+      if (r == m) {
+        // bound flip
+        status[q] = dir > 0 ? UPPER : LOWER;
+        x[q] = dir > 0 ? up[q] : lo[q];
+      } else {
+        const unsigned int j = basis[r];
+        if (-dir * w[r] < 0) {
+          status[j] = LOWER;
+          x[j] = lo[j];
+        } else {
+          status[j] = UPPER;
+          x[j] = up[j];
+        }
+        status[q] = BASIC;
+        basis[r] = q;
+        lu.update(w, r, pivotTol * 1e-3);
+      }
+    }
+    std::cout << "vpLinProg::revisedSimplex: maximum number of iterations reached" << std::endl;
+    return false;
+  }
+
+  unsigned int n, m;
+  double tol;
+  std::vector<double> rhs;
+  std::vector<vpSparseColumn> cols;
+  std::vector<double> lo, up, x;
+  std::vector<vpStatus> status;
+  std::vector<unsigned int> basis;
+  vpBasisFactorization lu;
+};
+}
+
+/*!
+  Solves a Linear Program with sparse equality constraints and bounded variables, with a revised simplex.
+
+  \f$\begin{array}{lll}
+  \mathbf{x} = &  \arg\min & \mathbf{c}^T\mathbf{x}\\
+               & \text{s.t.}& \mathbf{A}\mathbf{x} = \mathbf{b}\\
+               & \text{s.t.}& \mathbf{l} \leq \mathbf{x} \leq \mathbf{u}
+\end{array}
+\f$
+
+  Contrary to simplex(), the constraint matrix is never copied as a dense matrix: the basis is maintained as a
+  sparse LU factorization with product form updates, and the bounds are handled directly by the ratio test. This
+  makes it suitable for programs with thousands of variables with few non-zeros per column, such as assignment
+  or allocation problems.
+
+  \param c : cost vector (dimension n)
+  \param A : sparse equality matrix (dimension m x n)
+  \param b : equality vector (dimension m)
+  \param l : lower bounds (dimension n), or empty vector if all lower bounds are 0. Use
+  -std::numeric_limits<double>::infinity() for a variable without lower bound.
+  \param u : upper bounds (dimension n), or empty vector if there is no upper bound. Use
+  std::numeric_limits<double>::infinity() for a variable without upper bound.
+  \param x : in: used to choose the bounds of the non-basic variables when warm starting, out: solution (dimension n)
+  \param basis : in: basis of a previous call to warm start, or empty vector, out: optimal basis (dimension m).
+  Indices greater or equal to n denote the artificial variable of a row, that happens if A is rank deficient.
+  \param tol : tolerance on feasibility and optimality
+
+  \return True if the solution was found.
+
+  If the basis given as input is still feasible, for instance when only the cost vector changed since the
+  previous call, the search starts from it. Otherwise a feasible basis is first found from scratch.
+
+  \warning This function is only available if C++11 is activated during compilation. Configure ViSP using cmake -DUSE_CPP11=ON.
+
+  Here is an example that assigns 3 tasks to 2 robots, each robot being able to perform up to 2 tasks:
+
+  \code
+  #include <visp3/core/vpLinProg.h>
+
+  int main()
+  {
+    // x[3*r+t] is 1 if task t is assigned to robot r
+    const unsigned int R = 2, T = 3;
+    vpColVector c(R*T+R), l(R*T+R), u(R*T+R, 1);
+    vpLinProg::SparseMatrix A(T+R, R*T+R);
+    vpColVector b(T+R, 1);
+    for(unsigned int r = 0; r < R; ++r)
+    {
+      for(unsigned int t = 0; t < T; ++t)
+      {
+        c[T*r+t] = r + t*(r+1);
+        A.add(t, T*r+t, 1);     // each task is done once
+        A.add(T+r, T*r+t, 1);   // robot capacity, with slack variable
+      }
+      A.add(T+r, R*T+r, 1);
+      b[T+r] = u[R*T+r] = 2;
+    }
+
+    vpColVector x;
+    std::vector<unsigned int> basis;
+    if(vpLinProg::revisedSimplex(c, A, b, l, u, x, basis))
+      std::cout << "x: " << x.t() << std::endl;
+
+    // solve again after a change of the cost, starting from the previous basis
+    c[0] = 10;
+    if(vpLinProg::revisedSimplex(c, A, b, l, u, x, basis))
+      std::cout << "x: " << x.t() << std::endl;
+  }
+  \endcode
+
+  \sa simplex(), solveLP()
+*/
+bool vpLinProg::revisedSimplex(const vpColVector &c, const SparseMatrix &A, const vpColVector &b,
+                               const vpColVector &l, const vpColVector &u, vpColVector &x,
+                               std::vector<unsigned int> &basis, const double &tol)
+{
+  const unsigned int n = A.getCols();
+  const unsigned int m = A.getRows();
+  if(c.getRows() != n || b.getRows() != m ||
+     (l.getRows() != 0 && l.getRows() != n) ||
+     (u.getRows() != 0 && u.getRows() != n))
+  {
+    throw(vpException(vpException::dimensionError,
+                      "vpLinProg::revisedSimplex: wrong dimension, A is %ux%u, c: %u, b: %u, l: %u, u: %u",
+                      m, n, c.getRows(), b.getRows(), l.getRows(), u.getRows()));
+  }
+
+  vpRevisedSimplex lp(A, b, tol);
+  for(unsigned int j = 0; j < n; ++j)
+  {
+    if(l.getRows())
+      lp.lo[j] = l[j];
+    if(u.getRows())
+      lp.up[j] = u[j];
+    if(lp.lo[j] > lp.up[j] + tol)
+    {
+      std::cout << "vpLinProg::revisedSimplex: bounds not feasible" << std::endl;
+      return false;
+    }
+    lp.up[j] = std::max(lp.lo[j], lp.up[j]);
+    if(x.getRows() == n)
+      lp.x[j] = x[j];
+  }
+
+  if(!lp.warmStart(basis))
+  {
+    for(unsigned int j = 0; j < n; ++j)
+      lp.x[j] = x.getRows() == n ? x[j] : 0;
+    if(!lp.coldStart())
+    {
+      std::cout << "vpLinProg::revisedSimplex: constraints not feasible" << std::endl;
+      return false;
+    }
+  }
+
+  std::vector<double> cost(n + m, 0);
+  for(unsigned int j = 0; j < n; ++j)
+    cost[j] = c[j];
+  const bool optimal = lp.iterate(cost);
+
+  x.resize(n, false);
+  for(unsigned int j = 0; j < n; ++j)
+    x[j] = lp.x[j];
+  basis = lp.basis;
+  return optimal;
+}
 #endif
@@ -37,11 +37,29 @@
  *****************************************************************************/
 
 #include <algorithm>
+#include <cmath>
 #include <visp3/core/vpMatrixException.h>
 #include <visp3/core/vpQuadProg.h>
+#include <visp3/core/vpTime.h>
 
 #ifdef VISP_HAVE_CPP11_COMPATIBILITY
 
+namespace
+{
+// same as vpLinProg::allLesser(C, x, d, tol) without temporary row vectors
+bool isFeasible(const vpMatrix &C, const vpColVector &x, const vpColVector &d, const double &tol)
+{
+  for (unsigned int i = 0; i < C.getRows(); ++i) {
+    double cx = 0;
+    for (unsigned int j = 0; j < C.getCols(); ++j)
+      cx += C[i][j] * x[j];
+    if (cx - d[i] > tol)
+      return false;
+  }
+  return true;
+}
+}
+
 /*!
 Changes a canonical quadratic cost \f$\min \frac{1}{2}\mathbf{x}^T\mathbf{H}\mathbf{x} + \mathbf{c}^T\mathbf{x}\f$
 to the formulation used by this class \f$ \min ||\mathbf{Q}\mathbf{x} - \mathbf{r}||^2\f$.
@@ -705,6 +723,460 @@ bool vpQuadProg::solveQPi(const vpMatrix &Q, const vpColVector &r,
   }
   return true;
 }
+
+/*!
+  Preallocates the workspace of solveQPiRealTime() for problems with n variables and p inequality constraints.
+
+  The previous solution and working set are forgotten.
+
+  \param n : dimension of the search space
+  \param p : number of inequality constraints
+  \param regularization : relative value added to the diagonal of \f$\mathbf{Q}^T\mathbf{Q}\f$, that ensures that
+  the cost is strictly convex even if \f$\mathbf{Q}\f$ is rank deficient (typically for redundant robots).
+  It is scaled by the largest diagonal element of \f$\mathbf{Q}^T\mathbf{Q}\f$.
+
+  \sa solveQPiRealTime()
+*/
+void vpQuadProg::initRealTime(unsigned int n, unsigned int p, const double &regularization)
+{
+  rt_n = n;
+  rt_p = p;
+  rt_regularization = regularization;
+  rt_H.resize(n, n);
+  rt_L.resize(n, n);
+  rt_V.resize(n, n);
+  rt_R.resize(n, n);
+  rt_c.resize(n);
+  rt_g.resize(n);
+  rt_w.resize(n);
+  rt_t.resize(n);
+  rt_s.resize(n);
+  rt_lambda.resize(n);
+  rt_x.resize(n);
+  // at most n linearly independent constraints can be active
+  rt_active.clear();
+  rt_active.reserve(n);
+  rt_prevActive.clear();
+  rt_prevActive.reserve(n);
+  rt_isActive.assign(p, false);
+  rt_isIgnored.assign(p, false);
+  rt_hasSolution = false;
+  rt_warmStart = false;
+  rt_iterations = 0;
+  rt_time = 0;
+}
+
+/*!
+  Adds the inequality constraint i to the working set of solveQPiRealTime().
+
+  The new column \f$\mathbf{v} = \mathbf{L}^{-1}\mathbf{c}_i\f$ is appended to \f$\mathbf{V}\f$ and the triangular
+  factor \f$\mathbf{R}\f$ such that \f$\mathbf{R}^T\mathbf{R} = \mathbf{V}^T\mathbf{V}\f$ is updated with a new
+  column, in \f$O(n^2)\f$.
+
+  \return False if the constraint is linearly dependent on the working set, that is then not modified. The
+  coefficients \f$\boldsymbol{\mu}\f$ such that \f$\mathbf{c}_i = \mathbf{C}_W^T\boldsymbol{\mu}\f$ are then
+  stored in the first elements of rt_t.
+*/
+bool vpQuadProg::addRealTimeConstraint(const vpMatrix &C, unsigned int i, const double &tol)
+{
+  const unsigned int n = rt_n;
+  const unsigned int m = static_cast<unsigned int>(rt_active.size());
+  if (m == n) {
+    // no coefficient is computed, the constraint cannot replace another one
+    for (unsigned int k = 0; k < m; ++k)
+      rt_t[k] = 0;
+    return false;
+  }
+
+  // v = L^-1 c_i, stored as the column m of V
+  double vv = 0;
+  for (unsigned int j = 0; j < n; ++j) {
+    double v = C[i][j];
+    for (unsigned int k = 0; k < j; ++k)
+      v -= rt_L[j][k] * rt_V[k][m];
+    v /= rt_L[j][j];
+    rt_V[j][m] = v;
+    vv += v * v;
+  }
+
+  // R^T r = V^T v, r is the new column of R
+  double rr = 0;
+  for (unsigned int k = 0; k < m; ++k) {
+    double u = 0;
+    for (unsigned int j = 0; j < n; ++j)
+      u += rt_V[j][k] * rt_V[j][m];
+    for (unsigned int l = 0; l < k; ++l)
+      u -= rt_R[l][k] * rt_R[l][m];
+    u /= rt_R[k][k];
+    rt_R[k][m] = u;
+    rr += u * u;
+  }
+
+  const double rho2 = vv - rr;
+  if (rho2 <= tol * tol * vv) {
+    // v = V mu, hence R mu = r
+    for (unsigned int k = m; k-- > 0;) {
+      double mu = rt_R[k][m];
+      for (unsigned int l = k + 1; l < m; ++l)
+        mu -= rt_R[k][l] * rt_t[l];
+      rt_t[k] = mu / rt_R[k][k];
+    }
+    for (unsigned int k = 0; k < m; ++k)
+      rt_R[k][m] = 0;
+    return false;
+  }
+  rt_R[m][m] = sqrt(rho2);
+  rt_active.push_back(i);
+  rt_isActive[i] = true;
+  return true;
+}
+
+/*!
+  Removes the k-th constraint of the working set of solveQPiRealTime().
+
+  The corresponding column is removed from \f$\mathbf{V}\f$ and \f$\mathbf{R}\f$, and the resulting Hessenberg
+  matrix is brought back to a triangular form with Givens rotations, in \f$O(n^2)\f$.
+*/
+void vpQuadProg::removeRealTimeConstraint(unsigned int k)
+{
+  const unsigned int n = rt_n;
+  const unsigned int m = static_cast<unsigned int>(rt_active.size());
+
+  // shift the columns of V and R
+  for (unsigned int l = k; l + 1 < m; ++l) {
+    for (unsigned int j = 0; j < n; ++j)
+      rt_V[j][l] = rt_V[j][l + 1];
+    for (unsigned int j = 0; j <= l + 1; ++j)
+      rt_R[j][l] = rt_R[j][l + 1];
+  }
+  for (unsigned int j = 0; j < m; ++j)
+    rt_R[j][m - 1] = 0;
+
+  // Givens rotations on the rows of R, that keep R^T R unchanged
+  for (unsigned int l = k; l + 1 < m; ++l) {
+    const double a = rt_R[l][l], b = rt_R[l + 1][l];
+    const double h = sqrt(a * a + b * b);
+    if (h > 0) {
+      const double c = a / h, s = b / h;
+      for (unsigned int j = l; j + 1 < m; ++j) {
+        const double r1 = rt_R[l][j], r2 = rt_R[l + 1][j];
+        rt_R[l][j] = c * r1 + s * r2;
+        rt_R[l + 1][j] = c * r2 - s * r1;
+      }
+    }
+    rt_R[l + 1][l] = 0;
+  }
+  // keep a positive diagonal
+  for (unsigned int l = k; l + 1 < m; ++l) {
+    if (rt_R[l][l] < 0) {
+      for (unsigned int j = l; j + 1 < m; ++j)
+        rt_R[l][j] = -rt_R[l][j];
+    }
+  }
+
+  rt_isActive[rt_active[k]] = false;
+  rt_active.erase(rt_active.begin() + k);
+}
+
+/*!
+  Computes the step \f$\mathbf{s}\f$ of solveQPiRealTime() that minimizes the cost from the current point while
+  keeping the working set active, together with the multipliers of the working set:
+
+  \f$\boldsymbol{\lambda} = -(\mathbf{V}^T\mathbf{V})^{-1}\mathbf{V}^T\mathbf{L}^{-1}\mathbf{g}\f$ and
+  \f$\mathbf{s} = -\mathbf{L}^{-T}(\mathbf{L}^{-1}\mathbf{g} + \mathbf{V}\boldsymbol{\lambda})\f$
+*/
+void vpQuadProg::computeRealTimeStep()
+{
+  const unsigned int n = rt_n;
+  const unsigned int m = static_cast<unsigned int>(rt_active.size());
+
+  // w = L^-1 g
+  for (unsigned int j = 0; j < n; ++j) {
+    double w = rt_g[j];
+    for (unsigned int k = 0; k < j; ++k)
+      w -= rt_L[j][k] * rt_w[k];
+    rt_w[j] = w / rt_L[j][j];
+  }
+
+  if (m) {
+    // R^T t = V^T w
+    for (unsigned int k = 0; k < m; ++k) {
+      double t = 0;
+      for (unsigned int j = 0; j < n; ++j)
+        t += rt_V[j][k] * rt_w[j];
+      for (unsigned int l = 0; l < k; ++l)
+        t -= rt_R[l][k] * rt_t[l];
+      rt_t[k] = t / rt_R[k][k];
+    }
+    // R lambda = -t
+    for (unsigned int k = m; k-- > 0;) {
+      double lambda = -rt_t[k];
+      for (unsigned int l = k + 1; l < m; ++l)
+        lambda -= rt_R[k][l] * rt_lambda[l];
+      rt_lambda[k] = lambda / rt_R[k][k];
+    }
+    // w += V lambda
+    for (unsigned int j = 0; j < n; ++j) {
+      for (unsigned int k = 0; k < m; ++k)
+        rt_w[j] += rt_V[j][k] * rt_lambda[k];
+    }
+  }
+
+  // L^T s = -w
+  for (unsigned int j = n; j-- > 0;) {
+    double s = -rt_w[j];
+    for (unsigned int k = j + 1; k < n; ++k)
+      s -= rt_L[k][j] * rt_s[k];
+    rt_s[j] = s / rt_L[j][j];
+  }
+}
+
+/*!
+  Solves a Quadratic Program under inequality constraints with a preallocated workspace, for real-time loops
+  where the dimensions of the problem do not change between two calls (e.g. velocity control of a robot under
+  joint limits).
+
+  \f$\begin{array}{lll}
+  \mathbf{x} = &  \arg\min & ||\mathbf{Q}\mathbf{x} - \mathbf{r}||^2 + \epsilon||\mathbf{x}||^2\\
+               & \text{s.t.}& \mathbf{C}\mathbf{x} \leq \mathbf{d}
+\end{array}
+\f$
+  where \f$\epsilon\f$ is the regularization given to initRealTime().
+
+  The solver is a primal active set method that starts from the previous solution if it is still feasible, or
+  else from 0. The constraints of the previous working set that are still active at this point are used to warm
+  start the working set. The factorization of the working set is then updated incrementally at each iteration
+  instead of being recomputed. If no feasible starting point is known, one is computed with the simplex as in
+  solveQPi(), which allocates memory.
+
+  Equality constraints are not supported by this solver, they may be written as two opposite inequalities.
+
+  \param Q : cost matrix (dimension c x n)
+  \param r : cost vector (dimension c)
+  \param C : inequality matrix (dimension p x n)
+  \param d : inequality vector (dimension p)
+  \param x : solution (dimension n)
+  \param tol : tolerance to test the constraints and the optimality
+
+  \return True if the solution was found.
+
+  Here is an example:
+  \code
+  #include <visp3/core/vpQuadProg.h>
+
+  int main()
+  {
+    const unsigned int n = 6;
+    vpMatrix Q(n, n), C(2*n, n);
+    vpColVector r(n), d(2*n, 0.5);
+    // joint velocity limits
+    for(unsigned int i = 0; i < n; ++i)
+    {
+      Q[i][i] = 1;
+      C[i][i] = 1;
+      C[n+i][i] = -1;
+    }
+
+    vpQuadProg qp;
+    qp.initRealTime(n, 2*n);
+    vpColVector x;
+    for(unsigned int k = 0; k < 100; ++k)
+    {
+      for(unsigned int i = 0; i < n; ++i)
+        r[i] = sin(0.1*k + i);
+      qp.solveQPiRealTime(Q, r, C, d, x);
+      std::cout << qp.getIterations() << " iterations in " << qp.getSolveTime() << " ms" << std::endl;
+    }
+  }
+  \endcode
+
+  \sa initRealTime(), getIterations(), getSolveTime()
+*/
+bool vpQuadProg::solveQPiRealTime(const vpMatrix &Q, const vpColVector &r,
+                                  const vpMatrix &C, const vpColVector &d,
+                                  vpColVector &x, const double &tol)
+{
+  const double t0 = vpTime::measureTimeMs();
+  const unsigned int n = checkDimensions(Q, r, NULL, NULL, &C, &d, "solveQPiRealTime");
+  const unsigned int p = C.getRows();
+  if (n != rt_n || p != rt_p || d.getRows() != p) {
+    std::cout << "vpQuadProg::solveQPiRealTime: dimensions differ from initRealTime(" << rt_n << ", " << rt_p << ")"
+              << std::endl;
+    throw vpMatrixException::dimensionError;
+  }
+  rt_iterations = 0;
+
+  // H = Q^T Q + eps I, c = -Q^T r
+  double diagMax = 1;
+  for (unsigned int i = 0; i < n; ++i) {
+    for (unsigned int j = i; j < n; ++j) {
+      double h = 0;
+      for (unsigned int k = 0; k < Q.getRows(); ++k)
+        h += Q[k][i] * Q[k][j];
+      rt_H[i][j] = rt_H[j][i] = h;
+    }
+    double c = 0;
+    for (unsigned int k = 0; k < Q.getRows(); ++k)
+      c -= Q[k][i] * r[k];
+    rt_c[i] = c;
+    diagMax = std::max(diagMax, rt_H[i][i]);
+  }
+  for (unsigned int i = 0; i < n; ++i)
+    rt_H[i][i] += rt_regularization * diagMax;
+
+  // Cholesky factorization H = L L^T
+  for (unsigned int j = 0; j < n; ++j) {
+    double s = rt_H[j][j];
+    for (unsigned int k = 0; k < j; ++k)
+      s -= rt_L[j][k] * rt_L[j][k];
+    if (s <= 0) {
+      std::cout << "vpQuadProg::solveQPiRealTime: cost is not strictly convex, increase the regularization"
+                << std::endl;
+      rt_time = vpTime::measureTimeMs() - t0;
+      return false;
+    }
+    rt_L[j][j] = sqrt(s);
+    for (unsigned int i = j + 1; i < n; ++i) {
+      double l = rt_H[i][j];
+      for (unsigned int k = 0; k < j; ++k)
+        l -= rt_L[i][k] * rt_L[j][k];
+      rt_L[i][j] = l / rt_L[j][j];
+      rt_L[j][i] = 0;
+    }
+  }
+
+  // starting point: previous solution, or 0, or from the simplex
+  if (x.getRows() != n)
+    x.resize(n, false);
+  rt_warmStart = true;
+  if (rt_hasSolution) {
+    for (unsigned int i = 0; i < n; ++i)
+      x[i] = rt_x[i];
+  }
+  if (!rt_hasSolution || !isFeasible(C, x, d, tol)) {
+    x = 0;
+    if (!vpLinProg::allGreater(d, -tol)) {
+      rt_warmStart = false;
+      active.clear();
+      if (!solveQPi(Q, r, C, d, x, false, tol)) {
+        rt_hasSolution = false;
+        rt_time = vpTime::measureTimeMs() - t0;
+        return false;
+      }
+    }
+  }
+
+  // working set from the previous one, restricted to the constraints that are still active
+  rt_prevActive.assign(rt_active.begin(), rt_active.end());
+  rt_active.clear();
+  std::fill(rt_isActive.begin(), rt_isActive.end(), false);
+  std::fill(rt_isIgnored.begin(), rt_isIgnored.end(), false);
+  for (unsigned int k = 0; k < rt_prevActive.size(); ++k) {
+    const unsigned int i = rt_prevActive[k];
+    double cx = 0;
+    for (unsigned int j = 0; j < n; ++j)
+      cx += C[i][j] * x[j];
+    if (std::fabs(cx - d[i]) <= tol)
+      addRealTimeConstraint(C, i, tol);
+  }
+
+  // gradient g = H x + c
+  for (unsigned int i = 0; i < n; ++i) {
+    double g = rt_c[i];
+    for (unsigned int j = 0; j < n; ++j)
+      g += rt_H[i][j] * x[j];
+    rt_g[i] = g;
+  }
+
+  const unsigned int maxIterations = 10 * (n + p) + 10;
+  bool optimal = false;
+  while (rt_iterations < maxIterations) {
+    rt_iterations++;
+    computeRealTimeStep();
+
+    if (vpLinProg::allZero(rt_s, tol)) {
+      // check the multipliers of the working set
+      unsigned int ineqInd = static_cast<unsigned int>(rt_active.size());
+      double ineqMin = -tol;
+      for (unsigned int k = 0; k < rt_active.size(); ++k) {
+        if (rt_lambda[k] < ineqMin) {
+          ineqInd = k;
+          ineqMin = rt_lambda[k];
+        }
+      }
+      if (ineqInd == rt_active.size()) {
+        optimal = true;
+        break;
+      }
+      removeRealTimeConstraint(ineqInd);
+    } else {
+      // step length to the closest blocking constraint
+      double alpha = 1;
+      unsigned int blocking = p;
+      for (unsigned int i = 0; i < p; ++i) {
+        if (rt_isActive[i] || rt_isIgnored[i])
+          continue;
+        double cs = 0, cx = 0;
+        for (unsigned int j = 0; j < n; ++j) {
+          cs += C[i][j] * rt_s[j];
+          cx += C[i][j] * x[j];
+        }
+        if (cs > tol) {
+          const double a = std::max(0., (d[i] - cx) / cs);
+          if (a < alpha) {
+            alpha = a;
+            blocking = i;
+          }
+        }
+      }
+
+      // x += alpha s, g += alpha H s
+      for (unsigned int i = 0; i < n; ++i) {
+        x[i] += alpha * rt_s[i];
+        double hs = 0;
+        for (unsigned int j = 0; j < n; ++j)
+          hs += rt_H[i][j] * rt_s[j];
+        rt_g[i] += alpha * hs;
+      }
+      if (blocking < p && !addRealTimeConstraint(C, blocking, tol)) {
+        // The blocking constraint is linearly dependent on the working set, c_b = C_W^T mu, and would block the
+        // same step at the next iteration. As in the method of Goldfarb and Idnani, it replaces the constraint with
+        // the smallest ratio lambda_k / mu_k among mu_k > 0, or else the one with the largest |mu_k|, so that the
+        // working set remains independent. It is only ignored if no constraint can be replaced.
+        const unsigned int m = static_cast<unsigned int>(rt_active.size());
+        unsigned int dropped = m;
+        double ratioMin = 0;
+        for (unsigned int k = 0; k < m; ++k) {
+          if (rt_t[k] > tol && (dropped == m || rt_lambda[k] / rt_t[k] < ratioMin)) {
+            dropped = k;
+            ratioMin = rt_lambda[k] / rt_t[k];
+          }
+        }
+        if (dropped == m) {
+          double muMax = tol;
+          for (unsigned int k = 0; k < m; ++k) {
+            if (std::fabs(rt_t[k]) > muMax) {
+              dropped = k;
+              muMax = std::fabs(rt_t[k]);
+            }
+          }
+        }
+        if (dropped < m)
+          removeRealTimeConstraint(dropped);
+        if (dropped == m || !addRealTimeConstraint(C, blocking, tol))
+          rt_isIgnored[blocking] = true;
+      }
+    }
+  }
+
+  for (unsigned int i = 0; i < n; ++i)
+    rt_x[i] = x[i];
+  rt_hasSolution = true;
+  rt_time = vpTime::measureTimeMs() - t0;
+  if (!optimal)
+    std::cout << "vpQuadProg::solveQPiRealTime: maximum number of iterations reached" << std::endl;
+  return optimal;
+}
 #else
 void dummy_vpQuadProg(){};
 #endif
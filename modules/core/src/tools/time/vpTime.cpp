@@ -134,6 +134,30 @@ double measureTimeMicros()
 #endif
 }
 
+/*!
+  Return the time in milliseconds elapsed since an unspecified origin, from a
+  clock that is not affected by the changes of the system time. Contrary to
+  measureTimeMs(), two successive calls never go back in time, which makes
+  it the function to use to measure durations.
+
+  When the system does not provide such a clock, the time returned by
+  measureTimeMs() is used.
+
+  \sa measureTimeMs()
+*/
+double measureMonotonicTimeMs()
+{
+#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) &&   \
+    defined(CLOCK_MONOTONIC)
+  struct timespec tp;
+  if (clock_gettime(CLOCK_MONOTONIC, &tp) == 0) {
+    return (1000.0 * tp.tv_sec + tp.tv_nsec / 1000000.0);
+  }
+#endif
+  // QueryPerformanceCounter() used on Windows is already monotonic
+  return measureTimeMs();
+}
+
 /*!
 
   Wait t miliseconds after t0 (in ms).
@@ -0,0 +1,477 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Tracing of the time spent in the main functions of ViSP.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpTracing.cpp
+  \brief Tracing of the time spent in the main functions of ViSP.
+*/
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpMutex.h>
+#include <visp3/core/vpTime.h>
+#include <visp3/core/vpTracing.h>
+
+#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
+#include <unistd.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+
+#if defined(_MSC_VER)
+#define VP_THREAD_LOCAL __declspec(thread)
+#else
+#define VP_THREAD_LOCAL __thread
+#endif
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+struct vpEvent {
+  const char *name;
+  //! Time since the origin of the trace in ms
+  double ts;
+  //! Duration in ms of a complete event
+  double dur;
+  //! 'X' for a complete event, 'B' or 'E' for the beginning or the end of
+  //! a span
+  char phase;
+};
+
+// Events recorded by a thread. Only the thread writes in its buffer, the
+// other threads read it when the trace is saved. The events are stored in
+// chunks of growing size, allocated as they are recorded, so that the many
+// short-lived threads that only record a few events take little memory.
+struct vpThreadBuffer {
+  vpThreadBuffer() : nbChunks(0), capacity(0), maxSize(0), size(0), dropped(0), tid(0), name()
+  {
+    for (unsigned int k = 0; k < maxNbChunks; k++) {
+      chunks[k] = NULL;
+      chunkSizes[k] = 0;
+    }
+  }
+  ~vpThreadBuffer() { release(); }
+
+  // Slot of the next event, NULL if the buffer is full
+  vpEvent *append()
+  {
+    const unsigned int n = size;
+    if (n == capacity) {
+      if (capacity >= maxSize || nbChunks == maxNbChunks)
+        return NULL;
+      chunkSizes[nbChunks] = std::min(firstChunkSize << nbChunks, maxSize - capacity);
+      chunks[nbChunks] = new vpEvent[chunkSizes[nbChunks]];
+      capacity += chunkSizes[nbChunks];
+      nbChunks++;
+    }
+    // The event is in the last chunk, that ends at the capacity
+    return chunks[nbChunks - 1] + (n + chunkSizes[nbChunks - 1] - capacity);
+  }
+
+  const vpEvent &at(unsigned int i) const
+  {
+    unsigned int k = 0;
+    while (i >= chunkSizes[k]) {
+      i -= chunkSizes[k];
+      k++;
+    }
+    return chunks[k][i];
+  }
+
+  void release()
+  {
+    for (unsigned int k = 0; k < nbChunks; k++) {
+      delete[] chunks[k];
+      chunks[k] = NULL;
+      chunkSizes[k] = 0;
+    }
+    nbChunks = 0;
+    capacity = 0;
+    size = 0;
+  }
+
+  static const unsigned int firstChunkSize = 16;
+  static const unsigned int maxNbChunks = 27; // 16 (2^27 - 1) events at most
+
+  vpEvent *chunks[maxNbChunks];
+  unsigned int chunkSizes[maxNbChunks];
+  unsigned int nbChunks;
+  unsigned int capacity;
+  unsigned int maxSize;
+  volatile unsigned int size;
+  unsigned int dropped;
+  unsigned int tid;
+  std::string name;
+};
+
+struct vpRegistry {
+  vpRegistry() : buffers() {}
+  ~vpRegistry()
+  {
+    for (size_t i = 0; i < buffers.size(); i++) {
+      delete buffers[i];
+    }
+  }
+
+  std::vector<vpThreadBuffer *> buffers;
+};
+
+vpRegistry s_registry;
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+vpMutex s_mutex;
+#endif
+volatile bool s_started = false;
+bool s_hasOrigin = false;
+double s_origin = 0;
+unsigned int s_bufferSize = 65536;
+
+VP_THREAD_LOCAL vpThreadBuffer *t_buffer = NULL;
+
+void lockRegistry()
+{
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+  s_mutex.lock();
+#endif
+}
+
+void unlockRegistry()
+{
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+  s_mutex.unlock();
+#endif
+}
+
+vpThreadBuffer *getThreadBuffer()
+{
+  if (t_buffer == NULL) {
+    vpThreadBuffer *buffer = new vpThreadBuffer;
+    lockRegistry();
+    buffer->maxSize = s_bufferSize;
+    s_registry.buffers.push_back(buffer);
+    buffer->tid = (unsigned int)s_registry.buffers.size();
+    unlockRegistry();
+    t_buffer = buffer;
+  }
+  return t_buffer;
+}
+
+void record(const char *name, const char phase, const double ts, const double dur)
+{
+  vpThreadBuffer *buffer = getThreadBuffer();
+  vpEvent *event = buffer->append();
+  if (event != NULL) {
+    event->name = name;
+    event->ts = ts - s_origin;
+    event->dur = dur;
+    event->phase = phase;
+    buffer->size = buffer->size + 1;
+  } else {
+    buffer->dropped++;
+  }
+}
+
+void writeJsonString(std::ostream &os, const char *str)
+{
+  os << '"';
+  for (const char *c = str; c != NULL && *c != '\0'; c++) {
+    if (*c == '"' || *c == '\\') {
+      os << '\\' << *c;
+    } else if ((unsigned char)*c < 0x20) {
+      os << ' ';
+    } else {
+      os << *c;
+    }
+  }
+  os << '"';
+}
+
+unsigned long getProcessId()
+{
+#if !defined(_WIN32) && (defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))) // UNIX
+  return (unsigned long)getpid();
+#elif defined(_WIN32) && !defined(WINRT)
+  return (unsigned long)GetCurrentProcessId();
+#else
+  return 1;
+#endif
+}
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Start a span named \e name if the tracing is started.
+
+  \param name : Name of the span, that has to remain valid until the trace
+  is saved.
+*/
+vpTracing::vpScope::vpScope(const char *name)
+  : m_name(name), m_start(s_started ? vpTime::measureMonotonicTimeMs() : -1)
+{
+}
+
+/*!
+  Record the span if the tracing was started at its beginning.
+*/
+vpTracing::vpScope::~vpScope()
+{
+  if (m_start >= 0) {
+    record(m_name, 'X', m_start, vpTime::measureMonotonicTimeMs() - m_start);
+  }
+}
+
+/*!
+  Begin a span in the calling thread. It ends with the next call to end()
+  in the same thread. The spans can be nested. Nothing is recorded when the
+  tracing is not started.
+
+  \param name : Name of the span, that has to remain valid until the trace
+  is saved.
+
+  \sa VP_TRACING_BEGIN()
+*/
+void vpTracing::begin(const char *name)
+{
+  if (s_started) {
+    record(name, 'B', vpTime::measureMonotonicTimeMs(), 0);
+  }
+}
+
+/*!
+  Remove all the recorded spans and apply the buffer size given to
+  setBufferSize() to all the threads. The next call to start() sets the
+  origin of the time stamps.
+
+  \warning The other threads must not record spans during the call.
+*/
+void vpTracing::clear()
+{
+  lockRegistry();
+  for (size_t i = 0; i < s_registry.buffers.size(); i++) {
+    vpThreadBuffer *buffer = s_registry.buffers[i];
+    buffer->release();
+    buffer->dropped = 0;
+    buffer->maxSize = s_bufferSize;
+  }
+  s_hasOrigin = false;
+  unlockRegistry();
+}
+
+/*!
+  End the last span begun with begin() in the calling thread. Nothing is
+  recorded when the tracing is not started.
+
+  \sa VP_TRACING_END()
+*/
+void vpTracing::end()
+{
+  if (s_started) {
+    record(NULL, 'E', vpTime::measureMonotonicTimeMs(), 0);
+  }
+}
+
+/*!
+  Return the maximum number of events recorded by each thread. A span
+  created with vpScope is one event, a span delimited by begin() and end()
+  is two events.
+*/
+unsigned int vpTracing::getBufferSize() { return s_bufferSize; }
+
+/*!
+  Return the number of events that could not be recorded because the buffer
+  of their thread was full.
+*/
+unsigned int vpTracing::getNbDroppedEvents()
+{
+  unsigned int nb = 0;
+  lockRegistry();
+  for (size_t i = 0; i < s_registry.buffers.size(); i++) {
+    nb += s_registry.buffers[i]->dropped;
+  }
+  unlockRegistry();
+  return nb;
+}
+
+/*!
+  Return the number of events recorded by all the threads.
+*/
+unsigned int vpTracing::getNbEvents()
+{
+  unsigned int nb = 0;
+  lockRegistry();
+  for (size_t i = 0; i < s_registry.buffers.size(); i++) {
+    nb += s_registry.buffers[i]->size;
+  }
+  unlockRegistry();
+  return nb;
+}
+
+/*!
+  Return true if the spans are recorded.
+*/
+bool vpTracing::isStarted() { return s_started; }
+
+/*!
+  Save the recorded spans in a JSON file in the Chrome trace event format.
+
+  \param filename : Name of the file, usually with the .json extension.
+
+  \exception vpException::ioError : If the file cannot be created.
+
+  \sa writeChromeTrace()
+*/
+void vpTracing::saveChromeTrace(const std::string &filename)
+{
+  std::ofstream file(filename.c_str());
+  if (!file.is_open()) {
+    throw(vpException(vpException::ioError, "Cannot create the trace file %s", filename.c_str()));
+  }
+  writeChromeTrace(file);
+}
+
+/*!
+  Set the maximum number of events recorded by each thread. It applies to
+  the threads that record their first span afterwards, and to all the
+  threads after a call to clear(). The default size is 65536 events. The
+  memory of the events, 32 bytes each, is allocated as they are recorded.
+
+  \param nbEvents : Maximum number of events of each thread.
+*/
+void vpTracing::setBufferSize(const unsigned int nbEvents)
+{
+  lockRegistry();
+  s_bufferSize = nbEvents;
+  unlockRegistry();
+}
+
+/*!
+  Set the name of the calling thread in the trace. By default, the threads
+  are named after their order of appearance in the trace.
+
+  \param name : Name of the thread.
+*/
+void vpTracing::setThreadName(const std::string &name)
+{
+  vpThreadBuffer *buffer = getThreadBuffer();
+  lockRegistry();
+  buffer->name = name;
+  unlockRegistry();
+}
+
+/*!
+  Start the recording of the spans. The time stamps of the trace are
+  relative to the first call to start(), or to the first one after clear().
+*/
+void vpTracing::start()
+{
+  lockRegistry();
+  if (!s_hasOrigin) {
+    s_origin = vpTime::measureMonotonicTimeMs();
+    s_hasOrigin = true;
+  }
+  unlockRegistry();
+  s_started = true;
+}
+
+/*!
+  Stop the recording of the spans. The spans that began before are still
+  recorded when they end.
+*/
+void vpTracing::stop() { s_started = false; }
+
+/*!
+  Write the recorded spans in the Chrome trace event format. The result can
+  be opened in chrome://tracing or in https://ui.perfetto.dev.
+
+  \warning The trace has to be written once the other threads stopped
+  recording spans, for example after stop().
+
+  \param os : Output stream.
+*/
+void vpTracing::writeChromeTrace(std::ostream &os)
+{
+  const unsigned long pid = getProcessId();
+  std::ios_base::fmtflags flags = os.flags();
+  std::streamsize precision = os.precision();
+  os << std::fixed << std::setprecision(3);
+
+  lockRegistry();
+  os << "{\"traceEvents\": [";
+  unsigned int dropped = 0;
+  bool first = true;
+  for (size_t i = 0; i < s_registry.buffers.size(); i++) {
+    const vpThreadBuffer *buffer = s_registry.buffers[i];
+    dropped += buffer->dropped;
+
+    std::ostringstream name;
+    if (buffer->name.empty())
+      name << "Thread " << buffer->tid;
+    else
+      name << buffer->name;
+    os << (first ? "\n" : ",\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": " << pid
+       << ", \"tid\": " << buffer->tid << ", \"args\": {\"name\": ";
+    writeJsonString(os, name.str().c_str());
+    os << "}}";
+    first = false;
+
+    const unsigned int size = buffer->size;
+    for (unsigned int j = 0; j < size; j++) {
+      const vpEvent &event = buffer->at(j);
+      os << ",\n{";
+      if (event.phase != 'E') {
+        os << "\"name\": ";
+        writeJsonString(os, event.name);
+        os << ", \"cat\": \"visp\", ";
+      }
+      // Chrome trace time stamps are in microseconds
+      os << "\"ph\": \"" << event.phase << "\", \"ts\": " << 1000.0 * event.ts;
+      if (event.phase == 'X') {
+        os << ", \"dur\": " << 1000.0 * event.dur;
+      }
+      os << ", \"pid\": " << pid << ", \"tid\": " << buffer->tid << "}";
+    }
+  }
+  unlockRegistry();
+
+  os << "\n], \"displayTimeUnit\": \"ms\", \"otherData\": {\"visp_version\": \"" << VISP_VERSION_MAJOR << "."
+     << VISP_VERSION_MINOR << "." << VISP_VERSION_PATCH << "\", \"dropped_events\": " << dropped << "}}\n";
+
+  os.flags(flags);
+  os.precision(precision);
+}
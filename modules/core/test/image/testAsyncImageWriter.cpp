@@ -0,0 +1,221 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the writing of images with background threads.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testAsyncImageWriter.cpp
+
+  Write images with vpAsyncImageWriter and vpVideoWriter::setAsync(), with
+  the blocking and dropping policies, and check the content of the files.
+*/
+
+#include <iostream>
+
+#include <visp3/core/vpIoTools.h>
+#include <visp3/io/vpAsyncImageWriter.h>
+#include <visp3/io/vpImageIo.h>
+#include <visp3/io/vpVideoWriter.h>
+
+namespace
+{
+void fill(vpImage<unsigned char> &I, unsigned int number)
+{
+  for (unsigned int i = 0; i < I.getHeight(); i++)
+    for (unsigned int j = 0; j < I.getWidth(); j++)
+      I[i][j] = (unsigned char)((number * 13 + i + 2 * j) % 256);
+}
+
+void fill(vpImage<vpRGBa> &I, unsigned int number)
+{
+  for (unsigned int i = 0; i < I.getHeight(); i++)
+    for (unsigned int j = 0; j < I.getWidth(); j++)
+      I[i][j] = vpRGBa((unsigned char)((number * 13 + i + 2 * j) % 256), (unsigned char)(number % 256), 17);
+}
+
+bool check(const vpImage<unsigned char> &I, unsigned int number)
+{
+  vpImage<unsigned char> I_ref(I.getHeight(), I.getWidth());
+  fill(I_ref, number);
+  return I.getSize() > 0 && I_ref == I;
+}
+
+bool check(const vpImage<vpRGBa> &I, unsigned int number)
+{
+  vpImage<vpRGBa> I_ref(I.getHeight(), I.getWidth());
+  fill(I_ref, number);
+  for (unsigned int k = 0; k < I.getSize(); k++) {
+    if (I.bitmap[k].R != I_ref.bitmap[k].R || I.bitmap[k].G != I_ref.bitmap[k].G || I.bitmap[k].B != I_ref.bitmap[k].B)
+      return false;
+  }
+  return I.getSize() > 0;
+}
+
+std::string getName(const std::string &opath, unsigned int number, const std::string &ext)
+{
+  char filename[FILENAME_MAX];
+  sprintf(filename, "%s/image%04u.%s", opath.c_str(), number, ext.c_str());
+  return filename;
+}
+
+template <class Type>
+bool testWriter(const std::string &opath, const std::string &ext, unsigned int nbThreads, unsigned int queueSize,
+                const vpAsyncImageWriter::vpQueuePolicy &policy)
+{
+  const unsigned int nbImages = 30;
+  vpAsyncImageWriter writer(nbThreads, queueSize, policy);
+  vpImage<Type> I(120, 160);
+  std::vector<bool> written(nbImages);
+  unsigned int nbDropped = 0;
+  for (unsigned int n = 0; n < nbImages; n++) {
+    fill(I, n);
+    written[n] = writer.write(I, getName(opath, n, ext));
+    if (!written[n])
+      nbDropped++;
+  }
+  // The images are copied by write()
+  fill(I, nbImages);
+  writer.flush();
+
+  if (writer.getNbDroppedImages() != nbDropped || (policy == vpAsyncImageWriter::BLOCK && nbDropped != 0)) {
+    std::cerr << "Wrong number of dropped images: " << writer.getNbDroppedImages() << std::endl;
+    return false;
+  }
+  for (unsigned int n = 0; n < nbImages; n++) {
+    if (written[n]) {
+      vpImage<Type> I_read;
+      vpImageIo::read(I_read, getName(opath, n, ext));
+      if (!check(I_read, n)) {
+        std::cerr << "Wrong content of " << getName(opath, n, ext) << std::endl;
+        return false;
+      }
+    }
+  }
+  std::cout << "  " << nbImages - nbDropped << " images written, " << nbDropped << " dropped" << std::endl;
+
+  // The errors of the threads are reported by flush()
+  writer.write(I, opath + "/not/existing/image.pgm");
+  try {
+    writer.flush();
+    std::cerr << "No exception when writing in a missing directory" << std::endl;
+    return false;
+  } catch (const vpException &e) {
+    std::cout << "  Expected error: " << e.getStringMessage() << std::endl;
+  }
+  writer.flush();
+
+  return true;
+}
+
+bool testVideoWriter(const std::string &opath, const vpAsyncImageWriter::vpQueuePolicy &policy)
+{
+  const unsigned int nbFrames = 20;
+  vpImage<unsigned char> I(120, 160);
+  vpVideoWriter writer;
+  writer.setFileName(opath + "/frame%04d.pgm");
+  writer.setFirstFrameIndex(1);
+  writer.setAsync(2, 3, policy);
+  writer.open(I);
+  for (unsigned int n = 1; n <= nbFrames; n++) {
+    fill(I, n);
+    writer.saveFrame(I);
+  }
+  writer.close();
+
+  // The dropped frames leave no gap in the sequence
+  const unsigned int nbWritten = writer.getCurrentFrameIndex() - 1;
+  if (nbWritten + writer.getNbDroppedFrames() != nbFrames) {
+    std::cerr << "Wrong number of frames: " << nbWritten << " written, " << writer.getNbDroppedFrames()
+              << " dropped" << std::endl;
+    return false;
+  }
+  for (unsigned int n = 1; n <= nbWritten; n++) {
+    char filename[FILENAME_MAX];
+    sprintf(filename, "%s/frame%04u.pgm", opath.c_str(), n);
+    vpImage<unsigned char> I_read;
+    vpImageIo::read(I_read, filename);
+    if (I_read.getSize() != I.getSize() || (policy == vpAsyncImageWriter::BLOCK && !check(I_read, n))) {
+      std::cerr << "Wrong content of " << filename << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int main()
+{
+  try {
+    std::string username;
+    vpIoTools::getUserName(username);
+#if defined(_WIN32)
+    std::string opath = "C:/temp/" + username;
+#else
+    std::string opath = "/tmp/" + username;
+#endif
+    opath = vpIoTools::createFilePath(opath, "testAsyncImageWriter");
+    if (!vpIoTools::checkDirectory(opath))
+      vpIoTools::makeDirectory(opath);
+
+    std::vector<std::string> extensions;
+    extensions.push_back("pgm");
+#if defined(VISP_HAVE_PNG)
+    extensions.push_back("png");
+#endif
+
+    const unsigned int nbThreads[] = {0, 1, 4};
+    for (size_t e = 0; e < extensions.size(); e++) {
+      for (unsigned int t = 0; t < 3; t++) {
+        std::cout << "** Test " << extensions[e] << " with " << nbThreads[t] << " threads" << std::endl;
+        if (!testWriter<unsigned char>(opath, extensions[e], nbThreads[t], 4, vpAsyncImageWriter::BLOCK) ||
+            !testWriter<unsigned char>(opath, extensions[e], nbThreads[t], 1, vpAsyncImageWriter::BLOCK) ||
+            !testWriter<unsigned char>(opath, extensions[e], nbThreads[t], 2, vpAsyncImageWriter::DROP)) {
+          return EXIT_FAILURE;
+        }
+      }
+    }
+    std::cout << "** Test color images" << std::endl;
+    if (!testWriter<vpRGBa>(opath, "ppm", 3, 4, vpAsyncImageWriter::BLOCK))
+      return EXIT_FAILURE;
+
+    std::cout << "** Test vpVideoWriter" << std::endl;
+    if (!testVideoWriter(opath, vpAsyncImageWriter::BLOCK) || !testVideoWriter(opath, vpAsyncImageWriter::DROP))
+      return EXIT_FAILURE;
+
+    std::cout << "Test succeed" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const vpException &e) {
+    std::cout << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+}
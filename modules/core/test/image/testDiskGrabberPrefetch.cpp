@@ -0,0 +1,218 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the reading in advance of an image sequence.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testDiskGrabberPrefetch.cpp
+
+  Write a sequence of images and check that the images read in advance by
+  vpDiskGrabber and vpVideoReader are the expected ones, sequentially, with a
+  step and with a random access.
+*/
+
+#include <iostream>
+
+#include <visp3/core/vpIoTools.h>
+#include <visp3/io/vpDiskGrabber.h>
+#include <visp3/io/vpImageIo.h>
+#include <visp3/io/vpVideoReader.h>
+
+namespace
+{
+const long nbImages = 20;
+
+unsigned char pixel(long number, unsigned int i, unsigned int j)
+{
+  return (unsigned char)((number * 11 + i * 3 + j) % 256);
+}
+
+template <class Type> bool check(const vpImage<Type> &I, long number);
+
+template <> bool check(const vpImage<unsigned char> &I, long number)
+{
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      if (I[i][j] != pixel(number, i, j)) {
+        std::cerr << "Wrong content, expected image " << number << std::endl;
+        return false;
+      }
+    }
+  }
+  return I.getSize() > 0;
+}
+
+template <> bool check(const vpImage<vpRGBa> &I, long number)
+{
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      if (I[i][j].R != pixel(number, i, j) || I[i][j].G != pixel(number, i, j)) {
+        std::cerr << "Wrong content, expected color image " << number << std::endl;
+        return false;
+      }
+    }
+  }
+  return I.getSize() > 0;
+}
+
+template <class Type> bool testGrabber(const std::string &generic_name, unsigned int prefetch)
+{
+  vpImage<Type> I;
+  vpDiskGrabber g(generic_name);
+  g.setPrefetch(prefetch);
+  g.setImageNumber(1);
+  g.open(I);
+  if (!check(I, 1))
+    return false;
+
+  // Sequential reading
+  for (long n = 1; n <= 10; n++) {
+    g.acquire(I);
+    if (g.getImageNumber() != n || !check(I, n))
+      return false;
+  }
+
+  // Change of step, forward then backward
+  g.setStep(3);
+  for (long n = 11; n <= nbImages; n += 3) {
+    g.acquire(I);
+    if (!check(I, n))
+      return false;
+  }
+  g.setStep(-2);
+  g.setImageNumber(19);
+  for (long n = 19; n >= 1; n -= 2) {
+    g.acquire(I);
+    if (!check(I, n))
+      return false;
+  }
+
+  // Random access
+  const long numbers[] = {7, 7, 15, 2, 3, 1, 20};
+  g.setStep(1);
+  for (unsigned int k = 0; k < sizeof(numbers) / sizeof(numbers[0]); k++) {
+    g.acquire(I, numbers[k]);
+    if (g.getImageNumber() != numbers[k] || !check(I, numbers[k]))
+      return false;
+  }
+
+  // Reading after the end of the sequence
+  bool error = false;
+  try {
+    g.acquire(I);
+  } catch (const vpException &) {
+    error = true;
+  }
+  if (!error) {
+    std::cerr << "No exception when reading a missing image" << std::endl;
+    return false;
+  }
+  g.acquire(I, 5);
+  if (!check(I, 5))
+    return false;
+
+  g.close();
+  return true;
+}
+
+bool testVideoReader(const std::string &generic_name, unsigned int prefetch)
+{
+  vpImage<unsigned char> I;
+  vpVideoReader reader;
+  reader.setFileName(generic_name);
+  reader.setPrefetch(prefetch);
+  reader.setFrameStep(2);
+  reader.open(I);
+  if (reader.getFirstFrameIndex() != 1 || reader.getLastFrameIndex() != nbImages)
+    return false;
+
+  long n = 1;
+  while (!reader.end()) {
+    reader.acquire(I);
+    if (reader.getFrameIndex() != n || !check(I, n))
+      return false;
+    n += 2;
+  }
+  if (n != nbImages + 1) {
+    std::cerr << "Wrong number of frames" << std::endl;
+    return false;
+  }
+
+  if (!reader.getFrame(I, 12) || !check(I, 12) || !reader.getFrame(I, 4) || !check(I, 4))
+    return false;
+
+  return true;
+}
+}
+
+int main()
+{
+  try {
+    std::string username;
+    vpIoTools::getUserName(username);
+#if defined(_WIN32)
+    std::string opath = "C:/temp/" + username;
+#else
+    std::string opath = "/tmp/" + username;
+#endif
+    opath = vpIoTools::createFilePath(opath, "testDiskGrabberPrefetch");
+    if (!vpIoTools::checkDirectory(opath))
+      vpIoTools::makeDirectory(opath);
+
+    vpImage<unsigned char> I(24, 32);
+    for (long n = 1; n <= nbImages; n++) {
+      for (unsigned int i = 0; i < I.getHeight(); i++)
+        for (unsigned int j = 0; j < I.getWidth(); j++)
+          I[i][j] = pixel(n, i, j);
+      char filename[FILENAME_MAX];
+      sprintf(filename, "%s/image%04ld.pgm", opath.c_str(), n);
+      vpImageIo::write(I, filename);
+    }
+    const std::string generic_name = opath + "/image%04d.pgm";
+
+    const unsigned int prefetch[] = {0, 1, 4, 32};
+    for (unsigned int k = 0; k < sizeof(prefetch) / sizeof(prefetch[0]); k++) {
+      std::cout << "** Test with " << prefetch[k] << " images read in advance" << std::endl;
+      if (!testGrabber<unsigned char>(generic_name, prefetch[k]) || !testGrabber<vpRGBa>(generic_name, prefetch[k]) ||
+          !testVideoReader(generic_name, prefetch[k])) {
+        return EXIT_FAILURE;
+      }
+    }
+
+    std::cout << "Test succeed" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const vpException &e) {
+    std::cout << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,327 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the frame log writer and reader.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testFrameLog.cpp
+
+  Write grey level, color, depth and float frames in a frame log, read them
+  back with and without copy, append frames, recover a truncated log and
+  record a video in a log with vpVideoWriter and vpVideoReader.
+*/
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include <visp3/core/vpIoTools.h>
+#include <visp3/io/vpFrameLogReader.h>
+#include <visp3/io/vpFrameLogWriter.h>
+#include <visp3/io/vpVideoReader.h>
+#include <visp3/io/vpVideoWriter.h>
+
+namespace
+{
+template <class Type> Type value(unsigned int number, unsigned int i, unsigned int j)
+{
+  return (Type)((number * 13 + i + 2 * j) % 256);
+}
+
+template <> vpRGBa value<vpRGBa>(unsigned int number, unsigned int i, unsigned int j)
+{
+  return vpRGBa((unsigned char)((number * 13 + i + 2 * j) % 256), (unsigned char)(number % 256), 17, 255);
+}
+
+template <> uint16_t value<uint16_t>(unsigned int number, unsigned int i, unsigned int j)
+{
+  return (uint16_t)(number * 1000 + i * 7 + j);
+}
+
+template <> float value<float>(unsigned int number, unsigned int i, unsigned int j)
+{
+  return 0.5f * number + 0.001f * i - 0.01f * j;
+}
+
+bool equal(const vpRGBa &a, const vpRGBa &b) { return a.R == b.R && a.G == b.G && a.B == b.B && a.A == b.A; }
+template <class Type> bool equal(const Type &a, const Type &b) { return a == b; }
+
+template <class Type> void fill(vpImage<Type> &I, unsigned int number)
+{
+  for (unsigned int i = 0; i < I.getHeight(); i++)
+    for (unsigned int j = 0; j < I.getWidth(); j++)
+      I[i][j] = value<Type>(number, i, j);
+}
+
+template <class Type> bool check(const vpImage<Type> &I, unsigned int number, unsigned int height, unsigned int width)
+{
+  if (I.getHeight() != height || I.getWidth() != width)
+    return false;
+  for (unsigned int i = 0; i < height; i++)
+    for (unsigned int j = 0; j < width; j++)
+      if (!equal(I[i][j], value<Type>(number, i, j)))
+        return false;
+  return true;
+}
+
+// Frame n of the test logs, its type is n % 4 and its size depends on n
+unsigned int height(unsigned int n) { return 40 + 8 * n; }
+unsigned int width(unsigned int n) { return 30 + 5 * n; }
+
+void writeFrames(vpFrameLogWriter &writer, unsigned int first, unsigned int last)
+{
+  for (unsigned int n = first; n < last; n++) {
+    const double timestamp = 0.1 * n;
+    if (n % 4 == 0) {
+      vpImage<unsigned char> I(height(n), width(n));
+      fill(I, n);
+      writer.write(I, timestamp);
+    } else if (n % 4 == 1) {
+      vpImage<vpRGBa> I(height(n), width(n));
+      fill(I, n);
+      writer.write(I, timestamp);
+    } else if (n % 4 == 2) {
+      vpImage<uint16_t> I(height(n), width(n));
+      fill(I, n);
+      writer.write(I, timestamp);
+    } else {
+      vpImage<float> I(height(n), width(n));
+      fill(I, n);
+      writer.write(I, timestamp);
+    }
+  }
+}
+
+bool checkFrames(vpFrameLogReader &reader, unsigned int nbFrames, bool copyData)
+{
+  if (reader.getNbFrames() != nbFrames) {
+    std::cerr << "Wrong number of frames: " << reader.getNbFrames() << " instead of " << nbFrames << std::endl;
+    return false;
+  }
+  for (unsigned int n = 0; n < nbFrames; n++) {
+    bool ok = reader.getWidth(n) == width(n) && reader.getHeight(n) == height(n) &&
+              std::fabs(reader.getTimestamp(n) - 0.1 * n) < 1e-12;
+    if (n % 4 == 0) {
+      vpImage<unsigned char> I;
+      reader.getFrame(n, I, copyData);
+      ok = ok && reader.getFrameType(n) == vpFrameLogReader::FRAME_UCHAR && check(I, n, height(n), width(n));
+    } else if (n % 4 == 1) {
+      vpImage<vpRGBa> I;
+      reader.getFrame(n, I, copyData);
+      ok = ok && reader.getFrameType(n) == vpFrameLogReader::FRAME_RGBA && check(I, n, height(n), width(n));
+    } else if (n % 4 == 2) {
+      vpImage<uint16_t> I;
+      reader.getFrame(n, I, copyData);
+      ok = ok && reader.getFrameType(n) == vpFrameLogReader::FRAME_UINT16 && check(I, n, height(n), width(n));
+    } else {
+      vpImage<float> I;
+      reader.getFrame(n, I, copyData);
+      ok = ok && reader.getFrameType(n) == vpFrameLogReader::FRAME_FLOAT && check(I, n, height(n), width(n));
+    }
+    if (!ok) {
+      std::cerr << "Wrong frame " << n << (copyData ? " with" : " without") << " copy" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool testLog(const std::string &opath)
+{
+  const std::string filename = opath + "/frames.vplog";
+  {
+    vpFrameLogWriter writer(filename);
+    writeFrames(writer, 0, 6);
+  }
+
+  vpFrameLogReader reader(filename);
+  if (!checkFrames(reader, 6, true) || !checkFrames(reader, 6, false))
+    return false;
+
+  // A view on the log remains valid while an image is copied from it, and a
+  // resized view allocates its own memory
+  vpImage<unsigned char> I_view, I_copy;
+  reader.getFrame(0, I_view, false);
+  I_copy = I_view;
+  I_view.resize(10, 10);
+  I_view = 0;
+  if (!check(I_copy, 0, height(0), width(0)) || !checkFrames(reader, 6, false)) {
+    std::cerr << "The log was modified through a view" << std::endl;
+    return false;
+  }
+
+  // Color and grey level frames are converted when copied
+  vpImage<unsigned char> I_grey;
+  reader.getFrame(1, I_grey);
+  vpImage<vpRGBa> I_color;
+  reader.getFrame(0, I_color);
+  if (I_grey.getHeight() != height(1) || I_color.getWidth() != width(0) ||
+      I_color[3][5].R != value<unsigned char>(0, 3, 5)) {
+    std::cerr << "Wrong converted frames" << std::endl;
+    return false;
+  }
+
+  try {
+    vpImage<float> I_float;
+    reader.getFrame(2, I_float);
+    std::cerr << "No exception with a wrong pixel type" << std::endl;
+    return false;
+  } catch (const vpException &e) {
+    std::cout << "  Expected error: " << e.getStringMessage() << std::endl;
+  }
+  try {
+    reader.getFrame(0, I_color, false);
+    std::cerr << "No exception with a view of another pixel type" << std::endl;
+    return false;
+  } catch (const vpException &e) {
+    std::cout << "  Expected error: " << e.getStringMessage() << std::endl;
+  }
+  reader.close();
+
+  // Append frames to the log
+  {
+    vpFrameLogWriter writer(filename, true);
+    if (writer.getNbFrames() != 6) {
+      std::cerr << "Wrong number of frames before appending: " << writer.getNbFrames() << std::endl;
+      return false;
+    }
+    writeFrames(writer, 6, 9);
+  }
+  reader.open(filename);
+  if (!checkFrames(reader, 9, false))
+    return false;
+  reader.close();
+
+  // A log that was not closed misses its index: the complete frames are
+  // recovered by scanning the file
+  std::vector<char> buffer;
+  {
+    std::ifstream file(filename.c_str(), std::ifstream::binary);
+    file.seekg(0, std::ios::end);
+    buffer.resize((size_t)file.tellg());
+    file.seekg(0, std::ios::beg);
+    file.read(&buffer[0], (std::streamsize)buffer.size());
+  }
+  const std::string truncated = opath + "/truncated.vplog";
+  {
+    // Remove the trailer, the index and the end of the last frame
+    std::ofstream file(truncated.c_str(), std::ofstream::binary);
+    file.write(&buffer[0], (std::streamsize)(buffer.size() - 16 - (16 + 8 * 9) - height(8) * width(8) / 2));
+  }
+  reader.open(truncated);
+  if (!checkFrames(reader, 8, true))
+    return false;
+
+  return true;
+}
+
+bool testVideo(const std::string &opath)
+{
+  const std::string filename = opath + "/video.vplog";
+  const unsigned int nbFrames = 10;
+  vpImage<unsigned char> I(60, 80);
+  vpVideoWriter writer;
+  writer.setFileName(filename);
+  writer.open(I);
+  for (unsigned int n = 0; n < nbFrames; n++) {
+    fill(I, n);
+    writer.saveFrame(I);
+  }
+  writer.close();
+
+  vpVideoReader reader;
+  reader.setFileName(filename);
+  reader.open(I);
+  if (reader.getFirstFrameIndex() != 0 || reader.getLastFrameIndex() != (long)nbFrames - 1 ||
+      reader.getWidth() != 80 || reader.getHeight() != 60) {
+    std::cerr << "Wrong properties of the video" << std::endl;
+    return false;
+  }
+  for (unsigned int n = 0; !reader.end(); n++) {
+    reader.acquire(I);
+    if (n >= nbFrames || !check(I, n, 60, 80) || reader.getFrameIndex() != (long)n) {
+      std::cerr << "Wrong frame " << n << " of the video" << std::endl;
+      return false;
+    }
+  }
+
+  vpImage<vpRGBa> I_color;
+  reader.getFrame(I_color, 7);
+  if (I_color[2][3].R != value<unsigned char>(7, 2, 3)) {
+    std::cerr << "Wrong random access in the video" << std::endl;
+    return false;
+  }
+
+  reader.setFrameStep(3);
+  reader.open(I);
+  for (unsigned int n = 0; !reader.end(); n += 3) {
+    reader.acquire(I);
+    if (!check(I, n, 60, 80)) {
+      std::cerr << "Wrong frame " << n << " of the video with a step of 3" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int main()
+{
+  try {
+    std::string username;
+    vpIoTools::getUserName(username);
+#if defined(_WIN32)
+    std::string opath = "C:/temp/" + username;
+#else
+    std::string opath = "/tmp/" + username;
+#endif
+    opath = vpIoTools::createFilePath(opath, "testFrameLog");
+    if (!vpIoTools::checkDirectory(opath))
+      vpIoTools::makeDirectory(opath);
+
+    std::cout << "** Test the frame log" << std::endl;
+    if (!testLog(opath))
+      return EXIT_FAILURE;
+
+    std::cout << "** Test a video in a frame log" << std::endl;
+    if (!testVideo(opath))
+      return EXIT_FAILURE;
+
+    std::cout << "Test succeed" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const vpException &e) {
+    std::cout << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+}
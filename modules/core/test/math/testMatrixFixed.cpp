@@ -0,0 +1,168 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test vpMatrixFixed and the transformations that use it.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testMatrixFixed.cpp
+
+  Test vpMatrixFixed against vpMatrix, and the rigid transformations that
+  use fixed size temporaries against their definition.
+*/
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+#include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpMatrixFixed.h>
+#include <visp3/core/vpPoint.h>
+#include <visp3/core/vpVelocityTwistMatrix.h>
+
+namespace
+{
+bool equal(const vpArray2D<double> &A, const vpArray2D<double> &B, double eps = 1e-12)
+{
+  if (A.getRows() != B.getRows() || A.getCols() != B.getCols())
+    return false;
+  for (unsigned int i = 0; i < A.size(); i++)
+    if (std::fabs(A.data[i] - B.data[i]) > eps)
+      return false;
+  return true;
+}
+}
+
+int main()
+{
+  try {
+    // arithmetic against vpMatrix
+    vpMatrix A(3, 4), B(4, 2);
+    for (unsigned int i = 0; i < A.size(); i++)
+      A.data[i] = std::sin(1. + i);
+    for (unsigned int i = 0; i < B.size(); i++)
+      B.data[i] = std::cos(2. * i);
+
+    const vpMatrixFixed<3, 4> Af(A);
+    const vpMatrixFixed<4, 2> Bf(B);
+    if (!equal(Af * Bf, A * B) || !equal(Af.t(), A.t()) || !equal(Af + Af * 2., A * 3.) || !equal(-Af, A * -1.) ||
+        !equal(Af - Af, vpMatrix(3, 4))) {
+      std::cerr << "Fixed size arithmetic differs from vpMatrix" << std::endl;
+      return EXIT_FAILURE;
+    }
+    vpMatrix M(5, 5);
+    Af.copyTo(M, 1, 1);
+    if (!equal(vpMatrixFixed<3, 4>(M, 1, 1), A)) {
+      std::cerr << "Block copy failed" << std::endl;
+      return EXIT_FAILURE;
+    }
+    bool thrown = false;
+    try {
+      vpMatrixFixed<3, 3> F(A);
+    } catch (const vpException &) {
+      thrown = true;
+    }
+    if (!thrown) {
+      std::cerr << "Dimension error not detected" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // rigid transformations
+    vpHomogeneousMatrix aMb(0.1, -0.2, 0.5, vpMath::rad(10), vpMath::rad(-20), vpMath::rad(30));
+    vpHomogeneousMatrix bMc(-0.3, 0.1, 0.2, vpMath::rad(-5), vpMath::rad(40), vpMath::rad(15));
+    vpHomogeneousMatrix aMc = aMb * bMc;
+    if (!equal(aMc, (vpMatrix)aMb * (vpMatrix)bMc)) {
+      std::cerr << "Bad homogeneous matrix product" << std::endl;
+      return EXIT_FAILURE;
+    }
+    vpHomogeneousMatrix M1 = aMb;
+    M1 *= bMc;
+    if (!equal(M1, aMc)) {
+      std::cerr << "Bad homogeneous matrix in place product" << std::endl;
+      return EXIT_FAILURE;
+    }
+    vpHomogeneousMatrix I;
+    if (!equal(aMb * aMb.inverse(), I) || !equal(aMb.inverse(), ((vpMatrix)aMb).inverseByLU())) {
+      std::cerr << "Bad homogeneous matrix inverse" << std::endl;
+      return EXIT_FAILURE;
+    }
+    M1 = aMb;
+    M1.inverse(M1);
+    if (!equal(M1, aMb.inverse())) {
+      std::cerr << "Bad in place homogeneous matrix inverse" << std::endl;
+      return EXIT_FAILURE;
+    }
+    vpPoint bP(0.1, 0.2, 0.3);
+    bP.changeFrame(vpHomogeneousMatrix());
+    vpPoint aP = aMb * bP;
+    vpColVector bX(4, 1.);
+    bX[0] = 0.1;
+    bX[1] = 0.2;
+    bX[2] = 0.3;
+    vpColVector aX = aMb * bX;
+    if (std::fabs(aP.get_X() - aX[0]) > 1e-12 || std::fabs(aP.get_Y() - aX[1]) > 1e-12 ||
+        std::fabs(aP.get_Z() - aX[2]) > 1e-12) {
+      std::cerr << "Bad point transformation" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // velocity twist
+    vpVelocityTwistMatrix aVb(aMb);
+    vpMatrix V(6, 6);
+    vpRotationMatrix R = aMb.getRotationMatrix();
+    vpMatrix skewR = vpTranslationVector::skew(aMb.getTranslationVector()) * (vpMatrix)R;
+    for (unsigned int i = 0; i < 3; i++) {
+      for (unsigned int j = 0; j < 3; j++) {
+        V[i][j] = V[i + 3][j + 3] = R[i][j];
+        V[i][j + 3] = skewR[i][j];
+      }
+    }
+    if (!equal(aVb, V) || !equal(aVb.inverse(), vpVelocityTwistMatrix(aMb.inverse())) ||
+        !equal(vpVelocityTwistMatrix(aMb, false), vpVelocityTwistMatrix(R))) {
+      std::cerr << "Bad velocity twist matrix" << std::endl;
+      return EXIT_FAILURE;
+    }
+    vpTranslationVector t;
+    aVb.extract(t);
+    if (!equal(t, aMb.getTranslationVector())) {
+      std::cerr << "Bad translation extracted from a velocity twist matrix" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::cout << "Test succeed" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const vpException &e) {
+    std::cout << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+}
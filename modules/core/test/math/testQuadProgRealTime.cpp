@@ -0,0 +1,181 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the real-time QP solver on degenerate constraint sets.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testQuadProgRealTime.cpp
+
+  Test vpQuadProg::solveQPiRealTime() on degenerate problems: a blocking
+  constraint that is linearly dependent on the working set, several
+  constraints active at the same vertex, and random problems with redundant
+  constraints compared to vpQuadProg::solveQPi().
+*/
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+#include <visp3/core/vpConfig.h>
+
+#ifdef VISP_HAVE_CPP11_COMPATIBILITY
+
+#include <visp3/core/vpQuadProg.h>
+#include <visp3/core/vpUniRand.h>
+
+namespace
+{
+double cost(const vpMatrix &Q, const vpColVector &r, const vpColVector &x) { return (Q * x - r).sumSquare(); }
+
+bool isFeasible(const vpMatrix &C, const vpColVector &d, const vpColVector &x, double tol)
+{
+  const vpColVector Cx = C * x;
+  for (unsigned int i = 0; i < d.getRows(); i++) {
+    if (Cx[i] > d[i] + tol)
+      return false;
+  }
+  return true;
+}
+
+bool checkSolution(const std::string &name, const vpColVector &x, const vpColVector &x_ref, double tol)
+{
+  if ((x - x_ref).euclideanNorm() > tol) {
+    std::cerr << name << ": solution " << x.t() << " instead of " << x_ref.t() << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int main()
+{
+  const double tol = 1e-6;
+
+  // The second constraint is linearly dependent on the first one up to the
+  // tolerance, but blocks the step once the first one is in the working set
+  {
+    vpMatrix Q(2, 2), C(2, 2);
+    Q.eye();
+    vpColVector r(2), d(2, 0), x, x_ref(2);
+    r[0] = 100;
+    r[1] = 50;
+    C[0][1] = 1;
+    C[1][0] = 1e-7;
+    C[1][1] = 1;
+    x_ref[0] = 100;
+    x_ref[1] = -1e-5;
+
+    vpQuadProg qp;
+    qp.initRealTime(2, 2);
+    if (!qp.solveQPiRealTime(Q, r, C, d, x) || !isFeasible(C, d, x, tol) ||
+        !checkSolution("Dependent constraint", x, x_ref, 1e-4))
+      return EXIT_FAILURE;
+  }
+
+  // Constraints active at the same vertex, some of them redundant
+  {
+    vpMatrix Q(3, 3), C(6, 3);
+    Q.eye();
+    vpColVector r(3), d(6, 0), x, x_ref(3, 0);
+    for (unsigned int i = 0; i < 3; i++) {
+      r[i] = i + 1.;
+      C[i][i] = 1;
+    }
+    C[3][0] = C[3][1] = 1;
+    C[4][0] = C[4][1] = C[4][2] = 1;
+    C[5][2] = 1;
+
+    vpQuadProg qp;
+    qp.initRealTime(3, 6);
+    if (!qp.solveQPiRealTime(Q, r, C, d, x) || !checkSolution("Degenerate vertex", x, x_ref, tol))
+      return EXIT_FAILURE;
+
+    // Warm start from this vertex
+    r[1] = -2;
+    x_ref[1] = -2;
+    if (!qp.solveQPiRealTime(Q, r, C, d, x) || !checkSolution("Warm start from a degenerate vertex", x, x_ref, tol))
+      return EXIT_FAILURE;
+  }
+
+  // Random problems where more constraints than variables are active at the
+  // origin, with sums of constraints and duplicates
+  {
+    const unsigned int n = 6, nbRows = 8, p = 3 * nbRows;
+    vpUniRand rand(42);
+    vpMatrix Q(n, n), C(p, n);
+    vpColVector r(n), d(p, 0);
+    vpQuadProg qp;
+    qp.initRealTime(n, p);
+    for (unsigned int iter = 0; iter < 50; iter++) {
+      for (unsigned int i = 0; i < n; i++) {
+        r[i] = (2 * rand() - 1);
+        for (unsigned int j = 0; j < n; j++)
+          Q[i][j] = (2 * rand() - 1);
+      }
+      for (unsigned int k = 0; k < nbRows; k++) {
+        for (unsigned int j = 0; j < n; j++)
+          C[k][j] = (2 * rand() - 1);
+      }
+      for (unsigned int k = 0; k < nbRows; k++) {
+        for (unsigned int j = 0; j < n; j++) {
+          C[nbRows + k][j] = C[k][j] + C[(k + 1) % nbRows][j];
+          C[2 * nbRows + k][j] = C[k][j];
+        }
+      }
+
+      vpColVector x, x_ref;
+      vpQuadProg qp_ref;
+      if (!qp_ref.solveQPi(Q, r, C, d, x_ref)) {
+        std::cerr << "No reference solution for the problem " << iter << std::endl;
+        return EXIT_FAILURE;
+      }
+      if (!qp.solveQPiRealTime(Q, r, C, d, x) || !isFeasible(C, d, x, tol) ||
+          cost(Q, r, x) > cost(Q, r, x_ref) + 1e-6 * (1 + cost(Q, r, x_ref))) {
+        std::cerr << "Problem " << iter << ": cost " << cost(Q, r, x) << " instead of " << cost(Q, r, x_ref)
+                  << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  std::cout << "Test succeed" << std::endl;
+  return EXIT_SUCCESS;
+}
+
+#else
+int main()
+{
+  std::cout << "This test needs C++11 (USE_CPP11)" << std::endl;
+  return EXIT_SUCCESS;
+}
+#endif
@@ -202,6 +202,51 @@ int main(int argc, const char **argv)
     std::cout << " area : " << p3.getArea() << std::endl;
     std::cout << " center : " << p3.getCenter() << std::endl;
 
+    // Check that the scanline rasterization and the batch test are
+    // consistent with the point in polygon test
+    std::vector<vpPolygon> polygons;
+    polygons.push_back(p1);
+    polygons.push_back(p2);
+    polygons.push_back(p3);
+    vpImage<unsigned char> mask(I.getHeight(), I.getWidth(), 0);
+    vpPolygon::fillMask(polygons, mask);
+    for (size_t k = 0; k < polygons.size(); k++) {
+      std::vector<vpImagePoint> ips;
+      for (unsigned int i = 0; i < I.getHeight(); i++) {
+        for (unsigned int j = 0; j < I.getWidth(); j++) {
+          ips.push_back(vpImagePoint(i, j));
+        }
+      }
+      std::vector<bool> inside;
+      polygons[k].isInside(ips, inside);
+
+      std::vector<std::pair<unsigned int, unsigned int> > spans;
+      for (unsigned int i = 0; i < I.getHeight(); i++) {
+        polygons[k].getRowSpans(i, 0, I.getWidth(), spans);
+        size_t span_index = 0;
+        for (unsigned int j = 0; j < I.getWidth(); j++) {
+          bool isInside = polygons[k].isInside(vpImagePoint(i, j), vpPolygon::PnPolyRayCasting);
+          if (span_index < spans.size() && spans[span_index].second <= j) {
+            span_index++;
+          }
+          bool inSpan = span_index < spans.size() && spans[span_index].first <= j;
+          if (inSpan != isInside || inside[i * I.getWidth() + j] != isInside || (isInside && mask[i][j] != 255)) {
+            std::cerr << "Polygon " << k + 1 << ": inconsistent point in polygon test for (" << i << ", " << j << ")"
+                      << std::endl;
+            return 1;
+          }
+        }
+      }
+    }
+    for (unsigned int i = 0; i < I.getHeight(); i++) {
+      for (unsigned int j = 0; j < I.getWidth(); j++) {
+        if (mask[i][j] == 255 && !p1.isInside(vpImagePoint(i, j)) && !p2.isInside(vpImagePoint(i, j))) {
+          std::cerr << "Mask set outside of the polygons for (" << i << ", " << j << ")" << std::endl;
+          return 1;
+        }
+      }
+    }
+
     if (opt_display) {
 #if (defined VISP_HAVE_X11) || (defined VISP_HAVE_GTK) || (defined VISP_HAVE_GDI)
       display.init(I, 10, 10, "Test vpPolygon");
@@ -0,0 +1,113 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test vpMappedFile.
+ *
+ *****************************************************************************/
+/*!
+  \example testMappedFile.cpp
+
+  \brief Test the mapping of a file in memory with vpMappedFile.
+*/
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpMappedFile.h>
+
+int main()
+{
+  try {
+#if defined(_WIN32)
+    std::string opath = "C:/temp";
+#else
+    std::string opath = "/tmp";
+#endif
+    if (!vpIoTools::checkDirectory(opath))
+      vpIoTools::makeDirectory(opath);
+    std::string filename = vpIoTools::createFilePath(opath, "testMappedFile.bin");
+
+    std::vector<char> content(100000);
+    for (size_t i = 0; i < content.size(); i++)
+      content[i] = (char)(i * 7 + i / 256);
+    {
+      std::ofstream file(filename.c_str(), std::ofstream::binary);
+      file.write(&content[0], (std::streamsize)content.size());
+    }
+
+    vpMappedFile mappedFile;
+    if (mappedFile.isOpen() || mappedFile.data() != NULL || mappedFile.size() != 0) {
+      std::cerr << "A default vpMappedFile should not be open" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    mappedFile.open(filename);
+    std::cout << "File mapped in memory: " << (mappedFile.isMapped() ? "yes" : "no") << std::endl;
+    if (!mappedFile.isOpen() || mappedFile.size() != content.size() ||
+        memcmp(mappedFile.data(), &content[0], content.size()) != 0) {
+      std::cerr << "The mapped file differs from the file content" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // The mapping is private, the file is not modified
+    mappedFile.data()[0] = (unsigned char)(content[0] + 1);
+    mappedFile.close();
+    if (mappedFile.isOpen()) {
+      std::cerr << "The file is still open after close()" << std::endl;
+      return EXIT_FAILURE;
+    }
+    vpMappedFile mappedFile2(filename);
+    if (mappedFile2.size() != content.size() || memcmp(mappedFile2.data(), &content[0], content.size()) != 0) {
+      std::cerr << "The file was modified through a private mapping" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    try {
+      vpMappedFile missingFile(vpIoTools::createFilePath(opath, "testMappedFile_missing.bin"));
+      std::cerr << "No exception when mapping a missing file" << std::endl;
+      return EXIT_FAILURE;
+    } catch (vpException &e) {
+      if (e.getCode() != vpException::ioError) {
+        std::cerr << "Unexpected exception when mapping a missing file: " << e << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    std::cout << "Test succeed" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const vpException &e) {
+    std::cout << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+}
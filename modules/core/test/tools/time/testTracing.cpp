@@ -0,0 +1,200 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the record of tracing spans.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testTracing.cpp
+
+  \brief Test the record of tracing spans by several threads and their
+  export in the Chrome trace event format.
+*/
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpThread.h>
+#include <visp3/core/vpTracing.h>
+
+namespace
+{
+const unsigned int nbThreadSpans = 50;
+
+unsigned int countOccurrences(const std::string &str, const std::string &pattern)
+{
+  unsigned int nb = 0;
+  for (size_t pos = str.find(pattern); pos != std::string::npos; pos = str.find(pattern, pos + 1))
+    nb++;
+  return nb;
+}
+
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+vpThread::Return recordSpans(vpThread::Args args)
+{
+  std::ostringstream name;
+  name << "worker " << *((unsigned int *)args);
+  vpTracing::setThreadName(name.str());
+
+  for (unsigned int i = 0; i < nbThreadSpans; i++) {
+    vpTracing::vpScope scope("worker span");
+  }
+  return 0;
+}
+#endif
+}
+
+int main()
+{
+  try {
+    // Nothing is recorded before start()
+    {
+      vpTracing::vpScope scope("ignored");
+      vpTracing::begin("ignored");
+      vpTracing::end();
+    }
+    if (vpTracing::isStarted() || vpTracing::getNbEvents() != 0) {
+      std::cerr << "Spans recorded while the tracing is not started" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    vpTracing::setThreadName("main \"thread\"");
+    vpTracing::start();
+    {
+      vpTracing::vpScope outer("outer");
+      vpTracing::begin("inner");
+      vpTracing::vpScope last("last");
+      vpTracing::end();
+    }
+    unsigned int nbEvents = 4;
+
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+    const unsigned int nbThreads = 4;
+    {
+      std::vector<unsigned int> ids(nbThreads);
+      std::vector<vpThread *> threads(nbThreads);
+      for (unsigned int i = 0; i < nbThreads; i++) {
+        ids[i] = i;
+        threads[i] = new vpThread((vpThread::Fn)recordSpans, (vpThread::Args)&ids[i]);
+      }
+      for (unsigned int i = 0; i < nbThreads; i++) {
+        delete threads[i]; // join the thread
+      }
+    }
+    nbEvents += nbThreads * nbThreadSpans;
+#else
+    const unsigned int nbThreads = 0;
+#endif
+    vpTracing::stop();
+
+    if (vpTracing::getNbEvents() != nbEvents || vpTracing::getNbDroppedEvents() != 0) {
+      std::cerr << "Bad number of events: " << vpTracing::getNbEvents() << " instead of " << nbEvents << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::ostringstream oss;
+    vpTracing::writeChromeTrace(oss);
+    const std::string trace = oss.str();
+    if (countOccurrences(trace, "\"ph\": \"X\"") != nbEvents - 2 || countOccurrences(trace, "\"ph\": \"B\"") != 1 ||
+        countOccurrences(trace, "\"ph\": \"E\"") != 1 ||
+        countOccurrences(trace, "\"name\": \"thread_name\"") != nbThreads + 1 ||
+        countOccurrences(trace, "\"name\": \"worker span\"") != nbThreads * nbThreadSpans ||
+        countOccurrences(trace, "\"name\": \"main \\\"thread\\\"\"") != 1) {
+      std::cerr << "Bad trace:\n" << trace << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (countOccurrences(trace, "{") != countOccurrences(trace, "}") ||
+        countOccurrences(trace, "[") != countOccurrences(trace, "]")) {
+      std::cerr << "Unbalanced JSON trace" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // The events that do not fit in the buffer are dropped
+    vpTracing::setBufferSize(10);
+    vpTracing::clear();
+    vpTracing::start();
+    for (unsigned int i = 0; i < 25; i++) {
+      vpTracing::vpScope scope("span");
+    }
+    vpTracing::stop();
+    if (vpTracing::getNbEvents() != 10 || vpTracing::getNbDroppedEvents() != 15) {
+      std::cerr << "Bad number of dropped events: " << vpTracing::getNbDroppedEvents() << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // Same with events stored in several chunks, the last one being cut by
+    // the buffer size
+    vpTracing::setBufferSize(100);
+    vpTracing::clear();
+    vpTracing::start();
+    for (unsigned int i = 0; i < 150; i++) {
+      vpTracing::vpScope scope("span");
+    }
+    vpTracing::stop();
+    oss.str("");
+    vpTracing::writeChromeTrace(oss);
+    if (vpTracing::getNbEvents() != 100 || vpTracing::getNbDroppedEvents() != 50 ||
+        countOccurrences(oss.str(), "\"name\": \"span\"") != 100) {
+      std::cerr << "Bad number of events in chunks: " << vpTracing::getNbEvents() << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // A span begun before stop() is recorded when it ends
+    vpTracing::clear();
+    vpTracing::start();
+    {
+      vpTracing::vpScope scope("stopped");
+      vpTracing::stop();
+    }
+    if (vpTracing::getNbEvents() != 1) {
+      std::cerr << "The span running at stop() is not recorded" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    try {
+      vpTracing::saveChromeTrace("/visp/this/directory/does/not/exist/trace.json");
+      std::cerr << "No exception when the trace cannot be saved" << std::endl;
+      return EXIT_FAILURE;
+    } catch (const vpException &e) {
+      std::cout << "Expected exception: " << e.getMessage() << std::endl;
+    }
+
+    std::cout << "Test succeed" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const vpException &e) {
+    std::cout << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+}
@@ -38,6 +38,8 @@
 #include <visp3/core/vpConfig.h>
 
 #ifdef VISP_HAVE_APRILTAG
+#include <map>
+
 #include <visp3/core/vpCameraParameters.h>
 #include <visp3/core/vpHomogeneousMatrix.h>
 #include <visp3/core/vpImage.h>
@@ -157,6 +159,16 @@ Tag number 1:
   Tag Id: 1
 \endcode
 
+  With many tags in the image, the PLANAR_SQUARE pose estimation method is
+  much faster than the others. When the tags belong to a rigid set, like a
+  calibration board, setAprilTagLayout() allows to estimate the pose of the
+  whole set from all its tags.
+
+  When the tags are small with respect to the image, for example with a high
+  resolution camera, setAprilTagTracking() allows to search the tags only
+  around their location in the previous frame. The whole image is scanned
+  periodically to detect the new tags, or when a tag is lost.
+
   Other examples are also provided in tutorial-apriltag-detector.cpp and
   tutorial-apriltag-detector-live.cpp
 */
@@ -192,9 +204,13 @@ public:
                                 initialized by the Dementhon approach */
     LAGRANGE_VIRTUAL_VS,     /*!< Non linear virtual visual servoing approach
                                 initialized by the Lagrange approach */
-    BEST_RESIDUAL_VIRTUAL_VS /*!< Non linear virtual visual servoing approach
+    BEST_RESIDUAL_VIRTUAL_VS, /*!< Non linear virtual visual servoing approach
                                 initialized by the approach that gives the
                                 lowest residual */
+    PLANAR_SQUARE             /*!< Analytic pose of the square tag, as in
+                                 IPPE (\cite Collins14), refined by a few
+                                 Gauss-Newton iterations. The fastest method,
+                                 the tags are processed in parallel */
   };
 
   vpDetectorAprilTag(const vpAprilTagFamily &tagFamily = TAG_36h11,
@@ -210,6 +226,11 @@ public:
   */
   inline vpPoseEstimationMethod getPoseEstimationMethod() const { return m_poseEstimationMethod; }
 
+  bool getLayoutPose(vpHomogeneousMatrix &cMo) const;
+
+  bool isFullScan() const;
+
+  void setAprilTagLayout(const std::map<int, vpHomogeneousMatrix> &layout);
   void setAprilTagNbThreads(const int nThreads);
   void setAprilTagPoseEstimationMethod(const vpPoseEstimationMethod &poseEstimationMethod);
   void setAprilTagQuadDecimate(const float quadDecimate);
@@ -217,6 +238,8 @@ public:
   void setAprilTagRefineDecode(const bool refineDecode);
   void setAprilTagRefineEdges(const bool refineEdges);
   void setAprilTagRefinePose(const bool refinePose);
+  void setAprilTagTracking(const bool tracking, const unsigned int fullScanPeriod = 10,
+                           const double roiMargin = 0.5);
 
   /*! Allow to enable the display of overlay tag information in the windows
    * (vpDisplay) associated to the input image. */
@@ -266,6 +289,10 @@ inline std::ostream &operator<<(std::ostream &os, const vpDetectorAprilTag::vpPo
     os << "BEST_RESIDUAL_VIRTUAL_VS";
     break;
 
+  case vpDetectorAprilTag::PLANAR_SQUARE:
+    os << "PLANAR_SQUARE";
+    break;
+
   default:
       os << "ERROR_UNKNOWN_POSE_METHOD!";
     break;
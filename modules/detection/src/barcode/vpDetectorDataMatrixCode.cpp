@@ -39,6 +39,7 @@
 #include <assert.h>
 
 #include <visp3/core/vpConfig.h>
+#include <visp3/core/vpTracing.h>
 
 #ifdef VISP_HAVE_DMTX
 
@@ -59,6 +60,7 @@ vpDetectorDataMatrixCode::vpDetectorDataMatrixCode() {}
  */
 bool vpDetectorDataMatrixCode::detect(const vpImage<unsigned char> &I)
 {
+  VP_TRACING_SCOPE("vpDetectorDataMatrixCode::detect");
   bool detected = false;
   m_message.clear();
   m_polygon.clear();
@@ -37,6 +37,7 @@
  *****************************************************************************/
 
 #include <visp3/core/vpConfig.h>
+#include <visp3/core/vpTracing.h>
 
 #ifdef VISP_HAVE_ZBAR
 
@@ -59,6 +60,7 @@ vpDetectorQRCode::vpDetectorQRCode() : m_scanner()
  */
 bool vpDetectorQRCode::detect(const vpImage<unsigned char> &I)
 {
+  VP_TRACING_SCOPE("vpDetectorQRCode::detect");
   bool detected = false;
   m_message.clear();
   m_polygon.clear();
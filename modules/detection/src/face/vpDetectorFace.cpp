@@ -42,6 +42,7 @@
 #include <algorithm>
 
 #include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpTracing.h>
 #include <visp3/detection/vpDetectorFace.h>
 
 bool vpSortLargestFace(cv::Rect rect1, cv::Rect rect2) { return (rect1.area() > rect2.area()); }
@@ -102,6 +103,7 @@ bool vpDetectorFace::detect(const vpImage<unsigned char> &I)
  */
 bool vpDetectorFace::detect(const cv::Mat &frame_gray)
 {
+  VP_TRACING_SCOPE("vpDetectorFace::detect");
   bool detected = false;
   m_message.clear();
   m_polygon.clear();
@@ -35,6 +35,10 @@
 #include <visp3/core/vpConfig.h>
 
 #ifdef VISP_HAVE_APRILTAG
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
 #include <map>
 
 #include <apriltag.h>
@@ -49,16 +53,298 @@
 #include <visp3/core/vpDisplay.h>
 #include <visp3/core/vpPixelMeterConversion.h>
 #include <visp3/core/vpPoint.h>
+#include <visp3/core/vpTracing.h>
 #include <visp3/detection/vpDetectorAprilTag.h>
 #include <visp3/vision/vpPose.h>
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Rigid transformation in fixed size arrays, so that the poses of the tags
+// are estimated in parallel without any allocation
+struct vpRigidPose {
+  double R[3][3];
+  double t[3];
+};
+
+vpHomogeneousMatrix toHomogeneousMatrix(const vpRigidPose &pose)
+{
+  vpHomogeneousMatrix M;
+  for (unsigned int i = 0; i < 3; i++) {
+    for (unsigned int j = 0; j < 3; j++)
+      M[i][j] = pose.R[i][j];
+    M[i][3] = pose.t[i];
+  }
+  return M;
+}
+
+vpRigidPose toRigidPose(const vpHomogeneousMatrix &M)
+{
+  vpRigidPose pose;
+  for (unsigned int i = 0; i < 3; i++) {
+    for (unsigned int j = 0; j < 3; j++)
+      pose.R[i][j] = M[i][j];
+    pose.t[i] = M[i][3];
+  }
+  return pose;
+}
+
+// Solve A x = b with a Gaussian elimination with partial pivoting, A is n x n
+// stored by rows and is modified
+bool solveLinear(double *A, double *b, unsigned int n, double *x)
+{
+  for (unsigned int k = 0; k < n; k++) {
+    unsigned int pivot = k;
+    for (unsigned int i = k + 1; i < n; i++)
+      if (std::fabs(A[i * n + k]) > std::fabs(A[pivot * n + k]))
+        pivot = i;
+    if (std::fabs(A[pivot * n + k]) < std::numeric_limits<double>::epsilon())
+      return false;
+    if (pivot != k) {
+      for (unsigned int j = 0; j < n; j++)
+        std::swap(A[k * n + j], A[pivot * n + j]);
+      std::swap(b[k], b[pivot]);
+    }
+    for (unsigned int i = k + 1; i < n; i++) {
+      const double f = A[i * n + k] / A[k * n + k];
+      for (unsigned int j = k; j < n; j++)
+        A[i * n + j] -= f * A[k * n + j];
+      b[i] -= f * b[k];
+    }
+  }
+  for (unsigned int k = n; k-- > 0;) {
+    double s = b[k];
+    for (unsigned int j = k + 1; j < n; j++)
+      s -= A[k * n + j] * x[j];
+    x[k] = s / A[k * n + k];
+  }
+  return true;
+}
+
+// Least squares translation of the pose given its rotation, from the n
+// points X (3 coordinates each) and their normalized coordinates x
+bool computeTranslation(vpRigidPose &pose, const double *X, const double *x, unsigned int n)
+{
+  double A[9] = {0, 0, 0, 0, 0, 0, 0, 0, 0}, b[3] = {0, 0, 0};
+  for (unsigned int i = 0; i < n; i++) {
+    const double *Xi = X + 3 * i;
+    const double u = x[2 * i], v = x[2 * i + 1];
+    double P[3];
+    for (unsigned int r = 0; r < 3; r++)
+      P[r] = pose.R[r][0] * Xi[0] + pose.R[r][1] * Xi[1] + pose.R[r][2] * Xi[2];
+    // Rows [1 0 -u] t = u Pz - Px and [0 1 -v] t = v Pz - Py
+    const double bu = u * P[2] - P[0], bv = v * P[2] - P[1];
+    A[0] += 1;
+    A[2] -= u;
+    A[4] += 1;
+    A[5] -= v;
+    A[8] += u * u + v * v;
+    b[0] += bu;
+    b[1] += bv;
+    b[2] -= u * bu + v * bv;
+  }
+  A[6] = A[2];
+  A[7] = A[5];
+  return solveLinear(A, b, 3, pose.t);
+}
+
+// Sum of the squared reprojection errors
+double computeResidual(const vpRigidPose &pose, const double *X, const double *x, unsigned int n)
+{
+  double residual = 0;
+  for (unsigned int i = 0; i < n; i++) {
+    const double *Xi = X + 3 * i;
+    double P[3];
+    for (unsigned int r = 0; r < 3; r++)
+      P[r] = pose.R[r][0] * Xi[0] + pose.R[r][1] * Xi[1] + pose.R[r][2] * Xi[2] + pose.t[r];
+    if (P[2] <= 0)
+      return std::numeric_limits<double>::max();
+    const double du = P[0] / P[2] - x[2 * i], dv = P[1] / P[2] - x[2 * i + 1];
+    residual += du * du + dv * dv;
+  }
+  return residual;
+}
+
+// Rotation of angle |w| around w, with the Rodrigues formula
+void rotation(const double w[3], double R[3][3])
+{
+  const double theta = std::sqrt(w[0] * w[0] + w[1] * w[1] + w[2] * w[2]);
+  const double a = theta < 1e-8 ? 1 : std::sin(theta) / theta;
+  const double b = theta < 1e-8 ? 0.5 : (1 - std::cos(theta)) / (theta * theta);
+  const double K[3][3] = {{0, -w[2], w[1]}, {w[2], 0, -w[0]}, {-w[1], w[0], 0}};
+  for (unsigned int i = 0; i < 3; i++) {
+    for (unsigned int j = 0; j < 3; j++) {
+      const double K2 = K[i][0] * K[0][j] + K[i][1] * K[1][j] + K[i][2] * K[2][j];
+      R[i][j] = (i == j ? 1 : 0) + a * K[i][j] + b * K2;
+    }
+  }
+}
+
+/*
+  Analytic pose of a planar square from the normalized coordinates x of its
+  corners (-h, -h), (h, -h), (h, h), (-h, h), as in IPPE (Collins and
+  Bartoli, Infinitesimal Plane-based Pose Estimation, IJCV 2014): the
+  rotation is recovered from the Jacobian of the homography at the center of
+  the square, up to a reflection ambiguity that is solved with the
+  reprojection error.
+*/
+bool computeSquarePose(const double x[8], double h, vpRigidPose &pose)
+{
+  const double X[12] = {-h, -h, 0, h, -h, 0, h, h, 0, -h, h, 0};
+
+  // Homography from the plane of the square to the normalized coordinates
+  double A[64], b[8], H[8];
+  for (unsigned int i = 0; i < 4; i++) {
+    const double Xi = X[3 * i], Yi = X[3 * i + 1], u = x[2 * i], v = x[2 * i + 1];
+    const double row_u[8] = {Xi, Yi, 1, 0, 0, 0, -u * Xi, -u * Yi};
+    const double row_v[8] = {0, 0, 0, Xi, Yi, 1, -v * Xi, -v * Yi};
+    for (unsigned int j = 0; j < 8; j++) {
+      A[(2 * i) * 8 + j] = row_u[j];
+      A[(2 * i + 1) * 8 + j] = row_v[j];
+    }
+    b[2 * i] = u;
+    b[2 * i + 1] = v;
+  }
+  if (!solveLinear(A, b, 8, H))
+    return false;
+
+  // Image of the center and Jacobian of the homography at the center
+  const double v0 = H[2], v1 = H[5];
+  const double J[2][2] = {{H[0] - H[6] * v0, H[1] - H[7] * v0}, {H[3] - H[6] * v1, H[4] - H[7] * v1}};
+
+  // Rotation Rv that brings the optical axis on the line of sight of the
+  // center
+  const double axis[3] = {-v1, v0, 0};
+  const double norm = std::sqrt(v0 * v0 + v1 * v1 + 1);
+  const double sin_theta = std::sqrt(v0 * v0 + v1 * v1) / norm;
+  double Rv[3][3];
+  if (sin_theta > std::numeric_limits<double>::epsilon()) {
+    const double theta = std::atan2(sin_theta, 1 / norm);
+    const double s = theta / (sin_theta * norm);
+    const double w[3] = {axis[0] * s, axis[1] * s, 0};
+    rotation(w, Rv);
+  } else {
+    const double w[3] = {0, 0, 0};
+    rotation(w, Rv);
+  }
+
+  // Upper left 2x2 block of the rotation in the frame of Rv, up to scale
+  const double B[2][2] = {{Rv[0][0] - Rv[2][0] * v0, Rv[0][1] - Rv[2][1] * v0},
+                          {Rv[1][0] - Rv[2][0] * v1, Rv[1][1] - Rv[2][1] * v1}};
+  const double det = B[0][0] * B[1][1] - B[0][1] * B[1][0];
+  if (std::fabs(det) < std::numeric_limits<double>::epsilon())
+    return false;
+  const double Binv[2][2] = {{B[1][1] / det, -B[0][1] / det}, {-B[1][0] / det, B[0][0] / det}};
+  double M[2][2];
+  for (unsigned int i = 0; i < 2; i++)
+    for (unsigned int j = 0; j < 2; j++)
+      M[i][j] = Binv[i][0] * J[0][j] + Binv[i][1] * J[1][j];
+
+  // The largest singular value of the block of a rotation is 1
+  const double mm00 = M[0][0] * M[0][0] + M[0][1] * M[0][1], mm11 = M[1][0] * M[1][0] + M[1][1] * M[1][1];
+  const double mm01 = M[0][0] * M[1][0] + M[0][1] * M[1][1];
+  const double gamma =
+      std::sqrt(0.5 * (mm00 + mm11 + std::sqrt((mm00 - mm11) * (mm00 - mm11) + 4 * mm01 * mm01)));
+  if (gamma < std::numeric_limits<double>::epsilon())
+    return false;
+  const double a00 = M[0][0] / gamma, a01 = M[0][1] / gamma, a10 = M[1][0] / gamma, a11 = M[1][1] / gamma;
+  const double b0 = std::sqrt((std::max)(0., 1 - a00 * a00 - a10 * a10));
+  double b1 = std::sqrt((std::max)(0., 1 - a01 * a01 - a11 * a11));
+  if (a00 * a01 + a10 * a11 > 0)
+    b1 = -b1;
+
+  // Two solutions, the rotated plane and its reflection
+  double best_residual = std::numeric_limits<double>::max();
+  for (int sign = 1; sign >= -1; sign -= 2) {
+    const double c1[3] = {a00, a10, sign * b0}, c2[3] = {a01, a11, sign * b1};
+    const double c3[3] = {c1[1] * c2[2] - c1[2] * c2[1], c1[2] * c2[0] - c1[0] * c2[2],
+                          c1[0] * c2[1] - c1[1] * c2[0]};
+    vpRigidPose candidate;
+    for (unsigned int i = 0; i < 3; i++) {
+      candidate.R[i][0] = Rv[i][0] * c1[0] + Rv[i][1] * c1[1] + Rv[i][2] * c1[2];
+      candidate.R[i][1] = Rv[i][0] * c2[0] + Rv[i][1] * c2[1] + Rv[i][2] * c2[2];
+      candidate.R[i][2] = Rv[i][0] * c3[0] + Rv[i][1] * c3[1] + Rv[i][2] * c3[2];
+    }
+    if (!computeTranslation(candidate, X, x, 4))
+      continue;
+    const double residual = computeResidual(candidate, X, x, 4);
+    if (residual < best_residual) {
+      best_residual = residual;
+      pose = candidate;
+    }
+  }
+
+  return best_residual < std::numeric_limits<double>::max();
+}
+
+/*
+  Minimize the reprojection error of the n points X with Gauss-Newton
+  iterations. The pose is updated with the exponential map of the camera
+  velocity, as in the virtual visual servoing of vpPose.
+*/
+void refinePose(vpRigidPose &pose, const double *X, const double *x, unsigned int n, unsigned int nbIterations)
+{
+  for (unsigned int iter = 0; iter < nbIterations; iter++) {
+    double LtL[36], Lte[6], v[6];
+    std::fill(LtL, LtL + 36, 0.);
+    std::fill(Lte, Lte + 6, 0.);
+    for (unsigned int i = 0; i < n; i++) {
+      const double *Xi = X + 3 * i;
+      double P[3];
+      for (unsigned int r = 0; r < 3; r++)
+        P[r] = pose.R[r][0] * Xi[0] + pose.R[r][1] * Xi[1] + pose.R[r][2] * Xi[2] + pose.t[r];
+      if (P[2] <= 0)
+        return;
+      const double iz = 1 / P[2], u = P[0] * iz, w = P[1] * iz;
+      const double e[2] = {u - x[2 * i], w - x[2 * i + 1]};
+      const double L[2][6] = {{-iz, 0, u * iz, u * w, -(1 + u * u), w}, {0, -iz, w * iz, 1 + w * w, -u * w, -u}};
+      for (unsigned int k = 0; k < 2; k++) {
+        for (unsigned int r = 0; r < 6; r++) {
+          for (unsigned int c = 0; c < 6; c++)
+            LtL[r * 6 + c] += L[k][r] * L[k][c];
+          Lte[r] += L[k][r] * e[k];
+        }
+      }
+    }
+    if (!solveLinear(LtL, Lte, 6, v))
+      return;
+
+    // The camera moves with the velocity -v: cMo = exp(-v)^-1 cMo
+    double Re[3][3], te[3];
+    const double w[3] = {-v[3], -v[4], -v[5]};
+    rotation(w, Re);
+    const double theta = std::sqrt(w[0] * w[0] + w[1] * w[1] + w[2] * w[2]);
+    const double b = theta < 1e-8 ? 0.5 : (1 - std::cos(theta)) / (theta * theta);
+    const double c = theta < 1e-8 ? 1. / 6. : (theta - std::sin(theta)) / (theta * theta * theta);
+    const double vt[3] = {-v[0], -v[1], -v[2]};
+    const double wxv[3] = {w[1] * vt[2] - w[2] * vt[1], w[2] * vt[0] - w[0] * vt[2], w[0] * vt[1] - w[1] * vt[0]};
+    const double wxwxv[3] = {w[1] * wxv[2] - w[2] * wxv[1], w[2] * wxv[0] - w[0] * wxv[2],
+                             w[0] * wxv[1] - w[1] * wxv[0]};
+    for (unsigned int r = 0; r < 3; r++)
+      te[r] = vt[r] + b * wxv[r] + c * wxwxv[r];
+
+    vpRigidPose updated;
+    for (unsigned int r = 0; r < 3; r++) {
+      for (unsigned int k = 0; k < 3; k++)
+        updated.R[r][k] = Re[0][r] * pose.R[0][k] + Re[1][r] * pose.R[1][k] + Re[2][r] * pose.R[2][k];
+      updated.t[r] = Re[0][r] * (pose.t[0] - te[0]) + Re[1][r] * (pose.t[1] - te[1]) + Re[2][r] * (pose.t[2] - te[2]);
+    }
+    pose = updated;
+
+    if (v[0] * v[0] + v[1] * v[1] + v[2] * v[2] + v[3] * v[3] + v[4] * v[4] + v[5] * v[5] < 1e-20)
+      return;
+  }
+}
+}
+
 class vpDetectorAprilTag::Impl
 {
 public:
   Impl(const vpAprilTagFamily &tagFamily, const vpPoseEstimationMethod &method)
     : m_cam(), m_poseEstimationMethod(method), m_tagFamily(tagFamily), m_tagPoses(), m_tagSize(1.0), m_td(NULL),
-      m_tf(NULL)
+      m_tf(NULL), m_tracking(false), m_fullScanPeriod(10), m_roiMargin(0.5), m_nbFramesSinceFullScan(0),
+      m_trackedTags(), m_trackedWidth(0), m_trackedHeight(0), m_fullScan(true), m_layout(),
+      m_layoutPose(), m_layoutPoseValid(false)
   {
     switch (m_tagFamily) {
     case TAG_36h11:
@@ -137,21 +423,73 @@ public:
   {
     m_tagPoses.clear();
 
-    image_u8_t im = {/*.width =*/(int32_t)I.getWidth(),
-                     /*.height =*/(int32_t)I.getHeight(),
-                     /*.stride =*/(int32_t)I.getWidth(),
-                     /*.buf =*/I.bitmap};
+    std::vector<zarray_t *> detections;
+    m_fullScan = !m_tracking || m_trackedTags.empty() || I.getWidth() != m_trackedWidth ||
+                 I.getHeight() != m_trackedHeight ||
+                 (m_fullScanPeriod > 0 && m_nbFramesSinceFullScan + 1 >= m_fullScanPeriod);
+    if (!m_fullScan && !detectInRois(I, detections)) {
+      // A tag was lost, it may have moved out of its region
+      for (size_t i = 0; i < detections.size(); i++)
+        apriltag_detections_destroy(detections[i]);
+      detections.clear();
+      m_fullScan = true;
+    }
+    if (m_fullScan) {
+      image_u8_t im = {/*.width =*/(int32_t)I.getWidth(),
+                       /*.height =*/(int32_t)I.getHeight(),
+                       /*.stride =*/(int32_t)I.getWidth(),
+                       /*.buf =*/I.bitmap};
+
+      detections.push_back(apriltag_detector_detect(m_td, &im));
+      m_nbFramesSinceFullScan = 0;
+    } else {
+      m_nbFramesSinceFullScan++;
+    }
 
-    zarray_t *detections = apriltag_detector_detect(m_td, &im);
-    int nb_detections = zarray_size(detections);
+    std::vector<apriltag_detection_t *> dets;
+    for (size_t k = 0; k < detections.size(); k++) {
+      for (int i = 0; i < zarray_size(detections[k]); i++) {
+        apriltag_detection_t *det;
+        zarray_get(detections[k], i, &det);
+        dets.push_back(det);
+      }
+    }
+    int nb_detections = (int)dets.size();
     bool detected = nb_detections > 0;
 
     polygons.resize((size_t)nb_detections);
     messages.resize((size_t)nb_detections);
 
-    for (int i = 0; i < zarray_size(detections); i++) {
-      apriltag_detection_t *det;
-      zarray_get(detections, i, &det);
+    std::vector<vpRigidPose> squarePoses;
+    std::vector<double> corners;
+    if (computePose && (m_poseEstimationMethod == PLANAR_SQUARE || !m_layout.empty())) {
+      // Normalized coordinates of the corners of all the tags
+      corners.resize(8 * dets.size());
+      for (size_t i = 0; i < dets.size(); i++)
+        for (unsigned int j = 0; j < 4; j++)
+          vpPixelMeterConversion::convertPoint(m_cam, dets[i]->p[j][0], dets[i]->p[j][1], corners[8 * i + 2 * j],
+                                               corners[8 * i + 2 * j + 1]);
+    }
+    if (computePose && m_poseEstimationMethod == PLANAR_SQUARE) {
+      // The poses of the tags are independent and solved in parallel
+      squarePoses.resize(dets.size());
+      const double h = m_tagSize / 2;
+      const double X[12] = {-h, -h, 0, h, -h, 0, h, h, 0, -h, h, 0};
+#if defined _OPENMP // only to disable warning: ignoring #pragma omp parallel [-Wunknown-pragmas]
+#pragma omp parallel for if (nb_detections > 4)
+#endif
+      for (int i = 0; i < nb_detections; i++) {
+        vpRigidPose &pose = squarePoses[(size_t)i];
+        if (computeSquarePose(&corners[8 * (size_t)i], h, pose)) {
+          refinePose(pose, X, &corners[8 * (size_t)i], 4, 10);
+        } else {
+          pose = toRigidPose(vpHomogeneousMatrix());
+        }
+      }
+    }
+
+    for (int i = 0; i < nb_detections; i++) {
+      apriltag_detection_t *det = dets[(size_t)i];
 
       std::vector<vpImagePoint> polygon;
       for (int j = 0; j < 4; j++) {
@@ -178,7 +516,9 @@ public:
                                Oy2, thickness);
       }
 
-      if (computePose) {
+      if (computePose && m_poseEstimationMethod == PLANAR_SQUARE) {
+        m_tagPoses.push_back(toHomogeneousMatrix(squarePoses[(size_t)i]));
+      } else if (computePose) {
         vpHomogeneousMatrix cMo;
         if (m_poseEstimationMethod == HOMOGRAPHY || m_poseEstimationMethod == HOMOGRAPHY_VIRTUAL_VS
             || m_poseEstimationMethod == BEST_RESIDUAL_VIRTUAL_VS) {
@@ -277,11 +617,214 @@ public:
       }
     }
 
-    apriltag_detections_destroy(detections);
+    m_layoutPoseValid = false;
+    if (computePose && !m_layout.empty()) {
+      computeLayoutPose(dets, corners);
+    }
+
+    if (m_tracking) {
+      updateTrackedTags(dets);
+      m_trackedWidth = I.getWidth();
+      m_trackedHeight = I.getHeight();
+    }
+
+    for (size_t k = 0; k < detections.size(); k++)
+      apriltag_detections_destroy(detections[k]);
 
     return detected;
   }
 
+  /*
+    Detect the tags in padded regions around their location predicted from
+    the previous frames. The overlapping regions are merged and each one is
+    processed as an image_u8 view of I with the stride of I. Return false if
+    one of the tracked tags is not found in its region.
+  */
+  bool detectInRois(const vpImage<unsigned char> &I, std::vector<zarray_t *> &detections)
+  {
+    const int width = (int)I.getWidth(), height = (int)I.getHeight();
+
+    std::vector<vpRoi> rois(m_trackedTags.size());
+    for (size_t i = 0; i < m_trackedTags.size(); i++) {
+      const vpTrackedTag &tag = m_trackedTags[i];
+      const double margin = m_roiMargin * (std::max)(tag.u_max - tag.u_min, tag.v_max - tag.v_min) +
+                            (std::max)(std::fabs(tag.du), std::fabs(tag.dv));
+      rois[i].left = (std::max)(0, (int)std::floor(tag.u_min + tag.du - margin));
+      rois[i].top = (std::max)(0, (int)std::floor(tag.v_min + tag.dv - margin));
+      rois[i].right = (std::min)(width, (int)std::ceil(tag.u_max + tag.du + margin) + 1);
+      rois[i].bottom = (std::min)(height, (int)std::ceil(tag.v_max + tag.dv + margin) + 1);
+    }
+
+    // Merge the overlapping regions so that a tag is detected only once
+    bool merged = true;
+    while (merged) {
+      merged = false;
+      for (size_t i = 0; i < rois.size() && !merged; i++) {
+        for (size_t j = i + 1; j < rois.size() && !merged; j++) {
+          if (rois[i].left < rois[j].right && rois[j].left < rois[i].right && rois[i].top < rois[j].bottom &&
+              rois[j].top < rois[i].bottom) {
+            rois[i].left = (std::min)(rois[i].left, rois[j].left);
+            rois[i].top = (std::min)(rois[i].top, rois[j].top);
+            rois[i].right = (std::max)(rois[i].right, rois[j].right);
+            rois[i].bottom = (std::max)(rois[i].bottom, rois[j].bottom);
+            rois.erase(rois.begin() + (std::ptrdiff_t)j);
+            merged = true;
+          }
+        }
+      }
+    }
+
+    // Without decimation, a quad_sigma blurs or sharpens the input image in
+    // place and the sharpening copies it assuming that its buffer is
+    // stride * height bytes long: work on a copy of the region
+    const bool copyRoi = m_td->quad_sigma != 0 && m_td->quad_decimate <= 1;
+    vpImage<unsigned char> I_roi;
+    for (size_t k = 0; k < rois.size(); k++) {
+      const vpRoi &roi = rois[k];
+      const int roiWidth = roi.right - roi.left, roiHeight = roi.bottom - roi.top;
+      if (copyRoi) {
+        I_roi.resize((unsigned int)roiHeight, (unsigned int)roiWidth);
+        for (int i = 0; i < roiHeight; i++)
+          memcpy(I_roi[i], I[roi.top + i] + roi.left, (size_t)roiWidth);
+      }
+      image_u8_t im = {/*.width =*/roiWidth,
+                       /*.height =*/roiHeight,
+                       /*.stride =*/copyRoi ? roiWidth : width,
+                       /*.buf =*/copyRoi ? I_roi.bitmap : I.bitmap + roi.top * width + roi.left};
+
+      zarray_t *roiDetections = apriltag_detector_detect(m_td, &im);
+      for (int i = 0; i < zarray_size(roiDetections); i++) {
+        apriltag_detection_t *det;
+        zarray_get(roiDetections, i, &det);
+        // Back to the image frame: the homography is premultiplied by the
+        // translation of the region
+        for (int j = 0; j < 4; j++) {
+          det->p[j][0] += roi.left;
+          det->p[j][1] += roi.top;
+        }
+        det->c[0] += roi.left;
+        det->c[1] += roi.top;
+        for (int j = 0; j < 3; j++) {
+          MATD_EL(det->H, 0, j) += roi.left * MATD_EL(det->H, 2, j);
+          MATD_EL(det->H, 1, j) += roi.top * MATD_EL(det->H, 2, j);
+        }
+      }
+      detections.push_back(roiDetections);
+    }
+
+    // Each tracked tag must be found close to its predicted location
+    for (size_t i = 0; i < m_trackedTags.size(); i++) {
+      const vpTrackedTag &tag = m_trackedTags[i];
+      const double radius = (std::max)(tag.u_max - tag.u_min, tag.v_max - tag.v_min) * (0.5 + m_roiMargin) +
+                            (std::max)(std::fabs(tag.du), std::fabs(tag.dv));
+      bool found = false;
+      for (size_t k = 0; k < detections.size() && !found; k++) {
+        for (int j = 0; j < zarray_size(detections[k]) && !found; j++) {
+          apriltag_detection_t *det;
+          zarray_get(detections[k], j, &det);
+          found = det->id == tag.id && std::fabs(det->c[0] - (tag.u + tag.du)) <= radius &&
+                  std::fabs(det->c[1] - (tag.v + tag.dv)) <= radius;
+        }
+      }
+      if (!found)
+        return false;
+    }
+
+    return true;
+  }
+
+  /*
+    Joint pose of the tags of the layout: the reprojection error of the
+    corners of all the tags is minimized from the pose given by the tag that
+    best fits the others.
+  */
+  void computeLayoutPose(const std::vector<apriltag_detection_t *> &dets, const std::vector<double> &corners)
+  {
+    const double h = m_tagSize / 2;
+    const double tagCorners[4][2] = {{-h, -h}, {h, -h}, {h, h}, {-h, h}};
+    std::vector<double> X, x;
+    std::vector<size_t> layoutTags;
+    for (size_t i = 0; i < dets.size(); i++) {
+      std::map<int, vpHomogeneousMatrix>::const_iterator it = m_layout.find(dets[i]->id);
+      if (it == m_layout.end())
+        continue;
+      // A tag of the layout detected twice is ambiguous
+      bool duplicated = false;
+      for (size_t k = 0; k < dets.size(); k++)
+        duplicated = duplicated || (k != i && dets[k]->id == dets[i]->id);
+      if (duplicated)
+        continue;
+
+      const vpHomogeneousMatrix &oMt = it->second;
+      for (unsigned int j = 0; j < 4; j++) {
+        for (unsigned int r = 0; r < 3; r++)
+          X.push_back(oMt[r][0] * tagCorners[j][0] + oMt[r][1] * tagCorners[j][1] + oMt[r][3]);
+        x.push_back(corners[8 * i + 2 * j]);
+        x.push_back(corners[8 * i + 2 * j + 1]);
+      }
+      layoutTags.push_back(i);
+    }
+    if (layoutTags.empty())
+      return;
+
+    const unsigned int n = (unsigned int)(X.size() / 3);
+    double best_residual = std::numeric_limits<double>::max();
+    vpRigidPose pose;
+    for (size_t k = 0; k < layoutTags.size(); k++) {
+      const size_t i = layoutTags[k];
+      vpRigidPose candidate = toRigidPose(m_tagPoses[i] * m_layout[dets[i]->id].inverse());
+      const double residual = computeResidual(candidate, &X[0], &x[0], n);
+      if (residual < best_residual) {
+        best_residual = residual;
+        pose = candidate;
+      }
+    }
+    if (best_residual == std::numeric_limits<double>::max())
+      return;
+
+    refinePose(pose, &X[0], &x[0], n, 20);
+    m_layoutPose = toHomogeneousMatrix(pose);
+    m_layoutPoseValid = true;
+  }
+
+  /*
+    Replace the tracked tags by the detections. The displacement of a tag
+    since the previous frame is kept to predict its next location.
+  */
+  void updateTrackedTags(const std::vector<apriltag_detection_t *> &dets)
+  {
+    std::vector<vpTrackedTag> tags(dets.size());
+    for (size_t i = 0; i < dets.size(); i++) {
+      const apriltag_detection_t *det = dets[i];
+      vpTrackedTag &tag = tags[i];
+      tag.id = det->id;
+      tag.u = det->c[0];
+      tag.v = det->c[1];
+      tag.u_min = tag.u_max = det->p[0][0];
+      tag.v_min = tag.v_max = det->p[0][1];
+      for (int j = 1; j < 4; j++) {
+        tag.u_min = (std::min)(tag.u_min, det->p[j][0]);
+        tag.u_max = (std::max)(tag.u_max, det->p[j][0]);
+        tag.v_min = (std::min)(tag.v_min, det->p[j][1]);
+        tag.v_max = (std::max)(tag.v_max, det->p[j][1]);
+      }
+
+      // Closest tag with the same id in the previous frame
+      tag.du = tag.dv = 0;
+      double min_dist = (std::max)(tag.u_max - tag.u_min, tag.v_max - tag.v_min);
+      for (size_t k = 0; k < m_trackedTags.size(); k++) {
+        const vpTrackedTag &prev = m_trackedTags[k];
+        const double dist = (std::max)(std::fabs(tag.u - prev.u), std::fabs(tag.v - prev.v));
+        if (prev.id == tag.id && dist < min_dist) {
+          min_dist = dist;
+          tag.du = tag.u - prev.u;
+          tag.dv = tag.v - prev.v;
+        }
+      }
+    }
+    m_trackedTags.swap(tags);
+  }
+
   void getTagPoses(std::vector<vpHomogeneousMatrix> &tagPoses) const { tagPoses = m_tagPoses; }
 
   void setCameraParameters(const vpCameraParameters &cam) { m_cam = cam; }
@@ -302,7 +845,42 @@ public:
 
   void setPoseEstimationMethod(const vpPoseEstimationMethod &method) { m_poseEstimationMethod = method; }
 
+  void setTracking(const bool tracking, const unsigned int fullScanPeriod, const double roiMargin)
+  {
+    m_tracking = tracking;
+    m_fullScanPeriod = fullScanPeriod;
+    m_roiMargin = roiMargin;
+    m_trackedTags.clear();
+    m_nbFramesSinceFullScan = 0;
+  }
+
+  bool isFullScan() const { return m_fullScan; }
+
+  bool getLayoutPose(vpHomogeneousMatrix &cMo) const
+  {
+    if (m_layoutPoseValid)
+      cMo = m_layoutPose;
+    return m_layoutPoseValid;
+  }
+
+  void setLayout(const std::map<int, vpHomogeneousMatrix> &layout)
+  {
+    m_layout = layout;
+    m_layoutPoseValid = false;
+  }
+
 protected:
+  struct vpRoi {
+    int left, top, right, bottom;
+  };
+
+  struct vpTrackedTag {
+    int id;
+    double u, v;                       // center
+    double u_min, u_max, v_min, v_max; // bounding box
+    double du, dv;                     // displacement since the previous frame
+  };
+
   vpCameraParameters m_cam;
   std::map<vpPoseEstimationMethod, vpPose::vpPoseMethodType> m_mapOfCorrespondingPoseMethods;
   vpPoseEstimationMethod m_poseEstimationMethod;
@@ -311,6 +889,16 @@ protected:
   double m_tagSize;
   apriltag_detector_t *m_td;
   apriltag_family_t *m_tf;
+  bool m_tracking;
+  unsigned int m_fullScanPeriod;
+  double m_roiMargin;
+  unsigned int m_nbFramesSinceFullScan;
+  std::vector<vpTrackedTag> m_trackedTags;
+  unsigned int m_trackedWidth, m_trackedHeight;
+  bool m_fullScan;
+  std::map<int, vpHomogeneousMatrix> m_layout;
+  vpHomogeneousMatrix m_layoutPose;
+  bool m_layoutPoseValid;
 };
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 
@@ -339,6 +927,7 @@ vpDetectorAprilTag::~vpDetectorAprilTag() { delete m_impl; }
 */
 bool vpDetectorAprilTag::detect(const vpImage<unsigned char> &I)
 {
+  VP_TRACING_SCOPE("vpDetectorAprilTag::detect");
   m_message.clear();
   m_polygon.clear();
   m_nb_objects = 0;
@@ -361,6 +950,7 @@ bool vpDetectorAprilTag::detect(const vpImage<unsigned char> &I)
 bool vpDetectorAprilTag::detect(const vpImage<unsigned char> &I, const double tagSize, const vpCameraParameters &cam,
                                 std::vector<vpHomogeneousMatrix> &cMo_vec)
 {
+  VP_TRACING_SCOPE("vpDetectorAprilTag::detect");
   m_message.clear();
   m_polygon.clear();
   m_nb_objects = 0;
@@ -375,6 +965,25 @@ bool vpDetectorAprilTag::detect(const vpImage<unsigned char> &I, const double ta
   return detected;
 }
 
+/*!
+  Get the pose of the layout set with setAprilTagLayout(), estimated jointly
+  from all its tags detected by the last call to detect(I, tagSize, cam,
+  cMo_vec).
+
+  \param cMo : Pose of the frame of the layout in the camera frame.
+  \return true if at least one tag of the layout was detected, false
+  otherwise and \e cMo is unchanged.
+*/
+bool vpDetectorAprilTag::getLayoutPose(vpHomogeneousMatrix &cMo) const { return m_impl->getLayoutPose(cMo); }
+
+/*!
+  Return true if the last call to detect() processed the whole image, false
+  if the tags were only searched around their previous location.
+
+  \sa setAprilTagTracking()
+*/
+bool vpDetectorAprilTag::isFullScan() const { return m_impl->isFullScan(); }
+
 /*!
   Set the number of threads for April Tag detection (default is 1).
 
@@ -397,6 +1006,51 @@ void vpDetectorAprilTag::setAprilTagPoseEstimationMethod(const vpPoseEstimationM
   m_impl->setPoseEstimationMethod(poseEstimationMethod);
 }
 
+/*!
+  Enable or disable the tracking mode. When enabled, detect() only searches
+  the tags in regions around their location in the previous frame, predicted
+  with their last displacement and padded with a margin. The regions are
+  processed without any copy of the image, which is much faster than a scan
+  of the whole image when the tags are small with respect to the image.
+
+  The whole image is scanned again:
+  - every \e fullScanPeriod frames, to detect the new tags,
+  - when a tracked tag is not found in its region, for example when it moved
+  too fast or was occluded,
+  - when no tag was detected in the previous frame or the image size changed.
+
+  \param tracking : If true, enable the tracking mode.
+  \param fullScanPeriod : Number of frames between two scans of the whole
+  image, e.g. 10 scans one image out of 10. If 0, the whole image is only
+  scanned when a tag is lost or when no tag was detected.
+  \param roiMargin : Margin added on each side of the bounding box of a tag
+  to build its region, as a fraction of the bounding box size.
+
+  \sa isFullScan()
+*/
+void vpDetectorAprilTag::setAprilTagTracking(const bool tracking, const unsigned int fullScanPeriod,
+                                             const double roiMargin)
+{
+  m_impl->setTracking(tracking, fullScanPeriod, roiMargin);
+}
+
+/*!
+  Set the layout of a rigid set of tags, for example a calibration board.
+  The poses of the tags of the layout are then refined jointly into a
+  single pose by detect(I, tagSize, cam, cMo_vec), available with
+  getLayoutPose(). The tags that are not in the layout are ignored, and
+  the layout tags must all have the size given to detect().
+
+  \param layout : For each tag id, the pose of the tag in the frame of the
+  layout. The tag frame is centered on the tag, with the x and y axes in the
+  plane of the tag, as for the poses returned by detect(). An empty map
+  disables the layout pose.
+*/
+void vpDetectorAprilTag::setAprilTagLayout(const std::map<int, vpHomogeneousMatrix> &layout)
+{
+  m_impl->setLayout(layout);
+}
+
 /*!
   From the AprilTag code:
   <blockquote>
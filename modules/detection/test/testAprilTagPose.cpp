@@ -0,0 +1,242 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the pose estimation of AprilTag tags.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testAprilTagPose.cpp
+
+  Render a board of 36h11 tags in synthetic images and check the tag poses
+  estimated by the PLANAR_SQUARE method against the ground truth and the
+  HOMOGRAPHY_VIRTUAL_VS method, and the joint pose of the board.
+*/
+
+#include <cmath>
+#include <iostream>
+
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpPixelMeterConversion.h>
+#include <visp3/core/vpPoint.h>
+#include <visp3/core/vpTime.h>
+#include <visp3/detection/vpDetectorAprilTag.h>
+
+#if defined(VISP_HAVE_APRILTAG)
+
+namespace
+{
+// Codes of the first 36h11 tags
+const unsigned long long codes[] = {0xd5d628584ULL, 0xd97f18b49ULL, 0xdd280910eULL,
+                                    0xe479e9c98ULL, 0xebcbca822ULL, 0xf31dab3acULL,
+                                    0x056a5d085ULL, 0x10652e1d4ULL, 0x22b1dfeadULL};
+const unsigned int nbTags = 9;
+const double tagSize = 0.04, tagSpacing = 0.06;
+
+// Pose of the tag id in the board frame, the tags are on a 3x3 grid
+vpHomogeneousMatrix boardMtag(unsigned int id)
+{
+  return vpHomogeneousMatrix(((int)(id % 3) - 1) * tagSpacing, ((int)(id / 3) - 1) * tagSpacing, 0, 0, 0, 0);
+}
+
+// Intensity of the tag id at (X, Y) in the tag frame, or -1 outside the tag
+// and its white margin of one cell
+int intensity(unsigned int id, double X, double Y)
+{
+  const double cell = tagSize / 8;
+  const int x = (int)std::floor((X + tagSize / 2) / cell), y = (int)std::floor((Y + tagSize / 2) / cell);
+  if (x < -1 || x > 8 || y < -1 || y > 8)
+    return -1;
+  if (x == -1 || x == 8 || y == -1 || y == 8)
+    return 255;
+  if (x == 0 || x == 7 || y == 0 || y == 7)
+    return 0;
+  const int bit = (y - 1) * 6 + (x - 1);
+  return ((codes[id] >> (35 - bit)) & 1) ? 255 : 0;
+}
+
+// Render the board seen from cMo, with 4 samples per pixel
+void render(vpImage<unsigned char> &I, const vpCameraParameters &cam, const vpHomogeneousMatrix &cMo)
+{
+  std::vector<vpHomogeneousMatrix> tMc(nbTags);
+  for (unsigned int id = 0; id < nbTags; id++)
+    tMc[id] = (cMo * boardMtag(id)).inverse();
+
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      int sum = 0;
+      for (unsigned int s = 0; s < 4; s++) {
+        double x = 0, y = 0;
+        vpPixelMeterConversion::convertPoint(cam, j - 0.25 + 0.5 * (s % 2), i - 0.25 + 0.5 * (s / 2), x, y);
+        int value = 128;
+        for (unsigned int id = 0; id < nbTags && value == 128; id++) {
+          // Intersection of the line of sight with the plane of the tag
+          const vpHomogeneousMatrix &M = tMc[id];
+          const double dz = M[2][0] * x + M[2][1] * y + M[2][2];
+          const double lambda = -M[2][3] / dz;
+          const double X = M[0][3] + lambda * (M[0][0] * x + M[0][1] * y + M[0][2]);
+          const double Y = M[1][3] + lambda * (M[1][0] * x + M[1][1] * y + M[1][2]);
+          const int v = intensity(id, X, Y);
+          if (lambda > 0 && v >= 0)
+            value = v;
+        }
+        sum += value;
+      }
+      I[i][j] = (unsigned char)(sum / 4);
+    }
+  }
+}
+
+// The frame of the tags estimated by the detector has its y axis from the
+// bottom to the top of the tag, and its z axis in front of the tag
+vpHomogeneousMatrix tagMdetector() { return vpHomogeneousMatrix(0, 0, 0, M_PI, 0, 0); }
+
+int tagId(const std::string &message)
+{
+  return atoi(message.substr(message.find("id: ") + 4).c_str());
+}
+
+// Sum of the squared reprojection errors of the corners, in meter
+double residual(const vpHomogeneousMatrix &cMt, const std::vector<vpImagePoint> &corners,
+                const vpCameraParameters &cam)
+{
+  const double h = tagSize / 2;
+  const double X[4][2] = {{-h, -h}, {h, -h}, {h, h}, {-h, h}};
+  double r = 0;
+  for (unsigned int j = 0; j < 4; j++) {
+    vpPoint P(X[j][0], X[j][1], 0);
+    P.track(cMt);
+    double x = 0, y = 0;
+    vpPixelMeterConversion::convertPoint(cam, corners[j], x, y);
+    r += vpMath::sqr(P.get_x() - x) + vpMath::sqr(P.get_y() - y);
+  }
+  return r;
+}
+
+bool equal(const vpHomogeneousMatrix &M1, const vpHomogeneousMatrix &M2, double threshold_t, double threshold_r)
+{
+  const vpHomogeneousMatrix M = M1.inverse() * M2;
+  return M.getTranslationVector().euclideanNorm() < threshold_t &&
+         vpThetaUVector(M.getRotationMatrix()).getTheta() < threshold_r;
+}
+}
+
+int main()
+{
+  try {
+    vpImage<unsigned char> I(480, 640);
+    vpCameraParameters cam(700, 700, 320, 240);
+    const vpHomogeneousMatrix cMo_truth[] = {
+        vpHomogeneousMatrix(0.01, -0.02, 0.5, vpMath::rad(10), vpMath::rad(-15), vpMath::rad(5)),
+        vpHomogeneousMatrix(-0.03, 0.01, 0.45, vpMath::rad(-25), vpMath::rad(5), vpMath::rad(-20)),
+        vpHomogeneousMatrix(0.02, 0.03, 0.6, vpMath::rad(5), vpMath::rad(30), vpMath::rad(40))};
+
+    vpDetectorAprilTag detector(vpDetectorAprilTag::TAG_36h11, vpDetectorAprilTag::PLANAR_SQUARE);
+    vpDetectorAprilTag detector_vvs(vpDetectorAprilTag::TAG_36h11, vpDetectorAprilTag::HOMOGRAPHY_VIRTUAL_VS);
+    std::map<int, vpHomogeneousMatrix> layout;
+    for (unsigned int id = 0; id < nbTags; id++)
+      layout[(int)id] = boardMtag(id) * tagMdetector();
+    detector.setAprilTagLayout(layout);
+
+    for (unsigned int k = 0; k < 3; k++) {
+      std::cout << "** Test pose " << k << std::endl;
+      render(I, cam, cMo_truth[k]);
+
+      std::vector<vpHomogeneousMatrix> cMo_vec, cMo_vec_vvs;
+      double t = vpTime::measureTimeMs();
+      detector.detect(I, tagSize, cam, cMo_vec);
+      t = vpTime::measureTimeMs() - t;
+      double t_vvs = vpTime::measureTimeMs();
+      detector_vvs.detect(I, tagSize, cam, cMo_vec_vvs);
+      t_vvs = vpTime::measureTimeMs() - t_vvs;
+      std::cout << "  " << detector.getNbObjects() << " tags, detection and pose in " << t << " ms with PLANAR_SQUARE, "
+                << t_vvs << " ms with HOMOGRAPHY_VIRTUAL_VS" << std::endl;
+
+      if (detector.getNbObjects() != nbTags || detector_vvs.getNbObjects() != nbTags) {
+        std::cerr << "Wrong number of detected tags" << std::endl;
+        return EXIT_FAILURE;
+      }
+      for (size_t i = 0; i < cMo_vec.size(); i++) {
+        const int id = tagId(detector.getMessage(i));
+        const vpHomogeneousMatrix cMt_truth = cMo_truth[k] * boardMtag((unsigned int)id) * tagMdetector();
+        if (!equal(cMo_vec[i], cMt_truth, 0.005, vpMath::rad(3))) {
+          std::cerr << "Wrong pose of tag " << id << ":\n" << cMo_vec[i] << "\nGround truth:\n"
+                    << cMt_truth << std::endl;
+          return EXIT_FAILURE;
+        }
+        // Both methods minimize the reprojection error of the corners, the
+        // Gauss-Newton iterations converge further than the virtual visual
+        // servoing
+        if (detector_vvs.getMessage(i) != detector.getMessage(i) ||
+            residual(cMo_vec[i], detector.getPolygon(i), cam) >
+                residual(cMo_vec_vvs[i], detector_vvs.getPolygon(i), cam) + 1e-12 ||
+            !equal(cMo_vec[i], cMo_vec_vvs[i], 0.001, vpMath::rad(1))) {
+          std::cerr << "Different poses of tag " << id << ":\n" << cMo_vec[i] << "\nHOMOGRAPHY_VIRTUAL_VS:\n"
+                    << cMo_vec_vvs[i] << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+
+      vpHomogeneousMatrix cMo;
+      if (!detector.getLayoutPose(cMo) || !equal(cMo, cMo_truth[k], 0.001, vpMath::rad(0.5))) {
+        std::cerr << "Wrong pose of the board:\n" << cMo << "\nGround truth:\n" << cMo_truth[k] << std::endl;
+        return EXIT_FAILURE;
+      }
+      std::cout << "  Board pose error: " << (cMo_truth[k].inverse() * cMo).getTranslationVector().euclideanNorm()
+                << " m" << std::endl;
+    }
+
+    // Without any tag of the layout, there is no board pose
+    std::map<int, vpHomogeneousMatrix> other_layout;
+    other_layout[20] = vpHomogeneousMatrix();
+    detector.setAprilTagLayout(other_layout);
+    std::vector<vpHomogeneousMatrix> cMo_vec;
+    detector.detect(I, tagSize, cam, cMo_vec);
+    vpHomogeneousMatrix cMo;
+    if (detector.getLayoutPose(cMo)) {
+      std::cerr << "Pose of a board that is not visible" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::cout << "Test succeed" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const vpException &e) {
+    std::cout << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+}
+#else
+int main()
+{
+  std::cout << "Need ViSP AprilTag." << std::endl;
+  return 0;
+}
+#endif
@@ -0,0 +1,195 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the tracking mode of the AprilTag detector.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testAprilTagTracking.cpp
+
+  Detect moving 36h11 tags in synthetic images with and without the tracking
+  mode of vpDetectorAprilTag and check that the detections and the poses are
+  the same, and that the whole image is scanned again when a tag is lost.
+*/
+
+#include <cmath>
+#include <iostream>
+
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/detection/vpDetectorAprilTag.h>
+
+#if defined(VISP_HAVE_APRILTAG)
+
+namespace
+{
+// Codes of the first 36h11 tags
+const unsigned long long codes[] = {0xd5d628584ULL, 0xd97f18b49ULL, 0xdd280910eULL, 0xe479e9c98ULL};
+
+// Draw the tag with the given id, black border included, at (top, left)
+// with cells of cellSize pixels
+void drawTag(vpImage<unsigned char> &I, unsigned int id, int top, int left, int cellSize)
+{
+  for (int y = 0; y < 8; y++) {
+    for (int x = 0; x < 8; x++) {
+      bool white = false;
+      if (x > 0 && x < 7 && y > 0 && y < 7) {
+        const int bit = (y - 1) * 6 + (x - 1);
+        white = ((codes[id] >> (35 - bit)) & 1) != 0;
+      }
+      for (int i = 0; i < cellSize; i++)
+        for (int j = 0; j < cellSize; j++)
+          I[top + y * cellSize + i][left + x * cellSize + j] = white ? 240 : 20;
+    }
+  }
+}
+
+struct Tag {
+  unsigned int id;
+  int top, left, dv, du;
+  unsigned int firstFrame, lastFrame;
+};
+
+// Tag 2 disappears at frame 15, tag 3 appears at frame 21
+const Tag tags[] = {{0, 100, 150, 3, 4, 0, 40}, {1, 600, 900, -2, 3, 0, 40}, {2, 300, 500, 1, -5, 0, 14},
+                    {3, 700, 200, -4, 2, 21, 40}};
+const unsigned int nbTags = 4;
+
+void render(vpImage<unsigned char> &I, unsigned int frame, vpUniRand &rng)
+{
+  for (unsigned int k = 0; k < I.getSize(); k++)
+    I.bitmap[k] = (unsigned char)(215 + 4 * rng());
+  for (unsigned int t = 0; t < nbTags; t++) {
+    if (frame >= tags[t].firstFrame && frame <= tags[t].lastFrame) {
+      const int n = (int)(frame - tags[t].firstFrame);
+      drawTag(I, tags[t].id, tags[t].top + n * tags[t].dv, tags[t].left + n * tags[t].du, 6);
+    }
+  }
+}
+
+bool samePolygons(const std::vector<vpImagePoint> &a, const std::vector<vpImagePoint> &b)
+{
+  for (size_t k = 0; k < a.size(); k++) {
+    if (vpImagePoint::distance(a[k], b[k]) > 0.5)
+      return false;
+  }
+  return a.size() == b.size();
+}
+}
+
+int main()
+{
+  try {
+    const unsigned int nbFrames = 40, fullScanPeriod = 8;
+    vpImage<unsigned char> I(960, 1280);
+    vpCameraParameters cam(1000, 1000, 640, 480);
+    const double tagSize = 0.05;
+    vpUniRand rng(1);
+
+    vpDetectorAprilTag detector(vpDetectorAprilTag::TAG_36h11), tracker(vpDetectorAprilTag::TAG_36h11);
+    tracker.setAprilTagTracking(true, fullScanPeriod);
+
+    unsigned int nbPartialScans = 0, nbMissed = 0;
+    for (unsigned int frame = 0; frame < nbFrames; frame++) {
+      render(I, frame, rng);
+      std::vector<vpHomogeneousMatrix> cMo, cMo_tracked;
+      detector.detect(I, tagSize, cam, cMo);
+      tracker.detect(I, tagSize, cam, cMo_tracked);
+
+      const unsigned int nbVisible = frame < 15 ? 3 : (frame < 21 ? 2 : 3);
+      if (detector.getNbObjects() != nbVisible) {
+        std::cerr << "Frame " << frame << ": " << detector.getNbObjects() << " tags detected instead of " << nbVisible
+                  << std::endl;
+        return EXIT_FAILURE;
+      }
+      if (!tracker.isFullScan())
+        nbPartialScans++;
+      if (frame == 15 && !tracker.isFullScan()) {
+        std::cerr << "The image was not scanned again when a tag was lost" << std::endl;
+        return EXIT_FAILURE;
+      }
+
+      // The tracked tags are also detected by the full scan, with the same
+      // corners and pose
+      for (size_t i = 0; i < tracker.getNbObjects(); i++) {
+        bool found = false;
+        for (size_t j = 0; j < detector.getNbObjects() && !found; j++) {
+          if (tracker.getMessage(i) == detector.getMessage(j) &&
+              samePolygons(tracker.getPolygon(i), detector.getPolygon(j))) {
+            found = true;
+            for (unsigned int k = 0; k < 3; k++) {
+              if (std::fabs(cMo_tracked[i][k][3] - cMo[j][k][3]) > 0.005) {
+                std::cerr << "Frame " << frame << ": different poses for " << tracker.getMessage(i) << ":\n"
+                          << cMo_tracked[i] << "\n"
+                          << cMo[j] << std::endl;
+                return EXIT_FAILURE;
+              }
+            }
+          }
+        }
+        if (!found) {
+          std::cerr << "Frame " << frame << ": wrong tracked tag " << tracker.getMessage(i) << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+      // Only the new tags are missed until the next full scan
+      if (tracker.getNbObjects() != nbVisible) {
+        if (frame < 21 || tracker.getNbObjects() + 1 != nbVisible) {
+          std::cerr << "Frame " << frame << ": " << tracker.getNbObjects() << " tags tracked instead of " << nbVisible
+                    << std::endl;
+          return EXIT_FAILURE;
+        }
+        nbMissed++;
+      }
+    }
+
+    std::cout << nbPartialScans << " frames out of " << nbFrames << " processed in regions of interest, " << nbMissed
+              << " frames before the detection of the new tag" << std::endl;
+    if (nbPartialScans < nbFrames / 2 || nbMissed >= fullScanPeriod) {
+      std::cerr << "Wrong number of scans of the whole image" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::cout << "Test succeed" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const vpException &e) {
+    std::cout << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+}
+#else
+int main()
+{
+  std::cout << "Need ViSP AprilTag." << std::endl;
+  return 0;
+}
+#endif
@@ -47,6 +47,9 @@
 //{
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>
+#ifdef VISP_HAVE_X11_XSHM
+#include <X11/extensions/XShm.h>
+#endif
 //#include <X11/Xatom.h>
 //#include <X11/cursorfont.h>
 //} ;
@@ -79,6 +82,12 @@
   It also define method to display some geometric feature (point, line,
 circle) in the image.
 
+  When the X server supports the MIT-SHM extension (local display), the
+  images are uploaded through a shared memory segment reused from one frame
+  to the next instead of being copied over the X socket. Otherwise the
+  display falls back to XPutImage(). flushDisplay() only refreshes the part
+  of the window modified since the previous flush.
+
   The example below shows how to display an image with this video device.
   \code
 #include <visp3/core/vpConfig.h>
@@ -167,6 +176,18 @@ private:
   bool ximage_data_init;
   unsigned int RMask, GMask, BMask;
   int RShift, GShift, BShift;
+#ifdef VISP_HAVE_X11_XSHM
+  XShmSegmentInfo m_shmInfo;
+#endif
+  bool m_useShm;           // True when Ximage data lives in a MIT-SHM segment
+  XFontStruct *m_fontInfo; // Metrics of the current font
+  int m_dirtyLeft, m_dirtyTop, m_dirtyRight, m_dirtyBottom; // Area to refresh by flushDisplay()
+
+  void createImage();
+  void destroyImage();
+  void putImage(int x, int y, unsigned int w, unsigned int h);
+  void updateDirtyArea(int x, int y, int w, int h);
+  void updateDirtyArea(const vpImagePoint &ip1, const vpImagePoint &ip2, unsigned int margin);
 
   // private:
   //#ifndef DOXYGEN_SHOULD_SKIP_THIS
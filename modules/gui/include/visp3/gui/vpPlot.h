@@ -162,6 +162,8 @@ public:
 
   void plot(const unsigned int graphNum, const unsigned int curveNum, const double x, const double y);
   void plot(const unsigned int graphNum, const double x, const vpColVector &v_y);
+  void plotBatch(const unsigned int graphNum, const unsigned int curveNum, const vpColVector &v_x,
+                 const vpColVector &v_y);
   void plot(const unsigned int graphNum, const double x, const vpRowVector &v_y);
   void plot(const unsigned int graphNum, const double x, const vpPoseVector &v_y);
   void plot(const unsigned int graphNum, const double x, const vpTranslationVector &v_y);
@@ -190,6 +192,8 @@ public:
       vpDisplay::setFont(I, font.c_str());
   }
   void setLegend(const unsigned int graphNum, const unsigned int curveNum, const std::string &legend);
+  void setMaxNbPoints(const unsigned int graphNum, const unsigned int curveNum, const unsigned int maxNbPoints);
+  void setMaxNbPoints(const unsigned int graphNum, const unsigned int maxNbPoints);
   void setTitle(const unsigned int graphNum, const std::string &title);
   void setUnitX(const unsigned int graphNum, const std::string &unitx);
   void setUnitY(const unsigned int graphNum, const std::string &unity);
@@ -50,11 +50,11 @@
 #include <visp3/core/vpCameraParameters.h>
 #include <visp3/core/vpPoint.h>
 
-#include <list>
+#include <deque>
 
 #if defined(VISP_HAVE_DISPLAY)
 
-class vpPlotCurve
+class VISP_EXPORT vpPlotCurve
 {
 public:
   //! Different styles to plot the curve.
@@ -66,10 +66,11 @@ public:
   // char lineStyle[20];
   // vpList<vpImagePoint> pointList;
   unsigned int nbPoint;
+  unsigned int maxNbPoint; // Oldest points are dropped above this size, 0 for no limit
   vpImagePoint lastPoint;
-  std::list<double> pointListx;
-  std::list<double> pointListy;
-  std::list<double> pointListz;
+  std::deque<double> pointListx;
+  std::deque<double> pointListy;
+  std::deque<double> pointListz;
   std::string legend;
   double xmin;
   double xmax;
@@ -79,9 +80,11 @@ public:
 public:
   vpPlotCurve();
   ~vpPlotCurve();
+  void addPoint(const double x, const double y, const double z);
   void plotPoint(const vpImage<unsigned char> &I, const vpImagePoint &iP, const double x, const double y);
   void plotList(const vpImage<unsigned char> &I, const double xorg, const double yorg, const double zoomx,
-                const double zoomy);
+                const double zoomy, const unsigned int first = 0);
+  void setMaxNbPoint(const unsigned int maxNb);
 };
 
 #endif
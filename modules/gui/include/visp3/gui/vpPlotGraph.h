@@ -41,6 +41,7 @@
 #ifndef vpPlotGraph_H
 #define vpPlotGraph_H
 
+#include <visp3/core/vpColVector.h>
 #include <visp3/core/vpColor.h>
 #include <visp3/core/vpImage.h>
 
@@ -55,7 +56,7 @@
 
 #if defined(VISP_HAVE_DISPLAY)
 
-class vpPlotGraph
+class VISP_EXPORT vpPlotGraph
 {
 public:
   double xorg;
@@ -200,6 +201,7 @@ public:
   vpHomogeneousMatrix navigation(const vpImage<unsigned char> &I, bool &changed, vpMouseButton::vpMouseButtonType &b);
 
   void plot(vpImage<unsigned char> &I, const unsigned int curveNb, const double x, const double y);
+  void plot(vpImage<unsigned char> &I, const unsigned int curveNb, const vpColVector &x, const vpColVector &y);
   vpMouseButton::vpMouseButtonType plot(vpImage<unsigned char> &I, const unsigned int curveNb, const double x,
                                         const double y, const double z);
   void replot(vpImage<unsigned char> &I);
@@ -213,6 +215,7 @@ public:
   void resetPointList(const unsigned int curveNum);
 
   void setCurveColor(const unsigned int curveNum, const vpColor &color);
+  void setCurveMaxNbPoint(const unsigned int curveNum, const unsigned int maxNbPoint);
   void setCurveThickness(const unsigned int curveNum, const unsigned int thickness);
   void setGridThickness(const unsigned int thickness) { this->gridThickness = thickness; };
   void setLegend(const unsigned int curveNum, const std::string &legend);
@@ -46,11 +46,22 @@
 #ifdef VISP_HAVE_X11
 
 #include <cmath> // std::fabs
+#include <cstring> // strlen
 #include <iostream>
 #include <limits> // numeric_limits
 #include <stdio.h>
 #include <stdlib.h>
 
+#ifdef VISP_HAVE_X11_XSHM
+#include <sys/ipc.h>
+#include <sys/shm.h>
+#endif
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
 // Display stuff
 #include <visp3/core/vpDisplay.h>
 #include <visp3/gui/vpDisplayX.h>
@@ -62,6 +73,78 @@
 // math
 #include <visp3/core/vpMath.h>
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+namespace
+{
+#ifdef VISP_HAVE_X11_XSHM
+bool shmAttachFailed = false;
+
+int shmErrorHandler(Display *, XErrorEvent *)
+{
+  shmAttachFailed = true;
+  return 0;
+}
+#endif
+
+/*!
+  Convert grey pixels into 32-bit little endian pixels (B, G, R, A).
+ */
+void convertGreyToBGRa(const unsigned char *grey, unsigned char *bgra, unsigned int size)
+{
+  unsigned int i = 0;
+#if VISP_HAVE_SSE2
+  const __m128i alpha = _mm_set1_epi8((char)vpRGBa::alpha_default);
+  for (; i + 16 <= size; i += 16) {
+    const __m128i g = _mm_loadu_si128((const __m128i *)(grey + i));
+    const __m128i gg_lo = _mm_unpacklo_epi8(g, g);
+    const __m128i gg_hi = _mm_unpackhi_epi8(g, g);
+    const __m128i ga_lo = _mm_unpacklo_epi8(g, alpha);
+    const __m128i ga_hi = _mm_unpackhi_epi8(g, alpha);
+    _mm_storeu_si128((__m128i *)(bgra + 4 * i), _mm_unpacklo_epi16(gg_lo, ga_lo));
+    _mm_storeu_si128((__m128i *)(bgra + 4 * i + 16), _mm_unpackhi_epi16(gg_lo, ga_lo));
+    _mm_storeu_si128((__m128i *)(bgra + 4 * i + 32), _mm_unpacklo_epi16(gg_hi, ga_hi));
+    _mm_storeu_si128((__m128i *)(bgra + 4 * i + 48), _mm_unpackhi_epi16(gg_hi, ga_hi));
+  }
+#endif
+  for (; i < size; i++) {
+    unsigned char val = grey[i];
+    bgra[4 * i] = val;
+    bgra[4 * i + 1] = val;
+    bgra[4 * i + 2] = val;
+    bgra[4 * i + 3] = vpRGBa::alpha_default;
+  }
+}
+
+/*!
+  Convert RGBa pixels into 32-bit little endian pixels (B, G, R, A).
+ */
+void convertRGBaToBGRa(const vpRGBa *rgba, unsigned char *bgra, unsigned int size)
+{
+  unsigned int i = 0;
+#if VISP_HAVE_SSE2
+  const unsigned char *src = (const unsigned char *)rgba;
+  const __m128i mask_ga = _mm_set1_epi32((int)0xff00ff00);
+  const __m128i mask_b = _mm_set1_epi32(0x000000ff);
+  const __m128i mask_r = _mm_set1_epi32(0x00ff0000);
+  for (; i + 4 <= size; i += 4) {
+    const __m128i v = _mm_loadu_si128((const __m128i *)(src + 4 * i));
+    const __m128i r = _mm_and_si128(_mm_slli_epi32(v, 16), mask_r);
+    const __m128i b = _mm_and_si128(_mm_srli_epi32(v, 16), mask_b);
+    _mm_storeu_si128((__m128i *)(bgra + 4 * i), _mm_or_si128(_mm_and_si128(v, mask_ga), _mm_or_si128(r, b)));
+  }
+#endif
+  for (; i < size; i++) {
+    bgra[4 * i] = rgba[i].B;
+    bgra[4 * i + 1] = rgba[i].G;
+    bgra[4 * i + 2] = rgba[i].R;
+    bgra[4 * i + 3] = rgba[i].A;
+  }
+}
+}
+
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 /*!
 
   Constructor : initialize a display to visualize a gray level image
@@ -86,7 +169,7 @@
 vpDisplayX::vpDisplayX(vpImage<unsigned char> &I, vpScaleType scaleType)
   : display(NULL), window(), Ximage(NULL), lut(), context(), screen(0), event(), pixmap(), x_color(NULL),
     screen_depth(8), xcolor(), values(), ximage_data_init(false), RMask(0), GMask(0), BMask(0), RShift(0), GShift(0),
-    BShift(0)
+    BShift(0), m_useShm(false), m_fontInfo(NULL), m_dirtyLeft(0), m_dirtyTop(0), m_dirtyRight(0), m_dirtyBottom(0)
 {
   setScale(scaleType, I.getWidth(), I.getHeight());
 
@@ -119,7 +202,7 @@ vpDisplayX::vpDisplayX(vpImage<unsigned char> &I, vpScaleType scaleType)
 vpDisplayX::vpDisplayX(vpImage<unsigned char> &I, int x, int y, const std::string &title, vpScaleType scaleType)
   : display(NULL), window(), Ximage(NULL), lut(), context(), screen(0), event(), pixmap(), x_color(NULL),
     screen_depth(8), xcolor(), values(), ximage_data_init(false), RMask(0), GMask(0), BMask(0), RShift(0), GShift(0),
-    BShift(0)
+    BShift(0), m_useShm(false), m_fontInfo(NULL), m_dirtyLeft(0), m_dirtyTop(0), m_dirtyRight(0), m_dirtyBottom(0)
 {
   setScale(scaleType, I.getWidth(), I.getHeight());
   init(I, x, y, title);
@@ -147,7 +230,7 @@ vpDisplayX::vpDisplayX(vpImage<unsigned char> &I, int x, int y, const std::strin
 vpDisplayX::vpDisplayX(vpImage<vpRGBa> &I, vpScaleType scaleType)
   : display(NULL), window(), Ximage(NULL), lut(), context(), screen(0), event(), pixmap(), x_color(NULL),
     screen_depth(8), xcolor(), values(), ximage_data_init(false), RMask(0), GMask(0), BMask(0), RShift(0), GShift(0),
-    BShift(0)
+    BShift(0), m_useShm(false), m_fontInfo(NULL), m_dirtyLeft(0), m_dirtyTop(0), m_dirtyRight(0), m_dirtyBottom(0)
 {
   setScale(scaleType, I.getWidth(), I.getHeight());
   init(I);
@@ -177,7 +260,7 @@ vpDisplayX::vpDisplayX(vpImage<vpRGBa> &I, vpScaleType scaleType)
 vpDisplayX::vpDisplayX(vpImage<vpRGBa> &I, int x, int y, const std::string &title, vpScaleType scaleType)
   : display(NULL), window(), Ximage(NULL), lut(), context(), screen(0), event(), pixmap(), x_color(NULL),
     screen_depth(8), xcolor(), values(), ximage_data_init(false), RMask(0), GMask(0), BMask(0), RShift(0), GShift(0),
-    BShift(0)
+    BShift(0), m_useShm(false), m_fontInfo(NULL), m_dirtyLeft(0), m_dirtyTop(0), m_dirtyRight(0), m_dirtyBottom(0)
 {
   setScale(scaleType, I.getWidth(), I.getHeight());
   init(I, x, y, title);
@@ -208,7 +291,7 @@ int main()
 vpDisplayX::vpDisplayX(int x, int y, const std::string &title)
   : display(NULL), window(), Ximage(NULL), lut(), context(), screen(0), event(), pixmap(), x_color(NULL),
     screen_depth(8), xcolor(), values(), ximage_data_init(false), RMask(0), GMask(0), BMask(0), RShift(0), GShift(0),
-    BShift(0)
+    BShift(0), m_useShm(false), m_fontInfo(NULL), m_dirtyLeft(0), m_dirtyTop(0), m_dirtyRight(0), m_dirtyBottom(0)
 {
   m_windowXPosition = x;
   m_windowYPosition = y;
@@ -238,7 +321,7 @@ int main()
 vpDisplayX::vpDisplayX()
   : display(NULL), window(), Ximage(NULL), lut(), context(), screen(0), event(), pixmap(), x_color(NULL),
     screen_depth(8), xcolor(), values(), ximage_data_init(false), RMask(0), GMask(0), BMask(0), RShift(0), GShift(0),
-    BShift(0)
+    BShift(0), m_useShm(false), m_fontInfo(NULL), m_dirtyLeft(0), m_dirtyTop(0), m_dirtyRight(0), m_dirtyBottom(0)
 {
 }
 
@@ -659,13 +742,7 @@ void vpDisplayX::init(vpImage<unsigned char> &I, int x, int y, const std::string
   //    XNextEvent ( display, &event );
   //  while ( event.xany.type != Expose );
 
-  {
-    Ximage = XCreateImage(display, DefaultVisual(display, screen), screen_depth, ZPixmap, 0, NULL, m_width, m_height,
-                          XBitmapPad(display), 0);
-
-    Ximage->data = (char *)malloc(m_height * (unsigned int)Ximage->bytes_per_line);
-    ximage_data_init = true;
-  }
+  createImage();
   m_displayHasBeenInitialized = true;
 
   XStoreName(display, window, m_title.c_str());
@@ -1091,13 +1168,7 @@ void vpDisplayX::init(vpImage<vpRGBa> &I, int x, int y, const std::string &title
   //    XNextEvent ( display, &event );
   //  while ( event.xany.type != Expose );
 
-  {
-    Ximage = XCreateImage(display, DefaultVisual(display, screen), screen_depth, ZPixmap, 0, NULL, m_width, m_height,
-                          XBitmapPad(display), 0);
-
-    Ximage->data = (char *)malloc(m_height * (unsigned int)Ximage->bytes_per_line);
-    ximage_data_init = true;
-  }
+  createImage();
   m_displayHasBeenInitialized = true;
 
   XSync(display, true);
@@ -1542,13 +1613,7 @@ void vpDisplayX::init(unsigned int w, unsigned int h, int x, int y, const std::s
   //    XNextEvent ( display, &event );
   //  while ( event.xany.type != Expose );
 
-  {
-    Ximage = XCreateImage(display, DefaultVisual(display, screen), screen_depth, ZPixmap, 0, NULL, m_width, m_height,
-                          XBitmapPad(display), 0);
-
-    Ximage->data = (char *)malloc(m_height * (unsigned int)Ximage->bytes_per_line);
-    ximage_data_init = true;
-  }
+  createImage();
   m_displayHasBeenInitialized = true;
 
   XSync(display, true);
@@ -1578,6 +1643,9 @@ void vpDisplayX::setFont(const std::string &font)
         Font stringfont;
         stringfont = XLoadFont(display, font.c_str()); //"-adobe-times-bold-r-normal--18*");
         XSetFont(display, context, stringfont);
+        if (m_fontInfo != NULL)
+          XFreeFontInfo(NULL, m_fontInfo, 1);
+        m_fontInfo = XQueryFont(display, stringfont);
       } catch (...) {
         throw(vpDisplayException(vpDisplayException::notInitializedError, "Bad font"));
       }
@@ -1670,7 +1738,7 @@ void vpDisplayX::displayImage(const vpImage<unsigned char> &I)
       }
 
       // Affichage de l'image dans la Pixmap.
-      XPutImage(display, pixmap, context, Ximage, 0, 0, 0, 0, m_width, m_height);
+      putImage(0, 0, m_width, m_height);
       XSetWindowBackgroundPixmap(display, window, pixmap);
       break;
     }
@@ -1695,7 +1763,7 @@ void vpDisplayX::displayImage(const vpImage<unsigned char> &I)
       }
 
       // Affichage de l'image dans la Pixmap.
-      XPutImage(display, pixmap, context, Ximage, 0, 0, 0, 0, m_width, m_height);
+      putImage(0, 0, m_width, m_height);
       XSetWindowBackgroundPixmap(display, window, pixmap);
       break;
     }
@@ -1720,13 +1788,7 @@ void vpDisplayX::displayImage(const vpImage<unsigned char> &I)
           }
         } else {
           // little endian
-          while (bitmap < n) {
-            unsigned char val = *(bitmap++);
-            *(dst_32++) = val; // Blue
-            *(dst_32++) = val; // Green
-            *(dst_32++) = val; // Red
-            *(dst_32++) = vpRGBa::alpha_default;
-          }
+          convertGreyToBGRa(bitmap, dst_32, size_);
         }
       } else {
         if (XImageByteOrder(display) == 1) {
@@ -1755,7 +1817,7 @@ void vpDisplayX::displayImage(const vpImage<unsigned char> &I)
       }
 
       // Affichage de l'image dans la Pixmap.
-      XPutImage(display, pixmap, context, Ximage, 0, 0, 0, 0, m_width, m_height);
+      putImage(0, 0, m_width, m_height);
       XSetWindowBackgroundPixmap(display, window, pixmap);
       break;
     }
@@ -1813,7 +1875,7 @@ void vpDisplayX::displayImage(const vpImage<vpRGBa> &I)
         }
       }
 
-      XPutImage(display, pixmap, context, Ximage, 0, 0, 0, 0, m_width, m_height);
+      putImage(0, 0, m_width, m_height);
       XSetWindowBackgroundPixmap(display, window, pixmap);
 
       break;
@@ -1839,13 +1901,7 @@ void vpDisplayX::displayImage(const vpImage<vpRGBa> &I)
           }
         } else {
           // little endian
-          for (unsigned int i = 0; i < sizeI; i++) {
-            *(dst_32++) = bitmap->B;
-            *(dst_32++) = bitmap->G;
-            *(dst_32++) = bitmap->R;
-            *(dst_32++) = bitmap->A;
-            bitmap++;
-          }
+          convertRGBaToBGRa(bitmap, dst_32, sizeI);
         }
       } else {
         if (XImageByteOrder(display) == 1) {
@@ -1874,7 +1930,7 @@ void vpDisplayX::displayImage(const vpImage<vpRGBa> &I)
       }
 
       // Affichage de l'image dans la Pixmap.
-      XPutImage(display, pixmap, context, Ximage, 0, 0, 0, 0, m_width, m_height);
+      putImage(0, 0, m_width, m_height);
       XSetWindowBackgroundPixmap(display, window, pixmap);
       break;
     }
@@ -1912,7 +1968,7 @@ void vpDisplayX::displayImage(const unsigned char *bitmap)
     }
 
     // Affichage de l'image dans la Pixmap.
-    XPutImage(display, pixmap, context, Ximage, 0, 0, 0, 0, m_width, m_height);
+    putImage(0, 0, m_width, m_height);
     XSetWindowBackgroundPixmap(display, window, pixmap);
   } else {
     throw(vpDisplayException(vpDisplayException::notInitializedError, "X not initialized"));
@@ -1967,8 +2023,7 @@ void vpDisplayX::displayImageROI(const vpImage<unsigned char> &I, const vpImageP
           i++;
         }
 
-        XPutImage(display, pixmap, context, Ximage, (int)iP.get_u(), (int)iP.get_v(), (int)iP.get_u(), (int)iP.get_v(),
-                  w, h);
+        putImage((int)iP.get_u(), (int)iP.get_v(), w, h);
       } else {
         // Correction de l'image de facon a liberer les niveaux de gris
         // ROUGE, VERT, BLEU, JAUNE
@@ -1992,7 +2047,7 @@ void vpDisplayX::displayImageROI(const vpImage<unsigned char> &I, const vpImageP
               dst_8[j] = nivGris;
           }
         }
-        XPutImage(display, pixmap, context, Ximage, j_min, i_min, j_min, i_min, j_max_ - j_min_, i_max_ - i_min_);
+        putImage(j_min, i_min, j_max_ - j_min_, i_max_ - i_min_);
       }
 
       // Affichage de l'image dans la Pixmap.
@@ -2010,8 +2065,7 @@ void vpDisplayX::displayImageROI(const vpImage<unsigned char> &I, const vpImageP
           }
         }
 
-        XPutImage(display, pixmap, context, Ximage, (int)iP.get_u(), (int)iP.get_v(), (int)iP.get_u(), (int)iP.get_v(),
-                  w, h);
+        putImage((int)iP.get_u(), (int)iP.get_v(), w, h);
       } else {
         int i_min = (std::max)((int)ceil(iP.get_i() / m_scale), 0);
         int j_min = (std::max)((int)ceil(iP.get_j() / m_scale), 0);
@@ -2031,7 +2085,7 @@ void vpDisplayX::displayImageROI(const vpImage<unsigned char> &I, const vpImageP
           }
         }
 
-        XPutImage(display, pixmap, context, Ximage, j_min, i_min, j_min, i_min, j_max_ - j_min_, i_max_ - i_min_);
+        putImage(j_min, i_min, j_max_ - j_min_, i_max_ - i_min_);
       }
 
       XSetWindowBackgroundPixmap(display, window, pixmap);
@@ -2081,8 +2135,7 @@ void vpDisplayX::displayImageROI(const vpImage<unsigned char> &I, const vpImageP
           }
         }
 
-        XPutImage(display, pixmap, context, Ximage, (int)iP.get_u(), (int)iP.get_v(), (int)iP.get_u(), (int)iP.get_v(),
-                  w, h);
+        putImage((int)iP.get_u(), (int)iP.get_v(), w, h);
       } else {
         int i_min = (std::max)((int)ceil(iP.get_i() / m_scale), 0);
         int j_min = (std::max)((int)ceil(iP.get_j() / m_scale), 0);
@@ -2120,7 +2173,7 @@ void vpDisplayX::displayImageROI(const vpImage<unsigned char> &I, const vpImageP
           }
         }
 
-        XPutImage(display, pixmap, context, Ximage, j_min, i_min, j_min, i_min, j_max_ - j_min_, i_max_ - i_min_);
+        putImage(j_min, i_min, j_max_ - j_min_, i_max_ - i_min_);
       }
 
       XSetWindowBackgroundPixmap(display, window, pixmap);
@@ -2167,8 +2220,7 @@ void vpDisplayX::displayImageROI(const vpImage<vpRGBa> &I, const vpImagePoint &i
                 (((r << 8) >> RShift) & RMask) | (((g << 8) >> GShift) & GMask) | (((b << 8) >> BShift) & BMask);
           }
         }
-        XPutImage(display, pixmap, context, Ximage, (int)iP.get_u(), (int)iP.get_v(), (int)iP.get_u(), (int)iP.get_v(),
-                  w, h);
+        putImage((int)iP.get_u(), (int)iP.get_v(), w, h);
       } else {
         unsigned int bytes_per_line = (unsigned int)Ximage->bytes_per_line;
         int i_min = (std::max)((int)ceil(iP.get_i() / m_scale), 0);
@@ -2193,7 +2245,7 @@ void vpDisplayX::displayImageROI(const vpImage<vpRGBa> &I, const vpImagePoint &i
                 (((r << 8) >> RShift) & RMask) | (((g << 8) >> GShift) & GMask) | (((b << 8) >> BShift) & BMask);
           }
         }
-        XPutImage(display, pixmap, context, Ximage, j_min, i_min, j_min, i_min, j_max_ - j_min_, i_max_ - i_min_);
+        putImage(j_min, i_min, j_max_ - j_min_, i_max_ - i_min_);
       }
 
       XSetWindowBackgroundPixmap(display, window, pixmap);
@@ -2252,8 +2304,7 @@ void vpDisplayX::displayImageROI(const vpImage<vpRGBa> &I, const vpImagePoint &i
           }
         }
 
-        XPutImage(display, pixmap, context, Ximage, (int)iP.get_u(), (int)iP.get_v(), (int)iP.get_u(), (int)iP.get_v(),
-                  w, h);
+        putImage((int)iP.get_u(), (int)iP.get_v(), w, h);
       } else {
         int i_min = (std::max)((int)ceil(iP.get_i() / m_scale), 0);
         int j_min = (std::max)((int)ceil(iP.get_j() / m_scale), 0);
@@ -2290,7 +2341,7 @@ void vpDisplayX::displayImageROI(const vpImage<vpRGBa> &I, const vpImagePoint &i
             }
           }
         }
-        XPutImage(display, pixmap, context, Ximage, j_min, i_min, j_min, i_min, j_max_ - j_min_, i_max_ - i_min_);
+        putImage(j_min, i_min, j_max_ - j_min_, i_max_ - i_min_);
       }
 
       XSetWindowBackgroundPixmap(display, window, pixmap);
@@ -2315,11 +2366,12 @@ void vpDisplayX::displayImageROI(const vpImage<vpRGBa> &I, const vpImagePoint &i
 void vpDisplayX::closeDisplay()
 {
   if (m_displayHasBeenInitialized) {
-    if (ximage_data_init == true)
-      free(Ximage->data);
+    destroyImage();
 
-    Ximage->data = NULL;
-    XDestroyImage(Ximage);
+    if (m_fontInfo != NULL) {
+      XFreeFontInfo(NULL, m_fontInfo, 1);
+      m_fontInfo = NULL;
+    }
 
     XFreePixmap(display, pixmap);
 
@@ -2344,7 +2396,11 @@ void vpDisplayX::closeDisplay()
 void vpDisplayX::flushDisplay()
 {
   if (m_displayHasBeenInitialized) {
-    XClearWindow(display, window);
+    if (m_dirtyRight > m_dirtyLeft && m_dirtyBottom > m_dirtyTop) {
+      XClearArea(display, window, m_dirtyLeft, m_dirtyTop, (unsigned int)(m_dirtyRight - m_dirtyLeft),
+                 (unsigned int)(m_dirtyBottom - m_dirtyTop), 0);
+      m_dirtyLeft = m_dirtyTop = m_dirtyRight = m_dirtyBottom = 0;
+    }
     XFlush(display);
   } else {
     throw(vpDisplayException(vpDisplayException::notInitializedError, "X not initialized"));
@@ -2392,6 +2448,7 @@ void vpDisplayX::clearDisplay(const vpColor &color)
     XFreePixmap(display, pixmap);
     // Pixmap creation.
     pixmap = XCreatePixmap(display, window, m_width, m_height, screen_depth);
+    updateDirtyArea(0, 0, (int)m_width, (int)m_height);
   } else {
     throw(vpDisplayException(vpDisplayException::notInitializedError, "X not initialized"));
   }
@@ -2470,6 +2527,18 @@ void vpDisplayX::displayCharString(const vpImagePoint &ip, const char *text, con
     }
     XDrawString(display, pixmap, context, (int)(ip.get_u() / m_scale), (int)(ip.get_v() / m_scale), text,
                 (int)strlen(text));
+
+    if (m_fontInfo == NULL)
+      m_fontInfo = XQueryFont(display, XGContextFromGC(context));
+    if (m_fontInfo != NULL) {
+      int direction, ascent, descent;
+      XCharStruct overall;
+      XTextExtents(m_fontInfo, text, (int)strlen(text), &direction, &ascent, &descent, &overall);
+      updateDirtyArea((int)(ip.get_u() / m_scale) + overall.lbearing, (int)(ip.get_v() / m_scale) - overall.ascent,
+                      overall.rbearing - overall.lbearing + 1, overall.ascent + overall.descent + 1);
+    } else {
+      updateDirtyArea(0, 0, (int)m_width, (int)m_height);
+    }
   } else {
     throw(vpDisplayException(vpDisplayException::notInitializedError, "X not initialized"));
   }
@@ -2512,6 +2581,8 @@ void vpDisplayX::displayCircle(const vpImagePoint &center, unsigned int radius,
                vpMath::round((center.get_v() - radius) / m_scale), radius * 2 / m_scale, radius * 2 / m_scale, 0,
                23040); /* 23040 = 360*64 */
     }
+    updateDirtyArea(vpImagePoint(center.get_i() - radius, center.get_j() - radius),
+                    vpImagePoint(center.get_i() + radius, center.get_j() + radius), thickness + 1);
   } else {
     throw(vpDisplayException(vpDisplayException::notInitializedError, "X not initialized"));
   }
@@ -2576,6 +2647,7 @@ void vpDisplayX::displayDotLine(const vpImagePoint &ip1, const vpImagePoint &ip2
 
     XDrawLine(display, pixmap, context, vpMath::round(ip1.get_u() / m_scale), vpMath::round(ip1.get_v() / m_scale),
               vpMath::round(ip2.get_u() / m_scale), vpMath::round(ip2.get_v() / m_scale));
+    updateDirtyArea(ip1, ip2, thickness + 1);
   } else {
     throw(vpDisplayException(vpDisplayException::notInitializedError, "X not initialized"));
   }
@@ -2609,6 +2681,7 @@ void vpDisplayX::displayLine(const vpImagePoint &ip1, const vpImagePoint &ip2, c
 
     XDrawLine(display, pixmap, context, vpMath::round(ip1.get_u() / m_scale), vpMath::round(ip1.get_v() / m_scale),
               vpMath::round(ip2.get_u() / m_scale), vpMath::round(ip2.get_v() / m_scale));
+    updateDirtyArea(ip1, ip2, thickness + 1);
   } else {
     throw(vpDisplayException(vpDisplayException::notInitializedError, "X not initialized"));
   }
@@ -2641,6 +2714,7 @@ void vpDisplayX::displayPoint(const vpImagePoint &ip, const vpColor &color, unsi
                      thickness, thickness);
     }
 
+    updateDirtyArea(ip, ip, thickness + 1);
   } else {
     throw(vpDisplayException(vpDisplayException::notInitializedError, "X not initialized"));
   }
@@ -2683,6 +2757,7 @@ void vpDisplayX::displayRectangle(const vpImagePoint &topLeft, unsigned int w, u
       XFillRectangle(display, pixmap, context, vpMath::round(topLeft.get_u() / m_scale),
                      vpMath::round(topLeft.get_v() / m_scale), w / m_scale, h / m_scale);
     }
+    updateDirtyArea(topLeft, vpImagePoint(topLeft.get_i() + h, topLeft.get_j() + w), thickness + 1);
   } else {
     throw(vpDisplayException(vpDisplayException::notInitializedError, "X not initialized"));
   }
@@ -2735,6 +2810,7 @@ void vpDisplayX::displayRectangle(const vpImagePoint &topLeft, const vpImagePoin
                      vpMath::round(topLeft_.get_v() < bottomRight_.get_v() ? topLeft_.get_v() : bottomRight_.get_v()),
                      w, h);
     }
+    updateDirtyArea(topLeft, bottomRight, thickness + 1);
   } else {
     throw(vpDisplayException(vpDisplayException::notInitializedError, "X not initialized"));
   }
@@ -2782,6 +2858,7 @@ void vpDisplayX::displayRectangle(const vpRect &rectangle, const vpColor &color,
                      (unsigned int)vpMath::round(rectangle.getHeight() / m_scale));
     }
 
+    updateDirtyArea(rectangle.getTopLeft(), rectangle.getBottomRight(), thickness + 1);
   } else {
     throw(vpDisplayException(vpDisplayException::notInitializedError, "X not initialized"));
   }
@@ -3316,6 +3393,155 @@ int vpDisplayX::getMsb(unsigned int u32val)
   return i;
 }
 
+/*!
+  Create the XImage used to upload the images to the pixmap. When the X
+  server supports the MIT-SHM extension, the image data is allocated in a
+  shared memory segment so that putImage() does not copy the pixels through
+  the X socket. Otherwise, or if the segment cannot be attached (remote
+  display), the data is allocated in the client memory.
+*/
+void vpDisplayX::createImage()
+{
+  m_useShm = false;
+#ifdef VISP_HAVE_X11_XSHM
+  if (XShmQueryExtension(display)) {
+    Ximage = XShmCreateImage(display, DefaultVisual(display, screen), screen_depth, ZPixmap, NULL, &m_shmInfo, m_width,
+                             m_height);
+    if (Ximage != NULL) {
+      m_shmInfo.shmid = shmget(IPC_PRIVATE, m_height * (unsigned int)Ximage->bytes_per_line, IPC_CREAT | 0600);
+      if (m_shmInfo.shmid != -1) {
+        m_shmInfo.shmaddr = (char *)shmat(m_shmInfo.shmid, NULL, 0);
+        if (m_shmInfo.shmaddr != (char *)-1) {
+          Ximage->data = m_shmInfo.shmaddr;
+          m_shmInfo.readOnly = False;
+
+          // Attaching fails with a remote X server: catch the error instead
+          // of letting the default handler exit
+          XSync(display, False);
+          shmAttachFailed = false;
+          XErrorHandler handler = XSetErrorHandler(shmErrorHandler);
+          XShmAttach(display, &m_shmInfo);
+          XSync(display, False);
+          XSetErrorHandler(handler);
+          m_useShm = !shmAttachFailed;
+
+          if (!m_useShm)
+            shmdt(m_shmInfo.shmaddr);
+        }
+        // The segment is released once detached by both the client and the
+        // server
+        shmctl(m_shmInfo.shmid, IPC_RMID, NULL);
+      }
+
+      if (!m_useShm) {
+        Ximage->data = NULL;
+        XDestroyImage(Ximage);
+      }
+    }
+  }
+#endif
+
+  if (m_useShm) {
+    ximage_data_init = false;
+  } else {
+    Ximage = XCreateImage(display, DefaultVisual(display, screen), screen_depth, ZPixmap, 0, NULL, m_width, m_height,
+                          XBitmapPad(display), 0);
+
+    Ximage->data = (char *)malloc(m_height * (unsigned int)Ximage->bytes_per_line);
+    ximage_data_init = true;
+  }
+
+  updateDirtyArea(0, 0, (int)m_width, (int)m_height);
+}
+
+/*!
+  Release the XImage created by createImage().
+*/
+void vpDisplayX::destroyImage()
+{
+#ifdef VISP_HAVE_X11_XSHM
+  if (m_useShm) {
+    XShmDetach(display, &m_shmInfo);
+    XSync(display, False);
+    shmdt(m_shmInfo.shmaddr);
+    m_useShm = false;
+  }
+#endif
+  if (ximage_data_init == true)
+    free(Ximage->data);
+
+  Ximage->data = NULL;
+  XDestroyImage(Ximage);
+  Ximage = NULL;
+}
+
+/*!
+  Upload a part of the XImage to the pixmap.
+
+  \param x, y : Top left corner of the area in the display.
+  \param w, h : Size of the area.
+*/
+void vpDisplayX::putImage(int x, int y, unsigned int w, unsigned int h)
+{
+#ifdef VISP_HAVE_X11_XSHM
+  if (m_useShm) {
+    XShmPutImage(display, pixmap, context, Ximage, x, y, x, y, w, h, False);
+    // The server reads the segment asynchronously: wait until it is done
+    // before the data can be modified by the next displayImage() call
+    XSync(display, False);
+  } else
+#endif
+  {
+    XPutImage(display, pixmap, context, Ximage, x, y, x, y, w, h);
+  }
+  updateDirtyArea(x, y, (int)w, (int)h);
+}
+
+/*!
+  Extend the area of the window to refresh by the next flushDisplay().
+
+  \param x, y : Top left corner of the area in the display.
+  \param w, h : Size of the area.
+*/
+void vpDisplayX::updateDirtyArea(int x, int y, int w, int h)
+{
+  int left = (std::max)(x, 0);
+  int top = (std::max)(y, 0);
+  int right = (std::min)(x + w, (int)m_width);
+  int bottom = (std::min)(y + h, (int)m_height);
+  if (right <= left || bottom <= top)
+    return;
+
+  if (m_dirtyRight > m_dirtyLeft && m_dirtyBottom > m_dirtyTop) {
+    m_dirtyLeft = (std::min)(m_dirtyLeft, left);
+    m_dirtyTop = (std::min)(m_dirtyTop, top);
+    m_dirtyRight = (std::max)(m_dirtyRight, right);
+    m_dirtyBottom = (std::max)(m_dirtyBottom, bottom);
+  } else {
+    m_dirtyLeft = left;
+    m_dirtyTop = top;
+    m_dirtyRight = right;
+    m_dirtyBottom = bottom;
+  }
+}
+
+/*!
+  Extend the area of the window to refresh by the next flushDisplay() with
+  the bounding box of two image points.
+
+  \param ip1, ip2 : Image points.
+  \param margin : Margin in pixels added around the bounding box, to take
+  the thickness of the drawings into account.
+*/
+void vpDisplayX::updateDirtyArea(const vpImagePoint &ip1, const vpImagePoint &ip2, unsigned int margin)
+{
+  int left = vpMath::round((std::min)(ip1.get_u(), ip2.get_u()) / m_scale) - (int)margin;
+  int top = vpMath::round((std::min)(ip1.get_v(), ip2.get_v()) / m_scale) - (int)margin;
+  int right = vpMath::round((std::max)(ip1.get_u(), ip2.get_u()) / m_scale) + (int)margin + 1;
+  int bottom = vpMath::round((std::max)(ip1.get_v(), ip2.get_v()) / m_scale) + (int)margin + 1;
+  updateDirtyArea(left, top, right - left, bottom - top);
+}
+
 #elif !defined(VISP_BUILD_SHARED_LIBS)
 // Work arround to avoid warning: libvisp_core.a(vpDisplayX.cpp.o) has no
 // symbols
@@ -40,7 +40,7 @@
 
 #if defined(VISP_HAVE_DISPLAY)
 #include <fstream>
-#include <list>
+#include <deque>
 #include <vector>
 #include <visp3/core/vpMath.h>
 #include <visp3/core/vpMeterPixelConversion.h>
@@ -288,6 +288,35 @@ void vpPlot::plot(const unsigned int graphNum, const unsigned int curveNum, cons
   (graphList + graphNum)->plot(I, curveNum, x, y);
 }
 
+/*!
+  This function enables you to add a batch of new points in a curve. Compared
+  to successive calls to plot(const unsigned int, const unsigned int, const
+  double, const double), the display is updated only once, and only for the
+  new segments unless the graphic has to be rescaled.
+
+  \param graphNum : The index of the graph in the window. As the number of
+  graphic in a window is less or equal to 4, this parameter is between 0
+  and 3.
+  \param curveNum : The index of the curve in the list of the curves
+  belonging to the graphic.
+  \param v_x : Coordinates of the new points along the x axis, given in the
+  user unit system.
+  \param v_y : Coordinates of the new points along the y axis, given in the
+  user unit system.
+
+  \exception vpException::dimensionError : If \e v_x and \e v_y have not the
+  same size.
+*/
+void vpPlot::plotBatch(const unsigned int graphNum, const unsigned int curveNum, const vpColVector &v_x,
+                       const vpColVector &v_y)
+{
+  if (v_x.size() != v_y.size()) {
+    throw(vpException(vpException::dimensionError, "Cannot plot %d x values with %d y values", v_x.size(),
+                      v_y.size()));
+  }
+  (graphList + graphNum)->plot(I, curveNum, v_x, v_y);
+}
+
 /*!
   This function enables you to add new points in all curves of a plot. These
   points are drawn with the parameters of the curves.
@@ -563,6 +592,40 @@ void vpPlot::resetPointList(const unsigned int graphNum)
     (graphList + graphNum)->resetPointList(i);
 }
 
+/*!
+  Limit the number of points stored for a curve. Once the limit is reached,
+  each new point replaces the oldest one, so that the memory used and the
+  time needed to redraw the curve do not grow with the duration of the plot.
+
+  \param graphNum : The index of the graph in the window. As the number of
+  graphic in a window is less or equal to 4, this parameter is between 0
+  and 3.
+  \param curveNum : The index of the curve in the list of the curves
+  belonging to the graphic.
+  \param maxNbPoints : Maximum number of points kept for the curve. 0, the
+  default, means no limit.
+*/
+void vpPlot::setMaxNbPoints(const unsigned int graphNum, const unsigned int curveNum, const unsigned int maxNbPoints)
+{
+  (graphList + graphNum)->setCurveMaxNbPoint(curveNum, maxNbPoints);
+}
+
+/*!
+  Limit the number of points stored for all the curves of a graphic, see
+  setMaxNbPoints(const unsigned int, const unsigned int, const unsigned int).
+
+  \param graphNum : The index of the graph in the window. As the number of
+  graphic in a window is less or equal to 4, this parameter is between 0
+  and 3.
+  \param maxNbPoints : Maximum number of points kept for each curve. 0, the
+  default, means no limit.
+*/
+void vpPlot::setMaxNbPoints(const unsigned int graphNum, const unsigned int maxNbPoints)
+{
+  for (unsigned int curveNum = 0; curveNum < (graphList + graphNum)->curveNbr; curveNum++)
+    (graphList + graphNum)->setCurveMaxNbPoint(curveNum, maxNbPoints);
+}
+
 /*!
 This function enables you to choose the thickness used to draw a given curve.
 
@@ -652,9 +715,9 @@ void vpPlot::saveData(const unsigned int graphNum, const std::string &dataFile,
   double *p = new double[3];
   bool end = false;
 
-  std::vector<std::list<double>::const_iterator> vec_iter_pointListx((graphList + graphNum)->curveNbr);
-  std::vector<std::list<double>::const_iterator> vec_iter_pointListy((graphList + graphNum)->curveNbr);
-  std::vector<std::list<double>::const_iterator> vec_iter_pointListz((graphList + graphNum)->curveNbr);
+  std::vector<std::deque<double>::const_iterator> vec_iter_pointListx((graphList + graphNum)->curveNbr);
+  std::vector<std::deque<double>::const_iterator> vec_iter_pointListy((graphList + graphNum)->curveNbr);
+  std::vector<std::deque<double>::const_iterator> vec_iter_pointListz((graphList + graphNum)->curveNbr);
 
   fichier << title_prefix << (graphList + graphNum)->title << std::endl;
 
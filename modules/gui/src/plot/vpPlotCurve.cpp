@@ -46,10 +46,14 @@
 #include <visp3/gui/vpDisplayX.h>
 #include <visp3/gui/vpPlotCurve.h>
 
+#include <visp3/core/vpMath.h>
+
+#include <algorithm>
+
 #if defined(VISP_HAVE_DISPLAY)
 vpPlotCurve::vpPlotCurve()
-  : color(vpColor::red), curveStyle(point), thickness(1), nbPoint(0), lastPoint(), pointListx(), pointListy(),
-    pointListz(), legend(), xmin(0), xmax(0), ymin(0), ymax(0)
+  : color(vpColor::red), curveStyle(point), thickness(1), nbPoint(0), maxNbPoint(0), lastPoint(), pointListx(),
+    pointListy(), pointListz(), legend(), xmin(0), xmax(0), ymin(0), ymax(0)
 {
 }
 
@@ -60,11 +64,34 @@ vpPlotCurve::~vpPlotCurve()
   pointListz.clear();
 }
 
-void vpPlotCurve::plotPoint(const vpImage<unsigned char> &I, const vpImagePoint &iP, const double x, const double y)
+void vpPlotCurve::addPoint(const double x, const double y, const double z)
 {
-  nbPoint++;
+  pointListx.push_back(x);
+  pointListy.push_back(y);
+  pointListz.push_back(z);
+  if (maxNbPoint > 0 && pointListx.size() > maxNbPoint) {
+    pointListx.pop_front();
+    pointListy.pop_front();
+    pointListz.pop_front();
+  }
+  nbPoint = (unsigned int)pointListx.size();
+}
 
-  if (nbPoint > 1) {
+void vpPlotCurve::setMaxNbPoint(const unsigned int maxNb)
+{
+  maxNbPoint = maxNb;
+  if (maxNbPoint > 0 && pointListx.size() > maxNbPoint) {
+    size_t nbToRemove = pointListx.size() - maxNbPoint;
+    pointListx.erase(pointListx.begin(), pointListx.begin() + (std::ptrdiff_t)nbToRemove);
+    pointListy.erase(pointListy.begin(), pointListy.begin() + (std::ptrdiff_t)nbToRemove);
+    pointListz.erase(pointListz.begin(), pointListz.begin() + (std::ptrdiff_t)nbToRemove);
+    nbPoint = maxNbPoint;
+  }
+}
+
+void vpPlotCurve::plotPoint(const vpImage<unsigned char> &I, const vpImagePoint &iP, const double x, const double y)
+{
+  if (nbPoint > 0) {
     vpDisplay::displayLine(I, lastPoint, iP, color, thickness);
   }
 #if defined(VISP_HAVE_DISPLAY)
@@ -90,24 +117,44 @@ void vpPlotCurve::plotPoint(const vpImage<unsigned char> &I, const vpImagePoint
   vpDisplay::flushROI(I, vpRect(left, top, width, height));
 #endif
   lastPoint = iP;
-  pointListx.push_back(x);
-  pointListy.push_back(y);
-  pointListz.push_back(0.0);
+  addPoint(x, y, 0.0);
 }
 
+/*
+  Draw the points of the curve starting from index first. Consecutive points
+  that fall in the same pixel column are drawn as a single vertical segment
+  between their extreme values, so that the number of drawn segments is
+  bounded by the graph width and not by the number of points.
+*/
 void vpPlotCurve::plotList(const vpImage<unsigned char> &I, const double xorg, const double yorg, const double zoomx,
-                           const double zoomy)
+                           const double zoomy, const unsigned int first)
 {
-  std::list<double>::const_iterator it_ptListx = pointListx.begin();
-  std::list<double>::const_iterator it_ptListy = pointListy.begin();
+  if (first >= nbPoint)
+    return;
 
-  unsigned int k = 0;
+  std::deque<double>::const_iterator it_ptListx = pointListx.begin() + (std::ptrdiff_t)first;
+  std::deque<double>::const_iterator it_ptListy = pointListy.begin() + (std::ptrdiff_t)first;
+
+  unsigned int k = first;
   vpImagePoint iP;
+  int column = 0;
+  double i_min = 0, i_max = 0;
   while (k < nbPoint) {
     iP.set_ij(yorg - (zoomy * (*it_ptListy)), xorg + (zoomx * (*it_ptListx)));
+    int j = vpMath::round(iP.get_j());
 
-    if (k > 0)
-      vpDisplay::displayLine(I, lastPoint, iP, color, thickness);
+    if (k > first && j == column) {
+      i_min = (std::min)(i_min, iP.get_i());
+      i_max = (std::max)(i_max, iP.get_i());
+    } else {
+      if (k > first) {
+        if (i_max > i_min)
+          vpDisplay::displayLine(I, vpImagePoint(i_min, column), vpImagePoint(i_max, column), color, thickness);
+        vpDisplay::displayLine(I, lastPoint, iP, color, thickness);
+      }
+      column = j;
+      i_min = i_max = iP.get_i();
+    }
 
     lastPoint = iP;
 
@@ -115,6 +162,9 @@ void vpPlotCurve::plotList(const vpImage<unsigned char> &I, const double xorg, c
     ++it_ptListy;
     k++;
   }
+
+  if (i_max > i_min)
+    vpDisplay::displayLine(I, vpImagePoint(i_min, column), vpImagePoint(i_max, column), color, thickness);
 }
 
 #elif !defined(VISP_BUILD_SHARED_LIBS)
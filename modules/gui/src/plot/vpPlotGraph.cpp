@@ -243,6 +243,11 @@ void vpPlotGraph::setLegend(const unsigned int curveNum, const std::string &newl
   dispLegend = true;
 }
 
+void vpPlotGraph::setCurveMaxNbPoint(const unsigned int curveNum, const unsigned int maxNbPoint)
+{
+  (curveList + curveNum)->setMaxNbPoint(maxNbPoint);
+}
+
 void vpPlotGraph::setCurveThickness(const unsigned int curveNum, const unsigned int thickness)
 {
   (curveList + curveNum)->thickness = thickness;
@@ -548,6 +553,48 @@ void vpPlotGraph::plot(vpImage<unsigned char> &I, const unsigned int curveNb, co
 #endif
 }
 
+void vpPlotGraph::plot(vpImage<unsigned char> &I, const unsigned int curveNb, const vpColVector &x,
+                       const vpColVector &y)
+{
+  if (x.size() == 0)
+    return;
+
+  // The first point handles the scale initialization
+  plot(I, curveNb, x[0], y[0]);
+
+  vpPlotCurve *curve = curveList + curveNb;
+  bool rescaled = false;
+  for (unsigned int k = 1; k < x.size(); k++) {
+    vpImagePoint iP(yorg - (zoomy * y[k]), xorg + (zoomx * x[k]));
+
+    if (!iP.inRectangle(dGraphZone)) {
+      if (x[k] > xmax)
+        rescalex(1, x[k]);
+      else if (x[k] < xmin)
+        rescalex(0, x[k]);
+
+      if (y[k] > ymax)
+        rescaley(1, y[k]);
+      else if (y[k] < ymin)
+        rescaley(0, y[k]);
+
+      computeGraphParameters();
+      rescaled = true;
+    }
+
+    curve->addPoint(x[k], y[k], 0.0);
+  }
+
+  if (rescaled) {
+    replot(I);
+  } else {
+    // Only draw the new segments, starting from the last previous point
+    unsigned int nbNew = x.size() - 1;
+    curve->plotList(I, xorg, yorg, zoomx, zoomy, curve->nbPoint > nbNew ? curve->nbPoint - nbNew - 1 : 0);
+    vpDisplay::flushROI(I, graphZone);
+  }
+}
+
 void vpPlotGraph::replot(vpImage<unsigned char> &I)
 {
   clearGraphZone(I);
@@ -1157,10 +1204,7 @@ vpMouseButton::vpMouseButtonType vpPlotGraph::plot(vpImage<unsigned char> &I, co
 #endif
 
   (curveList + curveNb)->lastPoint = iP;
-  (curveList + curveNb)->pointListx.push_back(x);
-  (curveList + curveNb)->pointListy.push_back(y);
-  (curveList + curveNb)->pointListz.push_back(z);
-  (curveList + curveNb)->nbPoint++;
+  (curveList + curveNb)->addPoint(x, y, z);
 
 #if (!defined VISP_HAVE_X11 && defined FLUSH_ON_PLOT)
   vpDisplay::flushROI(I, graphZone);
@@ -1174,9 +1218,9 @@ void vpPlotGraph::replot3D(vpImage<unsigned char> &I)
   displayGrid3D(I);
 
   for (unsigned int i = 0; i < curveNbr; i++) {
-    std::list<double>::const_iterator it_ptListx = (curveList + i)->pointListx.begin();
-    std::list<double>::const_iterator it_ptListy = (curveList + i)->pointListy.begin();
-    std::list<double>::const_iterator it_ptListz = (curveList + i)->pointListz.begin();
+    std::deque<double>::const_iterator it_ptListx = (curveList + i)->pointListx.begin();
+    std::deque<double>::const_iterator it_ptListy = (curveList + i)->pointListy.begin();
+    std::deque<double>::const_iterator it_ptListz = (curveList + i)->pointListz.begin();
 
     unsigned int k = 0;
     vpImagePoint iP;
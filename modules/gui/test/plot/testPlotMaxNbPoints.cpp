@@ -0,0 +1,162 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the limit of the number of points stored by the curves of vpPlot.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testPlotMaxNbPoints.cpp
+
+  Check that the curves of vpPlot keep at most the number of points given
+  with setMaxNbPoints(), the oldest points being dropped first, when the
+  points are added one by one or by batch. The points are stored without
+  any display.
+*/
+
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_DISPLAY)
+
+#include <visp3/gui/vpPlotGraph.h>
+
+namespace
+{
+// Check that the curve stores the points (x, 10 x, z) for x from first to
+// last, z being 0 if zeroZ is true, -x otherwise
+bool checkCurve(const vpPlotCurve &curve, unsigned int first, unsigned int last, bool zeroZ)
+{
+  const unsigned int nbPoint = last - first + 1;
+  if (curve.nbPoint != nbPoint || curve.pointListx.size() != nbPoint || curve.pointListy.size() != nbPoint ||
+      curve.pointListz.size() != nbPoint) {
+    std::cerr << "Curve with " << curve.nbPoint << " points instead of " << nbPoint << std::endl;
+    return false;
+  }
+  for (unsigned int k = 0; k < nbPoint; k++) {
+    const double x = first + k;
+    if (curve.pointListx[k] != x || curve.pointListy[k] != 10 * x || curve.pointListz[k] != (zeroZ ? 0 : -x)) {
+      std::cerr << "Point " << k << " is (" << curve.pointListx[k] << ", " << curve.pointListy[k] << ", "
+                << curve.pointListz[k] << ") instead of (" << x << ", " << 10 * x << ", " << (zeroZ ? 0 : -x) << ")"
+                << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Samples (x, 10 x) for x from first to last
+void buildBatch(unsigned int first, unsigned int last, vpColVector &x, vpColVector &y)
+{
+  x.resize(last - first + 1);
+  y.resize(last - first + 1);
+  for (unsigned int k = 0; k < x.size(); k++) {
+    x[k] = first + k;
+    y[k] = 10 * x[k];
+  }
+}
+}
+
+int main()
+{
+  try {
+    // Storage of a curve
+    {
+      vpPlotCurve curve;
+      curve.setMaxNbPoint(3);
+      for (unsigned int k = 0; k < 7; k++)
+        curve.addPoint(k, 10 * k, -(double)k);
+      if (!checkCurve(curve, 4, 6, false))
+        return EXIT_FAILURE;
+
+      // Lowering the limit drops the oldest points
+      curve.setMaxNbPoint(2);
+      if (!checkCurve(curve, 5, 6, false))
+        return EXIT_FAILURE;
+
+      // No limit
+      curve.setMaxNbPoint(0);
+      for (unsigned int k = 7; k < 9; k++)
+        curve.addPoint(k, 10 * k, -(double)k);
+      if (!checkCurve(curve, 5, 8, false))
+        return EXIT_FAILURE;
+    }
+
+    // Points added to a graphic one by one and by batch, as vpPlot::plot()
+    // and vpPlot::plotBatch() do, the image having no display
+    {
+      vpImage<unsigned char> I(700, 700);
+      vpPlotGraph graph;
+      graph.initSize(vpImagePoint(0, 0), 700, 700, 30, 40);
+      graph.initGraph(2);
+      graph.setCurveMaxNbPoint(0, 5);
+
+      for (unsigned int k = 1; k <= 8; k++) {
+        graph.plot(I, 0, k, 10. * k);
+        graph.plot(I, 1, k, 10. * k);
+      }
+      if (!checkCurve(graph.curveList[0], 4, 8, true) || !checkCurve(graph.curveList[1], 1, 8, true))
+        return EXIT_FAILURE;
+
+      // A batch smaller than the limit
+      vpColVector x, y;
+      buildBatch(9, 11, x, y);
+      graph.plot(I, 0, x, y);
+      graph.plot(I, 1, x, y);
+      if (!checkCurve(graph.curveList[0], 7, 11, true) || !checkCurve(graph.curveList[1], 1, 11, true))
+        return EXIT_FAILURE;
+
+      // A batch larger than the limit, that also rescales the graphic
+      buildBatch(12, 100, x, y);
+      graph.plot(I, 0, x, y);
+      graph.plot(I, 1, x, y);
+      if (!checkCurve(graph.curveList[0], 96, 100, true) || !checkCurve(graph.curveList[1], 1, 100, true))
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Test succeed" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const vpException &e) {
+    std::cout << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+}
+
+#else
+int main()
+{
+  std::cout << "This test needs a display to build vpPlot" << std::endl;
+  return EXIT_SUCCESS;
+}
+#endif
@@ -0,0 +1,146 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Write images with a pool of background threads.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpAsyncImageWriter.h
+  \brief Write images with a pool of background threads.
+*/
+
+#ifndef vpAsyncImageWriter_h
+#define vpAsyncImageWriter_h
+
+#include <deque>
+#include <string>
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpRGBa.h>
+
+/*!
+  \class vpAsyncImageWriter
+
+  \ingroup group_io_image
+
+  \brief Write images in files with a pool of background threads.
+
+  write() copies the image in one of the buffers of a bounded queue and
+  returns immediately. The images are encoded and written by up to
+  getNbThreads() threads with vpImageIo::write(), so that the caller, for
+  example a tracking loop that records its input, does not wait for the
+  encoding of the png or jpeg files. Since the file name is given with the
+  image, the files contain the images in the order of the calls to write()
+  even if they are encoded in parallel.
+
+  When all the buffers are used, the behavior depends on the policy:
+  - with vpAsyncImageWriter::BLOCK, the default, the caller writes a pending
+    image itself before queuing the new one. The caller is slowed down as
+    with a blocking queue and no image is lost.
+  - with vpAsyncImageWriter::DROP, the new image is dropped and write()
+    returns false, so that the caller is never slowed down. See
+    getNbDroppedImages().
+
+  flush() waits until all the queued images are written and reports the
+  errors that occurred in the background threads. Without thread support, the
+  images are written by write().
+
+  \code
+#include <visp3/io/vpAsyncImageWriter.h>
+
+int main()
+{
+  vpImage<unsigned char> I(480, 640);
+  vpAsyncImageWriter writer(2, 8);
+  char filename[FILENAME_MAX];
+  for (unsigned int i = 0; i < 100; i++) {
+    // acquire and process I
+    sprintf(filename, "/tmp/image%04d.png", i);
+    writer.write(I, filename);
+  }
+  writer.flush();
+}
+  \endcode
+
+  \sa vpImageIo, vpVideoWriter::setAsync()
+*/
+class VISP_EXPORT vpAsyncImageWriter
+{
+public:
+  //! Behavior of write() when the queue is full.
+  typedef enum {
+    BLOCK, //!< The caller writes a pending image, no image is lost.
+    DROP   //!< The new image is dropped.
+  } vpQueuePolicy;
+
+  explicit vpAsyncImageWriter(unsigned int nbThreads = 2, unsigned int queueSize = 8,
+                              const vpQueuePolicy &policy = BLOCK);
+  virtual ~vpAsyncImageWriter();
+
+  void flush();
+
+  unsigned int getNbDroppedImages() const;
+  //! Return the maximum number of threads that write the images.
+  inline unsigned int getNbThreads() const { return m_nbThreads; }
+  //! Return the behavior of write() when the queue is full.
+  inline vpQueuePolicy getPolicy() const { return m_policy; }
+  //! Return the maximum number of images waiting to be written.
+  inline unsigned int getQueueSize() const { return m_queueSize; }
+
+  void setNbThreads(unsigned int nbThreads);
+  void setPolicy(const vpQueuePolicy &policy);
+  void setQueueSize(unsigned int queueSize);
+
+  bool write(const vpImage<unsigned char> &I, const std::string &filename);
+  bool write(const vpImage<vpRGBa> &I, const std::string &filename);
+
+private:
+  vpAsyncImageWriter(const vpAsyncImageWriter &);
+  vpAsyncImageWriter &operator=(const vpAsyncImageWriter &);
+
+  class vpJob;
+  class vpWorker;
+  class vpPrivate;
+
+  vpJob *getFreeJob();
+  void push(vpJob *job);
+  void release();
+
+  unsigned int m_nbThreads;
+  unsigned int m_queueSize;
+  vpQueuePolicy m_policy;
+  vpPrivate *m_private;
+};
+
+#endif
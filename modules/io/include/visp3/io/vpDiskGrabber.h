@@ -44,6 +44,7 @@
 #define vpDiskGrabber_hh
 
 #include <string>
+#include <vector>
 
 #include <visp3/core/vpDebug.h>
 #include <visp3/core/vpFrameGrabber.h>
@@ -103,6 +104,23 @@ int main(){
     g.acquire(I) ;
   }
 }
+\endcode
+
+  Since decoding compressed images (png, jpeg) is often slower than their
+  processing, the next images of the sequence can be read in advance on
+  background threads with setPrefetch(). The images are read in a ring of
+  preallocated buffers, so that the memory remains bounded, and are returned
+  in the order of the sequence. Changing the step, the image number or reading
+  a given image with acquire(I, image_number) is still possible: the images
+  that are no more needed are dropped and the reading restarts from the
+  requested one.
+
+\code
+  vpDiskGrabber g("/local/soft/ViSP/ViSP-images/cube/image.%04d.png");
+  g.setPrefetch(4); // Read up to 4 images in advance
+  g.open(I);
+  while (...)
+    g.acquire(I);
 \endcode
 */
 class VISP_EXPORT vpDiskGrabber : public vpFrameGrabber
@@ -121,11 +139,16 @@ private:
   bool m_use_generic_name;
   std::string m_generic_name;
 
+  class vpPrefetchSlot;
+  unsigned int m_prefetch_size;                 //!< number of images read in advance
+  std::vector<vpPrefetchSlot *> m_prefetch_ring; //!< buffers of the images read in advance
+
 public:
   vpDiskGrabber();
   explicit vpDiskGrabber(const std::string &genericName);
   explicit vpDiskGrabber(const std::string &dir, const std::string &basename, long number, int step, unsigned int noz,
                          const std::string &ext);
+  vpDiskGrabber(const vpDiskGrabber &grabber);
   virtual ~vpDiskGrabber();
 
   void acquire(vpImage<unsigned char> &I);
@@ -142,17 +165,32 @@ public:
   */
   long getImageNumber() { return m_image_number; };
 
+  /*!
+    Return the number of images read in advance.
+
+    \sa setPrefetch()
+  */
+  unsigned int getPrefetch() const { return m_prefetch_size; }
+
   void open(vpImage<unsigned char> &I);
   void open(vpImage<vpRGBa> &I);
   void open(vpImage<float> &I);
 
+  vpDiskGrabber &operator=(const vpDiskGrabber &grabber);
+
   void setBaseName(const std::string &name);
   void setDirectory(const std::string &dir);
   void setExtension(const std::string &ext);
   void setGenericName(const std::string &genericName);
   void setImageNumber(long number);
   void setNumberOfZero(unsigned int noz);
+  void setPrefetch(unsigned int nbImages);
   void setStep(long step);
+
+private:
+  std::string getImageName(long image_number) const;
+  vpPrefetchSlot *prefetch(long image_number, bool color);
+  void releasePrefetch();
 };
 
 #endif
@@ -0,0 +1,156 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Read a log of raw frames.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpFrameLogReader.h
+  \brief Read a log of raw frames.
+*/
+
+#ifndef vpFrameLogReader_h
+#define vpFrameLogReader_h
+
+#include <string>
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpMappedFile.h>
+#include <visp3/core/vpRGBa.h>
+
+/*!
+  \class vpFrameLogReader
+
+  \ingroup group_io_video
+
+  \brief Read a frame log written by vpFrameLogWriter.
+
+  A frame log (.vplog) is a binary file holding a sequence of raw frames,
+  vpImage<unsigned char>, vpImage<vpRGBa>, vpImage<uint16_t> (typically depth
+  maps) or vpImage<float>, each one with its timestamp. Since the frames are
+  neither encoded nor compressed, they are written at the speed of the disk
+  and read without any decoding.
+
+  The file is mapped in memory with vpMappedFile, so that opening a log is
+  immediate, and getFrame() with \e copyData set to false returns an image
+  that points on the mapped data without any copy. Such an image remains
+  valid until the log is closed. The mapping is private: modifying the image
+  does not modify the file.
+
+  The index of the frames is written at the end of the log when it is closed.
+  A log that was not closed, for example after a crash, is still readable:
+  its frames are found by going through the file.
+
+  The frame logs can also be read with vpVideoReader and written with
+  vpVideoWriter, using the ".vplog" extension.
+
+  \code
+#include <visp3/io/vpFrameLogReader.h>
+
+int main()
+{
+  vpFrameLogReader reader("/tmp/capture.vplog");
+  vpImage<uint16_t> I_depth;
+  for (unsigned int i = 0; i < reader.getNbFrames(); i++) {
+    if (reader.getFrameType(i) == vpFrameLogReader::FRAME_UINT16) {
+      reader.getFrame(i, I_depth, false); // No copy
+      double t = reader.getTimestamp(i);
+      // ...
+    }
+  }
+}
+  \endcode
+
+  \sa vpFrameLogWriter
+*/
+class VISP_EXPORT vpFrameLogReader
+{
+  friend class vpFrameLogWriter;
+
+public:
+  //! Type of the pixels of a frame.
+  typedef enum {
+    FRAME_UCHAR,  //!< vpImage<unsigned char>
+    FRAME_RGBA,   //!< vpImage<vpRGBa>
+    FRAME_UINT16, //!< vpImage<uint16_t>
+    FRAME_FLOAT   //!< vpImage<float>
+  } vpFrameType;
+
+  vpFrameLogReader();
+  explicit vpFrameLogReader(const std::string &filename);
+  virtual ~vpFrameLogReader();
+
+  void close();
+
+  void getFrame(unsigned int index, vpImage<unsigned char> &I, bool copyData = true);
+  void getFrame(unsigned int index, vpImage<vpRGBa> &I, bool copyData = true);
+  void getFrame(unsigned int index, vpImage<uint16_t> &I, bool copyData = true);
+  void getFrame(unsigned int index, vpImage<float> &I, bool copyData = true);
+  vpFrameType getFrameType(unsigned int index) const;
+  unsigned int getHeight(unsigned int index) const;
+  //! Return the number of frames of the log.
+  inline unsigned int getNbFrames() const { return (unsigned int)m_frames.size(); }
+  double getTimestamp(unsigned int index) const;
+  unsigned int getWidth(unsigned int index) const;
+
+  //! Return true if a log is open.
+  inline bool isOpen() const { return m_file.isOpen(); }
+
+  void open(const std::string &filename);
+
+private:
+  vpFrameLogReader(const vpFrameLogReader &);
+  vpFrameLogReader &operator=(const vpFrameLogReader &);
+
+  struct vpFrame {
+    size_t offset;
+    vpFrameType type;
+    unsigned int width;
+    unsigned int height;
+    double timestamp;
+  };
+
+  const vpFrame &getFrameInfo(unsigned int index) const;
+  template <class Type> void getRawFrame(unsigned int index, vpImage<Type> &I, vpFrameType type, bool copyData);
+  bool readFrameHeader(size_t offset, vpFrame &frame) const;
+
+  vpMappedFile m_file;
+  std::vector<vpFrame> m_frames;
+  //! Offset of the end of the last frame, where new frames can be appended
+  size_t m_endOffset;
+  //! Byte order of the multi-byte pixels
+  bool m_bigEndian;
+};
+
+#endif
@@ -0,0 +1,125 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Write a log of raw frames.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpFrameLogWriter.h
+  \brief Write a log of raw frames.
+*/
+
+#ifndef vpFrameLogWriter_h
+#define vpFrameLogWriter_h
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpRGBa.h>
+
+/*!
+  \class vpFrameLogWriter
+
+  \ingroup group_io_video
+
+  \brief Write raw frames with their timestamp in a frame log (.vplog).
+
+  Each frame is appended to the file as a 64 bytes header, with the type, the
+  size and the timestamp of the frame, followed by the raw pixels, aligned on
+  64 bytes. Since there is no encoding, the frames are written at the speed
+  of the disk, which allows for example to record RGB-D streams at high rate.
+  The index of the frames is written by close().
+
+  The log is read with vpFrameLogReader. The frame logs can also be written
+  with vpVideoWriter, using the ".vplog" extension.
+
+  \code
+#include <visp3/core/vpTime.h>
+#include <visp3/io/vpFrameLogWriter.h>
+
+int main()
+{
+  vpImage<vpRGBa> I_color(480, 640);
+  vpImage<uint16_t> I_depth(480, 640);
+  vpFrameLogWriter writer("/tmp/capture.vplog");
+  for (unsigned int i = 0; i < 100; i++) {
+    // acquire I_color and I_depth
+    double t = vpTime::measureTimeSecond();
+    writer.write(I_color, t);
+    writer.write(I_depth, t);
+  }
+  writer.close();
+}
+  \endcode
+
+  \sa vpFrameLogReader
+*/
+class VISP_EXPORT vpFrameLogWriter
+{
+public:
+  vpFrameLogWriter();
+  explicit vpFrameLogWriter(const std::string &filename, bool append = false);
+  virtual ~vpFrameLogWriter();
+
+  void close();
+
+  //! Return the number of frames of the log.
+  inline unsigned int getNbFrames() const { return (unsigned int)m_offsets.size(); }
+
+  //! Return true if a log is open.
+  inline bool isOpen() const { return m_file.is_open(); }
+
+  void open(const std::string &filename, bool append = false);
+
+  void write(const vpImage<unsigned char> &I, double timestamp);
+  void write(const vpImage<vpRGBa> &I, double timestamp);
+  void write(const vpImage<uint16_t> &I, double timestamp);
+  void write(const vpImage<float> &I, double timestamp);
+
+private:
+  vpFrameLogWriter(const vpFrameLogWriter &);
+  vpFrameLogWriter &operator=(const vpFrameLogWriter &);
+
+  void writeFrame(unsigned int type, unsigned int width, unsigned int height, double timestamp, const void *data,
+                  size_t size);
+
+  std::ofstream m_file;
+  std::string m_filename;
+  std::vector<uint64_t> m_offsets;
+  //! Offset of the next frame
+  uint64_t m_offset;
+};
+
+#endif
@@ -115,6 +115,9 @@ int main()
   This other example available in tutorial-image-reader.cpp shows how to
 read/write jpeg images. It supposes that \c libjpeg is installed. \include
 tutorial-image-reader.cpp
+
+  To write images without waiting for their encoding, for example to record
+the images of a live loop, use vpAsyncImageWriter.
 */
 
 class VISP_EXPORT vpImageIo
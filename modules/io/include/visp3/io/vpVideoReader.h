@@ -48,6 +48,7 @@
 #include <string>
 
 #include <visp3/io/vpDiskGrabber.h>
+#include <visp3/io/vpFrameLogReader.h>
 
 #if VISP_HAVE_OPENCV_VERSION >= 0x020200
 #include "opencv2/highgui/highgui.hpp"
@@ -81,6 +82,10 @@ image formats. OpenCV allows also to consider AVI, MPEG, MPEG4, MOV, OGV, WMV,
 FLV, MKV video formats. Installation instructions are provided here
 https://visp.inria.fr/3rd_opencv.
 
+  The frame logs (".vplog") written by vpVideoWriter or vpFrameLogWriter are
+  read without any decoding, see vpFrameLogReader. Their frames are indexed
+  from 0.
+
   The following example available in tutorial-video-reader.cpp shows how this
   class is really easy to use. It enables to read a video file named
 video.mpeg. \include tutorial-video-reader.cpp
@@ -173,6 +178,8 @@ class VISP_EXPORT vpVideoReader : public vpFrameGrabber
 private:
   //! To read sequences of images
   vpDiskGrabber *imSequence;
+  //! To read frame logs
+  vpFrameLogReader *frameLog;
 #if VISP_HAVE_OPENCV_VERSION >= 0x020100
   //! To read video files with OpenCV
   cv::VideoCapture capture;
@@ -200,6 +207,8 @@ private:
     FORMAT_WMV,
     FORMAT_FLV,
     FORMAT_MKV,
+    // Raw frame log
+    FORMAT_VPLOG,
     FORMAT_UNKNOWN
   } vpVideoFormatType;
 
@@ -223,6 +232,8 @@ private:
   //! The frame step
   long frameStep;
   double frameRate;
+  //! Number of images of a sequence read in advance
+  unsigned int prefetchSize;
 
   // private:
   //#ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -374,6 +385,7 @@ public:
   \sa setFrameStep()
 */
   inline void setFrameStep(const long frame_step) { this->frameStep = frame_step; }
+  void setPrefetch(unsigned int nbFrames);
 
 private:
   vpVideoFormatType getFormat(const char *filename);
@@ -46,6 +46,8 @@
 
 #include <string>
 
+#include <visp3/io/vpAsyncImageWriter.h>
+#include <visp3/io/vpFrameLogWriter.h>
 #include <visp3/io/vpImageIo.h>
 
 #if VISP_HAVE_OPENCV_VERSION >= 0x020200
@@ -79,6 +81,14 @@ these image formats. OpenCV allows also to consider AVI, MPEG, MPEG4, MOV,
 OGV, WMV, FLV, MKV video formats. Installation instructions are provided here
 https://visp.inria.fr/3rd_opencv.
 
+  With the ".vplog" extension, the raw frames are written with their
+  timestamp in a frame log, see vpFrameLogWriter. Since they are not encoded,
+  it is the fastest way to record a sequence.
+
+  When writing a sequence of images from a live loop, the encoding of the
+  images can be done by background threads with setAsync(), see
+  vpAsyncImageWriter.
+
   The following example available in tutorial-video-recorder.cpp shows how
 this class can be used to record a video from a camera by default in an mpeg
 file. \include tutorial-video-recorder.cpp
@@ -171,6 +181,7 @@ private:
     FORMAT_MPEG,
     FORMAT_MPEG4,
     FORMAT_MOV,
+    FORMAT_VPLOG,
     FORMAT_UNKNOWN
   } vpVideoFormatType;
 
@@ -196,6 +207,12 @@ private:
   unsigned int width;
   unsigned int height;
 
+  //! Writer of the image sequence in background threads
+  vpAsyncImageWriter *asyncWriter;
+
+  //! Writer of the raw frames
+  vpFrameLogWriter *frameLog;
+
 public:
   vpVideoWriter();
   ~vpVideoWriter();
@@ -208,6 +225,7 @@ public:
     \return Returns the current frame index.
   */
   inline unsigned int getCurrentFrameIndex() const { return frameCount; }
+  unsigned int getNbDroppedFrames() const;
 
   void open(vpImage<vpRGBa> &I);
   void open(vpImage<unsigned char> &I);
@@ -221,6 +239,9 @@ public:
   void saveFrame(vpImage<vpRGBa> &I);
   void saveFrame(vpImage<unsigned char> &I);
 
+  void setAsync(unsigned int nbThreads, unsigned int queueSize = 8,
+                const vpAsyncImageWriter::vpQueuePolicy &policy = vpAsyncImageWriter::BLOCK);
+
 #if VISP_HAVE_OPENCV_VERSION >= 0x020100
   inline void setCodec(const int fourcc_codec) { this->fourcc = fourcc_codec; }
 #endif
@@ -245,6 +266,9 @@ public:
 #endif
 
 private:
+  vpVideoWriter(const vpVideoWriter &);
+  vpVideoWriter &operator=(const vpVideoWriter &);
+
   vpVideoFormatType getFormat(const char *filename);
   static std::string getExtension(const std::string &filename);
 };
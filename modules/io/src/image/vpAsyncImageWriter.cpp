@@ -0,0 +1,431 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Write images with a pool of background threads.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpAsyncImageWriter.cpp
+  \brief Write images with a pool of background threads.
+*/
+
+#include <algorithm>
+
+#include <visp3/core/vpException.h>
+#include <visp3/io/vpAsyncImageWriter.h>
+#include <visp3/io/vpImageIo.h>
+
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+#include <visp3/core/vpMutex.h>
+#include <visp3/core/vpThread.h>
+#define VP_ASYNC_IMAGE_WRITER_THREADS
+#endif
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+#if defined(VP_ASYNC_IMAGE_WRITER_THREADS)
+typedef vpMutex vpWriterMutex;
+typedef vpMutex::vpScopedLock vpWriterLock;
+#else
+// Without threads there is nothing to protect
+class vpWriterMutex
+{
+};
+class vpWriterLock
+{
+public:
+  explicit vpWriterLock(vpWriterMutex &) {}
+};
+#endif
+}
+
+/*
+  Buffer of an image to write.
+*/
+class vpAsyncImageWriter::vpJob
+{
+public:
+  vpJob() : m_color(false), m_I(), m_Ic(), m_filename() {}
+
+  bool m_color;
+  vpImage<unsigned char> m_I;
+  vpImage<vpRGBa> m_Ic;
+  std::string m_filename;
+};
+
+/*
+  Thread that writes the queued images until the queue is empty.
+*/
+class vpAsyncImageWriter::vpWorker
+{
+public:
+  explicit vpWorker(vpAsyncImageWriter *writer) : m_writer(writer), m_thread(NULL), m_finished(false) {}
+  ~vpWorker()
+  {
+#if defined(VP_ASYNC_IMAGE_WRITER_THREADS)
+    delete m_thread;
+#endif
+  }
+
+#if defined(VP_ASYNC_IMAGE_WRITER_THREADS)
+  static vpThread::Return work(vpThread::Args args);
+#endif
+
+  vpAsyncImageWriter *m_writer;
+#if defined(VP_ASYNC_IMAGE_WRITER_THREADS)
+  vpThread *m_thread;
+#else
+  void *m_thread;
+#endif
+  bool m_finished;
+};
+
+/*
+  State shared with the threads.
+*/
+class vpAsyncImageWriter::vpPrivate
+{
+public:
+  vpPrivate()
+    : m_jobs(), m_free(), m_pending(), m_workers(), m_nbRunning(0), m_nbDropped(0), m_error(), m_errorCode(0),
+      m_mutex()
+  {
+  }
+
+  // Write the image of a job and put the job back in the free buffers
+  void run(vpJob *job)
+  {
+    std::string error;
+    int code = 0;
+    try {
+      if (job->m_color)
+        vpImageIo::write(job->m_Ic, job->m_filename);
+      else
+        vpImageIo::write(job->m_I, job->m_filename);
+    } catch (vpException &e) {
+      error = e.getStringMessage();
+      code = e.getCode();
+    } catch (...) {
+      error = "Cannot write file: " + job->m_filename;
+      code = vpException::ioError;
+    }
+
+    vpWriterLock lock(m_mutex);
+    if (!error.empty() && m_error.empty()) {
+      m_error = error;
+      m_errorCode = code;
+    }
+    m_free.push_back(job);
+  }
+
+  std::vector<vpJob *> m_jobs;       // all the buffers
+  std::vector<vpJob *> m_free;       // buffers available for write()
+  std::deque<vpJob *> m_pending;     // images to write, in the order of write()
+  std::vector<vpWorker *> m_workers; // only modified by the caller thread
+  unsigned int m_nbRunning;
+  unsigned int m_nbDropped;
+  std::string m_error; // first error of the threads
+  int m_errorCode;
+  vpWriterMutex m_mutex;
+};
+
+#if defined(VP_ASYNC_IMAGE_WRITER_THREADS)
+/*
+  Thread function: write the queued images until the queue is empty.
+*/
+vpThread::Return vpAsyncImageWriter::vpWorker::work(vpThread::Args args)
+{
+  vpWorker *worker = (vpWorker *)args;
+  vpPrivate *p = worker->m_writer->m_private;
+  for (;;) {
+    vpJob *job = NULL;
+    {
+      vpWriterLock lock(p->m_mutex);
+      if (p->m_pending.empty()) {
+        p->m_nbRunning--;
+        worker->m_finished = true;
+        return 0;
+      }
+      job = p->m_pending.front();
+      p->m_pending.pop_front();
+    }
+    p->run(job);
+  }
+}
+#endif
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Constructor.
+
+  \param nbThreads : Maximum number of threads that write the images. With 0,
+  the images are written by write().
+  \param queueSize : Maximum number of images waiting to be written, that is
+  the number of image buffers.
+  \param policy : Behavior of write() when the queue is full.
+*/
+vpAsyncImageWriter::vpAsyncImageWriter(unsigned int nbThreads, unsigned int queueSize, const vpQueuePolicy &policy)
+  : m_nbThreads(nbThreads), m_queueSize(std::max(queueSize, 1u)), m_policy(policy), m_private(new vpPrivate)
+{
+}
+
+/*!
+  Destructor that waits until all the queued images are written. The errors
+  are ignored, call flush() before to get them.
+*/
+vpAsyncImageWriter::~vpAsyncImageWriter()
+{
+  try {
+    flush();
+  } catch (...) {
+  }
+  release();
+  delete m_private;
+}
+
+/*!
+  Wait until all the queued images are written.
+
+  write() and flush() are expected to be called from the same thread.
+
+  \exception vpException : The first error that occurred while writing the
+  images since the previous call to flush(), for example
+  vpException::ioError if a file cannot be written.
+*/
+void vpAsyncImageWriter::flush()
+{
+  // The workers stop when the queue is empty, and only this thread queues
+  // images
+  for (size_t i = 0; i < m_private->m_workers.size(); i++) {
+#if defined(VP_ASYNC_IMAGE_WRITER_THREADS)
+    m_private->m_workers[i]->m_thread->join();
+#endif
+    delete m_private->m_workers[i];
+  }
+  m_private->m_workers.clear();
+
+  std::string error;
+  int code = 0;
+  {
+    vpWriterLock lock(m_private->m_mutex);
+    error.swap(m_private->m_error);
+    code = m_private->m_errorCode;
+  }
+  if (!error.empty()) {
+    throw(vpException(code, "%s", error.c_str()));
+  }
+}
+
+/*!
+  Return a buffer for a new image. When the queue is full, the caller writes
+  the oldest pending image with the BLOCK policy, or NULL is returned with the
+  DROP policy.
+*/
+vpAsyncImageWriter::vpJob *vpAsyncImageWriter::getFreeJob()
+{
+  for (;;) {
+    vpJob *pending = NULL;
+    {
+      vpWriterLock lock(m_private->m_mutex);
+      if (!m_private->m_free.empty()) {
+        vpJob *job = m_private->m_free.back();
+        m_private->m_free.pop_back();
+        return job;
+      }
+      if (m_private->m_jobs.size() < m_queueSize) {
+        m_private->m_jobs.push_back(new vpJob);
+        return m_private->m_jobs.back();
+      }
+      if (m_policy == DROP) {
+        m_private->m_nbDropped++;
+        return NULL;
+      }
+      if (!m_private->m_pending.empty()) {
+        pending = m_private->m_pending.front();
+        m_private->m_pending.pop_front();
+      }
+    }
+
+    if (pending != NULL) {
+      m_private->run(pending);
+    } else {
+      // All the images are being written: wait for the oldest worker, that
+      // stops after its current image since the queue is empty
+#if defined(VP_ASYNC_IMAGE_WRITER_THREADS)
+      m_private->m_workers.front()->m_thread->join();
+#endif
+      delete m_private->m_workers.front();
+      m_private->m_workers.erase(m_private->m_workers.begin());
+    }
+  }
+}
+
+/*!
+  Return the number of images dropped by write() since the construction,
+  with the DROP policy.
+*/
+unsigned int vpAsyncImageWriter::getNbDroppedImages() const
+{
+  vpWriterLock lock(m_private->m_mutex);
+  return m_private->m_nbDropped;
+}
+
+/*!
+  Queue a job and start a worker if less than getNbThreads() are running.
+*/
+void vpAsyncImageWriter::push(vpJob *job)
+{
+#if defined(VP_ASYNC_IMAGE_WRITER_THREADS)
+  if (m_nbThreads > 0) {
+    bool start = false;
+    {
+      vpWriterLock lock(m_private->m_mutex);
+      m_private->m_pending.push_back(job);
+      if (m_private->m_nbRunning < m_nbThreads) {
+        m_private->m_nbRunning++;
+        start = true;
+      }
+    }
+
+    if (start) {
+      // Release the workers that stopped
+      for (size_t i = 0; i < m_private->m_workers.size();) {
+        bool finished;
+        {
+          vpWriterLock lock(m_private->m_mutex);
+          finished = m_private->m_workers[i]->m_finished;
+        }
+        if (finished) {
+          m_private->m_workers[i]->m_thread->join();
+          delete m_private->m_workers[i];
+          m_private->m_workers.erase(m_private->m_workers.begin() + (long)i);
+        } else {
+          i++;
+        }
+      }
+
+      vpWorker *worker = new vpWorker(this);
+      m_private->m_workers.push_back(worker);
+      worker->m_thread = new vpThread(vpWorker::work, worker);
+    }
+    return;
+  }
+#endif
+  m_private->run(job);
+}
+
+/*!
+  Release the image buffers. The queue has to be empty.
+*/
+void vpAsyncImageWriter::release()
+{
+  for (size_t i = 0; i < m_private->m_jobs.size(); i++)
+    delete m_private->m_jobs[i];
+  m_private->m_jobs.clear();
+  m_private->m_free.clear();
+}
+
+/*!
+  Set the maximum number of threads that write the images. The queued images
+  are written before.
+
+  \param nbThreads : Number of threads. With 0, the images are written by
+  write().
+*/
+void vpAsyncImageWriter::setNbThreads(unsigned int nbThreads)
+{
+  flush();
+  m_nbThreads = nbThreads;
+}
+
+/*!
+  Set the behavior of write() when the queue is full.
+*/
+void vpAsyncImageWriter::setPolicy(const vpQueuePolicy &policy) { m_policy = policy; }
+
+/*!
+  Set the maximum number of images waiting to be written, that is the number
+  of image buffers. The queued images are written before.
+
+  \param queueSize : Size of the queue, at least 1.
+*/
+void vpAsyncImageWriter::setQueueSize(unsigned int queueSize)
+{
+  flush();
+  release();
+  m_queueSize = std::max(queueSize, 1u);
+}
+
+/*!
+  Queue the image \e I to be written in the file \e filename with
+  vpImageIo::write(). The image is copied and can be modified as soon as the
+  function returns.
+
+  \return false if the queue is full and the image is dropped with the DROP
+  policy, true otherwise.
+*/
+bool vpAsyncImageWriter::write(const vpImage<unsigned char> &I, const std::string &filename)
+{
+  vpJob *job = getFreeJob();
+  if (job == NULL)
+    return false;
+
+  job->m_color = false;
+  job->m_filename = filename;
+  job->m_I.resize(I.getHeight(), I.getWidth());
+  std::copy(I.bitmap, I.bitmap + I.getSize(), job->m_I.bitmap);
+  push(job);
+  return true;
+}
+
+/*!
+  Queue the color image \e I to be written in the file \e filename with
+  vpImageIo::write(). The image is copied and can be modified as soon as the
+  function returns.
+
+  \return false if the queue is full and the image is dropped with the DROP
+  policy, true otherwise.
+*/
+bool vpAsyncImageWriter::write(const vpImage<vpRGBa> &I, const std::string &filename)
+{
+  vpJob *job = getFreeJob();
+  if (job == NULL)
+    return false;
+
+  job->m_color = true;
+  job->m_filename = filename;
+  job->m_Ic.resize(I.getHeight(), I.getWidth());
+  std::copy(I.bitmap, I.bitmap + I.getSize(), job->m_Ic.bitmap);
+  push(job);
+  return true;
+}
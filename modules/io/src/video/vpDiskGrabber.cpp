@@ -36,14 +36,101 @@
  *
  *****************************************************************************/
 
+#include <visp3/core/vpTracing.h>
 #include <visp3/io/vpDiskGrabber.h>
 
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+#include <visp3/core/vpThread.h>
+#define VP_DISK_GRABBER_PREFETCH
+#endif
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/*
+  Buffer of an image read in advance by a background thread.
+*/
+class vpDiskGrabber::vpPrefetchSlot
+{
+public:
+  vpPrefetchSlot() : m_filename(), m_color(false), m_I(), m_Ic(), m_error(), m_error_code(0), m_thread(NULL) {}
+  ~vpPrefetchSlot() { wait(); }
+
+  // Read the image in the thread attached to the slot, if any
+  void start(const std::string &filename, bool color)
+  {
+    wait();
+    m_filename = filename;
+    m_color = color;
+    m_error.clear();
+    m_error_code = 0;
+#if defined(VP_DISK_GRABBER_PREFETCH)
+    m_thread = new vpThread(run, this);
+#else
+    read();
+#endif
+  }
+
+  // Wait until the image is read
+  void wait()
+  {
+#if defined(VP_DISK_GRABBER_PREFETCH)
+    if (m_thread != NULL) {
+      m_thread->join();
+      delete m_thread;
+      m_thread = NULL;
+    }
+#endif
+  }
+
+  // Read the image and keep the error, if any, for the caller thread
+  void read()
+  {
+    try {
+      if (m_color)
+        vpImageIo::read(m_Ic, m_filename);
+      else
+        vpImageIo::read(m_I, m_filename);
+    } catch (vpException &e) {
+      m_error = e.getStringMessage();
+      m_error_code = e.getCode();
+    } catch (...) {
+      m_error = "Cannot read file: " + m_filename;
+      m_error_code = vpException::ioError;
+    }
+  }
+
+#if defined(VP_DISK_GRABBER_PREFETCH)
+  static vpThread::Return run(vpThread::Args args)
+  {
+    ((vpPrefetchSlot *)args)->read();
+    return 0;
+  }
+#endif
+
+  std::string m_filename;
+  bool m_color;
+  vpImage<unsigned char> m_I;
+  vpImage<vpRGBa> m_Ic;
+  std::string m_error;
+  int m_error_code;
+#if defined(VP_DISK_GRABBER_PREFETCH)
+  vpThread *m_thread;
+#else
+  void *m_thread;
+#endif
+
+private:
+  vpPrefetchSlot(const vpPrefetchSlot &);
+  vpPrefetchSlot &operator=(const vpPrefetchSlot &);
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 /*!
   Elementary constructor.
 */
 vpDiskGrabber::vpDiskGrabber()
   : m_image_number(0), m_image_number_next(0), m_image_step(1), m_number_of_zero(0), m_directory("/tmp"),
-    m_base_name("I"), m_extension("pgm"), m_use_generic_name(false), m_generic_name("empty")
+    m_base_name("I"), m_extension("pgm"), m_use_generic_name(false), m_generic_name("empty"), m_prefetch_size(0),
+    m_prefetch_ring()
 {
   init = false;
 }
@@ -53,7 +140,8 @@ vpDiskGrabber::vpDiskGrabber()
 */
 vpDiskGrabber::vpDiskGrabber(const std::string &generic_name)
   : m_image_number(0), m_image_number_next(0), m_image_step(1), m_number_of_zero(0), m_directory("/tmp"),
-    m_base_name("I"), m_extension("pgm"), m_use_generic_name(true), m_generic_name(generic_name)
+    m_base_name("I"), m_extension("pgm"), m_use_generic_name(true), m_generic_name(generic_name), m_prefetch_size(0),
+    m_prefetch_ring()
 {
   init = false;
 }
@@ -72,11 +160,45 @@ vpDiskGrabber::vpDiskGrabber(const std::string &generic_name)
 vpDiskGrabber::vpDiskGrabber(const std::string &dir, const std::string &basename, long number, int step,
                              unsigned int noz, const std::string &ext)
   : m_image_number(number), m_image_number_next(number), m_image_step(step), m_number_of_zero(noz), m_directory(dir),
-    m_base_name(basename), m_extension(ext), m_use_generic_name(false), m_generic_name("empty")
+    m_base_name(basename), m_extension(ext), m_use_generic_name(false), m_generic_name("empty"), m_prefetch_size(0),
+    m_prefetch_ring()
 {
   init = false;
 }
 
+/*!
+  Copy constructor. The images read in advance by \e grabber are not copied.
+*/
+vpDiskGrabber::vpDiskGrabber(const vpDiskGrabber &grabber)
+  : vpFrameGrabber(grabber), m_image_number(0), m_image_number_next(0), m_image_step(1), m_number_of_zero(0),
+    m_directory(), m_base_name(), m_extension(), m_use_generic_name(false), m_generic_name(), m_prefetch_size(0),
+    m_prefetch_ring()
+{
+  *this = grabber;
+}
+
+/*!
+  Copy operator. The images read in advance by \e grabber are not copied.
+*/
+vpDiskGrabber &vpDiskGrabber::operator=(const vpDiskGrabber &grabber)
+{
+  if (this != &grabber) {
+    releasePrefetch();
+    vpFrameGrabber::operator=(grabber);
+    m_image_number = grabber.m_image_number;
+    m_image_number_next = grabber.m_image_number_next;
+    m_image_step = grabber.m_image_step;
+    m_number_of_zero = grabber.m_number_of_zero;
+    m_directory = grabber.m_directory;
+    m_base_name = grabber.m_base_name;
+    m_extension = grabber.m_extension;
+    m_use_generic_name = grabber.m_use_generic_name;
+    m_generic_name = grabber.m_generic_name;
+    m_prefetch_size = grabber.m_prefetch_size;
+  }
+  return *this;
+}
+
 /*!
   Read the first image of the sequence.
   The image number is not incremented.
@@ -141,26 +263,7 @@ void vpDiskGrabber::open(vpImage<float> &I)
 
   \param I : The image read from a file.
  */
-void vpDiskGrabber::acquire(vpImage<unsigned char> &I)
-{
-  m_image_number = m_image_number_next;
-  std::stringstream ss;
-
-  if (m_use_generic_name) {
-    char filename[FILENAME_MAX];
-    sprintf(filename, m_generic_name.c_str(), m_image_number);
-    ss << filename;
-  } else {
-    ss << m_directory << "/" << m_base_name << std::setfill('0') << std::setw(m_number_of_zero) << m_image_number << "."
-       << m_extension;
-  }
-
-  m_image_number_next += m_image_step;
-  vpImageIo::read(I, ss.str());
-
-  width = I.getWidth();
-  height = I.getHeight();
-}
+void vpDiskGrabber::acquire(vpImage<unsigned char> &I) { acquire(I, m_image_number_next); }
 
 /*!
   Acquire an image reading the next image from the disk.
@@ -168,27 +271,7 @@ void vpDiskGrabber::acquire(vpImage<unsigned char> &I)
 
   \param I : The image read from a file.
  */
-void vpDiskGrabber::acquire(vpImage<vpRGBa> &I)
-{
-  m_image_number = m_image_number_next;
-  std::stringstream ss;
-
-  if (m_use_generic_name) {
-    char filename[FILENAME_MAX];
-    sprintf(filename, m_generic_name.c_str(), m_image_number);
-    ss << filename;
-  } else {
-    ss << m_directory << "/" << m_base_name << std::setfill('0') << std::setw(m_number_of_zero) << m_image_number << "."
-       << m_extension;
-  }
-
-  m_image_number_next += m_image_step;
-
-  vpImageIo::read(I, ss.str());
-
-  width = I.getWidth();
-  height = I.getHeight();
-}
+void vpDiskGrabber::acquire(vpImage<vpRGBa> &I) { acquire(I, m_image_number_next); }
 
 /*!
   Acquire an image reading the next pfm image from the disk.
@@ -196,26 +279,7 @@ void vpDiskGrabber::acquire(vpImage<vpRGBa> &I)
 
   \param I : The image read from a file.
  */
-void vpDiskGrabber::acquire(vpImage<float> &I)
-{
-  m_image_number = m_image_number_next;
-  std::stringstream ss;
-  if (m_use_generic_name) {
-    char filename[FILENAME_MAX];
-    sprintf(filename, m_generic_name.c_str(), m_image_number);
-    ss << filename;
-  } else {
-    ss << m_directory << "/" << m_base_name << std::setfill('0') << std::setw(m_number_of_zero) << m_image_number << "."
-       << m_extension;
-  }
-
-  m_image_number_next += m_image_step;
-
-  vpImageIo::readPFM(I, ss.str());
-
-  width = I.getWidth();
-  height = I.getHeight();
-}
+void vpDiskGrabber::acquire(vpImage<float> &I) { acquire(I, m_image_number_next); }
 
 /*!
   Acquire an image reading the image with number \e img_number from the disk.
@@ -226,21 +290,16 @@ void vpDiskGrabber::acquire(vpImage<float> &I)
  */
 void vpDiskGrabber::acquire(vpImage<unsigned char> &I, long img_number)
 {
-  m_image_number = m_image_number_next;
-  std::stringstream ss;
-  if (m_use_generic_name) {
-    char filename[FILENAME_MAX];
-    sprintf(filename, m_generic_name.c_str(), m_image_number);
-    ss << filename;
+  VP_TRACING_SCOPE("vpDiskGrabber::acquire");
+  m_image_number = img_number;
+  m_image_number_next = m_image_number + m_image_step;
+
+  if (m_prefetch_size > 0) {
+    I = prefetch(m_image_number, false)->m_I;
   } else {
-    ss << m_directory << "/" << m_base_name << std::setfill('0') << std::setw(m_number_of_zero) << img_number << "."
-       << m_extension;
+    vpImageIo::read(I, getImageName(m_image_number));
   }
 
-  m_image_number_next += m_image_step;
-
-  vpImageIo::read(I, ss.str());
-
   width = I.getWidth();
   height = I.getHeight();
 }
@@ -254,21 +313,16 @@ void vpDiskGrabber::acquire(vpImage<unsigned char> &I, long img_number)
  */
 void vpDiskGrabber::acquire(vpImage<vpRGBa> &I, long img_number)
 {
-  m_image_number = m_image_number_next;
-  std::stringstream ss;
-  if (m_use_generic_name) {
-    char filename[FILENAME_MAX];
-    sprintf(filename, m_generic_name.c_str(), m_image_number);
-    ss << filename;
+  VP_TRACING_SCOPE("vpDiskGrabber::acquire");
+  m_image_number = img_number;
+  m_image_number_next = m_image_number + m_image_step;
+
+  if (m_prefetch_size > 0) {
+    I = prefetch(m_image_number, true)->m_Ic;
   } else {
-    ss << m_directory << "/" << m_base_name << std::setfill('0') << std::setw(m_number_of_zero) << img_number << "."
-       << m_extension;
+    vpImageIo::read(I, getImageName(m_image_number));
   }
 
-  m_image_number_next += m_image_step;
-
-  vpImageIo::read(I, ss.str());
-
   width = I.getWidth();
   height = I.getHeight();
 }
@@ -277,46 +331,124 @@ void vpDiskGrabber::acquire(vpImage<vpRGBa> &I, long img_number)
   Acquire an image reading the pfm image with number \e img_number from the
   disk. After this call, the image number is incremented considering the step.
 
+  \note The pfm images are never read in advance, see setPrefetch().
+
   \param I : The image read from a file.
   \param img_number : The number of the desired image.
  */
 void vpDiskGrabber::acquire(vpImage<float> &I, long img_number)
 {
-  m_image_number = m_image_number_next;
+  VP_TRACING_SCOPE("vpDiskGrabber::acquire");
+  m_image_number = img_number;
+  m_image_number_next = m_image_number + m_image_step;
+
+  vpImageIo::readPFM(I, getImageName(m_image_number));
+
+  width = I.getWidth();
+  height = I.getHeight();
+}
+
+/*!
+  Return the name of the file of the image with number \e image_number.
+*/
+std::string vpDiskGrabber::getImageName(long image_number) const
+{
   std::stringstream ss;
   if (m_use_generic_name) {
     char filename[FILENAME_MAX];
-    sprintf(filename, m_generic_name.c_str(), m_image_number);
+    sprintf(filename, m_generic_name.c_str(), image_number);
     ss << filename;
   } else {
-    ss << m_directory << "/" << m_base_name << std::setfill('0') << std::setw(m_number_of_zero) << img_number << "."
+    ss << m_directory << "/" << m_base_name << std::setfill('0') << std::setw(m_number_of_zero) << image_number << "."
        << m_extension;
   }
+  return ss.str();
+}
 
-  m_image_number_next += m_image_step;
+/*!
+  Return the buffer of the image with number \e image_number, once it is read,
+  and start reading the next images of the sequence in the free buffers.
 
-  vpImageIo::readPFM(I, ss.str());
+  The buffers are kept for the images of the window [image_number,
+  image_number + (n-1) step], with n the number of buffers, so that changing
+  the step or jumping to another image only reads the missing images.
 
-  width = I.getWidth();
-  height = I.getHeight();
+  \exception vpException::ioError : If the image cannot be read.
+*/
+vpDiskGrabber::vpPrefetchSlot *vpDiskGrabber::prefetch(long image_number, bool color)
+{
+  if (m_prefetch_ring.size() != m_prefetch_size) {
+    releasePrefetch();
+    for (unsigned int i = 0; i < m_prefetch_size; i++)
+      m_prefetch_ring.push_back(new vpPrefetchSlot);
+  }
+
+  const size_t nb_slots = m_prefetch_ring.size();
+  const size_t window_size = m_image_step == 0 ? 1 : nb_slots;
+  std::vector<std::string> names(window_size);
+  std::vector<vpPrefetchSlot *> window(window_size, NULL);
+  std::vector<bool> used(nb_slots, false);
+
+  // Keep the images of the window that are already read or being read
+  for (size_t i = 0; i < window_size; i++) {
+    names[i] = getImageName(image_number + (long)i * m_image_step);
+    for (size_t j = 0; j < nb_slots && window[i] == NULL; j++) {
+      vpPrefetchSlot *slot = m_prefetch_ring[j];
+      if (!used[j] && slot->m_color == color && slot->m_filename == names[i]) {
+        window[i] = slot;
+        used[j] = true;
+      }
+    }
+  }
+
+  // Read the missing images in the other buffers, in the order of the
+  // sequence
+  size_t j = 0;
+  for (size_t i = 0; i < window_size; i++) {
+    if (window[i] == NULL) {
+      while (used[j])
+        j++;
+      window[i] = m_prefetch_ring[j];
+      used[j] = true;
+      window[i]->start(names[i], color);
+    }
+  }
+
+  vpPrefetchSlot *slot = window[0];
+  slot->wait();
+  if (!slot->m_error.empty()) {
+    int code = slot->m_error_code;
+    std::string error = slot->m_error;
+    // Read the image again at the next request
+    slot->m_filename.clear();
+    throw(vpException(code, "%s", error.c_str()));
+  }
+
+  return slot;
 }
 
 /*!
-  Not useful.
-
-  Here for compatibility issue with the vpFrameGrabber class.
- */
-void vpDiskGrabber::close()
+  Wait for the images being read and release the buffers of the images read
+  in advance.
+*/
+void vpDiskGrabber::releasePrefetch()
 {
-  // Nothing do do here...
+  for (size_t i = 0; i < m_prefetch_ring.size(); i++)
+    delete m_prefetch_ring[i];
+  m_prefetch_ring.clear();
 }
 
 /*!
-  Destructor
+  Release the images read in advance, see setPrefetch().
+
+  Here for compatibility issue with the vpFrameGrabber class.
+ */
+void vpDiskGrabber::close() { releasePrefetch(); }
 
-  In fact nothing to destroy...
+/*!
+  Destructor that waits for the images being read in advance.
  */
-vpDiskGrabber::~vpDiskGrabber() {}
+vpDiskGrabber::~vpDiskGrabber() { releasePrefetch(); }
 
 /*!
   Set the main directory name (ie location of the image sequence)
@@ -346,6 +478,27 @@ void vpDiskGrabber::setImageNumber(long number)
   Set the step between two images.
 */
 void vpDiskGrabber::setStep(long step) { m_image_step = step; }
+
+/*!
+  Set the number of images of the sequence read in advance. Each image is
+  read by a background thread in a buffer, so that the next images are
+  already decoded when acquire() is called. The images are returned in the
+  order of the sequence, and the memory is bounded by \e nbImages buffers.
+
+  Only the images acquired as vpImage<unsigned char> or vpImage<vpRGBa> are
+  read in advance. Without thread support, the images are read when they are
+  acquired.
+
+  \param nbImages : Number of buffers. 0, the default, disables the reading
+  in advance. With 1, the images are read when they are acquired.
+*/
+void vpDiskGrabber::setPrefetch(unsigned int nbImages)
+{
+  if (nbImages != m_prefetch_size) {
+    releasePrefetch();
+    m_prefetch_size = nbImages;
+  }
+}
 /*!
   Set the step between two images.
 */
@@ -0,0 +1,302 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Read a log of raw frames.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpFrameLogReader.cpp
+  \brief Read a log of raw frames.
+*/
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpImageConvert.h>
+#include <visp3/io/vpFrameLogReader.h>
+
+#include "vpFrameLog_impl.h"
+
+/*!
+  Default constructor, no log is open.
+*/
+vpFrameLogReader::vpFrameLogReader() : m_file(), m_frames(), m_endOffset(0), m_bigEndian(false) {}
+
+/*!
+  Open the frame log \e filename. See open().
+*/
+vpFrameLogReader::vpFrameLogReader(const std::string &filename)
+  : m_file(), m_frames(), m_endOffset(0), m_bigEndian(false)
+{
+  open(filename);
+}
+
+/*!
+  Destructor that closes the log.
+*/
+vpFrameLogReader::~vpFrameLogReader() { close(); }
+
+/*!
+  Close the log. The images returned by getFrame() without copy are no more
+  valid.
+*/
+void vpFrameLogReader::close()
+{
+  m_file.close();
+  m_frames.clear();
+  m_endOffset = 0;
+}
+
+/*!
+  Get the frame \e index as a grey level image. A color frame is converted.
+
+  \param index : Index of the frame, from 0 to getNbFrames()-1.
+  \param I : The frame.
+  \param copyData : If false, \e I points on the data of the log without any
+  copy and remains valid until the log is closed. Only possible if the frame
+  is a grey level image.
+
+  \exception vpException::badValue : If the index is out of range or if the
+  frame cannot be converted.
+*/
+void vpFrameLogReader::getFrame(unsigned int index, vpImage<unsigned char> &I, bool copyData)
+{
+  if (getFrameType(index) == FRAME_RGBA && copyData) {
+    vpImage<vpRGBa> I_color;
+    getRawFrame(index, I_color, FRAME_RGBA, false);
+    vpImageConvert::convert(I_color, I);
+  } else {
+    getRawFrame(index, I, FRAME_UCHAR, copyData);
+  }
+}
+
+/*!
+  Get the frame \e index as a color image. A grey level frame is converted.
+
+  \param index : Index of the frame, from 0 to getNbFrames()-1.
+  \param I : The frame.
+  \param copyData : If false, \e I points on the data of the log without any
+  copy and remains valid until the log is closed. Only possible if the frame
+  is a color image.
+
+  \exception vpException::badValue : If the index is out of range or if the
+  frame cannot be converted.
+*/
+void vpFrameLogReader::getFrame(unsigned int index, vpImage<vpRGBa> &I, bool copyData)
+{
+  if (getFrameType(index) == FRAME_UCHAR && copyData) {
+    vpImage<unsigned char> I_grey;
+    getRawFrame(index, I_grey, FRAME_UCHAR, false);
+    vpImageConvert::convert(I_grey, I);
+  } else {
+    getRawFrame(index, I, FRAME_RGBA, copyData);
+  }
+}
+
+/*!
+  Get the frame \e index, typically a depth map.
+
+  \param index : Index of the frame, from 0 to getNbFrames()-1.
+  \param I : The frame.
+  \param copyData : If false, \e I points on the data of the log without any
+  copy and remains valid until the log is closed.
+
+  \exception vpException::badValue : If the index is out of range or if the
+  frame is not a vpImage<uint16_t>.
+*/
+void vpFrameLogReader::getFrame(unsigned int index, vpImage<uint16_t> &I, bool copyData)
+{
+  getRawFrame(index, I, FRAME_UINT16, copyData);
+}
+
+/*!
+  Get the frame \e index.
+
+  \param index : Index of the frame, from 0 to getNbFrames()-1.
+  \param I : The frame.
+  \param copyData : If false, \e I points on the data of the log without any
+  copy and remains valid until the log is closed.
+
+  \exception vpException::badValue : If the index is out of range or if the
+  frame is not a vpImage<float>.
+*/
+void vpFrameLogReader::getFrame(unsigned int index, vpImage<float> &I, bool copyData)
+{
+  getRawFrame(index, I, FRAME_FLOAT, copyData);
+}
+
+/*!
+  Return the description of the frame \e index.
+
+  \exception vpException::badValue : If the index is out of range.
+*/
+const vpFrameLogReader::vpFrame &vpFrameLogReader::getFrameInfo(unsigned int index) const
+{
+  if (index >= m_frames.size()) {
+    throw(vpException(vpException::badValue, "Frame %u is out of the log of %u frames", index,
+                      (unsigned int)m_frames.size()));
+  }
+  return m_frames[index];
+}
+
+/*!
+  Return the type of the pixels of the frame \e index.
+*/
+vpFrameLogReader::vpFrameType vpFrameLogReader::getFrameType(unsigned int index) const
+{
+  return getFrameInfo(index).type;
+}
+
+/*!
+  Return the height of the frame \e index.
+*/
+unsigned int vpFrameLogReader::getHeight(unsigned int index) const { return getFrameInfo(index).height; }
+
+/*!
+  Copy the pixels of the frame \e index in \e I, or let \e I point on them.
+*/
+template <class Type>
+void vpFrameLogReader::getRawFrame(unsigned int index, vpImage<Type> &I, vpFrameType type, bool copyData)
+{
+  const vpFrame &frame = getFrameInfo(index);
+  if (frame.type != type) {
+    throw(vpException(vpException::badValue, "Frame %u has not the requested pixel type", index));
+  }
+  if (sizeof(Type) > 1 && type != FRAME_RGBA && m_bigEndian != vpFrameLog::isBigEndian()) {
+    throw(vpException(vpException::badValue, "Frame %u was written with another byte order", index));
+  }
+
+  Type *data = reinterpret_cast<Type *>(m_file.data() + frame.offset + vpFrameLog::frameHeaderSize);
+  if (copyData)
+    I.init(data, frame.height, frame.width, true);
+  else
+    I.initView(data, frame.height, frame.width);
+}
+
+/*!
+  Return the timestamp of the frame \e index, as given to
+  vpFrameLogWriter::write().
+*/
+double vpFrameLogReader::getTimestamp(unsigned int index) const { return getFrameInfo(index).timestamp; }
+
+/*!
+  Return the width of the frame \e index.
+*/
+unsigned int vpFrameLogReader::getWidth(unsigned int index) const { return getFrameInfo(index).width; }
+
+/*!
+  Map the frame log \e filename in memory and read its index. A log
+  previously open is closed.
+
+  \exception vpException::ioError : If the file cannot be open or is not a
+  frame log.
+*/
+void vpFrameLogReader::open(const std::string &filename)
+{
+  close();
+  m_file.open(filename);
+
+  const unsigned char *data = m_file.data();
+  const uint64_t size = m_file.size();
+  if (size < vpFrameLog::headerSize || memcmp(data, vpFrameLog::fileMagic, 8) != 0) {
+    close();
+    throw(vpException(vpException::ioError, "The file %s is not a frame log", filename.c_str()));
+  }
+  if (vpFrameLog::getUInt32(data + 8) != vpFrameLog::version) {
+    close();
+    throw(vpException(vpException::ioError, "The version of the frame log %s is not supported", filename.c_str()));
+  }
+  m_bigEndian = vpFrameLog::getUInt32(data + 12) != 0;
+
+  // Read the index if the log was closed
+  bool indexed = false;
+  if (size >= vpFrameLog::headerSize + vpFrameLog::indexHeaderSize + vpFrameLog::trailerSize &&
+      memcmp(data + size - 8, vpFrameLog::trailerMagic, 8) == 0) {
+    const uint64_t indexOffset = vpFrameLog::getUInt64(data + size - vpFrameLog::trailerSize);
+    const uint64_t indexEnd = size - vpFrameLog::trailerSize;
+    if (indexOffset >= vpFrameLog::headerSize && indexOffset + vpFrameLog::indexHeaderSize <= indexEnd &&
+        memcmp(data + indexOffset, vpFrameLog::indexMagic, 4) == 0) {
+      const uint64_t nbFrames = vpFrameLog::getUInt64(data + indexOffset + 8);
+      if (nbFrames <= (indexEnd - indexOffset - vpFrameLog::indexHeaderSize) / 8) {
+        indexed = true;
+        m_frames.resize((size_t)nbFrames);
+        const unsigned char *offsets = data + indexOffset + vpFrameLog::indexHeaderSize;
+        for (size_t i = 0; i < m_frames.size() && indexed; i++) {
+          const uint64_t offset = vpFrameLog::getUInt64(offsets + 8 * i);
+          indexed = offset < indexOffset && readFrameHeader((size_t)offset, m_frames[i]);
+        }
+        m_endOffset = (size_t)indexOffset;
+      }
+    }
+  }
+
+  // Otherwise go through the frames, until a truncated one
+  if (!indexed) {
+    m_frames.clear();
+    size_t offset = vpFrameLog::headerSize;
+    vpFrame frame;
+    while (readFrameHeader(offset, frame)) {
+      m_frames.push_back(frame);
+      const uint64_t dataSize = vpFrameLog::getUInt64(data + offset + 24);
+      offset = (size_t)vpFrameLog::align(offset + vpFrameLog::frameHeaderSize + dataSize);
+    }
+    m_endOffset = offset;
+  }
+}
+
+/*!
+  Read the header of the frame at \e offset. Return false if there is no
+  valid frame at this offset.
+*/
+bool vpFrameLogReader::readFrameHeader(size_t offset, vpFrame &frame) const
+{
+  const unsigned char *data = m_file.data();
+  const uint64_t size = m_file.size();
+  if ((uint64_t)offset + vpFrameLog::frameHeaderSize > size || offset % vpFrameLog::alignment != 0 ||
+      memcmp(data + offset, vpFrameLog::frameMagic, 4) != 0) {
+    return false;
+  }
+
+  const unsigned char *header = data + offset;
+  const uint32_t type = vpFrameLog::getUInt32(header + 4);
+  static const unsigned int pixelSize[] = {sizeof(unsigned char), sizeof(vpRGBa), sizeof(uint16_t), sizeof(float)};
+  if (type > FRAME_FLOAT) {
+    return false;
+  }
+  frame.offset = offset;
+  frame.type = (vpFrameType)type;
+  frame.width = vpFrameLog::getUInt32(header + 8);
+  frame.height = vpFrameLog::getUInt32(header + 12);
+  frame.timestamp = vpFrameLog::getDouble(header + 16);
+  const uint64_t dataSize = vpFrameLog::getUInt64(header + 24);
+
+  return dataSize == (uint64_t)frame.width * frame.height * pixelSize[type] &&
+         (uint64_t)offset + vpFrameLog::frameHeaderSize + dataSize <= size;
+}
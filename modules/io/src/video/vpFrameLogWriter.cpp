@@ -0,0 +1,246 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Write a log of raw frames.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpFrameLogWriter.cpp
+  \brief Write a log of raw frames.
+*/
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpIoTools.h>
+#include <visp3/io/vpFrameLogReader.h>
+#include <visp3/io/vpFrameLogWriter.h>
+
+#include "vpFrameLog_impl.h"
+
+/*!
+  Default constructor, no log is open.
+*/
+vpFrameLogWriter::vpFrameLogWriter() : m_file(), m_filename(), m_offsets(), m_offset(0) {}
+
+/*!
+  Create the frame log \e filename. See open().
+*/
+vpFrameLogWriter::vpFrameLogWriter(const std::string &filename, bool append)
+  : m_file(), m_filename(), m_offsets(), m_offset(0)
+{
+  open(filename, append);
+}
+
+/*!
+  Destructor that closes the log.
+*/
+vpFrameLogWriter::~vpFrameLogWriter()
+{
+  try {
+    close();
+  } catch (...) {
+  }
+}
+
+/*!
+  Write the index of the frames and close the log.
+
+  \exception vpException::ioError : If the index cannot be written.
+*/
+void vpFrameLogWriter::close()
+{
+  if (!m_file.is_open())
+    return;
+
+  std::vector<unsigned char> index(vpFrameLog::indexHeaderSize + 8 * m_offsets.size() + vpFrameLog::trailerSize, 0);
+  memcpy(&index[0], vpFrameLog::indexMagic, 4);
+  vpFrameLog::setUInt64(&index[8], m_offsets.size());
+  for (size_t i = 0; i < m_offsets.size(); i++)
+    vpFrameLog::setUInt64(&index[vpFrameLog::indexHeaderSize + 8 * i], m_offsets[i]);
+  vpFrameLog::setUInt64(&index[index.size() - vpFrameLog::trailerSize], m_offset);
+  memcpy(&index[index.size() - 8], vpFrameLog::trailerMagic, 8);
+
+  m_file.write((const char *)&index[0], (std::streamsize)index.size());
+  bool ok = m_file.good();
+  m_file.close();
+  m_offsets.clear();
+  m_offset = 0;
+  if (!ok) {
+    throw(vpException(vpException::ioError, "Cannot write the index of the frame log %s", m_filename.c_str()));
+  }
+}
+
+/*!
+  Open the frame log \e filename. A log previously open is closed.
+
+  \param filename : Name of the log, usually with the ".vplog" extension.
+  \param append : If true and if the log exists, the new frames are added
+  after its frames. Otherwise the log is created or overwritten.
+
+  \exception vpException::ioError : If the file cannot be created, or if it
+  is not a frame log when \e append is true.
+*/
+void vpFrameLogWriter::open(const std::string &filename, bool append)
+{
+  close();
+  m_filename = filename;
+
+  if (append && vpIoTools::checkFilename(filename)) {
+    vpFrameLogReader reader(filename);
+    if (reader.m_bigEndian != vpFrameLog::isBigEndian()) {
+      throw(vpException(vpException::ioError, "Cannot append frames to %s, written with another byte order",
+                        filename.c_str()));
+    }
+    for (size_t i = 0; i < reader.m_frames.size(); i++)
+      m_offsets.push_back(reader.m_frames[i].offset);
+    m_offset = reader.m_endOffset;
+    reader.close();
+
+    // The new frames overwrite the previous index, that is shorter
+    m_file.open(filename.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+    if (!m_file.is_open()) {
+      m_offsets.clear();
+      throw(vpException(vpException::ioError, "Cannot open the frame log %s", filename.c_str()));
+    }
+    m_file.seekp((std::streamoff)m_offset);
+    return;
+  }
+
+  m_file.open(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!m_file.is_open()) {
+    throw(vpException(vpException::ioError, "Cannot create the frame log %s", filename.c_str()));
+  }
+
+  unsigned char header[vpFrameLog::headerSize];
+  memset(header, 0, sizeof(header));
+  memcpy(header, vpFrameLog::fileMagic, 8);
+  vpFrameLog::setUInt32(header + 8, vpFrameLog::version);
+  vpFrameLog::setUInt32(header + 12, vpFrameLog::isBigEndian() ? 1 : 0);
+  m_file.write((const char *)header, sizeof(header));
+  m_offset = vpFrameLog::headerSize;
+}
+
+/*!
+  Append a grey level frame to the log.
+
+  \param I : The frame.
+  \param timestamp : Timestamp of the frame, for example given by
+  vpTime::measureTimeSecond().
+
+  \exception vpException::ioError : If the log is not open or if the frame
+  cannot be written.
+*/
+void vpFrameLogWriter::write(const vpImage<unsigned char> &I, double timestamp)
+{
+  writeFrame(vpFrameLogReader::FRAME_UCHAR, I.getWidth(), I.getHeight(), timestamp, I.bitmap,
+             I.getSize() * sizeof(unsigned char));
+}
+
+/*!
+  Append a color frame to the log.
+
+  \param I : The frame.
+  \param timestamp : Timestamp of the frame.
+
+  \exception vpException::ioError : If the log is not open or if the frame
+  cannot be written.
+*/
+void vpFrameLogWriter::write(const vpImage<vpRGBa> &I, double timestamp)
+{
+  writeFrame(vpFrameLogReader::FRAME_RGBA, I.getWidth(), I.getHeight(), timestamp, I.bitmap,
+             I.getSize() * sizeof(vpRGBa));
+}
+
+/*!
+  Append a frame of 16 bits values, typically a raw depth map, to the log.
+
+  \param I : The frame.
+  \param timestamp : Timestamp of the frame.
+
+  \exception vpException::ioError : If the log is not open or if the frame
+  cannot be written.
+*/
+void vpFrameLogWriter::write(const vpImage<uint16_t> &I, double timestamp)
+{
+  writeFrame(vpFrameLogReader::FRAME_UINT16, I.getWidth(), I.getHeight(), timestamp, I.bitmap,
+             I.getSize() * sizeof(uint16_t));
+}
+
+/*!
+  Append a frame of float values, for example a depth map in meters, to the
+  log.
+
+  \param I : The frame.
+  \param timestamp : Timestamp of the frame.
+
+  \exception vpException::ioError : If the log is not open or if the frame
+  cannot be written.
+*/
+void vpFrameLogWriter::write(const vpImage<float> &I, double timestamp)
+{
+  writeFrame(vpFrameLogReader::FRAME_FLOAT, I.getWidth(), I.getHeight(), timestamp, I.bitmap,
+             I.getSize() * sizeof(float));
+}
+
+/*!
+  Write the header and the pixels of a frame.
+*/
+void vpFrameLogWriter::writeFrame(unsigned int type, unsigned int width, unsigned int height, double timestamp,
+                                  const void *data, size_t size)
+{
+  if (!m_file.is_open()) {
+    throw(vpException(vpException::ioError, "The frame log is not open"));
+  }
+
+  // The header is padded so that the pixels are aligned on 64 bytes too
+  unsigned char header[vpFrameLog::frameHeaderSize];
+  memset(header, 0, sizeof(header));
+  memcpy(header, vpFrameLog::frameMagic, 4);
+  vpFrameLog::setUInt32(header + 4, type);
+  vpFrameLog::setUInt32(header + 8, width);
+  vpFrameLog::setUInt32(header + 12, height);
+  vpFrameLog::setDouble(header + 16, timestamp);
+  vpFrameLog::setUInt64(header + 24, size);
+
+  const uint64_t next = vpFrameLog::align(m_offset + vpFrameLog::frameHeaderSize + size);
+  static const char padding[vpFrameLog::alignment] = {0};
+
+  m_file.write((const char *)header, sizeof(header));
+  if (size > 0)
+    m_file.write((const char *)data, (std::streamsize)size);
+  m_file.write(padding, (std::streamsize)(next - m_offset - vpFrameLog::frameHeaderSize - size));
+  if (!m_file.good()) {
+    throw(vpException(vpException::ioError, "Cannot write a frame in the frame log %s", m_filename.c_str()));
+  }
+
+  m_offsets.push_back(m_offset);
+  m_offset = next;
+}
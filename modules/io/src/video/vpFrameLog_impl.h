@@ -0,0 +1,124 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Layout of the frame logs shared by vpFrameLogReader and vpFrameLogWriter.
+ *
+ *****************************************************************************/
+
+#ifndef vpFrameLog_impl_h
+#define vpFrameLog_impl_h
+
+#include <cstring>
+
+#include <visp3/core/vpConfig.h>
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+/*
+  A frame log is made of:
+  - a header of 64 bytes: magic "VISPFLOG", version (uint32), byte order of
+    the pixels (uint32, 1 for big endian),
+  - the frames, each one aligned on 64 bytes: magic "VPFR", type (uint32),
+    width (uint32), height (uint32), timestamp (double), size of the pixels
+    (uint64), padding up to 64 bytes, then the raw pixels,
+  - the index written when the log is closed: magic "VPIX", reserved
+    (uint32), number of frames (uint64) and offset of each frame (uint64),
+  - a trailer of 16 bytes: offset of the index (uint64) and magic
+    "VPLOGEND".
+  The fields are stored in little endian, the pixels in the byte order of the
+  writer.
+*/
+namespace vpFrameLog
+{
+const char fileMagic[] = "VISPFLOG";
+const char frameMagic[] = "VPFR";
+const char indexMagic[] = "VPIX";
+const char trailerMagic[] = "VPLOGEND";
+const unsigned int version = 1;
+const unsigned int headerSize = 64;
+const unsigned int frameHeaderSize = 64;
+const unsigned int indexHeaderSize = 16;
+const unsigned int trailerSize = 16;
+const unsigned int alignment = 64;
+
+inline uint64_t align(uint64_t offset) { return (offset + alignment - 1) / alignment * alignment; }
+
+inline void setUInt32(unsigned char *data, uint32_t value)
+{
+  for (unsigned int i = 0; i < 4; i++)
+    data[i] = (unsigned char)(value >> (8 * i));
+}
+
+inline void setUInt64(unsigned char *data, uint64_t value)
+{
+  for (unsigned int i = 0; i < 8; i++)
+    data[i] = (unsigned char)(value >> (8 * i));
+}
+
+inline void setDouble(unsigned char *data, double value)
+{
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  setUInt64(data, bits);
+}
+
+inline uint32_t getUInt32(const unsigned char *data)
+{
+  uint32_t value = 0;
+  for (unsigned int i = 0; i < 4; i++)
+    value |= (uint32_t)data[i] << (8 * i);
+  return value;
+}
+
+inline uint64_t getUInt64(const unsigned char *data)
+{
+  uint64_t value = 0;
+  for (unsigned int i = 0; i < 8; i++)
+    value |= (uint64_t)data[i] << (8 * i);
+  return value;
+}
+
+inline double getDouble(const unsigned char *data)
+{
+  uint64_t bits = getUInt64(data);
+  double value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+inline bool isBigEndian()
+{
+  const uint16_t one = 1;
+  return *(const unsigned char *)&one == 0;
+}
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+#endif
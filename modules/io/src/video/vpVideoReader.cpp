@@ -44,6 +44,7 @@
 
 #include <visp3/core/vpDebug.h>
 #include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpTracing.h>
 #include <visp3/io/vpVideoReader.h>
 
 #include <cctype>
@@ -55,12 +56,12 @@
 Basic constructor.
 */
 vpVideoReader::vpVideoReader()
-  : vpFrameGrabber(), imSequence(NULL),
+  : vpFrameGrabber(), imSequence(NULL), frameLog(NULL),
 #if VISP_HAVE_OPENCV_VERSION >= 0x020100
     capture(), frame(),
 #endif
     formatType(FORMAT_UNKNOWN), initFileName(false), isOpen(false), frameCount(0), firstFrame(0), lastFrame(0),
-    firstFrameIndexIsSet(false), lastFrameIndexIsSet(false), frameStep(1), frameRate(0.)
+    firstFrameIndexIsSet(false), lastFrameIndexIsSet(false), frameStep(1), frameRate(0.), prefetchSize(0)
 {
 }
 
@@ -72,6 +73,9 @@ vpVideoReader::~vpVideoReader()
   if (imSequence != NULL) {
     delete imSequence;
   }
+  if (frameLog != NULL) {
+    delete frameLog;
+  }
 }
 
 /*!
@@ -136,6 +140,23 @@ sequence.
 */
 void vpVideoReader::setFileName(const std::string &filename) { setFileName(filename.c_str()); }
 
+/*!
+  Set the number of frames of an image sequence that are read in advance by
+  background threads, see vpDiskGrabber::setPrefetch(). The frames are still
+  returned in the order of the sequence and setFrameStep() or getFrame() can
+  be used as usual. It has no effect when reading a video file.
+
+  \param nbFrames : Number of frames read in advance. 0, the default,
+  disables the reading in advance.
+*/
+void vpVideoReader::setPrefetch(unsigned int nbFrames)
+{
+  prefetchSize = nbFrames;
+  if (imSequence != NULL) {
+    imSequence->setPrefetch(prefetchSize);
+  }
+}
+
 /*!
   Open video stream and get first and last frame indexes.
 */
@@ -149,10 +170,22 @@ void vpVideoReader::getProperties()
     imSequence = new vpDiskGrabber;
     imSequence->setGenericName(fileName);
     imSequence->setStep(frameStep);
+    imSequence->setPrefetch(prefetchSize);
     if (firstFrameIndexIsSet) {
       imSequence->setImageNumber(firstFrame);
     }
     frameRate = -1.;
+  } else if (formatType == FORMAT_VPLOG) {
+    frameLog = new vpFrameLogReader(fileName);
+    const unsigned int nbFrames = frameLog->getNbFrames();
+    if (nbFrames == 0) {
+      throw(vpException(vpException::ioError, "The frame log %s is empty", fileName));
+    }
+    width = frameLog->getWidth(0);
+    height = frameLog->getHeight(0);
+    // Mean frame rate given by the timestamps
+    const double duration = frameLog->getTimestamp(nbFrames - 1) - frameLog->getTimestamp(0);
+    frameRate = (nbFrames > 1 && duration > 0) ? (nbFrames - 1) / duration : -1.;
   } else if (isVideoExtensionSupported()) {
 #if VISP_HAVE_OPENCV_VERSION >= 0x020100
     capture.open(fileName);
@@ -206,6 +239,9 @@ void vpVideoReader::open(vpImage<vpRGBa> &I)
   // Rewind to the first frame since open() should not increase the frame
   // counter
   frameCount = firstFrame;
+  if (frameLog != NULL) {
+    frameCount -= frameStep;
+  }
 
   if (isVideoExtensionSupported()) {
 #if VISP_HAVE_OPENCV_VERSION >= 0x020100
@@ -239,6 +275,9 @@ void vpVideoReader::open(vpImage<unsigned char> &I)
   // Rewind to the first frame since open() should not increase the frame
   // counter
   frameCount = firstFrame;
+  if (frameLog != NULL) {
+    frameCount -= frameStep;
+  }
 
   if (isVideoExtensionSupported()) {
 #if VISP_HAVE_OPENCV_VERSION >= 0x020100
@@ -265,6 +304,7 @@ This method enables to use the class as frame grabber.
 */
 void vpVideoReader::acquire(vpImage<vpRGBa> &I)
 {
+  VP_TRACING_SCOPE("vpVideoReader::acquire");
   if (!isOpen) {
     open(I);
   }
@@ -279,6 +319,16 @@ void vpVideoReader::acquire(vpImage<vpRGBa> &I)
     } else if (frameCount + frameStep < firstFrame) {
       imSequence->setImageNumber(frameCount);
     }
+  } else if (frameLog != NULL) {
+    frameCount += frameStep;
+    if (frameCount > lastFrame) {
+      frameCount = lastFrame;
+    } else if (frameCount < firstFrame) {
+      frameCount = firstFrame;
+    }
+    frameLog->getFrame((unsigned int)frameCount, I);
+    width = I.getWidth();
+    height = I.getHeight();
   }
 #if VISP_HAVE_OPENCV_VERSION >= 0x020100
   else {
@@ -337,6 +387,7 @@ This method enables to use the class as frame grabber.
 */
 void vpVideoReader::acquire(vpImage<unsigned char> &I)
 {
+  VP_TRACING_SCOPE("vpVideoReader::acquire");
   if (!isOpen) {
     open(I);
   }
@@ -350,6 +401,16 @@ void vpVideoReader::acquire(vpImage<unsigned char> &I)
     } else if (frameCount + frameStep < firstFrame) {
       imSequence->setImageNumber(frameCount);
     }
+  } else if (frameLog != NULL) {
+    frameCount += frameStep;
+    if (frameCount > lastFrame) {
+      frameCount = lastFrame;
+    } else if (frameCount < firstFrame) {
+      frameCount = firstFrame;
+    }
+    frameLog->getFrame((unsigned int)frameCount, I);
+    width = I.getWidth();
+    height = I.getHeight();
   }
 #if VISP_HAVE_OPENCV_VERSION >= 0x020100
   else {
@@ -429,6 +490,15 @@ bool vpVideoReader::getFrame(vpImage<vpRGBa> &I, long frame_index)
       vpERROR_TRACE("Couldn't find the %u th frame", frame_index);
       return false;
     }
+  } else if (frameLog != NULL) {
+    if (frame_index < 0 || frame_index >= (long)frameLog->getNbFrames()) {
+      vpERROR_TRACE("Couldn't find the %ld th frame", frame_index);
+      return false;
+    }
+    frameLog->getFrame((unsigned int)frame_index, I);
+    width = I.getWidth();
+    height = I.getHeight();
+    frameCount = frame_index;
   } else {
 #if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x030000)
     if (!capture.set(cv::CAP_PROP_POS_FRAMES, frame_index)) {
@@ -499,6 +569,15 @@ bool vpVideoReader::getFrame(vpImage<unsigned char> &I, long frame_index)
       vpERROR_TRACE("Couldn't find the %u th frame", frame_index);
       return false;
     }
+  } else if (frameLog != NULL) {
+    if (frame_index < 0 || frame_index >= (long)frameLog->getNbFrames()) {
+      vpERROR_TRACE("Couldn't find the %ld th frame", frame_index);
+      return false;
+    }
+    frameLog->getFrame((unsigned int)frame_index, I);
+    width = I.getWidth();
+    height = I.getHeight();
+    frameCount = frame_index;
   } else {
 #if VISP_HAVE_OPENCV_VERSION >= 0x030000
     if (!capture.set(cv::CAP_PROP_POS_FRAMES, frame_index)) {
@@ -641,6 +720,10 @@ vpVideoReader::vpVideoFormatType vpVideoReader::getFormat(const char *filename)
     return FORMAT_MKV;
   else if (ext.compare(".mkv") == 0)
     return FORMAT_MKV;
+  else if (ext.compare(".VPLOG") == 0)
+    return FORMAT_VPLOG;
+  else if (ext.compare(".vplog") == 0)
+    return FORMAT_VPLOG;
   else
     return FORMAT_UNKNOWN;
 }
@@ -683,6 +766,11 @@ void vpVideoReader::findLastFrameIndex()
       }
     }
   }
+  else if (frameLog != NULL) {
+    if (!lastFrameIndexIsSet) {
+      lastFrame = (long)frameLog->getNbFrames() - 1;
+    }
+  }
 
 #if VISP_HAVE_OPENCV_VERSION >= 0x030000
   else if (!lastFrameIndexIsSet) {
@@ -733,6 +821,10 @@ void vpVideoReader::findFirstFrameIndex()
       }
       imSequence->setImageNumber(firstFrame);
     }
+  } else if (frameLog != NULL) {
+    if (!firstFrameIndexIsSet) {
+      firstFrame = 0;
+    }
   }
 #if VISP_HAVE_OPENCV_VERSION >= 0x020100
   else if (!firstFrameIndexIsSet) {
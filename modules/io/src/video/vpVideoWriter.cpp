@@ -43,6 +43,7 @@
 */
 
 #include <visp3/core/vpDebug.h>
+#include <visp3/core/vpTime.h>
 #include <visp3/io/vpVideoWriter.h>
 
 #if VISP_HAVE_OPENCV_VERSION >= 0x020200
@@ -57,7 +58,8 @@ vpVideoWriter::vpVideoWriter()
 #if VISP_HAVE_OPENCV_VERSION >= 0x020100
     writer(), fourcc(0), framerate(0.),
 #endif
-    formatType(FORMAT_UNKNOWN), initFileName(false), isOpen(false), frameCount(0), firstFrame(0), width(0), height(0)
+    formatType(FORMAT_UNKNOWN), initFileName(false), isOpen(false), frameCount(0), firstFrame(0), width(0), height(0),
+    asyncWriter(NULL), frameLog(NULL)
 {
   initFileName = false;
   firstFrame = 0;
@@ -76,7 +78,15 @@ vpVideoWriter::vpVideoWriter()
 /*!
   Basic destructor.
 */
-vpVideoWriter::~vpVideoWriter() {}
+vpVideoWriter::~vpVideoWriter()
+{
+  if (asyncWriter != NULL) {
+    delete asyncWriter;
+  }
+  if (frameLog != NULL) {
+    delete frameLog;
+  }
+}
 
 /*!
   It enables to set the path and the name of the files which will be saved.
@@ -139,6 +149,13 @@ void vpVideoWriter::open(vpImage<vpRGBa> &I)
   if (formatType == FORMAT_PGM || formatType == FORMAT_PPM || formatType == FORMAT_JPEG || formatType == FORMAT_PNG) {
     width = I.getWidth();
     height = I.getHeight();
+  } else if (formatType == FORMAT_VPLOG) {
+    if (frameLog == NULL) {
+      frameLog = new vpFrameLogWriter;
+    }
+    frameLog->open(fileName);
+    width = I.getWidth();
+    height = I.getHeight();
   } else if (formatType == FORMAT_AVI || formatType == FORMAT_MPEG || formatType == FORMAT_MPEG4 ||
              formatType == FORMAT_MOV) {
 #if VISP_HAVE_OPENCV_VERSION >= 0x020100
@@ -174,6 +191,13 @@ void vpVideoWriter::open(vpImage<unsigned char> &I)
   if (formatType == FORMAT_PGM || formatType == FORMAT_PPM || formatType == FORMAT_JPEG || formatType == FORMAT_PNG) {
     width = I.getWidth();
     height = I.getHeight();
+  } else if (formatType == FORMAT_VPLOG) {
+    if (frameLog == NULL) {
+      frameLog = new vpFrameLogWriter;
+    }
+    frameLog->open(fileName);
+    width = I.getWidth();
+    height = I.getHeight();
   } else if (formatType == FORMAT_AVI || formatType == FORMAT_MPEG || formatType == FORMAT_MPEG4 ||
              formatType == FORMAT_MOV) {
 #if VISP_HAVE_OPENCV_VERSION >= 0x020100
@@ -215,7 +239,16 @@ void vpVideoWriter::saveFrame(vpImage<vpRGBa> &I)
 
     sprintf(name, fileName, frameCount);
 
-    vpImageIo::write(I, name);
+    if (asyncWriter != NULL) {
+      if (!asyncWriter->write(I, name)) {
+        // The frame is dropped, the next one takes its index
+        return;
+      }
+    } else {
+      vpImageIo::write(I, name);
+    }
+  } else if (formatType == FORMAT_VPLOG) {
+    frameLog->write(I, vpTime::measureTimeSecond());
   } else {
 #if VISP_HAVE_OPENCV_VERSION >= 0x020100
     cv::Mat matFrame;
@@ -248,7 +281,16 @@ void vpVideoWriter::saveFrame(vpImage<unsigned char> &I)
 
     sprintf(name, fileName, frameCount);
 
-    vpImageIo::write(I, name);
+    if (asyncWriter != NULL) {
+      if (!asyncWriter->write(I, name)) {
+        // The frame is dropped, the next one takes its index
+        return;
+      }
+    } else {
+      vpImageIo::write(I, name);
+    }
+  } else if (formatType == FORMAT_VPLOG) {
+    frameLog->write(I, vpTime::measureTimeSecond());
   } else {
 #if VISP_HAVE_OPENCV_VERSION >= 0x030000
     cv::Mat matFrame, rgbMatFrame;
@@ -275,6 +317,56 @@ void vpVideoWriter::close()
     vpERROR_TRACE("The video has to be open first with the open method");
     throw(vpException(vpException::notInitialized, "file not yet opened"));
   }
+
+  if (asyncWriter != NULL) {
+    asyncWriter->flush();
+  }
+  if (frameLog != NULL) {
+    frameLog->close();
+  }
+}
+
+/*!
+  Return the number of frames of an image sequence dropped by saveFrame()
+  with the vpAsyncImageWriter::DROP policy, see setAsync().
+*/
+unsigned int vpVideoWriter::getNbDroppedFrames() const
+{
+  return asyncWriter != NULL ? asyncWriter->getNbDroppedImages() : 0;
+}
+
+/*!
+  Write the images of a sequence with background threads, see
+  vpAsyncImageWriter. saveFrame() then only copies the image in a queue, so
+  that the caller does not wait for the encoding of the files. The frames are
+  written in the files corresponding to their index. close() waits until all
+  the frames are written. It has no effect when writing a video file.
+
+  \param nbThreads : Number of threads that write the images. 0 disables the
+  background threads, the queued frames are written before.
+  \param queueSize : Maximum number of frames waiting to be written.
+  \param policy : Behavior of saveFrame() when the queue is full. With
+  vpAsyncImageWriter::DROP, the dropped frames are not written and the frame
+  index is not incremented, so that the image sequence has no gap.
+
+  \sa getNbDroppedFrames()
+*/
+void vpVideoWriter::setAsync(unsigned int nbThreads, unsigned int queueSize,
+                             const vpAsyncImageWriter::vpQueuePolicy &policy)
+{
+  if (nbThreads == 0) {
+    if (asyncWriter != NULL) {
+      asyncWriter->flush();
+      delete asyncWriter;
+      asyncWriter = NULL;
+    }
+  } else if (asyncWriter == NULL) {
+    asyncWriter = new vpAsyncImageWriter(nbThreads, queueSize, policy);
+  } else {
+    asyncWriter->setNbThreads(nbThreads);
+    asyncWriter->setQueueSize(queueSize);
+    asyncWriter->setPolicy(policy);
+  }
 }
 
 /*!
@@ -332,6 +424,10 @@ vpVideoWriter::vpVideoFormatType vpVideoWriter::getFormat(const char *filename)
     return FORMAT_MOV;
   else if (ext.compare(".mov") == 0)
     return FORMAT_MOV;
+  else if (ext.compare(".VPLOG") == 0)
+    return FORMAT_VPLOG;
+  else if (ext.compare(".vplog") == 0)
+    return FORMAT_VPLOG;
   else
     return FORMAT_UNKNOWN;
 }
@@ -66,6 +66,15 @@
   be filled in. By default this functionality is not used because it consumes
   lot of time.
 
+  The projected image is rendered by a scanline rasterizer: for each image
+  row, only the span covered by the projected plane is visited, and the depth
+  and texture coordinates are interpolated incrementally in a perspective
+  correct way. Rows are processed in parallel when OpenMP is available. When a
+  list of images is projected, all of them are rendered in a single pass with
+  a depth buffer that can be retrieved with getImage(vpImage<unsigned char>
+  &, std::list<vpImageSimulator> &, const vpCameraParameters &, vpImage<float>
+  &).
+
   The  following example explain how to use the class.
 
   \code
@@ -204,6 +213,15 @@ private:
   // boolean to tell if the points in the camera frame have to be clipped
   bool needClipping;
 
+  // edges of the projected polygon in the normalized image plane, stored as
+  // (a, b, c) with a*x + b*y + c >= 0 inside; used to compute the scanline
+  // spans
+  std::vector<double> edgeCoef;
+  // projective texture coordinates: with p = (x, y, 1), u = uCoef.p / n.p and
+  // v = vCoef.p / n.p where n is normal_Cam_optim
+  double uCoef[3];
+  double vCoef[3];
+
 public:
   explicit vpImageSimulator(const vpColorPlan &col = COLORED);
   vpImageSimulator(const vpImageSimulator &text);
@@ -241,6 +259,10 @@ public:
 
   static void getImage(vpImage<unsigned char> &I, std::list<vpImageSimulator> &list, const vpCameraParameters &cam);
   static void getImage(vpImage<vpRGBa> &I, std::list<vpImageSimulator> &list, const vpCameraParameters &cam);
+  static void getImage(vpImage<unsigned char> &I, std::list<vpImageSimulator> &list, const vpCameraParameters &cam,
+                       vpImage<float> &depth);
+  static void getImage(vpImage<vpRGBa> &I, std::list<vpImageSimulator> &list, const vpCameraParameters &cam,
+                       vpImage<float> &depth);
 
   std::vector<vpColVector> get3DcornersTextureRectangle();
 
@@ -283,16 +305,23 @@ private:
   // sinon invisible.
   bool isVisible() { return visible; }
 
-  // function that project a point x,y on the plane, return true if the
-  // projection is on the limited plane
-  // and in this case return the corresponding image pixel Ipixelplan
-  bool getPixel(const vpImagePoint &iP, unsigned char &Ipixelplan);
-  bool getPixel(const vpImagePoint &iP, vpRGBa &Ipixelplan);
-  bool getPixel(vpImage<unsigned char> &Isrc, const vpImagePoint &iP, unsigned char &Ipixelplan);
-  bool getPixel(vpImage<vpRGBa> &Isrc, const vpImagePoint &iP, vpRGBa &Ipixelplan);
-  bool getPixelDepth(const vpImagePoint &iP, double &Zpixelplan);
   bool getPixelVisibility(const vpImagePoint &iP, double &Zpixelplan);
 
+  // scanline rasterization of the plane in the image row i between the
+  // columns [left, right[, with an optional depth test when depthRow is not
+  // NULL
+  void getRowSpan(const vpCameraParameters &cam, double y, unsigned int left, unsigned int right, unsigned int &jmin,
+                  unsigned int &jmax) const;
+  template <class Type, class TextureType, class DepthType>
+  void rasterizeRow(const vpCameraParameters &cam, unsigned int i, unsigned int left, unsigned int right,
+                    const vpImage<TextureType> &texture, Type *row, DepthType *depthRow) const;
+  template <class Type, class TextureType>
+  void rasterize(vpImage<Type> &I, const vpImage<TextureType> &texture, const vpCameraParameters &cam,
+                 vpMatrix *zBuffer);
+  template <class Type>
+  static void rasterize(vpImage<Type> &I, std::list<vpImageSimulator> &list, const vpCameraParameters &cam,
+                        vpImage<float> &depth);
+
   // operation 3D de base :
   void project(const vpColVector &_vin, const vpHomogeneousMatrix &_cMt, vpColVector &_vout);
   // donne coordonnes homogenes de _v;
@@ -45,6 +45,9 @@
 #include <visp3/core/vpRotationMatrix.h>
 #include <visp3/robot/vpImageSimulator.h>
 
+#include <cmath>
+#include <limits>
+
 #ifdef VISP_HAVE_MODULE_IO
 #include <visp3/io/vpImageIo.h>
 #endif
@@ -63,7 +66,8 @@ vpImageSimulator::vpImageSimulator(const vpColorPlan &col)
   : cMt(), pt(), ptClipped(), interp(SIMPLE), normal_obj(), normal_Cam(), normal_Cam_optim(), distance(1.),
     visible_result(1.), visible(false), X0_2_optim(NULL), euclideanNorm_u(0.), euclideanNorm_v(0.), vbase_u(),
     vbase_v(), vbase_u_optim(NULL), vbase_v_optim(NULL), Xinter_optim(NULL), listTriangle(), colorI(col), Ig(), Ic(),
-    rect(), cleanPrevImage(false), setBackgroundTexture(false), bgColor(vpColor::white), focal(), needClipping(false)
+    rect(), cleanPrevImage(false), setBackgroundTexture(false), bgColor(vpColor::white), focal(), needClipping(false),
+    edgeCoef()
 {
   for (int i = 0; i < 4; i++)
     X[i].resize(3);
@@ -90,6 +94,11 @@ vpImageSimulator::vpImageSimulator(const vpColorPlan &col)
   vbase_v_optim = new double[3];
   Xinter_optim = new double[3];
 
+  for (unsigned int i = 0; i < 3; i++) {
+    uCoef[i] = 0.;
+    vCoef[i] = 0.;
+  }
+
   pt.resize(4);
 }
 
@@ -101,7 +110,7 @@ vpImageSimulator::vpImageSimulator(const vpImageSimulator &text)
     visible_result(1.), visible(false), X0_2_optim(NULL), euclideanNorm_u(0.), euclideanNorm_v(0.), vbase_u(),
     vbase_v(), vbase_u_optim(NULL), vbase_v_optim(NULL), Xinter_optim(NULL), listTriangle(), colorI(GRAY_SCALED), Ig(),
     Ic(), rect(), cleanPrevImage(false), setBackgroundTexture(false), bgColor(vpColor::white), focal(),
-    needClipping(false)
+    needClipping(false), edgeCoef()
 {
   pt.resize(4);
   for (unsigned int i = 0; i < 4; i++) {
@@ -133,6 +142,11 @@ vpImageSimulator::vpImageSimulator(const vpImageSimulator &text)
   vbase_v_optim = new double[3];
   Xinter_optim = new double[3];
 
+  for (unsigned int i = 0; i < 3; i++) {
+    uCoef[i] = 0.;
+    vCoef[i] = 0.;
+  }
+
   colorI = text.colorI;
   interp = text.interp;
   bgColor = text.bgColor;
@@ -181,6 +195,220 @@ vpImageSimulator &vpImageSimulator::operator=(const vpImageSimulator &sim)
   return *this;
 }
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+inline void vpConvertSimulatedPixel(const unsigned char &src, unsigned char &dst) { dst = src; }
+
+inline void vpConvertSimulatedPixel(const vpRGBa &src, unsigned char &dst)
+{
+  dst = (unsigned char)(0.2126 * src.R + 0.7152 * src.G + 0.0722 * src.B);
+}
+
+inline void vpConvertSimulatedPixel(const unsigned char &src, vpRGBa &dst)
+{
+  dst = vpRGBa();
+  dst.R = src;
+  dst.G = src;
+  dst.B = src;
+}
+
+inline void vpConvertSimulatedPixel(const vpRGBa &src, vpRGBa &dst) { dst = src; }
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Compute the span [jmin, jmax[ of the columns of the image row corresponding
+  to the normalized coordinate \e y that lie inside the projected polygon,
+  restricted to [left, right[. The span is empty when jmin == jmax.
+*/
+void vpImageSimulator::getRowSpan(const vpCameraParameters &cam, double y, unsigned int left, unsigned int right,
+                                  unsigned int &jmin, unsigned int &jmax) const
+{
+  jmin = jmax = left;
+
+  double xmin = -std::numeric_limits<double>::max();
+  double xmax = std::numeric_limits<double>::max();
+  for (size_t k = 0; k + 2 < edgeCoef.size(); k += 3) {
+    double a = edgeCoef[k];
+    double r = edgeCoef[k + 1] * y + edgeCoef[k + 2];
+    if (std::fabs(a) <= std::numeric_limits<double>::epsilon()) {
+      if (r < 0)
+        return;
+    } else if (a > 0) {
+      xmin = (std::max)(xmin, -r / a);
+    } else {
+      xmax = (std::min)(xmax, -r / a);
+    }
+  }
+  if (xmin > xmax)
+    return;
+
+  // Small tolerance, the exact test is done on the texture coordinates
+  double jstart = (std::max)((double)left, std::ceil(xmin * cam.get_px() + cam.get_u0() - 1e-6));
+  double jend = (std::min)((double)right, std::floor(xmax * cam.get_px() + cam.get_u0() + 1e-6) + 1.);
+  if (jend <= jstart)
+    return;
+
+  jmin = (unsigned int)jstart;
+  jmax = (unsigned int)jend;
+}
+
+/*!
+  Scan-convert the plane in the image row \e i between the columns [left,
+  right[. The depth and the texture coordinates are interpolated
+  incrementally along the row in a perspective correct way. When \e depthRow
+  is not NULL, a pixel is only updated if its depth is lower than the one
+  stored in \e depthRow or if the stored depth is negative, and the depth is
+  then updated.
+*/
+template <class Type, class TextureType, class DepthType>
+void vpImageSimulator::rasterizeRow(const vpCameraParameters &cam, unsigned int i, unsigned int left,
+                                    unsigned int right, const vpImage<TextureType> &texture, Type *row,
+                                    DepthType *depthRow) const
+{
+  // With distortion the normalized coordinates are not affine along the row
+  bool distortion = (cam.get_projModel() == vpCameraParameters::perspectiveProjWithDistortion);
+
+  unsigned int jmin = left, jmax = right;
+  double x = 0, y = 0;
+  vpPixelMeterConversion::convertPoint(cam, (double)left, (double)i, x, y);
+  if (!distortion) {
+    getRowSpan(cam, y, left, right, jmin, jmax);
+    x = (jmin - cam.get_u0()) * cam.get_px_inverse();
+  }
+
+  double den = normal_Cam_optim[0] * x + normal_Cam_optim[1] * y + normal_Cam_optim[2];
+  double nu = uCoef[0] * x + uCoef[1] * y + uCoef[2];
+  double nv = vCoef[0] * x + vCoef[1] * y + vCoef[2];
+  double dx = cam.get_px_inverse();
+  double dden = normal_Cam_optim[0] * dx, dnu = uCoef[0] * dx, dnv = vCoef[0] * dx;
+
+  double texHeight = texture.getHeight() - 1;
+  double texWidth = texture.getWidth() - 1;
+
+  for (unsigned int j = jmin; j < jmax; j++, den += dden, nu += dnu, nv += dnv) {
+    if (distortion) {
+      vpPixelMeterConversion::convertPoint(cam, (double)j, (double)i, x, y);
+      den = normal_Cam_optim[0] * x + normal_Cam_optim[1] * y + normal_Cam_optim[2];
+      nu = uCoef[0] * x + uCoef[1] * y + uCoef[2];
+      nv = vCoef[0] * x + vCoef[1] * y + vCoef[2];
+    }
+
+    // The ray intersects the plane behind the camera
+    if (den <= 0)
+      continue;
+
+    double inv_den = 1. / den;
+    double z = distance * inv_den;
+    if (depthRow != NULL && !(z < depthRow[j] || depthRow[j] < 0))
+      continue;
+
+    double u = nu * inv_den;
+    double v = nv * inv_den;
+    if (u > 0 && v > 0 && u < 1. && v < 1.) {
+      double i2 = v * texHeight;
+      double j2 = u * texWidth;
+      if (interp == BILINEAR_INTERPOLATION)
+        vpConvertSimulatedPixel(texture.getValue(i2, j2), row[j]);
+      else
+        vpConvertSimulatedPixel(texture[(unsigned int)i2][(unsigned int)j2], row[j]);
+
+      if (depthRow != NULL)
+        depthRow[j] = (DepthType)z;
+    }
+  }
+}
+
+/*!
+  Render the plane into \e I using the scanline rasterizer. The rows of the
+  region of interest are processed in parallel when OpenMP is available.
+*/
+template <class Type, class TextureType>
+void vpImageSimulator::rasterize(vpImage<Type> &I, const vpImage<TextureType> &texture,
+                                 const vpCameraParameters &cam, vpMatrix *zBuffer)
+{
+  if (!needClipping)
+    getRoi(I.getWidth(), I.getHeight(), cam, pt, rect);
+  else
+    getRoi(I.getWidth(), I.getHeight(), cam, ptClipped, rect);
+
+  int top = (int)rect.getTop();
+  int bottom = (int)rect.getBottom();
+  unsigned int left = (unsigned int)rect.getLeft();
+  unsigned int right = (unsigned int)rect.getRight();
+
+#if defined _OPENMP // only to disable warning: ignoring #pragma omp parallel [-Wunknown-pragmas]
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (int i = top; i < bottom; i++) {
+    double *depthRow = (zBuffer != NULL) ? (*zBuffer)[(unsigned int)i] : NULL;
+    rasterizeRow(cam, (unsigned int)i, left, right, texture, I[i], depthRow);
+  }
+}
+
+/*!
+  Render all the visible planes of \e list into \e I in one pass over the
+  image rows. For each row, every plane is scan-converted with a depth test
+  against the float depth buffer \e depth. The rows are processed in parallel
+  when OpenMP is available.
+*/
+template <class Type>
+void vpImageSimulator::rasterize(vpImage<Type> &I, std::list<vpImageSimulator> &list, const vpCameraParameters &cam,
+                                 vpImage<float> &depth)
+{
+  unsigned int width = I.getWidth();
+  unsigned int height = I.getHeight();
+
+  depth.resize(height, width, -1.f);
+
+  std::vector<vpImageSimulator *> simList;
+  double topFinal = height + 1;
+  double bottomFinal = -1;
+  for (std::list<vpImageSimulator>::iterator it = list.begin(); it != list.end(); ++it) {
+    vpImageSimulator *sim = &(*it);
+    if (!sim->visible)
+      continue;
+
+    if (!sim->needClipping)
+      sim->getRoi(width, height, cam, sim->pt, sim->rect);
+    else
+      sim->getRoi(width, height, cam, sim->ptClipped, sim->rect);
+
+    if (topFinal > sim->rect.getTop())
+      topFinal = sim->rect.getTop();
+    if (bottomFinal < sim->rect.getBottom())
+      bottomFinal = sim->rect.getBottom();
+
+    simList.push_back(sim);
+  }
+
+  if (simList.empty())
+    return;
+
+  int top = (int)topFinal;
+  int bottom = (int)bottomFinal;
+  int nbSim = (int)simList.size();
+
+#if defined _OPENMP // only to disable warning: ignoring #pragma omp parallel [-Wunknown-pragmas]
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (int i = top; i < bottom; i++) {
+    for (int k = 0; k < nbSim; k++) {
+      const vpImageSimulator *sim = simList[(size_t)k];
+      if (i < (int)sim->rect.getTop() || i >= (int)sim->rect.getBottom())
+        continue;
+
+      unsigned int left = (unsigned int)sim->rect.getLeft();
+      unsigned int right = (unsigned int)sim->rect.getRight();
+      if (sim->colorI == GRAY_SCALED)
+        sim->rasterizeRow(cam, (unsigned int)i, left, right, sim->Ig, I[i], depth[i]);
+      else if (sim->colorI == COLORED)
+        sim->rasterizeRow(cam, (unsigned int)i, left, right, sim->Ic, I[i], depth[i]);
+    }
+  }
+}
+
 /*!
   Get the view of the virtual camera. Be careful, the image I is modified. The
   projected image is not added as an overlay! \param I : The image used to
@@ -203,44 +431,10 @@ void vpImageSimulator::getImage(vpImage<unsigned char> &I, const vpCameraParamet
   }
 
   if (visible) {
-    if (!needClipping)
-      getRoi(I.getWidth(), I.getHeight(), cam, pt, rect);
-    else
-      getRoi(I.getWidth(), I.getHeight(), cam, ptClipped, rect);
-
-    double top = rect.getTop();
-    double bottom = rect.getBottom();
-    double left = rect.getLeft();
-    double right = rect.getRight();
-
-    unsigned char *bitmap = I.bitmap;
-    unsigned int width = I.getWidth();
-    vpImagePoint ip;
-    int nb_point_dessine = 0;
-
-    for (unsigned int i = (unsigned int)top; i < (unsigned int)bottom; i++) {
-      for (unsigned int j = (unsigned int)left; j < (unsigned int)right; j++) {
-        double x = 0, y = 0;
-        ip.set_ij(i, j);
-        vpPixelMeterConversion::convertPoint(cam, ip, x, y);
-        ip.set_ij(y, x);
-        if (colorI == GRAY_SCALED) {
-          unsigned char Ipixelplan = 0;
-          if (getPixel(ip, Ipixelplan)) {
-            *(bitmap + i * width + j) = Ipixelplan;
-            nb_point_dessine++;
-          }
-        } else if (colorI == COLORED) {
-          vpRGBa Ipixelplan;
-          if (getPixel(ip, Ipixelplan)) {
-            unsigned char pixelgrey =
-                (unsigned char)(0.2126 * Ipixelplan.R + 0.7152 * Ipixelplan.G + 0.0722 * Ipixelplan.B);
-            *(bitmap + i * width + j) = pixelgrey;
-            nb_point_dessine++;
-          }
-        }
-      }
-    }
+    if (colorI == GRAY_SCALED)
+      rasterize(I, Ig, cam, NULL);
+    else if (colorI == COLORED)
+      rasterize(I, Ic, cam, NULL);
   }
 }
 
@@ -263,36 +457,8 @@ void vpImageSimulator::getImage(vpImage<unsigned char> &I, vpImage<unsigned char
       }
     }
   }
-  if (visible) {
-    if (!needClipping)
-      getRoi(I.getWidth(), I.getHeight(), cam, pt, rect);
-    else
-      getRoi(I.getWidth(), I.getHeight(), cam, ptClipped, rect);
-
-    double top = rect.getTop();
-    double bottom = rect.getBottom();
-    double left = rect.getLeft();
-    double right = rect.getRight();
-
-    unsigned char *bitmap = I.bitmap;
-    unsigned int width = I.getWidth();
-    vpImagePoint ip;
-    int nb_point_dessine = 0;
-
-    for (unsigned int i = (unsigned int)top; i < (unsigned int)bottom; i++) {
-      for (unsigned int j = (unsigned int)left; j < (unsigned int)right; j++) {
-        double x = 0, y = 0;
-        ip.set_ij(i, j);
-        vpPixelMeterConversion::convertPoint(cam, ip, x, y);
-        ip.set_ij(y, x);
-        unsigned char Ipixelplan = 0;
-        if (getPixel(Isrc, ip, Ipixelplan)) {
-          *(bitmap + i * width + j) = Ipixelplan;
-          nb_point_dessine++;
-        }
-      }
-    }
-  }
+  if (visible)
+    rasterize(I, Isrc, cam, NULL);
 }
 
 /*!
@@ -325,50 +491,10 @@ void vpImageSimulator::getImage(vpImage<unsigned char> &I, const vpCameraParamet
     }
   }
   if (visible) {
-    if (!needClipping)
-      getRoi(I.getWidth(), I.getHeight(), cam, pt, rect);
-    else
-      getRoi(I.getWidth(), I.getHeight(), cam, ptClipped, rect);
-
-    double top = rect.getTop();
-    double bottom = rect.getBottom();
-    double left = rect.getLeft();
-    double right = rect.getRight();
-
-    unsigned char *bitmap = I.bitmap;
-    unsigned int width = I.getWidth();
-    vpImagePoint ip;
-    int nb_point_dessine = 0;
-
-    for (unsigned int i = (unsigned int)top; i < (unsigned int)bottom; i++) {
-      for (unsigned int j = (unsigned int)left; j < (unsigned int)right; j++) {
-        double x = 0, y = 0;
-        ip.set_ij(i, j);
-        vpPixelMeterConversion::convertPoint(cam, ip, x, y);
-        ip.set_ij(y, x);
-        if (colorI == GRAY_SCALED) {
-          unsigned char Ipixelplan;
-          if (getPixel(ip, Ipixelplan)) {
-            if (Xinter_optim[2] < zBuffer[i][j] || zBuffer[i][j] < 0) {
-              *(bitmap + i * width + j) = Ipixelplan;
-              nb_point_dessine++;
-              zBuffer[i][j] = Xinter_optim[2];
-            }
-          }
-        } else if (colorI == COLORED) {
-          vpRGBa Ipixelplan;
-          if (getPixel(ip, Ipixelplan)) {
-            if (Xinter_optim[2] < zBuffer[i][j] || zBuffer[i][j] < 0) {
-              unsigned char pixelgrey =
-                  (unsigned char)(0.2126 * Ipixelplan.R + 0.7152 * Ipixelplan.G + 0.0722 * Ipixelplan.B);
-              *(bitmap + i * width + j) = pixelgrey;
-              nb_point_dessine++;
-              zBuffer[i][j] = Xinter_optim[2];
-            }
-          }
-        }
-      }
-    }
+    if (colorI == GRAY_SCALED)
+      rasterize(I, Ig, cam, &zBuffer);
+    else if (colorI == COLORED)
+      rasterize(I, Ic, cam, &zBuffer);
   }
 }
 
@@ -390,46 +516,10 @@ void vpImageSimulator::getImage(vpImage<vpRGBa> &I, const vpCameraParameters &ca
   }
 
   if (visible) {
-    if (!needClipping)
-      getRoi(I.getWidth(), I.getHeight(), cam, pt, rect);
-    else
-      getRoi(I.getWidth(), I.getHeight(), cam, ptClipped, rect);
-
-    double top = rect.getTop();
-    double bottom = rect.getBottom();
-    double left = rect.getLeft();
-    double right = rect.getRight();
-
-    vpRGBa *bitmap = I.bitmap;
-    unsigned int width = I.getWidth();
-    vpImagePoint ip;
-    int nb_point_dessine = 0;
-
-    for (unsigned int i = (unsigned int)top; i < (unsigned int)bottom; i++) {
-      for (unsigned int j = (unsigned int)left; j < (unsigned int)right; j++) {
-        double x = 0, y = 0;
-        ip.set_ij(i, j);
-        vpPixelMeterConversion::convertPoint(cam, ip, x, y);
-        ip.set_ij(y, x);
-        if (colorI == GRAY_SCALED) {
-          unsigned char Ipixelplan;
-          if (getPixel(ip, Ipixelplan)) {
-            vpRGBa pixelcolor;
-            pixelcolor.R = Ipixelplan;
-            pixelcolor.G = Ipixelplan;
-            pixelcolor.B = Ipixelplan;
-            *(bitmap + i * width + j) = pixelcolor;
-            nb_point_dessine++;
-          }
-        } else if (colorI == COLORED) {
-          vpRGBa Ipixelplan;
-          if (getPixel(ip, Ipixelplan)) {
-            *(bitmap + i * width + j) = Ipixelplan;
-            nb_point_dessine++;
-          }
-        }
-      }
-    }
+    if (colorI == GRAY_SCALED)
+      rasterize(I, Ig, cam, NULL);
+    else if (colorI == COLORED)
+      rasterize(I, Ic, cam, NULL);
   }
 }
 
@@ -452,36 +542,8 @@ void vpImageSimulator::getImage(vpImage<vpRGBa> &I, vpImage<vpRGBa> &Isrc, const
     }
   }
 
-  if (visible) {
-    if (!needClipping)
-      getRoi(I.getWidth(), I.getHeight(), cam, pt, rect);
-    else
-      getRoi(I.getWidth(), I.getHeight(), cam, ptClipped, rect);
-
-    double top = rect.getTop();
-    double bottom = rect.getBottom();
-    double left = rect.getLeft();
-    double right = rect.getRight();
-
-    vpRGBa *bitmap = I.bitmap;
-    unsigned int width = I.getWidth();
-    vpImagePoint ip;
-    int nb_point_dessine = 0;
-
-    for (unsigned int i = (unsigned int)top; i < (unsigned int)bottom; i++) {
-      for (unsigned int j = (unsigned int)left; j < (unsigned int)right; j++) {
-        double x = 0, y = 0;
-        ip.set_ij(i, j);
-        vpPixelMeterConversion::convertPoint(cam, ip, x, y);
-        ip.set_ij(y, x);
-        vpRGBa Ipixelplan;
-        if (getPixel(Isrc, ip, Ipixelplan)) {
-          *(bitmap + i * width + j) = Ipixelplan;
-          nb_point_dessine++;
-        }
-      }
-    }
-  }
+  if (visible)
+    rasterize(I, Isrc, cam, NULL);
 }
 
 /*!
@@ -513,52 +575,10 @@ void vpImageSimulator::getImage(vpImage<vpRGBa> &I, const vpCameraParameters &ca
     }
   }
   if (visible) {
-    if (!needClipping)
-      getRoi(I.getWidth(), I.getHeight(), cam, pt, rect);
-    else
-      getRoi(I.getWidth(), I.getHeight(), cam, ptClipped, rect);
-
-    double top = rect.getTop();
-    double bottom = rect.getBottom();
-    double left = rect.getLeft();
-    double right = rect.getRight();
-
-    vpRGBa *bitmap = I.bitmap;
-    unsigned int width = I.getWidth();
-    vpImagePoint ip;
-    int nb_point_dessine = 0;
-
-    for (unsigned int i = (unsigned int)top; i < (unsigned int)bottom; i++) {
-      for (unsigned int j = (unsigned int)left; j < (unsigned int)right; j++) {
-        double x = 0, y = 0;
-        ip.set_ij(i, j);
-        vpPixelMeterConversion::convertPoint(cam, ip, x, y);
-        ip.set_ij(y, x);
-        if (colorI == GRAY_SCALED) {
-          unsigned char Ipixelplan;
-          if (getPixel(ip, Ipixelplan)) {
-            if (Xinter_optim[2] < zBuffer[i][j] || zBuffer[i][j] < 0) {
-              vpRGBa pixelcolor;
-              pixelcolor.R = Ipixelplan;
-              pixelcolor.G = Ipixelplan;
-              pixelcolor.B = Ipixelplan;
-              *(bitmap + i * width + j) = pixelcolor;
-              nb_point_dessine++;
-              zBuffer[i][j] = Xinter_optim[2];
-            }
-          }
-        } else if (colorI == COLORED) {
-          vpRGBa Ipixelplan;
-          if (getPixel(ip, Ipixelplan)) {
-            if (Xinter_optim[2] < zBuffer[i][j] || zBuffer[i][j] < 0) {
-              *(bitmap + i * width + j) = Ipixelplan;
-              nb_point_dessine++;
-              zBuffer[i][j] = Xinter_optim[2];
-            }
-          }
-        }
-      }
-    }
+    if (colorI == GRAY_SCALED)
+      rasterize(I, Ig, cam, &zBuffer);
+    else if (colorI == COLORED)
+      rasterize(I, Ic, cam, &zBuffer);
   }
 }
 
@@ -669,93 +689,8 @@ void vpImageSimulator::getImage(vpImage<vpRGBa> &I, const vpCameraParameters &ca
 void vpImageSimulator::getImage(vpImage<unsigned char> &I, std::list<vpImageSimulator> &list,
                                 const vpCameraParameters &cam)
 {
-
-  unsigned int width = I.getWidth();
-  unsigned int height = I.getHeight();
-
-  unsigned int nbsimList = (unsigned int)list.size();
-
-  if (nbsimList < 1)
-    return;
-
-  vpImageSimulator **simList = new vpImageSimulator *[nbsimList];
-
-  double topFinal = height + 1;
-  ;
-  double bottomFinal = -1;
-  double leftFinal = width + 1;
-  double rightFinal = -1;
-
-  unsigned int unvisible = 0;
-  unsigned int indexSimu = 0;
-  for (std::list<vpImageSimulator>::iterator it = list.begin(); it != list.end(); ++it, ++indexSimu) {
-    vpImageSimulator *sim = &(*it);
-    if (sim->visible)
-      simList[indexSimu] = sim;
-    else
-      unvisible++;
-  }
-  nbsimList = nbsimList - unvisible;
-
-  if (nbsimList < 1) {
-    delete[] simList;
-    return;
-  }
-
-  for (unsigned int i = 0; i < nbsimList; i++) {
-    if (!simList[i]->needClipping)
-      simList[i]->getRoi(width, height, cam, simList[i]->pt, simList[i]->rect);
-    else
-      simList[i]->getRoi(width, height, cam, simList[i]->ptClipped, simList[i]->rect);
-
-    if (topFinal > simList[i]->rect.getTop())
-      topFinal = simList[i]->rect.getTop();
-    if (bottomFinal < simList[i]->rect.getBottom())
-      bottomFinal = simList[i]->rect.getBottom();
-    if (leftFinal > simList[i]->rect.getLeft())
-      leftFinal = simList[i]->rect.getLeft();
-    if (rightFinal < simList[i]->rect.getRight())
-      rightFinal = simList[i]->rect.getRight();
-  }
-
-  double zmin = -1;
-  int indice = -1;
-  unsigned char *bitmap = I.bitmap;
-  vpImagePoint ip;
-
-  for (unsigned int i = (unsigned int)topFinal; i < (unsigned int)bottomFinal; i++) {
-    for (unsigned int j = (unsigned int)leftFinal; j < (unsigned int)rightFinal; j++) {
-      zmin = -1;
-      double x = 0, y = 0;
-      ip.set_ij(i, j);
-      vpPixelMeterConversion::convertPoint(cam, ip, x, y);
-      ip.set_ij(y, x);
-      for (int k = 0; k < (int)nbsimList; k++) {
-        double z = 0;
-        if (simList[k]->getPixelDepth(ip, z)) {
-          if (z < zmin || zmin < 0) {
-            zmin = z;
-            indice = k;
-          }
-        }
-      }
-      if (indice >= 0) {
-        if (simList[indice]->colorI == GRAY_SCALED) {
-          unsigned char Ipixelplan = 255;
-          simList[indice]->getPixel(ip, Ipixelplan);
-          *(bitmap + i * width + j) = Ipixelplan;
-        } else if (simList[indice]->colorI == COLORED) {
-          vpRGBa Ipixelplan(255, 255, 255);
-          simList[indice]->getPixel(ip, Ipixelplan);
-          unsigned char pixelgrey =
-              (unsigned char)(0.2126 * Ipixelplan.R + 0.7152 * Ipixelplan.G + 0.0722 * Ipixelplan.B);
-          *(bitmap + i * width + j) = pixelgrey;
-        }
-      }
-    }
-  }
-
-  delete[] simList;
+  vpImage<float> depth;
+  rasterize(I, list, cam, depth);
 }
 
 /*!
@@ -866,98 +801,52 @@ void vpImageSimulator::getImage(vpImage<unsigned char> &I, std::list<vpImageSimu
 */
 void vpImageSimulator::getImage(vpImage<vpRGBa> &I, std::list<vpImageSimulator> &list, const vpCameraParameters &cam)
 {
+  vpImage<float> depth;
+  rasterize(I, list, cam, depth);
+}
 
-  unsigned int width = I.getWidth();
-  unsigned int height = I.getHeight();
-
-  unsigned int nbsimList = (unsigned int)list.size();
-
-  if (nbsimList < 1)
-    return;
-
-  vpImageSimulator **simList = new vpImageSimulator *[nbsimList];
-
-  double topFinal = height + 1;
-  ;
-  double bottomFinal = -1;
-  double leftFinal = width + 1;
-  double rightFinal = -1;
-
-  unsigned int unvisible = 0;
-  unsigned int indexSimu = 0;
-  for (std::list<vpImageSimulator>::iterator it = list.begin(); it != list.end(); ++it, ++indexSimu) {
-    vpImageSimulator *sim = &(*it);
-    if (sim->visible)
-      simList[indexSimu] = sim;
-    else
-      unvisible++;
-  }
+/*!
+  Get the view of the virtual camera with a list of projected images, as
+  getImage(vpImage<unsigned char> &, std::list<vpImageSimulator> &, const vpCameraParameters &),
+  and retrieve the depth buffer used to manage the occlusions.
 
-  nbsimList = nbsimList - unvisible;
+  All the planes are scan-converted in a single pass over the image rows. To
+  avoid reallocations when a sequence of images is generated, the same \e
+  depth image should be given at each call.
 
-  if (nbsimList < 1) {
-    delete[] simList;
-    return;
-  }
+  \param I : The image used to store the result.
+  \param list : List of vpImageSimulator to project.
+  \param cam : The parameters of the virtual camera.
+  \param depth : Depth buffer resized to the size of \e I. It contains the
+  z coordinates in the camera frame of the projected images, or -1 for the
+  pixels where no image is projected.
+*/
+void vpImageSimulator::getImage(vpImage<unsigned char> &I, std::list<vpImageSimulator> &list,
+                                const vpCameraParameters &cam, vpImage<float> &depth)
+{
+  rasterize(I, list, cam, depth);
+}
 
-  for (unsigned int i = 0; i < nbsimList; i++) {
-    if (!simList[i]->needClipping)
-      simList[i]->getRoi(width, height, cam, simList[i]->pt, simList[i]->rect);
-    else
-      simList[i]->getRoi(width, height, cam, simList[i]->ptClipped, simList[i]->rect);
-
-    if (topFinal > simList[i]->rect.getTop())
-      topFinal = simList[i]->rect.getTop();
-    if (bottomFinal < simList[i]->rect.getBottom())
-      bottomFinal = simList[i]->rect.getBottom();
-    if (leftFinal > simList[i]->rect.getLeft())
-      leftFinal = simList[i]->rect.getLeft();
-    if (rightFinal < simList[i]->rect.getRight())
-      rightFinal = simList[i]->rect.getRight();
-  }
+/*!
+  Get the view of the virtual camera with a list of projected images, as
+  getImage(vpImage<vpRGBa> &, std::list<vpImageSimulator> &, const vpCameraParameters &),
+  and retrieve the depth buffer used to manage the occlusions.
 
-  double zmin = -1;
-  int indice = -1;
-  vpRGBa *bitmap = I.bitmap;
-  vpImagePoint ip;
-
-  for (unsigned int i = (unsigned int)topFinal; i < (unsigned int)bottomFinal; i++) {
-    for (unsigned int j = (unsigned int)leftFinal; j < (unsigned int)rightFinal; j++) {
-      zmin = -1;
-      double x = 0, y = 0;
-      ip.set_ij(i, j);
-      vpPixelMeterConversion::convertPoint(cam, ip, x, y);
-      ip.set_ij(y, x);
-      for (int k = 0; k < (int)nbsimList; k++) {
-        double z = 0;
-        if (simList[k]->getPixelDepth(ip, z)) {
-          if (z < zmin || zmin < 0) {
-            zmin = z;
-            indice = k;
-          }
-        }
-      }
-      if (indice >= 0) {
-        if (simList[indice]->colorI == GRAY_SCALED) {
-          unsigned char Ipixelplan = 255;
-          simList[indice]->getPixel(ip, Ipixelplan);
-          vpRGBa pixelcolor;
-          pixelcolor.R = Ipixelplan;
-          pixelcolor.G = Ipixelplan;
-          pixelcolor.B = Ipixelplan;
-          *(bitmap + i * width + j) = pixelcolor;
-        } else if (simList[indice]->colorI == COLORED) {
-          vpRGBa Ipixelplan(255, 255, 255);
-          simList[indice]->getPixel(ip, Ipixelplan);
-          // unsigned char pixelgrey = 0.2126 * Ipixelplan.R + 0.7152 *
-          // Ipixelplan.G + 0.0722 * Ipixelplan.B;
-          *(bitmap + i * width + j) = Ipixelplan;
-        }
-      }
-    }
-  }
+  All the planes are scan-converted in a single pass over the image rows. To
+  avoid reallocations when a sequence of images is generated, the same \e
+  depth image should be given at each call.
 
-  delete[] simList;
+  \param I : The image used to store the result.
+  \param list : List of vpImageSimulator to project.
+  \param cam : The parameters of the virtual camera.
+  \param depth : Depth buffer resized to the size of \e I. It contains the
+  z coordinates in the camera frame of the projected images, or -1 for the
+  pixels where no image is projected.
+*/
+void vpImageSimulator::getImage(vpImage<vpRGBa> &I, std::list<vpImageSimulator> &list, const vpCameraParameters &cam,
+                                vpImage<float> &depth)
+{
+  rasterize(I, list, cam, depth);
 }
 
 /*!
@@ -1026,12 +915,42 @@ void vpImageSimulator::setCameraPosition(const vpHomogeneousMatrix &cMt_)
       vbase_v_optim[i] = vbase_v[i];
     }
 
+    // The texture coordinates of the intersection of the ray p = (x, y, 1)
+    // with the plane are u = ((z p - X0).vbase_u) / |vbase_u|^2 with
+    // z = distance / n.p, ie. a ratio of two affine functions of p
+    double X0_u = vpColVector::dotProd(X2[0], vbase_u);
+    double X0_v = vpColVector::dotProd(X2[0], vbase_v);
+    for (unsigned int i = 0; i < 3; i++) {
+      uCoef[i] = (distance * vbase_u[i] - X0_u * normal_Cam[i]) / (euclideanNorm_u * euclideanNorm_u);
+      vCoef[i] = (distance * vbase_v[i] - X0_v * normal_Cam[i]) / (euclideanNorm_v * euclideanNorm_v);
+    }
+
     std::vector<vpPoint> *ptPtr = &pt;
     if (needClipping) {
       vpPolygon3D::getClippedPolygon(pt, ptClipped, cMt, vpPolygon3D::NEAR_CLIPPING);
       ptPtr = &ptClipped;
     }
 
+    // Edges of the projected polygon oriented so that the inside is positive
+    size_t nbPts = (*ptPtr).size();
+    double area = 0;
+    for (size_t i = 0; i < nbPts; i++) {
+      const vpPoint &p0 = (*ptPtr)[i];
+      const vpPoint &p1 = (*ptPtr)[(i + 1) % nbPts];
+      area += p0.get_x() * p1.get_y() - p1.get_x() * p0.get_y();
+    }
+    double orientation = (area >= 0) ? 1. : -1.;
+    edgeCoef.resize(3 * nbPts);
+    for (size_t i = 0; i < nbPts; i++) {
+      const vpPoint &p0 = (*ptPtr)[i];
+      const vpPoint &p1 = (*ptPtr)[(i + 1) % nbPts];
+      double dx = p1.get_x() - p0.get_x();
+      double dy = p1.get_y() - p0.get_y();
+      edgeCoef[3 * i] = -orientation * dy;
+      edgeCoef[3 * i + 1] = orientation * dx;
+      edgeCoef[3 * i + 2] = orientation * (dy * p0.get_x() - dx * p0.get_y());
+    }
+
     listTriangle.clear();
     for (unsigned int i = 1; i < (*ptPtr).size() - 1; i++) {
       vpImagePoint ip1, ip2, ip3;
@@ -1231,237 +1150,6 @@ void vpImageSimulator::init(const char *file_image, const std::vector<vpPoint> &
 }
 #endif
 
-bool vpImageSimulator::getPixel(const vpImagePoint &iP, unsigned char &Ipixelplan)
-{
-  //  std::cout << "In get Pixel" << std::endl;
-  // test si pixel dans zone projetee
-  bool inside = false;
-  for (unsigned int i = 0; i < listTriangle.size(); i++)
-    if (listTriangle[i].inTriangle(iP)) {
-      inside = true;
-      break;
-    }
-  if (!inside)
-    return false;
-
-  //  if(!T1.inTriangle(iP) && !T2.inTriangle(iP)){
-  ////      std::cout << "The pixel is inside the projected area" <<
-  /// std::endl;
-  //    return false;}
-
-  // methoed algebrique
-  double z;
-
-  // calcul de la profondeur de l'intersection
-  z = distance / (normal_Cam_optim[0] * iP.get_u() + normal_Cam_optim[1] * iP.get_v() + normal_Cam_optim[2]);
-  // calcul coordonnees 3D intersection
-  Xinter_optim[0] = iP.get_u() * z;
-  Xinter_optim[1] = iP.get_v() * z;
-  Xinter_optim[2] = z;
-
-  // recuperation des coordonnes de l'intersection dans le plan objet
-  // repere plan object :
-  //	centre = X0_2_optim[i] (premier point definissant le plan)
-  //	base =  u:(X[1]-X[0]) et v:(X[3]-X[0])
-  // ici j'ai considere que le plan est un rectangle => coordonnees sont
-  // simplement obtenu par un produit scalaire
-  double u = 0, v = 0;
-  for (unsigned int i = 0; i < 3; i++) {
-    double diff = (Xinter_optim[i] - X0_2_optim[i]);
-    u += diff * vbase_u_optim[i];
-    v += diff * vbase_v_optim[i];
-  }
-  u = u / (euclideanNorm_u * euclideanNorm_u);
-  v = v / (euclideanNorm_v * euclideanNorm_v);
-
-  if (u > 0 && v > 0 && u < 1. && v < 1.) {
-    double i2, j2;
-    i2 = v * (Ig.getHeight() - 1);
-    j2 = u * (Ig.getWidth() - 1);
-    if (interp == BILINEAR_INTERPOLATION)
-      Ipixelplan = Ig.getValue(i2, j2);
-    else if (interp == SIMPLE)
-      Ipixelplan = Ig[(unsigned int)i2][(unsigned int)j2];
-    return true;
-  } else
-    return false;
-}
-
-bool vpImageSimulator::getPixel(vpImage<unsigned char> &Isrc, const vpImagePoint &iP, unsigned char &Ipixelplan)
-{
-  // test si pixel dans zone projetee
-  bool inside = false;
-  for (unsigned int i = 0; i < listTriangle.size(); i++)
-    if (listTriangle[i].inTriangle(iP)) {
-      inside = true;
-      break;
-    }
-  if (!inside)
-    return false;
-
-  //  if(!T1.inTriangle(iP) && !T2.inTriangle(iP))
-  //    return false;
-
-  // methoed algebrique
-  double z;
-
-  // calcul de la profondeur de l'intersection
-  z = distance / (normal_Cam_optim[0] * iP.get_u() + normal_Cam_optim[1] * iP.get_v() + normal_Cam_optim[2]);
-  // calcul coordonnees 3D intersection
-  Xinter_optim[0] = iP.get_u() * z;
-  Xinter_optim[1] = iP.get_v() * z;
-  Xinter_optim[2] = z;
-
-  // recuperation des coordonnes de l'intersection dans le plan objet
-  // repere plan object :
-  //	centre = X0_2_optim[i] (premier point definissant le plan)
-  //	base =  u:(X[1]-X[0]) et v:(X[3]-X[0])
-  // ici j'ai considere que le plan est un rectangle => coordonnees sont
-  // simplement obtenu par un produit scalaire
-  double u = 0, v = 0;
-  for (unsigned int i = 0; i < 3; i++) {
-    double diff = (Xinter_optim[i] - X0_2_optim[i]);
-    u += diff * vbase_u_optim[i];
-    v += diff * vbase_v_optim[i];
-  }
-  u = u / (euclideanNorm_u * euclideanNorm_u);
-  v = v / (euclideanNorm_v * euclideanNorm_v);
-
-  if (u > 0 && v > 0 && u < 1. && v < 1.) {
-    double i2, j2;
-    i2 = v * (Isrc.getHeight() - 1);
-    j2 = u * (Isrc.getWidth() - 1);
-    if (interp == BILINEAR_INTERPOLATION)
-      Ipixelplan = Isrc.getValue(i2, j2);
-    else if (interp == SIMPLE)
-      Ipixelplan = Isrc[(unsigned int)i2][(unsigned int)j2];
-    return true;
-  } else
-    return false;
-}
-
-bool vpImageSimulator::getPixel(const vpImagePoint &iP, vpRGBa &Ipixelplan)
-{
-  // test si pixel dans zone projetee
-  bool inside = false;
-  for (unsigned int i = 0; i < listTriangle.size(); i++)
-    if (listTriangle[i].inTriangle(iP)) {
-      inside = true;
-      break;
-    }
-  if (!inside)
-    return false;
-  //  if(!T1.inTriangle(iP) && !T2.inTriangle(iP))
-  //    return false;
-
-  // methoed algebrique
-  double z;
-
-  // calcul de la profondeur de l'intersection
-  z = distance / (normal_Cam_optim[0] * iP.get_u() + normal_Cam_optim[1] * iP.get_v() + normal_Cam_optim[2]);
-  // calcul coordonnees 3D intersection
-  Xinter_optim[0] = iP.get_u() * z;
-  Xinter_optim[1] = iP.get_v() * z;
-  Xinter_optim[2] = z;
-
-  // recuperation des coordonnes de l'intersection dans le plan objet
-  // repere plan object :
-  //	centre = X0_2_optim[i] (premier point definissant le plan)
-  //	base =  u:(X[1]-X[0]) et v:(X[3]-X[0])
-  // ici j'ai considere que le plan est un rectangle => coordonnees sont
-  // simplement obtenu par un produit scalaire
-  double u = 0, v = 0;
-  for (unsigned int i = 0; i < 3; i++) {
-    double diff = (Xinter_optim[i] - X0_2_optim[i]);
-    u += diff * vbase_u_optim[i];
-    v += diff * vbase_v_optim[i];
-  }
-  u = u / (euclideanNorm_u * euclideanNorm_u);
-  v = v / (euclideanNorm_v * euclideanNorm_v);
-
-  if (u > 0 && v > 0 && u < 1. && v < 1.) {
-    double i2, j2;
-    i2 = v * (Ic.getHeight() - 1);
-    j2 = u * (Ic.getWidth() - 1);
-    if (interp == BILINEAR_INTERPOLATION)
-      Ipixelplan = Ic.getValue(i2, j2);
-    else if (interp == SIMPLE)
-      Ipixelplan = Ic[(unsigned int)i2][(unsigned int)j2];
-    return true;
-  } else
-    return false;
-}
-
-bool vpImageSimulator::getPixel(vpImage<vpRGBa> &Isrc, const vpImagePoint &iP, vpRGBa &Ipixelplan)
-{
-  // test si pixel dans zone projetee
-  //  if(!T1.inTriangle(iP) && !T2.inTriangle(iP))
-  //    return false;
-  bool inside = false;
-  for (unsigned int i = 0; i < listTriangle.size(); i++)
-    if (listTriangle[i].inTriangle(iP)) {
-      inside = true;
-      break;
-    }
-  if (!inside)
-    return false;
-
-  // methoed algebrique
-  double z;
-
-  // calcul de la profondeur de l'intersection
-  z = distance / (normal_Cam_optim[0] * iP.get_u() + normal_Cam_optim[1] * iP.get_v() + normal_Cam_optim[2]);
-  // calcul coordonnees 3D intersection
-  Xinter_optim[0] = iP.get_u() * z;
-  Xinter_optim[1] = iP.get_v() * z;
-  Xinter_optim[2] = z;
-
-  // recuperation des coordonnes de l'intersection dans le plan objet
-  // repere plan object :
-  //	centre = X0_2_optim[i] (premier point definissant le plan)
-  //	base =  u:(X[1]-X[0]) et v:(X[3]-X[0])
-  // ici j'ai considere que le plan est un rectangle => coordonnees sont
-  // simplement obtenu par un produit scalaire
-  double u = 0, v = 0;
-  for (unsigned int i = 0; i < 3; i++) {
-    double diff = (Xinter_optim[i] - X0_2_optim[i]);
-    u += diff * vbase_u_optim[i];
-    v += diff * vbase_v_optim[i];
-  }
-  u = u / (euclideanNorm_u * euclideanNorm_u);
-  v = v / (euclideanNorm_v * euclideanNorm_v);
-
-  if (u > 0 && v > 0 && u < 1. && v < 1.) {
-    double i2, j2;
-    i2 = v * (Isrc.getHeight() - 1);
-    j2 = u * (Isrc.getWidth() - 1);
-    if (interp == BILINEAR_INTERPOLATION)
-      Ipixelplan = Isrc.getValue(i2, j2);
-    else if (interp == SIMPLE)
-      Ipixelplan = Isrc[(unsigned int)i2][(unsigned int)j2];
-    return true;
-  } else
-    return false;
-}
-
-bool vpImageSimulator::getPixelDepth(const vpImagePoint &iP, double &Zpixelplan)
-{
-  // test si pixel dans zone projetee
-  bool inside = false;
-  for (unsigned int i = 0; i < listTriangle.size(); i++)
-    if (listTriangle[i].inTriangle(iP)) {
-      inside = true;
-      break;
-    }
-  if (!inside)
-    return false;
-  //  if(!T1.inTriangle(iP) && !T2.inTriangle(iP))
-  //    return false;
-
-  Zpixelplan = distance / (normal_Cam_optim[0] * iP.get_u() + normal_Cam_optim[1] * iP.get_v() + normal_Cam_optim[2]);
-  return true;
-}
-
 bool vpImageSimulator::getPixelVisibility(const vpImagePoint &iP, double &Visipixelplan)
 {
   // test si pixel dans zone projetee
@@ -0,0 +1,182 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test vpImageSimulator scanline rendering.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testImageSimulator.cpp
+
+  Test vpImageSimulator scanline rendering against a per pixel ray casting
+  and the depth management of a list of planes.
+*/
+
+#include <cmath>
+#include <iostream>
+#include <list>
+
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpPixelMeterConversion.h>
+#include <visp3/robot/vpImageSimulator.h>
+
+namespace
+{
+void initCorners(vpColVector *X, double half_size, double Z)
+{
+  for (unsigned int i = 0; i < 4; i++)
+    X[i].resize(3);
+  X[0][0] = -half_size; X[0][1] = -half_size; X[0][2] = Z;
+  X[1][0] =  half_size; X[1][1] = -half_size; X[1][2] = Z;
+  X[2][0] =  half_size; X[2][1] =  half_size; X[2][2] = Z;
+  X[3][0] = -half_size; X[3][1] =  half_size; X[3][2] = Z;
+}
+
+// Reference rendering: intersect the ray of each pixel with the plane
+void rayCasting(const vpImage<unsigned char> &texture, vpColVector *X, const vpHomogeneousMatrix &cMo,
+                const vpCameraParameters &cam, vpImage<unsigned char> &I)
+{
+  vpColVector cX[4];
+  for (unsigned int k = 0; k < 4; k++) {
+    vpColVector oX(4, 1.);
+    oX[0] = X[k][0]; oX[1] = X[k][1]; oX[2] = X[k][2];
+    vpColVector c = cMo * oX;
+    cX[k].resize(3);
+    cX[k][0] = c[0]; cX[k][1] = c[1]; cX[k][2] = c[2];
+  }
+  vpColVector eu = cX[1] - cX[0];
+  vpColVector ev = cX[3] - cX[0];
+  vpColVector n = vpColVector::crossProd(eu, ev);
+  double d = vpColVector::dotProd(n, cX[0]);
+
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      double x = 0, y = 0;
+      vpPixelMeterConversion::convertPoint(cam, (double)j, (double)i, x, y);
+      vpColVector p(3, 1.);
+      p[0] = x;
+      p[1] = y;
+      double z = d / vpColVector::dotProd(n, p);
+      if (z <= 0)
+        continue;
+      vpColVector diff = p * z - cX[0];
+      double u = vpColVector::dotProd(diff, eu) / eu.sumSquare();
+      double v = vpColVector::dotProd(diff, ev) / ev.sumSquare();
+      if (u > 0 && v > 0 && u < 1. && v < 1.)
+        I[i][j] = texture[(unsigned int)(v * (texture.getHeight() - 1))][(unsigned int)(u * (texture.getWidth() - 1))];
+    }
+  }
+}
+}
+
+int main()
+{
+  try {
+    vpCameraParameters cam(600, 600, 320, 240);
+
+    vpImage<unsigned char> texture(100, 120);
+    for (unsigned int i = 0; i < texture.getHeight(); i++)
+      for (unsigned int j = 0; j < texture.getWidth(); j++)
+        texture[i][j] = (unsigned char)((i * 7 + j * 3) % 256);
+
+    vpColVector X[4];
+    initCorners(X, 0.1, 0);
+
+    vpImageSimulator sim(vpImageSimulator::GRAY_SCALED);
+    sim.init(texture, X);
+
+    std::cout << "** Test single plane rendering" << std::endl;
+    for (int k = 0; k < 4; k++) {
+      vpHomogeneousMatrix cMo(0.01 * k, -0.02, 0.5, vpMath::rad(10. * k), vpMath::rad(-15. + 5 * k), vpMath::rad(30.));
+      sim.setCameraPosition(cMo);
+
+      vpImage<unsigned char> I(480, 640, 0), Iref(480, 640, 0);
+      sim.getImage(I, cam);
+      rayCasting(texture, X, cMo, cam, Iref);
+
+      unsigned int nbRendered = 0, nbDiff = 0;
+      for (unsigned int i = 0; i < I.getHeight(); i++) {
+        for (unsigned int j = 0; j < I.getWidth(); j++) {
+          if (Iref[i][j] != 0)
+            nbRendered++;
+          if (I[i][j] != Iref[i][j])
+            nbDiff++;
+        }
+      }
+      std::cout << "Pose " << k << ": " << nbRendered << " rendered pixels, " << nbDiff << " differences"
+                << std::endl;
+      // Only a few pixels on the border of the projected plane may differ
+      if (nbRendered == 0 || nbDiff > 0.02 * nbRendered) {
+        std::cerr << "Scanline rendering differs from ray casting" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    std::cout << "** Test depth management with a list of planes" << std::endl;
+    vpImage<unsigned char> Ifront(10, 10, 50), Iback(10, 10, 200);
+    vpColVector Xfront[4], Xback[4];
+    initCorners(Xfront, 0.05, 0);
+    initCorners(Xback, 0.2, 0.5);
+
+    std::list<vpImageSimulator> list;
+    vpImageSimulator front(vpImageSimulator::GRAY_SCALED), back(vpImageSimulator::GRAY_SCALED);
+    // Add the back plane first so that the depth test is required
+    back.init(Iback, Xback);
+    back.setCameraPosition(vpHomogeneousMatrix(0, 0, 0.5, 0, 0, 0));
+    list.push_back(back);
+    front.init(Ifront, Xfront);
+    front.setCameraPosition(vpHomogeneousMatrix(0, 0, 0.5, 0, 0, 0));
+    list.push_back(front);
+
+    vpImage<unsigned char> I(480, 640, 0);
+    vpImage<float> depth;
+    vpImageSimulator::getImage(I, list, cam, depth);
+
+    if (I[240][320] != 50 || std::fabs(depth[240][320] - 0.5f) > 1e-4f) {
+      std::cerr << "Bad front plane: " << (unsigned int)I[240][320] << " at depth " << depth[240][320] << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (I[240][420] != 200 || std::fabs(depth[240][420] - 1.f) > 1e-4f) {
+      std::cerr << "Bad back plane: " << (unsigned int)I[240][420] << " at depth " << depth[240][420] << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (I[10][10] != 0 || depth[10][10] >= 0) {
+      std::cerr << "Bad background: " << (unsigned int)I[10][10] << " at depth " << depth[10][10] << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::cout << "Test succeed" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const vpException &e) {
+    std::cout << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+}
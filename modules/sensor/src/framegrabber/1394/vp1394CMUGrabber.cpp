@@ -45,6 +45,7 @@
 #include <iostream>
 
 #include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpTracing.h>
 #include <visp3/sensor/vp1394CMUGrabber.h>
 
 /*!
@@ -209,6 +210,7 @@ void vp1394CMUGrabber::open(vpImage<vpRGBa> &I)
   */
 void vp1394CMUGrabber::acquire(vpImage<unsigned char> &I)
 {
+  VP_TRACING_SCOPE("vp1394CMUGrabber::acquire");
   // get image data
   unsigned long length;
   unsigned char *rawdata = NULL;
@@ -271,6 +273,7 @@ void vp1394CMUGrabber::acquire(vpImage<unsigned char> &I)
  */
 void vp1394CMUGrabber::acquire(vpImage<vpRGBa> &I)
 {
+  VP_TRACING_SCOPE("vp1394CMUGrabber::acquire");
   // get image data
   unsigned long length;
   unsigned char *rawdata = NULL;
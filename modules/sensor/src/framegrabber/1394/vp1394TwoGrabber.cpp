@@ -54,6 +54,7 @@
 #include <visp3/core/vpFrameGrabberException.h>
 #include <visp3/core/vpImageConvert.h>
 #include <visp3/core/vpTime.h>
+#include <visp3/core/vpTracing.h>
 #include <visp3/sensor/vp1394TwoGrabber.h>
 
 const char *vp1394TwoGrabber::strVideoMode[DC1394_VIDEO_MODE_NUM] = {
@@ -2506,6 +2507,7 @@ void vp1394TwoGrabber::enqueue(dc1394video_frame_t *frame)
 */
 void vp1394TwoGrabber::acquire(vpImage<unsigned char> &I)
 {
+  VP_TRACING_SCOPE("vp1394TwoGrabber::acquire");
   uint64_t timestamp;
   uint32_t id;
 
@@ -2535,6 +2537,7 @@ void vp1394TwoGrabber::acquire(vpImage<unsigned char> &I)
 */
 void vp1394TwoGrabber::acquire(vpImage<unsigned char> &I, uint64_t &timestamp, uint32_t &id)
 {
+  VP_TRACING_SCOPE("vp1394TwoGrabber::acquire");
   dc1394video_frame_t *frame;
 
   open();
@@ -2557,6 +2560,7 @@ void vp1394TwoGrabber::acquire(vpImage<unsigned char> &I, uint64_t &timestamp, u
 */
 void vp1394TwoGrabber::acquire(vpImage<vpRGBa> &I)
 {
+  VP_TRACING_SCOPE("vp1394TwoGrabber::acquire");
   uint64_t timestamp;
   uint32_t id;
   dc1394video_frame_t *frame;
@@ -2586,6 +2590,7 @@ void vp1394TwoGrabber::acquire(vpImage<vpRGBa> &I)
 */
 void vp1394TwoGrabber::acquire(vpImage<vpRGBa> &I, uint64_t &timestamp, uint32_t &id)
 {
+  VP_TRACING_SCOPE("vp1394TwoGrabber::acquire");
   dc1394video_frame_t *frame;
 
   open();
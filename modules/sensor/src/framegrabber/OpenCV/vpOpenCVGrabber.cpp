@@ -47,6 +47,7 @@
 
 #include <visp3/core/vpFrameGrabberException.h>
 #include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpTracing.h>
 
 #include <iostream>
 #include <math.h>
@@ -119,6 +120,7 @@ void vpOpenCVGrabber::open(vpImage<vpRGBa> & /*I*/) { open(); }
 */
 void vpOpenCVGrabber::acquire(vpImage<unsigned char> &I)
 {
+  VP_TRACING_SCOPE("vpOpenCVGrabber::acquire");
   IplImage *im;
 
   if (init == false) {
@@ -141,6 +143,7 @@ void vpOpenCVGrabber::acquire(vpImage<unsigned char> &I)
 */
 void vpOpenCVGrabber::acquire(vpImage<vpRGBa> &I)
 {
+  VP_TRACING_SCOPE("vpOpenCVGrabber::acquire");
   IplImage *im;
 
   if (init == false) {
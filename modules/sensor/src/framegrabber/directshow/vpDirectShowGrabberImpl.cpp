@@ -40,6 +40,7 @@
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 
 #include <visp3/core/vpConfig.h>
+#include <visp3/core/vpTracing.h>
 #if (defined(VISP_HAVE_DIRECTSHOW))
 
 #include <visp3/sensor/vpDirectShowGrabberImpl.h>
@@ -583,6 +584,7 @@ bool vpDirectShowGrabberImpl::removeAll()
 */
 void vpDirectShowGrabberImpl::acquire(vpImage<vpRGBa> &I)
 {
+  VP_TRACING_SCOPE("vpDirectShowGrabber::acquire");
   if (init == false) {
     close();
     throw(vpFrameGrabberException(vpFrameGrabberException::initializationError, "Initialization not done"));
@@ -619,6 +621,7 @@ void vpDirectShowGrabberImpl::acquire(vpImage<vpRGBa> &I)
 */
 void vpDirectShowGrabberImpl::acquire(vpImage<unsigned char> &I)
 {
+  VP_TRACING_SCOPE("vpDirectShowGrabber::acquire");
   if (init == false) {
     close();
     throw(vpFrameGrabberException(vpFrameGrabberException::initializationError, "Initialization not done"));
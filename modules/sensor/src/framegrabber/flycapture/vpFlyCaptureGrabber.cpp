@@ -48,6 +48,7 @@
 #ifdef VISP_HAVE_FLYCAPTURE
 
 #include <visp3/core/vpTime.h>
+#include <visp3/core/vpTracing.h>
 
 /*!
    Default constructor that consider the first camera found on the bus as
@@ -1112,6 +1113,7 @@ void vpFlyCaptureGrabber::acquire(vpImage<unsigned char> &I)
 */
 void vpFlyCaptureGrabber::acquire(vpImage<unsigned char> &I, FlyCapture2::TimeStamp &timestamp)
 {
+  VP_TRACING_SCOPE("vpFlyCaptureGrabber::acquire");
   this->open();
 
   FlyCapture2::Error error;
@@ -1164,6 +1166,7 @@ void vpFlyCaptureGrabber::acquire(vpImage<vpRGBa> &I)
 */
 void vpFlyCaptureGrabber::acquire(vpImage<vpRGBa> &I, FlyCapture2::TimeStamp &timestamp)
 {
+  VP_TRACING_SCOPE("vpFlyCaptureGrabber::acquire");
   this->open();
 
   FlyCapture2::Error error;
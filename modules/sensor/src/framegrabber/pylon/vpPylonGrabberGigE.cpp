@@ -47,6 +47,7 @@
 
 #include <visp3/core/vpException.h>
 #include <visp3/core/vpTime.h>
+#include <visp3/core/vpTracing.h>
 
 /*!
    Default constructor that consider the first camera found on the bus as
@@ -650,6 +651,7 @@ void vpPylonGrabberGigE::close()
 */
 void vpPylonGrabberGigE::acquire(vpImage<unsigned char> &I)
 {
+  VP_TRACING_SCOPE("vpPylonGrabberGigE::acquire");
   open();
 
   Pylon::CGrabResultPtr grabResult;
@@ -679,6 +681,7 @@ void vpPylonGrabberGigE::acquire(vpImage<unsigned char> &I)
 */
 void vpPylonGrabberGigE::acquire(vpImage<vpRGBa> &I)
 {
+  VP_TRACING_SCOPE("vpPylonGrabberGigE::acquire");
   open();
 
   Pylon::CGrabResultPtr grabResult;
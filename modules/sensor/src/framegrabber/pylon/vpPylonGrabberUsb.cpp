@@ -47,6 +47,7 @@
 
 #include <visp3/core/vpException.h>
 #include <visp3/core/vpTime.h>
+#include <visp3/core/vpTracing.h>
 
 /*!
    Default constructor that consider the first camera found on the bus as
@@ -635,6 +636,7 @@ void vpPylonGrabberUsb::close()
 */
 void vpPylonGrabberUsb::acquire(vpImage<unsigned char> &I)
 {
+  VP_TRACING_SCOPE("vpPylonGrabberUsb::acquire");
   open();
 
   Pylon::CGrabResultPtr grabResult;
@@ -664,6 +666,7 @@ void vpPylonGrabberUsb::acquire(vpImage<unsigned char> &I)
 */
 void vpPylonGrabberUsb::acquire(vpImage<vpRGBa> &I)
 {
+  VP_TRACING_SCOPE("vpPylonGrabberUsb::acquire");
   open();
 
   Pylon::CGrabResultPtr grabResult;
@@ -63,6 +63,7 @@
 //#include <visp3/io/vpImageIo.h>
 #include <visp3/core/vpImageConvert.h>
 #include <visp3/core/vpImageTools.h>
+#include <visp3/core/vpTracing.h>
 
 const unsigned int vpV4l2Grabber::DEFAULT_INPUT = 2;
 const unsigned int vpV4l2Grabber::DEFAULT_SCALE = 2;
@@ -570,6 +571,7 @@ void vpV4l2Grabber::acquire(vpImage<unsigned char> &I, const vpRect &roi)
 */
 void vpV4l2Grabber::acquire(vpImage<unsigned char> &I, struct timeval &timestamp, const vpRect &roi)
 {
+  VP_TRACING_SCOPE("vpV4l2Grabber::acquire");
   if (init == false) {
     open(I);
   }
@@ -696,6 +698,7 @@ void vpV4l2Grabber::acquire(vpImage<vpRGBa> &I, const vpRect &roi)
 */
 void vpV4l2Grabber::acquire(vpImage<vpRGBa> &I, struct timeval &timestamp, const vpRect &roi)
 {
+  VP_TRACING_SCOPE("vpV4l2Grabber::acquire");
   if (init == false) {
     open(I);
   }
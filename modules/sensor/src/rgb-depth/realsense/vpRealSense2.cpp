@@ -41,6 +41,7 @@
 #include <set>
 #include <cstring>
 #include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpTracing.h>
 #include <visp3/sensor/vpRealSense2.h>
 
 #define MANUAL_POINTCLOUD 1
@@ -66,6 +67,7 @@ vpRealSense2::~vpRealSense2() { close(); }
  */
 void vpRealSense2::acquire(vpImage<unsigned char> &grey)
 {
+  VP_TRACING_SCOPE("vpRealSense2::acquire");
   auto data = m_pipe.wait_for_frames();
   auto color_frame = data.get_color_frame();
   getGreyFrame(color_frame, grey);
@@ -77,6 +79,7 @@ void vpRealSense2::acquire(vpImage<unsigned char> &grey)
  */
 void vpRealSense2::acquire(vpImage<vpRGBa> &color)
 {
+  VP_TRACING_SCOPE("vpRealSense2::acquire");
   auto data = m_pipe.wait_for_frames();
   auto color_frame = data.get_color_frame();
   getColorFrame(color_frame, color);
@@ -94,6 +97,7 @@ void vpRealSense2::acquire(unsigned char *const data_image, unsigned char *const
                            std::vector<vpColVector> *const data_pointCloud, unsigned char *const data_infrared,
                            rs2::align *const align_to)
 {
+  VP_TRACING_SCOPE("vpRealSense2::acquire");
   auto data = m_pipe.wait_for_frames();
   if (align_to != NULL)
 #if (RS2_API_VERSION > ((2 * 10000) + (9 * 100) + 0))
@@ -138,6 +142,7 @@ void vpRealSense2::acquire(unsigned char *const data_image, unsigned char *const
                            pcl::PointCloud<pcl::PointXYZ>::Ptr &pointcloud, unsigned char *const data_infrared,
                            rs2::align *const align_to)
 {
+  VP_TRACING_SCOPE("vpRealSense2::acquire");
   auto data = m_pipe.wait_for_frames();
   if (align_to != NULL)
 #if (RS2_API_VERSION > ((2 * 10000) + (9 * 100) + 0))
@@ -184,6 +189,7 @@ void vpRealSense2::acquire(unsigned char *const data_image, unsigned char *const
                            pcl::PointCloud<pcl::PointXYZRGB>::Ptr &pointcloud, unsigned char *const data_infrared,
                            rs2::align *const align_to)
 {
+  VP_TRACING_SCOPE("vpRealSense2::acquire");
   auto data = m_pipe.wait_for_frames();
   if (align_to != NULL)
 #if (RS2_API_VERSION > ((2 * 10000) + (9 * 100) + 0))
@@ -46,6 +46,7 @@
 #include <visp3/blob/vpDot.h>
 #include <visp3/core/vpColor.h>
 #include <visp3/core/vpDisplay.h>
+#include <visp3/core/vpTracing.h>
 #include <visp3/core/vpTrackingException.h>
 
 #include <vector>
@@ -769,6 +770,7 @@ void vpDot::initTracking(const vpImage<unsigned char> &I, const vpImagePoint &ip
 */
 void vpDot::track(const vpImage<unsigned char> &I)
 {
+  VP_TRACING_SCOPE("vpDot::track");
   try {
     setGrayLevelOut();
     double u = this->cog.get_u();
@@ -49,6 +49,7 @@
 // exception handling
 #include <visp3/core/vpIoTools.h>
 #include <visp3/core/vpMath.h>
+#include <visp3/core/vpTracing.h>
 #include <visp3/core/vpTrackingException.h>
 
 #include <cmath> // std::fabs
@@ -438,6 +439,7 @@ void vpDot2::initTracking(const vpImage<unsigned char> &I, const vpImagePoint &i
 */
 void vpDot2::track(const vpImage<unsigned char> &I)
 {
+  VP_TRACING_SCOPE("vpDot2::track");
   m00 = m11 = m02 = m20 = m10 = m01 = 0;
 
   // First, we will estimate the position of the tracked point
@@ -52,6 +52,7 @@
 #include <string>
 
 #include <visp3/core/vpDisplay.h>
+#include <visp3/core/vpTracing.h>
 #include <visp3/core/vpTrackingException.h>
 #include <visp3/klt/vpKltOpencv.h>
 
@@ -146,6 +147,7 @@ void vpKltOpencv::initTracking(const cv::Mat &I, const cv::Mat &mask)
  */
 void vpKltOpencv::track(const cv::Mat &I)
 {
+  VP_TRACING_SCOPE("vpKltOpencv::track");
   if (m_points[1].size() == 0)
     throw vpTrackingException(vpTrackingException::fatalError, "Not enough key points to track.");
 
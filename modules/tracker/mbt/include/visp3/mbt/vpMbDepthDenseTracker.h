@@ -57,6 +57,10 @@ public:
   virtual void display(const vpImage<vpRGBa> &I, const vpHomogeneousMatrix &cMo, const vpCameraParameters &cam,
                        const vpColor &col, const unsigned int thickness = 1, const bool displayFullModel = false);
 
+  //! Return true if the normal equations are accumulated instead of stacking the interaction matrix, see
+  //! setDepthDenseNormalEquations().
+  inline bool getDepthDenseNormalEquations() const { return m_depthDenseNormalEquations; }
+
   virtual inline vpColVector getError() const { return m_error_depthDense; }
 
   virtual inline vpColVector getRobustWeights() const { return m_w_depthDense; }
@@ -80,6 +84,7 @@ public:
   virtual void setDepthDenseFilteringMethod(const int method);
   virtual void setDepthDenseFilteringMinDistance(const double minDistance);
   virtual void setDepthDenseFilteringOccupancyRatio(const double occupancyRatio);
+  void setDepthDenseNormalEquations(const bool enable);
 
   inline void setDepthDenseSamplingStep(const unsigned int stepX, const unsigned int stepY)
   {
@@ -136,6 +141,8 @@ protected:
   vpColVector m_w_depthDense;
   //! Weighted error
   vpColVector m_weightedError_depthDense;
+  //! If true, accumulate the normal equations instead of stacking the interaction matrix
+  bool m_depthDenseNormalEquations;
 #if DEBUG_DISPLAY_DEPTH_DENSE
   vpDisplay *m_debugDisp_depthDense;
   vpImage<unsigned char> m_debugImage_depthDense;
@@ -146,6 +153,7 @@ protected:
   void computeVisibility(const unsigned int width, const unsigned int height);
 
   void computeVVS();
+  void computeVVSNormalEquations();
   virtual void computeVVSInit();
   virtual void computeVVSInteractionMatrixAndResidu();
   virtual void computeVVSWeights();
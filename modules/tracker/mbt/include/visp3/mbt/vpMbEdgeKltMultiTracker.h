@@ -233,6 +233,8 @@ public:
 
   virtual void loadConfigFile(const std::map<std::string, std::string> &mapOfConfigFiles);
 
+  virtual void loadCompiledModel(const vpMbtCompiledModel &model, const vpHomogeneousMatrix &T = vpHomogeneousMatrix());
+
   virtual void loadModel(const std::string &modelFile, const bool verbose = false,
                          const vpHomogeneousMatrix &T=vpHomogeneousMatrix());
 
@@ -84,6 +84,9 @@ protected:
 
   //! Map of pyramidal images for each camera
   std::map<std::string, std::vector<const vpImage<unsigned char> *> > m_mapOfPyramidalImages;
+  //! Map of the images of the pyramid levels for each camera, reused from
+  //! one frame to the next one
+  std::map<std::string, std::vector<vpImage<unsigned char> > > m_mapOfPyramidBuffers;
 
   //! Name of the reference camera
   std::string m_referenceCameraName;
@@ -227,6 +230,8 @@ public:
 
   virtual void loadConfigFile(const std::map<std::string, std::string> &mapOfConfigFiles);
 
+  virtual void loadCompiledModel(const vpMbtCompiledModel &model, const vpHomogeneousMatrix &T = vpHomogeneousMatrix());
+
   virtual void loadModel(const std::string &modelFile, const bool verbose = false,
                          const vpHomogeneousMatrix &T=vpHomogeneousMatrix());
 
@@ -342,6 +342,29 @@ protected:
   vpColVector m_weightedError_edge;
   //! Robust
   vpRobust m_robust_edge;
+  //! Number of threads used to track the moving edges (0 to use all the
+  //! available threads)
+  unsigned int m_nbThreads;
+  //! Images of the pyramid levels above 0, kept between two calls to
+  //! initPyramid() to avoid reallocations
+  std::vector<vpImage<unsigned char> > m_pyramidBuffers;
+  //! If true, the coarse levels are skipped when the motion is small
+  bool m_scaleScheduling;
+  //! Image motion (in pixels) below which the coarse levels are skipped
+  double m_scaleMotionThreshold;
+  //! Image motion (in pixels) of the model during the last call to track()
+  double m_lastMotion;
+  //! Levels whose moving edges have not been updated during the last call
+  //! to track()
+  std::vector<bool> m_staleScales;
+  //! Time (in ms) spent on each level during the last call to track()
+  std::vector<double> m_scaleLastTimes;
+  //! Cumulated time (in ms) spent on each level
+  std::vector<double> m_scaleTotalTimes;
+  //! Number of times each level has been tracked
+  std::vector<unsigned int> m_scaleNbTracked;
+  //! Number of times each level has been skipped
+  std::vector<unsigned int> m_scaleNbSkipped;
 
 public:
   vpMbEdgeTracker();
@@ -375,12 +398,30 @@ public:
 
   virtual unsigned int getNbPoints(const unsigned int level = 0) const;
 
+  /*!
+    Return the number of threads used to track the moving edges.
+
+    \sa setNbThreads()
+  */
+  inline unsigned int getNbThreads() const { return m_nbThreads; }
+
   /*!
     Return the scales levels used for the tracking.
 
     \return The scales levels used for the tracking.
   */
   std::vector<bool> getScales() const { return scales; }
+
+  /*!
+    Return true if the coarse levels of the pyramid may be skipped when the
+    motion is small.
+
+    \sa setScaleScheduling()
+  */
+  inline bool getScaleScheduling() const { return m_scaleScheduling; }
+
+  void getScaleStatistics(std::vector<double> &lastTimes, std::vector<double> &meanTimes,
+                          std::vector<unsigned int> &nbSkipped) const;
   /*!
      \return The threshold value between 0 and 1 over good moving edges ratio.
      It allows to decide if the tracker has enough valid moving edges to
@@ -401,6 +442,7 @@ public:
   virtual void reInitModel(const vpImage<unsigned char> &I, const std::string &cad_name,
                            const vpHomogeneousMatrix &cMo_, const bool verbose = false,
                            const vpHomogeneousMatrix &T=vpHomogeneousMatrix());
+  void resetScaleStatistics();
   void resetTracker();
 
   /*!
@@ -487,10 +529,14 @@ public:
 
   void setMovingEdge(const vpMe &me);
 
+  void setNbThreads(const unsigned int nbThreads);
+
   virtual void setPose(const vpImage<unsigned char> &I, const vpHomogeneousMatrix &cdMo);
 
   void setScales(const std::vector<bool> &_scales);
 
+  void setScaleScheduling(const bool enable, const double motionThreshold = 2.0);
+
   void setUseEdgeTracking(const std::string &name, const bool &useEdgeTracking);
 
   void track(const vpImage<unsigned char> &I);
@@ -506,6 +552,7 @@ protected:
   void addPolygon(vpMbtPolygon &p);
 
   void cleanPyramid(std::vector<const vpImage<unsigned char> *> &_pyramid);
+  double computeImageMotion(const vpHomogeneousMatrix &cMo_1, const vpHomogeneousMatrix &cMo_2);
   void computeProjectionError(const vpImage<unsigned char> &_I);
 
   void computeVVS(const vpImage<unsigned char> &_I, const unsigned int lvl);
@@ -532,6 +579,8 @@ protected:
                                unsigned int &nberrors_circles);
   void initMovingEdge(const vpImage<unsigned char> &I, const vpHomogeneousMatrix &_cMo);
   void initPyramid(const vpImage<unsigned char> &_I, std::vector<const vpImage<unsigned char> *> &_pyramid);
+  void initPyramid(const vpImage<unsigned char> &_I, std::vector<const vpImage<unsigned char> *> &_pyramid,
+                   std::vector<vpImage<unsigned char> > &buffers);
   void reInitLevel(const unsigned int _lvl);
   void reinitMovingEdge(const vpImage<unsigned char> &I, const vpHomogeneousMatrix &_cMo);
   void removeCircle(const std::string &name);
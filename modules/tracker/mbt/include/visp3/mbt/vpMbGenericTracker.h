@@ -44,6 +44,7 @@
 #include <visp3/mbt/vpMbDepthNormalTracker.h>
 #include <visp3/mbt/vpMbEdgeTracker.h>
 #include <visp3/mbt/vpMbKltTracker.h>
+#include <visp3/mbt/vpMbtTrackingStatistics.h>
 
 /*!
   \class vpMbGenericTracker
@@ -197,6 +198,18 @@ public:
 
   virtual inline vpColVector getRobustWeights() const { return m_w; }
 
+  /*!
+    Return the timings and counters of the last call to track(), only
+    computed when enabled with setTrackingStatisticsComputation().
+  */
+  inline const vpMbtTrackingStatistics &getTrackingStatistics() const { return m_trackingStatistics; }
+  /*!
+    Return true if the timings and counters of track() are computed.
+
+    \sa setTrackingStatisticsComputation()
+  */
+  inline bool getTrackingStatisticsComputation() const { return m_computeTrackingStatistics; }
+
   virtual void init(const vpImage<unsigned char> &I);
 
 #ifdef VISP_HAVE_MODULE_GUI
@@ -230,6 +243,8 @@ public:
   virtual void loadConfigFile(const std::string &configFile1, const std::string &configFile2);
   virtual void loadConfigFile(const std::map<std::string, std::string> &mapOfConfigFiles);
 
+  virtual void loadCompiledModel(const vpMbtCompiledModel &model, const vpHomogeneousMatrix &T = vpHomogeneousMatrix());
+
   virtual void loadModel(const std::string &modelFile, const bool verbose = false, const vpHomogeneousMatrix &T=vpHomogeneousMatrix());
   virtual void loadModel(const std::string &modelFile1, const std::string &modelFile2, const bool verbose = false,
                          const vpHomogeneousMatrix &T1=vpHomogeneousMatrix(), const vpHomogeneousMatrix &T2=vpHomogeneousMatrix());
@@ -320,10 +335,14 @@ public:
   virtual void setMinLineLengthThresh(const double minLineLengthThresh, const std::string &name = "");
   virtual void setMinPolygonAreaThresh(const double minPolygonAreaThresh, const std::string &name = "");
 
+  virtual void setModelCacheDirectory(const std::string &directory);
+
   virtual void setMovingEdge(const vpMe &me);
   virtual void setMovingEdge(const vpMe &me1, const vpMe &me2);
   virtual void setMovingEdge(const std::map<std::string, vpMe> &mapOfMe);
 
+  virtual void setNbThreads(const unsigned int nbThreads);
+
   virtual void setNearClippingDistance(const double &dist);
   virtual void setNearClippingDistance(const double &dist1, const double &dist2);
   virtual void setNearClippingDistance(const std::map<std::string, double> &mapOfDists);
@@ -352,6 +371,8 @@ public:
   virtual void setTrackerType(const int type);
   virtual void setTrackerType(const std::map<std::string, int> &mapOfTrackerTypes);
 
+  void setTrackingStatisticsComputation(const bool flag);
+
   virtual void setUseDepthDenseTracking(const std::string &name, const bool &useDepthDenseTracking);
   virtual void setUseDepthNormalTracking(const std::string &name, const bool &useDepthNormalTracking);
   virtual void setUseEdgeTracking(const std::string &name, const bool &useEdgeTracking);
@@ -513,6 +534,13 @@ private:
     virtual void preTracking(const vpImage<unsigned char> *const ptr_I = NULL,
                              const std::vector<vpColVector> *const point_cloud = NULL,
                              const unsigned int pointcloud_width = 0, const unsigned int pointcloud_height = 0);
+
+  private:
+    void computeMovingEdgeStatistics();
+
+    //! Statistics of the camera filled during the tracking, NULL when they
+    //! are not computed
+    vpMbtTrackingStatistics::vpCameraStatistics *m_statistics;
   };
 
 protected:
@@ -540,5 +568,12 @@ protected:
   vpColVector m_w;
   //! Weighted error
   vpColVector m_weightedError;
+  //! If true, the timings and counters of track() are computed
+  bool m_computeTrackingStatistics;
+  //! Timings and counters of the last call to track()
+  vpMbtTrackingStatistics m_trackingStatistics;
+
+private:
+  void startTrackingStatistics();
 };
 #endif
@@ -43,6 +43,7 @@
 #define vpMbHiddenFaces_HH
 
 #include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpMath.h>
 #include <visp3/core/vpMeterPixelConversion.h>
 #include <visp3/core/vpPixelMeterConversion.h>
 #include <visp3/mbt/vpMbScanLine.h>
@@ -52,6 +53,8 @@
 #include <visp3/ar/vpAROgre.h>
 #endif
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
 #include <vector>
 
@@ -76,6 +79,48 @@ private:
   unsigned int nbVisiblePolygon;
   vpMbScanLine scanlineRender;
 
+  //! Node of the bounding volume hierarchy built over the faces
+  struct vpBvhNode {
+    double center[3];        //!< Center of the bounding sphere in the object frame
+    double radius;           //!< Radius of the bounding sphere
+    double axis[3];          //!< Axis of the cone bounding the face normals
+    double coneAngle;        //!< Half-angle of the cone bounding the face normals
+    bool hasCone;            //!< False if a face of the node has no orientation
+    unsigned int minNbPoint; //!< Smallest number of points of the faces
+    unsigned int maxNbPoint; //!< Largest number of points of the faces
+    unsigned int begin;      //!< First face of the node in m_bvhFaces
+    unsigned int end;        //!< Past-the-end face of the node in m_bvhFaces
+    int left;                //!< Index of the left child, -1 for a leaf
+    int right;               //!< Index of the right child, -1 for a leaf
+    bool hidden;             //!< All the faces of the node were culled by the last visibility test
+  };
+
+  //! Ordering of the faces along an axis according to their centroid
+  struct vpBvhCentroidLess {
+    vpBvhCentroidLess(const std::vector<double> &centroids, unsigned int axis) : m_centroids(&centroids), m_axis(axis)
+    {
+    }
+    bool operator()(unsigned int a, unsigned int b) const
+    {
+      return (*m_centroids)[3 * a + m_axis] < (*m_centroids)[3 * b + m_axis];
+    }
+    const std::vector<double> *m_centroids;
+    unsigned int m_axis;
+  };
+
+  //! If true, faces are culled using the bounding volume hierarchy
+  bool m_useBvh;
+  //! If true, the hierarchy has to be rebuilt before its next use
+  bool m_bvhDirty;
+  //! If true, the hidden flags of the nodes match the visibility of the faces
+  bool m_bvhCacheValid;
+  //! Nodes of the hierarchy, the root being the first one
+  std::vector<vpBvhNode> m_bvhNodes;
+  //! Face indices ordered such as each node covers a contiguous range
+  std::vector<unsigned int> m_bvhFaces;
+  //! Faces that were not culled and go through the detailed visibility test
+  std::vector<bool> m_bvhCandidates;
+
 #ifdef VISP_HAVE_OGRE
   vpImage<unsigned char> ogreBackground;
   bool ogreInitialised;
@@ -91,6 +136,15 @@ private:
                                  bool not_used = false, const vpImage<unsigned char> &I = vpImage<unsigned char>(),
                                  const vpCameraParameters &cam = vpCameraParameters());
 
+  void buildBvh();
+  int buildBvhNode(unsigned int begin, unsigned int end, const std::vector<double> &centroids,
+                   const std::vector<double> &normals, const std::vector<unsigned int> &buckets);
+  void clipBvhNode(int index, const vpHomogeneousMatrix &cMo, const vpCameraParameters &cam,
+                   const std::vector<vpColVector> &fovNormals, const double &nearMax, const double &farMin);
+  void cullBvhNode(int index, const bool &cacheValid, bool &changed);
+  void selectBvhNode(int index, const double *cameraOrigin, const double *cameraAxis, const double &angleCulling,
+                     const bool &cacheValid, bool &changed);
+
 public:
   vpMbHiddenFaces();
   ~vpMbHiddenFaces();
@@ -111,6 +165,16 @@ public:
   void computeScanLineQuery(const vpPoint &a, const vpPoint &b, std::vector<std::pair<vpPoint, vpPoint> > &lines,
                             const bool &displayResults = false);
 
+  /*!
+    Tell whether the bounding volume hierarchy built over the faces is used
+    to cull them.
+
+    \sa setBvhCulling()
+
+    \return True if the hierarchy is used, false otherwise.
+  */
+  bool getBvhCulling() const { return m_useBvh; }
+
   vpMbScanLine &getMbScanLineRenderer() { return scanlineRender; }
 
 #ifdef VISP_HAVE_OGRE
@@ -254,6 +318,30 @@ public:
   inline void setOgreShowConfigDialog(const bool showConfigDialog) { ogreShowConfigDialog = showConfigDialog; }
 #endif
 
+  /*!
+    Enable/Disable the culling of the faces with a bounding volume hierarchy.
+
+    The hierarchy groups the faces by orientation and by location. A group
+    whose normals all point away from the camera is hidden without testing
+    each of its faces, and a group lying entirely outside a clipping plane
+    gets empty clipped polygons. The visibility and the clipped polygons are
+    the same as the ones obtained with the face by face tests. The only
+    difference is that culled faces do not update their coordinates in the
+    camera frame. This is enabled by default and only concerns the
+    visibility test without Ogre.
+
+    \warning The hierarchy relies on the visibility criterion of
+    vpMbtPolygon::isVisible(). It has to be disabled if \e PolygonType
+    overrides this criterion.
+
+    \param useBvh : If true, the hierarchy is used.
+  */
+  void setBvhCulling(const bool &useBvh)
+  {
+    m_useBvh = useBvh;
+    m_bvhCacheValid = false;
+  }
+
   unsigned int setVisible(const vpImage<unsigned char> &I, const vpCameraParameters &cam,
                           const vpHomogeneousMatrix &cMo, const double &angle, bool &changed);
   unsigned int setVisible(const vpImage<unsigned char> &I, const vpCameraParameters &cam,
@@ -281,7 +369,10 @@ public:
   Basic constructor.
 */
 template <class PolygonType>
-vpMbHiddenFaces<PolygonType>::vpMbHiddenFaces() : Lpol(), nbVisiblePolygon(0), scanlineRender()
+vpMbHiddenFaces<PolygonType>::vpMbHiddenFaces()
+  : Lpol(), nbVisiblePolygon(0), scanlineRender(), m_useBvh(true), m_bvhDirty(true), m_bvhCacheValid(false),
+    m_bvhNodes(), m_bvhFaces(),
+    m_bvhCandidates()
 {
 #ifdef VISP_HAVE_OGRE
   ogreInitialised = false;
@@ -329,7 +420,8 @@ template <class PolygonType> vpMbHiddenFaces<PolygonType>::~vpMbHiddenFaces()
 */
 template <class PolygonType>
 vpMbHiddenFaces<PolygonType>::vpMbHiddenFaces(const vpMbHiddenFaces<PolygonType> &copy)
-  : Lpol(), nbVisiblePolygon(copy.nbVisiblePolygon), scanlineRender(copy.scanlineRender)
+  : Lpol(), nbVisiblePolygon(copy.nbVisiblePolygon), scanlineRender(copy.scanlineRender), m_useBvh(copy.m_useBvh),
+    m_bvhDirty(true), m_bvhCacheValid(false), m_bvhNodes(), m_bvhFaces(), m_bvhCandidates()
 #ifdef VISP_HAVE_OGRE
     ,
     ogreBackground(copy.ogreBackground), ogreInitialised(copy.ogreInitialised), nbRayAttempts(copy.nbRayAttempts),
@@ -349,6 +441,12 @@ template <class PolygonType> void swap(vpMbHiddenFaces<PolygonType> &first, vpMb
   swap(first.Lpol, second.Lpol);
   swap(first.nbVisiblePolygon, second.nbVisiblePolygon);
   swap(first.scanlineRender, second.scanlineRender);
+  swap(first.m_useBvh, second.m_useBvh);
+  swap(first.m_bvhDirty, second.m_bvhDirty);
+  swap(first.m_bvhCacheValid, second.m_bvhCacheValid);
+  swap(first.m_bvhNodes, second.m_bvhNodes);
+  swap(first.m_bvhFaces, second.m_bvhFaces);
+  swap(first.m_bvhCandidates, second.m_bvhCandidates);
 #ifdef VISP_HAVE_OGRE
   swap(first.ogreInitialised, second.ogreInitialised);
   swap(first.nbRayAttempts, second.nbRayAttempts);
@@ -390,6 +488,7 @@ template <class PolygonType> void vpMbHiddenFaces<PolygonType>::addPolygon(Polyg
   for (unsigned int i = 0; i < p->nbpt; i++)
     p_new->p[i] = p->p[i];
   Lpol.push_back(p_new);
+  m_bvhDirty = true;
 }
 
 /*!
@@ -405,6 +504,10 @@ template <class PolygonType> void vpMbHiddenFaces<PolygonType>::reset()
     Lpol[i] = NULL;
   }
   Lpol.resize(0);
+  m_bvhNodes.clear();
+  m_bvhFaces.clear();
+  m_bvhDirty = true;
+  m_bvhCacheValid = false;
 
 #ifdef VISP_HAVE_OGRE
   if (ogre != NULL) {
@@ -430,6 +533,291 @@ template <class PolygonType> void vpMbHiddenFaces<PolygonType>::reset()
 #endif
 }
 
+/*!
+  Build the bounding volume hierarchy over the faces.
+
+  Faces are first grouped by the dominant axis of their normal, so that the
+  normals of a group are bounded by a narrow cone, and then split at the
+  median of their centroids along the largest extent. Lines, faces without
+  orientation and degenerated faces are gathered in a group without cone.
+*/
+template <class PolygonType> void vpMbHiddenFaces<PolygonType>::buildBvh()
+{
+  m_bvhNodes.clear();
+  m_bvhFaces.clear();
+  m_bvhDirty = false;
+  m_bvhCacheValid = false;
+
+  const unsigned int nbFaces = (unsigned int)Lpol.size();
+  if (nbFaces == 0)
+    return;
+
+  const unsigned int nbBuckets = 7;
+  std::vector<double> centroids(3 * nbFaces, 0.0);
+  std::vector<double> normals(3 * nbFaces, 0.0);
+  std::vector<unsigned int> buckets(nbFaces, nbBuckets - 1);
+  std::vector<unsigned int> offsets(nbBuckets + 1, 0);
+
+  for (unsigned int i = 0; i < nbFaces; i++) {
+    const PolygonType *poly = Lpol[i];
+    const unsigned int nbpt = poly->getNbPoint();
+    double n[3] = {0.0, 0.0, 0.0};
+    double edges = 0.0;
+    for (unsigned int j = 0; j < nbpt; j++) {
+      const vpPoint &cur = poly->p[j];
+      const vpPoint &next = poly->p[(j + 1) % nbpt];
+      centroids[3 * i] += cur.get_oX();
+      centroids[3 * i + 1] += cur.get_oY();
+      centroids[3 * i + 2] += cur.get_oZ();
+
+      // Newell's method, as in vpMbtPolygon::isVisible()
+      n[0] += (cur.get_oY() - next.get_oY()) * (cur.get_oZ() + next.get_oZ());
+      n[1] += (cur.get_oZ() - next.get_oZ()) * (cur.get_oX() + next.get_oX());
+      n[2] += (cur.get_oX() - next.get_oX()) * (cur.get_oY() + next.get_oY());
+      edges += vpMath::sqr(cur.get_oX() - next.get_oX()) + vpMath::sqr(cur.get_oY() - next.get_oY()) +
+               vpMath::sqr(cur.get_oZ() - next.get_oZ());
+    }
+    if (nbpt > 0) {
+      for (unsigned int k = 0; k < 3; k++)
+        centroids[3 * i + k] /= (double)nbpt;
+    }
+
+    double norm = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+    if (nbpt >= 3 && poly->hasOrientation && norm > 1e-6 * edges) {
+      unsigned int axis = 0;
+      for (unsigned int k = 0; k < 3; k++) {
+        normals[3 * i + k] = n[k] / norm;
+        if (std::fabs(n[k]) > std::fabs(n[axis]))
+          axis = k;
+      }
+      buckets[i] = 2 * axis + (n[axis] < 0 ? 1 : 0);
+    }
+    offsets[buckets[i] + 1]++;
+  }
+
+  for (unsigned int k = 1; k <= nbBuckets; k++)
+    offsets[k] += offsets[k - 1];
+  m_bvhFaces.resize(nbFaces);
+  for (unsigned int i = 0; i < nbFaces; i++)
+    m_bvhFaces[offsets[buckets[i]]++] = i;
+
+  m_bvhNodes.reserve(nbFaces / 2 + nbBuckets);
+  buildBvhNode(0, nbFaces, centroids, normals, buckets);
+}
+
+/*!
+  Build the node of the bounding volume hierarchy covering a range of faces,
+  and its children.
+
+  \param begin : First face of the node in the ordered list of faces.
+  \param end : Past-the-end face of the node in the ordered list of faces.
+  \param centroids : Centroids of the faces.
+  \param normals : Normals of the faces.
+  \param buckets : Orientation groups of the faces.
+
+  \return Index of the node.
+*/
+template <class PolygonType>
+int vpMbHiddenFaces<PolygonType>::buildBvhNode(unsigned int begin, unsigned int end,
+                                               const std::vector<double> &centroids,
+                                               const std::vector<double> &normals,
+                                               const std::vector<unsigned int> &buckets)
+{
+  const unsigned int noOrientation = 6;
+  const unsigned int leafSize = 8;
+
+  vpBvhNode node;
+  node.begin = begin;
+  node.end = end;
+  node.left = -1;
+  node.right = -1;
+  node.hidden = false;
+
+  // Bounding sphere centered on the bounding box of the vertices
+  double bbMin[3], bbMax[3];
+  for (unsigned int k = 0; k < 3; k++) {
+    bbMin[k] = std::numeric_limits<double>::max();
+    bbMax[k] = -std::numeric_limits<double>::max();
+    node.center[k] = 0.0;
+    node.axis[k] = 0.0;
+  }
+  bool hasVertex = false;
+  for (unsigned int f = begin; f < end; f++) {
+    const PolygonType *poly = Lpol[m_bvhFaces[f]];
+    for (unsigned int j = 0; j < poly->getNbPoint(); j++) {
+      double v[3] = {poly->p[j].get_oX(), poly->p[j].get_oY(), poly->p[j].get_oZ()};
+      for (unsigned int k = 0; k < 3; k++) {
+        bbMin[k] = (std::min)(bbMin[k], v[k]);
+        bbMax[k] = (std::max)(bbMax[k], v[k]);
+      }
+      hasVertex = true;
+    }
+  }
+  double radius2 = 0.0;
+  if (hasVertex) {
+    for (unsigned int k = 0; k < 3; k++)
+      node.center[k] = 0.5 * (bbMin[k] + bbMax[k]);
+    for (unsigned int f = begin; f < end; f++) {
+      const PolygonType *poly = Lpol[m_bvhFaces[f]];
+      for (unsigned int j = 0; j < poly->getNbPoint(); j++) {
+        radius2 = (std::max)(radius2, vpMath::sqr(poly->p[j].get_oX() - node.center[0]) +
+                                        vpMath::sqr(poly->p[j].get_oY() - node.center[1]) +
+                                        vpMath::sqr(poly->p[j].get_oZ() - node.center[2]));
+      }
+    }
+  }
+  // Slightly enlarged to remain conservative with respect to rounding errors
+  node.radius = sqrt(radius2) * (1.0 + 1e-9) + 1e-12;
+
+  // Cone bounding the normals
+  node.hasCone = true;
+  node.coneAngle = 0.0;
+  node.minNbPoint = std::numeric_limits<unsigned int>::max();
+  node.maxNbPoint = 0;
+  for (unsigned int f = begin; f < end && node.hasCone; f++) {
+    unsigned int i = m_bvhFaces[f];
+    node.minNbPoint = (std::min)(node.minNbPoint, Lpol[i]->getNbPoint());
+    node.maxNbPoint = (std::max)(node.maxNbPoint, Lpol[i]->getNbPoint());
+    if (buckets[i] == noOrientation) {
+      node.hasCone = false;
+    } else {
+      for (unsigned int k = 0; k < 3; k++)
+        node.axis[k] += normals[3 * i + k];
+    }
+  }
+  if (node.hasCone) {
+    double norm = sqrt(node.axis[0] * node.axis[0] + node.axis[1] * node.axis[1] + node.axis[2] * node.axis[2]);
+    if (norm < 1e-9) {
+      node.hasCone = false;
+    } else {
+      for (unsigned int k = 0; k < 3; k++)
+        node.axis[k] /= norm;
+      for (unsigned int f = begin; f < end; f++) {
+        unsigned int i = m_bvhFaces[f];
+        double cosAngle = node.axis[0] * normals[3 * i] + node.axis[1] * normals[3 * i + 1] +
+                          node.axis[2] * normals[3 * i + 2];
+        node.coneAngle = (std::max)(node.coneAngle, acos((std::max)(-1.0, (std::min)(1.0, cosAngle))));
+      }
+    }
+  }
+
+  int index = (int)m_bvhNodes.size();
+  m_bvhNodes.push_back(node);
+  if (end - begin <= leafSize)
+    return index;
+
+  unsigned int middle = (begin + end) / 2;
+  if (buckets[m_bvhFaces[begin]] != buckets[m_bvhFaces[end - 1]]) {
+    // Split between the orientation groups, as close as possible to the middle
+    unsigned int half = middle, distance = end - begin;
+    for (unsigned int f = begin + 1; f < end; f++) {
+      if (buckets[m_bvhFaces[f]] != buckets[m_bvhFaces[f - 1]]) {
+        unsigned int d = f > half ? f - half : half - f;
+        if (d < distance) {
+          distance = d;
+          middle = f;
+        }
+      }
+    }
+  } else {
+    // Median split along the largest extent of the centroids
+    double cMin[3], cMax[3];
+    for (unsigned int k = 0; k < 3; k++) {
+      cMin[k] = std::numeric_limits<double>::max();
+      cMax[k] = -std::numeric_limits<double>::max();
+    }
+    for (unsigned int f = begin; f < end; f++) {
+      for (unsigned int k = 0; k < 3; k++) {
+        cMin[k] = (std::min)(cMin[k], centroids[3 * m_bvhFaces[f] + k]);
+        cMax[k] = (std::max)(cMax[k], centroids[3 * m_bvhFaces[f] + k]);
+      }
+    }
+    unsigned int axis = 0;
+    for (unsigned int k = 1; k < 3; k++) {
+      if (cMax[k] - cMin[k] > cMax[axis] - cMin[axis])
+        axis = k;
+    }
+    std::nth_element(m_bvhFaces.begin() + begin, m_bvhFaces.begin() + middle, m_bvhFaces.begin() + end,
+                     vpBvhCentroidLess(centroids, axis));
+  }
+
+  int left = buildBvhNode(begin, middle, centroids, normals, buckets);
+  int right = buildBvhNode(middle, end, centroids, normals, buckets);
+  m_bvhNodes[(size_t)index].left = left;
+  m_bvhNodes[(size_t)index].right = right;
+
+  return index;
+}
+
+/*!
+  Compute the clipped polygons of the faces of a node of the bounding volume
+  hierarchy. Faces of a node lying entirely outside a clipping plane get an
+  empty clipped polygon without being clipped.
+
+  \param index : Index of the node.
+  \param cMo : Pose that will be used to clip the polygons.
+  \param cam : Camera parameters that will be used to clip the polygons.
+  \param fovNormals : Normals of the field of view planes, empty if the field
+  of view is not computed.
+  \param nearMax : Largest near clipping distance of the faces.
+  \param farMin : Smallest far clipping distance of the faces.
+*/
+template <class PolygonType>
+void vpMbHiddenFaces<PolygonType>::clipBvhNode(int index, const vpHomogeneousMatrix &cMo, const vpCameraParameters &cam,
+                                               const std::vector<vpColVector> &fovNormals, const double &nearMax,
+                                               const double &farMin)
+{
+  const vpBvhNode &node = m_bvhNodes[(size_t)index];
+
+  double c[3];
+  for (unsigned int r = 0; r < 3; r++)
+    c[r] = cMo[r][0] * node.center[0] + cMo[r][1] * node.center[1] + cMo[r][2] * node.center[2] + cMo[r][3];
+  const double zMin = c[2] - node.radius;
+  const double zMax = c[2] + node.radius;
+
+  unsigned int outside = vpPolygon3D::NO_CLIPPING;
+  if (zMax < nearMax)
+    outside |= vpPolygon3D::NEAR_CLIPPING;
+  if (zMin > farMin)
+    outside |= vpPolygon3D::FAR_CLIPPING;
+  for (unsigned int k = 0; k < fovNormals.size(); k++) {
+    if (fovNormals[k][0] * c[0] + fovNormals[k][1] * c[1] + fovNormals[k][2] * c[2] > node.radius)
+      outside |= (vpPolygon3D::LEFT_CLIPPING << k);
+  }
+
+  if (outside != vpPolygon3D::NO_CLIPPING) {
+    for (unsigned int f = node.begin; f < node.end; f++) {
+      PolygonType *poly = Lpol[m_bvhFaces[f]];
+      const unsigned int flag = poly->getClipping();
+      bool clipped = false;
+      if (((flag & vpPolygon3D::NEAR_CLIPPING) == vpPolygon3D::NEAR_CLIPPING ||
+           flag > vpPolygon3D::FAR_CLIPPING) &&
+          zMax < poly->getNearClippingDistance())
+        clipped = true;
+      else if ((flag & vpPolygon3D::FAR_CLIPPING) == vpPolygon3D::FAR_CLIPPING &&
+               zMin > poly->getFarClippingDistance())
+        clipped = true;
+      else if ((flag & outside & ~(vpPolygon3D::NEAR_CLIPPING | vpPolygon3D::FAR_CLIPPING)) != 0)
+        clipped = true;
+
+      if (clipped) {
+        poly->polyClipped.clear();
+      } else {
+        poly->changeFrame(cMo);
+        poly->computePolygonClipped(cam);
+      }
+    }
+  } else if (node.left < 0) {
+    for (unsigned int f = node.begin; f < node.end; f++) {
+      Lpol[m_bvhFaces[f]]->changeFrame(cMo);
+      Lpol[m_bvhFaces[f]]->computePolygonClipped(cam);
+    }
+  } else {
+    clipBvhNode(node.left, cMo, cam, fovNormals, nearMax, farMin);
+    clipBvhNode(node.right, cMo, cam, fovNormals, nearMax, farMin);
+  }
+}
+
 /*!
   Compute the clipped points of the polygons that have been added via
   addPolygon().
@@ -440,6 +828,28 @@ template <class PolygonType> void vpMbHiddenFaces<PolygonType>::reset()
 template <class PolygonType>
 void vpMbHiddenFaces<PolygonType>::computeClippedPolygons(const vpHomogeneousMatrix &cMo, const vpCameraParameters &cam)
 {
+  if (m_useBvh && !Lpol.empty()) {
+    if (m_bvhDirty || m_bvhFaces.size() != Lpol.size())
+      buildBvh();
+
+    double nearMax = -std::numeric_limits<double>::max();
+    double farMin = std::numeric_limits<double>::max();
+    for (unsigned int i = 0; i < Lpol.size(); i++) {
+      const unsigned int flag = Lpol[i]->getClipping();
+      if ((flag & vpPolygon3D::NEAR_CLIPPING) == vpPolygon3D::NEAR_CLIPPING || flag > vpPolygon3D::FAR_CLIPPING)
+        nearMax = (std::max)(nearMax, Lpol[i]->getNearClippingDistance());
+      if ((flag & vpPolygon3D::FAR_CLIPPING) == vpPolygon3D::FAR_CLIPPING)
+        farMin = (std::min)(farMin, Lpol[i]->getFarClippingDistance());
+    }
+
+    std::vector<vpColVector> fovNormals;
+    if (cam.isFovComputed())
+      fovNormals = cam.getFovNormals();
+
+    clipBvhNode(0, cMo, cam, fovNormals, nearMax, farMin);
+    return;
+  }
+
   for (unsigned int i = 0; i < Lpol.size(); i++) {
     // For fast result we could just clip visible polygons.
     // However clipping all of them gives us the possibility to return more
@@ -539,6 +949,36 @@ unsigned int vpMbHiddenFaces<PolygonType>::setVisiblePrivate(const vpHomogeneous
 #endif
   }
 
+  if (m_useBvh && !useOgre && !Lpol.empty()) {
+    if (m_bvhDirty || m_bvhFaces.size() != Lpol.size())
+      buildBvh();
+
+    // Position and optical axis of the camera in the object frame
+    double cameraOrigin[3], cameraAxis[3];
+    for (unsigned int r = 0; r < 3; r++) {
+      cameraOrigin[r] = -(cMo[0][r] * cMo[0][3] + cMo[1][r] * cMo[1][3] + cMo[2][r] * cMo[2][3]);
+      cameraAxis[r] = cMo[2][r];
+    }
+
+    // Faces seen with a larger angle are neither visible nor appearing, see
+    // vpMbtPolygon::isVisible()
+    const double angleCulling = (std::max)(angleAppears, angleDisappears) + vpMath::rad(1) + 1e-6;
+
+    const bool cacheValid = m_bvhCacheValid;
+    m_bvhCandidates.assign(Lpol.size(), false);
+    selectBvhNode(0, cameraOrigin, cameraAxis, angleCulling, cacheValid, changed);
+
+    // The candidates are tested in the order of the list, which is the order
+    // of the faces in memory
+    for (unsigned int i = 0; i < Lpol.size(); i++) {
+      if (m_bvhCandidates[i] &&
+          computeVisibility(cMo, angleAppears, angleDisappears, changed, false, not_used, I, cam, cameraPos, i))
+        nbVisiblePolygon++;
+    }
+    m_bvhCacheValid = true;
+    return nbVisiblePolygon;
+  }
+
   for (unsigned int i = 0; i < Lpol.size(); i++) {
     // std::cout << "Calling poly: " << i << std::endl;
     if (computeVisibility(cMo, angleAppears, angleDisappears, changed, useOgre, not_used, I, cam, cameraPos, i))
@@ -547,6 +987,90 @@ unsigned int vpMbHiddenFaces<PolygonType>::setVisiblePrivate(const vpHomogeneous
   return nbVisiblePolygon;
 }
 
+/*!
+  Hide all the faces of a node of the bounding volume hierarchy.
+
+  \param index : Index of the node.
+  \param cacheValid : If true, the faces of a node already hidden by the
+  previous visibility test are not updated.
+  \param changed : Set to true if a face disappears.
+*/
+template <class PolygonType>
+void vpMbHiddenFaces<PolygonType>::cullBvhNode(int index, const bool &cacheValid, bool &changed)
+{
+  vpBvhNode &node = m_bvhNodes[(size_t)index];
+  if (cacheValid && node.hidden)
+    return;
+
+  node.hidden = true;
+  if (node.left < 0) {
+    for (unsigned int f = node.begin; f < node.end; f++) {
+      PolygonType *poly = Lpol[m_bvhFaces[f]];
+      if (poly->isvisible)
+        changed = true;
+      poly->isvisible = false;
+      poly->isappearing = false;
+    }
+  } else {
+    cullBvhNode(node.left, cacheValid, changed);
+    cullBvhNode(node.right, cacheValid, changed);
+  }
+}
+
+/*!
+  Select the faces of a node of the bounding volume hierarchy that have to go
+  through the detailed visibility test of computeVisibility(). The node is
+  hidden as a whole if the cone bounding its normals points away from the
+  camera.
+
+  \param index : Index of the node.
+  \param cameraOrigin : Position of the camera in the object frame.
+  \param cameraAxis : Optical axis of the camera in the object frame.
+  \param angleCulling : Smallest angle between a face normal and the
+  direction of the camera for which a face is neither visible nor appearing.
+  \param cacheValid : If true, the hidden flags of the nodes match the
+  visibility of the faces.
+  \param changed : Set to true if a face disappears.
+*/
+template <class PolygonType>
+void vpMbHiddenFaces<PolygonType>::selectBvhNode(int index, const double *cameraOrigin, const double *cameraAxis,
+                                                 const double &angleCulling, const bool &cacheValid, bool &changed)
+{
+  vpBvhNode &node = m_bvhNodes[(size_t)index];
+
+  if (node.hasCone) {
+    // vpMbtPolygon::isVisible() measures the angle from a point shifted by
+    // 1/nbpt along the optical axis with respect to the centroid of the face,
+    // the sphere is moved and enlarged to contain these points
+    const double shiftMin = 1.0 / node.maxNbPoint, shiftMax = 1.0 / node.minNbPoint;
+    const double shift = 0.5 * (shiftMin + shiftMax);
+    const double radius = node.radius + 0.5 * (shiftMax - shiftMin);
+    double w[3];
+    for (unsigned int k = 0; k < 3; k++)
+      w[k] = cameraOrigin[k] - node.center[k] - shift * cameraAxis[k];
+    double d = sqrt(w[0] * w[0] + w[1] * w[1] + w[2] * w[2]);
+    if (d > radius) {
+      // Lower bound of the angle between the normal of a face and the
+      // direction from its centroid to the camera
+      double cosAngle = (node.axis[0] * w[0] + node.axis[1] * w[1] + node.axis[2] * w[2]) / d;
+      double angle = acos((std::max)(-1.0, (std::min)(1.0, cosAngle))) - node.coneAngle - asin(radius / d);
+      if (angle > angleCulling) {
+        cullBvhNode(index, cacheValid, changed);
+        return;
+      }
+    }
+  }
+
+  node.hidden = false;
+  if (node.left < 0) {
+    for (unsigned int f = node.begin; f < node.end; f++)
+      m_bvhCandidates[m_bvhFaces[f]] = true;
+  } else {
+    selectBvhNode(node.left, cameraOrigin, cameraAxis, angleCulling, cacheValid, changed);
+    selectBvhNode(node.right, cameraOrigin, cameraAxis, angleCulling, cacheValid, changed);
+  }
+}
+
 /*!
   Compute the visibility of a given face index.
 
@@ -574,6 +1098,7 @@ bool vpMbHiddenFaces<PolygonType>::computeVisibility(const vpHomogeneousMatrix &
 {
   (void)not_used;
   unsigned int i = index;
+  m_bvhCacheValid = false;
   Lpol[i]->changeFrame(cMo);
   Lpol[i]->isappearing = false;
 
@@ -81,9 +81,9 @@ public:
 
   //! Structure to define a scanline intersection.
   struct vpMbScanLineSegment {
-    vpMbScanLineSegment() : type(START), edge(), p(0), P1(0), P2(0), Z1(0), Z2(0), ID(0), b_sample_Y(false) {}
+    vpMbScanLineSegment() : type(START), edge(-1), p(0), P1(0), P2(0), Z1(0), Z2(0), ID(0), b_sample_Y(false) {}
     vpMbScanLineType type;
-    vpMbScanLineEdge edge;
+    int edge;      // Index of the edge in the list of edges of the scene.
     double p;      // This value can be either x or y-coordinate value depending if
                    // the structure is used in X or Y-axis scanlines computation.
     double P1, P2; // Same comment as previous value.
@@ -131,9 +131,18 @@ private:
   unsigned int maskBorder;
   vpImage<unsigned char> mask;
   vpImage<int> primitive_ids;
-  std::map<vpMbScanLineEdge, std::set<int>, vpMbScanLineEdgeComparator> visibility_samples;
+  vpImage<float> primitive_depths;
+  bool computeDepths;
+  std::map<vpMbScanLineEdge, int, vpMbScanLineEdgeComparator> edge_ids;
+  std::vector<std::vector<int> > visibility_samples;
   double depthTreshold;
 
+  // Buffers kept from one scene to the next to avoid reallocations
+  std::vector<std::vector<vpMbScanLineSegment> > scanlinesY, scanlinesX, localScanlines;
+  unsigned int localFirst, localLast;
+  std::vector<std::vector<int> > samplesY, samplesX;
+  vpImage<unsigned char> maskY, maskX;
+
 public:
 #if defined(DEBUG_DISP)
   vpDisplay *dispMaskDebug;
@@ -158,6 +167,13 @@ public:
   unsigned int getMaskBorder() { return maskBorder; }
   const vpImage<unsigned char> &getMask() const { return mask; }
   const vpImage<int> &getPrimitiveIDs() const { return primitive_ids; }
+  /*!
+    Depth of the visible primitive at each pixel, or 0 where there is none.
+    It is only computed if enabled with setComputePrimitiveDepths().
+
+    \return Depth buffer of the last rendered scene.
+  */
+  const vpImage<float> &getPrimitiveDepths() const { return primitive_depths; }
 
   void queryLineVisibility(const vpPoint &a, const vpPoint &b, std::vector<std::pair<vpPoint, vpPoint> > &lines,
                            const bool &displayResults = false);
@@ -171,18 +187,25 @@ public:
   */
   void setDepthTreshold(const double &treshold) { depthTreshold = treshold; }
   void setMaskBorder(const unsigned int &mb) { maskBorder = mb; }
+  /*!
+    Enable/Disable the computation of the depth buffer, see
+    getPrimitiveDepths(). By default it is disabled.
+
+    \param compute : If true, the depth buffer is computed by drawScene().
+  */
+  void setComputePrimitiveDepths(const bool &compute) { computeDepths = compute; }
 
 private:
-  void createScanLinesFromLocals(std::vector<std::vector<vpMbScanLineSegment> > &scanlines,
-                                 std::vector<std::vector<vpMbScanLineSegment> > &localScanlines,
-                                 const unsigned int &size);
+  void createScanLinesFromLocals(std::vector<std::vector<vpMbScanLineSegment> > &scanlines);
 
-  void drawLineY(const vpColVector &a, const vpColVector &b, const vpMbScanLineEdge &line_ID, const int ID,
+  void drawLineY(const vpColVector &a, const vpColVector &b, const int edge, const int ID,
                  std::vector<std::vector<vpMbScanLineSegment> > &scanlines);
 
-  void drawLineX(const vpColVector &a, const vpColVector &b, const vpMbScanLineEdge &line_ID, const int ID,
+  void drawLineX(const vpColVector &a, const vpColVector &b, const int edge, const int ID,
                  std::vector<std::vector<vpMbScanLineSegment> > &scanlines);
 
+  int getEdgeIndex(const vpPoint &a, const vpPoint &b);
+
   void drawPolygonY(const std::vector<std::pair<vpPoint, unsigned int> > &polygon, const int ID,
                     std::vector<std::vector<vpMbScanLineSegment> > &scanlines);
 
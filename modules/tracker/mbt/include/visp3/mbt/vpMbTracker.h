@@ -66,6 +66,7 @@
 #include <visp3/core/vpRGBa.h>
 #include <visp3/core/vpRobust.h>
 #include <visp3/mbt/vpMbHiddenFaces.h>
+#include <visp3/mbt/vpMbtCompiledModel.h>
 #include <visp3/mbt/vpMbtPolygon.h>
 
 #include <visp3/mbt/vpMbtDistanceCircle.h>
@@ -225,6 +226,8 @@ protected:
   vpCameraParameters m_projectionErrorCam;
   //! Mask used to disable tracking on a part of image
   const vpImage<bool> *m_mask;
+  //! Directory of the compiled CAO models, no cache if empty
+  std::string m_modelCacheDirectory;
 
 public:
   vpMbTracker();
@@ -297,6 +300,13 @@ public:
    */
   virtual inline unsigned int getMaxIter() const { return m_maxIter; }
 
+  /*!
+    Get the directory where the compiled CAO models are cached.
+
+    \sa setModelCacheDirectory()
+  */
+  virtual inline std::string getModelCacheDirectory() const { return m_modelCacheDirectory; }
+
   /*!
     Get the error angle between the gradient direction of the model features
     projected at the resulting pose and their normal. The error is expressed
@@ -441,6 +451,8 @@ public:
   virtual void initFromPose(const vpImage<unsigned char> &I, const vpHomogeneousMatrix &cMo);
   virtual void initFromPose(const vpImage<unsigned char> &I, const vpPoseVector &cPo);
 
+  virtual void compileModel(const std::string &modelFile, vpMbtCompiledModel &model, const bool verbose = false);
+  virtual void loadCompiledModel(const vpMbtCompiledModel &model, const vpHomogeneousMatrix &T = vpHomogeneousMatrix());
   virtual void loadModel(const std::string &modelFile, const bool verbose = false, const vpHomogeneousMatrix &T=vpHomogeneousMatrix());
 
   /*!
@@ -529,6 +541,17 @@ public:
    */
   virtual inline void setMaxIter(const unsigned int max) { m_maxIter = max; }
 
+  /*!
+    Set the directory where the CAO models are cached once compiled. When
+    the directory is not empty, loadModel() maps the compiled model saved
+    by a previous call instead of parsing the CAO files, as long as these
+    files did not change. See vpMbtCompiledModel.
+
+    \param directory : Existing directory, or an empty string to disable the
+    cache (default).
+  */
+  virtual inline void setModelCacheDirectory(const std::string &directory) { m_modelCacheDirectory = directory; }
+
   virtual void setMinLineLengthThresh(const double minLineLengthThresh, const std::string &name = "");
 
   virtual void setMinPolygonAreaThresh(const double minPolygonAreaThresh, const std::string &name = "");
@@ -771,6 +794,9 @@ protected:
                                         vpColVector &R, const vpColVector &error, vpColVector &error_prev,
                                         vpColVector &LTR, double &mu, vpColVector &v, const vpColVector *const w = NULL,
                                         vpColVector *const m_w_prev = NULL);
+  void computeVVSPoseEstimationNormalEquations(const bool isoJoIdentity_, const unsigned int iter, const vpMatrix &LTL,
+                                               const vpColVector &LTR, const vpColVector &error,
+                                               vpColVector &error_prev, double &mu, vpColVector &v);
   virtual void computeVVSWeights(vpRobust &robust, const vpColVector &error, vpColVector &w);
 
 #ifdef VISP_HAVE_COIN3D
@@ -833,11 +859,14 @@ protected:
   void initProjectionErrorFaceFromCorners(vpMbtPolygon &polygon);
   void initProjectionErrorFaceFromLines(vpMbtPolygon &polygon);
 
+  void buildCAOModel(const vpMbtCompiledModel &model, int &startIdFace, const vpHomogeneousMatrix &T);
   virtual void loadVRMLModel(const std::string &modelFile);
   virtual void loadCAOModel(const std::string &modelFile, std::vector<std::string> &vectorOfModelFilename,
                             int &startIdFace, const bool verbose = false, const bool parent = true,
                             const vpHomogeneousMatrix &T=vpHomogeneousMatrix());
 
+  void parseCAOModel(const std::string &modelFile, std::vector<std::string> &vectorOfModelFilename,
+                     vpMbtCompiledModel &model, const bool verbose = false, const bool parent = true);
   void projectionErrorInitMovingEdge(const vpImage<unsigned char> &I, const vpHomogeneousMatrix &_cMo);
   void projectionErrorResetMovingEdges();
   void projectionErrorVisibleFace(const vpImage<unsigned char> &_I, const vpHomogeneousMatrix &_cMo);
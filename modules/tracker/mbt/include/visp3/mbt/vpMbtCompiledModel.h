@@ -0,0 +1,166 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ * Description:
+ * Compiled CAO model that can be saved in a binary cache file.
+ *
+ *****************************************************************************/
+
+/*!
+ \file vpMbtCompiledModel.h
+ \brief Compiled CAO model that can be saved in a binary cache file.
+*/
+
+#ifndef vpMbtCompiledModel_h
+#define vpMbtCompiledModel_h
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+
+/*!
+  \class vpMbtCompiledModel
+
+  \brief Result of the parsing of a CAO model file and of the files it
+  includes.
+
+  The model keeps the 3D points expressed in the frame of the CAO file and
+  the primitives in the order they have to be added to a tracker: faces
+  defined from lines or from points, lines that do not belong to a face,
+  cylinders and circles, with their name and their level of detail (LOD)
+  parameters when they are given in the file.
+
+  A model is obtained with vpMbTracker::compileModel(). It can be added to
+  several trackers with vpMbTracker::loadCompiledModel() without parsing the
+  file again, which is what vpMbGenericTracker::loadModel() does for the
+  trackers of each camera. The model can also be saved in a binary file and
+  loaded back. The file stores a hash of the content of the CAO files so
+  that isUpToDate() tells if the model has to be compiled again.
+  vpMbTracker::setModelCacheDirectory() makes the trackers use such cache
+  files transparently:
+
+  \code
+#include <visp3/mbt/vpMbGenericTracker.h>
+
+int main()
+{
+  vpMbGenericTracker tracker(2, vpMbGenericTracker::EDGE_TRACKER);
+  tracker.setModelCacheDirectory("/tmp/cao_cache");
+  // The first run parses the file, the next ones map the cache file
+  tracker.loadModel("assembly.cao");
+}
+  \endcode
+
+  \ingroup group_mbt_faces
+*/
+class VISP_EXPORT vpMbtCompiledModel
+{
+  friend class vpMbTracker;
+
+public:
+  //! Kind of primitive of the model.
+  typedef enum {
+    FACE_FROM_LINES,  //!< Face defined from lines, the indices are pairs of
+                      //!< line extremities.
+    FACE_FROM_POINTS, //!< Face defined from its corners.
+    SEGMENT,          //!< Line that does not belong to a face.
+    CYLINDER,         //!< Cylinder defined by two points on its axis.
+    CIRCLE            //!< Circle defined by its center and two points of its plane.
+  } vpPrimitiveType;
+
+  //! Primitive of the model.
+  struct vpPrimitive {
+    //! Kind of primitive.
+    vpPrimitiveType type;
+    //! Indices of the points of the primitive.
+    std::vector<unsigned int> indices;
+    //! Name of the primitive, empty if not given.
+    std::string name;
+    //! True when the useLod parameter is given in the file.
+    bool hasUseLod;
+    //! Value of the useLod parameter.
+    bool useLod;
+    //! True when a LOD threshold is given in the file.
+    bool hasThreshold;
+    //! Minimum polygon area for faces and circles, minimum line length for
+    //! segments and cylinders.
+    double threshold;
+    //! Radius of the cylinder or of the circle.
+    double radius;
+
+    vpPrimitive();
+  };
+
+  vpMbtCompiledModel();
+  explicit vpMbtCompiledModel(const std::string &filename);
+
+  void clear();
+
+  //! Return true if the model has no point.
+  inline bool empty() const { return m_points.empty(); }
+
+  //! Name of the main CAO file of the model.
+  inline std::string getModelFile() const { return m_sourceFiles.empty() ? "" : m_sourceFiles.front(); }
+  //! Number of 3D points of the model.
+  inline unsigned int getNbPoints() const { return (unsigned int)(m_points.size() / 3); }
+  void getPoint(const unsigned int index, double &X, double &Y, double &Z) const;
+  //! Primitives of the model, in the order they are added to a tracker.
+  inline const std::vector<vpPrimitive> &getPrimitives() const { return m_primitives; }
+  //! Main CAO file followed by the files it includes.
+  inline const std::vector<std::string> &getSourceFiles() const { return m_sourceFiles; }
+
+  bool isUpToDate() const;
+
+  void load(const std::string &filename);
+  void save(const std::string &filename) const;
+
+  static uint64_t computeFileHash(const std::string &filename);
+
+private:
+  vpMbtCompiledModel(const vpMbtCompiledModel &);
+  vpMbtCompiledModel &operator=(const vpMbtCompiledModel &);
+
+  void addSourceFile(const std::string &filename);
+
+  //! Coordinates of the points in the frame of the CAO file.
+  std::vector<double> m_points;
+  std::vector<vpPrimitive> m_primitives;
+  std::vector<std::string> m_sourceFiles;
+  std::vector<uint64_t> m_sourceHashes;
+  //! Number of elements declared in the files, as counted by vpMbTracker.
+  unsigned int m_nbLines;
+  unsigned int m_nbPolygonLines;
+  unsigned int m_nbPolygonPoints;
+  unsigned int m_nbCylinders;
+  unsigned int m_nbCircles;
+};
+
+#endif
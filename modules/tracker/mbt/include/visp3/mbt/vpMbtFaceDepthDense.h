@@ -109,6 +109,8 @@ public:
   );
 
   void computeInteractionMatrixAndResidu(const vpHomogeneousMatrix &cMo, vpMatrix &L, vpColVector &error);
+  void computeNormalEquations(const vpColVector &w, const unsigned int start, vpMatrix &LTL, vpColVector &LTR) const;
+  void computeResidu(const vpHomogeneousMatrix &cMo, vpColVector &error, const unsigned int start);
 
   void computeVisibility();
   void computeVisibilityDisplay();
@@ -0,0 +1,162 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Timings and counters of a tracking iteration of the generic model-based
+ * tracker.
+ *
+ *****************************************************************************/
+
+/*!
+ \file vpMbtTrackingStatistics.h
+ \brief Timings and counters of a tracking iteration of the generic
+ model-based tracker.
+*/
+
+#ifndef vpMbtTrackingStatistics_h
+#define vpMbtTrackingStatistics_h
+
+#include <map>
+#include <string>
+
+#include <visp3/core/vpConfig.h>
+
+/*!
+  \class vpMbtTrackingStatistics
+
+  \brief Timings and counters of the last call to vpMbGenericTracker::track().
+
+  The statistics are only computed when enabled with
+  vpMbGenericTracker::setTrackingStatisticsComputation(). They give the time
+  spent in each stage of the tracking, per camera for the stages that are run
+  by the tracker of each camera, the number of iterations of the virtual
+  visual servoing (VVS), the number of features of each type and the number
+  of features rejected by the robust estimation. All the durations are
+  expressed in milliseconds and measured with vpTime::measureMonotonicTimeMs().
+
+  \code
+#include <visp3/mbt/vpMbGenericTracker.h>
+
+void track(vpMbGenericTracker &tracker, const vpImage<unsigned char> &I, std::ofstream &csv)
+{
+  tracker.setTrackingStatisticsComputation(true);
+  tracker.track(I);
+
+  const vpMbtTrackingStatistics &stats = tracker.getTrackingStatistics();
+  std::cout << "VVS: " << stats.vvsTime << " ms, " << stats.nbIterations << " iterations" << std::endl;
+  if (stats.frame == 1)
+    csv << vpMbtTrackingStatistics::getCsvHeader() << std::endl;
+  csv << stats.toCsv();
+}
+  \endcode
+
+  \ingroup group_mbt_trackers
+*/
+class VISP_EXPORT vpMbtTrackingStatistics
+{
+public:
+  //! Timings and counters of the tracker of a camera.
+  struct VISP_EXPORT vpCameraStatistics {
+    //! Tracking of the moving edges.
+    double meTrackingTime;
+    //! Tracking of the KLT points.
+    double kltTrackingTime;
+    //! Segmentation of the point cloud for the depth normal features.
+    double depthNormalTime;
+    //! Segmentation of the point cloud for the dense depth features.
+    double depthDenseTime;
+    //! Update of the KLT points after the pose estimation.
+    double kltReinitTime;
+    //! Visibility test of the faces, including the scanline rendering.
+    double visibilityTime;
+    //! Update and initialization of the moving edges after the pose
+    //! estimation.
+    double meReinitTime;
+
+    //! Number of moving edge features used in the VVS.
+    unsigned int nbEdgeFeatures;
+    //! Number of KLT features used in the VVS.
+    unsigned int nbKltFeatures;
+    //! Number of depth normal features used in the VVS.
+    unsigned int nbDepthNormalFeatures;
+    //! Number of dense depth features used in the VVS.
+    unsigned int nbDepthDenseFeatures;
+
+    //! Number of moving edge features with a final robust weight below 0.5.
+    unsigned int nbEdgeRejected;
+    //! Number of KLT features with a final robust weight below 0.5.
+    unsigned int nbKltRejected;
+    //! Number of depth normal features with a final robust weight below 0.5.
+    unsigned int nbDepthNormalRejected;
+    //! Number of dense depth features with a final robust weight below 0.5.
+    unsigned int nbDepthDenseRejected;
+
+    //! Number of moving edge sites kept after the tracking.
+    unsigned int nbMeTracked;
+    //! Number of moving edge sites rejected by the contrast test.
+    unsigned int nbMeContrast;
+    //! Number of moving edge sites rejected by the likelihood threshold.
+    unsigned int nbMeThreshold;
+    //! Number of moving edge sites rejected by the robust estimation.
+    unsigned int nbMeMEstimator;
+    //! Number of moving edge sites rejected for being too close to another.
+    unsigned int nbMeTooNear;
+
+    vpCameraStatistics();
+    void reset();
+  };
+
+  //! Number of calls to vpMbGenericTracker::track() since the computation of
+  //! the statistics has been enabled, the current one included.
+  unsigned int frame;
+  //! Duration of the whole call to vpMbGenericTracker::track().
+  double totalTime;
+  //! Duration of the pose estimation by VVS, covariance excepted.
+  double vvsTime;
+  //! Duration of the computation of the covariance matrix.
+  double covarianceTime;
+  //! Duration of the computation of the projection error.
+  double projectionErrorTime;
+  //! Number of iterations of the VVS.
+  unsigned int nbIterations;
+  //! Statistics of the tracker of each camera, the key is the camera name.
+  std::map<std::string, vpCameraStatistics> cameras;
+
+  vpMbtTrackingStatistics();
+
+  static std::string getCsvHeader();
+
+  void reset();
+
+  std::string toCsv() const;
+  std::string toJson() const;
+};
+
+#endif
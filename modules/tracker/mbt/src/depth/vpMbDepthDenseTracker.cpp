@@ -43,6 +43,7 @@
 
 #include <visp3/core/vpDisplay.h>
 #include <visp3/core/vpExponentialMap.h>
+#include <visp3/core/vpTracing.h>
 #include <visp3/core/vpTrackingException.h>
 #include <visp3/mbt/vpMbDepthDenseTracker.h>
 #include <visp3/mbt/vpMbtXmlGenericParser.h>
@@ -55,7 +56,8 @@
 vpMbDepthDenseTracker::vpMbDepthDenseTracker()
   : m_depthDenseHiddenFacesDisplay(), m_depthDenseI_dummyVisibility(), m_depthDenseListOfActiveFaces(),
     m_denseDepthNbFeatures(0), m_depthDenseFaces(), m_depthDenseSamplingStepX(2), m_depthDenseSamplingStepY(2),
-    m_error_depthDense(), m_L_depthDense(), m_robust_depthDense(), m_w_depthDense(), m_weightedError_depthDense()
+    m_error_depthDense(), m_L_depthDense(), m_robust_depthDense(), m_w_depthDense(), m_weightedError_depthDense(),
+    m_depthDenseNormalEquations(false)
 #if DEBUG_DISPLAY_DEPTH_DENSE
     ,
     m_debugDisp_depthDense(NULL), m_debugImage_depthDense()
@@ -153,6 +155,11 @@ void vpMbDepthDenseTracker::computeVisibility(const unsigned int width, const un
 
 void vpMbDepthDenseTracker::computeVVS()
 {
+  if (m_depthDenseNormalEquations && !computeCovariance) {
+    computeVVSNormalEquations();
+    return;
+  }
+
   double normRes = 0;
   double normRes_1 = -1;
   unsigned int iter = 0;
@@ -245,6 +252,115 @@ void vpMbDepthDenseTracker::computeVVS()
   computeCovarianceMatrixVVS(isoJoIdentity_, m_w_depthDense, cMo_prev, L_true, LVJ_true, m_error_depthDense);
 }
 
+/*!
+  Virtual visual servoing where each face adds its contribution to the 6x6
+  normal equations instead of stacking its rows in the interaction matrix.
+  Only the residuals and the robust weights are stored for each point, which
+  avoids the Nx6 interaction matrix and its weighting at each iteration.
+*/
+void vpMbDepthDenseTracker::computeVVSNormalEquations()
+{
+  double normRes = 0;
+  double normRes_1 = -1;
+  unsigned int iter = 0;
+
+  m_denseDepthNbFeatures = 0;
+  for (std::vector<vpMbtFaceDepthDense *>::const_iterator it = m_depthDenseListOfActiveFaces.begin();
+       it != m_depthDenseListOfActiveFaces.end(); ++it) {
+    m_denseDepthNbFeatures += (*it)->getNbFeatures();
+  }
+
+  m_L_depthDense.resize(0, 0);
+  m_weightedError_depthDense.resize(0);
+  m_error_depthDense.resize(m_denseDepthNbFeatures, false);
+  m_w_depthDense.resize(m_denseDepthNbFeatures, false);
+
+  vpColVector error_prev(m_denseDepthNbFeatures);
+  vpMatrix LTL(6, 6);
+  vpColVector LTR(6), v;
+
+  double mu = m_initialMu;
+  vpHomogeneousMatrix cMo_prev;
+
+  bool isoJoIdentity_ = true;
+
+  while (std::fabs(normRes_1 - normRes) > m_stopCriteriaEpsilon && (iter < m_maxIter)) {
+    unsigned int start_index = 0;
+    for (std::vector<vpMbtFaceDepthDense *>::const_iterator it = m_depthDenseListOfActiveFaces.begin();
+         it != m_depthDenseListOfActiveFaces.end(); ++it) {
+      (*it)->computeResidu(cMo, m_error_depthDense, start_index);
+      start_index += (*it)->getNbFeatures();
+    }
+
+    bool reStartFromLastIncrement = false;
+    computeVVSCheckLevenbergMarquardt(iter, m_error_depthDense, error_prev, cMo_prev, mu, reStartFromLastIncrement);
+
+    if (!reStartFromLastIncrement) {
+      // Compute DoF only once, with the unweighted interaction matrix
+      if (iter == 0) {
+        isoJoIdentity_ = true;
+        oJo.eye();
+
+        m_w_depthDense = 1;
+        LTL = 0;
+        LTR = 0;
+        start_index = 0;
+        for (std::vector<vpMbtFaceDepthDense *>::const_iterator it = m_depthDenseListOfActiveFaces.begin();
+             it != m_depthDenseListOfActiveFaces.end(); ++it) {
+          (*it)->computeNormalEquations(m_w_depthDense, start_index, LTL, LTR);
+          start_index += (*it)->getNbFeatures();
+        }
+
+        // (L V)^T (L V) = V^T L^T L V since L^T L is symmetric. Its singular
+        // values are the squares of those of L V, hence the squared threshold
+        vpVelocityTwistMatrix cVo;
+        cVo.buildFrom(cMo);
+        vpMatrix LTLV = LTL * cVo;
+        vpMatrix K; // kernel
+        unsigned int rank = (LTLV.t() * cVo).kernel(K, 1e-12);
+        if (rank == 0) {
+          throw vpException(vpException::fatalError, "Rank=0, cannot estimate the pose !");
+        }
+
+        if (rank != 6) {
+          vpMatrix I; // Identity
+          I.eye(6);
+          oJo = I - K.AtA();
+
+          isoJoIdentity_ = false;
+        }
+      }
+
+      computeVVSWeights();
+
+      double num = 0.0, den = 0.0;
+      for (unsigned int i = 0; i < m_denseDepthNbFeatures; i++) {
+        num += m_w_depthDense[i] * vpMath::sqr(m_error_depthDense[i]);
+        den += m_w_depthDense[i];
+      }
+
+      LTL = 0;
+      LTR = 0;
+      start_index = 0;
+      for (std::vector<vpMbtFaceDepthDense *>::const_iterator it = m_depthDenseListOfActiveFaces.begin();
+           it != m_depthDenseListOfActiveFaces.end(); ++it) {
+        (*it)->computeNormalEquations(m_w_depthDense, start_index, LTL, LTR);
+        start_index += (*it)->getNbFeatures();
+      }
+
+      computeVVSPoseEstimationNormalEquations(isoJoIdentity_, iter, LTL, LTR, m_error_depthDense, error_prev, mu, v);
+
+      cMo_prev = cMo;
+      cMo = vpExponentialMap::direct(v).inverse() * cMo;
+
+      normRes_1 = normRes;
+      normRes = sqrt(num / den);
+    }
+
+    iter++;
+  }
+}
+
 void vpMbDepthDenseTracker::computeVVSInit()
 {
   m_denseDepthNbFeatures = 0;
@@ -287,6 +403,30 @@ void vpMbDepthDenseTracker::computeVVSWeights()
   m_robust_depthDense.MEstimator(m_error_depthDense, m_w_depthDense, 1e-3);
 }
 
+/*!
+  Enable or disable the accumulation of the normal equations during the pose
+  estimation. When enabled, each face directly adds its contribution to the
+  6x6 matrix \f$ \mathbf{L}^T \mathbf{W} \mathbf{L} \f$ and to the gradient
+  \f$ \mathbf{L}^T \mathbf{W} \mathbf{e} \f$ from the moments of its point
+  cloud instead of stacking one row per point in the interaction matrix,
+  which drastically reduces the memory traffic with dense point clouds. The
+  estimated pose is the same up to rounding errors.
+
+  The interaction matrix is still stacked when the covariance matrix is
+  computed, see setCovarianceComputation().
+
+  \warning This mode is only available with this standalone dense depth
+  tracker. The edge, KLT and depth normal trackers, and vpMbGenericTracker
+  even when it only uses dense depth features, always stack the interaction
+  matrix.
+
+  \param enable : If true, accumulate the normal equations.
+*/
+void vpMbDepthDenseTracker::setDepthDenseNormalEquations(const bool enable)
+{
+  m_depthDenseNormalEquations = enable;
+}
+
 void vpMbDepthDenseTracker::display(const vpImage<unsigned char> &I, const vpHomogeneousMatrix &cMo_,
                                     const vpCameraParameters &cam_, const vpColor &col, const unsigned int thickness,
                                     const bool displayFullModel)
@@ -700,6 +840,7 @@ void vpMbDepthDenseTracker::track(const vpImage<unsigned char> &)
 #ifdef VISP_HAVE_PCL
 void vpMbDepthDenseTracker::track(const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud)
 {
+  VP_TRACING_SCOPE("vpMbDepthDenseTracker::track");
   segmentPointCloud(point_cloud);
 
   computeVVS();
@@ -711,6 +852,7 @@ void vpMbDepthDenseTracker::track(const pcl::PointCloud<pcl::PointXYZ>::ConstPtr
 void vpMbDepthDenseTracker::track(const std::vector<vpColVector> &point_cloud, const unsigned int width,
                                   const unsigned int height)
 {
+  VP_TRACING_SCOPE("vpMbDepthDenseTracker::track");
   segmentPointCloud(point_cloud, width, height);
 
   computeVVS();
@@ -43,6 +43,7 @@
 
 #include <visp3/core/vpDisplay.h>
 #include <visp3/core/vpExponentialMap.h>
+#include <visp3/core/vpTracing.h>
 #include <visp3/core/vpTrackingException.h>
 #include <visp3/mbt/vpMbDepthNormalTracker.h>
 #include <visp3/mbt/vpMbtXmlGenericParser.h>
@@ -741,6 +742,7 @@ void vpMbDepthNormalTracker::track(const vpImage<unsigned char> &)
 #ifdef VISP_HAVE_PCL
 void vpMbDepthNormalTracker::track(const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud)
 {
+  VP_TRACING_SCOPE("vpMbDepthNormalTracker::track");
   segmentPointCloud(point_cloud);
 
   computeVVS();
@@ -752,6 +754,7 @@ void vpMbDepthNormalTracker::track(const pcl::PointCloud<pcl::PointXYZ>::ConstPt
 void vpMbDepthNormalTracker::track(const std::vector<vpColVector> &point_cloud, const unsigned int width,
                                    const unsigned int height)
 {
+  VP_TRACING_SCOPE("vpMbDepthNormalTracker::track");
   segmentPointCloud(point_cloud, width, height);
 
   computeVVS();
@@ -34,6 +34,7 @@
  *****************************************************************************/
 
 #include <visp3/core/vpCPUFeatures.h>
+#include <visp3/core/vpMatrixFixed.h>
 #include <visp3/mbt/vpMbtFaceDepthDense.h>
 
 #if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
@@ -48,6 +49,24 @@
 #define USE_SSE 0
 #endif
 
+namespace
+{
+// Offset in m_pointCloudFace of the x coordinate of the point i and stride
+// between its x, y and z coordinates. When the point cloud has been built for
+// the SSE2 code, the points are stored by pairs (x0 x1 y0 y1 z0 z1), the last
+// point being stored alone when the number of points is odd.
+inline size_t pointOffset(const bool pairs, const size_t nbPairs, const size_t i, size_t &stride)
+{
+  if (pairs && i < 2 * nbPairs) {
+    stride = 2;
+    return 6 * (i / 2) + (i % 2);
+  }
+
+  stride = 1;
+  return 3 * i;
+}
+}
+
 vpMbtFaceDepthDense::vpMbtFaceDepthDense()
   : m_cam(), m_clippingFlag(vpPolygon3D::NO_CLIPPING), m_distFarClip(100), m_distNearClip(0.001), m_hiddenFace(NULL),
     m_planeObject(), m_polygon(NULL), m_useScanLine(false),
@@ -205,12 +224,18 @@ bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo,
 #endif
 
   int totalTheoreticalPoints = 0, totalPoints = 0;
+  std::vector<std::pair<unsigned int, unsigned int> > spans;
   for (unsigned int i = top; i < bottom; i += stepY) {
+    size_t span_index = 0;
+    if (!m_useScanLine) {
+      polygon_2d.getRowSpans(i, left, right, spans);
+    }
+
     for (unsigned int j = left; j < right; j += stepX) {
       if ((m_useScanLine ? (i < m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getHeight() &&
                             j < m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getWidth() &&
                             m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs()[i][j] == m_polygon->getIndex())
-                         : polygon_2d.isInside(vpImagePoint(i, j)))) {
+                         : vpPolygon::isInsideRowSpans(spans, j, span_index))) {
         totalTheoreticalPoints++;
 
         if (vpMeTracker::inMask(mask, i, j) && pcl::isFinite((*point_cloud)(j, i)) && (*point_cloud)(j, i).z > 0) {
@@ -328,12 +353,18 @@ bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo,
 #endif
 
   int totalTheoreticalPoints = 0, totalPoints = 0;
+  std::vector<std::pair<unsigned int, unsigned int> > spans;
   for (unsigned int i = top; i < bottom; i += stepY) {
+    size_t span_index = 0;
+    if (!m_useScanLine) {
+      polygon_2d.getRowSpans(i, left, right, spans);
+    }
+
     for (unsigned int j = left; j < right; j += stepX) {
       if ((m_useScanLine ? (i < m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getHeight() &&
                             j < m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getWidth() &&
                             m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs()[i][j] == m_polygon->getIndex())
-                         : polygon_2d.isInside(vpImagePoint(i, j)))) {
+                         : vpPolygon::isInsideRowSpans(spans, j, span_index))) {
         totalTheoreticalPoints++;
 
         if (vpMeTracker::inMask(mask, i, j) && point_cloud[i * width + j][2] > 0) {
@@ -575,6 +606,125 @@ void vpMbtFaceDepthDense::computeInteractionMatrixAndResidu(const vpHomogeneousM
   }
 }
 
+/*!
+  Compute the point to plane distances for the current pose, without the
+  interaction matrix. The residuals are stored in \e error from the index \e
+  start, in the same order as with computeInteractionMatrixAndResidu().
+*/
+void vpMbtFaceDepthDense::computeResidu(const vpHomogeneousMatrix &cMo, vpColVector &error, const unsigned int start)
+{
+  // Transform the plane equation for the current pose
+  m_planeCamera = m_planeObject;
+  m_planeCamera.changeFrame(cMo);
+
+  const double nx = m_planeCamera.getA();
+  const double ny = m_planeCamera.getB();
+  const double nz = m_planeCamera.getC();
+  const double D = m_planeCamera.getD();
+
+  bool pairs = vpCPUFeatures::checkSSE2();
+#if !USE_SSE
+  pairs = false;
+#endif
+
+  const size_t nbPoints = getNbFeatures();
+  const size_t nbPairs = nbPoints / 2;
+  for (size_t i = 0; i < nbPoints; i++) {
+    size_t stride;
+    const double *pt = &m_pointCloudFace[pointOffset(pairs, nbPairs, i, stride)];
+    error[(unsigned int)(start + i)] = D + nx * pt[0] + ny * pt[stride] + nz * pt[2 * stride];
+  }
+}
+
+/*!
+  Add the contribution of the face to the normal equations
+  \f$ \mathbf{L}^T \mathbf{W}^2 \mathbf{L} \f$ and
+  \f$ \mathbf{L}^T \mathbf{W}^2 \mathbf{e} \f$ of the plane computed by
+  the last call to computeResidu(), \e w being the robust weights indexed from
+  \e start.
+
+  Since the interaction matrix row of a point \f$ \mathbf{p} \f$ is
+  \f$ (\mathbf{n}^T, (\mathbf{p} \times \mathbf{n})^T) \f$, both terms
+  only depend on the weighted moments \f$ \sum w_i^2 \f$,
+  \f$ \sum w_i^2 \mathbf{p}_i \f$ and
+  \f$ \sum w_i^2 \mathbf{p}_i \mathbf{p}_i^T \f$ that are accumulated in
+  parallel with OpenMP.
+*/
+void vpMbtFaceDepthDense::computeNormalEquations(const vpColVector &w, const unsigned int start, vpMatrix &LTL,
+                                                 vpColVector &LTR) const
+{
+  bool pairs = vpCPUFeatures::checkSSE2();
+#if !USE_SSE
+  pairs = false;
+#endif
+
+  const int nbPoints = (int)getNbFeatures();
+  const size_t nbPairs = (size_t)nbPoints / 2;
+  double s = 0, sx = 0, sy = 0, sz = 0, sxx = 0, sxy = 0, sxz = 0, syy = 0, syz = 0, szz = 0;
+
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for reduction(+ : s, sx, sy, sz, sxx, sxy, sxz, syy, syz, szz) if (nbPoints > 4096)
+#endif
+  for (int i = 0; i < nbPoints; i++) {
+    size_t stride;
+    const double *pt = &m_pointCloudFace[pointOffset(pairs, nbPairs, (size_t)i, stride)];
+    const double x = pt[0], y = pt[stride], z = pt[2 * stride];
+    const double q = w[start + (unsigned int)i] * w[start + (unsigned int)i];
+    const double qx = q * x, qy = q * y, qz = q * z;
+
+    s += q;
+    sx += qx;
+    sy += qy;
+    sz += qz;
+    sxx += qx * x;
+    sxy += qx * y;
+    sxz += qx * z;
+    syy += qy * y;
+    syz += qy * z;
+    szz += qz * z;
+  }
+
+  vpMatrixFixed<3, 1> n, S1;
+  n[0][0] = m_planeCamera.getA();
+  n[1][0] = m_planeCamera.getB();
+  n[2][0] = m_planeCamera.getC();
+  const double D = m_planeCamera.getD();
+  S1[0][0] = sx;
+  S1[1][0] = sy;
+  S1[2][0] = sz;
+
+  vpMatrixFixed<3, 3> S2, N;
+  S2[0][0] = sxx;
+  S2[0][1] = S2[1][0] = sxy;
+  S2[0][2] = S2[2][0] = sxz;
+  S2[1][1] = syy;
+  S2[1][2] = S2[2][1] = syz;
+  S2[2][2] = szz;
+  // N = [n]_x so that p x n = -N p
+  N[0][1] = -n[2][0];
+  N[0][2] = n[1][0];
+  N[1][0] = n[2][0];
+  N[1][2] = -n[0][0];
+  N[2][0] = -n[1][0];
+  N[2][1] = n[0][0];
+
+  const vpMatrixFixed<3, 1> Sa = -(N * S1);                  // sum q a
+  const vpMatrixFixed<3, 3> Saa = N * S2 * N.t();            // sum q a a^T
+  const double Se = (n.t() * S1)[0][0] + D * s;              // sum q e
+  const vpMatrixFixed<3, 1> Sea = -(N * (S2 * n + S1 * D)); // sum q e a
+
+  for (unsigned int i = 0; i < 3; i++) {
+    for (unsigned int j = 0; j < 3; j++) {
+      LTL[i][j] += s * n[i][0] * n[j][0];
+      LTL[i][j + 3] += n[i][0] * Sa[j][0];
+      LTL[i + 3][j] += Sa[i][0] * n[j][0];
+      LTL[i + 3][j + 3] += Saa[i][j];
+    }
+    LTR[i] += n[i][0] * Se;
+    LTR[i + 3] += Sea[i][0];
+  }
+}
+
 void vpMbtFaceDepthDense::computeROI(const vpHomogeneousMatrix &cMo, const unsigned int width,
                                      const unsigned int height, std::vector<vpImagePoint> &roiPts
 #if DEBUG_DISPLAY_DEPTH_DENSE
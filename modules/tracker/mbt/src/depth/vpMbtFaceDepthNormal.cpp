@@ -217,13 +217,19 @@ bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo
 #endif
 
   double x = 0.0, y = 0.0;
+  std::vector<std::pair<unsigned int, unsigned int> > spans;
   for (unsigned int i = top; i < bottom; i += stepY) {
+    size_t span_index = 0;
+    if (!m_useScanLine) {
+      polygon_2d.getRowSpans(i, left, right, spans);
+    }
+
     for (unsigned int j = left; j < right; j += stepX) {
       if (vpMeTracker::inMask(mask, i, j) && pcl::isFinite((*point_cloud)(j, i)) && (*point_cloud)(j, i).z > 0 &&
           (m_useScanLine ? (i < m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getHeight() &&
                             j < m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getWidth() &&
                             m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs()[i][j] == m_polygon->getIndex())
-                         : polygon_2d.isInside(vpImagePoint(i, j)))) {
+                         : vpPolygon::isInsideRowSpans(spans, j, span_index))) {
 
         if (m_featureEstimationMethod == PCL_PLANE_ESTIMATION) {
           point_cloud_face->push_back((*point_cloud)(j, i));
@@ -372,13 +378,19 @@ bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo
 #endif
 
   double x = 0.0, y = 0.0;
+  std::vector<std::pair<unsigned int, unsigned int> > spans;
   for (unsigned int i = top; i < bottom; i += stepY) {
+    size_t span_index = 0;
+    if (!m_useScanLine) {
+      polygon_2d.getRowSpans(i, left, right, spans);
+    }
+
     for (unsigned int j = left; j < right; j += stepX) {
       if (vpMeTracker::inMask(mask, i, j) && point_cloud[i * width + j][2] > 0 &&
           (m_useScanLine ? (i < m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getHeight() &&
                             j < m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs().getWidth() &&
                             m_hiddenFace->getMbScanLineRenderer().getPrimitiveIDs()[i][j] == m_polygon->getIndex())
-                         : polygon_2d.isInside(vpImagePoint(i, j)))) {
+                         : vpPolygon::isInsideRowSpans(spans, j, span_index))) {
         // Add point
         point_cloud_face.push_back(point_cloud[i * width + j][0]);
         point_cloud_face.push_back(point_cloud[i * width + j][1]);
@@ -55,7 +55,7 @@
   Basic constructor
 */
 vpMbEdgeMultiTracker::vpMbEdgeMultiTracker()
-  : m_mapOfCameraTransformationMatrix(), m_mapOfEdgeTrackers(), m_mapOfPyramidalImages(),
+  : m_mapOfCameraTransformationMatrix(), m_mapOfEdgeTrackers(), m_mapOfPyramidalImages(), m_mapOfPyramidBuffers(),
     m_referenceCameraName("Camera"), m_L_edgeMulti(), m_error_edgeMulti(), m_w_edgeMulti(), m_weightedError_edgeMulti()
 {
   m_mapOfEdgeTrackers["Camera"] = new vpMbEdgeTracker();
@@ -70,7 +70,7 @@ vpMbEdgeMultiTracker::vpMbEdgeMultiTracker()
   \param nbCameras : Number of cameras to use.
 */
 vpMbEdgeMultiTracker::vpMbEdgeMultiTracker(const unsigned int nbCameras)
-  : m_mapOfCameraTransformationMatrix(), m_mapOfEdgeTrackers(), m_mapOfPyramidalImages(),
+  : m_mapOfCameraTransformationMatrix(), m_mapOfEdgeTrackers(), m_mapOfPyramidalImages(), m_mapOfPyramidBuffers(),
     m_referenceCameraName("Camera"), m_L_edgeMulti(), m_error_edgeMulti(), m_w_edgeMulti(), m_weightedError_edgeMulti()
 {
 
@@ -114,7 +114,7 @@ vpMbEdgeMultiTracker::vpMbEdgeMultiTracker(const unsigned int nbCameras)
   \param cameraNames : List of camera names.
 */
 vpMbEdgeMultiTracker::vpMbEdgeMultiTracker(const std::vector<std::string> &cameraNames)
-  : m_mapOfCameraTransformationMatrix(), m_mapOfEdgeTrackers(), m_mapOfPyramidalImages(),
+  : m_mapOfCameraTransformationMatrix(), m_mapOfEdgeTrackers(), m_mapOfPyramidalImages(), m_mapOfPyramidBuffers(),
     m_referenceCameraName("Camera"), m_L_edgeMulti(), m_error_edgeMulti(), m_w_edgeMulti(), m_weightedError_edgeMulti()
 {
 
@@ -149,16 +149,8 @@ void vpMbEdgeMultiTracker::cleanPyramid(std::map<std::string, std::vector<const
 {
   for (std::map<std::string, std::vector<const vpImage<unsigned char> *> >::iterator it1 = pyramid.begin();
        it1 != pyramid.end(); ++it1) {
-    if (it1->second.size() > 0) {
-      it1->second[0] = NULL;
-      for (size_t i = 1; i < it1->second.size(); i++) {
-        if (it1->second[i] != NULL) {
-          delete it1->second[i];
-          it1->second[i] = NULL;
-        }
-      }
-      it1->second.clear();
-    }
+    // The images of the levels belong to m_mapOfPyramidBuffers
+    vpMbEdgeTracker::cleanPyramid(it1->second);
   }
 }
 
@@ -1649,9 +1641,7 @@ void vpMbEdgeMultiTracker::initPyramid(const std::map<std::string, const vpImage
 {
   for (std::map<std::string, const vpImage<unsigned char> *>::const_iterator it = mapOfImages.begin();
        it != mapOfImages.end(); ++it) {
-    pyramid[it->first].resize(scales.size());
-
-    vpMbEdgeTracker::initPyramid(*it->second, pyramid[it->first]);
+    vpMbEdgeTracker::initPyramid(*it->second, pyramid[it->first], m_mapOfPyramidBuffers[it->first]);
   }
 }
 
@@ -1829,6 +1819,24 @@ void vpMbEdgeMultiTracker::loadConfigFile(const std::map<std::string, std::strin
   }
 }
 
+/*!
+  Add a model compiled with vpMbTracker::compileModel() to the trackers of
+  all the cameras.
+
+  \param model : Compiled model.
+  \param T : optional transformation matrix to transform 3D points expressed
+  in the original object frame to the desired object frame.
+*/
+void vpMbEdgeMultiTracker::loadCompiledModel(const vpMbtCompiledModel &model, const vpHomogeneousMatrix &T)
+{
+  for (std::map<std::string, vpMbEdgeTracker *>::const_iterator it = m_mapOfEdgeTrackers.begin();
+       it != m_mapOfEdgeTrackers.end(); ++it) {
+    it->second->loadCompiledModel(model, T);
+  }
+
+  modelInitialised = true;
+}
+
 /*!
   Load a 3D model from the file in parameter. This file must either be a vrml
   file (.wrl) or a CAO file (.cao). CAO format is described in the
@@ -43,6 +43,7 @@
   \brief Make the complete tracking of an object by using its CAD model.
 */
 
+#include <visp3/core/vpCPUFeatures.h>
 #include <visp3/core/vpDebug.h>
 #include <visp3/core/vpException.h>
 #include <visp3/core/vpExponentialMap.h>
@@ -50,6 +51,8 @@
 #include <visp3/core/vpMatrixException.h>
 #include <visp3/core/vpPixelMeterConversion.h>
 #include <visp3/core/vpPolygon3D.h>
+#include <visp3/core/vpTime.h>
+#include <visp3/core/vpTracing.h>
 #include <visp3/core/vpTrackingException.h>
 #include <visp3/core/vpVelocityTwistMatrix.h>
 #include <visp3/mbt/vpMbEdgeTracker.h>
@@ -57,12 +60,76 @@
 #include <visp3/mbt/vpMbtXmlParser.h>
 #include <visp3/vision/vpPose.h>
 
+#include <algorithm>
 #include <float.h>
 #include <limits>
 #include <map>
 #include <sstream>
 #include <string>
 
+#ifdef VISP_HAVE_OPENMP
+#include <omp.h>
+#endif
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
+namespace
+{
+// Primitive whose moving edges have to be tracked. The cost is the number of
+// moving edge sites, used to balance the work between the threads.
+struct vpMbtTrackingTask {
+  vpMbtDistanceLine *line;
+  vpMbtDistanceCylinder *cylinder;
+  vpMbtDistanceCircle *circle;
+  size_t cost;
+  size_t index;
+};
+
+bool compareTrackingTaskCost(const vpMbtTrackingTask &a, const vpMbtTrackingTask &b)
+{
+  if (a.cost != b.cost)
+    return a.cost > b.cost;
+  return a.index < b.index;
+}
+
+// Keep one pixel over two in each direction: dst[i][j] = src[2i][2j]
+void subsample(const vpImage<unsigned char> &src, vpImage<unsigned char> &dst)
+{
+  dst.resize(src.getHeight() / 2, src.getWidth() / 2);
+  const unsigned int width = dst.getWidth();
+
+  bool checkSSE2 = vpCPUFeatures::checkSSE2();
+#if !VISP_HAVE_SSE2
+  checkSSE2 = false;
+#endif
+
+  for (unsigned int i = 0; i < dst.getHeight(); i++) {
+    const unsigned char *srcRow = src[2 * i];
+    unsigned char *dstRow = dst[i];
+    unsigned int j = 0;
+
+    if (checkSSE2) {
+#if VISP_HAVE_SSE2
+      // The even bytes of 32 source pixels are packed into 16 destination pixels
+      const __m128i mask = _mm_set1_epi16(0x00FF);
+      for (; j + 16 <= width; j += 16) {
+        const __m128i lo = _mm_and_si128(_mm_loadu_si128((const __m128i *)(srcRow + 2 * j)), mask);
+        const __m128i hi = _mm_and_si128(_mm_loadu_si128((const __m128i *)(srcRow + 2 * j + 16)), mask);
+        _mm_storeu_si128((__m128i *)(dstRow + j), _mm_packus_epi16(lo, hi));
+      }
+#endif
+    }
+
+    for (; j < width; j++) {
+      dstRow[j] = srcRow[2 * j];
+    }
+  }
+}
+}
+
 /*!
   Basic constructor
 */
@@ -71,7 +138,9 @@ vpMbEdgeTracker::vpMbEdgeTracker()
     percentageGdPt(0.4), scales(1), Ipyramid(0), scaleLevel(0), nbFeaturesForProjErrorComputation(0), m_factor(),
     m_robustLines(), m_robustCylinders(), m_robustCircles(), m_wLines(), m_wCylinders(), m_wCircles(), m_errorLines(),
     m_errorCylinders(), m_errorCircles(), m_L_edge(), m_error_edge(), m_w_edge(), m_weightedError_edge(),
-    m_robust_edge()
+    m_robust_edge(), m_nbThreads(1), m_pyramidBuffers(), m_scaleScheduling(false), m_scaleMotionThreshold(2.0),
+    m_lastMotion(DBL_MAX), m_staleScales(1, false), m_scaleLastTimes(1, 0.), m_scaleTotalTimes(1, 0.),
+    m_scaleNbTracked(1, 0), m_scaleNbSkipped(1, 0)
 {
   angleAppears = vpMath::rad(89);
   angleDisappears = vpMath::rad(89);
@@ -158,6 +227,84 @@ void vpMbEdgeTracker::setMovingEdge(const vpMe &p_me)
   }
 }
 
+/*!
+  Set the number of threads used to track the moving edges. The visible
+  primitives (lines, cylinders and circles) are distributed between the
+  threads. This has no effect if ViSP is not built with OpenMP.
+
+  \param nbThreads : Number of threads. 1 (the default value) means that the
+  moving edges are tracked sequentially, 0 that all the available threads are
+  used.
+
+  \sa getNbThreads()
+*/
+void vpMbEdgeTracker::setNbThreads(const unsigned int nbThreads) { m_nbThreads = nbThreads; }
+
+/*!
+  Enable or disable the scheduling of the levels of the pyramid used for the
+  multi-scale tracking (see setScales()).
+
+  When enabled, the coarse levels are skipped as long as they are not
+  needed:
+  - if the model moved less than \e motionThreshold pixels during the
+  previous call to track(), only the finest level is tracked;
+  - once the pose estimated on a coarse level moves the model less than
+  \e motionThreshold pixels, the next coarse levels are skipped and the
+  tracking goes directly to the finest level.
+
+  If the tracking fails on the finest level while coarse levels were
+  skipped, the frame is tracked again with all the levels. The moving edges
+  of a skipped level are re-initialized from the current pose the next time
+  the level is used. This keeps the robustness of the multi-scale tracking to
+  fast motions while the cost of a frame with a slow motion is the one of a
+  single level.
+
+  \param enable : True to enable the scheduling. It is disabled by default.
+  \param motionThreshold : Largest displacement, in pixels, of the corners of
+  the visible faces below which the coarse levels are skipped.
+
+  \sa getScaleStatistics()
+*/
+void vpMbEdgeTracker::setScaleScheduling(const bool enable, const double motionThreshold)
+{
+  m_scaleScheduling = enable;
+  m_scaleMotionThreshold = motionThreshold;
+  m_lastMotion = DBL_MAX;
+}
+
+/*!
+  Get the time spent on each level of the pyramid by track().
+
+  \param lastTimes : Time in ms spent on each level during the last call to
+  track(), 0 if the level was not used.
+  \param meanTimes : Mean time in ms spent on each level when it is used.
+  \param nbSkipped : Number of times each level has been skipped by the scale
+  scheduling (see setScaleScheduling()).
+
+  \sa resetScaleStatistics()
+*/
+void vpMbEdgeTracker::getScaleStatistics(std::vector<double> &lastTimes, std::vector<double> &meanTimes,
+                                         std::vector<unsigned int> &nbSkipped) const
+{
+  lastTimes = m_scaleLastTimes;
+  nbSkipped = m_scaleNbSkipped;
+  meanTimes.resize(m_scaleTotalTimes.size());
+  for (size_t i = 0; i < m_scaleTotalTimes.size(); i++) {
+    meanTimes[i] = m_scaleNbTracked[i] > 0 ? m_scaleTotalTimes[i] / m_scaleNbTracked[i] : 0.;
+  }
+}
+
+/*!
+  Reset the statistics returned by getScaleStatistics().
+*/
+void vpMbEdgeTracker::resetScaleStatistics()
+{
+  m_scaleLastTimes.assign(scales.size(), 0.);
+  m_scaleTotalTimes.assign(scales.size(), 0.);
+  m_scaleNbTracked.assign(scales.size(), 0);
+  m_scaleNbSkipped.assign(scales.size(), 0);
+}
+
 /*!
   Compute the visual servoing loop to get the pose of the feature set.
 
@@ -1031,8 +1178,25 @@ void vpMbEdgeTracker::testTracking()
  */
 void vpMbEdgeTracker::track(const vpImage<unsigned char> &I)
 {
+  VP_TRACING_SCOPE("vpMbEdgeTracker::track");
   initPyramid(I, Ipyramid);
 
+  if (m_scaleLastTimes.size() != scales.size()) {
+    resetScaleStatistics();
+  }
+  std::fill(m_scaleLastTimes.begin(), m_scaleLastTimes.end(), 0.);
+
+  unsigned int finestLevel = 0;
+  while (!scales[finestLevel])
+    finestLevel++;
+
+  // With the scale scheduling, the coarse levels are only used when the
+  // model moved significantly during the previous frame, or until the pose
+  // estimated on a coarse level does not move anymore
+  bool skipCoarseLevels = m_scaleScheduling && (m_lastMotion < m_scaleMotionThreshold);
+  bool skippedLevels = false;
+  const vpHomogeneousMatrix cMo_init = cMo;
+
   //  for (int lvl = ((int)scales.size()-1); lvl >= 0; lvl -= 1)
   unsigned int lvl = (unsigned int)scales.size();
   do {
@@ -1040,11 +1204,33 @@ void vpMbEdgeTracker::track(const vpImage<unsigned char> &I)
 
     projectionError = 90.0;
 
-    if (scales[lvl]) {
+    if (scales[lvl] && lvl != finestLevel && skipCoarseLevels) {
+      m_staleScales[lvl] = true;
+      m_scaleNbSkipped[lvl]++;
+      skippedLevels = true;
+    } else if (scales[lvl]) {
+      const unsigned int level = lvl;
+      double t = vpTime::measureTimeMs();
       vpHomogeneousMatrix cMo_1 = cMo;
       try {
         downScale(lvl);
 
+        if (m_staleScales[lvl]) {
+          // The moving edges of this level have not been updated since the
+          // level was skipped
+          for (std::list<vpMbtDistanceLine *>::const_iterator it = lines[lvl].begin(); it != lines[lvl].end(); ++it)
+            (*it)->Reinit = true;
+          for (std::list<vpMbtDistanceCylinder *>::const_iterator it = cylinders[lvl].begin();
+               it != cylinders[lvl].end(); ++it)
+            (*it)->Reinit = true;
+          for (std::list<vpMbtDistanceCircle *>::const_iterator it = circles[lvl].begin(); it != circles[lvl].end();
+               ++it)
+            (*it)->Reinit = true;
+          initMovingEdge(*Ipyramid[lvl], cMo);
+          reinitMovingEdge(*Ipyramid[lvl], cMo);
+          m_staleScales[lvl] = false;
+        }
+
         try {
           trackMovingEdge(*Ipyramid[lvl]);
         } catch (...) {
@@ -1109,19 +1295,47 @@ void vpMbEdgeTracker::track(const vpImage<unsigned char> &I)
           computeProjectionError(I);
 
         upScale(lvl);
+
+        if (m_scaleScheduling && lvl != finestLevel && computeImageMotion(cMo_1, cMo) < m_scaleMotionThreshold) {
+          skipCoarseLevels = true;
+        }
       } catch (const vpException &e) {
         if (lvl != 0) {
           cMo = cMo_1;
           reInitLevel(lvl);
           upScale(lvl);
+        } else if (skippedLevels) {
+          // The motion is larger than expected: track the frame again with
+          // all the levels
+          upScale(lvl);
+          cMo = cMo_init;
+          m_staleScales[lvl] = true;
+          skipCoarseLevels = false;
+          skippedLevels = false;
+          lvl = (unsigned int)scales.size();
         } else {
           upScale(lvl);
+          // Use all the levels for the next frame
+          m_lastMotion = DBL_MAX;
+          t = vpTime::measureTimeMs() - t;
+          m_scaleLastTimes[level] += t;
+          m_scaleTotalTimes[level] += t;
+          m_scaleNbTracked[level]++;
+          cleanPyramid(Ipyramid);
           throw(e);
         }
       }
+      t = vpTime::measureTimeMs() - t;
+      m_scaleLastTimes[level] += t;
+      m_scaleTotalTimes[level] += t;
+      m_scaleNbTracked[level]++;
     }
   } while (lvl != 0);
 
+  if (m_scaleScheduling) {
+    m_lastMotion = computeImageMotion(cMo_init, cMo);
+  }
+
   cleanPyramid(Ipyramid);
 }
 
@@ -1178,6 +1392,10 @@ void vpMbEdgeTracker::init(const vpImage<unsigned char> &I)
   } while (i != 0);
 
   cleanPyramid(Ipyramid);
+
+  // All the levels are used for the first frame
+  m_staleScales.assign(scales.size(), false);
+  m_lastMotion = DBL_MAX;
 }
 
 /*!
@@ -1492,11 +1710,19 @@ void vpMbEdgeTracker::initMovingEdge(const vpImage<unsigned char> &I, const vpHo
 /*!
   Track the moving edges in the image.
 
+  The moving edges of the visible and tracked primitives are first
+  initialized if needed. Since each primitive only modifies its own moving
+  edges, they are then tracked in parallel when more than one thread is
+  set with setNbThreads(). The primitives with the largest number of sites
+  are scheduled first to balance the work between the threads. The result
+  does not depend on the number of threads.
+
   \param I : the image.
 */
 void vpMbEdgeTracker::trackMovingEdge(const vpImage<unsigned char> &I)
 {
   const bool doNotTrack = false;
+  std::vector<vpMbtTrackingTask> tasks;
 
   for (std::list<vpMbtDistanceLine *>::const_iterator it = lines[scaleLevel].begin(); it != lines[scaleLevel].end();
        ++it) {
@@ -1505,7 +1731,10 @@ void vpMbEdgeTracker::trackMovingEdge(const vpImage<unsigned char> &I)
       if (l->meline.empty()) {
         l->initMovingEdge(I, cMo, doNotTrack, m_mask);
       }
-      l->trackMovingEdge(I);
+      vpMbtTrackingTask task = {l, NULL, NULL, 0, tasks.size()};
+      for (size_t i = 0; i < l->meline.size(); i++)
+        task.cost += l->meline[i]->getMeList().size();
+      tasks.push_back(task);
     }
   }
 
@@ -1516,7 +1745,12 @@ void vpMbEdgeTracker::trackMovingEdge(const vpImage<unsigned char> &I)
       if (cy->meline1 == NULL || cy->meline2 == NULL) {
         cy->initMovingEdge(I, cMo, doNotTrack, m_mask);
       }
-      cy->trackMovingEdge(I, cMo);
+      vpMbtTrackingTask task = {NULL, cy, NULL, 0, tasks.size()};
+      if (cy->meline1 != NULL)
+        task.cost += cy->meline1->getMeList().size();
+      if (cy->meline2 != NULL)
+        task.cost += cy->meline2->getMeList().size();
+      tasks.push_back(task);
     }
   }
 
@@ -1527,9 +1761,54 @@ void vpMbEdgeTracker::trackMovingEdge(const vpImage<unsigned char> &I)
       if (ci->meEllipse == NULL) {
         ci->initMovingEdge(I, cMo, doNotTrack, m_mask);
       }
-      ci->trackMovingEdge(I, cMo);
+      vpMbtTrackingTask task = {NULL, NULL, ci, 0, tasks.size()};
+      if (ci->meEllipse != NULL)
+        task.cost += ci->meEllipse->getMeList().size();
+      tasks.push_back(task);
+    }
+  }
+
+  int nbThreads = 1;
+#ifdef VISP_HAVE_OPENMP
+  nbThreads = (m_nbThreads == 0) ? omp_get_max_threads() : (int)m_nbThreads;
+#endif
+  if (nbThreads > 1) {
+    std::sort(tasks.begin(), tasks.end(), compareTrackingTaskCost);
+  }
+
+  // The primitives catch their own tracking errors. Anything else is
+  // reported after the parallel section, for the first primitive in the
+  // sequential order.
+  size_t errorIndex = tasks.size();
+  std::string errorMessage;
+  int nbTasks = (int)tasks.size();
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for schedule(dynamic, 1) num_threads(nbThreads) if (nbThreads > 1)
+#endif
+  for (int k = 0; k < nbTasks; k++) {
+    const vpMbtTrackingTask &task = tasks[(size_t)k];
+    try {
+      if (task.line != NULL)
+        task.line->trackMovingEdge(I);
+      else if (task.cylinder != NULL)
+        task.cylinder->trackMovingEdge(I, cMo);
+      else
+        task.circle->trackMovingEdge(I, cMo);
+    } catch (const std::exception &e) {
+#ifdef VISP_HAVE_OPENMP
+#pragma omp critical(vpMbEdgeTracker_trackMovingEdge)
+#endif
+      if (task.index < errorIndex) {
+        errorIndex = task.index;
+        errorMessage = e.what();
+      }
     }
   }
+
+  if (errorIndex < tasks.size()) {
+    throw vpTrackingException(vpTrackingException::fatalError, "Cannot track the moving edges: %s",
+                              errorMessage.c_str());
+  }
 }
 
 /*!
@@ -2483,6 +2762,9 @@ void vpMbEdgeTracker::setScales(const std::vector<bool> &scale)
       circles[i].clear();
     }
   }
+
+  m_staleScales.assign(scales.size(), false);
+  resetScaleStatistics();
 }
 
 /*!
@@ -2575,16 +2857,39 @@ void vpMbEdgeTracker::setClipping(const unsigned int &flags)
   pyramid come from OpenCV, otherwise a simple subsampling (no smoothing, no
   interpolation) is realized.
 
-  \warning The pyramid contains pointers to vpImage. To properly deallocate
-  the pyramid. All the element but the first (which is a pointer to the input
-  image) must be freed. A proper cleaning is implemented in the cleanPyramid()
-  method.
+  Each level is subsampled from the previous one. The images of the levels
+  are kept by the tracker and reused at the next call, so that no memory is
+  allocated as long as the size of the input image does not change.
+
+  \warning The pyramid contains pointers to vpImage that belong either to
+  the caller (the first level is a pointer to the input image) or to the
+  tracker. They are valid until the next call to this method and must not be
+  freed. The pointers are reset by the cleanPyramid() method.
 
   \param _I : The input image.
   \param _pyramid : The pyramid of image to build from the input image.
 */
 void vpMbEdgeTracker::initPyramid(const vpImage<unsigned char> &_I,
                                   std::vector<const vpImage<unsigned char> *> &_pyramid)
+{
+  initPyramid(_I, _pyramid, m_pyramidBuffers);
+}
+
+/*!
+  Compute the pyramid of image associated to the image in parameter, as
+  initPyramid(const vpImage<unsigned char> &, std::vector<const vpImage<unsigned char> *> &),
+  but with the images of the coarse levels stored in \e buffers. It allows
+  to keep one pyramid per image when several images are tracked.
+
+  \param _I : The input image.
+  \param _pyramid : The pyramid of image to build from the input image.
+  \param buffers : The images of the levels, reused from one call to the
+  next one. The pointers of \e _pyramid are valid as long as \e buffers is
+  not modified.
+*/
+void vpMbEdgeTracker::initPyramid(const vpImage<unsigned char> &_I,
+                                  std::vector<const vpImage<unsigned char> *> &_pyramid,
+                                  std::vector<vpImage<unsigned char> > &buffers)
 {
   _pyramid.resize(scales.size());
 
@@ -2594,28 +2899,38 @@ void vpMbEdgeTracker::initPyramid(const vpImage<unsigned char> &_I,
     _pyramid[0] = NULL;
   }
 
+  unsigned int lastLevel = 0;
+  for (unsigned int i = 1; i < scales.size(); i += 1) {
+    if (scales[i])
+      lastLevel = i;
+  }
+  if (buffers.size() < lastLevel + 1) {
+    buffers.resize(lastLevel + 1);
+  }
+
   for (unsigned int i = 1; i < _pyramid.size(); i += 1) {
-    if (scales[i]) {
-      unsigned int cScale = static_cast<unsigned int>(pow(2., (int)i));
-      vpImage<unsigned char> *I = new vpImage<unsigned char>(_I.getHeight() / cScale, _I.getWidth() / cScale);
+    if (i <= lastLevel) {
 #if (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION < 0x020408))
-      IplImage *vpI0 = cvCreateImageHeader(cvSize((int)_I.getWidth(), (int)_I.getHeight()), IPL_DEPTH_8U, 1);
-      vpI0->imageData = (char *)(_I.bitmap);
-      IplImage *vpI =
-          cvCreateImage(cvSize((int)(_I.getWidth() / cScale), (int)(_I.getHeight() / cScale)), IPL_DEPTH_8U, 1);
-      cvResize(vpI0, vpI, CV_INTER_NN);
-      vpImageConvert::convert(vpI, *I);
-      cvReleaseImage(&vpI);
-      vpI0->imageData = NULL;
-      cvReleaseImageHeader(&vpI0);
-#else
-      for (unsigned int k = 0, ii = 0; k < I->getHeight(); k += 1, ii += cScale) {
-        for (unsigned int l = 0, jj = 0; l < I->getWidth(); l += 1, jj += cScale) {
-          (*I)[k][l] = _I[ii][jj];
-        }
+      if (scales[i]) {
+        unsigned int cScale = static_cast<unsigned int>(pow(2., (int)i));
+        IplImage *vpI0 = cvCreateImageHeader(cvSize((int)_I.getWidth(), (int)_I.getHeight()), IPL_DEPTH_8U, 1);
+        vpI0->imageData = (char *)(_I.bitmap);
+        IplImage *vpI =
+            cvCreateImage(cvSize((int)(_I.getWidth() / cScale), (int)(_I.getHeight() / cScale)), IPL_DEPTH_8U, 1);
+        cvResize(vpI0, vpI, CV_INTER_NN);
+        vpImageConvert::convert(vpI, buffers[i]);
+        cvReleaseImage(&vpI);
+        vpI0->imageData = NULL;
+        cvReleaseImageHeader(&vpI0);
       }
+#else
+      // Subsampling the previous level gives the pixels _I[2^i k][2^i l]
+      subsample(i == 1 ? _I : buffers[i - 1], buffers[i]);
 #endif
-      _pyramid[i] = I;
+    }
+
+    if (scales[i]) {
+      _pyramid[i] = &buffers[i];
     } else {
       _pyramid[i] = NULL;
     }
@@ -2623,23 +2938,60 @@ void vpMbEdgeTracker::initPyramid(const vpImage<unsigned char> &_I,
 }
 
 /*!
-  Clean the pyramid of image allocated with the initPyramid() method. The
-  vector has a size equal to zero at the end of the method.
+  Clean the pyramid of image built with the initPyramid() method. The
+  vector has a size equal to zero at the end of the method. The images of the
+  levels are kept by the tracker to be reused.
 
   \param _pyramid : The pyramid of image to clean.
 */
-void vpMbEdgeTracker::cleanPyramid(std::vector<const vpImage<unsigned char> *> &_pyramid)
+void vpMbEdgeTracker::cleanPyramid(std::vector<const vpImage<unsigned char> *> &_pyramid) { _pyramid.resize(0); }
+
+/*!
+  Compute the largest displacement, in pixels of the full resolution image,
+  of the corners of the visible faces between two poses.
+
+  \param cMo_1 : First pose.
+  \param cMo_2 : Second pose.
+
+  \return The displacement, or DBL_MAX if there is no visible corner in front
+  of the camera.
+*/
+double vpMbEdgeTracker::computeImageMotion(const vpHomogeneousMatrix &cMo_1, const vpHomogeneousMatrix &cMo_2)
 {
-  if (_pyramid.size() > 0) {
-    _pyramid[0] = NULL;
-    for (unsigned int i = 1; i < _pyramid.size(); i += 1) {
-      if (_pyramid[i] != NULL) {
-        delete _pyramid[i];
-        _pyramid[i] = NULL;
+  double motion = 0;
+  bool found = false;
+  std::vector<vpMbtPolygon *> &polygons = faces.getPolygon();
+  for (size_t i = 0; i < polygons.size(); i++) {
+    if (!polygons[i]->isVisible())
+      continue;
+
+    for (unsigned int j = 0; j < polygons[i]->getNbPoint(); j++) {
+      const vpPoint &P = polygons[i]->getPoint(j);
+      double x[2], y[2];
+      bool inFront = true;
+      for (unsigned int k = 0; k < 2; k++) {
+        const vpHomogeneousMatrix &M = (k == 0) ? cMo_1 : cMo_2;
+        const double X = M[0][0] * P.get_oX() + M[0][1] * P.get_oY() + M[0][2] * P.get_oZ() + M[0][3];
+        const double Y = M[1][0] * P.get_oX() + M[1][1] * P.get_oY() + M[1][2] * P.get_oZ() + M[1][3];
+        const double Z = M[2][0] * P.get_oX() + M[2][1] * P.get_oY() + M[2][2] * P.get_oZ() + M[2][3];
+        if (Z <= 0) {
+          inFront = false;
+          break;
+        }
+        x[k] = X / Z;
+        y[k] = Y / Z;
       }
+      if (!inFront)
+        continue;
+
+      const double du = cam.get_px() * (x[1] - x[0]);
+      const double dv = cam.get_py() * (y[1] - y[0]);
+      motion = (std::max)(motion, sqrt(du * du + dv * dv));
+      found = true;
     }
-    _pyramid.resize(0);
   }
+
+  return found ? motion : DBL_MAX;
 }
 
 /*!
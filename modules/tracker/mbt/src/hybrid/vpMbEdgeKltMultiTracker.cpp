@@ -1337,6 +1337,22 @@ void vpMbEdgeKltMultiTracker::loadConfigFile(const std::map<std::string, std::st
   vpMbKltMultiTracker::loadConfigFile(mapOfConfigFiles);
 }
 
+/*!
+  Add a model compiled with vpMbTracker::compileModel() to the trackers of
+  all the cameras.
+
+  \param model : Compiled model.
+  \param T : optional transformation matrix to transform 3D points expressed
+  in the original object frame to the desired object frame.
+*/
+void vpMbEdgeKltMultiTracker::loadCompiledModel(const vpMbtCompiledModel &model, const vpHomogeneousMatrix &T)
+{
+  vpMbEdgeMultiTracker::loadCompiledModel(model, T);
+  vpMbKltMultiTracker::loadCompiledModel(model, T);
+
+  modelInitialised = true;
+}
+
 /*!
   Load a 3D model from the file in parameter. This file must either be a vrml
   file (.wrl) or a CAO file (.cao). CAO format is described in the
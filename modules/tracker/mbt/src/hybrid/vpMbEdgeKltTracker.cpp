@@ -40,6 +40,7 @@
 //#define VP_DEBUG_MODE 1 // Activate debug level 1
 
 #include <visp3/core/vpDebug.h>
+#include <visp3/core/vpTracing.h>
 #include <visp3/core/vpTrackingException.h>
 #include <visp3/core/vpVelocityTwistMatrix.h>
 #include <visp3/mbt/vpMbEdgeKltTracker.h>
@@ -794,6 +795,7 @@ void vpMbEdgeKltTracker::computeVVSInteractionMatrixAndResidu()
 */
 void vpMbEdgeKltTracker::track(const vpImage<unsigned char> &I)
 {
+  VP_TRACING_SCOPE("vpMbEdgeKltTracker::track");
   try {
     vpMbKltTracker::preTracking(I);
   } catch (...) {
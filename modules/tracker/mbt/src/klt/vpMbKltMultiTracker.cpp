@@ -1669,6 +1669,24 @@ void vpMbKltMultiTracker::loadConfigFile(const std::map<std::string, std::string
   }
 }
 
+/*!
+  Add a model compiled with vpMbTracker::compileModel() to the trackers of
+  all the cameras.
+
+  \param model : Compiled model.
+  \param T : optional transformation matrix to transform 3D points expressed
+  in the original object frame to the desired object frame.
+*/
+void vpMbKltMultiTracker::loadCompiledModel(const vpMbtCompiledModel &model, const vpHomogeneousMatrix &T)
+{
+  for (std::map<std::string, vpMbKltTracker *>::const_iterator it = m_mapOfKltTrackers.begin();
+       it != m_mapOfKltTrackers.end(); ++it) {
+    it->second->loadCompiledModel(model, T);
+  }
+
+  modelInitialised = true;
+}
+
 /*!
   Load a 3D model from the file in parameter. This file must either be a vrml
   file (.wrl) or a CAO file (.cao). CAO format is described in the
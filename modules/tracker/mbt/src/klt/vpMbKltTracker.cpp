@@ -38,6 +38,7 @@
  *****************************************************************************/
 
 #include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpTracing.h>
 #include <visp3/core/vpTrackingException.h>
 #include <visp3/core/vpVelocityTwistMatrix.h>
 #include <visp3/mbt/vpMbKltTracker.h>
@@ -881,6 +882,7 @@ void vpMbKltTracker::computeVVSInteractionMatrixAndResidu()
 */
 void vpMbKltTracker::track(const vpImage<unsigned char> &I)
 {
+  VP_TRACING_SCOPE("vpMbKltTracker::track");
   preTracking(I);
 
   if (m_nbInfos < 4 || m_nbFaceUsed == 0) {
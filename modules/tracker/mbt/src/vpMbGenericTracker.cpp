@@ -37,12 +37,55 @@
 
 #include <visp3/core/vpDisplay.h>
 #include <visp3/core/vpExponentialMap.h>
+#include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpTime.h>
+#include <visp3/core/vpTracing.h>
 #include <visp3/core/vpTrackingException.h>
 #include <visp3/mbt/vpMbtXmlGenericParser.h>
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+// Add the time spent in the scope to a duration in ms, nothing is measured
+// when the duration is NULL
+class vpStageTimer
+{
+public:
+  explicit vpStageTimer(double *duration)
+    : m_duration(duration), m_start(duration != NULL ? vpTime::measureMonotonicTimeMs() : 0)
+  {
+  }
+  ~vpStageTimer()
+  {
+    if (m_duration != NULL) {
+      *m_duration += vpTime::measureMonotonicTimeMs() - m_start;
+    }
+  }
+
+private:
+  vpStageTimer(const vpStageTimer &);
+  vpStageTimer &operator=(const vpStageTimer &);
+
+  double *m_duration;
+  double m_start;
+};
+
+unsigned int countWeightsBelow(const vpColVector &w, const double threshold)
+{
+  unsigned int nb = 0;
+  for (unsigned int i = 0; i < w.getRows(); i++) {
+    if (w[i] < threshold)
+      nb++;
+  }
+  return nb;
+}
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 vpMbGenericTracker::vpMbGenericTracker()
   : m_error(), m_L(), m_mapOfCameraTransformationMatrix(), m_mapOfFeatureFactors(), m_mapOfTrackers(),
-    m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError()
+    m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError(),
+    m_computeTrackingStatistics(false), m_trackingStatistics()
 {
   m_mapOfTrackers["Camera"] = new TrackerWrapper(EDGE_TRACKER);
 
@@ -62,7 +105,8 @@ vpMbGenericTracker::vpMbGenericTracker()
 
 vpMbGenericTracker::vpMbGenericTracker(const unsigned int nbCameras, const int trackerType)
   : m_error(), m_L(), m_mapOfCameraTransformationMatrix(), m_mapOfFeatureFactors(), m_mapOfTrackers(),
-    m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError()
+    m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError(),
+    m_computeTrackingStatistics(false), m_trackingStatistics()
 {
   if (nbCameras == 0) {
     throw vpException(vpTrackingException::fatalError, "Cannot use no camera!");
@@ -98,7 +142,8 @@ vpMbGenericTracker::vpMbGenericTracker(const unsigned int nbCameras, const int t
 
 vpMbGenericTracker::vpMbGenericTracker(const std::vector<int> &trackerTypes)
   : m_error(), m_L(), m_mapOfCameraTransformationMatrix(), m_mapOfFeatureFactors(), m_mapOfTrackers(),
-    m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError()
+    m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError(),
+    m_computeTrackingStatistics(false), m_trackingStatistics()
 {
   if (trackerTypes.empty()) {
     throw vpException(vpException::badValue, "There is no camera!");
@@ -137,7 +182,8 @@ vpMbGenericTracker::vpMbGenericTracker(const std::vector<int> &trackerTypes)
 vpMbGenericTracker::vpMbGenericTracker(const std::vector<std::string> &cameraNames,
                                        const std::vector<int> &trackerTypes)
   : m_error(), m_L(), m_mapOfCameraTransformationMatrix(), m_mapOfFeatureFactors(), m_mapOfTrackers(),
-    m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError()
+    m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError(),
+    m_computeTrackingStatistics(false), m_trackingStatistics()
 {
   if (cameraNames.size() != trackerTypes.size() || cameraNames.empty()) {
     throw vpException(vpTrackingException::badValue,
@@ -248,6 +294,9 @@ void vpMbGenericTracker::computeProjectionError()
 
 void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages)
 {
+  VP_TRACING_SCOPE("vpMbGenericTracker::computeVVS");
+  const double t_vvs = m_computeTrackingStatistics ? vpTime::measureMonotonicTimeMs() : 0;
+
   computeVVSInit(mapOfImages);
 
   if (m_error.getRows() < 4) {
@@ -458,12 +507,42 @@ void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned
     iter++;
   }
 
-  computeCovarianceMatrixVVS(isoJoIdentity_, W_true, cMo_prev, L_true, LVJ_true, m_error);
+  if (m_computeTrackingStatistics) {
+    m_trackingStatistics.vvsTime += vpTime::measureMonotonicTimeMs() - t_vvs;
+    m_trackingStatistics.nbIterations = iter;
+  }
+
+  {
+    vpStageTimer timer(m_computeTrackingStatistics ? &m_trackingStatistics.covarianceTime : NULL);
+    computeCovarianceMatrixVVS(isoJoIdentity_, W_true, cMo_prev, L_true, LVJ_true, m_error);
+  }
 
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
        it != m_mapOfTrackers.end(); ++it) {
     TrackerWrapper *tracker = it->second;
 
+    if (tracker->m_statistics != NULL) {
+      vpMbtTrackingStatistics::vpCameraStatistics &stats = *tracker->m_statistics;
+      if (tracker->m_trackerType & EDGE_TRACKER) {
+        stats.nbEdgeFeatures = tracker->m_error_edge.getRows();
+        stats.nbEdgeRejected = countWeightsBelow(tracker->m_w_edge, 0.5);
+      }
+#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+      if (tracker->m_trackerType & KLT_TRACKER) {
+        stats.nbKltFeatures = tracker->m_error_klt.getRows();
+        stats.nbKltRejected = countWeightsBelow(tracker->m_w_klt, 0.5);
+      }
+#endif
+      if (tracker->m_trackerType & DEPTH_NORMAL_TRACKER) {
+        stats.nbDepthNormalFeatures = tracker->m_error_depthNormal.getRows();
+        stats.nbDepthNormalRejected = countWeightsBelow(tracker->m_w_depthNormal, 0.5);
+      }
+      if (tracker->m_trackerType & DEPTH_DENSE_TRACKER) {
+        stats.nbDepthDenseFeatures = tracker->m_error_depthDense.getRows();
+        stats.nbDepthDenseRejected = countWeightsBelow(tracker->m_w_depthDense, 0.5);
+      }
+    }
+
     if (tracker->m_trackerType & EDGE_TRACKER) {
       tracker->updateMovingEdgeWeights();
     }
@@ -2129,11 +2208,43 @@ CAO model files which include other CAO model files.
 cameras configuration.
 */
 void vpMbGenericTracker::loadModel(const std::string &modelFile, const bool verbose, const vpHomogeneousMatrix &T)
+{
+  std::string extension = vpIoTools::getFileExtension(modelFile);
+  std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+  if (extension == ".cao") {
+    // Parse the CAO model only once for all the cameras
+    vpMbtCompiledModel model;
+    compileModel(modelFile, model, verbose);
+
+    for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+         it != m_mapOfTrackers.end(); ++it) {
+      TrackerWrapper *tracker = it->second;
+      tracker->loadCompiledModel(model, T);
+      tracker->modelFileName = modelFile;
+    }
+  } else {
+    for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+         it != m_mapOfTrackers.end(); ++it) {
+      TrackerWrapper *tracker = it->second;
+      tracker->loadModel(modelFile, verbose, T);
+    }
+  }
+}
+
+/*!
+  Add a model compiled with vpMbTracker::compileModel() to the trackers of
+  all the cameras.
+
+  \param model : Compiled model.
+  \param T : optional transformation matrix to transform 3D points expressed
+  in the original object frame to the desired object frame.
+*/
+void vpMbGenericTracker::loadCompiledModel(const vpMbtCompiledModel &model, const vpHomogeneousMatrix &T)
 {
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
        it != m_mapOfTrackers.end(); ++it) {
     TrackerWrapper *tracker = it->second;
-    tracker->loadModel(modelFile, verbose, T);
+    tracker->loadCompiledModel(model, T);
   }
 }
 
@@ -2244,6 +2355,7 @@ void vpMbGenericTracker::loadModel(const std::map<std::string, std::string> &map
 void vpMbGenericTracker::preTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
                                      std::map<std::string, pcl::PointCloud<pcl::PointXYZ>::ConstPtr> &mapOfPointClouds)
 {
+  VP_TRACING_SCOPE("vpMbGenericTracker::preTracking");
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
        it != m_mapOfTrackers.end(); ++it) {
     TrackerWrapper *tracker = it->second;
@@ -2257,6 +2369,7 @@ void vpMbGenericTracker::preTracking(std::map<std::string, const vpImage<unsigne
                                      std::map<std::string, unsigned int> &mapOfPointCloudWidths,
                                      std::map<std::string, unsigned int> &mapOfPointCloudHeights)
 {
+  VP_TRACING_SCOPE("vpMbGenericTracker::preTracking");
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
        it != m_mapOfTrackers.end(); ++it) {
     TrackerWrapper *tracker = it->second;
@@ -3394,6 +3507,24 @@ void vpMbGenericTracker::setMinPolygonAreaThresh(const double minPolygonAreaThre
   }
 }
 
+/*!
+  Set the directory where the CAO models are cached once compiled, for all
+  the cameras. See vpMbTracker::setModelCacheDirectory().
+
+  \param directory : Existing directory, or an empty string to disable the
+  cache.
+*/
+void vpMbGenericTracker::setModelCacheDirectory(const std::string &directory)
+{
+  vpMbTracker::setModelCacheDirectory(directory);
+
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+       it != m_mapOfTrackers.end(); ++it) {
+    TrackerWrapper *tracker = it->second;
+    tracker->setModelCacheDirectory(directory);
+  }
+}
+
 /*!
   Set the moving edge parameters.
 
@@ -3451,6 +3582,23 @@ void vpMbGenericTracker::setMovingEdge(const std::map<std::string, vpMe> &mapOfM
   }
 }
 
+/*!
+  Set the number of threads used to track the moving edges of each camera.
+  See vpMbEdgeTracker::setNbThreads() for more details.
+
+  \param nbThreads : Number of threads, 0 to use all the available threads.
+
+  \note This function will set the new parameter for all the cameras.
+*/
+void vpMbGenericTracker::setNbThreads(const unsigned int nbThreads)
+{
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+       it != m_mapOfTrackers.end(); ++it) {
+    TrackerWrapper *tracker = it->second;
+    tracker->setNbThreads(nbThreads);
+  }
+}
+
 /*!
   Set the near distance for clipping.
 
@@ -3856,6 +4004,44 @@ void vpMbGenericTracker::setTrackerType(const std::map<std::string, int> &mapOfT
   }
 }
 
+/*!
+  Enable or disable the computation of the timings and counters of track().
+  When enabled, the time spent in each stage of the tracking, the number of
+  iterations of the virtual visual servoing and the number of features of
+  each type are available with getTrackingStatistics() after each call to
+  track(). When disabled, the default, the tracking is not slowed down.
+
+  \param flag : True to compute the statistics. Enabling the computation
+  resets the frame index of the statistics.
+
+  \sa vpMbtTrackingStatistics
+*/
+void vpMbGenericTracker::setTrackingStatisticsComputation(const bool flag)
+{
+  if (flag && !m_computeTrackingStatistics) {
+    m_trackingStatistics = vpMbtTrackingStatistics();
+  }
+  m_computeTrackingStatistics = flag;
+}
+
+/*!
+  Reset the statistics at the beginning of track() and give to the tracker
+  of each camera the statistics to fill, or NULL when they are not
+  computed.
+*/
+void vpMbGenericTracker::startTrackingStatistics()
+{
+  if (m_computeTrackingStatistics) {
+    m_trackingStatistics.reset();
+    m_trackingStatistics.frame++;
+  }
+
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+       it != m_mapOfTrackers.end(); ++it) {
+    it->second->m_statistics = m_computeTrackingStatistics ? &m_trackingStatistics.cameras[it->first] : NULL;
+  }
+}
+
 /*!
   Set if the polygon that has the given name has to be considered during
   the tracking phase.
@@ -4031,6 +4217,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char
 void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
                                std::map<std::string, pcl::PointCloud<pcl::PointXYZ>::ConstPtr> &mapOfPointClouds)
 {
+  VP_TRACING_SCOPE("vpMbGenericTracker::track");
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
        it != m_mapOfTrackers.end(); ++it) {
     TrackerWrapper *tracker = it->second;
@@ -4058,6 +4245,9 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char
     }
   }
 
+  startTrackingStatistics();
+  const double t_track = m_computeTrackingStatistics ? vpTime::measureMonotonicTimeMs() : 0;
+
   preTracking(mapOfImages, mapOfPointClouds);
 
   try {
@@ -4076,7 +4266,14 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char
     tracker->postTracking(mapOfImages[it->first], mapOfPointClouds[it->first]);
   }
 
-  computeProjectionError();
+  {
+    vpStageTimer timer(m_computeTrackingStatistics ? &m_trackingStatistics.projectionErrorTime : NULL);
+    computeProjectionError();
+  }
+
+  if (m_computeTrackingStatistics) {
+    m_trackingStatistics.totalTime = vpTime::measureMonotonicTimeMs() - t_track;
+  }
 }
 #endif
 
@@ -4095,6 +4292,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char
                                std::map<std::string, unsigned int> &mapOfPointCloudWidths,
                                std::map<std::string, unsigned int> &mapOfPointCloudHeights)
 {
+  VP_TRACING_SCOPE("vpMbGenericTracker::track");
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
        it != m_mapOfTrackers.end(); ++it) {
     TrackerWrapper *tracker = it->second;
@@ -4122,6 +4320,9 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char
     }
   }
 
+  startTrackingStatistics();
+  const double t_track = m_computeTrackingStatistics ? vpTime::measureMonotonicTimeMs() : 0;
+
   preTracking(mapOfImages, mapOfPointClouds, mapOfPointCloudWidths, mapOfPointCloudHeights);
 
   try {
@@ -4140,12 +4341,19 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char
     tracker->postTracking(mapOfImages[it->first], mapOfPointCloudWidths[it->first], mapOfPointCloudHeights[it->first]);
   }
 
-  computeProjectionError();
+  {
+    vpStageTimer timer(m_computeTrackingStatistics ? &m_trackingStatistics.projectionErrorTime : NULL);
+    computeProjectionError();
+  }
+
+  if (m_computeTrackingStatistics) {
+    m_trackingStatistics.totalTime = vpTime::measureMonotonicTimeMs() - t_track;
+  }
 }
 
 /** TrackerWrapper **/
 vpMbGenericTracker::TrackerWrapper::TrackerWrapper()
-  : m_error(), m_L(), m_trackerType(EDGE_TRACKER), m_w(), m_weightedError()
+  : m_error(), m_L(), m_trackerType(EDGE_TRACKER), m_w(), m_weightedError(), m_statistics(NULL)
 {
   m_lambda = 1.0;
   m_maxIter = 30;
@@ -4158,7 +4366,7 @@ vpMbGenericTracker::TrackerWrapper::TrackerWrapper()
 }
 
 vpMbGenericTracker::TrackerWrapper::TrackerWrapper(const int trackerType)
-  : m_error(), m_L(), m_trackerType(trackerType), m_w(), m_weightedError()
+  : m_error(), m_L(), m_trackerType(trackerType), m_w(), m_weightedError(), m_statistics(NULL)
 {
   if ((m_trackerType & (EDGE_TRACKER |
 #if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
@@ -4939,10 +5147,69 @@ void vpMbGenericTracker::TrackerWrapper::loadConfigFile(const std::string &confi
 #endif
 }
 
+void vpMbGenericTracker::TrackerWrapper::computeMovingEdgeStatistics()
+{
+  std::vector<const std::list<vpMeSite> *> meLists;
+  for (std::list<vpMbtDistanceLine *>::const_iterator it = lines[scaleLevel].begin(); it != lines[scaleLevel].end();
+       ++it) {
+    vpMbtDistanceLine *l = *it;
+    if (l->isVisible() && l->isTracked()) {
+      for (size_t a = 0; a < l->meline.size(); a++) {
+        if (l->meline[a] != NULL)
+          meLists.push_back(&l->meline[a]->getMeList());
+      }
+    }
+  }
+
+  for (std::list<vpMbtDistanceCylinder *>::const_iterator it = cylinders[scaleLevel].begin();
+       it != cylinders[scaleLevel].end(); ++it) {
+    vpMbtDistanceCylinder *cy = *it;
+    if (cy->isVisible() && cy->isTracked()) {
+      if (cy->meline1 != NULL)
+        meLists.push_back(&cy->meline1->getMeList());
+      if (cy->meline2 != NULL)
+        meLists.push_back(&cy->meline2->getMeList());
+    }
+  }
+
+  for (std::list<vpMbtDistanceCircle *>::const_iterator it = circles[scaleLevel].begin();
+       it != circles[scaleLevel].end(); ++it) {
+    vpMbtDistanceCircle *ci = *it;
+    if (ci->isVisible() && ci->isTracked() && ci->meEllipse != NULL) {
+      meLists.push_back(&ci->meEllipse->getMeList());
+    }
+  }
+
+  for (size_t i = 0; i < meLists.size(); i++) {
+    for (std::list<vpMeSite>::const_iterator it = meLists[i]->begin(); it != meLists[i]->end(); ++it) {
+      switch (it->getState()) {
+      case vpMeSite::NO_SUPPRESSION:
+        m_statistics->nbMeTracked++;
+        break;
+      case vpMeSite::CONSTRAST:
+        m_statistics->nbMeContrast++;
+        break;
+      case vpMeSite::THRESHOLD:
+        m_statistics->nbMeThreshold++;
+        break;
+      case vpMeSite::M_ESTIMATOR:
+        m_statistics->nbMeMEstimator++;
+        break;
+      case vpMeSite::TOO_NEAR:
+        m_statistics->nbMeTooNear++;
+        break;
+      default:
+        break;
+      }
+    }
+  }
+}
+
 #ifdef VISP_HAVE_PCL
 void vpMbGenericTracker::TrackerWrapper::postTracking(const vpImage<unsigned char> *const ptr_I,
                                                       const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud)
 {
+  VP_TRACING_SCOPE("vpMbGenericTracker::postTracking");
   if (displayFeatures) {
     if (m_trackerType & EDGE_TRACKER) {
       vpMbEdgeTracker::displayFeaturesOnImage(*ptr_I, 0);
@@ -4952,33 +5219,43 @@ void vpMbGenericTracker::TrackerWrapper::postTracking(const vpImage<unsigned cha
 #if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   // KLT
   if (m_trackerType & KLT_TRACKER) {
+    vpStageTimer timer(m_statistics != NULL ? &m_statistics->kltReinitTime : NULL);
     if (vpMbKltTracker::postTracking(*ptr_I, m_w_klt)) {
       vpMbKltTracker::reinit(*ptr_I);
     }
   }
 #endif
 
-  // Looking for new visible face
-  if (m_trackerType & EDGE_TRACKER) {
-    bool newvisibleface = false;
-    vpMbEdgeTracker::visibleFace(*ptr_I, cMo, newvisibleface);
+  {
+    vpStageTimer timer(m_statistics != NULL ? &m_statistics->visibilityTime : NULL);
+
+    // Looking for new visible face
+    if (m_trackerType & EDGE_TRACKER) {
+      bool newvisibleface = false;
+      vpMbEdgeTracker::visibleFace(*ptr_I, cMo, newvisibleface);
 
-    if (useScanLine) {
-      faces.computeClippedPolygons(cMo, cam);
-      faces.computeScanLineRender(cam, ptr_I->getWidth(), ptr_I->getHeight());
+      if (useScanLine) {
+        faces.computeClippedPolygons(cMo, cam);
+        faces.computeScanLineRender(cam, ptr_I->getWidth(), ptr_I->getHeight());
+      }
     }
-  }
 
-  // Depth normal
-  if (m_trackerType & DEPTH_NORMAL_TRACKER)
-    vpMbDepthNormalTracker::computeVisibility(point_cloud->width, point_cloud->height);
+    // Depth normal
+    if (m_trackerType & DEPTH_NORMAL_TRACKER)
+      vpMbDepthNormalTracker::computeVisibility(point_cloud->width, point_cloud->height);
 
-  // Depth dense
-  if (m_trackerType & DEPTH_DENSE_TRACKER)
-    vpMbDepthDenseTracker::computeVisibility(point_cloud->width, point_cloud->height);
+    // Depth dense
+    if (m_trackerType & DEPTH_DENSE_TRACKER)
+      vpMbDepthDenseTracker::computeVisibility(point_cloud->width, point_cloud->height);
+  }
 
   // Edge
   if (m_trackerType & EDGE_TRACKER) {
+    if (m_statistics != NULL) {
+      computeMovingEdgeStatistics();
+    }
+
+    vpStageTimer timer(m_statistics != NULL ? &m_statistics->meReinitTime : NULL);
     vpMbEdgeTracker::updateMovingEdge(*ptr_I);
 
     vpMbEdgeTracker::initMovingEdge(*ptr_I, cMo);
@@ -4995,6 +5272,7 @@ void vpMbGenericTracker::TrackerWrapper::preTracking(const vpImage<unsigned char
                                                      const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud)
 {
   if (m_trackerType & EDGE_TRACKER) {
+    vpStageTimer timer(m_statistics != NULL ? &m_statistics->meTrackingTime : NULL);
     try {
       vpMbEdgeTracker::trackMovingEdge(*ptr_I);
     } catch (...) {
@@ -5005,6 +5283,7 @@ void vpMbGenericTracker::TrackerWrapper::preTracking(const vpImage<unsigned char
 
 #if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   if (m_trackerType & KLT_TRACKER) {
+    vpStageTimer timer(m_statistics != NULL ? &m_statistics->kltTrackingTime : NULL);
     try {
       vpMbKltTracker::preTracking(*ptr_I);
     } catch (const vpException &e) {
@@ -5015,6 +5294,7 @@ void vpMbGenericTracker::TrackerWrapper::preTracking(const vpImage<unsigned char
 #endif
 
   if (m_trackerType & DEPTH_NORMAL_TRACKER) {
+    vpStageTimer timer(m_statistics != NULL ? &m_statistics->depthNormalTime : NULL);
     try {
       vpMbDepthNormalTracker::segmentPointCloud(point_cloud);
     } catch (...) {
@@ -5024,6 +5304,7 @@ void vpMbGenericTracker::TrackerWrapper::preTracking(const vpImage<unsigned char
   }
 
   if (m_trackerType & DEPTH_DENSE_TRACKER) {
+    vpStageTimer timer(m_statistics != NULL ? &m_statistics->depthDenseTime : NULL);
     try {
       vpMbDepthDenseTracker::segmentPointCloud(point_cloud);
     } catch (...) {
@@ -5038,6 +5319,7 @@ void vpMbGenericTracker::TrackerWrapper::postTracking(const vpImage<unsigned cha
                                                       const unsigned int pointcloud_width,
                                                       const unsigned int pointcloud_height)
 {
+  VP_TRACING_SCOPE("vpMbGenericTracker::postTracking");
   if (displayFeatures) {
     if (m_trackerType & EDGE_TRACKER) {
       vpMbEdgeTracker::displayFeaturesOnImage(*ptr_I, 0);
@@ -5047,33 +5329,43 @@ void vpMbGenericTracker::TrackerWrapper::postTracking(const vpImage<unsigned cha
 #if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   // KLT
   if (m_trackerType & KLT_TRACKER) {
+    vpStageTimer timer(m_statistics != NULL ? &m_statistics->kltReinitTime : NULL);
     if (vpMbKltTracker::postTracking(*ptr_I, m_w_klt)) {
       vpMbKltTracker::reinit(*ptr_I);
     }
   }
 #endif
 
-  // Looking for new visible face
-  if (m_trackerType & EDGE_TRACKER) {
-    bool newvisibleface = false;
-    vpMbEdgeTracker::visibleFace(*ptr_I, cMo, newvisibleface);
+  {
+    vpStageTimer timer(m_statistics != NULL ? &m_statistics->visibilityTime : NULL);
 
-    if (useScanLine) {
-      faces.computeClippedPolygons(cMo, cam);
-      faces.computeScanLineRender(cam, ptr_I->getWidth(), ptr_I->getHeight());
+    // Looking for new visible face
+    if (m_trackerType & EDGE_TRACKER) {
+      bool newvisibleface = false;
+      vpMbEdgeTracker::visibleFace(*ptr_I, cMo, newvisibleface);
+
+      if (useScanLine) {
+        faces.computeClippedPolygons(cMo, cam);
+        faces.computeScanLineRender(cam, ptr_I->getWidth(), ptr_I->getHeight());
+      }
     }
-  }
 
-  // Depth normal
-  if (m_trackerType & DEPTH_NORMAL_TRACKER)
-    vpMbDepthNormalTracker::computeVisibility(pointcloud_width, pointcloud_height);
+    // Depth normal
+    if (m_trackerType & DEPTH_NORMAL_TRACKER)
+      vpMbDepthNormalTracker::computeVisibility(pointcloud_width, pointcloud_height);
 
-  // Depth dense
-  if (m_trackerType & DEPTH_DENSE_TRACKER)
-    vpMbDepthDenseTracker::computeVisibility(pointcloud_width, pointcloud_height);
+    // Depth dense
+    if (m_trackerType & DEPTH_DENSE_TRACKER)
+      vpMbDepthDenseTracker::computeVisibility(pointcloud_width, pointcloud_height);
+  }
 
   // Edge
   if (m_trackerType & EDGE_TRACKER) {
+    if (m_statistics != NULL) {
+      computeMovingEdgeStatistics();
+    }
+
+    vpStageTimer timer(m_statistics != NULL ? &m_statistics->meReinitTime : NULL);
     vpMbEdgeTracker::updateMovingEdge(*ptr_I);
 
     vpMbEdgeTracker::initMovingEdge(*ptr_I, cMo);
@@ -5092,6 +5384,7 @@ void vpMbGenericTracker::TrackerWrapper::preTracking(const vpImage<unsigned char
                                                      const unsigned int pointcloud_height)
 {
   if (m_trackerType & EDGE_TRACKER) {
+    vpStageTimer timer(m_statistics != NULL ? &m_statistics->meTrackingTime : NULL);
     try {
       vpMbEdgeTracker::trackMovingEdge(*ptr_I);
     } catch (...) {
@@ -5102,6 +5395,7 @@ void vpMbGenericTracker::TrackerWrapper::preTracking(const vpImage<unsigned char
 
 #if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
   if (m_trackerType & KLT_TRACKER) {
+    vpStageTimer timer(m_statistics != NULL ? &m_statistics->kltTrackingTime : NULL);
     try {
       vpMbKltTracker::preTracking(*ptr_I);
     } catch (const vpException &e) {
@@ -5112,6 +5406,7 @@ void vpMbGenericTracker::TrackerWrapper::preTracking(const vpImage<unsigned char
 #endif
 
   if (m_trackerType & DEPTH_NORMAL_TRACKER) {
+    vpStageTimer timer(m_statistics != NULL ? &m_statistics->depthNormalTime : NULL);
     try {
       vpMbDepthNormalTracker::segmentPointCloud(*point_cloud, pointcloud_width, pointcloud_height);
     } catch (...) {
@@ -5121,6 +5416,7 @@ void vpMbGenericTracker::TrackerWrapper::preTracking(const vpImage<unsigned char
   }
 
   if (m_trackerType & DEPTH_DENSE_TRACKER) {
+    vpStageTimer timer(m_statistics != NULL ? &m_statistics->depthDenseTime : NULL);
     try {
       vpMbDepthDenseTracker::segmentPointCloud(*point_cloud, pointcloud_width, pointcloud_height);
     } catch (...) {
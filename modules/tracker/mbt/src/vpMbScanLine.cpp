@@ -59,7 +59,9 @@
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 
 vpMbScanLine::vpMbScanLine()
-  : w(0), h(0), K(), maskBorder(0), mask(), primitive_ids(), visibility_samples(), depthTreshold(1e-06)
+  : w(0), h(0), K(), maskBorder(0), mask(), primitive_ids(), primitive_depths(), computeDepths(false), edge_ids(),
+    visibility_samples(), depthTreshold(1e-06), scanlinesY(), scanlinesX(), localScanlines(), localFirst(0),
+    localLast(0), samplesY(), samplesX(), maskY(), maskX()
 #if defined(DEBUG_DISP)
     ,
     dispMaskDebug(NULL), dispLineDebug(NULL), linedebugImg()
@@ -89,11 +91,11 @@ vpMbScanLine::~vpMbScanLine()
 
   \param a : First point of the line.
   \param b : Second point of the line.
-  \param edge : Pair with the two points of the line.
+  \param edge : Index of the line in the edge list, see getEdgeIndex().
   \param ID : Id of the given line (has to be know when using queries).
   \param scanlines : Resulting intersections.
 */
-void vpMbScanLine::drawLineY(const vpColVector &a, const vpColVector &b, const vpMbScanLineEdge &edge, const int ID,
+void vpMbScanLine::drawLineY(const vpColVector &a, const vpColVector &b, const int edge, const int ID,
                              std::vector<std::vector<vpMbScanLineSegment> > &scanlines)
 {
   double x0 = a[0] / a[2];
@@ -129,6 +131,8 @@ void vpMbScanLine::drawLineY(const vpColVector &a, const vpColVector &b, const v
     s.edge = edge;
     s.b_sample_Y = b_sample_Y;
     scanlines[y].push_back(s);
+    localFirst = (std::min)(localFirst, y);
+    localLast = (std::max)(localLast, y + 1);
   }
 }
 
@@ -138,11 +142,11 @@ void vpMbScanLine::drawLineY(const vpColVector &a, const vpColVector &b, const v
 
   \param a : First point of the line.
   \param b : Second point of the line.
-  \param edge : Pair with the two points of the line.
+  \param edge : Index of the line in the edge list, see getEdgeIndex().
   \param ID : Id of the given line (has to be know when using queries).
   \param scanlines : Resulting intersections.
 */
-void vpMbScanLine::drawLineX(const vpColVector &a, const vpColVector &b, const vpMbScanLineEdge &edge, const int ID,
+void vpMbScanLine::drawLineX(const vpColVector &a, const vpColVector &b, const int edge, const int ID,
                              std::vector<std::vector<vpMbScanLineSegment> > &scanlines)
 {
   double x0 = a[0] / a[2];
@@ -178,9 +182,27 @@ void vpMbScanLine::drawLineX(const vpColVector &a, const vpColVector &b, const v
     s.edge = edge;
     s.b_sample_Y = b_sample_Y;
     scanlines[x].push_back(s);
+    localFirst = (std::min)(localFirst, x);
+    localLast = (std::max)(localLast, x + 1);
   }
 }
 
+/*!
+  Get the index of an edge in the edge list of the current scene, adding it
+  if it is not yet known. The index is used to store the visibility samples
+  of the edge.
+
+  \param a : First point of the line.
+  \param b : Second point of the line.
+
+  \return Index of the edge.
+*/
+int vpMbScanLine::getEdgeIndex(const vpPoint &a, const vpPoint &b)
+{
+  const int index = (int)edge_ids.size();
+  return edge_ids.insert(std::make_pair(makeMbScanLineEdge(a, b), index)).first->second;
+}
+
 /*!
   Compute the Y-axis scanlines intersections of a polygon.
 
@@ -199,23 +221,22 @@ void vpMbScanLine::drawPolygonY(const std::vector<std::pair<vpPoint, unsigned in
     createVectorFromPoint(polygon.front().first, p1, K);
     createVectorFromPoint(polygon.back().first, p2, K);
 
-    drawLineY(p1, p2, makeMbScanLineEdge(polygon.front().first, polygon.back().first), ID, scanlines);
+    drawLineY(p1, p2, getEdgeIndex(polygon.front().first, polygon.back().first), ID, scanlines);
     return;
   }
 
-  std::vector<std::vector<vpMbScanLineSegment> > local_scanlines;
-  local_scanlines.resize(h);
+  std::vector<vpColVector> points(polygon.size());
+  for (size_t i = 0; i < polygon.size(); ++i)
+    createVectorFromPoint(polygon[i].first, points[i], K);
 
+  localFirst = h;
+  localLast = 0;
   for (size_t i = 0; i < polygon.size(); ++i) {
-    vpColVector p1, p2;
-    createVectorFromPoint(polygon[i].first, p1, K);
-    createVectorFromPoint(polygon[(i + 1) % polygon.size()].first, p2, K);
-
-    drawLineY(p1, p2, makeMbScanLineEdge(polygon[i].first, polygon[(i + 1) % polygon.size()].first), ID,
-              local_scanlines);
+    const size_t j = (i + 1) % polygon.size();
+    drawLineY(points[i], points[j], getEdgeIndex(polygon[i].first, polygon[j].first), ID, localScanlines);
   }
 
-  createScanLinesFromLocals(scanlines, local_scanlines, h);
+  createScanLinesFromLocals(scanlines);
 }
 
 /*!
@@ -236,39 +257,36 @@ void vpMbScanLine::drawPolygonX(const std::vector<std::pair<vpPoint, unsigned in
     createVectorFromPoint(polygon.front().first, p1, K);
     createVectorFromPoint(polygon.back().first, p2, K);
 
-    drawLineX(p1, p2, makeMbScanLineEdge(polygon.front().first, polygon.back().first), ID, scanlines);
+    drawLineX(p1, p2, getEdgeIndex(polygon.front().first, polygon.back().first), ID, scanlines);
     return;
   }
 
-  std::vector<std::vector<vpMbScanLineSegment> > local_scanlines;
-  local_scanlines.resize(w);
+  std::vector<vpColVector> points(polygon.size());
+  for (size_t i = 0; i < polygon.size(); ++i)
+    createVectorFromPoint(polygon[i].first, points[i], K);
 
+  localFirst = w;
+  localLast = 0;
   for (size_t i = 0; i < polygon.size(); ++i) {
-    vpColVector p1, p2;
-    createVectorFromPoint(polygon[i].first, p1, K);
-    createVectorFromPoint(polygon[(i + 1) % polygon.size()].first, p2, K);
-
-    drawLineX(p1, p2, makeMbScanLineEdge(polygon[i].first, polygon[(i + 1) % polygon.size()].first), ID,
-              local_scanlines);
+    const size_t j = (i + 1) % polygon.size();
+    drawLineX(points[i], points[j], getEdgeIndex(polygon[i].first, polygon[j].first), ID, localScanlines);
   }
 
-  createScanLinesFromLocals(scanlines, local_scanlines, w);
+  createScanLinesFromLocals(scanlines);
 }
 
 /*!
-  Organise local scanlines in a global scanline vector.
-  It also marks the computed intersections as starting or ending points.
+  Organise the local scanlines filled by the last drawn polygon in a global
+  scanline vector. It also marks the computed intersections as starting or
+  ending points. Only the scanlines in [localFirst, localLast) are processed
+  and they are emptied for the next polygon.
   This function will only be called by the drawPolygons functions.
 
   \param scanlines : Global scanline vector.
-  \param localScanlines : Local scanline vector (X or Y-axis).
-  \param size : Corresponding size (typically the width or the height).
 */
-void vpMbScanLine::createScanLinesFromLocals(std::vector<std::vector<vpMbScanLineSegment> > &scanlines,
-                                             std::vector<std::vector<vpMbScanLineSegment> > &localScanlines,
-                                             const unsigned int &size)
+void vpMbScanLine::createScanLinesFromLocals(std::vector<std::vector<vpMbScanLineSegment> > &scanlines)
 {
-  for (unsigned int j = 0; j < size; ++j) {
+  for (unsigned int j = localFirst; j < localLast; ++j) {
     std::vector<vpMbScanLineSegment> &scanline = localScanlines[j];
     sort(scanline.begin(), scanline.end(),
          vpMbScanLineSegmentComparator()); // Not sure its necessary
@@ -292,6 +310,7 @@ void vpMbScanLine::createScanLinesFromLocals(std::vector<std::vector<vpMbScanLin
       }
       scanlines[j].push_back(s);
     }
+    scanline.clear();
   }
 }
 
@@ -299,6 +318,10 @@ void vpMbScanLine::createScanLinesFromLocals(std::vector<std::vector<vpMbScanLin
   Render a scene of polygons and compute scanlines intersections in order to
   use queries.
 
+  The scanline buffers are kept from one call to the next. The rows (and then
+  the columns) are independent once all the polygons are drawn, so they are
+  processed by bands in parallel when OpenMP is available.
+
   \param polygons : List of polygons composed by arrays of lines.
   \param listPolyIndices : List of polygons IDs (has to be know when using
   queries). \param cam : Camera parameters. \param width : Width of the image
@@ -312,19 +335,32 @@ void vpMbScanLine::drawScene(const std::vector<std::vector<std::pair<vpPoint, un
   this->h = height;
   this->K = cam;
 
-  visibility_samples.clear();
+  edge_ids.clear();
 
-  std::vector<std::vector<vpMbScanLineSegment> > scanlinesY;
   scanlinesY.resize(h);
-  std::vector<std::vector<vpMbScanLineSegment> > scanlinesX;
+  samplesY.resize(h);
+  for (unsigned int y = 0; y < h; ++y) {
+    scanlinesY[y].clear();
+    samplesY[y].clear();
+  }
   scanlinesX.resize(w);
+  samplesX.resize(w);
+  for (unsigned int x = 0; x < w; ++x) {
+    scanlinesX[x].clear();
+    samplesX[x].clear();
+  }
+  if (localScanlines.size() < (std::max)(w, h))
+    localScanlines.resize((std::max)(w, h));
 
   mask.resize(h, w, 0);
-
-  vpImage<unsigned char> maskY(h, w, 0);
-  vpImage<unsigned char> maskX(h, w, 0);
+  if (maskBorder != 0) {
+    maskY.resize(h, w, 0);
+    maskX.resize(h, w, 0);
+  }
 
   primitive_ids.resize(h, w, -1);
+  if (computeDepths)
+    primitive_depths.resize(h, w, 0.f);
 
   for (unsigned int ID = 0; ID < polygons.size(); ++ID) {
     drawPolygonY(*(polygons[ID]), listPolyIndices[ID], scanlinesY);
@@ -332,153 +368,201 @@ void vpMbScanLine::drawScene(const std::vector<std::vector<std::pair<vpPoint, un
   }
 
   // Y
-  int last_ID = -1;
-  vpMbScanLineSegment last_visible;
-  for (unsigned int y = 0; y < scanlinesY.size(); ++y) {
-    std::vector<vpMbScanLineSegment> &scanline = scanlinesY[y];
-    sort(scanline.begin(), scanline.end(), vpMbScanLineSegmentComparator());
-
+  const int nbRows = (int)h;
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel if (nbRows > 64)
+#endif
+  {
     std::vector<std::pair<double, vpMbScanLineSegment> > stack;
-    for (size_t i = 0; i < scanline.size(); ++i) {
-      const vpMbScanLineSegment &s = scanline[i];
-
-      switch (s.type) {
-      case START:
-        stack.push_back(std::make_pair(s.Z1, s));
-        break;
-      case END:
-        for (size_t j = 0; j < stack.size(); ++j)
-          if (stack[j].second.ID == s.ID) {
-            if (j != stack.size() - 1)
-              stack[j] = stack.back();
-            stack.pop_back();
-            break;
-          }
-        break;
-      case POINT:
-        break;
-      }
+#ifdef VISP_HAVE_OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif
+    for (int row = 0; row < nbRows; ++row) {
+      const unsigned int y = (unsigned int)row;
+      std::vector<vpMbScanLineSegment> &scanline = scanlinesY[y];
+      std::vector<int> &samples = samplesY[y];
+      sort(scanline.begin(), scanline.end(), vpMbScanLineSegmentComparator());
+
+      int last_ID = -1;
+      vpMbScanLineSegment last_visible;
+      stack.clear();
+      for (size_t i = 0; i < scanline.size(); ++i) {
+        const vpMbScanLineSegment &s = scanline[i];
+
+        switch (s.type) {
+        case START:
+          stack.push_back(std::make_pair(s.Z1, s));
+          break;
+        case END:
+          for (size_t j = 0; j < stack.size(); ++j)
+            if (stack[j].second.ID == s.ID) {
+              if (j != stack.size() - 1)
+                stack[j] = stack.back();
+              stack.pop_back();
+              break;
+            }
+          break;
+        case POINT:
+          break;
+        }
 
-      for (size_t j = 0; j < stack.size(); ++j) {
-        const vpMbScanLineSegment &s0 = stack[j].second;
-        stack[j].first = mix(s0.Z1, s0.Z2, getAlpha(s.type == POINT ? s.p : (s.p + 0.5), s0.P1, s0.Z1, s0.P2, s0.Z2));
-      }
-      sort(stack.begin(), stack.end(), vpMbScanLineSegmentComparator());
-
-      int new_ID = stack.empty() ? -1 : stack.front().second.ID;
-
-      if (new_ID != last_ID || s.type == POINT) {
-        if (s.b_sample_Y)
-          switch (s.type) {
-          case POINT:
-            if (new_ID == -1 || s.Z1 - depthTreshold <= stack.front().first)
-              visibility_samples[s.edge].insert((int)y);
-            break;
-          case START:
-            if (new_ID == s.ID)
-              visibility_samples[s.edge].insert((int)y);
-            break;
-          case END:
-            if (last_ID == s.ID)
-              visibility_samples[s.edge].insert((int)y);
-            break;
+        for (size_t j = 0; j < stack.size(); ++j) {
+          const vpMbScanLineSegment &s0 = stack[j].second;
+          stack[j].first =
+              mix(s0.Z1, s0.Z2, getAlpha(s.type == POINT ? s.p : (s.p + 0.5), s0.P1, s0.Z1, s0.P2, s0.Z2));
+        }
+        sort(stack.begin(), stack.end(), vpMbScanLineSegmentComparator());
+
+        int new_ID = stack.empty() ? -1 : stack.front().second.ID;
+
+        if (new_ID != last_ID || s.type == POINT) {
+          if (s.b_sample_Y)
+            switch (s.type) {
+            case POINT:
+              if (new_ID == -1 || s.Z1 - depthTreshold <= stack.front().first)
+                samples.push_back(s.edge);
+              break;
+            case START:
+              if (new_ID == s.ID)
+                samples.push_back(s.edge);
+              break;
+            case END:
+              if (last_ID == s.ID)
+                samples.push_back(s.edge);
+              break;
+            }
+
+          // This part will only be used for MbKltTracking
+          if (last_ID != -1) {
+            const unsigned int x0 = (std::max)((unsigned int)0, (unsigned int)(std::ceil(last_visible.p)));
+            const double x1 = (std::min)((double)w, (double)s.p);
+            for (unsigned int x = x0 + maskBorder; x < x1 - maskBorder; ++x) {
+              primitive_ids[y][x] = last_visible.ID;
+
+              if (computeDepths)
+                primitive_depths[y][x] = (float)mix(last_visible.Z1, last_visible.Z2,
+                                                    getAlpha(x, last_visible.P1, last_visible.Z1, last_visible.P2,
+                                                             last_visible.Z2));
+
+              if (maskBorder != 0)
+                maskY[y][x] = 255;
+              else
+                mask[y][x] = 255;
+            }
           }
 
-        // This part will only be used for MbKltTracking
-        if (last_ID != -1) {
-          const unsigned int x0 = (std::max)((unsigned int)0, (unsigned int)(std::ceil(last_visible.p)));
-          const double x1 = (std::min)((double)w, (double)s.p);
-          for (unsigned int x = x0 + maskBorder; x < x1 - maskBorder; ++x) {
-            primitive_ids[(unsigned int)y][(unsigned int)x] = last_visible.ID;
-
-            if (maskBorder != 0)
-              maskY[(unsigned int)y][(unsigned int)x] = 255;
-            else
-              mask[(unsigned int)y][(unsigned int)x] = 255;
+          last_ID = new_ID;
+          if (!stack.empty()) {
+            last_visible = stack.front().second;
+            last_visible.p = s.p;
           }
         }
-
-        last_ID = new_ID;
-        if (!stack.empty()) {
-          last_visible = stack.front().second;
-          last_visible.p = s.p;
-        }
       }
     }
   }
 
   // X
-  last_ID = -1;
-  for (unsigned int x = 0; x < scanlinesX.size(); ++x) {
-    std::vector<vpMbScanLineSegment> &scanline = scanlinesX[x];
-    sort(scanline.begin(), scanline.end(), vpMbScanLineSegmentComparator());
-
+  const int nbCols = (int)w;
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel if (nbCols > 64)
+#endif
+  {
     std::vector<std::pair<double, vpMbScanLineSegment> > stack;
-    for (size_t i = 0; i < scanline.size(); ++i) {
-      const vpMbScanLineSegment &s = scanline[i];
-
-      switch (s.type) {
-      case START:
-        stack.push_back(std::make_pair(s.Z1, s));
-        break;
-      case END:
-        for (size_t j = 0; j < stack.size(); ++j)
-          if (stack[j].second.ID == s.ID) {
-            if (j != stack.size() - 1)
-              stack[j] = stack.back();
-            stack.pop_back();
-            break;
-          }
-        break;
-      case POINT:
-        break;
-      }
+#ifdef VISP_HAVE_OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif
+    for (int col = 0; col < nbCols; ++col) {
+      const unsigned int x = (unsigned int)col;
+      std::vector<vpMbScanLineSegment> &scanline = scanlinesX[x];
+      std::vector<int> &samples = samplesX[x];
+      sort(scanline.begin(), scanline.end(), vpMbScanLineSegmentComparator());
+
+      int last_ID = -1;
+      vpMbScanLineSegment last_visible;
+      stack.clear();
+      for (size_t i = 0; i < scanline.size(); ++i) {
+        const vpMbScanLineSegment &s = scanline[i];
+
+        switch (s.type) {
+        case START:
+          stack.push_back(std::make_pair(s.Z1, s));
+          break;
+        case END:
+          for (size_t j = 0; j < stack.size(); ++j)
+            if (stack[j].second.ID == s.ID) {
+              if (j != stack.size() - 1)
+                stack[j] = stack.back();
+              stack.pop_back();
+              break;
+            }
+          break;
+        case POINT:
+          break;
+        }
 
-      for (size_t j = 0; j < stack.size(); ++j) {
-        const vpMbScanLineSegment &s0 = stack[j].second;
-        stack[j].first = mix(s0.Z1, s0.Z2, getAlpha(s.type == POINT ? s.p : (s.p + 0.5), s0.P1, s0.Z1, s0.P2, s0.Z2));
-      }
-      sort(stack.begin(), stack.end(), vpMbScanLineSegmentComparator());
-
-      int new_ID = stack.empty() ? -1 : stack.front().second.ID;
-
-      if (new_ID != last_ID || s.type == POINT) {
-        if (!s.b_sample_Y)
-          switch (s.type) {
-          case POINT:
-            if (new_ID == -1 || s.Z1 - depthTreshold <= stack.front().first)
-              visibility_samples[s.edge].insert((int)x);
-            break;
-          case START:
-            if (new_ID == s.ID)
-              visibility_samples[s.edge].insert((int)x);
-            break;
-          case END:
-            if (last_ID == s.ID)
-              visibility_samples[s.edge].insert((int)x);
-            break;
+        for (size_t j = 0; j < stack.size(); ++j) {
+          const vpMbScanLineSegment &s0 = stack[j].second;
+          stack[j].first =
+              mix(s0.Z1, s0.Z2, getAlpha(s.type == POINT ? s.p : (s.p + 0.5), s0.P1, s0.Z1, s0.P2, s0.Z2));
+        }
+        sort(stack.begin(), stack.end(), vpMbScanLineSegmentComparator());
+
+        int new_ID = stack.empty() ? -1 : stack.front().second.ID;
+
+        if (new_ID != last_ID || s.type == POINT) {
+          if (!s.b_sample_Y)
+            switch (s.type) {
+            case POINT:
+              if (new_ID == -1 || s.Z1 - depthTreshold <= stack.front().first)
+                samples.push_back(s.edge);
+              break;
+            case START:
+              if (new_ID == s.ID)
+                samples.push_back(s.edge);
+              break;
+            case END:
+              if (last_ID == s.ID)
+                samples.push_back(s.edge);
+              break;
+            }
+
+          // This part will only be used for MbKltTracking
+          if (maskBorder != 0 && last_ID != -1) {
+            const unsigned int y0 = (std::max)((unsigned int)0, (unsigned int)(std::ceil(last_visible.p)));
+            const double y1 = (std::min)((double)h, (double)s.p);
+            for (unsigned int y = y0 + maskBorder; y < y1 - maskBorder; ++y) {
+              // primitive_ids[(unsigned int)y][(unsigned int)x] =
+              // last_visible.ID;
+              maskX[y][x] = 255;
+            }
           }
 
-        // This part will only be used for MbKltTracking
-        if (maskBorder != 0 && last_ID != -1) {
-          const unsigned int y0 = (std::max)((unsigned int)0, (unsigned int)(std::ceil(last_visible.p)));
-          const double y1 = (std::min)((double)h, (double)s.p);
-          for (unsigned int y = y0 + maskBorder; y < y1 - maskBorder; ++y) {
-            // primitive_ids[(unsigned int)y][(unsigned int)x] =
-            // last_visible.ID;
-            maskX[(unsigned int)y][(unsigned int)x] = 255;
+          last_ID = new_ID;
+          if (!stack.empty()) {
+            last_visible = stack.front().second;
+            last_visible.p = s.p;
           }
         }
-
-        last_ID = new_ID;
-        if (!stack.empty()) {
-          last_visible = stack.front().second;
-          last_visible.p = s.p;
-        }
       }
     }
   }
 
+  // Gather the samples of each edge, sorted and without duplicates
+  visibility_samples.resize(edge_ids.size());
+  for (size_t i = 0; i < visibility_samples.size(); ++i)
+    visibility_samples[i].clear();
+  for (unsigned int y = 0; y < h; ++y)
+    for (size_t i = 0; i < samplesY[y].size(); ++i)
+      visibility_samples[(size_t)samplesY[y][i]].push_back((int)y);
+  for (unsigned int x = 0; x < w; ++x)
+    for (size_t i = 0; i < samplesX[x].size(); ++i)
+      visibility_samples[(size_t)samplesX[x][i]].push_back((int)x);
+  for (size_t i = 0; i < visibility_samples.size(); ++i) {
+    std::vector<int> &samples = visibility_samples[i];
+    sort(samples.begin(), samples.end());
+    samples.erase(std::unique(samples.begin(), samples.end()), samples.end());
+  }
+
   if (maskBorder != 0)
     for (unsigned int i = 0; i < h; i++)
       for (unsigned int j = 0; j < w; j++)
@@ -556,7 +640,8 @@ void vpMbScanLine::queryLineVisibility(const vpPoint &a, const vpPoint &b,
 #endif
   }
 
-  if (!visibility_samples.count(edge))
+  std::map<vpMbScanLineEdge, int, vpMbScanLineEdgeComparator>::const_iterator it_edge = edge_ids.find(edge);
+  if (it_edge == edge_ids.end() || visibility_samples[(size_t)it_edge->second].empty())
     return;
 
   // Initialized as the biggest difference between the two points is on the
@@ -597,12 +682,12 @@ void vpMbScanLine::queryLineVisibility(const vpPoint &a, const vpPoint &b,
   const int _v0 = (std::max)(0, int(std::ceil(*v0)));
   const int _v1 = (std::min)((int)(size - 1), (int)(std::ceil(*v1) - 1));
 
-  const std::set<int> &visible_samples = visibility_samples[edge];
+  const std::vector<int> &visible_samples = visibility_samples[(size_t)it_edge->second];
   int last = _v0;
   vpPoint line_start;
   vpPoint line_end;
   bool b_line_started = false;
-  for (std::set<int>::const_iterator it = visible_samples.begin(); it != visible_samples.end(); ++it) {
+  for (std::vector<int>::const_iterator it = visible_samples.begin(); it != visible_samples.end(); ++it) {
     const int v = *it;
     const double alpha = getAlpha(v, (*v0) * (*w0), (*w0), (*v1) * (*w1), (*w1));
     // const vpPoint p = mix(a, b, alpha);
@@ -44,9 +44,11 @@
 */
 
 #include <algorithm>
+#include <iomanip>
 #include <iostream>
 #include <limits>
 #include <map>
+#include <sstream>
 
 #include <visp3/core/vpColVector.h>
 #include <visp3/core/vpDisplay.h>
@@ -102,18 +104,6 @@
 
 namespace
 {
-/*!
-  Structure to store info about segment in CAO model files.
- */
-struct SegmentInfo {
-  SegmentInfo() : extremities(), name(), useLod(false), minLineLengthThresh(0.) {}
-
-  std::vector<vpPoint> extremities;
-  std::string name;
-  bool useLod;
-  double minLineLengthThresh;
-};
-
 /*!
   Structure to store info about a polygon face represented by a vpPolygon and
   by a list of vpPoint representing the corners of the polygon face in 3D.
@@ -151,7 +141,7 @@ vpMbTracker::vpMbTracker()
     m_projectionErrorFaces(), m_projectionErrorOgreShowConfigDialog(false),
     m_projectionErrorMe(), m_projectionErrorKernelSize(2), m_SobelX(5,5), m_SobelY(5,5),
     m_projectionErrorDisplay(false), m_projectionErrorDisplayLength(20), m_projectionErrorDisplayThickness(1),
-    m_projectionErrorCam(), m_mask(NULL)
+    m_projectionErrorCam(), m_mask(NULL), m_modelCacheDirectory()
 {
   oJo.eye();
   // Map used to parse additional information in CAO model files,
@@ -1109,7 +1099,9 @@ void vpMbTracker::loadModel(const std::string &modelFile, const bool verbose, co
     it = modelFile.end();
     if ((*(it - 1) == 'o' && *(it - 2) == 'a' && *(it - 3) == 'c' && *(it - 4) == '.') ||
         (*(it - 1) == 'O' && *(it - 2) == 'A' && *(it - 3) == 'C' && *(it - 4) == '.')) {
-      std::vector<std::string> vectorOfModelFilename;
+      vpMbtCompiledModel model;
+      compileModel(modelFile, model, verbose);
+
       int startIdFace = (int)faces.size();
       nbPoints = 0;
       nbLines = 0;
@@ -1117,7 +1109,7 @@ void vpMbTracker::loadModel(const std::string &modelFile, const bool verbose, co
       nbPolygonPoints = 0;
       nbCylinders = 0;
       nbCircles = 0;
-      loadCAOModel(modelFile, vectorOfModelFilename, startIdFace, verbose, true, T);
+      buildCAOModel(model, startIdFace, T);
     } else if ((*(it - 1) == 'l' && *(it - 2) == 'r' && *(it - 3) == 'w' && *(it - 4) == '.') ||
                (*(it - 1) == 'L' && *(it - 2) == 'R' && *(it - 3) == 'W' && *(it - 4) == '.')) {
       loadVRMLModel(modelFile);
@@ -1132,6 +1124,93 @@ void vpMbTracker::loadModel(const std::string &modelFile, const bool verbose, co
   this->modelFileName = modelFile;
 }
 
+/*!
+  Compile a CAO model file and the files it includes, so that it can be added
+  to one or several trackers with loadCompiledModel() without being parsed
+  again.
+
+  When a cache directory is set with setModelCacheDirectory(), the compiled
+  model is saved in this directory, in a file named after the hash of the
+  content of \e modelFile. The next calls load this file instead of parsing
+  the model, as long as none of the CAO files was modified.
+
+  \throw vpException::ioError if the file cannot be open, or if its extension
+  is not cao.
+
+  \param modelFile : CAO file containing the 3D model description.
+  \param model : Compiled model.
+  \param verbose : verbose option to print additional information when loading
+  CAO model files which include other CAO model files.
+*/
+void vpMbTracker::compileModel(const std::string &modelFile, vpMbtCompiledModel &model, const bool verbose)
+{
+  if (!vpIoTools::checkFilename(modelFile)) {
+    throw vpException(vpException::ioError, "Error: File %s doesn't exist", modelFile.c_str());
+  }
+  std::string extension = vpIoTools::getFileExtension(modelFile);
+  std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+  if (extension != ".cao") {
+    throw vpException(vpException::ioError, "Error: File %s doesn't contain a cao model", modelFile.c_str());
+  }
+
+  std::string cacheFile;
+  if (!m_modelCacheDirectory.empty()) {
+    std::ostringstream name;
+    name << vpIoTools::getNameWE(modelFile) << "_" << std::hex << std::setw(16) << std::setfill('0')
+         << vpMbtCompiledModel::computeFileHash(modelFile) << ".cao.bin";
+    cacheFile = vpIoTools::createFilePath(m_modelCacheDirectory, name.str());
+
+    if (vpIoTools::checkFilename(cacheFile)) {
+      try {
+        model.load(cacheFile);
+        if (model.getModelFile() == vpIoTools::getAbsolutePathname(modelFile) && model.isUpToDate()) {
+          if (verbose) {
+            std::cout << "Model file : " << modelFile << " loaded from " << cacheFile << std::endl;
+          }
+          return;
+        }
+      } catch (const vpException &) {
+        // The model is compiled again below
+      }
+    }
+  }
+
+  model.clear();
+  std::vector<std::string> vectorOfModelFilename;
+  parseCAOModel(modelFile, vectorOfModelFilename, model, verbose, true);
+
+  if (!cacheFile.empty()) {
+    try {
+      model.save(cacheFile);
+    } catch (const vpException &e) {
+      std::cerr << "Cannot cache the compiled model: " << e.getMessage() << std::endl;
+    }
+  }
+}
+
+/*!
+  Add to the tracker a model compiled with compileModel(). The same compiled
+  model can be added to several trackers.
+
+  \param model : Compiled model.
+  \param T : optional transformation matrix to transform 3D points expressed
+  in the original object frame to the desired object frame.
+*/
+void vpMbTracker::loadCompiledModel(const vpMbtCompiledModel &model, const vpHomogeneousMatrix &T)
+{
+  int startIdFace = (int)faces.size();
+  nbPoints = 0;
+  nbLines = 0;
+  nbPolygonLines = 0;
+  nbPolygonPoints = 0;
+  nbCylinders = 0;
+  nbCircles = 0;
+  buildCAOModel(model, startIdFace, T);
+
+  this->modelInitialised = true;
+  this->modelFileName = model.getModelFile();
+}
+
 /*!
   Load the 3D model of the object from a vrml file. Only LineSet and FaceSet
 are extracted from the vrml file.
@@ -1314,6 +1393,9 @@ std::map<std::string, std::string> vpMbTracker::parseParameters(std::string &end
   0.5 0 1 2 // radius, index center point, index 2 other points on the plane containing the circle
   \endcode
 
+  The file is first compiled with parseCAOModel(), then the primitives are
+  added to the tracker with buildCAOModel().
+
   \param modelFile : Full name of the main *.cao file containing the model.
   \param vectorOfModelFilename : A vector of *.cao files.
   \param startIdFace : Current Id of the face.
@@ -1328,6 +1410,26 @@ std::map<std::string, std::string> vpMbTracker::parseParameters(std::string &end
 void vpMbTracker::loadCAOModel(const std::string &modelFile, std::vector<std::string> &vectorOfModelFilename,
                                int &startIdFace, const bool verbose, const bool parent,
                                const vpHomogeneousMatrix &T)
+{
+  vpMbtCompiledModel model;
+  parseCAOModel(modelFile, vectorOfModelFilename, model, verbose, parent);
+  buildCAOModel(model, startIdFace, T);
+}
+
+/*!
+  Parse a *.cao file, described in loadCAOModel(), and the files it includes.
+  The points and the primitives are appended to \e model.
+
+  \param modelFile : Full name of the *.cao file.
+  \param vectorOfModelFilename : A vector of *.cao files already parsed.
+  \param model : Compiled model.
+  \param verbose : If true, will print additional information with CAO model
+  files which include other CAO model files.
+  \param parent : This parameter is set to true when parsing a parent CAO model
+  file, and false when parsing an included CAO model file.
+*/
+void vpMbTracker::parseCAOModel(const std::string &modelFile, std::vector<std::string> &vectorOfModelFilename,
+                                vpMbtCompiledModel &model, const bool verbose, const bool parent)
 {
   std::ifstream fileId;
   fileId.exceptions(std::ifstream::failbit | std::ifstream::eofbit);
@@ -1341,6 +1443,7 @@ void vpMbTracker::loadCAOModel(const std::string &modelFile, std::vector<std::st
     std::cout << "Model file : " << modelFile << std::endl;
   }
   vectorOfModelFilename.push_back(modelFile);
+  model.addSourceFile(vpIoTools::getAbsolutePathname(modelFile));
 
   try {
     char c;
@@ -1404,7 +1507,7 @@ void vpMbTracker::loadCAOModel(const std::string &modelFile, std::vector<std::st
 
         if (!cyclic) {
           if (vpIoTools::checkFilename(headerPath)) {
-            loadCAOModel(headerPath, vectorOfModelFilename, startIdFace, verbose, false, T);
+            parseCAOModel(headerPath, vectorOfModelFilename, model, verbose, false);
           } else {
             throw vpException(vpException::ioError, "file cannot be open");
           }
@@ -1426,7 +1529,6 @@ void vpMbTracker::loadCAOModel(const std::string &modelFile, std::vector<std::st
     fileId >> caoNbrPoint;
     fileId.ignore(256, '\n'); // skip the rest of the line
 
-    nbPoints += caoNbrPoint;
     if (verbose || vectorOfModelFilename.size() == 1) {
       std::cout << "> " << caoNbrPoint << " points" << std::endl;
     }
@@ -1438,7 +1540,9 @@ void vpMbTracker::loadCAOModel(const std::string &modelFile, std::vector<std::st
     if (caoNbrPoint == 0 && !header) {
       throw vpException(vpException::badValue, "in vpMbTracker::loadCAOModel() -> no points are defined");
     }
-    vpPoint *caoPoints = new vpPoint[caoNbrPoint];
+    // The points of this file are appended to the ones of the included files
+    const unsigned int pointOffset = model.getNbPoints();
+    model.m_points.reserve(model.m_points.size() + 3 * caoNbrPoint);
 
     int i; // image coordinate (used for matching)
     int j;
@@ -1446,10 +1550,10 @@ void vpMbTracker::loadCAOModel(const std::string &modelFile, std::vector<std::st
     for (unsigned int k = 0; k < caoNbrPoint; k++) {
       removeComment(fileId);
 
-      vpColVector pt_3d(4, 1.0);
-      fileId >> pt_3d[0];
-      fileId >> pt_3d[1];
-      fileId >> pt_3d[2];
+      double X, Y, Z;
+      fileId >> X;
+      fileId >> Y;
+      fileId >> Z;
 
       if (caoVersion == 2) {
         fileId >> i;
@@ -1458,38 +1562,32 @@ void vpMbTracker::loadCAOModel(const std::string &modelFile, std::vector<std::st
 
       fileId.ignore(256, '\n'); // skip the rest of the line
 
-      vpColVector pt_3d_tf = T*pt_3d;
-      caoPoints[k].setWorldCoordinates(pt_3d_tf[0], pt_3d_tf[1], pt_3d_tf[2]);
+      model.m_points.push_back(X);
+      model.m_points.push_back(Y);
+      model.m_points.push_back(Z);
     }
 
     removeComment(fileId);
 
     //////////////////////////Read the segment declaration part//////////////////////////
     // Store in a map the potential segments to add
-    std::map<std::pair<unsigned int, unsigned int>, SegmentInfo> segmentTemporaryMap;
+    std::map<std::pair<unsigned int, unsigned int>, vpMbtCompiledModel::vpPrimitive> segmentTemporaryMap;
     unsigned int caoNbrLine;
     fileId >> caoNbrLine;
     fileId.ignore(256, '\n'); // skip the rest of the line
 
-    nbLines += caoNbrLine;
-    unsigned int *caoLinePoints = NULL;
+    model.m_nbLines += caoNbrLine;
     if (verbose || vectorOfModelFilename.size() == 1) {
       std::cout << "> " << caoNbrLine << " lines" << std::endl;
     }
 
     if (caoNbrLine > 100000) {
-      delete[] caoPoints;
       throw vpException(vpException::badValue, "Exceed the max number of lines in the CAO model.");
     }
 
-    if (caoNbrLine > 0)
-      caoLinePoints = new unsigned int[2 * caoNbrLine];
+    std::vector<unsigned int> caoLinePoints(2 * caoNbrLine);
 
     unsigned int index1, index2;
-    // Initialization of idFace with startIdFace for dealing with recursive
-    // load in header
-    int idFace = startIdFace;
-
     for (unsigned int k = 0; k < caoNbrLine; k++) {
       removeComment(fileId);
 
@@ -1503,36 +1601,30 @@ void vpMbTracker::loadCAOModel(const std::string &modelFile, std::vector<std::st
       std::string endLine(buffer);
       std::map<std::string, std::string> mapOfParams = parseParameters(endLine);
 
-      std::string segmentName = "";
-      double minLineLengthThresh = !applyLodSettingInConfig ? minLineLengthThresholdGeneral : 50.0;
-      bool useLod = !applyLodSettingInConfig ? useLodGeneral : false;
+      vpMbtCompiledModel::vpPrimitive segment;
+      segment.type = vpMbtCompiledModel::SEGMENT;
       if (mapOfParams.find("name") != mapOfParams.end()) {
-        segmentName = mapOfParams["name"];
+        segment.name = mapOfParams["name"];
       }
       if (mapOfParams.find("minLineLengthThreshold") != mapOfParams.end()) {
-        minLineLengthThresh = std::atof(mapOfParams["minLineLengthThreshold"].c_str());
+        segment.hasThreshold = true;
+        segment.threshold = std::atof(mapOfParams["minLineLengthThreshold"].c_str());
       }
       if (mapOfParams.find("useLod") != mapOfParams.end()) {
-        useLod = parseBoolean(mapOfParams["useLod"]);
+        segment.hasUseLod = true;
+        segment.useLod = parseBoolean(mapOfParams["useLod"]);
       }
 
-      SegmentInfo segmentInfo;
-      segmentInfo.name = segmentName;
-      segmentInfo.useLod = useLod;
-      segmentInfo.minLineLengthThresh = minLineLengthThresh;
-
       caoLinePoints[2 * k] = index1;
       caoLinePoints[2 * k + 1] = index2;
 
       if (index1 < caoNbrPoint && index2 < caoNbrPoint) {
-        std::vector<vpPoint> extremities;
-        extremities.push_back(caoPoints[index1]);
-        extremities.push_back(caoPoints[index2]);
-        segmentInfo.extremities = extremities;
+        segment.indices.push_back(pointOffset + index1);
+        segment.indices.push_back(pointOffset + index2);
 
         std::pair<unsigned int, unsigned int> key(index1, index2);
 
-        segmentTemporaryMap[key] = segmentInfo;
+        segmentTemporaryMap[key] = segment;
       } else {
         vpTRACE(" line %d has wrong coordinates.", k);
       }
@@ -1550,14 +1642,12 @@ void vpMbTracker::loadCAOModel(const std::string &modelFile, std::vector<std::st
     fileId >> caoNbrPolygonLine;
     fileId.ignore(256, '\n'); // skip the rest of the line
 
-    nbPolygonLines += caoNbrPolygonLine;
+    model.m_nbPolygonLines += caoNbrPolygonLine;
     if (verbose || vectorOfModelFilename.size() == 1) {
       std::cout << "> " << caoNbrPolygonLine << " polygon lines" << std::endl;
     }
 
     if (caoNbrPolygonLine > 100000) {
-      delete[] caoPoints;
-      delete[] caoLinePoints;
       throw vpException(vpException::badValue, "Exceed the max number of polygon lines.");
     }
 
@@ -1567,19 +1657,21 @@ void vpMbTracker::loadCAOModel(const std::string &modelFile, std::vector<std::st
 
       unsigned int nbLinePol;
       fileId >> nbLinePol;
-      std::vector<vpPoint> corners;
       if (nbLinePol > 100000) {
         throw vpException(vpException::badValue, "Exceed the max number of lines.");
       }
 
+      vpMbtCompiledModel::vpPrimitive face;
+      face.type = vpMbtCompiledModel::FACE_FROM_LINES;
       for (unsigned int n = 0; n < nbLinePol; n++) {
         fileId >> index;
 
-        if (index >= caoNbrLine) {
+        if (index >= caoNbrLine || caoLinePoints[2 * index] >= caoNbrPoint ||
+            caoLinePoints[2 * index + 1] >= caoNbrPoint) {
           throw vpException(vpException::badValue, "Exceed the max number of lines.");
         }
-        corners.push_back(caoPoints[caoLinePoints[2 * index]]);
-        corners.push_back(caoPoints[caoLinePoints[2 * index + 1]]);
+        face.indices.push_back(pointOffset + caoLinePoints[2 * index]);
+        face.indices.push_back(pointOffset + caoLinePoints[2 * index + 1]);
 
         std::pair<unsigned int, unsigned int> key(caoLinePoints[2 * index], caoLinePoints[2 * index + 1]);
         faceSegmentKeyVector.push_back(key);
@@ -1592,38 +1684,28 @@ void vpMbTracker::loadCAOModel(const std::string &modelFile, std::vector<std::st
       std::string endLine(buffer);
       std::map<std::string, std::string> mapOfParams = parseParameters(endLine);
 
-      std::string polygonName = "";
-      bool useLod = !applyLodSettingInConfig ? useLodGeneral : false;
-      double minPolygonAreaThreshold = !applyLodSettingInConfig ? minPolygonAreaThresholdGeneral : 2500.0;
       if (mapOfParams.find("name") != mapOfParams.end()) {
-        polygonName = mapOfParams["name"];
+        face.name = mapOfParams["name"];
       }
       if (mapOfParams.find("minPolygonAreaThreshold") != mapOfParams.end()) {
-        minPolygonAreaThreshold = std::atof(mapOfParams["minPolygonAreaThreshold"].c_str());
+        face.hasThreshold = true;
+        face.threshold = std::atof(mapOfParams["minPolygonAreaThreshold"].c_str());
       }
       if (mapOfParams.find("useLod") != mapOfParams.end()) {
-        useLod = parseBoolean(mapOfParams["useLod"]);
+        face.hasUseLod = true;
+        face.useLod = parseBoolean(mapOfParams["useLod"]);
       }
 
-      addPolygon(corners, idFace, polygonName, useLod, minPolygonAreaThreshold, minLineLengthThresholdGeneral);
-      initFaceFromLines(*(faces.getPolygon().back())); // Init from the last polygon that was added
-
-      addProjectionErrorPolygon(corners, idFace++, polygonName, useLod, minPolygonAreaThreshold, minLineLengthThresholdGeneral);
-      initProjectionErrorFaceFromLines(*(m_projectionErrorFaces.getPolygon().back()));
+      model.m_primitives.push_back(face);
     }
 
     // Add the segments which were not already added in the face segment case
-    for (std::map<std::pair<unsigned int, unsigned int>, SegmentInfo>::const_iterator it = segmentTemporaryMap.begin();
+    for (std::map<std::pair<unsigned int, unsigned int>, vpMbtCompiledModel::vpPrimitive>::const_iterator it =
+             segmentTemporaryMap.begin();
          it != segmentTemporaryMap.end(); ++it) {
       if (std::find(faceSegmentKeyVector.begin(), faceSegmentKeyVector.end(), it->first) ==
           faceSegmentKeyVector.end()) {
-        addPolygon(it->second.extremities, idFace, it->second.name, it->second.useLod, minPolygonAreaThresholdGeneral,
-                   it->second.minLineLengthThresh);
-        initFaceFromCorners(*(faces.getPolygon().back())); // Init from the last polygon that was added
-
-        addProjectionErrorPolygon(it->second.extremities, idFace++, it->second.name, it->second.useLod, minPolygonAreaThresholdGeneral,
-                                  it->second.minLineLengthThresh);
-        initProjectionErrorFaceFromCorners(*(m_projectionErrorFaces.getPolygon().back()));
+        model.m_primitives.push_back(it->second);
       }
     }
 
@@ -1635,7 +1717,7 @@ void vpMbTracker::loadCAOModel(const std::string &modelFile, std::vector<std::st
     fileId >> caoNbrPolygonPoint;
     fileId.ignore(256, '\n'); // skip the rest of the line
 
-    nbPolygonPoints += caoNbrPolygonPoint;
+    model.m_nbPolygonPoints += caoNbrPolygonPoint;
     if (verbose || vectorOfModelFilename.size() == 1) {
       std::cout << "> " << caoNbrPolygonPoint << " polygon points" << std::endl;
     }
@@ -1652,13 +1734,14 @@ void vpMbTracker::loadCAOModel(const std::string &modelFile, std::vector<std::st
       if (nbPointPol > 100000) {
         throw vpException(vpException::badValue, "Exceed the max number of points.");
       }
-      std::vector<vpPoint> corners;
+      vpMbtCompiledModel::vpPrimitive face;
+      face.type = vpMbtCompiledModel::FACE_FROM_POINTS;
       for (unsigned int n = 0; n < nbPointPol; n++) {
         fileId >> index;
         if (index > caoNbrPoint - 1) {
           throw vpException(vpException::badValue, "Exceed the max number of points.");
         }
-        corners.push_back(caoPoints[index]);
+        face.indices.push_back(pointOffset + index);
       }
 
       //////////////////////////Read the parameter value if present//////////////////////////
@@ -1668,24 +1751,19 @@ void vpMbTracker::loadCAOModel(const std::string &modelFile, std::vector<std::st
       std::string endLine(buffer);
       std::map<std::string, std::string> mapOfParams = parseParameters(endLine);
 
-      std::string polygonName = "";
-      bool useLod = !applyLodSettingInConfig ? useLodGeneral : false;
-      double minPolygonAreaThreshold = !applyLodSettingInConfig ? minPolygonAreaThresholdGeneral : 2500.0;
       if (mapOfParams.find("name") != mapOfParams.end()) {
-        polygonName = mapOfParams["name"];
+        face.name = mapOfParams["name"];
       }
       if (mapOfParams.find("minPolygonAreaThreshold") != mapOfParams.end()) {
-        minPolygonAreaThreshold = std::atof(mapOfParams["minPolygonAreaThreshold"].c_str());
+        face.hasThreshold = true;
+        face.threshold = std::atof(mapOfParams["minPolygonAreaThreshold"].c_str());
       }
       if (mapOfParams.find("useLod") != mapOfParams.end()) {
-        useLod = parseBoolean(mapOfParams["useLod"]);
+        face.hasUseLod = true;
+        face.useLod = parseBoolean(mapOfParams["useLod"]);
       }
 
-      addPolygon(corners, idFace, polygonName, useLod, minPolygonAreaThreshold, minLineLengthThresholdGeneral);
-      initFaceFromCorners(*(faces.getPolygon().back())); // Init from the last polygon that was added
-
-      addProjectionErrorPolygon(corners, idFace++, polygonName, useLod, minPolygonAreaThreshold, minLineLengthThresholdGeneral);
-      initProjectionErrorFaceFromCorners(*(m_projectionErrorFaces.getPolygon().back()));
+      model.m_primitives.push_back(face);
     }
 
     //////////////////////////Read the cylinder declaration part//////////////////////////
@@ -1695,8 +1773,6 @@ void vpMbTracker::loadCAOModel(const std::string &modelFile, std::vector<std::st
 
       if (fileId.eof()) { // check if not at the end of the file (for old
                           // style files)
-        delete[] caoPoints;
-        delete[] caoLinePoints;
         return;
       }
 
@@ -1704,7 +1780,7 @@ void vpMbTracker::loadCAOModel(const std::string &modelFile, std::vector<std::st
       fileId >> caoNbCylinder;
       fileId.ignore(256, '\n'); // skip the rest of the line
 
-      nbCylinders += caoNbCylinder;
+      model.m_nbCylinders += caoNbCylinder;
       if (verbose || vectorOfModelFilename.size() == 1) {
         std::cout << "> " << caoNbCylinder << " cylinders" << std::endl;
       }
@@ -1729,34 +1805,28 @@ void vpMbTracker::loadCAOModel(const std::string &modelFile, std::vector<std::st
         std::string endLine(buffer);
         std::map<std::string, std::string> mapOfParams = parseParameters(endLine);
 
-        std::string polygonName = "";
-        bool useLod = !applyLodSettingInConfig ? useLodGeneral : false;
-        double minLineLengthThreshold = !applyLodSettingInConfig ? minLineLengthThresholdGeneral : 50.0;
+        if (indexP1 >= caoNbrPoint || indexP2 >= caoNbrPoint) {
+          throw vpException(vpException::badValue, "Exceed the max number of points.");
+        }
+
+        vpMbtCompiledModel::vpPrimitive cylinder;
+        cylinder.type = vpMbtCompiledModel::CYLINDER;
+        cylinder.indices.push_back(pointOffset + indexP1);
+        cylinder.indices.push_back(pointOffset + indexP2);
+        cylinder.radius = radius;
         if (mapOfParams.find("name") != mapOfParams.end()) {
-          polygonName = mapOfParams["name"];
+          cylinder.name = mapOfParams["name"];
         }
         if (mapOfParams.find("minLineLengthThreshold") != mapOfParams.end()) {
-          minLineLengthThreshold = std::atof(mapOfParams["minLineLengthThreshold"].c_str());
+          cylinder.hasThreshold = true;
+          cylinder.threshold = std::atof(mapOfParams["minLineLengthThreshold"].c_str());
         }
         if (mapOfParams.find("useLod") != mapOfParams.end()) {
-          useLod = parseBoolean(mapOfParams["useLod"]);
+          cylinder.hasUseLod = true;
+          cylinder.useLod = parseBoolean(mapOfParams["useLod"]);
         }
 
-        int idRevolutionAxis = idFace;
-        addPolygon(caoPoints[indexP1], caoPoints[indexP2], idFace, polygonName, useLod, minLineLengthThreshold);
-
-        addProjectionErrorPolygon(caoPoints[indexP1], caoPoints[indexP2], idFace++, polygonName, useLod, minLineLengthThreshold);
-
-        std::vector<std::vector<vpPoint> > listFaces;
-        createCylinderBBox(caoPoints[indexP1], caoPoints[indexP2], radius, listFaces);
-        addPolygon(listFaces, idFace, polygonName, useLod, minLineLengthThreshold);
-
-        initCylinder(caoPoints[indexP1], caoPoints[indexP2], radius, idRevolutionAxis, polygonName);
-
-        addProjectionErrorPolygon(listFaces, idFace, polygonName, useLod, minLineLengthThreshold);
-        initProjectionErrorCylinder(caoPoints[indexP1], caoPoints[indexP2], radius, idRevolutionAxis, polygonName);
-
-        idFace += 4;
+        model.m_primitives.push_back(cylinder);
       }
 
     } catch (...) {
@@ -1771,8 +1841,6 @@ void vpMbTracker::loadCAOModel(const std::string &modelFile, std::vector<std::st
 
       if (fileId.eof()) { // check if not at the end of the file (for old
                           // style files)
-        delete[] caoPoints;
-        delete[] caoLinePoints;
         return;
       }
 
@@ -1780,7 +1848,7 @@ void vpMbTracker::loadCAOModel(const std::string &modelFile, std::vector<std::st
       fileId >> caoNbCircle;
       fileId.ignore(256, '\n'); // skip the rest of the line
 
-      nbCircles += caoNbCircle;
+      model.m_nbCircles += caoNbCircle;
       if (verbose || vectorOfModelFilename.size() == 1) {
         std::cout << "> " << caoNbCircle << " circles" << std::endl;
       }
@@ -1806,27 +1874,29 @@ void vpMbTracker::loadCAOModel(const std::string &modelFile, std::vector<std::st
         std::string endLine(buffer);
         std::map<std::string, std::string> mapOfParams = parseParameters(endLine);
 
-        std::string polygonName = "";
-        bool useLod = !applyLodSettingInConfig ? useLodGeneral : false;
-        double minPolygonAreaThreshold = !applyLodSettingInConfig ? minPolygonAreaThresholdGeneral : 2500.0;
+        if (indexP1 >= caoNbrPoint || indexP2 >= caoNbrPoint || indexP3 >= caoNbrPoint) {
+          throw vpException(vpException::badValue, "Exceed the max number of points.");
+        }
+
+        vpMbtCompiledModel::vpPrimitive circle;
+        circle.type = vpMbtCompiledModel::CIRCLE;
+        circle.indices.push_back(pointOffset + indexP1);
+        circle.indices.push_back(pointOffset + indexP2);
+        circle.indices.push_back(pointOffset + indexP3);
+        circle.radius = radius;
         if (mapOfParams.find("name") != mapOfParams.end()) {
-          polygonName = mapOfParams["name"];
+          circle.name = mapOfParams["name"];
         }
         if (mapOfParams.find("minPolygonAreaThreshold") != mapOfParams.end()) {
-          minPolygonAreaThreshold = std::atof(mapOfParams["minPolygonAreaThreshold"].c_str());
+          circle.hasThreshold = true;
+          circle.threshold = std::atof(mapOfParams["minPolygonAreaThreshold"].c_str());
         }
         if (mapOfParams.find("useLod") != mapOfParams.end()) {
-          useLod = parseBoolean(mapOfParams["useLod"]);
+          circle.hasUseLod = true;
+          circle.useLod = parseBoolean(mapOfParams["useLod"]);
         }
 
-        addPolygon(caoPoints[indexP1], caoPoints[indexP2], caoPoints[indexP3], radius, idFace, polygonName, useLod,
-                   minPolygonAreaThreshold);
-
-        initCircle(caoPoints[indexP1], caoPoints[indexP2], caoPoints[indexP3], radius, idFace, polygonName);
-
-        addProjectionErrorPolygon(caoPoints[indexP1], caoPoints[indexP2], caoPoints[indexP3], radius, idFace, polygonName, useLod,
-                                  minPolygonAreaThreshold);
-        initProjectionErrorCircle(caoPoints[indexP1], caoPoints[indexP2], caoPoints[indexP3], radius, idFace++, polygonName);
+        model.m_primitives.push_back(circle);
       }
 
     } catch (...) {
@@ -1834,27 +1904,22 @@ void vpMbTracker::loadCAOModel(const std::string &modelFile, std::vector<std::st
       caoNbCircle = 0;
     }
 
-    startIdFace = idFace;
-
-    delete[] caoPoints;
-    delete[] caoLinePoints;
-
     if (vectorOfModelFilename.size() > 1 && parent) {
       if (verbose) {
         std::cout << "Global information for " << vpIoTools::getName(modelFile) << " :" << std::endl;
-        std::cout << "Total nb of points : " << nbPoints << std::endl;
-        std::cout << "Total nb of lines : " << nbLines << std::endl;
-        std::cout << "Total nb of polygon lines : " << nbPolygonLines << std::endl;
-        std::cout << "Total nb of polygon points : " << nbPolygonPoints << std::endl;
-        std::cout << "Total nb of cylinders : " << nbCylinders << std::endl;
-        std::cout << "Total nb of circles : " << nbCircles << std::endl;
+        std::cout << "Total nb of points : " << model.getNbPoints() << std::endl;
+        std::cout << "Total nb of lines : " << model.m_nbLines << std::endl;
+        std::cout << "Total nb of polygon lines : " << model.m_nbPolygonLines << std::endl;
+        std::cout << "Total nb of polygon points : " << model.m_nbPolygonPoints << std::endl;
+        std::cout << "Total nb of cylinders : " << model.m_nbCylinders << std::endl;
+        std::cout << "Total nb of circles : " << model.m_nbCircles << std::endl;
       } else {
-        std::cout << "> " << nbPoints << " points" << std::endl;
-        std::cout << "> " << nbLines << " lines" << std::endl;
-        std::cout << "> " << nbPolygonLines << " polygon lines" << std::endl;
-        std::cout << "> " << nbPolygonPoints << " polygon points" << std::endl;
-        std::cout << "> " << nbCylinders << " cylinders" << std::endl;
-        std::cout << "> " << nbCircles << " circles" << std::endl;
+        std::cout << "> " << model.getNbPoints() << " points" << std::endl;
+        std::cout << "> " << model.m_nbLines << " lines" << std::endl;
+        std::cout << "> " << model.m_nbPolygonLines << " polygon lines" << std::endl;
+        std::cout << "> " << model.m_nbPolygonPoints << " polygon points" << std::endl;
+        std::cout << "> " << model.m_nbCylinders << " cylinders" << std::endl;
+        std::cout << "> " << model.m_nbCircles << " circles" << std::endl;
       }
     }
   } catch (...) {
@@ -1863,6 +1928,131 @@ void vpMbTracker::loadCAOModel(const std::string &modelFile, std::vector<std::st
   }
 }
 
+/*!
+  Add the primitives of a compiled CAO model to the tracker. The LOD settings
+  that are not given in the model file are the ones of the tracker.
+
+  \param model : Compiled model.
+  \param startIdFace : Current Id of the face, updated with the number of
+  faces that were added.
+  \param T : Transformation matrix applied to the 3D points of the model.
+*/
+void vpMbTracker::buildCAOModel(const vpMbtCompiledModel &model, int &startIdFace, const vpHomogeneousMatrix &T)
+{
+  const unsigned int caoNbrPoint = model.getNbPoints();
+  std::vector<vpPoint> caoPoints(caoNbrPoint);
+  for (unsigned int k = 0; k < caoNbrPoint; k++) {
+    vpColVector pt_3d(4, 1.0);
+    model.getPoint(k, pt_3d[0], pt_3d[1], pt_3d[2]);
+    vpColVector pt_3d_tf = T * pt_3d;
+    caoPoints[k].setWorldCoordinates(pt_3d_tf[0], pt_3d_tf[1], pt_3d_tf[2]);
+  }
+
+  const bool defaultUseLod = !applyLodSettingInConfig ? useLodGeneral : false;
+  const double defaultMinLineLengthThresh = !applyLodSettingInConfig ? minLineLengthThresholdGeneral : 50.0;
+  const double defaultMinPolygonAreaThresh = !applyLodSettingInConfig ? minPolygonAreaThresholdGeneral : 2500.0;
+
+  int idFace = startIdFace;
+  const std::vector<vpMbtCompiledModel::vpPrimitive> &primitives = model.getPrimitives();
+  for (size_t k = 0; k < primitives.size(); k++) {
+    const vpMbtCompiledModel::vpPrimitive &primitive = primitives[k];
+    const bool useLod = primitive.hasUseLod ? primitive.useLod : defaultUseLod;
+    const std::vector<unsigned int> &indices = primitive.indices;
+
+    switch (primitive.type) {
+    case vpMbtCompiledModel::FACE_FROM_LINES:
+    case vpMbtCompiledModel::FACE_FROM_POINTS: {
+      const double minPolygonAreaThreshold =
+          primitive.hasThreshold ? primitive.threshold : defaultMinPolygonAreaThresh;
+      std::vector<vpPoint> corners(indices.size());
+      for (size_t n = 0; n < indices.size(); n++) {
+        corners[n] = caoPoints[indices[n]];
+      }
+
+      addPolygon(corners, idFace, primitive.name, useLod, minPolygonAreaThreshold, minLineLengthThresholdGeneral);
+      // Init from the last polygon that was added
+      if (primitive.type == vpMbtCompiledModel::FACE_FROM_LINES) {
+        initFaceFromLines(*(faces.getPolygon().back()));
+      } else {
+        initFaceFromCorners(*(faces.getPolygon().back()));
+      }
+
+      addProjectionErrorPolygon(corners, idFace++, primitive.name, useLod, minPolygonAreaThreshold,
+                                minLineLengthThresholdGeneral);
+      if (primitive.type == vpMbtCompiledModel::FACE_FROM_LINES) {
+        initProjectionErrorFaceFromLines(*(m_projectionErrorFaces.getPolygon().back()));
+      } else {
+        initProjectionErrorFaceFromCorners(*(m_projectionErrorFaces.getPolygon().back()));
+      }
+      break;
+    }
+
+    case vpMbtCompiledModel::SEGMENT: {
+      const double minLineLengthThresh = primitive.hasThreshold ? primitive.threshold : defaultMinLineLengthThresh;
+      std::vector<vpPoint> extremities;
+      extremities.push_back(caoPoints[indices[0]]);
+      extremities.push_back(caoPoints[indices[1]]);
+
+      addPolygon(extremities, idFace, primitive.name, useLod, minPolygonAreaThresholdGeneral, minLineLengthThresh);
+      initFaceFromCorners(*(faces.getPolygon().back())); // Init from the last polygon that was added
+
+      addProjectionErrorPolygon(extremities, idFace++, primitive.name, useLod, minPolygonAreaThresholdGeneral,
+                                minLineLengthThresh);
+      initProjectionErrorFaceFromCorners(*(m_projectionErrorFaces.getPolygon().back()));
+      break;
+    }
+
+    case vpMbtCompiledModel::CYLINDER: {
+      const double minLineLengthThreshold = primitive.hasThreshold ? primitive.threshold : defaultMinLineLengthThresh;
+      const vpPoint &p1 = caoPoints[indices[0]];
+      const vpPoint &p2 = caoPoints[indices[1]];
+
+      int idRevolutionAxis = idFace;
+      addPolygon(p1, p2, idFace, primitive.name, useLod, minLineLengthThreshold);
+
+      addProjectionErrorPolygon(p1, p2, idFace++, primitive.name, useLod, minLineLengthThreshold);
+
+      std::vector<std::vector<vpPoint> > listFaces;
+      createCylinderBBox(p1, p2, primitive.radius, listFaces);
+      addPolygon(listFaces, idFace, primitive.name, useLod, minLineLengthThreshold);
+
+      initCylinder(p1, p2, primitive.radius, idRevolutionAxis, primitive.name);
+
+      addProjectionErrorPolygon(listFaces, idFace, primitive.name, useLod, minLineLengthThreshold);
+      initProjectionErrorCylinder(p1, p2, primitive.radius, idRevolutionAxis, primitive.name);
+
+      idFace += 4;
+      break;
+    }
+
+    case vpMbtCompiledModel::CIRCLE: {
+      const double minPolygonAreaThreshold =
+          primitive.hasThreshold ? primitive.threshold : defaultMinPolygonAreaThresh;
+      const vpPoint &p1 = caoPoints[indices[0]];
+      const vpPoint &p2 = caoPoints[indices[1]];
+      const vpPoint &p3 = caoPoints[indices[2]];
+
+      addPolygon(p1, p2, p3, primitive.radius, idFace, primitive.name, useLod, minPolygonAreaThreshold);
+
+      initCircle(p1, p2, p3, primitive.radius, idFace, primitive.name);
+
+      addProjectionErrorPolygon(p1, p2, p3, primitive.radius, idFace, primitive.name, useLod, minPolygonAreaThreshold);
+      initProjectionErrorCircle(p1, p2, p3, primitive.radius, idFace++, primitive.name);
+      break;
+    }
+    }
+  }
+
+  startIdFace = idFace;
+
+  nbPoints += caoNbrPoint;
+  nbLines += model.m_nbLines;
+  nbPolygonLines += model.m_nbPolygonLines;
+  nbPolygonPoints += model.m_nbPolygonPoints;
+  nbCylinders += model.m_nbCylinders;
+  nbCircles += model.m_nbCircles;
+}
+
 #ifdef VISP_HAVE_COIN3D
 /*!
   Extract a VRML object Group.
@@ -2563,6 +2753,64 @@ void vpMbTracker::computeVVSPoseEstimation(const bool isoJoIdentity_, const unsi
   }
 }
 
+/*!
+  Same as computeVVSPoseEstimation() but from the normal equations
+  \f$ \mathbf{L}^T \mathbf{L} \f$ and \f$ \mathbf{L}^T \mathbf{R} \f$
+  already accumulated by the features, the weighted interaction matrix
+  \f$ \mathbf{L} \f$ being never built.
+
+  \param isoJoIdentity_ : If false, the pose is estimated in the subspace
+  defined by oJo.
+  \param iter : Current iteration.
+  \param LTL : 6x6 matrix \f$ \mathbf{L}^T \mathbf{L} \f$ with the
+  weighted interaction matrix.
+  \param LTR : 6-dim vector \f$ \mathbf{L}^T \mathbf{R} \f$ with the
+  weighted residual.
+  \param error : Current residual, saved in \e error_prev with the
+  Levenberg-Marquardt method.
+  \param error_prev : Previous residual.
+  \param mu : Levenberg-Marquardt damping factor.
+  \param v : Estimated velocity.
+*/
+void vpMbTracker::computeVVSPoseEstimationNormalEquations(const bool isoJoIdentity_, const unsigned int iter,
+                                                          const vpMatrix &LTL, const vpColVector &LTR,
+                                                          const vpColVector &error, vpColVector &error_prev,
+                                                          double &mu, vpColVector &v)
+{
+  if (LTL.getRows() != 6 || LTL.getCols() != 6 || LTR.getRows() != 6) {
+    throw vpMatrixException(vpMatrixException::incorrectMatrixSizeError,
+                            "Incorrect normal equations size in computeVVSPoseEstimationNormalEquations.");
+  }
+
+  vpVelocityTwistMatrix cVo;
+  vpMatrix VJ;
+  vpMatrix A = LTL;
+  vpColVector b = LTR;
+  if (!isoJoIdentity_) {
+    // (L V J)^T (L V J) = (V J)^T L^T L (V J)
+    cVo.buildFrom(cMo);
+    VJ = cVo * oJo;
+    A = VJ.t() * LTL * VJ;
+    b = VJ.t() * LTR;
+  }
+
+  if (m_optimizationMethod == vpMbTracker::LEVENBERG_MARQUARDT_OPT) {
+    for (unsigned int i = 0; i < 6; i++)
+      A[i][i] += mu;
+  }
+
+  v = -m_lambda * A.pseudoInverse(A.getRows() * std::numeric_limits<double>::epsilon()) * b;
+  if (!isoJoIdentity_)
+    v = cVo * v;
+
+  if (m_optimizationMethod == vpMbTracker::LEVENBERG_MARQUARDT_OPT) {
+    if (iter != 0)
+      mu /= 10.0;
+
+    error_prev = error;
+  }
+}
+
 void vpMbTracker::computeVVSWeights(vpRobust &robust, const vpColVector &error, vpColVector &w)
 {
   if (error.getRows() > 0)
@@ -0,0 +1,428 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ * Description:
+ * Compiled CAO model that can be saved in a binary cache file.
+ *
+ *****************************************************************************/
+
+/*!
+ \file vpMbtCompiledModel.cpp
+ \brief Compiled CAO model that can be saved in a binary cache file.
+*/
+
+#include <cstring>
+#include <fstream>
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpMappedFile.h>
+#include <visp3/mbt/vpMbtCompiledModel.h>
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+/*
+  A compiled model file is made of:
+  - a header of 48 bytes: magic "VPMBTCAO", version (uint32), reserved
+    (uint32), number of source files, points and primitives, and the number
+    of lines, polygon lines, polygon points, cylinders and circles declared in
+    the files (uint32),
+  - for each source file: hash of its content (uint64), length of its name
+    (uint32) and its name,
+  - the coordinates of the points (double),
+  - for each primitive: type (uint32), flags (uint32, bit 0: useLod given,
+    bit 1: useLod, bit 2: threshold given), number of indices (uint32),
+    threshold and radius (double), length of the name (uint32) and the name,
+    then the indices (uint32).
+  All the fields are stored in little endian.
+*/
+const char fileMagic[] = "VPMBTCAO";
+const unsigned int fileVersion = 1;
+const unsigned int headerSize = 48;
+
+void putUInt32(std::vector<unsigned char> &buffer, uint32_t value)
+{
+  for (unsigned int i = 0; i < 4; i++)
+    buffer.push_back((unsigned char)(value >> (8 * i)));
+}
+
+void putUInt64(std::vector<unsigned char> &buffer, uint64_t value)
+{
+  for (unsigned int i = 0; i < 8; i++)
+    buffer.push_back((unsigned char)(value >> (8 * i)));
+}
+
+void putDouble(std::vector<unsigned char> &buffer, double value)
+{
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  putUInt64(buffer, bits);
+}
+
+void putString(std::vector<unsigned char> &buffer, const std::string &value)
+{
+  putUInt32(buffer, (uint32_t)value.size());
+  buffer.insert(buffer.end(), value.begin(), value.end());
+}
+
+// Number of indices needed by buildCAOModel() for each kind of primitive
+bool isValidNbIndices(const vpMbtCompiledModel::vpPrimitiveType type, const uint32_t nbIndices)
+{
+  switch (type) {
+  case vpMbtCompiledModel::FACE_FROM_LINES:
+    return nbIndices >= 2 && nbIndices % 2 == 0;
+  case vpMbtCompiledModel::FACE_FROM_POINTS:
+    return nbIndices >= 2;
+  case vpMbtCompiledModel::SEGMENT:
+  case vpMbtCompiledModel::CYLINDER:
+    return nbIndices == 2;
+  case vpMbtCompiledModel::CIRCLE:
+    return nbIndices == 3;
+  default:
+    return false;
+  }
+}
+
+// Sequential reading of a mapped file with bounds checking
+class vpByteReader
+{
+public:
+  vpByteReader(const unsigned char *data, size_t size, const std::string &filename)
+    : m_data(data), m_size(size), m_offset(0), m_filename(filename)
+  {
+  }
+
+  const unsigned char *get(size_t size)
+  {
+    if (size > m_size - m_offset) {
+      throw(vpException(vpException::ioError, "Compiled model %s is truncated", m_filename.c_str()));
+    }
+    const unsigned char *data = m_data + m_offset;
+    m_offset += size;
+    return data;
+  }
+
+  uint32_t getUInt32()
+  {
+    const unsigned char *data = get(4);
+    uint32_t value = 0;
+    for (unsigned int i = 0; i < 4; i++)
+      value |= (uint32_t)data[i] << (8 * i);
+    return value;
+  }
+
+  uint64_t getUInt64()
+  {
+    const unsigned char *data = get(8);
+    uint64_t value = 0;
+    for (unsigned int i = 0; i < 8; i++)
+      value |= (uint64_t)data[i] << (8 * i);
+    return value;
+  }
+
+  double getDouble()
+  {
+    uint64_t bits = getUInt64();
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+  std::string getString()
+  {
+    const uint32_t length = getUInt32();
+    const unsigned char *data = get(length);
+    return std::string((const char *)data, length);
+  }
+
+  size_t remaining() const { return m_size - m_offset; }
+
+private:
+  const unsigned char *m_data;
+  size_t m_size;
+  size_t m_offset;
+  std::string m_filename;
+};
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Default constructor of a primitive.
+*/
+vpMbtCompiledModel::vpPrimitive::vpPrimitive()
+  : type(FACE_FROM_POINTS), indices(), name(), hasUseLod(false), useLod(false), hasThreshold(false), threshold(0.),
+    radius(0.)
+{
+}
+
+/*!
+  Default constructor, the model is empty.
+*/
+vpMbtCompiledModel::vpMbtCompiledModel()
+  : m_points(), m_primitives(), m_sourceFiles(), m_sourceHashes(), m_nbLines(0), m_nbPolygonLines(0),
+    m_nbPolygonPoints(0), m_nbCylinders(0), m_nbCircles(0)
+{
+}
+
+/*!
+  Load the compiled model saved in \e filename. See load().
+*/
+vpMbtCompiledModel::vpMbtCompiledModel(const std::string &filename)
+  : m_points(), m_primitives(), m_sourceFiles(), m_sourceHashes(), m_nbLines(0), m_nbPolygonLines(0),
+    m_nbPolygonPoints(0), m_nbCylinders(0), m_nbCircles(0)
+{
+  load(filename);
+}
+
+/*!
+  Remove all the points, primitives and source files of the model.
+*/
+void vpMbtCompiledModel::clear()
+{
+  m_points.clear();
+  m_primitives.clear();
+  m_sourceFiles.clear();
+  m_sourceHashes.clear();
+  m_nbLines = 0;
+  m_nbPolygonLines = 0;
+  m_nbPolygonPoints = 0;
+  m_nbCylinders = 0;
+  m_nbCircles = 0;
+}
+
+/*!
+  Record a file read to compile the model with the hash of its content.
+*/
+void vpMbtCompiledModel::addSourceFile(const std::string &filename)
+{
+  m_sourceFiles.push_back(filename);
+  m_sourceHashes.push_back(computeFileHash(filename));
+}
+
+/*!
+  Compute the 64 bits FNV-1a hash of the content of a file.
+
+  \throw vpException::ioError if the file cannot be read.
+*/
+uint64_t vpMbtCompiledModel::computeFileHash(const std::string &filename)
+{
+  vpMappedFile file(filename);
+  const unsigned char *data = file.data();
+  // Constants written from 32 bits halves to stay valid without long long
+  // literals
+  const uint64_t prime = ((uint64_t)0x100 << 32) | 0x1b3;
+  uint64_t hash = ((uint64_t)0xcbf29ce4 << 32) | 0x84222325;
+  for (size_t i = 0; i < file.size(); i++) {
+    hash ^= data[i];
+    hash *= prime;
+  }
+  return hash;
+}
+
+/*!
+  Get the coordinates of a point in the frame of the CAO file.
+
+  \param index : Index of the point, from 0 to getNbPoints()-1.
+  \param X, Y, Z : Coordinates of the point.
+*/
+void vpMbtCompiledModel::getPoint(const unsigned int index, double &X, double &Y, double &Z) const
+{
+  if (index >= getNbPoints()) {
+    throw(vpException(vpException::dimensionError, "Point %u is out of the model", index));
+  }
+  X = m_points[3 * index];
+  Y = m_points[3 * index + 1];
+  Z = m_points[3 * index + 2];
+}
+
+/*!
+  Check that the CAO files used to compile the model exist and were not
+  modified since.
+*/
+bool vpMbtCompiledModel::isUpToDate() const
+{
+  if (m_sourceFiles.empty()) {
+    return false;
+  }
+  for (size_t i = 0; i < m_sourceFiles.size(); i++) {
+    if (!vpIoTools::checkFilename(m_sourceFiles[i])) {
+      return false;
+    }
+    try {
+      if (computeFileHash(m_sourceFiles[i]) != m_sourceHashes[i]) {
+        return false;
+      }
+    } catch (const vpException &) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*!
+  Load a model saved with save(). The file is mapped in memory and decoded
+  without parsing any text.
+
+  \throw vpException::ioError if the file cannot be read or is not a
+  compiled model.
+*/
+void vpMbtCompiledModel::load(const std::string &filename)
+{
+  clear();
+
+  vpMappedFile file(filename);
+  vpByteReader reader(file.data(), file.size(), filename);
+  if (file.size() < headerSize || memcmp(reader.get(8), fileMagic, 8) != 0) {
+    throw(vpException(vpException::ioError, "%s is not a compiled model", filename.c_str()));
+  }
+  const uint32_t version = reader.getUInt32();
+  if (version != fileVersion) {
+    throw(vpException(vpException::ioError, "Compiled model %s has the unsupported version %u", filename.c_str(),
+                      version));
+  }
+  reader.getUInt32();
+  const uint32_t nbSources = reader.getUInt32();
+  const uint32_t nbPoints = reader.getUInt32();
+  const uint32_t nbPrimitives = reader.getUInt32();
+  m_nbLines = reader.getUInt32();
+  m_nbPolygonLines = reader.getUInt32();
+  m_nbPolygonPoints = reader.getUInt32();
+  m_nbCylinders = reader.getUInt32();
+  m_nbCircles = reader.getUInt32();
+
+  // Check the sizes before allocating anything
+  if (nbSources > reader.remaining() / 12 || nbPoints > reader.remaining() / 24 ||
+      nbPrimitives > reader.remaining() / 32) {
+    clear();
+    throw(vpException(vpException::ioError, "Compiled model %s is truncated", filename.c_str()));
+  }
+
+  try {
+    for (uint32_t i = 0; i < nbSources; i++) {
+      m_sourceHashes.push_back(reader.getUInt64());
+      m_sourceFiles.push_back(reader.getString());
+    }
+
+    m_points.resize(3 * (size_t)nbPoints);
+    for (size_t i = 0; i < m_points.size(); i++) {
+      m_points[i] = reader.getDouble();
+    }
+
+    m_primitives.resize(nbPrimitives);
+    for (uint32_t i = 0; i < nbPrimitives; i++) {
+      vpPrimitive &primitive = m_primitives[i];
+      const uint32_t type = reader.getUInt32();
+      const uint32_t flags = reader.getUInt32();
+      const uint32_t nbIndices = reader.getUInt32();
+      if (type > CIRCLE || nbIndices > reader.remaining() / 4 ||
+          !isValidNbIndices((vpPrimitiveType)type, nbIndices)) {
+        throw(vpException(vpException::ioError, "Compiled model %s is corrupted", filename.c_str()));
+      }
+      primitive.type = (vpPrimitiveType)type;
+      primitive.hasUseLod = (flags & 1) != 0;
+      primitive.useLod = (flags & 2) != 0;
+      primitive.hasThreshold = (flags & 4) != 0;
+      primitive.threshold = reader.getDouble();
+      primitive.radius = reader.getDouble();
+      primitive.name = reader.getString();
+      primitive.indices.resize(nbIndices);
+      for (uint32_t j = 0; j < nbIndices; j++) {
+        primitive.indices[j] = reader.getUInt32();
+        if (primitive.indices[j] >= nbPoints) {
+          throw(vpException(vpException::ioError, "Compiled model %s is corrupted", filename.c_str()));
+        }
+      }
+    }
+  } catch (...) {
+    clear();
+    throw;
+  }
+}
+
+/*!
+  Save the model in a binary file that can be loaded with load().
+
+  \throw vpException::ioError if the file cannot be written.
+*/
+void vpMbtCompiledModel::save(const std::string &filename) const
+{
+  std::vector<unsigned char> buffer;
+  buffer.insert(buffer.end(), fileMagic, fileMagic + 8);
+  putUInt32(buffer, fileVersion);
+  putUInt32(buffer, 0);
+  putUInt32(buffer, (uint32_t)m_sourceFiles.size());
+  putUInt32(buffer, getNbPoints());
+  putUInt32(buffer, (uint32_t)m_primitives.size());
+  putUInt32(buffer, m_nbLines);
+  putUInt32(buffer, m_nbPolygonLines);
+  putUInt32(buffer, m_nbPolygonPoints);
+  putUInt32(buffer, m_nbCylinders);
+  putUInt32(buffer, m_nbCircles);
+
+  for (size_t i = 0; i < m_sourceFiles.size(); i++) {
+    putUInt64(buffer, m_sourceHashes[i]);
+    putString(buffer, m_sourceFiles[i]);
+  }
+
+  for (size_t i = 0; i < m_points.size(); i++) {
+    putDouble(buffer, m_points[i]);
+  }
+
+  for (size_t i = 0; i < m_primitives.size(); i++) {
+    const vpPrimitive &primitive = m_primitives[i];
+    putUInt32(buffer, (uint32_t)primitive.type);
+    putUInt32(buffer, (primitive.hasUseLod ? 1u : 0u) | (primitive.useLod ? 2u : 0u) |
+                          (primitive.hasThreshold ? 4u : 0u));
+    putUInt32(buffer, (uint32_t)primitive.indices.size());
+    putDouble(buffer, primitive.threshold);
+    putDouble(buffer, primitive.radius);
+    putString(buffer, primitive.name);
+    for (size_t j = 0; j < primitive.indices.size(); j++) {
+      putUInt32(buffer, primitive.indices[j]);
+    }
+  }
+
+  // Write in a temporary file renamed at the end, so that a tracker never
+  // maps a partially written model
+  const std::string tmpFilename = filename + ".tmp";
+  std::ofstream file(tmpFilename.c_str(), std::ios::out | std::ios::binary);
+  if (!file.is_open()) {
+    throw(vpException(vpException::ioError, "Cannot create the compiled model %s", filename.c_str()));
+  }
+  file.write((const char *)&buffer[0], (std::streamsize)buffer.size());
+  file.close();
+  if (!file.fail() && vpIoTools::checkFilename(filename)) {
+    vpIoTools::remove(filename);
+  }
+  if (file.fail() || !vpIoTools::rename(tmpFilename, filename)) {
+    vpIoTools::remove(tmpFilename);
+    throw(vpException(vpException::ioError, "Cannot write the compiled model %s", filename.c_str()));
+  }
+}
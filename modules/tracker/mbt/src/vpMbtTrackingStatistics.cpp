@@ -0,0 +1,189 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Timings and counters of a tracking iteration of the generic model-based
+ * tracker.
+ *
+ *****************************************************************************/
+
+/*!
+ \file vpMbtTrackingStatistics.cpp
+ \brief Timings and counters of a tracking iteration of the generic
+ model-based tracker.
+*/
+
+#include <iomanip>
+#include <sstream>
+
+#include <visp3/mbt/vpMbtTrackingStatistics.h>
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace
+{
+std::string escapeJson(const std::string &str)
+{
+  std::ostringstream oss;
+  for (size_t i = 0; i < str.size(); i++) {
+    const unsigned char c = (unsigned char)str[i];
+    if (c == '"' || c == '\\') {
+      oss << '\\' << str[i];
+    } else if (c < 0x20) {
+      oss << "\\u" << std::hex << std::setw(4) << std::setfill('0') << (unsigned int)c << std::dec
+          << std::setfill(' ');
+    } else {
+      oss << str[i];
+    }
+  }
+  return oss.str();
+}
+
+std::string escapeCsv(const std::string &str)
+{
+  if (str.find_first_of(",\"\r\n") == std::string::npos) {
+    return str;
+  }
+
+  std::string escaped = "\"";
+  for (size_t i = 0; i < str.size(); i++) {
+    if (str[i] == '"') {
+      escaped += '"';
+    }
+    escaped += str[i];
+  }
+  return escaped + "\"";
+}
+}
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
+/*!
+  Default constructor, all the timings and counters are set to 0.
+*/
+vpMbtTrackingStatistics::vpCameraStatistics::vpCameraStatistics()
+  : meTrackingTime(0), kltTrackingTime(0), depthNormalTime(0), depthDenseTime(0), kltReinitTime(0),
+    visibilityTime(0), meReinitTime(0), nbEdgeFeatures(0), nbKltFeatures(0), nbDepthNormalFeatures(0),
+    nbDepthDenseFeatures(0), nbEdgeRejected(0), nbKltRejected(0), nbDepthNormalRejected(0), nbDepthDenseRejected(0),
+    nbMeTracked(0), nbMeContrast(0), nbMeThreshold(0), nbMeMEstimator(0), nbMeTooNear(0)
+{
+}
+
+/*!
+  Set all the timings and counters to 0.
+*/
+void vpMbtTrackingStatistics::vpCameraStatistics::reset() { *this = vpCameraStatistics(); }
+
+/*!
+  Default constructor, all the timings and counters are set to 0.
+*/
+vpMbtTrackingStatistics::vpMbtTrackingStatistics()
+  : frame(0), totalTime(0), vvsTime(0), covarianceTime(0), projectionErrorTime(0), nbIterations(0), cameras()
+{
+}
+
+/*!
+  Return the names of the columns written by toCsv(), separated by commas.
+*/
+std::string vpMbtTrackingStatistics::getCsvHeader()
+{
+  return "frame,camera,total_ms,vvs_ms,covariance_ms,projection_error_ms,iterations,"
+         "me_tracking_ms,klt_tracking_ms,depth_normal_ms,depth_dense_ms,klt_reinit_ms,visibility_ms,me_reinit_ms,"
+         "edge_features,klt_features,depth_normal_features,depth_dense_features,"
+         "edge_rejected,klt_rejected,depth_normal_rejected,depth_dense_rejected,"
+         "me_tracked,me_contrast,me_threshold,me_m_estimator,me_too_near";
+}
+
+/*!
+  Set all the timings and counters to 0 and remove the statistics of the
+  cameras. The frame index is kept.
+*/
+void vpMbtTrackingStatistics::reset()
+{
+  totalTime = 0;
+  vvsTime = 0;
+  covarianceTime = 0;
+  projectionErrorTime = 0;
+  nbIterations = 0;
+  cameras.clear();
+}
+
+/*!
+  Return the statistics in the CSV format, one line per camera terminated by
+  a new line character. The global timings and counters are repeated on each
+  line. The columns are given by getCsvHeader().
+*/
+std::string vpMbtTrackingStatistics::toCsv() const
+{
+  std::ostringstream oss;
+  oss << std::fixed << std::setprecision(4);
+  for (std::map<std::string, vpCameraStatistics>::const_iterator it = cameras.begin(); it != cameras.end(); ++it) {
+    const vpCameraStatistics &c = it->second;
+    oss << frame << "," << escapeCsv(it->first) << "," << totalTime << "," << vvsTime << "," << covarianceTime << ","
+        << projectionErrorTime << "," << nbIterations << "," << c.meTrackingTime << "," << c.kltTrackingTime << ","
+        << c.depthNormalTime << "," << c.depthDenseTime << "," << c.kltReinitTime << "," << c.visibilityTime << ","
+        << c.meReinitTime << "," << c.nbEdgeFeatures << "," << c.nbKltFeatures << "," << c.nbDepthNormalFeatures << ","
+        << c.nbDepthDenseFeatures << "," << c.nbEdgeRejected << "," << c.nbKltRejected << ","
+        << c.nbDepthNormalRejected << "," << c.nbDepthDenseRejected << "," << c.nbMeTracked << "," << c.nbMeContrast
+        << "," << c.nbMeThreshold << "," << c.nbMeMEstimator << "," << c.nbMeTooNear << "\n";
+  }
+  return oss.str();
+}
+
+/*!
+  Return the statistics as a JSON object. The statistics of the cameras are
+  given in the "cameras" object, with the camera names as keys. The keys of
+  the durations end with "_ms".
+*/
+std::string vpMbtTrackingStatistics::toJson() const
+{
+  std::ostringstream oss;
+  oss << std::fixed << std::setprecision(4);
+  oss << "{\"frame\": " << frame << ", \"total_ms\": " << totalTime << ", \"vvs_ms\": " << vvsTime
+      << ", \"covariance_ms\": " << covarianceTime << ", \"projection_error_ms\": " << projectionErrorTime
+      << ", \"iterations\": " << nbIterations << ", \"cameras\": {";
+  for (std::map<std::string, vpCameraStatistics>::const_iterator it = cameras.begin(); it != cameras.end(); ++it) {
+    const vpCameraStatistics &c = it->second;
+    if (it != cameras.begin()) {
+      oss << ", ";
+    }
+    oss << "\"" << escapeJson(it->first) << "\": {"
+        << "\"me_tracking_ms\": " << c.meTrackingTime << ", \"klt_tracking_ms\": " << c.kltTrackingTime
+        << ", \"depth_normal_ms\": " << c.depthNormalTime << ", \"depth_dense_ms\": " << c.depthDenseTime
+        << ", \"klt_reinit_ms\": " << c.kltReinitTime << ", \"visibility_ms\": " << c.visibilityTime
+        << ", \"me_reinit_ms\": " << c.meReinitTime << ", \"features\": {\"edge\": " << c.nbEdgeFeatures
+        << ", \"klt\": " << c.nbKltFeatures << ", \"depth_normal\": " << c.nbDepthNormalFeatures
+        << ", \"depth_dense\": " << c.nbDepthDenseFeatures << "}, \"rejected\": {\"edge\": " << c.nbEdgeRejected
+        << ", \"klt\": " << c.nbKltRejected << ", \"depth_normal\": " << c.nbDepthNormalRejected
+        << ", \"depth_dense\": " << c.nbDepthDenseRejected << "}, \"me_sites\": {\"tracked\": " << c.nbMeTracked
+        << ", \"contrast\": " << c.nbMeContrast << ", \"threshold\": " << c.nbMeThreshold
+        << ", \"m_estimator\": " << c.nbMeMEstimator << ", \"too_near\": " << c.nbMeTooNear << "}}";
+  }
+  oss << "}}";
+  return oss.str();
+}
@@ -0,0 +1,139 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the multi-threaded moving edges tracking of the model-based tracker.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testGenericTrackerThreads.cpp
+
+  Track a synthetic box with the edge tracker using one and several threads
+  and check that the estimated poses are the same.
+*/
+
+#include <cmath>
+#include <iostream>
+
+#include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/mbt/vpMbGenericTracker.h>
+
+#include "testMbSyntheticBox.h"
+
+int main()
+{
+  try {
+    std::string username;
+    vpIoTools::getUserName(username);
+#if defined(_WIN32)
+    std::string opath = "C:/temp/" + username;
+#else
+    std::string opath = "/tmp/" + username;
+#endif
+    if (!vpIoTools::checkDirectory(opath))
+      vpIoTools::makeDirectory(opath);
+    std::string model = vpIoTools::createFilePath(opath, "testGenericTrackerThreads.cao");
+    writeModel(model);
+
+    vpCameraParameters cam(600, 600, 320, 240);
+    vpMe me;
+    me.setMaskSize(5);
+    me.setMaskNumber(180);
+    me.setRange(8);
+    me.setThreshold(2000);
+    me.setMu1(0.5);
+    me.setMu2(0.5);
+    me.setSampleStep(4);
+
+    const unsigned int nbFrames = 10;
+    std::vector<vpHomogeneousMatrix> cMo_truth;
+    for (unsigned int k = 0; k < nbFrames; k++) {
+      cMo_truth.push_back(vpHomogeneousMatrix(-0.08 + 0.001 * k, -0.03, 0.4 + 0.0015 * k, vpMath::rad(-30 + 0.5 * k),
+                                              vpMath::rad(30 - 0.25 * k), vpMath::rad(10)));
+    }
+
+    const unsigned int nbThreads[2] = {1, 4};
+    std::vector<vpHomogeneousMatrix> cMo_est[2];
+    std::vector<unsigned int> nbPoints[2];
+    for (unsigned int t = 0; t < 2; t++) {
+      vpMbGenericTracker tracker(vpMbGenericTracker::EDGE_TRACKER);
+      tracker.setCameraParameters(cam);
+      tracker.setMovingEdge(me);
+      tracker.setNbThreads(nbThreads[t]);
+      tracker.loadModel(model);
+
+      vpImage<unsigned char> I(480, 640);
+      for (unsigned int k = 0; k < nbFrames; k++) {
+        render(cMo_truth[k], cam, I);
+        if (k == 0) {
+          // Start from a slightly wrong pose
+          tracker.initFromPose(I, vpHomogeneousMatrix(0.002, -0.001, 0.003, vpMath::rad(0.5), 0, vpMath::rad(-0.5)) *
+                                      cMo_truth[0]);
+        }
+        tracker.track(I);
+        cMo_est[t].push_back(tracker.getPose());
+        nbPoints[t].push_back(tracker.getNbPoints());
+      }
+    }
+
+    for (unsigned int k = 0; k < nbFrames; k++) {
+      std::cout << "Frame " << k << ": " << nbPoints[0][k] << " moving edges" << std::endl;
+      if (nbPoints[0][k] != nbPoints[1][k]) {
+        std::cerr << "Different number of moving edges: " << nbPoints[0][k] << " with 1 thread, " << nbPoints[1][k]
+                  << " with " << nbThreads[1] << " threads" << std::endl;
+        return EXIT_FAILURE;
+      }
+      // Two instances of the tracker may differ by rounding errors
+      for (unsigned int i = 0; i < 16; i++) {
+        if (std::fabs(cMo_est[0][k].data[i] - cMo_est[1][k].data[i]) > 1e-12) {
+          std::cerr << "Different poses with 1 and " << nbThreads[1] << " threads:\n"
+                    << cMo_est[0][k] << "\n"
+                    << cMo_est[1][k] << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+
+    vpTranslationVector error = cMo_est[0].back().getTranslationVector() - cMo_truth.back().getTranslationVector();
+    std::cout << "Final translation error: " << error.euclideanNorm() << " m" << std::endl;
+    if (error.euclideanNorm() > 0.02) {
+      std::cerr << "The tracker did not converge" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::cout << "Test succeed" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const vpException &e) {
+    std::cout << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,346 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ * Description:
+ * Test the compiled CAO models and their cache.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testMbCompiledModel.cpp
+
+  Compile a CAO model that includes an other one, and check that the trackers
+  built from the compiled model, from its binary cache or from a corrupted or
+  outdated cache are the same as the ones built by parsing the file.
+*/
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+#include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/mbt/vpMbEdgeTracker.h>
+#include <visp3/mbt/vpMbGenericTracker.h>
+
+namespace
+{
+void writeModel(const std::string &filename, const std::string &includedName)
+{
+  std::ofstream file(filename.c_str());
+  file << "V1\n"
+       << "load(\"" << includedName << "\")\n"
+       << "# Points\n10\n"
+       << "0 0 0\n0.1 0 0\n0.1 0.1 0\n0 0.1 0\n0 0 0.1\n0.1 0 0.1\n"
+       << "0.05 0.05 0.2\n0.05 0.05 0.3\n0.02 0.05 0.3\n0.05 0.02 0.3\n"
+       << "# Lines\n5\n"
+       << "0 1 name=\"bottom\" useLod=true minLineLengthThreshold=20\n"
+       << "1 2\n2 3\n3 0\n"
+       << "4 5 name=\"edge\" minLineLengthThreshold=30\n"
+       << "# Faces from lines\n1\n"
+       << "4 0 1 2 3 name=\"base\" minPolygonAreaThreshold=100\n"
+       << "# Faces from points\n1\n"
+       << "4 0 1 5 4 name=\"front\" useLod=true\n"
+       << "# Cylinders\n1\n"
+       << "6 7 0.02 name=\"cylinder\" useLod=true minLineLengthThreshold=10\n"
+       << "# Circles\n1\n"
+       << "0.03 7 8 9 name=\"circle\"\n";
+}
+
+void writeIncludedModel(const std::string &filename, const std::string &faceName)
+{
+  std::ofstream file(filename.c_str());
+  file << "V1\n4\n"
+       << "0.2 0 0\n0.3 0 0\n0.3 0.1 0\n0.2 0.1 0\n"
+       << "0\n0\n1\n"
+       << "4 0 1 2 3 name=\"" << faceName << "\"\n"
+       << "0\n0\n";
+}
+
+bool compareFaces(vpMbHiddenFaces<vpMbtPolygon> &faces1, vpMbHiddenFaces<vpMbtPolygon> &faces2)
+{
+  if (faces1.size() != faces2.size()) {
+    std::cerr << "Different number of faces: " << faces1.size() << " and " << faces2.size() << std::endl;
+    return false;
+  }
+  for (unsigned int i = 0; i < faces1.size(); i++) {
+    vpMbtPolygon &p1 = *faces1[i];
+    vpMbtPolygon &p2 = *faces2[i];
+    if (p1.getIndex() != p2.getIndex() || p1.getName() != p2.getName() || p1.getNbPoint() != p2.getNbPoint() ||
+        p1.useLod != p2.useLod || !vpMath::equal(p1.minLineLengthThresh, p2.minLineLengthThresh) ||
+        !vpMath::equal(p1.minPolygonAreaThresh, p2.minPolygonAreaThresh)) {
+      std::cerr << "Face " << i << " is different" << std::endl;
+      return false;
+    }
+    for (unsigned int j = 0; j < p1.getNbPoint(); j++) {
+      const vpPoint &P1 = p1.getPoint(j);
+      const vpPoint &P2 = p2.getPoint(j);
+      if (!vpMath::equal(P1.get_oX(), P2.get_oX()) || !vpMath::equal(P1.get_oY(), P2.get_oY()) ||
+          !vpMath::equal(P1.get_oZ(), P2.get_oZ())) {
+        std::cerr << "Point " << j << " of face " << i << " is different" << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool compareTrackers(vpMbEdgeTracker &tracker1, vpMbEdgeTracker &tracker2)
+{
+  std::list<vpMbtDistanceLine *> lines1, lines2;
+  std::list<vpMbtDistanceCylinder *> cylinders1, cylinders2;
+  std::list<vpMbtDistanceCircle *> circles1, circles2;
+  tracker1.getLline(lines1);
+  tracker2.getLline(lines2);
+  tracker1.getLcylinder(cylinders1);
+  tracker2.getLcylinder(cylinders2);
+  tracker1.getLcircle(circles1);
+  tracker2.getLcircle(circles2);
+  if (lines1.size() != lines2.size() || cylinders1.size() != cylinders2.size() || circles1.size() != circles2.size()) {
+    std::cerr << "Different number of lines, cylinders or circles" << std::endl;
+    return false;
+  }
+  return compareFaces(tracker1.getFaces(), tracker2.getFaces());
+}
+
+uint32_t readUInt32(const std::vector<char> &data, const size_t offset)
+{
+  uint32_t value = 0;
+  for (unsigned int i = 0; i < 4; i++)
+    value |= (uint32_t)(unsigned char)data[offset + i] << (8 * i);
+  return value;
+}
+
+// Change the first segment of a compiled model into a circle, which needs
+// one more index
+bool corruptSegment(const std::string &filename)
+{
+  std::ifstream in(filename.c_str(), std::ios::binary);
+  std::vector<char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  in.close();
+
+  // See the layout of the file in vpMbtCompiledModel.cpp
+  const uint32_t nbSources = readUInt32(data, 16);
+  const uint32_t nbPoints = readUInt32(data, 20);
+  const uint32_t nbPrimitives = readUInt32(data, 24);
+  size_t offset = 48;
+  for (uint32_t i = 0; i < nbSources; i++)
+    offset += 12 + readUInt32(data, offset + 8);
+  offset += 24 * (size_t)nbPoints;
+  for (uint32_t i = 0; i < nbPrimitives; i++) {
+    if (readUInt32(data, offset) == (uint32_t)vpMbtCompiledModel::SEGMENT) {
+      data[offset] = (char)vpMbtCompiledModel::CIRCLE;
+      std::ofstream out(filename.c_str(), std::ios::binary);
+      out.write(&data[0], (std::streamsize)data.size());
+      return true;
+    }
+    const uint32_t nbIndices = readUInt32(data, offset + 8);
+    const uint32_t nameLength = readUInt32(data, offset + 28);
+    offset += 32 + nameLength + 4 * (size_t)nbIndices;
+  }
+  return false;
+}
+}
+
+int main()
+{
+  try {
+    std::string username;
+    vpIoTools::getUserName(username);
+#if defined(_WIN32)
+    std::string opath = "C:/temp/" + username;
+#else
+    std::string opath = "/tmp/" + username;
+#endif
+    if (!vpIoTools::checkDirectory(opath))
+      vpIoTools::makeDirectory(opath);
+    const std::string cacheDirectory = vpIoTools::createFilePath(opath, "testMbCompiledModel_cache");
+    if (vpIoTools::checkDirectory(cacheDirectory))
+      vpIoTools::remove(cacheDirectory);
+    vpIoTools::makeDirectory(cacheDirectory);
+
+    const std::string model = vpIoTools::createFilePath(opath, "testMbCompiledModel.cao");
+    const std::string includedModel = vpIoTools::createFilePath(opath, "testMbCompiledModel_included.cao");
+    writeModel(model, "testMbCompiledModel_included.cao");
+    writeIncludedModel(includedModel, "included");
+
+    // Reference tracker that parses the model
+    vpMbEdgeTracker reference;
+    reference.loadModel(model);
+    // 1 included face, 1 face from lines, 1 line out of the faces, 1 face
+    // from points, 1 cylinder with its 4 faces and 1 circle
+    if (reference.getNbPolygon() != 10) {
+      std::cerr << "Unexpected number of faces: " << reference.getNbPolygon() << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::cout << "** Compile the model in the cache" << std::endl;
+    {
+      vpMbEdgeTracker tracker;
+      tracker.setModelCacheDirectory(cacheDirectory);
+      tracker.loadModel(model);
+      if (!compareTrackers(reference, tracker))
+        return EXIT_FAILURE;
+    }
+    std::vector<std::string> cacheFiles = vpIoTools::getDirFiles(cacheDirectory);
+    if (cacheFiles.size() != 1) {
+      std::cerr << "The compiled model was not saved in the cache" << std::endl;
+      return EXIT_FAILURE;
+    }
+    const std::string cacheFile = vpIoTools::createFilePath(cacheDirectory, cacheFiles[0]);
+    {
+      vpMbtCompiledModel compiled(cacheFile);
+      if (!compiled.isUpToDate() || compiled.getSourceFiles().size() != 2 || compiled.getNbPoints() != 14 ||
+          compiled.getPrimitives().size() != 6) {
+        std::cerr << "Unexpected content of the compiled model" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    std::cout << "** Load the model from the cache for two cameras" << std::endl;
+    {
+      vpMbGenericTracker tracker(2, vpMbGenericTracker::EDGE_TRACKER);
+      tracker.setModelCacheDirectory(cacheDirectory);
+      tracker.loadModel(model);
+      if (!compareFaces(reference.getFaces(), tracker.getFaces("Camera1")) ||
+          !compareFaces(reference.getFaces(), tracker.getFaces("Camera2")))
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "** Share a compiled model with a transformation and LOD settings" << std::endl;
+    {
+      const vpHomogeneousMatrix T(0.1, -0.2, 0.3, vpMath::rad(10), vpMath::rad(-20), vpMath::rad(30));
+      vpMbEdgeTracker parsed;
+      parsed.setLod(true);
+      parsed.setMinLineLengthThresh(15);
+      parsed.loadModel(model, false, T);
+
+      vpMbEdgeTracker compiler;
+      vpMbtCompiledModel compiled;
+      compiler.compileModel(model, compiled);
+      vpMbEdgeTracker tracker1, tracker2;
+      tracker1.setLod(true);
+      tracker1.setMinLineLengthThresh(15);
+      tracker1.loadCompiledModel(compiled, T);
+      tracker2.setLod(true);
+      tracker2.setMinLineLengthThresh(15);
+      tracker2.loadCompiledModel(compiled, T);
+      if (!compareTrackers(parsed, tracker1) || !compareTrackers(parsed, tracker2))
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "** Modify the included model" << std::endl;
+    writeIncludedModel(includedModel, "modified");
+    {
+      vpMbtCompiledModel compiled(cacheFile);
+      if (compiled.isUpToDate()) {
+        std::cerr << "The modification of the included model was not detected" << std::endl;
+        return EXIT_FAILURE;
+      }
+      vpMbEdgeTracker parsed;
+      parsed.loadModel(model);
+      vpMbEdgeTracker tracker;
+      tracker.setModelCacheDirectory(cacheDirectory);
+      tracker.loadModel(model);
+      if (parsed.getFaces()[0]->getName() != "modified" || !compareTrackers(parsed, tracker))
+        return EXIT_FAILURE;
+      compiled.load(cacheFile);
+      if (!compiled.isUpToDate()) {
+        std::cerr << "The cache was not updated" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    writeIncludedModel(includedModel, "included");
+
+    std::cout << "** Load a truncated cache" << std::endl;
+    {
+      vpMbEdgeTracker tracker;
+      tracker.setModelCacheDirectory(cacheDirectory);
+      tracker.loadModel(model);
+
+      std::ifstream in(cacheFile.c_str(), std::ios::binary);
+      std::vector<char> data(100);
+      in.read(&data[0], (std::streamsize)data.size());
+      in.close();
+      std::ofstream out(cacheFile.c_str(), std::ios::binary);
+      out.write(&data[0], (std::streamsize)data.size());
+      out.close();
+
+      bool thrown = false;
+      try {
+        vpMbtCompiledModel compiled(cacheFile);
+      } catch (const vpException &) {
+        thrown = true;
+      }
+      if (!thrown) {
+        std::cerr << "The truncated model was loaded" << std::endl;
+        return EXIT_FAILURE;
+      }
+
+      vpMbEdgeTracker tracker2;
+      tracker2.setModelCacheDirectory(cacheDirectory);
+      tracker2.loadModel(model);
+      if (!compareTrackers(reference, tracker) || !compareTrackers(reference, tracker2))
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "** Load a cache with a bad number of indices" << std::endl;
+    {
+      if (!corruptSegment(cacheFile)) {
+        std::cerr << "No segment in the compiled model" << std::endl;
+        return EXIT_FAILURE;
+      }
+
+      bool thrown = false;
+      try {
+        vpMbtCompiledModel compiled(cacheFile);
+      } catch (const vpException &) {
+        thrown = true;
+      }
+      if (!thrown) {
+        std::cerr << "The corrupted model was loaded" << std::endl;
+        return EXIT_FAILURE;
+      }
+
+      vpMbEdgeTracker tracker;
+      tracker.setModelCacheDirectory(cacheDirectory);
+      tracker.loadModel(model);
+      if (!compareTrackers(reference, tracker))
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Test succeed" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const vpException &e) {
+    std::cout << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,200 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the accumulation of the normal equations in the dense depth tracker.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testMbDepthDenseNormalEquations.cpp
+
+  Track a synthetic point cloud with the dense depth tracker by stacking the
+  interaction matrix and by accumulating the normal equations, and check that
+  the estimated poses are the same.
+*/
+
+#include <cmath>
+#include <iostream>
+
+#include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpPixelMeterConversion.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/mbt/vpMbDepthDenseTracker.h>
+
+#include "testMbSyntheticBox.h"
+
+namespace
+{
+// Ray cast the first nbFaces faces of the box, with some noise and a few
+// outliers
+void renderPointCloud(const vpHomogeneousMatrix &cMo, const vpCameraParameters &cam, unsigned int nbFaces,
+                      unsigned int width, unsigned int height, vpUniRand &rng, std::vector<vpColVector> &point_cloud)
+{
+  point_cloud.assign(width * height, vpColVector(3, 0.));
+
+  for (unsigned int f = 0; f < nbFaces; f++) {
+    double c[4][3];
+    for (unsigned int k = 0; k < 4; k++) {
+      const double *X = box[faces[f][k]];
+      for (unsigned int r = 0; r < 3; r++)
+        c[k][r] = cMo[r][0] * X[0] + cMo[r][1] * X[1] + cMo[r][2] * X[2] + cMo[r][3];
+    }
+    double u[3], v[3], n[3];
+    for (unsigned int r = 0; r < 3; r++) {
+      u[r] = c[1][r] - c[0][r];
+      v[r] = c[3][r] - c[0][r];
+    }
+    n[0] = u[1] * v[2] - u[2] * v[1];
+    n[1] = u[2] * v[0] - u[0] * v[2];
+    n[2] = u[0] * v[1] - u[1] * v[0];
+    const double d = n[0] * c[0][0] + n[1] * c[0][1] + n[2] * c[0][2];
+
+    for (unsigned int i = 0; i < height; i++) {
+      for (unsigned int j = 0; j < width; j++) {
+        double x = 0, y = 0;
+        vpPixelMeterConversion::convertPoint(cam, (double)j, (double)i, x, y);
+        const double den = n[0] * x + n[1] * y + n[2];
+        if (std::fabs(den) < 1e-12)
+          continue;
+        const double Z = d / den;
+        // Coordinates of the intersection in the (u, v) basis of the face
+        const double P[3] = {x * Z - c[0][0], y * Z - c[0][1], Z - c[0][2]};
+        const double a = (P[0] * u[0] + P[1] * u[1] + P[2] * u[2]) / (u[0] * u[0] + u[1] * u[1] + u[2] * u[2]);
+        const double b = (P[0] * v[0] + P[1] * v[1] + P[2] * v[2]) / (v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+        vpColVector &pt = point_cloud[i * width + j];
+        if (Z > 0 && a >= 0 && a <= 1 && b >= 0 && b <= 1 && (pt[2] == 0 || Z < pt[2])) {
+          pt[0] = x * Z;
+          pt[1] = y * Z;
+          pt[2] = Z;
+        }
+      }
+    }
+  }
+
+  for (size_t k = 0; k < point_cloud.size(); k++) {
+    if (point_cloud[k][2] > 0) {
+      const double scale = rng() < 0.02 ? 1.05 : 1 + 0.004 * (rng() - 0.5);
+      point_cloud[k] *= scale;
+    }
+  }
+}
+
+bool test(const std::string &model, unsigned int nbFaces, const vpHomogeneousMatrix &cMo_truth, double threshold)
+{
+  const unsigned int width = 320, height = 240;
+  vpCameraParameters cam(300, 300, 160, 120);
+  vpImage<unsigned char> I(height, width);
+  const vpHomogeneousMatrix cMo_init =
+      vpHomogeneousMatrix(0.003, -0.002, 0.004, vpMath::rad(1), vpMath::rad(-1), vpMath::rad(0.5)) * cMo_truth;
+
+  // vpUniRand has a global state: render the point clouds only once
+  vpUniRand rng(42);
+  std::vector<std::vector<vpColVector> > point_clouds(3);
+  for (size_t k = 0; k < point_clouds.size(); k++)
+    renderPointCloud(cMo_truth, cam, nbFaces, width, height, rng, point_clouds[k]);
+
+  vpHomogeneousMatrix cMo[2];
+  for (unsigned int t = 0; t < 2; t++) {
+    vpMbDepthDenseTracker tracker;
+    tracker.setCameraParameters(cam);
+    tracker.setDepthDenseSamplingStep(1, 1);
+    tracker.setDepthDenseNormalEquations(t == 1);
+    tracker.loadModel(model);
+    tracker.initFromPose(I, cMo_init);
+
+    for (size_t k = 0; k < point_clouds.size(); k++)
+      tracker.track(point_clouds[k], width, height);
+    cMo[t] = tracker.getPose();
+
+    if (t == 1 && tracker.getError().getRows() == 0) {
+      std::cerr << "No residual with the accumulated normal equations" << std::endl;
+      return false;
+    }
+  }
+
+  for (unsigned int i = 0; i < 16; i++) {
+    if (std::fabs(cMo[0].data[i] - cMo[1].data[i]) > 1e-9) {
+      std::cerr << "Different poses with the stacked interaction matrix and the normal equations:\n"
+                << cMo[0] << "\n"
+                << cMo[1] << std::endl;
+      return false;
+    }
+  }
+
+  vpTranslationVector error = cMo[1].getTranslationVector() - cMo_truth.getTranslationVector();
+  std::cout << "Translation error: " << error.euclideanNorm() << " m" << std::endl;
+  if (error.euclideanNorm() > threshold) {
+    std::cerr << "The tracker did not converge" << std::endl;
+    return false;
+  }
+
+  return true;
+}
+}
+
+int main()
+{
+  try {
+    std::string username;
+    vpIoTools::getUserName(username);
+#if defined(_WIN32)
+    std::string opath = "C:/temp/" + username;
+#else
+    std::string opath = "/tmp/" + username;
+#endif
+    if (!vpIoTools::checkDirectory(opath))
+      vpIoTools::makeDirectory(opath);
+
+    std::cout << "** Test with a box" << std::endl;
+    std::string model = vpIoTools::createFilePath(opath, "testMbDepthDenseNormalEquations_box.cao");
+    writeModel(model, 6);
+    if (!test(model, 6, vpHomogeneousMatrix(-0.08, -0.03, 0.5, vpMath::rad(-30), vpMath::rad(30), vpMath::rad(10)),
+              0.005)) {
+      return EXIT_FAILURE;
+    }
+
+    // A single plane only constrains 3 dof, the others are removed from the
+    // estimation
+    std::cout << "** Test with a plane" << std::endl;
+    model = vpIoTools::createFilePath(opath, "testMbDepthDenseNormalEquations_plane.cao");
+    writeModel(model, 1);
+    if (!test(model, 1, vpHomogeneousMatrix(-0.08, -0.03, 0.5, vpMath::rad(100), vpMath::rad(10), 0), 0.02)) {
+      return EXIT_FAILURE;
+    }
+
+    std::cout << "Test succeed" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const vpException &e) {
+    std::cout << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+}
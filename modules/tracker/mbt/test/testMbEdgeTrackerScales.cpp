@@ -0,0 +1,278 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the multi-scale tracking of the model-based edge tracker.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testMbEdgeTrackerScales.cpp
+
+  Test the pyramid and the scale scheduling of the edge tracker on a
+  synthetic box, with one camera and with two cameras.
+*/
+
+#include <algorithm>
+#include <iostream>
+
+#include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/mbt/vpMbEdgeMultiTracker.h>
+#include <visp3/mbt/vpMbEdgeTracker.h>
+
+#include "testMbSyntheticBox.h"
+
+namespace
+{
+class vpMbEdgeTrackerTest : public vpMbEdgeTracker
+{
+public:
+  using vpMbEdgeTracker::cleanPyramid;
+  using vpMbEdgeTracker::initPyramid;
+};
+
+bool testPyramid()
+{
+  vpImage<unsigned char> I(483, 645);
+  for (unsigned int i = 0; i < I.getHeight(); i++)
+    for (unsigned int j = 0; j < I.getWidth(); j++)
+      I[i][j] = (unsigned char)((i * 31 + j * 17 + (i * j) % 7) % 256);
+
+  vpMbEdgeTrackerTest tracker;
+  std::vector<bool> scales(4, true);
+  scales[2] = false;
+  tracker.setScales(scales);
+
+  std::vector<const vpImage<unsigned char> *> pyramid, pyramid2;
+  tracker.initPyramid(I, pyramid);
+  for (unsigned int l = 0; l < scales.size(); l++) {
+    if (!scales[l]) {
+      if (pyramid[l] != NULL)
+        return false;
+      continue;
+    }
+    const unsigned int ratio = 1u << l;
+    const vpImage<unsigned char> &Il = *pyramid[l];
+    if (Il.getHeight() != I.getHeight() / ratio || Il.getWidth() != I.getWidth() / ratio) {
+      std::cerr << "Bad size of the pyramid level " << l << std::endl;
+      return false;
+    }
+    for (unsigned int i = 0; i < Il.getHeight(); i++) {
+      for (unsigned int j = 0; j < Il.getWidth(); j++) {
+        if (Il[i][j] != I[i * ratio][j * ratio]) {
+          std::cerr << "Bad pixel (" << i << ", " << j << ") in the pyramid level " << l << std::endl;
+          return false;
+        }
+      }
+    }
+  }
+
+  // The images of the levels are reused
+  tracker.cleanPyramid(pyramid);
+  tracker.initPyramid(I, pyramid2);
+  tracker.initPyramid(I, pyramid);
+  for (unsigned int l = 1; l < scales.size(); l++) {
+    if (pyramid[l] != pyramid2[l] || (scales[l] && pyramid[l]->bitmap == NULL)) {
+      std::cerr << "The pyramid level " << l << " is not reused" << std::endl;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool isSubsampled(const vpImage<unsigned char> &I, const vpImage<unsigned char> *Il, const unsigned int ratio)
+{
+  if (Il == NULL || Il->getHeight() != I.getHeight() / ratio || Il->getWidth() != I.getWidth() / ratio)
+    return false;
+  for (unsigned int i = 0; i < Il->getHeight(); i++)
+    for (unsigned int j = 0; j < Il->getWidth(); j++)
+      if ((*Il)[i][j] != I[i * ratio][j * ratio])
+        return false;
+  return true;
+}
+
+#if defined(VISP_BUILD_DEPRECATED_FUNCTIONS)
+class vpMbEdgeMultiTrackerTest : public vpMbEdgeMultiTracker
+{
+public:
+  vpMbEdgeMultiTrackerTest() : vpMbEdgeMultiTracker(2) {}
+  using vpMbEdgeMultiTracker::cleanPyramid;
+  using vpMbEdgeMultiTracker::initPyramid;
+};
+
+// Each camera has its own pyramid, and tracks the box with two scales
+bool testMultiCamera(const std::string &model, const vpCameraParameters &cam, const vpMe &me,
+                     const std::vector<vpHomogeneousMatrix> &c1Mo_truth)
+{
+  const vpHomogeneousMatrix c2Mc1(-0.04, 0.01, 0.02, 0, vpMath::rad(8), vpMath::rad(-5));
+  std::vector<bool> scales(2, true);
+
+  vpMbEdgeMultiTrackerTest tracker;
+  tracker.setScales(scales);
+  tracker.setCameraParameters(cam, cam);
+  tracker.setMovingEdge(me);
+  tracker.setCameraTransformationMatrix("Camera2", c2Mc1);
+  tracker.loadModel(model);
+
+  vpImage<unsigned char> I1(480, 640), I2(480, 640);
+  render(c1Mo_truth[0], cam, I1);
+  render(c2Mc1 * c1Mo_truth[0], cam, I2);
+
+  std::map<std::string, const vpImage<unsigned char> *> mapOfImages;
+  mapOfImages["Camera1"] = &I1;
+  mapOfImages["Camera2"] = &I2;
+  std::map<std::string, std::vector<const vpImage<unsigned char> *> > pyramid;
+  tracker.initPyramid(mapOfImages, pyramid);
+  if (!isSubsampled(I1, pyramid["Camera1"][1], 2) || !isSubsampled(I2, pyramid["Camera2"][1], 2)) {
+    std::cerr << "The cameras do not have their own pyramid" << std::endl;
+    return false;
+  }
+  tracker.cleanPyramid(pyramid);
+
+  tracker.initFromPose(I1, I2, c1Mo_truth[0], c2Mc1 * c1Mo_truth[0]);
+  double maxError = 0;
+  for (size_t k = 1; k < c1Mo_truth.size(); k++) {
+    render(c1Mo_truth[k], cam, I1);
+    render(c2Mc1 * c1Mo_truth[k], cam, I2);
+    tracker.track(I1, I2);
+
+    vpHomogeneousMatrix c1Mo, c2Mo;
+    tracker.getPose(c1Mo, c2Mo);
+    vpTranslationVector error1 = c1Mo.getTranslationVector() - c1Mo_truth[k].getTranslationVector();
+    vpTranslationVector error2 = c2Mo.getTranslationVector() - (c2Mc1 * c1Mo_truth[k]).getTranslationVector();
+    maxError = (std::max)(maxError, (std::max)(error1.euclideanNorm(), error2.euclideanNorm()));
+  }
+  std::cout << "Largest translation error: " << maxError << " m" << std::endl;
+
+  if (maxError > 0.02) {
+    std::cerr << "The tracker did not follow the object" << std::endl;
+    return false;
+  }
+  return true;
+}
+#endif
+}
+
+int main()
+{
+  try {
+    std::cout << "** Test the pyramid" << std::endl;
+    if (!testPyramid())
+      return EXIT_FAILURE;
+
+    std::string username;
+    vpIoTools::getUserName(username);
+#if defined(_WIN32)
+    std::string opath = "C:/temp/" + username;
+#else
+    std::string opath = "/tmp/" + username;
+#endif
+    if (!vpIoTools::checkDirectory(opath))
+      vpIoTools::makeDirectory(opath);
+    std::string model = vpIoTools::createFilePath(opath, "testMbEdgeTrackerScales.cao");
+    writeModel(model);
+
+    vpCameraParameters cam(600, 600, 320, 240);
+    vpMe me;
+    me.setMaskSize(5);
+    me.setMaskNumber(180);
+    me.setRange(8);
+    me.setThreshold(2000);
+    me.setMu1(0.5);
+    me.setMu2(0.5);
+    me.setSampleStep(4);
+
+    // Slow motion, a fast motion at frame 10, then slow motion again
+    const unsigned int nbFrames = 20;
+    std::vector<vpHomogeneousMatrix> cMo_truth;
+    vpHomogeneousMatrix cMo(-0.08, -0.03, 0.4, vpMath::rad(-30), vpMath::rad(30), vpMath::rad(10));
+    for (unsigned int k = 0; k < nbFrames; k++) {
+      double dx = (k == 10) ? 0.006 : 0.0005;
+      cMo = vpHomogeneousMatrix(dx, 0, 0, 0, 0, vpMath::rad(0.2)) * cMo;
+      cMo_truth.push_back(cMo);
+    }
+
+    std::vector<bool> scales(2, true);
+    for (unsigned int scheduling = 0; scheduling < 2; scheduling++) {
+      std::cout << "** Test the tracking " << (scheduling ? "with" : "without") << " scale scheduling" << std::endl;
+      vpMbEdgeTracker tracker;
+      tracker.setScales(scales);
+      tracker.setCameraParameters(cam);
+      tracker.setMovingEdge(me);
+      tracker.setScaleScheduling(scheduling == 1, 2.0);
+      tracker.loadModel(model);
+
+      vpImage<unsigned char> I(480, 640);
+      render(cMo_truth[0], cam, I);
+      tracker.initFromPose(I, cMo_truth[0]);
+
+      double maxError = 0;
+      for (unsigned int k = 1; k < nbFrames; k++) {
+        render(cMo_truth[k], cam, I);
+        tracker.track(I);
+        vpTranslationVector error =
+            tracker.getPose().getTranslationVector() - cMo_truth[k].getTranslationVector();
+        maxError = (std::max)(maxError, error.euclideanNorm());
+      }
+
+      std::vector<double> lastTimes, meanTimes;
+      std::vector<unsigned int> nbSkipped;
+      tracker.getScaleStatistics(lastTimes, meanTimes, nbSkipped);
+      for (size_t l = 0; l < scales.size(); l++) {
+        std::cout << "Level " << l << ": mean time " << meanTimes[l] << " ms, skipped " << nbSkipped[l] << " times"
+                  << std::endl;
+      }
+      std::cout << "Largest translation error: " << maxError << " m" << std::endl;
+
+      if (maxError > 0.02) {
+        std::cerr << "The tracker did not follow the object" << std::endl;
+        return EXIT_FAILURE;
+      }
+      if ((scheduling == 1) != (nbSkipped[1] > 0) || nbSkipped[0] != 0) {
+        std::cerr << "Unexpected number of skipped levels" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+#if defined(VISP_BUILD_DEPRECATED_FUNCTIONS)
+    std::cout << "** Test the tracking with two cameras" << std::endl;
+    if (!testMultiCamera(model, cam, me, cMo_truth))
+      return EXIT_FAILURE;
+#endif
+
+    std::cout << "Test succeed" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const vpException &e) {
+    std::cout << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+}
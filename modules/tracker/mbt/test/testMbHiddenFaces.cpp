@@ -0,0 +1,224 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the culling of the faces with a bounding volume hierarchy.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testMbHiddenFaces.cpp
+
+  Compare the visibility and the clipped polygons of a large model computed
+  with and without the bounding volume hierarchy of vpMbHiddenFaces, for
+  random poses and for small motions of the camera.
+*/
+
+#include <cstdlib>
+#include <iostream>
+
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpTime.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/mbt/vpMbHiddenFaces.h>
+
+namespace
+{
+void addFace(vpMbHiddenFaces<vpMbtPolygon> &faces, const std::vector<vpPoint> &points, bool oriented = true)
+{
+  vpMbtPolygon polygon;
+  polygon.setNbPoint((unsigned int)points.size());
+  for (unsigned int i = 0; i < points.size(); i++)
+    polygon.addPoint(i, points[i]);
+  polygon.setIndex((int)faces.size());
+  polygon.setIsPolygonOriented(oriented);
+  faces.addPolygon(&polygon);
+}
+
+// Boxes of random size on a grid, each with six outward faces, along with a
+// few lines and faces without orientation
+void buildModel(vpMbHiddenFaces<vpMbtPolygon> &faces, unsigned int side)
+{
+  vpUniRand rand(42);
+  for (unsigned int i = 0; i < side; i++) {
+    for (unsigned int j = 0; j < side; j++) {
+      for (unsigned int k = 0; k < side; k++) {
+        double x0 = 0.1 * i, y0 = 0.1 * j, z0 = 0.1 * k;
+        double x1 = x0 + 0.02 + 0.06 * rand(), y1 = y0 + 0.02 + 0.06 * rand(), z1 = z0 + 0.02 + 0.06 * rand();
+        vpPoint v[8] = {vpPoint(x0, y0, z0), vpPoint(x1, y0, z0), vpPoint(x1, y1, z0), vpPoint(x0, y1, z0),
+                        vpPoint(x0, y0, z1), vpPoint(x1, y0, z1), vpPoint(x1, y1, z1), vpPoint(x0, y1, z1)};
+        const unsigned int quads[6][4] = {{0, 3, 2, 1}, {4, 5, 6, 7}, {0, 1, 5, 4},
+                                          {2, 3, 7, 6}, {0, 4, 7, 3}, {1, 2, 6, 5}};
+        for (unsigned int f = 0; f < 6; f++) {
+          std::vector<vpPoint> points;
+          for (unsigned int n = 0; n < 4; n++)
+            points.push_back(v[quads[f][n]]);
+          addFace(faces, points);
+        }
+
+        if ((i + j + k) % 7 == 0) {
+          std::vector<vpPoint> line;
+          line.push_back(v[0]);
+          line.push_back(v[6]);
+          addFace(faces, line);
+        }
+        if ((i + j + k) % 11 == 0) {
+          std::vector<vpPoint> cylinder;
+          cylinder.push_back(v[0]);
+          cylinder.push_back(v[1]);
+          cylinder.push_back(v[6]);
+          cylinder.push_back(v[7]);
+          addFace(faces, cylinder, false);
+        }
+      }
+    }
+  }
+}
+
+bool compareVisibility(vpMbHiddenFaces<vpMbtPolygon> &faces, vpMbHiddenFaces<vpMbtPolygon> &reference,
+                       unsigned int nbVisible, unsigned int nbVisibleReference, bool changed, bool changedReference)
+{
+  if (nbVisible != nbVisibleReference || changed != changedReference) {
+    std::cerr << "Visible faces: " << nbVisible << " instead of " << nbVisibleReference << ", changed: " << changed
+              << " instead of " << changedReference << std::endl;
+    return false;
+  }
+  for (unsigned int i = 0; i < faces.size(); i++) {
+    if (faces.isVisible(i) != reference.isVisible(i) || faces.isAppearing(i) != reference.isAppearing(i)) {
+      std::cerr << "Visibility of face " << i << " differs" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool compareClipping(vpMbHiddenFaces<vpMbtPolygon> &faces, vpMbHiddenFaces<vpMbtPolygon> &reference)
+{
+  for (unsigned int i = 0; i < faces.size(); i++) {
+    std::vector<std::pair<vpPoint, unsigned int> > clipped, clippedReference;
+    faces[i]->getPolygonClipped(clipped);
+    reference[i]->getPolygonClipped(clippedReference);
+    if (clipped.size() != clippedReference.size()) {
+      std::cerr << "Clipped polygon of face " << i << " differs" << std::endl;
+      return false;
+    }
+    for (size_t j = 0; j < clipped.size(); j++) {
+      if (clipped[j].second != clippedReference[j].second ||
+          !vpMath::equal(clipped[j].first.get_X(), clippedReference[j].first.get_X(), 1e-12) ||
+          !vpMath::equal(clipped[j].first.get_Y(), clippedReference[j].first.get_Y(), 1e-12) ||
+          !vpMath::equal(clipped[j].first.get_Z(), clippedReference[j].first.get_Z(), 1e-12)) {
+        std::cerr << "Clipped point " << j << " of face " << i << " differs" << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int main()
+{
+  try {
+    vpMbHiddenFaces<vpMbtPolygon> faces, reference;
+    buildModel(faces, 8);
+    reference = faces;
+    reference.setBvhCulling(false);
+    std::cout << "Model with " << faces.size() << " faces" << std::endl;
+
+    vpCameraParameters cam(600, 600, 320, 240);
+    cam.computeFov(640, 480);
+    vpImage<unsigned char> I(480, 640);
+    for (unsigned int i = 0; i < faces.size(); i++) {
+      unsigned int clipping = vpPolygon3D::NEAR_CLIPPING | vpPolygon3D::FAR_CLIPPING | vpPolygon3D::FOV_CLIPPING;
+      faces[i]->setClipping(clipping);
+      faces[i]->setNearClippingDistance(0.1);
+      faces[i]->setFarClippingDistance(1.5);
+      reference[i]->setClipping(clipping);
+      reference[i]->setNearClippingDistance(0.1);
+      reference[i]->setFarClippingDistance(1.5);
+    }
+
+    const double angleAppears = vpMath::rad(89), angleDisappears = vpMath::rad(85);
+    vpUniRand rand(17);
+    double time = 0, timeReference = 0;
+    for (unsigned int iter = 0; iter < 10; iter++) {
+      // Random pose looking at the model, followed by small motions
+      vpHomogeneousMatrix cMo(-0.75 + 0.5 * rand(), -0.75 + 0.5 * rand(), 0.3 + 2.0 * rand(),
+                              vpMath::rad(360 * rand()), vpMath::rad(360 * rand()), vpMath::rad(360 * rand()));
+      cMo[0][3] -= cMo[0][0] * 0.75 + cMo[0][1] * 0.75 + cMo[0][2] * 0.75;
+      cMo[1][3] -= cMo[1][0] * 0.75 + cMo[1][1] * 0.75 + cMo[1][2] * 0.75;
+      cMo[2][3] -= cMo[2][0] * 0.75 + cMo[2][1] * 0.75 + cMo[2][2] * 0.75;
+
+      for (unsigned int step = 0; step < 5; step++) {
+        vpHomogeneousMatrix cdMc(0.005 * rand(), 0.005 * rand(), 0.005 * rand(), vpMath::rad(rand()),
+                                 vpMath::rad(rand()), vpMath::rad(rand()));
+        cMo = cdMc * cMo;
+
+        bool changed = false, changedReference = false;
+        double t = vpTime::measureTimeMs();
+        unsigned int nbVisible = faces.setVisible(I, cam, cMo, angleAppears, angleDisappears, changed);
+        time += vpTime::measureTimeMs() - t;
+        t = vpTime::measureTimeMs();
+        unsigned int nbVisibleReference =
+            reference.setVisible(I, cam, cMo, angleAppears, angleDisappears, changedReference);
+        timeReference += vpTime::measureTimeMs() - t;
+        if (!compareVisibility(faces, reference, nbVisible, nbVisibleReference, changed, changedReference))
+          return EXIT_FAILURE;
+
+        faces.computeClippedPolygons(cMo, cam);
+        reference.computeClippedPolygons(cMo, cam);
+        if (!compareClipping(faces, reference))
+          return EXIT_FAILURE;
+      }
+    }
+    std::cout << "Visibility test: " << time << " ms with the hierarchy, " << timeReference << " ms without"
+              << std::endl;
+
+    // The hierarchy has to follow the changes of the faces
+    reference.reset();
+    buildModel(reference, 4);
+    reference.setBvhCulling(false);
+    faces.reset();
+    buildModel(faces, 4);
+    vpHomogeneousMatrix cMo(-0.2, -0.2, 1.0, vpMath::rad(10), vpMath::rad(20), 0);
+    bool changed = false, changedReference = false;
+    unsigned int nbVisible = faces.setVisible(I, cam, cMo, angleAppears, angleDisappears, changed);
+    unsigned int nbVisibleReference =
+        reference.setVisible(I, cam, cMo, angleAppears, angleDisappears, changedReference);
+    if (!compareVisibility(faces, reference, nbVisible, nbVisibleReference, changed, changedReference))
+      return EXIT_FAILURE;
+
+    std::cout << "Test succeed" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const vpException &e) {
+    std::cout << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+}
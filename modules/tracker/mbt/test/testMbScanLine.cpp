@@ -0,0 +1,229 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the rendering of the faces with scanlines.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testMbScanLine.cpp
+
+  Render faces with vpMbScanLine and compare the primitive ids and the
+  depths of the pixels with their expected values, for overlapping faces,
+  a hidden face and a tilted face. The scene is then rendered again to
+  check that nothing remains from the previous one.
+*/
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+#include <visp3/core/vpMath.h>
+#include <visp3/mbt/vpMbScanLine.h>
+
+namespace
+{
+const vpCameraParameters cam(600, 600, 320, 240);
+const unsigned int width = 640, height = 480;
+
+typedef std::vector<std::pair<vpPoint, unsigned int> > vpFace;
+
+// Add to the face the point of depth Z seen at the pixel (u, v)
+void addPoint(vpFace &face, const double u, const double v, const double Z)
+{
+  vpPoint P;
+  P.set_X((u - cam.get_u0()) / cam.get_px() * Z);
+  P.set_Y((v - cam.get_v0()) / cam.get_py() * Z);
+  P.set_Z(Z);
+  face.push_back(std::make_pair(P, (unsigned int)face.size()));
+}
+
+struct vpRect2D {
+  double left, top, right, bottom;
+  bool contains(const double u, const double v, const double margin) const
+  {
+    return u > left + margin && u < right - margin && v > top + margin && v < bottom - margin;
+  }
+  bool isNear(const double u, const double v, const double margin) const
+  {
+    return contains(u, v, -margin) && !contains(u, v, margin);
+  }
+};
+
+// Face parallel to the image plane
+vpFace buildFace(const vpRect2D &r, const double Z)
+{
+  vpFace face;
+  addPoint(face, r.left, r.top, Z);
+  addPoint(face, r.right, r.top, Z);
+  addPoint(face, r.right, r.bottom, Z);
+  addPoint(face, r.left, r.bottom, Z);
+  return face;
+}
+
+// Face in the plane Z = 1 + X
+vpFace buildTiltedFace()
+{
+  const double corners[4][2] = {{0.3, 0.1}, {0.45, 0.1}, {0.45, 0.25}, {0.3, 0.25}};
+  vpFace face;
+  for (unsigned int i = 0; i < 4; i++) {
+    vpPoint P;
+    P.set_X(corners[i][0]);
+    P.set_Y(corners[i][1]);
+    P.set_Z(1 + corners[i][0]);
+    face.push_back(std::make_pair(P, i));
+  }
+  return face;
+}
+
+double getTiltedDepth(const unsigned int u)
+{
+  // Intersection of the ray of the pixel with the plane Z = 1 + X
+  return 1.0 / (1.0 - (u - cam.get_u0()) / cam.get_px());
+}
+
+void render(vpMbScanLine &scanline, const std::vector<vpFace> &faces, const std::vector<int> &ids)
+{
+  std::vector<std::vector<std::pair<vpPoint, unsigned int> > *> polygons;
+  for (size_t i = 0; i < faces.size(); i++)
+    polygons.push_back(const_cast<vpFace *>(&faces[i]));
+  scanline.drawScene(polygons, ids, cam, width, height);
+}
+}
+
+int main()
+{
+  const vpRect2D back = {100, 100, 300, 300};
+  const vpRect2D front = {200, 150, 400, 250};
+  const vpRect2D hidden = {120, 120, 180, 180};
+
+  vpMbScanLine scanline;
+  scanline.setComputePrimitiveDepths(true);
+
+  std::cout << "** Render overlapping, hidden and tilted faces" << std::endl;
+  {
+    std::vector<vpFace> faces;
+    std::vector<int> ids;
+    faces.push_back(buildFace(back, 1.0));
+    ids.push_back(10);
+    faces.push_back(buildFace(front, 0.5));
+    ids.push_back(20);
+    faces.push_back(buildFace(hidden, 2.0));
+    ids.push_back(30);
+    faces.push_back(buildTiltedFace());
+    ids.push_back(40);
+    render(scanline, faces, ids);
+
+    const vpImage<int> &I_ids = scanline.getPrimitiveIDs();
+    const vpImage<float> &I_depths = scanline.getPrimitiveDepths();
+    const vpImage<unsigned char> &I_mask = scanline.getMask();
+    if (I_ids.getHeight() != height || I_ids.getWidth() != width || I_depths.getHeight() != height ||
+        I_depths.getWidth() != width) {
+      std::cerr << "Bad size of the rendered images" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    unsigned int nbTilted = 0;
+    for (unsigned int v = 0; v < height; v++) {
+      for (unsigned int u = 0; u < width; u++) {
+        const int id = I_ids[v][u];
+        if ((id != -1) != (I_mask[v][u] == 255)) {
+          std::cerr << "The mask and the ids differ at (" << u << ", " << v << ")" << std::endl;
+          return EXIT_FAILURE;
+        }
+        if (id == 30) {
+          std::cerr << "The hidden face is visible at (" << u << ", " << v << ")" << std::endl;
+          return EXIT_FAILURE;
+        }
+        if (id == 40) {
+          nbTilted++;
+          if (std::fabs(I_depths[v][u] - getTiltedDepth(u)) > 1e-4) {
+            std::cerr << "Depth " << I_depths[v][u] << " of the tilted face at (" << u << ", " << v << ") instead of "
+                      << getTiltedDepth(u) << std::endl;
+            return EXIT_FAILURE;
+          }
+          continue;
+        }
+
+        // The pixels on the edges of the faces may belong to either side
+        if (back.isNear(u, v, 1) || front.isNear(u, v, 1))
+          continue;
+        int expectedId = -1;
+        float expectedDepth = 0.f;
+        if (front.contains(u, v, 0)) {
+          expectedId = 20;
+          expectedDepth = 0.5f;
+        } else if (back.contains(u, v, 0)) {
+          expectedId = 10;
+          expectedDepth = 1.0f;
+        }
+        if (id != expectedId || !vpMath::equal(I_depths[v][u], expectedDepth, 1e-6)) {
+          std::cerr << "Face " << id << " with depth " << I_depths[v][u] << " at (" << u << ", " << v
+                    << ") instead of face " << expectedId << " with depth " << expectedDepth << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+    if (nbTilted < 1000) {
+      std::cerr << "The tilted face covers only " << nbTilted << " pixels" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // The buffers are reused, nothing has to remain from the previous scene
+  std::cout << "** Render a single face" << std::endl;
+  {
+    const vpRect2D moved = {300, 200, 500, 400};
+    std::vector<vpFace> faces;
+    std::vector<int> ids;
+    faces.push_back(buildFace(moved, 2.0));
+    ids.push_back(10);
+    render(scanline, faces, ids);
+
+    const vpImage<int> &I_ids = scanline.getPrimitiveIDs();
+    const vpImage<float> &I_depths = scanline.getPrimitiveDepths();
+    for (unsigned int v = 0; v < height; v++) {
+      for (unsigned int u = 0; u < width; u++) {
+        if (moved.isNear(u, v, 1))
+          continue;
+        const bool inside = moved.contains(u, v, 0);
+        if (I_ids[v][u] != (inside ? 10 : -1) || !vpMath::equal(I_depths[v][u], inside ? 2.f : 0.f, 1e-6)) {
+          std::cerr << "Face " << I_ids[v][u] << " with depth " << I_depths[v][u] << " at (" << u << ", " << v
+                    << ")" << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  std::cout << "Test succeed" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,107 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Synthetic box shared by the model-based tracker tests.
+ *
+ *****************************************************************************/
+
+/*!
+  \file testMbSyntheticBox.h
+
+  \brief Model and rendering of a synthetic box, shared by the model-based
+  tracker tests that do not rely on the ViSP data set.
+*/
+
+#ifndef __testMbSyntheticBox_h_
+#define __testMbSyntheticBox_h_
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <visp3/core/vpCameraParameters.h>
+#include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpPoint.h>
+#include <visp3/core/vpPolygon.h>
+
+namespace
+{
+const double box[8][3] = {{0, 0, 0},         {0, 0, -0.08},         {0.165, 0, -0.08},    {0.165, 0, 0},
+                          {0.165, 0.068, 0}, {0.165, 0.068, -0.08}, {0, 0.068, -0.08}, {0, 0.068, 0}};
+// Vertices of each face in counterclockwise order seen from outside the box,
+// for the normal used by the visibility test to point outward
+const unsigned int faces[6][4] = {{0, 1, 2, 3}, {1, 6, 5, 2}, {4, 5, 6, 7},
+                                  {0, 3, 4, 7}, {5, 4, 3, 2}, {0, 7, 6, 1}};
+
+// Write the .cao model of the first nbFaces faces of the box
+inline void writeModel(const std::string &filename, const unsigned int nbFaces = 6)
+{
+  std::ofstream file(filename.c_str());
+  file << "V1\n8\n";
+  for (unsigned int i = 0; i < 8; i++)
+    file << box[i][0] << " " << box[i][1] << " " << box[i][2] << "\n";
+  file << "0\n0\n" << nbFaces << "\n";
+  for (unsigned int i = 0; i < nbFaces; i++)
+    file << "4 " << faces[i][0] << " " << faces[i][1] << " " << faces[i][2] << " " << faces[i][3] << "\n";
+  file << "0\n0\n";
+}
+
+// Render the box with a different gray level for each face, the farthest
+// faces being drawn first
+inline void render(const vpHomogeneousMatrix &cMo, const vpCameraParameters &cam, vpImage<unsigned char> &I)
+{
+  I = 0;
+  std::vector<std::pair<double, unsigned int> > order;
+  std::vector<std::vector<vpPoint> > corners(6);
+  for (unsigned int f = 0; f < 6; f++) {
+    double depth = 0;
+    for (unsigned int k = 0; k < 4; k++) {
+      const double *X = box[faces[f][k]];
+      vpPoint P(X[0], X[1], X[2]);
+      P.project(cMo);
+      depth += P.get_Z();
+      corners[f].push_back(P);
+    }
+    order.push_back(std::make_pair(-depth, f));
+  }
+  std::sort(order.begin(), order.end());
+  for (size_t k = 0; k < order.size(); k++) {
+    vpPolygon polygon;
+    polygon.buildFrom(corners[order[k].second], cam);
+    polygon.fillMask(I, (unsigned char)(60 + 35 * order[k].second));
+  }
+}
+}
+
+#endif
@@ -0,0 +1,174 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the timings and counters of the generic model-based tracker.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testMbTrackingStatistics.cpp
+
+  Test the timings and counters computed by vpMbGenericTracker::track() on a
+  synthetic box tracked by the moving edges.
+*/
+
+#include <iostream>
+#include <sstream>
+
+#include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/mbt/vpMbGenericTracker.h>
+
+#include "testMbSyntheticBox.h"
+
+namespace
+{
+bool checkStatistics(const vpMbtTrackingStatistics &stats, const unsigned int frame)
+{
+  if (stats.frame != frame) {
+    std::cerr << "Bad frame index: " << stats.frame << " instead of " << frame << std::endl;
+    return false;
+  }
+  if (stats.nbIterations == 0 || stats.cameras.size() != 1 || stats.cameras.count("Camera") == 0) {
+    std::cerr << "Missing statistics" << std::endl;
+    return false;
+  }
+
+  const vpMbtTrackingStatistics::vpCameraStatistics &camera = stats.cameras.find("Camera")->second;
+  if (camera.nbEdgeFeatures == 0 || camera.nbEdgeRejected > camera.nbEdgeFeatures || camera.nbKltFeatures != 0 ||
+      camera.nbDepthNormalFeatures != 0 || camera.nbDepthDenseFeatures != 0) {
+    std::cerr << "Bad number of features" << std::endl;
+    return false;
+  }
+  // Each moving edge site gives a feature, whatever its state
+  const unsigned int nbSites =
+      camera.nbMeTracked + camera.nbMeContrast + camera.nbMeThreshold + camera.nbMeMEstimator + camera.nbMeTooNear;
+  if (nbSites != camera.nbEdgeFeatures || camera.nbMeMEstimator > camera.nbEdgeRejected) {
+    std::cerr << "The moving edge sites do not match the features: " << nbSites << " sites for "
+              << camera.nbEdgeFeatures << " features" << std::endl;
+    return false;
+  }
+
+  const double stages = stats.vvsTime + stats.covarianceTime + stats.projectionErrorTime + camera.meTrackingTime +
+                        camera.visibilityTime + camera.meReinitTime;
+  if (stats.vvsTime < 0 || camera.meTrackingTime < 0 || stages > stats.totalTime) {
+    std::cerr << "Bad timings: " << stages << " ms spent in the stages for a total of " << stats.totalTime << " ms"
+              << std::endl;
+    return false;
+  }
+
+  const std::string json = stats.toJson();
+  std::ostringstream frameKey;
+  frameKey << "{\"frame\": " << frame << ",";
+  if (json.find(frameKey.str()) != 0 || json.find("\"Camera\": {") == std::string::npos ||
+      json[json.size() - 1] != '}') {
+    std::cerr << "Bad JSON export: " << json << std::endl;
+    return false;
+  }
+
+  const std::string csv = stats.toCsv();
+  const std::string header = vpMbtTrackingStatistics::getCsvHeader();
+  if (std::count(csv.begin(), csv.end(), '\n') != 1 ||
+      std::count(csv.begin(), csv.end(), ',') != std::count(header.begin(), header.end(), ',')) {
+    std::cerr << "Bad CSV export: " << csv << std::endl;
+    return false;
+  }
+
+  return true;
+}
+}
+
+int main()
+{
+  try {
+    std::string username;
+    vpIoTools::getUserName(username);
+#if defined(_WIN32)
+    std::string opath = "C:/temp/" + username;
+#else
+    std::string opath = "/tmp/" + username;
+#endif
+    if (!vpIoTools::checkDirectory(opath))
+      vpIoTools::makeDirectory(opath);
+    std::string model = vpIoTools::createFilePath(opath, "testMbTrackingStatistics.cao");
+    writeModel(model);
+
+    vpCameraParameters cam(600, 600, 320, 240);
+    vpMe me;
+    me.setMaskSize(5);
+    me.setMaskNumber(180);
+    me.setRange(8);
+    me.setThreshold(2000);
+    me.setMu1(0.5);
+    me.setMu2(0.5);
+    me.setSampleStep(4);
+
+    vpMbGenericTracker tracker(1, vpMbGenericTracker::EDGE_TRACKER);
+    tracker.setCameraParameters(cam);
+    tracker.setMovingEdge(me);
+    tracker.loadModel(model);
+
+    vpHomogeneousMatrix cMo(-0.08, -0.03, 0.4, vpMath::rad(-30), vpMath::rad(30), vpMath::rad(10));
+    vpImage<unsigned char> I(480, 640);
+    render(cMo, cam, I);
+    tracker.initFromPose(I, cMo);
+
+    const unsigned int nbFrames = 10;
+    for (unsigned int k = 1; k <= nbFrames; k++) {
+      // The statistics are only computed for the second half of the sequence
+      tracker.setTrackingStatisticsComputation(k > nbFrames / 2);
+
+      cMo = vpHomogeneousMatrix(0.0005, 0, 0, 0, 0, vpMath::rad(0.2)) * cMo;
+      render(cMo, cam, I);
+      tracker.track(I);
+
+      const vpMbtTrackingStatistics &stats = tracker.getTrackingStatistics();
+      if (!tracker.getTrackingStatisticsComputation()) {
+        if (stats.frame != 0 || !stats.cameras.empty()) {
+          std::cerr << "Statistics computed while disabled" << std::endl;
+          return EXIT_FAILURE;
+        }
+        continue;
+      }
+
+      if (!checkStatistics(stats, k - nbFrames / 2))
+        return EXIT_FAILURE;
+      if (k == nbFrames)
+        std::cout << stats.toJson() << std::endl;
+    }
+
+    std::cout << "Test succeed" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const vpException &e) {
+    std::cout << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+}
@@ -42,6 +42,7 @@
 #include <visp3/core/vpException.h>
 #include <visp3/core/vpImagePoint.h>
 #include <visp3/core/vpRobust.h>
+#include <visp3/core/vpTracing.h>
 #include <visp3/me/vpMe.h>
 
 #include <cmath>  // std::fabs
@@ -813,6 +814,7 @@ void vpMeEllipse::initTracking(const vpImage<unsigned char> &I, const vpImagePoi
 */
 void vpMeEllipse::track(const vpImage<unsigned char> &I)
 {
+  VP_TRACING_SCOPE("vpMeEllipse::track");
   vpMeTracker::track(I);
 
   // Estimation des parametres de la droite aux moindres carre
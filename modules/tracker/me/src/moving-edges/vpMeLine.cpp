@@ -48,6 +48,7 @@
 #include <visp3/core/vpImagePoint.h>
 #include <visp3/core/vpMath.h>
 #include <visp3/core/vpRobust.h>
+#include <visp3/core/vpTracing.h>
 #include <visp3/core/vpTrackingException.h>
 #include <visp3/me/vpMe.h>
 #include <visp3/me/vpMeLine.h>
@@ -746,6 +747,7 @@ void vpMeLine::updateDelta()
 */
 void vpMeLine::track(const vpImage<unsigned char> &I)
 {
+  VP_TRACING_SCOPE("vpMeLine::track");
   vpCDEBUG(1) << "begin vpMeLine::track()" << std::endl;
 
   //  1. On fait ce qui concerne les droites (peut etre vide)
@@ -51,6 +51,7 @@
 #include <visp3/core/vpMath.h>
 #include <visp3/core/vpRect.h>
 #include <visp3/core/vpRobust.h>
+#include <visp3/core/vpTracing.h>
 #include <visp3/core/vpTrackingException.h>
 #include <visp3/me/vpMe.h>
 #include <visp3/me/vpMeNurbs.h>
@@ -971,6 +972,7 @@ void vpMeNurbs::supressNearPoints()
 */
 void vpMeNurbs::track(const vpImage<unsigned char> &I)
 {
+  VP_TRACING_SCOPE("vpMeNurbs::track");
   // Tracking des vpMeSites
   vpMeTracker::track(I);
 
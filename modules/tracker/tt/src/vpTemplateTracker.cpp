@@ -40,6 +40,7 @@
 
 #include <visp3/tt/vpTemplateTracker.h>
 #include <visp3/tt/vpTemplateTrackerBSpline.h>
+#include <visp3/core/vpTracing.h>
 
 vpTemplateTracker::vpTemplateTracker(vpTemplateTrackerWarp *_warp)
   : nbLvlPyr(1), l0Pyr(0), pyrInitialised(false), ptTemplate(NULL), ptTemplatePyr(NULL), ptTemplateInit(false),
@@ -793,6 +794,7 @@ void vpTemplateTracker::initHessienDesiredPyr(const vpImage<unsigned char> &I)
  */
 void vpTemplateTracker::track(const vpImage<unsigned char> &I)
 {
+  VP_TRACING_SCOPE("vpTemplateTracker::track");
   if (nbLvlPyr > 1)
     trackPyr(I);
   else
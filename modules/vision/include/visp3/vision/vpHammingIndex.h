@@ -0,0 +1,135 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Approximate nearest neighbour index for binary descriptors.
+ *
+ *****************************************************************************/
+
+#ifndef vpHammingIndex_h
+#define vpHammingIndex_h
+
+/*!
+  \file vpHammingIndex.h
+  \brief Approximate nearest neighbour index for binary descriptors.
+*/
+
+#include <string>
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+
+/*!
+  \class vpHammingIndex
+
+  \ingroup group_vision_keypoints
+
+  \brief Multi-index hashing of binary descriptors (ORB, BRIEF, BRISK...)
+  to search their nearest neighbours in Hamming distance.
+
+  Each descriptor is split in substrings of 16 bits and one hash table is
+  built per substring. A query only computes the distance to the
+  descriptors whose substrings are at most at getProbeRadius() bits from
+  its own substrings, instead of the distance to all the descriptors. With
+  \f$m\f$ substrings and a probe radius \f$r\f$, all the descriptors at a
+  distance lower than \f$m(r+1)\f$ from the query are found: with 256 bits
+  ORB descriptors and the default radius of 1, the search is exact up to a
+  distance of 31.
+
+  The descriptors are not copied: they must stay valid as long as the index
+  is used. The hash tables can be saved with save() and loaded with load()
+  to avoid building them again.
+
+  \code
+#include <visp3/vision/vpHammingIndex.h>
+
+int main()
+{
+  std::vector<unsigned char> train(1000 * 32), query(10 * 32);
+  // ... fill the descriptors
+  vpHammingIndex index;
+  index.build(&train[0], 1000, 32);
+
+  std::vector<unsigned int> indices, distances;
+  index.knnSearch(&query[0], 10, 2, indices, distances);
+  // indices[2*i] is the nearest train descriptor of query i
+}
+  \endcode
+*/
+class VISP_EXPORT vpHammingIndex
+{
+public:
+  vpHammingIndex();
+  virtual ~vpHammingIndex();
+
+  void build(const unsigned char *descriptors, unsigned int nbDescriptors, unsigned int descriptorSize);
+
+  void clear();
+
+  //! Return the size of the descriptors in bytes.
+  inline unsigned int getDescriptorSize() const { return m_descriptorSize; }
+  //! Return the number of indexed descriptors.
+  inline unsigned int getNbDescriptors() const { return m_nbDescriptors; }
+  //! Return the number of bits by which the substrings of a query are
+  //! changed to find the candidate descriptors.
+  inline unsigned int getProbeRadius() const { return m_probeRadius; }
+
+  static unsigned int hammingDistance(const unsigned char *descriptor1, const unsigned char *descriptor2,
+                                      unsigned int descriptorSize);
+
+  void knnSearch(const unsigned char *queries, unsigned int nbQueries, unsigned int k,
+                 std::vector<unsigned int> &indices, std::vector<unsigned int> &distances) const;
+
+  void load(const std::string &filename, const unsigned char *descriptors, unsigned int nbDescriptors,
+            unsigned int descriptorSize);
+
+  void save(const std::string &filename) const;
+
+  void setProbeRadius(unsigned int radius);
+
+private:
+  static unsigned int checksum(const unsigned char *descriptors, unsigned int nbDescriptors,
+                               unsigned int descriptorSize);
+  inline unsigned int substring(const unsigned char *descriptor, unsigned int table) const;
+
+  //! Indexed descriptors, not owned.
+  const unsigned char *m_descriptors;
+  unsigned int m_nbDescriptors;
+  unsigned int m_descriptorSize;
+  unsigned int m_nbTables;
+  unsigned int m_probeRadius;
+  //! For each table, start of the bucket of each substring value in m_ids.
+  std::vector<unsigned int> m_offsets;
+  //! For each table, indexes of the descriptors sorted by substring value.
+  std::vector<unsigned int> m_ids;
+};
+
+#endif
@@ -51,10 +51,12 @@
 #include <visp3/core/vpConfig.h>
 #include <visp3/core/vpDisplay.h>
 #include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpMappedFile.h>
 #include <visp3/core/vpPixelMeterConversion.h>
 #include <visp3/core/vpPlane.h>
 #include <visp3/core/vpPoint.h>
 #include <visp3/vision/vpBasicKeyPoint.h>
+#include <visp3/vision/vpHammingIndex.h>
 #include <visp3/vision/vpPose.h>
 #ifdef VISP_HAVE_MODULE_IO
 #  include <visp3/io/vpImageIo.h>
@@ -378,6 +380,9 @@ public:
                    std::vector<unsigned int> &inlierIndex, double &elapsedTime,
                    bool (*func)(const vpHomogeneousMatrix &) = NULL);
 
+  static void convertLearningData(const std::string &filename, const bool binaryMode,
+                                  const std::string &mappedFilename);
+
   void createImageMatching(vpImage<unsigned char> &IRef, vpImage<unsigned char> &ICurrent,
                            vpImage<unsigned char> &IMatching);
   void createImageMatching(vpImage<unsigned char> &ICurrent, vpImage<unsigned char> &IMatching);
@@ -650,6 +655,11 @@ public:
 
      \return : Matrix with descriptors values at each row for each train
      keypoints (or reference keypoints).
+
+     \warning After loadMappedLearningData(), the matrix uses the memory of
+     the mapped file and must be cloned to be used after the next call to
+     buildReference(), loadLearningData(), loadMappedLearningData() or
+     reset().
    */
   inline cv::Mat getTrainDescriptors() const { return m_trainDescriptors; }
 
@@ -670,6 +680,8 @@ public:
 #endif
 
   void loadLearningData(const std::string &filename, const bool binaryMode = false, const bool append = false);
+  void loadMappedLearningData(const std::string &filename, const bool append = false);
+  void loadMatchingIndex(const std::string &filename);
 
   void match(const cv::Mat &trainDescriptors, const cv::Mat &queryDescriptors, std::vector<cv::DMatch> &matches,
              double &elapsedTime);
@@ -698,6 +710,17 @@ public:
 
   void saveLearningData(const std::string &filename, const bool binaryMode = false,
                         const bool saveTrainingImages = true);
+  void saveMappedLearningData(const std::string &filename, const bool saveTrainingImages = true);
+  void saveMatchingIndex(const std::string &filename) const;
+
+  /*!
+    Set the number of threads used to detect and extract the keypoints in
+    the simulated affine views (see setUseAffineDetection()).
+
+    \param nthreads : Number of threads, if 0 the number of threads is
+    determined by OpenMP.
+  */
+  inline void setAffineDetectionNbThreads(const unsigned int nthreads) { m_affineDetectionNbThreads = nthreads; }
 
   /*!
     Set if the covariance matrix has to be computed in the Virtual Visual
@@ -1081,6 +1104,8 @@ public:
   }
 #endif
 
+  void setUseMatchingIndex(const bool useMatchingIndex);
+
   /*!
     Set if we want to match the train keypoints to the query keypoints.
 
@@ -1119,6 +1144,9 @@ public:
   inline void setUseSingleMatchFilter(const bool singleMatchFilter) { m_useSingleMatchFilter = singleMatchFilter; }
 
 private:
+  //! Number of threads used in detectExtractAffine() (if 0, determined by
+  //! OpenMP).
+  unsigned int m_affineDetectionNbThreads;
   //! If true, compute covariance matrix if the user select the pose
   //! estimation method using ViSP
   bool m_computeCovariance;
@@ -1154,8 +1182,13 @@ private:
   std::vector<cv::DMatch> m_filteredMatches;
   //! Chosen method of filtering to eliminate false matching.
   vpFilterMatchingType m_filterType;
+  //! Index of the binary train descriptors (see setUseMatchingIndex()).
+  vpHammingIndex m_hammingIndex;
   //! Image format to use when saving the training images
   vpImageFormatType m_imageFormat;
+  //! k-d forest matcher of the floating point train descriptors (see
+  //! setUseMatchingIndex()).
+  cv::Ptr<cv::DescriptorMatcher> m_indexMatcher;
   //! List of k-nearest neighbors for each detected keypoints (if the method
   //! chosen is based upon on knn).
   std::vector<std::vector<cv::DMatch> > m_knnMatches;
@@ -1169,6 +1202,9 @@ private:
   //! Map of images to have access to the image buffer according to his image
   //! id.
   std::map<int, vpImage<unsigned char> > m_mapOfImages;
+  //! Memory-mapped learning file that contains the train descriptors (see
+  //! loadMappedLearningData()).
+  cv::Ptr<vpMappedFile> m_mappedLearningData;
   //! Smart reference-counting pointer (similar to shared_ptr in Boost) of
   //! descriptor matcher (e.g. BruteForce or FlannBased).
   cv::Ptr<cv::DescriptorMatcher> m_matcher;
@@ -1245,6 +1281,8 @@ private:
   bool m_useConsensusPercentage;
   //! Flag set if a knn matching method must be used.
   bool m_useKnn;
+  //! Flag set if the train descriptors are indexed to speed up the matching.
+  bool m_useMatchingIndex;
   //! Flag set if we want to match the train keypoints to the query keypoints,
   //! useful when there is only one train image because it reduces the number
   //! of possible false matches (by default it is the inverse because normally
@@ -1272,6 +1310,12 @@ private:
 
   void initFeatureNames();
 
+  void buildMatchingIndex();
+  void getLearningDataStartIds(int &startClassId, int &startImageId) const;
+  bool matchWithIndex(const cv::Mat &queryDescriptors, std::vector<std::vector<cv::DMatch> > &knnMatches,
+                      const unsigned int k);
+  void releaseMappedLearningData();
+
   inline size_t myKeypointHash(const cv::KeyPoint &kp)
   {
     size_t _Val = 2166136261U, scale = 16777619U;
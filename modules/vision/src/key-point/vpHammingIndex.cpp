@@ -0,0 +1,398 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Approximate nearest neighbour index for binary descriptors.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpHammingIndex.cpp
+  \brief Approximate nearest neighbour index for binary descriptors.
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpIoTools.h>
+#include <visp3/vision/vpHammingIndex.h>
+
+namespace
+{
+// Substrings of 16 bits
+const unsigned int substringSize = 2;
+const unsigned int substringValues = 1 << 16;
+
+const char hammingIndexMagic[8] = {'V', 'P', 'H', 'I', 'D', 'X', '\0', '\0'};
+const uint32_t hammingIndexVersion = 1;
+
+bool isBigEndian()
+{
+  const uint16_t one = 1;
+  return *(const unsigned char *)&one == 0;
+}
+
+// The arrays are stored in little endian
+void writeArray(std::ofstream &file, const std::vector<unsigned int> &array)
+{
+  if (isBigEndian()) {
+    for (size_t i = 0; i < array.size(); i++) {
+      vpIoTools::writeBinaryValueLE(file, (uint32_t)array[i]);
+    }
+  } else if (!array.empty()) {
+    file.write((const char *)&array[0], (std::streamsize)(array.size() * sizeof(unsigned int)));
+  }
+}
+
+void readArray(std::ifstream &file, std::vector<unsigned int> &array)
+{
+  if (isBigEndian()) {
+    for (size_t i = 0; i < array.size(); i++) {
+      uint32_t value = 0;
+      vpIoTools::readBinaryValueLE(file, value);
+      array[i] = value;
+    }
+  } else if (!array.empty()) {
+    file.read((char *)&array[0], (std::streamsize)(array.size() * sizeof(unsigned int)));
+  }
+}
+
+// Insert a candidate in the list of the k nearest neighbours sorted by
+// increasing distance
+void insertNeighbour(unsigned int index, unsigned int distance, unsigned int k, unsigned int *indices,
+                     unsigned int *distances)
+{
+  if (distance >= distances[k - 1]) {
+    return;
+  }
+  unsigned int i = k - 1;
+  for (; i > 0 && distances[i - 1] > distance; i--) {
+    indices[i] = indices[i - 1];
+    distances[i] = distances[i - 1];
+  }
+  indices[i] = index;
+  distances[i] = distance;
+}
+}
+
+/*!
+  Default constructor, the index is empty.
+*/
+vpHammingIndex::vpHammingIndex()
+  : m_descriptors(NULL), m_nbDescriptors(0), m_descriptorSize(0), m_nbTables(0), m_probeRadius(1), m_offsets(),
+    m_ids()
+{
+}
+
+/*!
+  Destructor.
+*/
+vpHammingIndex::~vpHammingIndex() {}
+
+/*!
+  Build the hash tables of the descriptors.
+
+  \param descriptors : Contiguous array of \e nbDescriptors descriptors of
+  \e descriptorSize bytes. It is not copied and must stay valid as long as
+  the index is used.
+  \param nbDescriptors : Number of descriptors.
+  \param descriptorSize : Size of a descriptor in bytes.
+*/
+void vpHammingIndex::build(const unsigned char *descriptors, unsigned int nbDescriptors, unsigned int descriptorSize)
+{
+  clear();
+  if (nbDescriptors == 0 || descriptorSize == 0) {
+    return;
+  }
+
+  m_descriptors = descriptors;
+  m_nbDescriptors = nbDescriptors;
+  m_descriptorSize = descriptorSize;
+  m_nbTables = (descriptorSize + substringSize - 1) / substringSize;
+  m_offsets.assign((size_t)m_nbTables * (substringValues + 1), 0);
+  m_ids.resize((size_t)m_nbTables * nbDescriptors);
+
+  // Counting sort of the descriptors by substring value in each table
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel for
+#endif
+  for (int t = 0; t < (int)m_nbTables; t++) {
+    unsigned int *offsets = &m_offsets[(size_t)t * (substringValues + 1)];
+    unsigned int *ids = &m_ids[(size_t)t * m_nbDescriptors];
+
+    for (unsigned int i = 0; i < m_nbDescriptors; i++) {
+      offsets[substring(m_descriptors + (size_t)i * m_descriptorSize, (unsigned int)t) + 1]++;
+    }
+    for (unsigned int v = 0; v < substringValues; v++) {
+      offsets[v + 1] += offsets[v];
+    }
+
+    std::vector<unsigned int> next(offsets, offsets + substringValues);
+    for (unsigned int i = 0; i < m_nbDescriptors; i++) {
+      ids[next[substring(m_descriptors + (size_t)i * m_descriptorSize, (unsigned int)t)]++] = i;
+    }
+  }
+}
+
+/*!
+  Compute a checksum of the descriptors, to check that a saved index matches
+  the descriptors.
+*/
+unsigned int vpHammingIndex::checksum(const unsigned char *descriptors, unsigned int nbDescriptors,
+                                      unsigned int descriptorSize)
+{
+  // FNV-1a
+  uint32_t hash = 2166136261U;
+  const size_t size = (size_t)nbDescriptors * descriptorSize;
+  for (size_t i = 0; i < size; i++) {
+    hash = (hash ^ descriptors[i]) * 16777619U;
+  }
+  return hash;
+}
+
+/*!
+  Remove all the descriptors from the index.
+*/
+void vpHammingIndex::clear()
+{
+  m_descriptors = NULL;
+  m_nbDescriptors = 0;
+  m_descriptorSize = 0;
+  m_nbTables = 0;
+  m_offsets.clear();
+  m_ids.clear();
+}
+
+/*!
+  Return the number of different bits between two descriptors.
+*/
+unsigned int vpHammingIndex::hammingDistance(const unsigned char *descriptor1, const unsigned char *descriptor2,
+                                             unsigned int descriptorSize)
+{
+  unsigned int distance = 0;
+  unsigned int i = 0;
+#if defined(__GNUC__)
+  for (; i + sizeof(unsigned int) <= descriptorSize; i += sizeof(unsigned int)) {
+    unsigned int value1, value2;
+    memcpy(&value1, descriptor1 + i, sizeof(unsigned int));
+    memcpy(&value2, descriptor2 + i, sizeof(unsigned int));
+    distance += (unsigned int)__builtin_popcount(value1 ^ value2);
+  }
+#endif
+  for (; i < descriptorSize; i++) {
+    unsigned int value = (unsigned int)(descriptor1[i] ^ descriptor2[i]);
+    for (; value != 0; value &= value - 1) {
+      distance++;
+    }
+  }
+  return distance;
+}
+
+/*!
+  Search the k nearest neighbours of query descriptors. The queries are
+  processed in parallel when OpenMP is available.
+
+  \param queries : Contiguous array of \e nbQueries descriptors of
+  getDescriptorSize() bytes.
+  \param nbQueries : Number of query descriptors.
+  \param k : Number of neighbours to search.
+  \param indices : Indexes of the k nearest neighbours of each query, by
+  increasing distance: the neighbours of the query \e i are in
+  indices[k*i] to indices[k*i+k-1]. When less than k neighbours are found,
+  the remaining indexes are set to std::numeric_limits<unsigned int>::max().
+  \param distances : Hamming distances to the neighbours, with the same
+  layout as \e indices.
+*/
+void vpHammingIndex::knnSearch(const unsigned char *queries, unsigned int nbQueries, unsigned int k,
+                               std::vector<unsigned int> &indices, std::vector<unsigned int> &distances) const
+{
+  const unsigned int invalid = std::numeric_limits<unsigned int>::max();
+  indices.assign((size_t)nbQueries * k, invalid);
+  distances.assign((size_t)nbQueries * k, invalid);
+  if (k == 0 || m_nbDescriptors == 0) {
+    return;
+  }
+
+#ifdef VISP_HAVE_OPENMP
+#pragma omp parallel
+#endif
+  {
+    std::vector<unsigned int> candidates;
+    std::vector<unsigned int> probes;
+
+#ifdef VISP_HAVE_OPENMP
+#pragma omp for schedule(dynamic, 16)
+#endif
+    for (int q = 0; q < (int)nbQueries; q++) {
+      const unsigned char *query = queries + (size_t)q * m_descriptorSize;
+
+      // Descriptors sharing a substring close to a substring of the query
+      candidates.clear();
+      for (unsigned int t = 0; t < m_nbTables; t++) {
+        const unsigned int value = substring(query, t);
+        probes.clear();
+        probes.push_back(value);
+        for (unsigned int b1 = 0; b1 < 16 && m_probeRadius >= 1; b1++) {
+          probes.push_back(value ^ (1U << b1));
+          for (unsigned int b2 = b1 + 1; b2 < 16 && m_probeRadius >= 2; b2++) {
+            probes.push_back(value ^ (1U << b1) ^ (1U << b2));
+          }
+        }
+
+        const unsigned int *offsets = &m_offsets[(size_t)t * (substringValues + 1)];
+        const unsigned int *ids = &m_ids[(size_t)t * m_nbDescriptors];
+        for (size_t p = 0; p < probes.size(); p++) {
+          candidates.insert(candidates.end(), ids + offsets[probes[p]], ids + offsets[probes[p] + 1]);
+        }
+      }
+      std::sort(candidates.begin(), candidates.end());
+      candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+      unsigned int *queryIndices = &indices[(size_t)q * k];
+      unsigned int *queryDistances = &distances[(size_t)q * k];
+      for (size_t c = 0; c < candidates.size(); c++) {
+        const unsigned int distance =
+            hammingDistance(query, m_descriptors + (size_t)candidates[c] * m_descriptorSize, m_descriptorSize);
+        insertNeighbour(candidates[c], distance, k, queryIndices, queryDistances);
+      }
+    }
+  }
+}
+
+/*!
+  Load the hash tables saved with save() instead of building them.
+
+  \param filename : Path of the index file.
+  \param descriptors, nbDescriptors, descriptorSize : Descriptors, see
+  build(). They must be the ones that were indexed when the index was saved.
+
+  \exception vpException::ioError : If the file cannot be read or if it does
+  not match the descriptors.
+*/
+void vpHammingIndex::load(const std::string &filename, const unsigned char *descriptors, unsigned int nbDescriptors,
+                          unsigned int descriptorSize)
+{
+  std::ifstream file(filename.c_str(), std::ifstream::binary);
+  if (!file.is_open()) {
+    throw(vpException(vpException::ioError, "Cannot open the file %s", filename.c_str()));
+  }
+
+  char magic[sizeof(hammingIndexMagic)];
+  file.read(magic, sizeof(magic));
+  uint32_t version = 0, nbDescriptorsSaved = 0, descriptorSizeSaved = 0, nbTables = 0, checksumSaved = 0;
+  vpIoTools::readBinaryValueLE(file, version);
+  vpIoTools::readBinaryValueLE(file, nbDescriptorsSaved);
+  vpIoTools::readBinaryValueLE(file, descriptorSizeSaved);
+  vpIoTools::readBinaryValueLE(file, nbTables);
+  vpIoTools::readBinaryValueLE(file, checksumSaved);
+  if (!file || memcmp(magic, hammingIndexMagic, sizeof(magic)) != 0 || version != hammingIndexVersion) {
+    throw(vpException(vpException::ioError, "The file %s is not a Hamming index", filename.c_str()));
+  }
+  if (nbDescriptorsSaved != nbDescriptors || descriptorSizeSaved != descriptorSize ||
+      nbTables != (descriptorSize + substringSize - 1) / substringSize ||
+      checksumSaved != checksum(descriptors, nbDescriptors, descriptorSize)) {
+    throw(vpException(vpException::ioError, "The Hamming index %s does not match the descriptors",
+                      filename.c_str()));
+  }
+
+  clear();
+  std::vector<unsigned int> offsets((size_t)nbTables * (substringValues + 1));
+  std::vector<unsigned int> ids((size_t)nbTables * nbDescriptors);
+  readArray(file, offsets);
+  readArray(file, ids);
+  if (!file) {
+    throw(vpException(vpException::ioError, "Cannot read the Hamming index %s", filename.c_str()));
+  }
+  for (unsigned int t = 0; t < nbTables; t++) {
+    if (offsets[(size_t)t * (substringValues + 1) + substringValues] != nbDescriptors) {
+      throw(vpException(vpException::ioError, "The Hamming index %s is corrupted", filename.c_str()));
+    }
+  }
+
+  m_descriptors = descriptors;
+  m_nbDescriptors = nbDescriptors;
+  m_descriptorSize = descriptorSize;
+  m_nbTables = nbTables;
+  m_offsets.swap(offsets);
+  m_ids.swap(ids);
+}
+
+/*!
+  Save the hash tables in a file, to be loaded with load().
+
+  \param filename : Path of the index file.
+*/
+void vpHammingIndex::save(const std::string &filename) const
+{
+  std::ofstream file(filename.c_str(), std::ofstream::binary);
+  if (!file.is_open()) {
+    throw(vpException(vpException::ioError, "Cannot create the file %s", filename.c_str()));
+  }
+
+  file.write(hammingIndexMagic, sizeof(hammingIndexMagic));
+  vpIoTools::writeBinaryValueLE(file, hammingIndexVersion);
+  vpIoTools::writeBinaryValueLE(file, (uint32_t)m_nbDescriptors);
+  vpIoTools::writeBinaryValueLE(file, (uint32_t)m_descriptorSize);
+  vpIoTools::writeBinaryValueLE(file, (uint32_t)m_nbTables);
+  vpIoTools::writeBinaryValueLE(file, (uint32_t)checksum(m_descriptors, m_nbDescriptors, m_descriptorSize));
+  writeArray(file, m_offsets);
+  writeArray(file, m_ids);
+  if (!file) {
+    throw(vpException(vpException::ioError, "Cannot write the file %s", filename.c_str()));
+  }
+}
+
+/*!
+  Set the number of bits, between 0 and 2, by which the substrings of a
+  query are changed to find the candidate descriptors. A larger radius finds
+  farther neighbours but computes the distance to more candidates.
+
+  \exception vpException::badValue : If the radius is greater than 2.
+*/
+void vpHammingIndex::setProbeRadius(unsigned int radius)
+{
+  if (radius > 2) {
+    throw(vpException(vpException::badValue, "The probe radius must be lower or equal to 2"));
+  }
+  m_probeRadius = radius;
+}
+
+/*!
+  Value of the substring \e table of a descriptor.
+*/
+unsigned int vpHammingIndex::substring(const unsigned char *descriptor, unsigned int table) const
+{
+  const unsigned int i = table * substringSize;
+  return (unsigned int)descriptor[i] | (i + 1 < m_descriptorSize ? (unsigned int)descriptor[i + 1] << 8 : 0U);
+}
@@ -36,12 +36,18 @@
  *
  *****************************************************************************/
 
+#include <cstring>
 #include <iomanip>
 #include <limits>
 
 #include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpTracing.h>
 #include <visp3/vision/vpKeyPoint.h>
 
+#ifdef VISP_HAVE_OPENMP
+#include <omp.h>
+#endif
+
 #if (VISP_HAVE_OPENCV_VERSION >= 0x020101)
 
 #if (VISP_HAVE_OPENCV_VERSION >= 0x030000)
@@ -65,6 +71,50 @@ inline vpImagePoint matchRansacToVpImage(const std::pair<cv::KeyPoint, cv::Point
   return vpImagePoint(pair.first.pt.y, pair.first.pt.x);
 }
 
+// Memory-mapped learning data format, see vpKeyPoint::saveMappedLearningData()
+const char mappedLearningDataMagic[8] = {'V', 'P', 'K', 'P', 'D', 'B', '\0', '\0'};
+const uint32_t mappedLearningDataVersion = 1;
+const uint32_t mappedLearningDataHeaderSize = 128;
+const uint64_t mappedLearningDataImageEntrySize = 32;
+
+inline uint64_t alignOffset(uint64_t offset, uint64_t alignment)
+{
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+void writePadding(std::ofstream &file, uint64_t offset)
+{
+  while ((uint64_t)(std::streamoff)file.tellp() < offset) {
+    file.put('\0');
+  }
+}
+
+void writeOffset(std::ofstream &file, uint64_t offset)
+{
+  vpIoTools::writeBinaryValueLE(file, (uint32_t)(offset & 0xFFFFFFFF));
+  vpIoTools::writeBinaryValueLE(file, (uint32_t)(offset >> 32));
+}
+
+template <typename Type> inline Type readMappedValue(const unsigned char *data, size_t index = 0)
+{
+  Type value;
+  memcpy(&value, data + index * sizeof(Type), sizeof(Type));
+  return value;
+}
+
+inline uint64_t readMappedOffset(const unsigned char *data)
+{
+  return (uint64_t)readMappedValue<uint32_t>(data) | ((uint64_t)readMappedValue<uint32_t>(data + 4) << 32);
+}
+
+// The memory-mapped learning data are little endian and used without
+// conversion
+inline bool isBigEndian()
+{
+  const uint16_t one = 1;
+  return *(const unsigned char *)&one == 0;
+}
+
 }
 
 /*!
@@ -78,13 +128,16 @@ inline vpImagePoint matchRansacToVpImage(const std::pair<cv::KeyPoint, cv::Point
  */
 vpKeyPoint::vpKeyPoint(const vpFeatureDetectorType &detectorType, const vpFeatureDescriptorType &descriptorType,
                        const std::string &matcherName, const vpFilterMatchingType &filterType)
-  : m_computeCovariance(false), m_covarianceMatrix(), m_currentImageId(0), m_detectionMethod(detectionScore),
+  : m_affineDetectionNbThreads(0), m_computeCovariance(false), m_covarianceMatrix(), m_currentImageId(0),
+    m_detectionMethod(detectionScore),
     m_detectionScore(0.15), m_detectionThreshold(100.0), m_detectionTime(0.), m_detectorNames(), m_detectors(),
     m_extractionTime(0.), m_extractorNames(), m_extractors(), m_filteredMatches(), m_filterType(filterType),
-    m_imageFormat(jpgImageFormat), m_knnMatches(), m_mapOfImageId(), m_mapOfImages(), m_matcher(),
-    m_matcherName(matcherName), m_matches(), m_matchingFactorThreshold(2.0), m_matchingRatioThreshold(0.85),
-    m_matchingTime(0.), m_matchRansacKeyPointsToPoints(), m_nbRansacIterations(200), m_nbRansacMinInlierCount(100),
-    m_objectFilteredPoints(), m_poseTime(0.), m_queryDescriptors(), m_queryFilteredKeyPoints(), m_queryKeyPoints(),
+    m_hammingIndex(), m_imageFormat(jpgImageFormat), m_indexMatcher(), m_knnMatches(), m_mapOfImageId(),
+    m_mapOfImages(), m_mappedLearningData(),
+    m_matcher(), m_matcherName(matcherName), m_matches(), m_matchingFactorThreshold(2.0),
+    m_matchingRatioThreshold(0.85), m_matchingTime(0.), m_matchRansacKeyPointsToPoints(), m_nbRansacIterations(200),
+    m_nbRansacMinInlierCount(100), m_objectFilteredPoints(), m_poseTime(0.), m_queryDescriptors(),
+    m_queryFilteredKeyPoints(), m_queryKeyPoints(),
     m_ransacConsensusPercentage(20.0), m_ransacFilterFlag(vpPose::NO_FILTER), m_ransacInliers(), m_ransacOutliers(),
     m_ransacParallel(false), m_ransacParallelNbThreads(0), m_ransacReprojectionError(6.0),
     m_ransacThreshold(0.01), m_trainDescriptors(), m_trainKeyPoints(), m_trainPoints(), m_trainVpPoints(),
@@ -92,8 +145,8 @@ vpKeyPoint::vpKeyPoint(const vpFeatureDetectorType &detectorType, const vpFeatur
 #if (VISP_HAVE_OPENCV_VERSION >= 0x020400 && VISP_HAVE_OPENCV_VERSION < 0x030000)
     m_useBruteForceCrossCheck(true),
 #endif
-    m_useConsensusPercentage(false), m_useKnn(false), m_useMatchTrainToQuery(false), m_useRansacVVS(true),
-    m_useSingleMatchFilter(true)
+    m_useConsensusPercentage(false), m_useKnn(false), m_useMatchingIndex(false), m_useMatchTrainToQuery(false),
+    m_useRansacVVS(true), m_useSingleMatchFilter(true)
 {
   initFeatureNames();
 
@@ -114,13 +167,16 @@ vpKeyPoint::vpKeyPoint(const vpFeatureDetectorType &detectorType, const vpFeatur
  */
 vpKeyPoint::vpKeyPoint(const std::string &detectorName, const std::string &extractorName,
                        const std::string &matcherName, const vpFilterMatchingType &filterType)
-  : m_computeCovariance(false), m_covarianceMatrix(), m_currentImageId(0), m_detectionMethod(detectionScore),
+  : m_affineDetectionNbThreads(0), m_computeCovariance(false), m_covarianceMatrix(), m_currentImageId(0),
+    m_detectionMethod(detectionScore),
     m_detectionScore(0.15), m_detectionThreshold(100.0), m_detectionTime(0.), m_detectorNames(), m_detectors(),
     m_extractionTime(0.), m_extractorNames(), m_extractors(), m_filteredMatches(), m_filterType(filterType),
-    m_imageFormat(jpgImageFormat), m_knnMatches(), m_mapOfImageId(), m_mapOfImages(), m_matcher(),
-    m_matcherName(matcherName), m_matches(), m_matchingFactorThreshold(2.0), m_matchingRatioThreshold(0.85),
-    m_matchingTime(0.), m_matchRansacKeyPointsToPoints(), m_nbRansacIterations(200), m_nbRansacMinInlierCount(100),
-    m_objectFilteredPoints(), m_poseTime(0.), m_queryDescriptors(), m_queryFilteredKeyPoints(), m_queryKeyPoints(),
+    m_hammingIndex(), m_imageFormat(jpgImageFormat), m_indexMatcher(), m_knnMatches(), m_mapOfImageId(),
+    m_mapOfImages(), m_mappedLearningData(),
+    m_matcher(), m_matcherName(matcherName), m_matches(), m_matchingFactorThreshold(2.0),
+    m_matchingRatioThreshold(0.85), m_matchingTime(0.), m_matchRansacKeyPointsToPoints(), m_nbRansacIterations(200),
+    m_nbRansacMinInlierCount(100), m_objectFilteredPoints(), m_poseTime(0.), m_queryDescriptors(),
+    m_queryFilteredKeyPoints(), m_queryKeyPoints(),
     m_ransacConsensusPercentage(20.0), m_ransacFilterFlag(vpPose::NO_FILTER), m_ransacInliers(), m_ransacOutliers(),
     m_ransacParallel(false), m_ransacParallelNbThreads(0), m_ransacReprojectionError(6.0),
     m_ransacThreshold(0.01), m_trainDescriptors(), m_trainKeyPoints(), m_trainPoints(), m_trainVpPoints(),
@@ -128,8 +184,8 @@ vpKeyPoint::vpKeyPoint(const std::string &detectorName, const std::string &extra
 #if (VISP_HAVE_OPENCV_VERSION >= 0x020400 && VISP_HAVE_OPENCV_VERSION < 0x030000)
     m_useBruteForceCrossCheck(true),
 #endif
-    m_useConsensusPercentage(false), m_useKnn(false), m_useMatchTrainToQuery(false), m_useRansacVVS(true),
-    m_useSingleMatchFilter(true)
+    m_useConsensusPercentage(false), m_useKnn(false), m_useMatchingIndex(false), m_useMatchTrainToQuery(false),
+    m_useRansacVVS(true), m_useSingleMatchFilter(true)
 {
   initFeatureNames();
 
@@ -150,11 +206,13 @@ vpKeyPoint::vpKeyPoint(const std::string &detectorName, const std::string &extra
  */
 vpKeyPoint::vpKeyPoint(const std::vector<std::string> &detectorNames, const std::vector<std::string> &extractorNames,
                        const std::string &matcherName, const vpFilterMatchingType &filterType)
-  : m_computeCovariance(false), m_covarianceMatrix(), m_currentImageId(0), m_detectionMethod(detectionScore),
+  : m_affineDetectionNbThreads(0), m_computeCovariance(false), m_covarianceMatrix(), m_currentImageId(0),
+    m_detectionMethod(detectionScore),
     m_detectionScore(0.15), m_detectionThreshold(100.0), m_detectionTime(0.), m_detectorNames(detectorNames),
     m_detectors(), m_extractionTime(0.), m_extractorNames(extractorNames), m_extractors(), m_filteredMatches(),
-    m_filterType(filterType), m_imageFormat(jpgImageFormat), m_knnMatches(), m_mapOfImageId(), m_mapOfImages(),
-    m_matcher(), m_matcherName(matcherName), m_matches(), m_matchingFactorThreshold(2.0),
+    m_filterType(filterType), m_hammingIndex(), m_imageFormat(jpgImageFormat), m_indexMatcher(), m_knnMatches(),
+    m_mapOfImageId(), m_mapOfImages(),
+    m_mappedLearningData(), m_matcher(), m_matcherName(matcherName), m_matches(), m_matchingFactorThreshold(2.0),
     m_matchingRatioThreshold(0.85), m_matchingTime(0.), m_matchRansacKeyPointsToPoints(), m_nbRansacIterations(200),
     m_nbRansacMinInlierCount(100), m_objectFilteredPoints(), m_poseTime(0.), m_queryDescriptors(),
     m_queryFilteredKeyPoints(), m_queryKeyPoints(), m_ransacConsensusPercentage(20.0), m_ransacFilterFlag(vpPose::NO_FILTER), m_ransacInliers(),
@@ -163,8 +221,8 @@ vpKeyPoint::vpKeyPoint(const std::vector<std::string> &detectorNames, const std:
 #if (VISP_HAVE_OPENCV_VERSION >= 0x020400 && VISP_HAVE_OPENCV_VERSION < 0x030000)
     m_useBruteForceCrossCheck(true),
 #endif
-    m_useConsensusPercentage(false), m_useKnn(false), m_useMatchTrainToQuery(false), m_useRansacVVS(true),
-    m_useSingleMatchFilter(true)
+    m_useConsensusPercentage(false), m_useKnn(false), m_useMatchingIndex(false), m_useMatchTrainToQuery(false),
+    m_useRansacVVS(true), m_useSingleMatchFilter(true)
 {
   initFeatureNames();
   init();
@@ -310,9 +368,12 @@ unsigned int vpKeyPoint::buildReference(const vpImage<unsigned char> &I, const v
 
   _reference_computed = true;
 
+  releaseMappedLearningData();
+
   // Add train descriptors in matcher object
   m_matcher->clear();
   m_matcher->add(std::vector<cv::Mat>(1, m_trainDescriptors));
+  buildMatchingIndex();
 
   return static_cast<unsigned int>(m_trainKeyPoints.size());
 }
@@ -419,13 +480,47 @@ void vpKeyPoint::buildReference(const vpImage<unsigned char> &I, const std::vect
   vpConvert::convertFromOpenCV(this->m_trainKeyPoints, referenceImagePointsList);
   vpConvert::convertFromOpenCV(this->m_trainPoints, m_trainVpPoints);
 
+  releaseMappedLearningData();
+
   // Add train descriptors in matcher object
   m_matcher->clear();
   m_matcher->add(std::vector<cv::Mat>(1, m_trainDescriptors));
+  buildMatchingIndex();
 
   _reference_computed = true;
 }
 
+/*!
+   Build the index of the train descriptors used to speed up the matching
+   (see setUseMatchingIndex()).
+ */
+void vpKeyPoint::buildMatchingIndex()
+{
+  m_hammingIndex.clear();
+  m_indexMatcher = cv::Ptr<cv::DescriptorMatcher>();
+  if (!m_useMatchingIndex || m_trainDescriptors.empty()) {
+    return;
+  }
+
+  if (m_trainDescriptors.type() == CV_8U) {
+    // The index needs contiguous descriptors
+    if (!m_trainDescriptors.isContinuous()) {
+      m_trainDescriptors = m_trainDescriptors.clone();
+    }
+    m_hammingIndex.build(m_trainDescriptors.data, (unsigned int)m_trainDescriptors.rows,
+                         (unsigned int)m_trainDescriptors.cols);
+  } else if (m_trainDescriptors.type() == CV_32F) {
+    // Randomized k-d forest
+#if (VISP_HAVE_OPENCV_VERSION >= 0x030000)
+    m_indexMatcher = cv::makePtr<cv::FlannBasedMatcher>(cv::makePtr<cv::flann::KDTreeIndexParams>(4));
+#else
+    m_indexMatcher = new cv::FlannBasedMatcher(new cv::flann::KDTreeIndexParams(4));
+#endif
+    m_indexMatcher->add(std::vector<cv::Mat>(1, m_trainDescriptors));
+    m_indexMatcher->train();
+  }
+}
+
 /*!
    Compute the 3D coordinate in the world/object frame given the 2D image
    coordinate and under the assumption that the point is located on a plane
@@ -535,7 +630,6 @@ void vpKeyPoint::compute3DForPointsInPolygons(const vpHomogeneousMatrix &cMo, co
   std::vector<cv::KeyPoint> candidatesToCheck = candidates;
   candidates.clear();
   points.clear();
-  vpImagePoint imPt;
   cv::Point3f pt;
   cv::Mat desc;
 
@@ -544,28 +638,34 @@ void vpKeyPoint::compute3DForPointsInPolygons(const vpHomogeneousMatrix &cMo, co
     pairOfCandidatesToCheck[i] = std::pair<cv::KeyPoint, size_t>(candidatesToCheck[i], i);
   }
 
+  std::vector<vpImagePoint> imPts;
+  std::vector<bool> inside;
+  std::vector<std::pair<cv::KeyPoint, size_t> > remainingCandidates;
   size_t cpt1 = 0;
-  std::vector<vpPolygon> polygons_tmp = polygons;
-  for (std::vector<vpPolygon>::iterator it1 = polygons_tmp.begin(); it1 != polygons_tmp.end(); ++it1, cpt1++) {
-    std::vector<std::pair<cv::KeyPoint, size_t> >::iterator it2 = pairOfCandidatesToCheck.begin();
-
-    while (it2 != pairOfCandidatesToCheck.end()) {
-      imPt.set_ij(it2->first.pt.y, it2->first.pt.x);
-      if (it1->isInside(imPt)) {
-        candidates.push_back(it2->first);
-        vpKeyPoint::compute3D(it2->first, roisPt[cpt1], cam, cMo, pt);
+  for (std::vector<vpPolygon>::const_iterator it1 = polygons.begin(); it1 != polygons.end(); ++it1, cpt1++) {
+    imPts.resize(pairOfCandidatesToCheck.size());
+    for (size_t i = 0; i < pairOfCandidatesToCheck.size(); i++) {
+      imPts[i].set_ij(pairOfCandidatesToCheck[i].first.pt.y, pairOfCandidatesToCheck[i].first.pt.x);
+    }
+    // Test all the remaining candidates at once
+    it1->isInside(imPts, inside);
+
+    remainingCandidates.clear();
+    for (size_t i = 0; i < pairOfCandidatesToCheck.size(); i++) {
+      if (inside[i]) {
+        candidates.push_back(pairOfCandidatesToCheck[i].first);
+        vpKeyPoint::compute3D(pairOfCandidatesToCheck[i].first, roisPt[cpt1], cam, cMo, pt);
         points.push_back(pt);
 
         if (descriptors != NULL) {
-          desc.push_back(descriptors->row((int)it2->second));
+          desc.push_back(descriptors->row((int)pairOfCandidatesToCheck[i].second));
         }
-
-        // Remove candidate keypoint which is located on the current polygon
-        it2 = pairOfCandidatesToCheck.erase(it2);
       } else {
-        ++it2;
+        // Keep only candidate keypoints not located on the current polygon
+        remainingCandidates.push_back(pairOfCandidatesToCheck[i]);
       }
     }
+    pairOfCandidatesToCheck.swap(remainingCandidates);
   }
 
   if (descriptors != NULL) {
@@ -607,27 +707,34 @@ void vpKeyPoint::compute3DForPointsInPolygons(const vpHomogeneousMatrix &cMo, co
     pairOfCandidatesToCheck[i] = std::pair<vpImagePoint, size_t>(candidatesToCheck[i], i);
   }
 
+  std::vector<vpImagePoint> imPts;
+  std::vector<bool> inside;
+  std::vector<std::pair<vpImagePoint, size_t> > remainingCandidates;
   size_t cpt1 = 0;
-  std::vector<vpPolygon> polygons_tmp = polygons;
-  for (std::vector<vpPolygon>::iterator it1 = polygons_tmp.begin(); it1 != polygons_tmp.end(); ++it1, cpt1++) {
-    std::vector<std::pair<vpImagePoint, size_t> >::iterator it2 = pairOfCandidatesToCheck.begin();
-
-    while (it2 != pairOfCandidatesToCheck.end()) {
-      if (it1->isInside(it2->first)) {
-        candidates.push_back(it2->first);
-        vpKeyPoint::compute3D(it2->first, roisPt[cpt1], cam, cMo, pt);
+  for (std::vector<vpPolygon>::const_iterator it1 = polygons.begin(); it1 != polygons.end(); ++it1, cpt1++) {
+    imPts.resize(pairOfCandidatesToCheck.size());
+    for (size_t i = 0; i < pairOfCandidatesToCheck.size(); i++) {
+      imPts[i] = pairOfCandidatesToCheck[i].first;
+    }
+    // Test all the remaining candidates at once
+    it1->isInside(imPts, inside);
+
+    remainingCandidates.clear();
+    for (size_t i = 0; i < pairOfCandidatesToCheck.size(); i++) {
+      if (inside[i]) {
+        candidates.push_back(pairOfCandidatesToCheck[i].first);
+        vpKeyPoint::compute3D(pairOfCandidatesToCheck[i].first, roisPt[cpt1], cam, cMo, pt);
         points.push_back(pt);
 
         if (descriptors != NULL) {
-          desc.push_back(descriptors->row((int)it2->second));
+          desc.push_back(descriptors->row((int)pairOfCandidatesToCheck[i].second));
         }
-
-        // Remove candidate keypoint which is located on the current polygon
-        it2 = pairOfCandidatesToCheck.erase(it2);
       } else {
-        ++it2;
+        // Keep only candidate keypoints not located on the current polygon
+        remainingCandidates.push_back(pairOfCandidatesToCheck[i]);
       }
     }
+    pairOfCandidatesToCheck.swap(remainingCandidates);
   }
 }
 
@@ -1014,6 +1121,23 @@ double vpKeyPoint::computePoseEstimationError(const std::vector<std::pair<cv::Ke
   return std::accumulate(errors.begin(), errors.end(), 0.0) / errors.size();
 }
 
+/*!
+   Convert a learning file saved with saveLearningData() into the
+   memory-mapped format of saveMappedLearningData().
+
+   \param filename : Path of the learning file to convert.
+   \param binaryMode : If true, the learning file is in a binary mode,
+   otherwise it is in XML mode.
+   \param mappedFilename : Path of the memory-mapped learning file to create.
+ */
+void vpKeyPoint::convertLearningData(const std::string &filename, const bool binaryMode,
+                                     const std::string &mappedFilename)
+{
+  vpKeyPoint keyPoint;
+  keyPoint.loadLearningData(filename, binaryMode);
+  keyPoint.saveMappedLearningData(mappedFilename);
+}
+
 /*!
    Initialize the size of the matching image (case with a matching side by
    side between IRef and ICurrent).
@@ -1152,6 +1276,7 @@ void vpKeyPoint::detect(const vpImage<unsigned char> &I, std::vector<cv::KeyPoin
 void vpKeyPoint::detect(const cv::Mat &matImg, std::vector<cv::KeyPoint> &keyPoints, double &elapsedTime,
                         const cv::Mat &mask)
 {
+  VP_TRACING_SCOPE("vpKeyPoint::detect");
   double t = vpTime::measureTimeMs();
   keyPoints.clear();
 
@@ -1426,6 +1551,7 @@ void vpKeyPoint::extract(const vpImage<unsigned char> &I, std::vector<cv::KeyPoi
 void vpKeyPoint::extract(const cv::Mat &matImg, std::vector<cv::KeyPoint> &keyPoints, cv::Mat &descriptors,
                          double &elapsedTime, std::vector<cv::Point3f> *trainPoints)
 {
+  VP_TRACING_SCOPE("vpKeyPoint::extract");
   double t = vpTime::measureTimeMs();
   bool first = true;
 
@@ -1539,13 +1665,18 @@ void vpKeyPoint::filterMatches()
     // error under Windows. To fix it we have to add #undef max
     double min_dist = DBL_MAX;
     double mean = 0.0;
-    std::vector<double> distance_vec(m_knnMatches.size());
+    std::vector<double> distance_vec;
 
     if (m_filterType == stdAndRatioDistanceThreshold) {
+      distance_vec.reserve(m_knnMatches.size());
       for (size_t i = 0; i < m_knnMatches.size(); i++) {
+        // The index of the train descriptors may find no neighbor
+        if (m_knnMatches[i].empty()) {
+          continue;
+        }
         double dist = m_knnMatches[i][0].distance;
         mean += dist;
-        distance_vec[i] = dist;
+        distance_vec.push_back(dist);
 
         if (dist < min_dist) {
           min_dist = dist;
@@ -1554,12 +1685,15 @@ void vpKeyPoint::filterMatches()
         //  max_dist = dist;
         //}
       }
-      mean /= m_queryDescriptors.rows;
     }
 
-    double sq_sum = std::inner_product(distance_vec.begin(), distance_vec.end(), distance_vec.begin(), 0.0);
-    double stdev = std::sqrt(sq_sum / distance_vec.size() - mean * mean);
-    double threshold = min_dist + stdev;
+    double threshold = min_dist;
+    if (!distance_vec.empty()) {
+      mean /= distance_vec.size();
+      double sq_sum = std::inner_product(distance_vec.begin(), distance_vec.end(), distance_vec.begin(), 0.0);
+      double stdev = std::sqrt(sq_sum / distance_vec.size() - mean * mean);
+      threshold += stdev;
+    }
 
     for (size_t i = 0; i < m_knnMatches.size(); i++) {
       if (m_knnMatches[i].size() >= 2) {
@@ -1601,10 +1735,15 @@ void vpKeyPoint::filterMatches()
       //  max_dist = dist;
       // }
     }
-    mean /= m_queryDescriptors.rows;
 
-    double sq_sum = std::inner_product(distance_vec.begin(), distance_vec.end(), distance_vec.begin(), 0.0);
-    double stdev = std::sqrt(sq_sum / distance_vec.size() - mean * mean);
+    // With the index of the train descriptors, only the query descriptors
+    // that found a neighbor are matched
+    double stdev = 0;
+    if (!distance_vec.empty()) {
+      mean /= distance_vec.size();
+      double sq_sum = std::inner_product(distance_vec.begin(), distance_vec.end(), distance_vec.begin(), 0.0);
+      stdev = std::sqrt(sq_sum / distance_vec.size() - mean * mean);
+    }
 
     // Define a threshold where we keep all keypoints whose the descriptor
     // distance falls below a factor of the  minimum descriptor distance (for
@@ -1661,6 +1800,31 @@ void vpKeyPoint::filterMatches()
   }
 }
 
+/*!
+   Get the max keypoint class id and the max training image id, used to
+   append learning data to the current ones.
+ */
+void vpKeyPoint::getLearningDataStartIds(int &startClassId, int &startImageId) const
+{
+  startClassId = 0;
+  startImageId = 0;
+
+  // Find the max index of keypoint class Id
+  for (std::map<int, int>::const_iterator it = m_mapOfImageId.begin(); it != m_mapOfImageId.end(); ++it) {
+    if (startClassId < it->first) {
+      startClassId = it->first;
+    }
+  }
+
+  // Find the max index of images Id
+  for (std::map<int, vpImage<unsigned char> >::const_iterator it = m_mapOfImages.begin(); it != m_mapOfImages.end();
+       ++it) {
+    if (startImageId < it->first) {
+      startImageId = it->first;
+    }
+  }
+}
+
 /*!
    Get the 3D coordinates of the object points matched (the corresponding 3D
    coordinates in the object frame of the keypoints detected in the current
@@ -2404,20 +2568,7 @@ void vpKeyPoint::loadLearningData(const std::string &filename, const bool binary
     m_mapOfImageId.clear();
     m_mapOfImages.clear();
   } else {
-    // In append case, find the max index of keypoint class Id
-    for (std::map<int, int>::const_iterator it = m_mapOfImageId.begin(); it != m_mapOfImageId.end(); ++it) {
-      if (startClassId < it->first) {
-        startClassId = it->first;
-      }
-    }
-
-    // In append case, find the max index of images Id
-    for (std::map<int, vpImage<unsigned char> >::const_iterator it = m_mapOfImages.begin(); it != m_mapOfImages.end();
-         ++it) {
-      if (startImageId < it->first) {
-        startImageId = it->first;
-      }
-    }
+    getLearningDataStartIds(startClassId, startImageId);
   }
 
   // Get parent directory
@@ -2804,9 +2955,12 @@ void vpKeyPoint::loadLearningData(const std::string &filename, const bool binary
   vpConvert::convertFromOpenCV(m_trainKeyPoints, referenceImagePointsList);
   vpConvert::convertFromOpenCV(this->m_trainPoints, m_trainVpPoints);
 
+  releaseMappedLearningData();
+
   // Add train descriptors in matcher object
   m_matcher->clear();
   m_matcher->add(std::vector<cv::Mat>(1, m_trainDescriptors));
+  buildMatchingIndex();
 
   // Set _reference_computed to true as we load a learning file
   _reference_computed = true;
@@ -2815,6 +2969,178 @@ void vpKeyPoint::loadLearningData(const std::string &filename, const bool binary
   m_currentImageId = (int)m_mapOfImages.size();
 }
 
+/*!
+   Load learning data saved with saveMappedLearningData().
+
+   The file is mapped in memory (see vpMappedFile) instead of being parsed:
+   the keypoints, the 3D points and the training images are copied from the
+   mapping and the train descriptors directly use the mapped memory, which is
+   kept as long as they are used. The train descriptors returned by
+   getTrainDescriptors() must then not be used after the next call to
+   buildReference(), loadLearningData(), loadMappedLearningData() or
+   reset().
+
+   \param filename : Path of the memory-mapped learning file.
+   \param append : If true, concatenate the learning data, otherwise reset
+   the variables.
+
+   \exception vpException::ioError : If the file cannot be open or is not a
+   valid learning file.
+   \exception vpException::notImplementedError : On big endian platforms.
+ */
+void vpKeyPoint::loadMappedLearningData(const std::string &filename, const bool append)
+{
+  if (isBigEndian()) {
+    throw vpException(vpException::notImplementedError,
+                      "Memory-mapped learning data are not supported on big endian platforms.");
+  }
+
+  cv::Ptr<vpMappedFile> mappedFile(new vpMappedFile(filename));
+  const unsigned char *data = mappedFile->data();
+  const uint64_t fileSize = (uint64_t)mappedFile->size();
+
+  if (fileSize < mappedLearningDataHeaderSize ||
+      memcmp(data, mappedLearningDataMagic, sizeof(mappedLearningDataMagic)) != 0) {
+    throw vpException(vpException::ioError, "The file %s is not a memory-mapped learning file.", filename.c_str());
+  }
+  if (readMappedValue<uint32_t>(data + 8) != mappedLearningDataVersion) {
+    throw vpException(vpException::ioError, "Unsupported version of the memory-mapped learning file %s.",
+                      filename.c_str());
+  }
+
+  const uint64_t headerSize = readMappedValue<uint32_t>(data + 12);
+  const int nRows = readMappedValue<int32_t>(data + 16);
+  const int nCols = readMappedValue<int32_t>(data + 20);
+  const int descriptorType = readMappedValue<int32_t>(data + 24);
+  const bool have3DInfo = readMappedValue<int32_t>(data + 28) != 0;
+  const int nbImgs = readMappedValue<int32_t>(data + 32);
+  const uint64_t keyPointsOffset = readMappedOffset(data + 40);
+  const uint64_t descriptorsOffset = readMappedOffset(data + 48);
+  const uint64_t pointsOffset = readMappedOffset(data + 56);
+  const uint64_t imagesOffset = readMappedOffset(data + 64);
+
+  // Check that all the sections are in the file
+  const uint64_t keyPointsArraySize = alignOffset(4 * (uint64_t)nRows, 16);
+  const uint64_t descriptorsRowSize = (uint64_t)nCols * CV_ELEM_SIZE(descriptorType);
+  if (headerSize < mappedLearningDataHeaderSize || nRows < 0 || nCols < 0 || nbImgs < 0 ||
+      readMappedOffset(data + 72) != fileSize || keyPointsOffset < headerSize ||
+      keyPointsOffset + 8 * keyPointsArraySize > fileSize ||
+      descriptorsOffset + (uint64_t)nRows * descriptorsRowSize > fileSize ||
+      (have3DInfo && pointsOffset + (uint64_t)nRows * sizeof(cv::Point3f) > fileSize) ||
+      imagesOffset + (uint64_t)nbImgs * mappedLearningDataImageEntrySize > fileSize) {
+    throw vpException(vpException::ioError, "The memory-mapped learning file %s is corrupted.", filename.c_str());
+  }
+
+  int startClassId = 0;
+  int startImageId = 0;
+  if (!append) {
+    m_trainKeyPoints.clear();
+    m_trainPoints.clear();
+    m_mapOfImageId.clear();
+    m_mapOfImages.clear();
+  } else {
+    getLearningDataStartIds(startClassId, startImageId);
+  }
+
+  // Training images
+  for (int i = 0; i < nbImgs; i++) {
+    const unsigned char *entry = data + imagesOffset + (uint64_t)i * mappedLearningDataImageEntrySize;
+    const int id = readMappedValue<int32_t>(entry);
+    const unsigned int width = readMappedValue<uint32_t>(entry + 4);
+    const unsigned int height = readMappedValue<uint32_t>(entry + 8);
+    const uint64_t offset = readMappedOffset(entry + 16);
+    const uint64_t size = readMappedOffset(entry + 24);
+    if (size != (uint64_t)width * height || offset + size > fileSize) {
+      throw vpException(vpException::ioError, "The memory-mapped learning file %s is corrupted.", filename.c_str());
+    }
+
+    vpImage<unsigned char> &I = m_mapOfImages[id + startImageId];
+    I.resize(height, width);
+    memcpy(I.bitmap, data + offset, (size_t)size);
+  }
+
+  // Keypoints, stored as one array per field
+  const unsigned char *keyPoints = data + keyPointsOffset;
+  m_trainKeyPoints.reserve(m_trainKeyPoints.size() + (size_t)nRows);
+  for (int i = 0; i < nRows; i++) {
+    const size_t i_ = (size_t)i;
+    const float u = readMappedValue<float>(keyPoints, i_);
+    const float v = readMappedValue<float>(keyPoints + keyPointsArraySize, i_);
+    const float size = readMappedValue<float>(keyPoints + 2 * keyPointsArraySize, i_);
+    const float angle = readMappedValue<float>(keyPoints + 3 * keyPointsArraySize, i_);
+    const float response = readMappedValue<float>(keyPoints + 4 * keyPointsArraySize, i_);
+    const int octave = readMappedValue<int32_t>(keyPoints + 5 * keyPointsArraySize, i_);
+    const int class_id = readMappedValue<int32_t>(keyPoints + 6 * keyPointsArraySize, i_);
+    const int image_id = readMappedValue<int32_t>(keyPoints + 7 * keyPointsArraySize, i_);
+    m_trainKeyPoints.push_back(
+        cv::KeyPoint(cv::Point2f(u, v), size, angle, response, octave, (class_id + startClassId)));
+
+    // No training images if image_id == -1
+    if (image_id != -1) {
+      m_mapOfImageId[m_trainKeyPoints.back().class_id] = image_id + startImageId;
+    }
+  }
+
+  if (have3DInfo) {
+    const cv::Point3f *points = reinterpret_cast<const cv::Point3f *>(data + pointsOffset);
+    m_trainPoints.insert(m_trainPoints.end(), points, points + nRows);
+  }
+
+  // The descriptors are not copied but use the mapped memory
+  cv::Mat trainDescriptorsTmp(nRows, nCols, descriptorType, mappedFile->data() + descriptorsOffset);
+  if (!append || m_trainDescriptors.empty()) {
+    m_trainDescriptors = trainDescriptorsTmp;
+    m_mappedLearningData = mappedFile;
+  } else {
+    cv::vconcat(m_trainDescriptors, trainDescriptorsTmp, m_trainDescriptors);
+  }
+
+  // Convert OpenCV type to ViSP type for compatibility
+  vpConvert::convertFromOpenCV(m_trainKeyPoints, referenceImagePointsList);
+  vpConvert::convertFromOpenCV(this->m_trainPoints, m_trainVpPoints);
+
+  releaseMappedLearningData();
+
+  // Add train descriptors in matcher object
+  m_matcher->clear();
+  m_matcher->add(std::vector<cv::Mat>(1, m_trainDescriptors));
+  buildMatchingIndex();
+
+  // Set _reference_computed to true as we load a learning file
+  _reference_computed = true;
+
+  // Set m_currentImageId
+  m_currentImageId = (int)m_mapOfImages.size();
+}
+
+/*!
+   Load the index of the binary train descriptors saved with
+   saveMatchingIndex() instead of building it, and enable the indexed
+   matching (see setUseMatchingIndex()). The learning data must be loaded
+   before, with the indexed matching disabled to not build the index.
+
+   \param filename : Path of the index file.
+
+   \exception vpException::badValue : If the train descriptors are not binary
+   descriptors.
+   \exception vpException::ioError : If the index does not match the train
+   descriptors.
+ */
+void vpKeyPoint::loadMatchingIndex(const std::string &filename)
+{
+  if (m_trainDescriptors.empty() || m_trainDescriptors.type() != CV_8U) {
+    throw vpException(vpException::badValue, "Only the index of binary train descriptors can be loaded !");
+  }
+
+  if (!m_trainDescriptors.isContinuous()) {
+    m_trainDescriptors = m_trainDescriptors.clone();
+  }
+  m_indexMatcher = cv::Ptr<cv::DescriptorMatcher>();
+  m_hammingIndex.load(filename, m_trainDescriptors.data, (unsigned int)m_trainDescriptors.rows,
+                      (unsigned int)m_trainDescriptors.cols);
+  m_useMatchingIndex = true;
+}
+
 /*!
    Match keypoints based on distance between their descriptors.
 
@@ -2851,7 +3177,9 @@ void vpKeyPoint::match(const cv::Mat &trainDescriptors, const cv::Mat &queryDesc
       std::transform(m_knnMatches.begin(), m_knnMatches.end(), matches.begin(), knnToDMatch);
     } else {
       // Match query descriptors to train descriptors
-      m_matcher->knnMatch(queryDescriptors, m_knnMatches, 2);
+      if (!matchWithIndex(queryDescriptors, m_knnMatches, 2)) {
+        m_matcher->knnMatch(queryDescriptors, m_knnMatches, 2);
+      }
       matches.resize(m_knnMatches.size());
       std::transform(m_knnMatches.begin(), m_knnMatches.end(), matches.begin(), knnToDMatch);
     }
@@ -2869,12 +3197,61 @@ void vpKeyPoint::match(const cv::Mat &trainDescriptors, const cv::Mat &queryDesc
       }
     } else {
       // Match query descriptors to train descriptors
-      m_matcher->match(queryDescriptors, matches);
+      std::vector<std::vector<cv::DMatch> > knnMatchesTmp;
+      if (matchWithIndex(queryDescriptors, knnMatchesTmp, 1)) {
+        for (std::vector<std::vector<cv::DMatch> >::const_iterator it = knnMatchesTmp.begin();
+             it != knnMatchesTmp.end(); ++it) {
+          if (!it->empty()) {
+            matches.push_back(it->front());
+          }
+        }
+      } else {
+        m_matcher->match(queryDescriptors, matches);
+      }
     }
   }
   elapsedTime = vpTime::measureTimeMs() - t;
 }
 
+/*!
+   Search the k nearest train descriptors of the query descriptors with the
+   index of the train descriptors.
+
+   \return false if the train descriptors are not indexed.
+ */
+bool vpKeyPoint::matchWithIndex(const cv::Mat &queryDescriptors, std::vector<std::vector<cv::DMatch> > &knnMatches,
+                                const unsigned int k)
+{
+  if (m_hammingIndex.getNbDescriptors() > 0) {
+    if (queryDescriptors.type() != CV_8U || queryDescriptors.cols != (int)m_hammingIndex.getDescriptorSize()) {
+      throw vpException(vpException::badValue, "The query descriptors do not match the train descriptors !");
+    }
+
+    const cv::Mat query = queryDescriptors.isContinuous() ? queryDescriptors : queryDescriptors.clone();
+    std::vector<unsigned int> indices, distances;
+    m_hammingIndex.knnSearch(query.data, (unsigned int)query.rows, k, indices, distances);
+
+    knnMatches.resize((size_t)query.rows);
+    for (int i = 0; i < query.rows; i++) {
+      knnMatches[(size_t)i].clear();
+      for (unsigned int j = 0; j < k; j++) {
+        const size_t index = (size_t)i * k + j;
+        if (indices[index] != std::numeric_limits<unsigned int>::max()) {
+          knnMatches[(size_t)i].push_back(cv::DMatch(i, (int)indices[index], 0, (float)distances[index]));
+        }
+      }
+    }
+    return true;
+  }
+
+  if (!m_indexMatcher.empty()) {
+    m_indexMatcher->knnMatch(queryDescriptors, knnMatches, (int)k);
+    return true;
+  }
+
+  return false;
+}
+
 /*!
    Match keypoints detected in the image with those built in the reference
    list.
@@ -2910,6 +3287,7 @@ unsigned int vpKeyPoint::matchPoint(const vpImage<unsigned char> &I, const vpIma
  */
 unsigned int vpKeyPoint::matchPoint(const vpImage<unsigned char> &I, const vpRect &rectangle)
 {
+  VP_TRACING_SCOPE("vpKeyPoint::matchPoint");
   if (m_trainDescriptors.empty()) {
     std::cerr << "Reference is empty." << std::endl;
     if (!_reference_computed) {
@@ -3028,6 +3406,7 @@ bool vpKeyPoint::matchPoint(const vpImage<unsigned char> &I, const vpCameraParam
                             double &error, double &elapsedTime, bool (*func)(const vpHomogeneousMatrix &),
                             const vpRect &rectangle)
 {
+  VP_TRACING_SCOPE("vpKeyPoint::matchPoint");
   // Check if we have training descriptors
   if (m_trainDescriptors.empty()) {
     std::cerr << "Reference is empty." << std::endl;
@@ -3404,6 +3783,9 @@ bool vpKeyPoint::matchPointAndDetect(const vpImage<unsigned char> &I, const vpCa
     \param listOfDescriptors : Corresponding list of descriptors
     \param listOfAffineI : Optional parameter, list of images after affine
    transformations
+
+    The views are processed in parallel when OpenMP is available, see
+    setAffineDetectionNbThreads().
  */
 void vpKeyPoint::detectExtractAffine(const vpImage<unsigned char> &I,
                                      std::vector<std::vector<cv::KeyPoint> > &listOfKeypoints,
@@ -3485,57 +3867,71 @@ void vpKeyPoint::detectExtractAffine(const vpImage<unsigned char> &I,
     listOfAffineI->resize(listOfAffineParams.size());
   }
 
+  // The views are processed by a bounded number of threads, each thread
+  // reusing its own image buffers. The results are stored by view index so
+  // that the merged keypoints do not depend on the scheduling.
 #ifdef VISP_HAVE_OPENMP
-#pragma omp parallel for
+  int nbThreads = m_affineDetectionNbThreads > 0 ? (int)m_affineDetectionNbThreads : omp_get_max_threads();
+#pragma omp parallel num_threads(nbThreads)
 #endif
-  for (int cpt = 0; cpt < static_cast<int>(listOfAffineParams.size()); cpt++) {
-    std::vector<cv::KeyPoint> keypoints;
-    cv::Mat descriptors;
-
-    cv::Mat timg, mask, Ai;
-    img.copyTo(timg);
+  {
+    cv::Mat timg, mask, Ai, img_disp;
+    std::vector<cv::KeyPoint> kp;
 
-    affineSkew(listOfAffineParams[(size_t)cpt].first, listOfAffineParams[(size_t)cpt].second, timg, mask, Ai);
+#ifdef VISP_HAVE_OPENMP
+#pragma omp for schedule(dynamic, 1)
+#endif
+    for (int cpt = 0; cpt < static_cast<int>(listOfAffineParams.size()); cpt++) {
+      std::vector<cv::KeyPoint> &keypoints = listOfKeypoints[(size_t)cpt];
+      cv::Mat &descriptors = listOfDescriptors[(size_t)cpt];
+      keypoints.clear();
 
-    if (listOfAffineI != NULL) {
-      cv::Mat img_disp;
-      bitwise_and(mask, timg, img_disp);
-      vpImage<unsigned char> tI;
-      vpImageConvert::convert(img_disp, tI);
-      (*listOfAffineI)[(size_t)cpt] = tI;
-    }
+      img.copyTo(timg);
+      affineSkew(listOfAffineParams[(size_t)cpt].first, listOfAffineParams[(size_t)cpt].second, timg, mask, Ai);
 
-#if 0
-    cv::Mat img_disp;
-    cv::bitwise_and(mask, timg, img_disp);
-    cv::namedWindow( "Skew", cv::WINDOW_AUTOSIZE ); // Create a window for display.
-    cv::imshow( "Skew", img_disp );
-    cv::waitKey(0);
-#endif
+      if (listOfAffineI != NULL) {
+        cv::bitwise_and(mask, timg, img_disp);
+        vpImageConvert::convert(img_disp, (*listOfAffineI)[(size_t)cpt]);
+      }
 
-    for (std::map<std::string, cv::Ptr<cv::FeatureDetector> >::const_iterator it = m_detectors.begin();
-         it != m_detectors.end(); ++it) {
-      std::vector<cv::KeyPoint> kp;
-      it->second->detect(timg, kp, mask);
-      keypoints.insert(keypoints.end(), kp.begin(), kp.end());
-    }
+      for (std::map<std::string, cv::Ptr<cv::FeatureDetector> >::const_iterator it = m_detectors.begin();
+           it != m_detectors.end(); ++it) {
+        kp.clear();
+        it->second->detect(timg, kp, mask);
+        keypoints.insert(keypoints.end(), kp.begin(), kp.end());
+      }
 
-    double elapsedTime;
-    extract(timg, keypoints, descriptors, elapsedTime);
+      double elapsedTime;
+      extract(timg, keypoints, descriptors, elapsedTime);
 
-    for (size_t i = 0; i < keypoints.size(); i++) {
-      cv::Point3f kpt(keypoints[i].pt.x, keypoints[i].pt.y, 1.f);
-      cv::Mat kpt_t = Ai * cv::Mat(kpt);
-      keypoints[i].pt.x = kpt_t.at<float>(0, 0);
-      keypoints[i].pt.y = kpt_t.at<float>(1, 0);
+      // Back to the coordinates of the input image
+      Ai.convertTo(Ai, CV_32F);
+      const float *Ai0 = Ai.ptr<float>(0), *Ai1 = Ai.ptr<float>(1);
+      for (size_t i = 0; i < keypoints.size(); i++) {
+        const float x = keypoints[i].pt.x, y = keypoints[i].pt.y;
+        keypoints[i].pt.x = Ai0[0] * x + Ai0[1] * y + Ai0[2];
+        keypoints[i].pt.y = Ai1[0] * x + Ai1[1] * y + Ai1[2];
+      }
     }
-
-    listOfKeypoints[(size_t)cpt] = keypoints;
-    listOfDescriptors[(size_t)cpt] = descriptors;
   }
 #endif
 }
 
+/*!
+   Release the memory-mapped learning file if the train descriptors do not
+   use it anymore.
+ */
+void vpKeyPoint::releaseMappedLearningData()
+{
+  if (!m_mappedLearningData.empty()) {
+    const unsigned char *begin = m_mappedLearningData->data();
+    const unsigned char *end = begin + m_mappedLearningData->size();
+    if (m_trainDescriptors.data < begin || m_trainDescriptors.data >= end) {
+      m_mappedLearningData = cv::Ptr<vpMappedFile>();
+    }
+  }
+}
+
 /*!
    Reset the instance as if we would declare another vpKeyPoint variable.
  */
@@ -3547,6 +3943,7 @@ void vpKeyPoint::reset()
   matchedReferencePoints.clear();
   _reference_computed = false;
 
+  m_affineDetectionNbThreads = 0;
   m_computeCovariance = false;
   m_covarianceMatrix = vpMatrix();
   m_currentImageId = 0;
@@ -3587,7 +3984,10 @@ void vpKeyPoint::reset()
   m_ransacParallelNbThreads = 0;
   m_ransacReprojectionError = 6.0;
   m_ransacThreshold = 0.01;
+  m_hammingIndex.clear();
+  m_indexMatcher = cv::Ptr<cv::DescriptorMatcher>();
   m_trainDescriptors = cv::Mat();
+  m_mappedLearningData = cv::Ptr<vpMappedFile>();
   m_trainKeyPoints.clear();
   m_trainPoints.clear();
   m_trainVpPoints.clear();
@@ -3597,6 +3997,7 @@ void vpKeyPoint::reset()
 #endif
   m_useConsensusPercentage = false;
   m_useKnn = true; // as m_filterType == ratioDistanceThreshold
+  m_useMatchingIndex = false;
   m_useMatchTrainToQuery = false;
   m_useRansacVVS = true;
   m_useSingleMatchFilter = true;
@@ -4003,6 +4404,221 @@ void vpKeyPoint::saveLearningData(const std::string &filename, bool binaryMode,
   }
 }
 
+/*!
+   Save the learning data in a binary file that can be mapped in memory with
+   loadMappedLearningData().
+
+   Contrary to saveLearningData(), the file is laid out to be used without
+   parsing: a fixed size header gives the offset of each section, the
+   keypoints are stored as one array per field, the descriptors are stored
+   as a contiguous matrix aligned on 64 bytes and the training images are
+   stored raw in the same file. All the values are little endian.
+
+   \param filename : Path of the save file.
+   \param saveTrainingImages : If true, save also the training images.
+
+   \exception vpException::notImplementedError : On big endian platforms.
+ */
+void vpKeyPoint::saveMappedLearningData(const std::string &filename, const bool saveTrainingImages)
+{
+  if (isBigEndian()) {
+    throw vpException(vpException::notImplementedError,
+                      "Memory-mapped learning data are not supported on big endian platforms.");
+  }
+
+  bool have3DInfo = m_trainPoints.size() > 0;
+  if (have3DInfo && m_trainPoints.size() != m_trainKeyPoints.size()) {
+    throw vpException(vpException::fatalError, "List of keypoints and list of 3D points have different size !");
+  }
+  if ((size_t)m_trainDescriptors.rows != m_trainKeyPoints.size()) {
+    throw vpException(vpException::fatalError, "List of keypoints and descriptors have different size !");
+  }
+
+  std::string parent = vpIoTools::getParent(filename);
+  if (!parent.empty()) {
+    vpIoTools::makeDirectory(parent);
+  }
+
+  const int nRows = m_trainDescriptors.rows, nCols = m_trainDescriptors.cols;
+  const int descriptorType = m_trainDescriptors.type();
+  const int nbImgs = saveTrainingImages ? (int)m_mapOfImages.size() : 0;
+
+  // Layout of the file
+  const uint64_t keyPointsArraySize = alignOffset(4 * (uint64_t)nRows, 16);
+  const uint64_t descriptorsRowSize = (uint64_t)nCols * m_trainDescriptors.elemSize();
+  const uint64_t keyPointsOffset = mappedLearningDataHeaderSize;
+  const uint64_t descriptorsOffset = alignOffset(keyPointsOffset + 8 * keyPointsArraySize, 64);
+  uint64_t fileSize = descriptorsOffset + (uint64_t)nRows * descriptorsRowSize;
+  uint64_t pointsOffset = 0;
+  if (have3DInfo) {
+    pointsOffset = alignOffset(fileSize, 16);
+    fileSize = pointsOffset + (uint64_t)nRows * 3 * sizeof(float);
+  }
+  uint64_t imagesOffset = 0;
+  std::vector<uint64_t> imageOffsets;
+  if (nbImgs > 0) {
+    imagesOffset = alignOffset(fileSize, 16);
+    fileSize = imagesOffset + (uint64_t)nbImgs * mappedLearningDataImageEntrySize;
+    for (std::map<int, vpImage<unsigned char> >::const_iterator it = m_mapOfImages.begin();
+         it != m_mapOfImages.end(); ++it) {
+      imageOffsets.push_back(alignOffset(fileSize, 16));
+      fileSize = imageOffsets.back() + it->second.getSize();
+    }
+  }
+
+  std::ofstream file(filename.c_str(), std::ofstream::binary);
+  if (!file.is_open()) {
+    throw vpException(vpException::ioError, "Cannot create the file.");
+  }
+
+  // Header
+  file.write(mappedLearningDataMagic, sizeof(mappedLearningDataMagic));
+  vpIoTools::writeBinaryValueLE(file, mappedLearningDataVersion);
+  vpIoTools::writeBinaryValueLE(file, mappedLearningDataHeaderSize);
+  vpIoTools::writeBinaryValueLE(file, nRows);
+  vpIoTools::writeBinaryValueLE(file, nCols);
+  vpIoTools::writeBinaryValueLE(file, descriptorType);
+  vpIoTools::writeBinaryValueLE(file, have3DInfo ? 1 : 0);
+  vpIoTools::writeBinaryValueLE(file, nbImgs);
+  vpIoTools::writeBinaryValueLE(file, 0);
+  writeOffset(file, keyPointsOffset);
+  writeOffset(file, descriptorsOffset);
+  writeOffset(file, pointsOffset);
+  writeOffset(file, imagesOffset);
+  writeOffset(file, fileSize);
+
+  // Keypoints, one array per field
+  for (unsigned int field = 0; field < 8; field++) {
+    writePadding(file, keyPointsOffset + field * keyPointsArraySize);
+    for (size_t i = 0; i < m_trainKeyPoints.size(); i++) {
+      const cv::KeyPoint &keyPoint = m_trainKeyPoints[i];
+      switch (field) {
+      case 0:
+        vpIoTools::writeBinaryValueLE(file, keyPoint.pt.x);
+        break;
+      case 1:
+        vpIoTools::writeBinaryValueLE(file, keyPoint.pt.y);
+        break;
+      case 2:
+        vpIoTools::writeBinaryValueLE(file, keyPoint.size);
+        break;
+      case 3:
+        vpIoTools::writeBinaryValueLE(file, keyPoint.angle);
+        break;
+      case 4:
+        vpIoTools::writeBinaryValueLE(file, keyPoint.response);
+        break;
+      case 5:
+        vpIoTools::writeBinaryValueLE(file, keyPoint.octave);
+        break;
+      case 6:
+        vpIoTools::writeBinaryValueLE(file, keyPoint.class_id);
+        break;
+      default: {
+        int image_id = -1;
+        if (saveTrainingImages) {
+          std::map<int, int>::const_iterator it_findImgId = m_mapOfImageId.find(keyPoint.class_id);
+          if (it_findImgId != m_mapOfImageId.end()) {
+            image_id = it_findImgId->second;
+          }
+        }
+        vpIoTools::writeBinaryValueLE(file, image_id);
+      } break;
+      }
+    }
+  }
+
+  // Descriptors, as a contiguous matrix
+  writePadding(file, descriptorsOffset);
+  for (int i = 0; i < nRows; i++) {
+    file.write((const char *)m_trainDescriptors.ptr(i), (std::streamsize)descriptorsRowSize);
+  }
+
+  // 3D points
+  if (have3DInfo) {
+    writePadding(file, pointsOffset);
+    for (size_t i = 0; i < m_trainPoints.size(); i++) {
+      vpIoTools::writeBinaryValueLE(file, m_trainPoints[i].x);
+      vpIoTools::writeBinaryValueLE(file, m_trainPoints[i].y);
+      vpIoTools::writeBinaryValueLE(file, m_trainPoints[i].z);
+    }
+  }
+
+  // Training images: a table of {id, width, height, offset, size} followed
+  // by the raw images
+  if (nbImgs > 0) {
+    writePadding(file, imagesOffset);
+    size_t cpt = 0;
+    for (std::map<int, vpImage<unsigned char> >::const_iterator it = m_mapOfImages.begin();
+         it != m_mapOfImages.end(); ++it, cpt++) {
+      vpIoTools::writeBinaryValueLE(file, it->first);
+      vpIoTools::writeBinaryValueLE(file, it->second.getWidth());
+      vpIoTools::writeBinaryValueLE(file, it->second.getHeight());
+      vpIoTools::writeBinaryValueLE(file, 0);
+      writeOffset(file, imageOffsets[cpt]);
+      writeOffset(file, (uint64_t)it->second.getSize());
+    }
+
+    cpt = 0;
+    for (std::map<int, vpImage<unsigned char> >::const_iterator it = m_mapOfImages.begin();
+         it != m_mapOfImages.end(); ++it, cpt++) {
+      writePadding(file, imageOffsets[cpt]);
+      file.write((const char *)it->second.bitmap, (std::streamsize)it->second.getSize());
+    }
+  }
+
+  if (!file) {
+    throw vpException(vpException::ioError, "Cannot write the file %s.", filename.c_str());
+  }
+}
+
+/*!
+   Save the index of the binary train descriptors (see setUseMatchingIndex())
+   to load it with loadMatchingIndex() instead of building it again, for
+   instance next to the learning file.
+
+   \param filename : Path of the index file.
+
+   \exception vpException::fatalError : If the binary train descriptors are
+   not indexed.
+ */
+void vpKeyPoint::saveMatchingIndex(const std::string &filename) const
+{
+  if (m_hammingIndex.getNbDescriptors() == 0) {
+    throw vpException(vpException::fatalError, "No index of binary train descriptors to save !");
+  }
+
+  std::string parent = vpIoTools::getParent(filename);
+  if (!parent.empty()) {
+    vpIoTools::makeDirectory(parent);
+  }
+  m_hammingIndex.save(filename);
+}
+
+/*!
+   Set if the train descriptors are indexed to speed up the matching of the
+   query descriptors to the train descriptors, instead of using the matcher.
+
+   The binary descriptors are indexed with vpHammingIndex and the floating
+   point descriptors with a randomized k-d forest. The index is built once,
+   when the reference is built or when the learning data are loaded, and the
+   query descriptors are searched in parallel. The search is approximate: a
+   train descriptor far from the query descriptor may not be found, which
+   mostly removes matches that would be rejected by the filtering method.
+
+   The index is not used to match the train descriptors to the query
+   descriptors (see setUseMatchTrainToQuery()).
+
+   \param useMatchingIndex : True to index the train descriptors.
+ */
+void vpKeyPoint::setUseMatchingIndex(const bool useMatchingIndex)
+{
+  if (useMatchingIndex != m_useMatchingIndex) {
+    m_useMatchingIndex = useMatchingIndex;
+    buildMatchingIndex();
+  }
+}
+
 #if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x030000)
 // From OpenCV 2.4.11 source code.
 struct KeypointResponseGreaterThanThreshold {
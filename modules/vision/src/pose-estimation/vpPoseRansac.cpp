@@ -53,6 +53,7 @@
 #include <visp3/core/vpColVector.h>
 #include <visp3/core/vpMath.h>
 #include <visp3/core/vpRansac.h>
+#include <visp3/core/vpTracing.h>
 #include <visp3/vision/vpPose.h>
 #include <visp3/vision/vpPoseException.h>
 
@@ -122,6 +123,7 @@ struct FindDegeneratePoint {
 
 bool vpPose::RansacFunctor::poseRansacImpl()
 {
+  VP_TRACING_SCOPE("vpPose::RansacFunctor::poseRansacImpl");
   const unsigned int size = (unsigned int)m_listOfUniquePoints.size();
   const unsigned int nbMinRandom = 4;
   int nbTrials = 0;
@@ -332,6 +334,7 @@ bool vpPose::RansacFunctor::poseRansacImpl()
 */
 bool vpPose::poseRansac(vpHomogeneousMatrix &cMo, bool (*func)(const vpHomogeneousMatrix &))
 {
+  VP_TRACING_SCOPE("vpPose::poseRansac");
   // Check only for adding / removing problem
   // Do not take into account problem with element modification here
   if (listP.size() != listOfPoints.size()) {
@@ -44,6 +44,7 @@
 #include <visp3/core/vpExponentialMap.h>
 #include <visp3/core/vpPoint.h>
 #include <visp3/core/vpRobust.h>
+#include <visp3/core/vpTracing.h>
 #include <visp3/vision/vpPose.h>
 
 /*!
@@ -55,6 +56,7 @@
 
 void vpPose::poseVirtualVS(vpHomogeneousMatrix &cMo)
 {
+  VP_TRACING_SCOPE("vpPose::poseVirtualVS");
   try {
 
     double residu_1 = 1e8;
@@ -0,0 +1,173 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the approximate nearest neighbour search of vpHammingIndex.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testHammingIndex.cpp
+
+  Index random binary descriptors with vpHammingIndex and check that the
+  nearest neighbours of noisy copies of the descriptors are the ones found
+  by a brute force search.
+*/
+
+#include <iostream>
+#include <limits>
+#include <vector>
+
+#include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/vision/vpHammingIndex.h>
+
+namespace
+{
+// Nearest neighbour of a query by brute force
+unsigned int bruteForceSearch(const std::vector<unsigned char> &train, unsigned int nbTrain,
+                              const unsigned char *query, unsigned int descriptorSize, unsigned int &distance)
+{
+  unsigned int index = 0;
+  distance = std::numeric_limits<unsigned int>::max();
+  for (unsigned int i = 0; i < nbTrain; i++) {
+    unsigned int d = vpHammingIndex::hammingDistance(&train[i * descriptorSize], query, descriptorSize);
+    if (d < distance) {
+      distance = d;
+      index = i;
+    }
+  }
+  return index;
+}
+
+bool test(const vpHammingIndex &index, const std::vector<unsigned char> &train, unsigned int nbTrain,
+          const std::vector<unsigned char> &queries, unsigned int nbQueries, unsigned int descriptorSize,
+          unsigned int exactDistance)
+{
+  std::vector<unsigned int> indices, distances;
+  index.knnSearch(&queries[0], nbQueries, 2, indices, distances);
+  if (indices.size() != 2 * nbQueries || distances.size() != 2 * nbQueries) {
+    std::cerr << "Wrong size of the search results" << std::endl;
+    return false;
+  }
+
+  for (unsigned int q = 0; q < nbQueries; q++) {
+    const unsigned char *query = &queries[q * descriptorSize];
+    unsigned int distance = 0;
+    unsigned int nearest = bruteForceSearch(train, nbTrain, query, descriptorSize, distance);
+
+    if (distances[2 * q] > distances[2 * q + 1]) {
+      std::cerr << "The neighbours are not sorted" << std::endl;
+      return false;
+    }
+    if (indices[2 * q] != std::numeric_limits<unsigned int>::max() &&
+        vpHammingIndex::hammingDistance(&train[indices[2 * q] * descriptorSize], query, descriptorSize) !=
+            distances[2 * q]) {
+      std::cerr << "Wrong distance for the query " << q << std::endl;
+      return false;
+    }
+    // The search is exact below the guaranteed distance
+    if (distance < exactDistance && (indices[2 * q] != nearest || distances[2 * q] != distance)) {
+      std::cerr << "Query " << q << ": nearest neighbour " << indices[2 * q] << " at " << distances[2 * q]
+                << " instead of " << nearest << " at " << distance << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int main()
+{
+  try {
+    const unsigned int descriptorSize = 32, nbTrain = 5000, nbQueries = 500;
+    vpUniRand rng(1234);
+
+    std::vector<unsigned char> train(nbTrain * descriptorSize);
+    for (size_t i = 0; i < train.size(); i++) {
+      train[i] = (unsigned char)(rng() * 256);
+    }
+
+    // Queries: train descriptors with up to 40 flipped bits
+    std::vector<unsigned char> queries(nbQueries * descriptorSize);
+    for (unsigned int q = 0; q < nbQueries; q++) {
+      unsigned int i = (unsigned int)(rng() * nbTrain) % nbTrain;
+      std::copy(&train[i * descriptorSize], &train[i * descriptorSize] + descriptorSize, &queries[q * descriptorSize]);
+      unsigned int nbFlips = q % 41;
+      for (unsigned int f = 0; f < nbFlips; f++) {
+        unsigned int bit = (unsigned int)(rng() * descriptorSize * 8) % (descriptorSize * 8);
+        queries[q * descriptorSize + bit / 8] ^= (unsigned char)(1 << (bit % 8));
+      }
+    }
+
+    vpHammingIndex index;
+    index.build(&train[0], nbTrain, descriptorSize);
+    for (unsigned int radius = 0; radius <= 2; radius++) {
+      std::cout << "** Test probe radius " << radius << std::endl;
+      index.setProbeRadius(radius);
+      if (!test(index, train, nbTrain, queries, nbQueries, descriptorSize, (descriptorSize / 2) * (radius + 1))) {
+        return EXIT_FAILURE;
+      }
+    }
+
+    // Save and load the index
+    std::cout << "** Test save / load" << std::endl;
+#if defined(_WIN32)
+    std::string opath = "C:/temp";
+#else
+    std::string opath = "/tmp";
+#endif
+    if (!vpIoTools::checkDirectory(opath))
+      vpIoTools::makeDirectory(opath);
+    std::string filename = vpIoTools::createFilePath(opath, "testHammingIndex.bin");
+    index.save(filename);
+
+    vpHammingIndex index_read;
+    index_read.load(filename, &train[0], nbTrain, descriptorSize);
+    if (!test(index_read, train, nbTrain, queries, nbQueries, descriptorSize, descriptorSize / 2 * 2)) {
+      return EXIT_FAILURE;
+    }
+
+    // The index does not match other descriptors
+    train[0] ^= 1;
+    try {
+      index_read.load(filename, &train[0], nbTrain, descriptorSize);
+      std::cerr << "No exception when loading an index of other descriptors" << std::endl;
+      return EXIT_FAILURE;
+    } catch (const vpException &) {
+    }
+
+    std::cout << "Test succeed" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const vpException &e) {
+    std::cout << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+}
@@ -483,6 +483,72 @@ int main(int argc, const char **argv)
       }
 #endif
 
+      // Save in the memory-mapped format with training images
+      filename = vpIoTools::createFilePath(opath, "mapped_with_img");
+      vpIoTools::makeDirectory(filename);
+      filename = vpIoTools::createFilePath(filename, "test_save_in_mapped_with_img.bin");
+      keyPoints.saveMappedLearningData(filename, true);
+
+      // Test if save is ok
+      if (!vpIoTools::checkFilename(filename)) {
+        std::stringstream ss;
+        ss << "Problem when saving file=" << filename;
+        throw vpException(vpException::ioError, ss.str().c_str());
+      }
+
+      // Test if read is ok
+      vpKeyPoint read_keypoint5;
+      read_keypoint5.loadMappedLearningData(filename);
+      trainKeyPoints_read.clear();
+      read_keypoint5.getTrainKeyPoints(trainKeyPoints_read);
+      trainDescriptors_read = read_keypoint5.getTrainDescriptors();
+
+      if (!compareKeyPoints(trainKeyPoints, trainKeyPoints_read)) {
+        throw vpException(vpException::fatalError, "Problem with trainKeyPoints when reading learning file saved "
+                                                   "in the memory-mapped format !");
+      }
+
+      if (!compareDescriptors(trainDescriptors, trainDescriptors_read)) {
+        throw vpException(vpException::fatalError, "Problem with trainDescriptors when reading "
+                                                   "learning file saved in "
+                                                   "the memory-mapped format !");
+      }
+
+      if (read_keypoint5.getNbImages() != keyPoints.getNbImages()) {
+        throw vpException(vpException::fatalError, "Problem with the training images when reading learning file "
+                                                   "saved in the memory-mapped format !");
+      }
+
+      // Append the same learning data
+      read_keypoint5.loadMappedLearningData(filename, true);
+      if (read_keypoint5.getTrainDescriptors().rows != 2 * trainDescriptors.rows) {
+        throw vpException(vpException::fatalError, "Problem when appending learning file saved in "
+                                                   "the memory-mapped format !");
+      }
+
+      // Convert the binary learning file in the memory-mapped format
+      std::string filename_bin = vpIoTools::createFilePath(opath, "bin_with_img");
+      filename_bin = vpIoTools::createFilePath(filename_bin, "test_save_in_bin_with_img.bin");
+      filename = vpIoTools::createFilePath(opath, "mapped_with_img");
+      filename = vpIoTools::createFilePath(filename, "test_convert_bin_with_img.bin");
+      vpKeyPoint::convertLearningData(filename_bin, true, filename);
+
+      vpKeyPoint read_keypoint6;
+      read_keypoint6.loadMappedLearningData(filename);
+      trainKeyPoints_read.clear();
+      read_keypoint6.getTrainKeyPoints(trainKeyPoints_read);
+      trainDescriptors_read = read_keypoint6.getTrainDescriptors();
+
+      if (!compareKeyPoints(trainKeyPoints, trainKeyPoints_read)) {
+        throw vpException(vpException::fatalError, "Problem with trainKeyPoints when reading converted "
+                                                   "learning file !");
+      }
+
+      if (!compareDescriptors(trainDescriptors, trainDescriptors_read)) {
+        throw vpException(vpException::fatalError, "Problem with trainDescriptors when reading converted "
+                                                   "learning file !");
+      }
+
       std::cout << "Saving / loading learning files with binary descriptor are ok !" << std::endl;
     }
 
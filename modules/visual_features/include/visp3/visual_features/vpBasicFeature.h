@@ -109,6 +109,11 @@ public:
   /*! Return the dimension of the feature vector \f$\bf s\f$. */
   unsigned int dimension_s() { return dim_s; }
 
+  virtual void computeError(const vpBasicFeature &s_star, const unsigned int select, vpColVector &e,
+                            const unsigned int row);
+  virtual void computeInteraction(const unsigned int select, vpMatrix &L, const unsigned int row);
+  void copy_s(const unsigned int select, vpColVector &state, const unsigned int row) const;
+
   virtual void display(const vpCameraParameters &cam, const vpImage<unsigned char> &I,
                        const vpColor &color = vpColor::green, unsigned int thickness = 1) const = 0;
   virtual void display(const vpCameraParameters &cam, const vpImage<vpRGBa> &I, const vpColor &color = vpColor::green,
@@ -199,6 +199,9 @@ public:
 
   vpFeaturePoint *duplicate() const;
 
+  void computeError(const vpBasicFeature &s_star, const unsigned int select, vpColVector &e, const unsigned int row);
+  void computeInteraction(const unsigned int select, vpMatrix &L, const unsigned int row);
+
   vpColVector error(const vpBasicFeature &s_star, const unsigned int select = FEATURE_ALL);
   //! Compute the error between a visual features and zero
   vpColVector error(const unsigned int select = FEATURE_ALL);
@@ -271,6 +271,9 @@ public:
   //! Feature duplication.
   vpFeatureThetaU *duplicate() const;
 
+  void computeError(const vpBasicFeature &s_star, const unsigned int select, vpColVector &e, const unsigned int row);
+  void computeInteraction(const unsigned int select, vpMatrix &L, const unsigned int row);
+
   // compute the error between two visual features from a subset
   // a the possible features
   vpColVector error(const vpBasicFeature &s_star, const unsigned int select = FEATURE_ALL);
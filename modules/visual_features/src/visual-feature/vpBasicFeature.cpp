@@ -38,6 +38,7 @@
  *****************************************************************************/
 
 #include <visp3/visual_features/vpBasicFeature.h>
+#include <visp3/visual_features/vpFeatureException.h>
 
 const unsigned int vpBasicFeature::FEATURE_LINE[32] = {
     (unsigned int)(1 << 0),  (unsigned int)(1 << 1),  (unsigned int)(1 << 2),  (unsigned int)(1 << 3),
@@ -128,6 +129,77 @@ vpColVector vpBasicFeature::get_s(const unsigned int select) const
   return state;
 }
 
+/*!
+  Copy the selected features of \f$\bf s\f$ in \e state from the index \e
+  row, without any memory allocation. \e state should have at least
+  getDimension(select) elements from \e row.
+
+  \exception vpFeatureException::sizeMismatchError : If \e state is too small.
+*/
+void vpBasicFeature::copy_s(const unsigned int select, vpColVector &state, const unsigned int row) const
+{
+  if (dim_s > 31) {
+    if (row + dim_s > state.getRows()) {
+      throw(vpFeatureException(vpFeatureException::sizeMismatchError, "Feature vector too small"));
+    }
+    for (unsigned int i = 0; i < dim_s; ++i)
+      state[row + i] = s[i];
+    return;
+  }
+
+  unsigned int r = row;
+  for (unsigned int i = 0; i < dim_s; ++i) {
+    if (FEATURE_LINE[i] & select) {
+      if (r >= state.getRows()) {
+        throw(vpFeatureException(vpFeatureException::sizeMismatchError, "Feature vector too small"));
+      }
+      state[r++] = s[i];
+    }
+  }
+}
+
+/*!
+  Compute the error \f$ (s-s^*)\f$ between the current and the desired visual
+  features from a subset of the possible features, and write it in \e e from
+  the index \e row. \e e should have at least getDimension(select) elements
+  from \e row.
+
+  This default implementation copies the vector returned by error(). It is
+  redefined without memory allocation by the most common features to be
+  used in a compiled vpServo task.
+
+  \exception vpFeatureException::sizeMismatchError : If \e e is too small.
+*/
+void vpBasicFeature::computeError(const vpBasicFeature &s_star, const unsigned int select, vpColVector &e,
+                                  const unsigned int row)
+{
+  vpColVector eTmp = error(s_star, select);
+  if (row + eTmp.getRows() > e.getRows()) {
+    throw(vpFeatureException(vpFeatureException::sizeMismatchError, "Error vector too small"));
+  }
+  e.insert(row, eTmp);
+}
+
+/*!
+  Compute the interaction matrix from a subset of the possible features, and
+  write it in \e L from the row \e row. \e L should have 6 columns and at
+  least getDimension(select) rows from \e row.
+
+  This default implementation copies the matrix returned by interaction().
+  It is redefined without memory allocation by the most common features to
+  be used in a compiled vpServo task.
+
+  \exception vpFeatureException::sizeMismatchError : If \e L is too small.
+*/
+void vpBasicFeature::computeInteraction(const unsigned int select, vpMatrix &L, const unsigned int row)
+{
+  vpMatrix LTmp = interaction(select);
+  if (row + LTmp.getRows() > L.getRows() || LTmp.getCols() != L.getCols()) {
+    throw(vpFeatureException(vpFeatureException::sizeMismatchError, "Interaction matrix too small"));
+  }
+  L.insert(LTmp, row, 0);
+}
+
 void vpBasicFeature::resetFlags()
 {
   if (flags != NULL) {
@@ -214,10 +214,21 @@ void vpFeaturePoint::set_xyZ(const double x_, const double y_, const double Z_)
 */
 vpMatrix vpFeaturePoint::interaction(const unsigned int select)
 {
-  vpMatrix L;
+  vpMatrix L(getDimension(select), 6);
+  computeInteraction(select, L, 0);
+  return L;
+}
 
-  L.resize(0, 6);
+/*!
+  Compute the interaction matrix from a subset of the possible point features
+  and write it in \e L from the row \e row, without memory allocation. See
+  interaction() for the meaning of \e select.
 
+  \exception vpFeatureException::sizeMismatchError : If \e L has not 6
+  columns and at least getDimension(select) rows from \e row.
+*/
+void vpFeaturePoint::computeInteraction(const unsigned int select, vpMatrix &L, const unsigned int row)
+{
   if (deallocate == vpBasicFeature::user) {
     for (unsigned int i = 0; i < nbParameters; i++) {
       if (flags[i] == false) {
@@ -260,34 +271,30 @@ vpMatrix vpFeaturePoint::interaction(const unsigned int select)
     throw(vpFeatureException(vpFeatureException::badInitializationError, "Point Z coordinates is null"));
   }
 
-  if (vpFeaturePoint::selectX() & select) {
-    vpMatrix Lx(1, 6);
-    Lx = 0;
-
-    Lx[0][0] = -1 / Z_;
-    Lx[0][1] = 0;
-    Lx[0][2] = x_ / Z_;
-    Lx[0][3] = x_ * y_;
-    Lx[0][4] = -(1 + x_ * x_);
-    Lx[0][5] = y_;
+  if (row + getDimension(select) > L.getRows() || L.getCols() != 6) {
+    throw(vpFeatureException(vpFeatureException::sizeMismatchError, "Interaction matrix too small"));
+  }
 
-    L = vpMatrix::stack(L, Lx);
+  unsigned int r = row;
+  if (vpFeaturePoint::selectX() & select) {
+    double *Lx = L[r++];
+    Lx[0] = -1 / Z_;
+    Lx[1] = 0;
+    Lx[2] = x_ / Z_;
+    Lx[3] = x_ * y_;
+    Lx[4] = -(1 + x_ * x_);
+    Lx[5] = y_;
   }
 
   if (vpFeaturePoint::selectY() & select) {
-    vpMatrix Ly(1, 6);
-    Ly = 0;
-
-    Ly[0][0] = 0;
-    Ly[0][1] = -1 / Z_;
-    Ly[0][2] = y_ / Z_;
-    Ly[0][3] = 1 + y_ * y_;
-    Ly[0][4] = -x_ * y_;
-    Ly[0][5] = -x_;
-
-    L = vpMatrix::stack(L, Ly);
+    double *Ly = L[r];
+    Ly[0] = 0;
+    Ly[1] = -1 / Z_;
+    Ly[2] = y_ / Z_;
+    Ly[3] = 1 + y_ * y_;
+    Ly[4] = -x_ * y_;
+    Ly[5] = -x_;
   }
-  return L;
 }
 
 /*!
@@ -328,26 +335,33 @@ vpMatrix vpFeaturePoint::interaction(const unsigned int select)
 */
 vpColVector vpFeaturePoint::error(const vpBasicFeature &s_star, const unsigned int select)
 {
-  vpColVector e(0);
-
-  try {
-    if (vpFeaturePoint::selectX() & select) {
-      vpColVector ex(1);
-      ex[0] = s[0] - s_star[0];
+  vpColVector e(getDimension(select));
+  computeError(s_star, select, e, 0);
+  return e;
+}
 
-      e = vpColVector::stack(e, ex);
-    }
+/*!
+  Compute the error \f$ (s-s^*)\f$ between the current and the desired
+  visual features from a subset of the possible point features and write it
+  in \e e from the index \e row, without memory allocation. See error() for
+  the meaning of \e select.
 
-    if (vpFeaturePoint::selectY() & select) {
-      vpColVector ey(1);
-      ey[0] = s[1] - s_star[1];
-      e = vpColVector::stack(e, ey);
-    }
-  } catch (...) {
-    throw;
+  \exception vpFeatureException::sizeMismatchError : If \e e has not at least
+  getDimension(select) elements from \e row.
+*/
+void vpFeaturePoint::computeError(const vpBasicFeature &s_star, const unsigned int select, vpColVector &e,
+                                  const unsigned int row)
+{
+  if (row + getDimension(select) > e.getRows()) {
+    throw(vpFeatureException(vpFeatureException::sizeMismatchError, "Error vector too small"));
   }
 
-  return e;
+  unsigned int r = row;
+  if (vpFeaturePoint::selectX() & select)
+    e[r++] = s[0] - s_star[0];
+
+  if (vpFeaturePoint::selectY() & select)
+    e[r] = s[1] - s_star[1];
 }
 
 /*!
@@ -407,10 +407,21 @@ double vpFeatureThetaU::get_TUz() const { return s[2]; }
 */
 vpMatrix vpFeatureThetaU::interaction(const unsigned int select)
 {
+  vpMatrix L(getDimension(select), 6);
+  computeInteraction(select, L, 0);
+  return L;
+}
 
-  vpMatrix L;
-  L.resize(0, 6);
+/*!
+  Compute the interaction matrix from a subset of the possible \f$ \theta u
+  \f$ features and write it in \e L from the row \e row, without memory
+  allocation. See interaction() for the meaning of \e select.
 
+  \exception vpFeatureException::sizeMismatchError : If \e L has not 6
+  columns and at least getDimension(select) rows from \e row.
+*/
+void vpFeatureThetaU::computeInteraction(const unsigned int select, vpMatrix &L, const unsigned int row)
+{
   if (deallocate == vpBasicFeature::user) {
     for (unsigned int i = 0; i < nbParameters; i++) {
       if (flags[i] == false) {
@@ -435,72 +446,50 @@ vpMatrix vpFeatureThetaU::interaction(const unsigned int select)
     resetFlags();
   }
 
-  // Lw computed using Lw = [theta/2 u]_x +/- (I + alpha [u]_x [u]_x)
-  vpColVector u(3);
-  for (unsigned int i = 0; i < 3; i++) {
-    u[i] = s[i] / 2.0;
+  if (row + getDimension(select) > L.getRows() || L.getCols() != 6) {
+    throw(vpFeatureException(vpFeatureException::sizeMismatchError, "Interaction matrix too small"));
   }
 
-  vpMatrix Lw(3, 3);
-  Lw = vpColVector::skew(u); /* [theta/2  u]_x */
-
-  vpMatrix U2(3, 3);
-  U2.eye();
-
-  double theta = sqrt(s.sumSquare());
+  // Lw computed using Lw = [theta/2 u]_x +/- (I + alpha [u]_x [u]_x)
+  double Lw[3][3];
+  Lw[0][0] = 0;
+  Lw[0][1] = -s[2] / 2.0;
+  Lw[0][2] = s[1] / 2.0;
+  Lw[1][0] = s[2] / 2.0;
+  Lw[1][1] = 0;
+  Lw[1][2] = -s[0] / 2.0;
+  Lw[2][0] = -s[1] / 2.0;
+  Lw[2][1] = s[0] / 2.0;
+  Lw[2][2] = 0;
+
+  // U2 = I + alpha [u]_x [u]_x, with [u]_x [u]_x = u u^T - I for a unit u
+  double U2[3][3];
+  double theta = sqrt(s[0] * s[0] + s[1] * s[1] + s[2] * s[2]);
+  double alpha = 0;
+  double u[3] = {0, 0, 0};
   if (theta >= 1e-6) {
     for (unsigned int i = 0; i < 3; i++)
       u[i] = s[i] / theta;
-
-    vpMatrix skew_u;
-    skew_u = vpColVector::skew(u);
-    U2 += (1 - vpMath::sinc(theta) / vpMath::sqr(vpMath::sinc(theta / 2.0))) * skew_u * skew_u;
+    alpha = 1 - vpMath::sinc(theta) / vpMath::sqr(vpMath::sinc(theta / 2.0));
   }
+  for (unsigned int i = 0; i < 3; i++)
+    for (unsigned int j = 0; j < 3; j++)
+      U2[i][j] = (i == j ? 1 - alpha : 0) + alpha * u[i] * u[j];
 
-  if (rotation == cdRc) {
-    Lw += U2;
-  } else {
-    Lw -= U2;
-  }
+  const double sign = (rotation == cdRc) ? 1. : -1.;
 
   // This version is a simplification
-  if (vpFeatureThetaU::selectTUx() & select) {
-    vpMatrix Lx(1, 6);
-
-    Lx[0][0] = 0;
-    Lx[0][1] = 0;
-    Lx[0][2] = 0;
-    for (int i = 0; i < 3; i++)
-      Lx[0][i + 3] = Lw[0][i];
-
-    L = vpMatrix::stack(L, Lx);
-  }
-
-  if (vpFeatureThetaU::selectTUy() & select) {
-    vpMatrix Ly(1, 6);
-
-    Ly[0][0] = 0;
-    Ly[0][1] = 0;
-    Ly[0][2] = 0;
-    for (int i = 0; i < 3; i++)
-      Ly[0][i + 3] = Lw[1][i];
-
-    L = vpMatrix::stack(L, Ly);
-  }
-
-  if (vpFeatureThetaU::selectTUz() & select) {
-    vpMatrix Lz(1, 6);
-
-    Lz[0][0] = 0;
-    Lz[0][1] = 0;
-    Lz[0][2] = 0;
-    for (int i = 0; i < 3; i++)
-      Lz[0][i + 3] = Lw[2][i];
-
-    L = vpMatrix::stack(L, Lz);
+  unsigned int r = row;
+  for (unsigned int k = 0; k < 3; k++) {
+    if (FEATURE_LINE[k] & select) {
+      double *Lk = L[r++];
+      Lk[0] = 0;
+      Lk[1] = 0;
+      Lk[2] = 0;
+      for (unsigned int i = 0; i < 3; i++)
+        Lk[i + 3] = Lw[k][i] + sign * U2[k][i];
+    }
   }
-
-  return L;
 }
 
 /*!
@@ -566,32 +555,42 @@ vpMatrix vpFeatureThetaU::interaction(const unsigned int select)
 */
 vpColVector vpFeatureThetaU::error(const vpBasicFeature &s_star, const unsigned int select)
 {
+  vpColVector e(getDimension(select));
+  computeError(s_star, select, e, 0);
+  return e;
+}
 
-  if (fabs(s_star.get_s().sumSquare()) > 1e-6) {
-    vpERROR_TRACE("s* should be zero ! ");
-    throw(vpFeatureException(vpFeatureException::badInitializationError, "s* should be zero !"));
-  }
+/*!
+  Compute the error \f$ (s-s^*)\f$ from a subset of the possible \f$ \theta
+  u \f$ features and write it in \e e from the index \e row, without memory
+  allocation. See error() for the meaning of \e select.
 
-  vpColVector e(0);
+  \exception vpFeatureException::badInitializationError : If the
+  desired visual feature \f$ s^* \f$ is not equal to zero.
 
-  if (vpFeatureThetaU::selectTUx() & select) {
-    vpColVector ex(1);
-    ex[0] = s[0];
-    e = vpColVector::stack(e, ex);
+  \exception vpFeatureException::sizeMismatchError : If \e e has not at least
+  getDimension(select) elements from \e row.
+*/
+void vpFeatureThetaU::computeError(const vpBasicFeature &s_star, const unsigned int select, vpColVector &e,
+                                   const unsigned int row)
+{
+  double sumSquare = 0;
+  for (unsigned int i = 0; i < s_star.getDimension(); i++)
+    sumSquare += s_star[i] * s_star[i];
+  if (sumSquare > 1e-6) {
+    vpERROR_TRACE("s* should be zero ! ");
+    throw(vpFeatureException(vpFeatureException::badInitializationError, "s* should be zero !"));
   }
 
-  if (vpFeatureThetaU::selectTUy() & select) {
-    vpColVector ey(1);
-    ey[0] = s[1];
-    e = vpColVector::stack(e, ey);
+  if (row + getDimension(select) > e.getRows()) {
+    throw(vpFeatureException(vpFeatureException::sizeMismatchError, "Error vector too small"));
   }
 
-  if (vpFeatureThetaU::selectTUz() & select) {
-    vpColVector ez(1);
-    ez[0] = s[2];
-    e = vpColVector::stack(e, ez);
+  unsigned int r = row;
+  for (unsigned int k = 0; k < 3; k++) {
+    if (FEATURE_LINE[k] & select)
+      e[r++] = s[k];
   }
-  return e;
 }
 
 /*!
@@ -47,6 +47,7 @@
 */
 
 #include <list>
+#include <vector>
 
 #include <visp3/core/vpMatrix.h>
 #include <visp3/core/vpVelocityTwistMatrix.h>
@@ -266,6 +267,11 @@ public:
   // compute the interaction matrix related to the set of visual features
   vpMatrix computeInteractionMatrix();
 
+  /*!
+    Return true if the compiled task mode is enabled.
+    \sa setCompiledTask()
+  */
+  bool getCompiledTask() const { return compiledTask; }
   // Return the task dimension.
   unsigned int getDimension() const;
   /*!
@@ -362,6 +368,8 @@ error vector is updated after a call of computeError() or computeControlLaw().
 
   void setCameraDoF(const vpColVector &dof);
 
+  void setCompiledTask(bool compiled);
+
   /*!
     Set a variable which enables to compute the interaction matrix at each
     iteration.
@@ -539,6 +547,11 @@ protected:
    */
   void computeProjectionOperators();
 
+  void compileTask();
+  void computeCompiledControlLaw();
+  void computeCompiledError();
+  void computeCompiledInteractionMatrix();
+
 public:
   //! Interaction matrix
   vpMatrix L;
@@ -674,6 +687,34 @@ protected:
   //! A diag matrix used to determine which are the degrees of freedom that
   //! are controlled in the camera frame
   vpMatrix cJc;
+
+  /*
+    Compiled task
+  */
+
+  //! true if the compiled task mode is enabled (see setCompiledTask()).
+  bool compiledTask;
+  //! true if the feature lists have been frozen in the arrays below.
+  bool taskCompiled;
+  //! Current visual features of the compiled task.
+  std::vector<vpBasicFeature *> compiledFeatures;
+  //! Desired visual features of the compiled task.
+  std::vector<vpBasicFeature *> compiledDesiredFeatures;
+  //! Selection of each visual feature of the compiled task.
+  std::vector<unsigned int> compiledSelections;
+  //! Index of the first row of each visual feature in the task, followed by
+  //! the task dimension.
+  std::vector<unsigned int> compiledOffsets;
+  //! Interaction matrix computed from the desired features (MEAN case).
+  vpMatrix compiledLstar;
+  //! Twist transformation matrix \f${^c}V_a\f$ (with the controlled dof).
+  vpMatrix compiled_cVa;
+  //! Product \f$L {^c}V_a\f$.
+  vpMatrix compiledLcVa;
+  //! Image of the task Jacobian and of its transpose.
+  vpMatrix compiledImJ1, compiledImJ1t;
+  //! Temporary vector of the dimension of the controlled dof.
+  vpColVector compiledVector;
 };
 
 #endif
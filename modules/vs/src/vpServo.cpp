@@ -47,6 +47,7 @@
 
 // Debug trace
 #include <visp3/core/vpDebug.h>
+#include <visp3/core/vpTracing.h>
 
 /*!
   \file vpServo.cpp
@@ -72,7 +73,9 @@ vpServo::vpServo()
     interactionMatrixType(DESIRED), inversionType(PSEUDO_INVERSE), cVe(), init_cVe(false), cVf(), init_cVf(false),
     fVe(), init_fVe(false), eJe(), init_eJe(false), fJe(), init_fJe(false), errorComputed(false),
     interactionMatrixComputed(false), dim_task(0), taskWasKilled(false), forceInteractionMatrixComputation(false),
-    WpW(), I_WpW(), P(), sv(), mu(4.), e1_initial(), iscJcIdentity(true), cJc(6, 6)
+    WpW(), I_WpW(), P(), sv(), mu(4.), e1_initial(), iscJcIdentity(true), cJc(6, 6), compiledTask(false),
+    taskCompiled(false), compiledFeatures(), compiledDesiredFeatures(), compiledSelections(), compiledOffsets(),
+    compiledLstar(), compiled_cVa(6, 6), compiledLcVa(), compiledImJ1(), compiledImJ1t(), compiledVector()
 {
   cJc.eye();
 }
@@ -97,7 +100,9 @@ vpServo::vpServo(vpServoType servo_type)
     inversionType(PSEUDO_INVERSE), cVe(), init_cVe(false), cVf(), init_cVf(false), fVe(), init_fVe(false), eJe(),
     init_eJe(false), fJe(), init_fJe(false), errorComputed(false), interactionMatrixComputed(false), dim_task(0),
     taskWasKilled(false), forceInteractionMatrixComputation(false), WpW(), I_WpW(), P(), sv(), mu(4), e1_initial(),
-    iscJcIdentity(true), cJc(6, 6)
+    iscJcIdentity(true), cJc(6, 6), compiledTask(false), taskCompiled(false), compiledFeatures(),
+    compiledDesiredFeatures(), compiledSelections(), compiledOffsets(), compiledLstar(), compiled_cVa(6, 6),
+    compiledLcVa(), compiledImJ1(), compiledImJ1t(), compiledVector()
 {
   cJc.eye();
 }
@@ -171,6 +176,8 @@ void vpServo::init()
   forceInteractionMatrixComputation = false;
 
   rankJ1 = 0;
+
+  taskCompiled = false;
 }
 
 /*!
@@ -211,6 +218,7 @@ void vpServo::kill()
 
     featureList.clear();
     desiredFeatureList.clear();
+    taskCompiled = false;
     taskWasKilled = true;
   }
 }
@@ -301,6 +309,37 @@ void vpServo::setCameraDoF(const vpColVector &dof)
   }
 }
 
+/*!
+  Enable or disable the compiled task mode.
+
+  In the default mode, the interaction matrix and the error vector are built
+  at each iteration by stacking the matrices and vectors returned by each
+  visual feature, which leads to many small memory allocations. When the
+  compiled task mode is enabled, the feature lists are frozen at the first
+  computation in arrays with the index of the first row of each feature. The
+  features then write their rows in place in the interaction matrix and in
+  the error vector, whose dimension is known in advance, and
+  computeControlLaw() reuses the memory of the intermediate matrices from one
+  iteration to the other. This is interesting for tasks with a large number
+  of features and high rate servo loops.
+
+  The features that implement vpBasicFeature::computeInteraction() and
+  vpBasicFeature::computeError() (vpFeaturePoint, vpFeatureThetaU) fully
+  benefit from this mode; the others are copied from the matrices returned by
+  vpBasicFeature::interaction() and vpBasicFeature::error().
+
+  The task is compiled again after addFeature(), kill() or when the mode is
+  changed. The dimension of the features must not change once the task is
+  compiled.
+
+  \param compiled : true to enable the compiled task mode.
+*/
+void vpServo::setCompiledTask(bool compiled)
+{
+  compiledTask = compiled;
+  taskCompiled = false;
+}
+
 /*!
 
   Prints on \e os stream information about the task:
@@ -499,6 +538,7 @@ void vpServo::addFeature(vpBasicFeature &s_cur, vpBasicFeature &s_star, unsigned
   featureList.push_back(&s_cur);
   desiredFeatureList.push_back(&s_star);
   featureSelectionList.push_back(select);
+  taskCompiled = false;
 }
 
 /*!
@@ -554,6 +594,7 @@ void vpServo::addFeature(vpBasicFeature &s_cur, unsigned int select)
 
   desiredFeatureList.push_back(s_star);
   featureSelectionList.push_back(select);
+  taskCompiled = false;
 }
 
 //! Return the task dimension.
@@ -653,6 +694,11 @@ static void computeInteractionMatrixFromList(const std::list<vpBasicFeature *> &
 */
 vpMatrix vpServo::computeInteractionMatrix()
 {
+  if (compiledTask) {
+    computeCompiledInteractionMatrix();
+    return L;
+  }
+
   try {
 
     switch (interactionMatrixType) {
@@ -705,6 +751,79 @@ vpMatrix vpServo::computeInteractionMatrix()
   return L;
 }
 
+/*!
+  Freeze the feature lists in arrays and compute the index of the first row of
+  each feature in the task. See setCompiledTask().
+*/
+void vpServo::compileTask()
+{
+  if (featureList.empty()) {
+    vpERROR_TRACE("feature list empty, cannot compile the task");
+    throw(vpServoException(vpServoException::noFeatureError, "feature list empty, cannot compile the task"));
+  }
+
+  compiledFeatures.assign(featureList.begin(), featureList.end());
+  compiledDesiredFeatures.assign(desiredFeatureList.begin(), desiredFeatureList.end());
+  compiledSelections.assign(featureSelectionList.begin(), featureSelectionList.end());
+
+  compiledOffsets.resize(compiledFeatures.size() + 1);
+  compiledOffsets[0] = 0;
+  for (size_t k = 0; k < compiledFeatures.size(); k++) {
+    compiledOffsets[k + 1] = compiledOffsets[k] + compiledFeatures[k]->getDimension(compiledSelections[k]);
+  }
+
+  // The task may have changed, the interaction matrix has to be updated
+  interactionMatrixComputed = false;
+  taskCompiled = true;
+}
+
+static void computeInteractionMatrixFromArray(const std::vector<vpBasicFeature *> &features,
+                                              const std::vector<unsigned int> &selections,
+                                              const std::vector<unsigned int> &offsets, vpMatrix &L)
+{
+  // No reallocation when the dimension does not change
+  L.resize(offsets.back(), 6, false);
+  for (size_t k = 0; k < features.size(); k++) {
+    features[k]->computeInteraction(selections[k], L, offsets[k]);
+  }
+}
+
+/*!
+  Compute the interaction matrix of the compiled task in place.
+  See computeInteractionMatrix().
+*/
+void vpServo::computeCompiledInteractionMatrix()
+{
+  if (!taskCompiled)
+    compileTask();
+
+  switch (interactionMatrixType) {
+  case CURRENT:
+    computeInteractionMatrixFromArray(compiledFeatures, compiledSelections, compiledOffsets, L);
+    dim_task = L.getRows();
+    interactionMatrixComputed = true;
+    break;
+  case DESIRED:
+    if (interactionMatrixComputed == false || forceInteractionMatrixComputation == true) {
+      computeInteractionMatrixFromArray(compiledDesiredFeatures, compiledSelections, compiledOffsets, L);
+      dim_task = L.getRows();
+      interactionMatrixComputed = true;
+    }
+    break;
+  case MEAN:
+    computeInteractionMatrixFromArray(compiledFeatures, compiledSelections, compiledOffsets, L);
+    computeInteractionMatrixFromArray(compiledDesiredFeatures, compiledSelections, compiledOffsets, compiledLstar);
+    L += compiledLstar;
+    L /= 2;
+    dim_task = L.getRows();
+    interactionMatrixComputed = true;
+    break;
+  case USER_DEFINED:
+    interactionMatrixComputed = false;
+    break;
+  }
+}
+
 /*!
 
   Compute the error \f$\bf e =(s - s^*)\f$ between the current set of visual
@@ -715,6 +834,11 @@ vpMatrix vpServo::computeInteractionMatrix()
 */
 vpColVector vpServo::computeError()
 {
+  if (compiledTask) {
+    computeCompiledError();
+    return error;
+  }
+
   if (featureList.empty()) {
     vpERROR_TRACE("feature list empty, cannot compute Ls");
     throw(vpServoException(vpServoException::noFeatureError, "feature list empty, cannot compute Ls"));
@@ -829,6 +953,32 @@ vpColVector vpServo::computeError()
   return error;
 }
 
+/*!
+  Compute the error of the compiled task in place. See computeError().
+*/
+void vpServo::computeCompiledError()
+{
+  if (!taskCompiled)
+    compileTask();
+
+  // No reallocation when the dimension does not change
+  const unsigned int dim = compiledOffsets.back();
+  s.resize(dim, false);
+  sStar.resize(dim, false);
+  error.resize(dim, false);
+
+  for (size_t k = 0; k < compiledFeatures.size(); k++) {
+    const unsigned int select = compiledSelections[k];
+    const unsigned int offset = compiledOffsets[k];
+    compiledFeatures[k]->copy_s(select, s, offset);
+    compiledDesiredFeatures[k]->copy_s(select, sStar, offset);
+    compiledFeatures[k]->computeError(*compiledDesiredFeatures[k], select, error, offset);
+  }
+
+  dim_task = dim;
+  errorComputed = true;
+}
+
 bool vpServo::testInitialization()
 {
   switch (servoType) {
@@ -934,6 +1084,12 @@ bool vpServo::testUpdated()
 */
 vpColVector vpServo::computeControlLaw()
 {
+  VP_TRACING_SCOPE("vpServo::computeControlLaw");
+  if (compiledTask) {
+    computeCompiledControlLaw();
+    return e;
+  }
+
   static int iteration = 0;
 
   try {
@@ -1050,6 +1206,105 @@ vpColVector vpServo::computeControlLaw()
   return e;
 }
 
+/*!
+  Compute the control law of the compiled task, reusing the memory of the
+  intermediate matrices. See computeControlLaw().
+*/
+void vpServo::computeCompiledControlLaw()
+{
+  if (!taskCompiled && testInitialization() == false) {
+    vpERROR_TRACE("All the matrices are not correctly initialized");
+    throw(vpServoException(vpServoException::servoError, "Cannot compute control law "
+                                                         "All the matrices are not correctly"
+                                                         "initialized"));
+  }
+  if (testUpdated() == false) {
+    vpERROR_TRACE("All the matrices are not correctly updated");
+  }
+
+  const vpMatrix *aJe = &eJe; // Jacobian
+  switch (servoType) {
+  case NONE:
+    vpERROR_TRACE("No control law have been yet defined");
+    throw(vpServoException(vpServoException::servoError, "No control law have been yet defined"));
+    break;
+  case EYEINHAND_CAMERA:
+  case EYEINHAND_L_cVe_eJe:
+  case EYETOHAND_L_cVe_eJe:
+    for (unsigned int i = 0; i < 6; i++)
+      for (unsigned int j = 0; j < 6; j++)
+        compiled_cVa[i][j] = cVe[i][j];
+    init_cVe = false;
+    init_eJe = false;
+    break;
+  case EYETOHAND_L_cVf_fVe_eJe:
+    for (unsigned int i = 0; i < 6; i++) {
+      for (unsigned int j = 0; j < 6; j++) {
+        double sum = 0;
+        for (unsigned int k = 0; k < 6; k++)
+          sum += cVf[i][k] * fVe[k][j];
+        compiled_cVa[i][j] = sum;
+      }
+    }
+    init_fVe = false;
+    init_eJe = false;
+    break;
+  case EYETOHAND_L_cVf_fJe:
+    for (unsigned int i = 0; i < 6; i++)
+      for (unsigned int j = 0; j < 6; j++)
+        compiled_cVa[i][j] = cVf[i][j];
+    aJe = &fJe;
+    init_fJe = false;
+    break;
+  }
+
+  // cJc is diagonal: remove the dof that are not controlled
+  if (!iscJcIdentity) {
+    for (unsigned int i = 0; i < 6; i++)
+      for (unsigned int j = 0; j < 6; j++)
+        compiled_cVa[i][j] *= cJc[i][i];
+  }
+
+  computeCompiledInteractionMatrix();
+  computeCompiledError();
+
+  // compute task Jacobian
+  vpMatrix::mult2Matrices(L, compiled_cVa, compiledLcVa);
+  vpMatrix::mult2Matrices(compiledLcVa, *aJe, J1);
+
+  // handle the eye-in-hand eye-to-hand case
+  J1 *= signInteractionMatrix;
+
+  bool imageComputed = false;
+  if (inversionType == PSEUDO_INVERSE) {
+    rankJ1 = J1.pseudoInverse(J1p, sv, 1e-6, compiledImJ1, compiledImJ1t);
+    imageComputed = true;
+  } else
+    J1.transpose(J1p);
+
+  const unsigned int n = J1.getCols();
+  if (rankJ1 == n) {
+    // WpW = I, multiply by WpW is useless
+    vpMatrix::multMatrixVector(J1p, error, e1); // primary task
+    WpW.eye(n, n);
+  } else {
+    if (imageComputed != true) {
+      vpMatrix Jtmp;
+      rankJ1 = J1.pseudoInverse(Jtmp, sv, 1e-6, compiledImJ1, compiledImJ1t);
+    }
+    compiledImJ1t.AAt(WpW);
+    vpMatrix::multMatrixVector(J1p, error, compiledVector);
+    vpMatrix::multMatrixVector(WpW, compiledVector, e1);
+  }
+
+  const double gain = -lambda(e1);
+  e.resize(e1.getRows(), false);
+  for (unsigned int i = 0; i < e1.getRows(); i++)
+    e[i] = gain * e1[i];
+
+  computeProjectionOperators();
+}
+
 /*!
   Compute the control law specified using setServo(). See vpServo::vpServoType
   for more details concerning the control laws that are available. The \ref
@@ -1086,6 +1341,7 @@ vpColVector vpServo::computeControlLaw()
 */
 vpColVector vpServo::computeControlLaw(double t)
 {
+  VP_TRACING_SCOPE("vpServo::computeControlLaw");
   static int iteration = 0;
   // static vpColVector e1_initial;
 
@@ -1247,6 +1503,7 @@ vpColVector vpServo::computeControlLaw(double t)
 */
 vpColVector vpServo::computeControlLaw(double t, const vpColVector &e_dot_init)
 {
+  VP_TRACING_SCOPE("vpServo::computeControlLaw");
   static int iteration = 0;
 
   try {
@@ -1374,13 +1631,7 @@ void vpServo::computeProjectionOperators()
 {
   // Initialization
   unsigned int n = J1.getCols();
-  P.resize(n, n);
-
-  vpMatrix I;
-  I.eye(n);
-
-  // Compute classical projection operator
-  I_WpW = (I - WpW);
+  P.resize(n, n, !compiledTask);
 
   // Compute gain depending by the task error to ensure a smooth change
   // between the operators.
@@ -1396,6 +1647,34 @@ void vpServo::computeProjectionOperators()
   else
     sig = 0.0;
 
+  if (compiledTask) {
+    // With g = J1^T e: P_norm_e = I - g g^T / (g^T g)
+    compiledVector.resize(n, false);
+    for (unsigned int j = 0; j < n; j++) {
+      double sum = 0;
+      for (unsigned int i = 0; i < error.getRows(); i++)
+        sum += J1[i][j] * error[i];
+      compiledVector[j] = sum;
+    }
+    double pp = compiledVector.sumSquare();
+
+    I_WpW.resize(n, n, false);
+    for (unsigned int i = 0; i < n; i++) {
+      for (unsigned int j = 0; j < n; j++) {
+        double delta = (i == j) ? 1. : 0.;
+        I_WpW[i][j] = delta - WpW[i][j];
+        P[i][j] = sig * (delta - compiledVector[i] * compiledVector[j] / pp) + (1 - sig) * I_WpW[i][j];
+      }
+    }
+    return;
+  }
+
+  vpMatrix I;
+  I.eye(n);
+
+  // Compute classical projection operator
+  I_WpW = (I - WpW);
+
   vpMatrix J1t = J1.transpose();
 
   double pp = (error.t() * (J1 * J1t) * error);
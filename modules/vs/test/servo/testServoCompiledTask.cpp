@@ -0,0 +1,175 @@
+/****************************************************************************
+ *
+ * This file is part of the ViSP software.
+ * Copyright (C) 2005 - 2017 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the compiled task mode of vpServo.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testServoCompiledTask.cpp
+
+  Simulate a visual servoing task with and without the compiled task mode of
+  vpServo and check that the velocities, the task Jacobian and the projection
+  operators are the same.
+*/
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <visp3/core/vpExponentialMap.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpPoint.h>
+#include <visp3/visual_features/vpFeatureBuilder.h>
+#include <visp3/visual_features/vpFeaturePoint.h>
+#include <visp3/visual_features/vpFeatureThetaU.h>
+#include <visp3/vs/vpServo.h>
+
+namespace
+{
+bool equal(const vpArray2D<double> &A, const vpArray2D<double> &B, double threshold)
+{
+  if (A.getRows() != B.getRows() || A.getCols() != B.getCols())
+    return false;
+  for (unsigned int i = 0; i < A.size(); i++) {
+    if (std::fabs(A.data[i] - B.data[i]) > threshold)
+      return false;
+  }
+  return true;
+}
+
+// Servo a camera with nbPoints points and the selected theta u components,
+// with the regular and the compiled tasks
+bool test(unsigned int nbPoints, unsigned int selectTU, vpServo::vpServoIteractionMatrixType type,
+          vpServo::vpServoInversionType inversion)
+{
+  const vpHomogeneousMatrix cdMo(0, 0, 0.75, 0, 0, 0);
+  const vpHomogeneousMatrix cMo_init(0.1, -0.05, 1., vpMath::rad(10), vpMath::rad(-20), vpMath::rad(40));
+  const double points[4][3] = {{-0.1, -0.1, 0}, {0.1, -0.1, 0}, {0.1, 0.1, 0}, {-0.1, 0.1, 0.05}};
+
+  vpHomogeneousMatrix cMo[2] = {cMo_init, cMo_init};
+  vpServo task[2];
+  std::vector<vpFeaturePoint> p[2], pd[2];
+  vpFeatureThetaU tu[2] = {vpFeatureThetaU(vpFeatureThetaU::cdRc), vpFeatureThetaU(vpFeatureThetaU::cdRc)};
+
+  for (unsigned int t = 0; t < 2; t++) {
+    p[t].resize(nbPoints);
+    pd[t].resize(nbPoints);
+    task[t].setServo(vpServo::EYEINHAND_CAMERA);
+    task[t].setInteractionMatrixType(type, inversion);
+    task[t].setLambda(0.5);
+    task[t].setCompiledTask(t == 1);
+    for (unsigned int k = 0; k < nbPoints; k++) {
+      vpPoint point(points[k][0], points[k][1], points[k][2]);
+      point.track(cdMo);
+      vpFeatureBuilder::create(pd[t][k], point);
+      task[t].addFeature(p[t][k], pd[t][k]);
+    }
+    if (selectTU)
+      task[t].addFeature(tu[t], selectTU);
+  }
+
+  for (unsigned int iter = 0; iter < 20; iter++) {
+    vpColVector v[2];
+    for (unsigned int t = 0; t < 2; t++) {
+      for (unsigned int k = 0; k < nbPoints; k++) {
+        vpPoint point(points[k][0], points[k][1], points[k][2]);
+        point.track(cMo[t]);
+        vpFeatureBuilder::create(p[t][k], point);
+      }
+      tu[t].buildFrom(cdMo * cMo[t].inverse());
+      v[t] = task[t].computeControlLaw();
+      cMo[t] = vpExponentialMap::direct(v[t], 0.04).inverse() * cMo[t];
+    }
+
+    if (!equal(v[0], v[1], 1e-10) || !equal(task[0].getError(), task[1].getError(), 1e-12) ||
+        !equal(task[0].getInteractionMatrix(), task[1].getInteractionMatrix(), 1e-12) ||
+        !equal(task[0].getTaskJacobian(), task[1].getTaskJacobian(), 1e-12) ||
+        !equal(task[0].getWpW(), task[1].getWpW(), 1e-10) || !equal(task[0].getI_WpW(), task[1].getI_WpW(), 1e-10) ||
+        !equal(task[0].getLargeP(), task[1].getLargeP(), 1e-8) || !equal(task[0].s, task[1].s, 1e-12) ||
+        !equal(task[0].sStar, task[1].sStar, 1e-12)) {
+      std::cerr << "Different task at iteration " << iter << ":\n"
+                << v[0].t() << "\n"
+                << v[1].t() << std::endl;
+      return false;
+    }
+    if (task[0].getTaskRank() != task[1].getTaskRank()) {
+      std::cerr << "Different task rank at iteration " << iter << std::endl;
+      return false;
+    }
+  }
+
+  // Adding a feature to the compiled task compiles it again
+  vpFeaturePoint p_extra, pd_extra;
+  vpPoint point(0, 0, 0);
+  point.track(cdMo);
+  vpFeatureBuilder::create(pd_extra, point);
+  point.track(cMo[1]);
+  vpFeatureBuilder::create(p_extra, point);
+  unsigned int dim = task[1].getError().getRows();
+  task[1].addFeature(p_extra, pd_extra);
+  task[1].computeControlLaw();
+  if (task[1].getError().getRows() != dim + 2 || task[1].getInteractionMatrix().getRows() != dim + 2) {
+    std::cerr << "The compiled task was not updated after addFeature()" << std::endl;
+    return false;
+  }
+
+  task[0].kill();
+  task[1].kill();
+  return true;
+}
+}
+
+int main()
+{
+  try {
+    const char *types[] = {"CURRENT", "DESIRED", "MEAN"};
+    const vpServo::vpServoIteractionMatrixType type[] = {vpServo::CURRENT, vpServo::DESIRED, vpServo::MEAN};
+    for (unsigned int i = 0; i < 3; i++) {
+      std::cout << "** Test " << types[i] << " interaction matrix" << std::endl;
+      // Full rank task
+      if (!test(4, vpBasicFeature::FEATURE_ALL, type[i], vpServo::PSEUDO_INVERSE))
+        return EXIT_FAILURE;
+      // Rank deficient task, with a non trivial projection operator
+      if (!test(1, vpFeatureThetaU::selectTUz(), type[i], vpServo::PSEUDO_INVERSE))
+        return EXIT_FAILURE;
+      // Points only, transpose of the task Jacobian
+      if (!test(2, 0, type[i], vpServo::TRANSPOSE))
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Test succeed" << std::endl;
+    return EXIT_SUCCESS;
+  } catch (const vpException &e) {
+    std::cout << "Catch an exception: " << e << std::endl;
+    return EXIT_FAILURE;
+  }
+}